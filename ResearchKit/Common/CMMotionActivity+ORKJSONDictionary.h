@@ -38,6 +38,11 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (NSDictionary *)ork_JSONDictionary;
 
+/**
+ Returns `YES` if the activity has the same activity states and confidence as `activity`.
+ */
+- (BOOL)ork_hasSameStateAsActivity:(CMMotionActivity *)activity;
+
 @end
 
 NS_ASSUME_NONNULL_END
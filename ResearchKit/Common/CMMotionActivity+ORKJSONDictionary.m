@@ -81,4 +81,13 @@ static NSString *const ConfidenceKey = @"confidence";
              StartDateKey: ORKStringFromDateISO8601(self.startDate)};
 }
 
+- (BOOL)ork_hasSameStateAsActivity:(CMMotionActivity *)activity {
+    return (self.confidence == activity.confidence &&
+            self.unknown == activity.unknown &&
+            self.stationary == activity.stationary &&
+            self.walking == activity.walking &&
+            self.running == activity.running &&
+            self.automotive == activity.automotive);
+}
+
 @end
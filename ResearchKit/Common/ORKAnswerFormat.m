@@ -35,6 +35,7 @@
 
 #import "ORKAnswerFormat.h"
 #import "ORKAnswerFormat_Internal.h"
+#import "ORKAnswerFormatValidator.h"
 #import "ORKChoiceAnswerFormatHelper.h"
 #import "ORKQuestionResult_Private.h"
 #import "ORKResult_Private.h"
@@ -647,6 +648,16 @@ static NSNumberFormatterStyle ORKNumberFormattingStyleConvert(ORKNumberFormattin
     return impliedFormat == self ? nil : [impliedFormat stringForAnswer:answer];
 }
 
+- (ORKAnswerFormatValidator *)validator {
+    static ORKAnswerFormatValidator *acceptingValidator;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        acceptingValidator = [ORKAnswerFormatValidator new];
+    });
+    ORKAnswerFormat *impliedFormat = [self impliedAnswerFormat];
+    return impliedFormat == self ? acceptingValidator : [impliedFormat validator];
+}
+
 - (BOOL)shouldShowDontKnowButton {
     return _showDontKnowButton;
 }
@@ -2018,8 +2029,7 @@ NSArray<Class> *ORKAllowableValueClasses(void) {
         default:
             break;
     }
-    dfm = [dfm copy];
-    dfm.calendar = [NSCalendar calendarWithIdentifier:NSCalendarIdentifierGregorian];
+    // The shared result formatters already use the Gregorian calendar and are never changed.
     return dfm;
 }
 
@@ -2089,7 +2099,9 @@ NSArray<Class> *ORKAllowableValueClasses(void) {
 
 #pragma mark - ORKNumericAnswerFormat
 
-@implementation ORKNumericAnswerFormat
+@implementation ORKNumericAnswerFormat {
+    ORKNumericAnswerFormatValidator *_validator;
+}
 
 - (Class)questionResultClass {
     return [ORKNumericQuestionResult class];
@@ -2240,50 +2252,36 @@ NSArray<Class> *ORKAllowableValueClasses(void) {
     
 }
 
-- (BOOL)isAnswerValid:(id)answer {
-    BOOL isValid = NO;
-    if ([answer isKindOfClass:[NSNumber class]]) {
-        return [self isAnswerValidWithNumber:(NSNumber *)answer];
-    } else if ([answer isKindOfClass:[ORKDontKnowAnswer class]]) {
-        isValid = YES;
+- (ORKNumericAnswerFormatValidator *)validator {
+    ORKNumericAnswerFormatValidator *validator = _validator;
+    // Bounds are immutable numbers, so the validator is current as long as it holds the same ones.
+    if (!validator || validator.minimum != _minimum || validator.maximum != _maximum) {
+        validator = [[ORKNumericAnswerFormatValidator alloc] initWithMinimum:_minimum maximum:_maximum];
+        _validator = validator;
     }
-    return isValid;
+    return validator;
+}
+
+- (BOOL)isAnswerValid:(id)answer {
+    return [self.validator isAnswerValid:answer];
 }
 
 - (BOOL)isAnswerValidWithNumber:(NSNumber *)number {
-    BOOL isValid = NO;
-    if (number) {
-        isValid = YES;
-        if (isnan(number.doubleValue)) {
-            isValid = NO;
-        } else if (self.minimum && (self.minimum.doubleValue > number.doubleValue)) {
-            isValid = NO;
-        } else if (self.maximum && (self.maximum.doubleValue < number.doubleValue)) {
-            isValid = NO;
-        }
-    }
-    return isValid;
+    return [self.validator isAnswerValidWithNumber:number];
 }
 
 - (BOOL)isAnswerValidWithString:(NSString *)text {
-    BOOL isValid = NO;
-    if (text.length > 0) {
-        NSDecimalNumber *number = [NSDecimalNumber decimalNumberWithString:text locale:[NSLocale currentLocale]];
-        isValid = [self isAnswerValidWithNumber:number];
-    }
-    return isValid;
+    return [self.validator isAnswerValidWithString:text];
 }
 
 - (NSString *)localizedInvalidValueStringWithAnswerString:(NSString *)text {
-    if (!text.length) {
-        return nil;
-    }
-    NSDecimalNumber *num = [NSDecimalNumber decimalNumberWithString:text locale:[NSLocale currentLocale]];
+    ORKNumericAnswerFormatValidator *validator = self.validator;
+    NSDecimalNumber *num = [validator numberWithString:text];
     if (!num) {
         return nil;
     }
     NSString *string = nil;
-    NSNumberFormatter *formatter = ORKDecimalNumberFormatter();
+    NSNumberFormatter *formatter = validator.numberFormatter;
     if (self.minimum && (self.minimum.doubleValue > num.doubleValue)) {
         string = [NSString localizedStringWithFormat:ORKLocalizedString(@"RANGE_ALERT_MESSAGE_BELOW_MAXIMUM", nil), text, [formatter stringFromNumber:self.minimum]];
     } else if (self.maximum && (self.maximum.doubleValue < num.doubleValue)) {
@@ -2297,8 +2295,7 @@ NSArray<Class> *ORKAllowableValueClasses(void) {
 - (NSString *)stringForAnswer:(id)answer {
     NSString *answerString = nil;
     if ([self isAnswerValid:answer]) {
-        NSNumberFormatter *formatter = ORKDecimalNumberFormatter();
-        answerString = [formatter stringFromNumber:answer];
+        answerString = [self.validator.numberFormatter stringFromNumber:answer];
         if (self.unit && self.unit.length > 0) {
             answerString = [NSString stringWithFormat:@"%@ %@", answerString, self.unit];
         }
@@ -3048,8 +3045,9 @@ NSArray<Class> *ORKAllowableValueClasses(void) {
 
 @end
 
-@implementation ORKTextAnswerFormat
-
+@implementation ORKTextAnswerFormat {
+    ORKTextAnswerFormatValidator *_validator;
+}
 
 - (Class)questionResultClass {
     return [ORKTextQuestionResult class];
@@ -3140,40 +3138,32 @@ NSArray<Class> *ORKAllowableValueClasses(void) {
     return answerFormat;
 }
 
-- (BOOL)isAnswerValid:(id)answer {
-    BOOL isValid = NO;
-    if ([answer isKindOfClass:[NSString class]]) {
-        isValid = [self isAnswerValidWithString:(NSString *)answer];
-    } else if ([answer isKindOfClass:[ORKDontKnowAnswer class]]) {
-        isValid = YES;
+- (ORKTextAnswerFormatValidator *)validator {
+    ORKTextAnswerFormatValidator *validator = _validator;
+    if (!validator ||
+        validator.maximumLength != _maximumLength ||
+        validator.validationRegularExpression != _validationRegularExpression) {
+        validator = [[ORKTextAnswerFormatValidator alloc] initWithMaximumLength:_maximumLength
+                                                    validationRegularExpression:_validationRegularExpression];
+        _validator = validator;
     }
-    return isValid;
+    return validator;
+}
+
+- (BOOL)isAnswerValid:(id)answer {
+    return [self.validator isAnswerValid:answer];
 }
 
 - (BOOL)isAnswerValidWithString:(NSString *)text {
-    BOOL isValid = NO;
-    
-    if (text &&
-        [text stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]].length > 0)
-    {
-        isValid = ([self isTextLengthValidWithString:text] && [self isTextRegularExpressionValidWithString:text]);
-    }
-    return isValid;
+    return [self.validator isAnswerValidWithString:text];
 }
 
 - (BOOL)isTextLengthValidWithString:(NSString *)text {
-    return (_maximumLength == 0 || text.length <= _maximumLength);
+    return [self.validator isTextLengthValidWithString:text];
 }
 
 - (BOOL)isTextRegularExpressionValidWithString:(NSString *)text {
-    BOOL isValid = YES;
-    if (self.validationRegularExpression) {
-        NSUInteger regularExpressionMatches = [_validationRegularExpression numberOfMatchesInString:text
-                                                                                            options:(NSMatchingOptions)0
-                                                                                              range:NSMakeRange(0, [text length])];
-        isValid = (regularExpressionMatches != 0);
-    }
-    return isValid;
+    return [self.validator isTextRegularExpressionValidWithString:text];
 }
 
 - (NSString *)localizedInvalidValueStringWithAnswerString:(NSString *)text {
@@ -3348,9 +3338,8 @@ static NSString *const kSecureTextEntryEscapeString = @"*";
 - (ORKAnswerFormat *)impliedAnswerFormat {
     if (!_impliedAnswerFormat) {
         NSRegularExpression *validationRegularExpression =
-        [NSRegularExpression regularExpressionWithPattern:EmailValidationRegularExpressionPattern
-                                                  options:(NSRegularExpressionOptions)0
-                                                    error:nil];
+        [[ORKRegularExpressionCache sharedCache] regularExpressionWithPattern:EmailValidationRegularExpressionPattern
+                                                                      options:(NSRegularExpressionOptions)0];
         NSString *invalidMessage = ORKLocalizedString(@"INVALID_EMAIL_ALERT_MESSAGE", nil);
         _impliedAnswerFormat = [ORKTextAnswerFormat textAnswerFormatWithValidationRegularExpression:validationRegularExpression
                                                                                      invalidMessage:invalidMessage];
@@ -0,0 +1,130 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A cache of compiled regular expressions, shared by every answer format validator.
+ 
+ Patterns with the same options share one `NSRegularExpression`, so a form whose fields are
+ validated by the same pattern compiles it once. The cache can be used from any thread.
+ */
+@interface ORKRegularExpressionCache : NSObject
+
++ (instancetype)sharedCache;
+
+/**
+ Returns the compiled regular expression, or nil if `pattern` is not valid.
+ */
+- (nullable NSRegularExpression *)regularExpressionWithPattern:(NSString *)pattern options:(NSRegularExpressionOptions)options;
+
+@end
+
+
+/**
+ Checks answers for an answer format, with everything the checks need compiled up front.
+ 
+ Validators are immutable and can be used from any thread. Answer formats compile theirs on first
+ use, and again when a property the checks depend on has changed. This base class accepts every
+ answer.
+ */
+@interface ORKAnswerFormatValidator : NSObject
+
+- (BOOL)isAnswerValid:(nullable id)answer;
+
+- (BOOL)isAnswerValidWithString:(nullable NSString *)text;
+
+@end
+
+
+@interface ORKTextAnswerFormatValidator : ORKAnswerFormatValidator
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithMaximumLength:(NSInteger)maximumLength
+          validationRegularExpression:(nullable NSRegularExpression *)validationRegularExpression NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readonly) NSInteger maximumLength;
+
+/**
+ The regular expression the validator was compiled from.
+ */
+@property (nonatomic, readonly, nullable) NSRegularExpression *validationRegularExpression;
+
+/**
+ The equivalent regular expression from the shared cache, which is the one evaluated.
+ */
+@property (nonatomic, readonly, nullable) NSRegularExpression *regularExpression;
+
+- (BOOL)isTextLengthValidWithString:(NSString *)text;
+
+/**
+ Returns whether the text answer cells should accept replacing the characters in `range` of `text`
+ with `string`, as in `-textField:shouldChangeCharactersInRange:replacementString:`.
+ 
+ An edit that does not lengthen the text is always accepted, and newlines do not count towards
+ `maximumLength`. The edited text is only built when the length of the edit alone could exceed it.
+ */
+- (BOOL)isEditLengthValidWithString:(nullable NSString *)text replacingCharactersInRange:(NSRange)range withString:(NSString *)string;
+
+- (BOOL)isTextRegularExpressionValidWithString:(NSString *)text;
+
+@end
+
+
+@interface ORKNumericAnswerFormatValidator : ORKAnswerFormatValidator
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithMinimum:(nullable NSNumber *)minimum maximum:(nullable NSNumber *)maximum NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readonly, nullable) NSNumber *minimum;
+
+@property (nonatomic, readonly, nullable) NSNumber *maximum;
+
+/**
+ A decimal formatter without grouping separators, for showing answers and bounds.
+ */
+@property (nonatomic, readonly) NSNumberFormatter *numberFormatter;
+
+- (BOOL)isAnswerValidWithNumber:(nullable NSNumber *)number;
+
+/**
+ Parses `text` in the current locale, or returns nil if it is empty.
+ */
+- (nullable NSDecimalNumber *)numberWithString:(nullable NSString *)text;
+
+@end
+
+NS_ASSUME_NONNULL_END
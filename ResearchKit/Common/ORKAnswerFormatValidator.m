@@ -0,0 +1,222 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKAnswerFormatValidator.h"
+
+#import "ORKHelpers_Internal.h"
+#import "ORKTypes.h"
+
+
+@implementation ORKRegularExpressionCache {
+    NSCache<NSString *, NSRegularExpression *> *_regularExpressions;
+}
+
++ (instancetype)sharedCache {
+    static ORKRegularExpressionCache *sharedCache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCache = [ORKRegularExpressionCache new];
+    });
+    return sharedCache;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _regularExpressions = [NSCache new];
+        _regularExpressions.name = @"ORKRegularExpressionCache";
+    }
+    return self;
+}
+
+- (NSRegularExpression *)regularExpressionWithPattern:(NSString *)pattern options:(NSRegularExpressionOptions)options {
+    NSString *key = [NSString stringWithFormat:@"%lu:%@", (unsigned long)options, pattern];
+    NSRegularExpression *regularExpression = [_regularExpressions objectForKey:key];
+    if (!regularExpression) {
+        // Two threads may both compile a new pattern; either result is equivalent.
+        regularExpression = [NSRegularExpression regularExpressionWithPattern:pattern options:options error:nil];
+        if (regularExpression) {
+            [_regularExpressions setObject:regularExpression forKey:key];
+        }
+    }
+    return regularExpression;
+}
+
+@end
+
+
+@implementation ORKAnswerFormatValidator
+
+- (BOOL)isAnswerValid:(id)answer {
+    return YES;
+}
+
+- (BOOL)isAnswerValidWithString:(NSString *)text {
+    return YES;
+}
+
+@end
+
+
+static NSCharacterSet *ORKNonWhitespaceCharacterSet(void) {
+    static NSCharacterSet *characterSet;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        characterSet = [[NSCharacterSet whitespaceAndNewlineCharacterSet] invertedSet];
+    });
+    return characterSet;
+}
+
+@implementation ORKTextAnswerFormatValidator
+
+- (instancetype)initWithMaximumLength:(NSInteger)maximumLength
+          validationRegularExpression:(NSRegularExpression *)validationRegularExpression {
+    self = [super init];
+    if (self) {
+        _maximumLength = maximumLength;
+        _validationRegularExpression = validationRegularExpression;
+        if (validationRegularExpression) {
+            _regularExpression = [[ORKRegularExpressionCache sharedCache] regularExpressionWithPattern:validationRegularExpression.pattern
+                                                                                              options:validationRegularExpression.options] ? : validationRegularExpression;
+        }
+    }
+    return self;
+}
+
+- (BOOL)isAnswerValid:(id)answer {
+    BOOL isValid = NO;
+    if ([answer isKindOfClass:[NSString class]]) {
+        isValid = [self isAnswerValidWithString:(NSString *)answer];
+    } else if ([answer isKindOfClass:[ORKDontKnowAnswer class]]) {
+        isValid = YES;
+    }
+    return isValid;
+}
+
+- (BOOL)isAnswerValidWithString:(NSString *)text {
+    // A text with any character that trimming would keep is not blank.
+    if (!text || [text rangeOfCharacterFromSet:ORKNonWhitespaceCharacterSet()].location == NSNotFound) {
+        return NO;
+    }
+    return [self isTextLengthValidWithString:text] && [self isTextRegularExpressionValidWithString:text];
+}
+
+- (BOOL)isTextLengthValidWithString:(NSString *)text {
+    return (_maximumLength == 0 || text.length <= (NSUInteger)_maximumLength);
+}
+
+- (BOOL)isEditLengthValidWithString:(NSString *)text replacingCharactersInRange:(NSRange)range withString:(NSString *)string {
+    if (_maximumLength <= 0 || string.length <= range.length) {
+        return YES;
+    }
+    NSUInteger length = text.length - range.length + string.length;
+    if (length <= (NSUInteger)_maximumLength) {
+        return YES;
+    }
+    // Only newlines can bring a long edit back within the limit, so count what remains without them.
+    NSString *editedText = [(text ? : @"") stringByReplacingCharactersInRange:range withString:string];
+    NSCharacterSet *newlines = [NSCharacterSet newlineCharacterSet];
+    NSRange searchRange = NSMakeRange(0, editedText.length);
+    length = editedText.length;
+    NSRange newline = [editedText rangeOfCharacterFromSet:newlines options:0 range:searchRange];
+    while (newline.location != NSNotFound) {
+        length -= newline.length;
+        searchRange = NSMakeRange(NSMaxRange(newline), editedText.length - NSMaxRange(newline));
+        newline = [editedText rangeOfCharacterFromSet:newlines options:0 range:searchRange];
+    }
+    return length <= (NSUInteger)_maximumLength;
+}
+
+- (BOOL)isTextRegularExpressionValidWithString:(NSString *)text {
+    if (!_regularExpression) {
+        return YES;
+    }
+    // The first match is enough to know there is one.
+    NSRange match = [_regularExpression rangeOfFirstMatchInString:text options:(NSMatchingOptions)0 range:NSMakeRange(0, text.length)];
+    return match.location != NSNotFound;
+}
+
+@end
+
+
+@implementation ORKNumericAnswerFormatValidator {
+    BOOL _hasMinimum;
+    BOOL _hasMaximum;
+    double _minimumValue;
+    double _maximumValue;
+    NSLocale *_locale;
+}
+
+- (instancetype)initWithMinimum:(NSNumber *)minimum maximum:(NSNumber *)maximum {
+    self = [super init];
+    if (self) {
+        _minimum = minimum;
+        _maximum = maximum;
+        _hasMinimum = (minimum != nil);
+        _hasMaximum = (maximum != nil);
+        _minimumValue = minimum.doubleValue;
+        _maximumValue = maximum.doubleValue;
+        _locale = [NSLocale autoupdatingCurrentLocale];
+        _numberFormatter = ORKDecimalNumberFormatter();
+    }
+    return self;
+}
+
+- (BOOL)isAnswerValid:(id)answer {
+    BOOL isValid = NO;
+    if ([answer isKindOfClass:[NSNumber class]]) {
+        isValid = [self isAnswerValidWithNumber:(NSNumber *)answer];
+    } else if ([answer isKindOfClass:[ORKDontKnowAnswer class]]) {
+        isValid = YES;
+    }
+    return isValid;
+}
+
+- (BOOL)isAnswerValidWithNumber:(NSNumber *)number {
+    if (!number) {
+        return NO;
+    }
+    double value = number.doubleValue;
+    return !(isnan(value) || (_hasMinimum && _minimumValue > value) || (_hasMaximum && _maximumValue < value));
+}
+
+- (NSDecimalNumber *)numberWithString:(NSString *)text {
+    if (text.length == 0) {
+        return nil;
+    }
+    return [NSDecimalNumber decimalNumberWithString:text locale:_locale];
+}
+
+- (BOOL)isAnswerValidWithString:(NSString *)text {
+    return [self isAnswerValidWithNumber:[self numberWithString:text]];
+}
+
+@end
@@ -80,7 +80,10 @@ ORK_DESIGNATE_CODING_AND_SERIALIZATION_INITIALIZERS(ORKTextChoiceAnswerFormat)
 ORK_DESIGNATE_CODING_AND_SERIALIZATION_INITIALIZERS(ORKTextChoice)
 
 
+@class ORKAnswerFormatValidator;
+@class ORKNumericAnswerFormatValidator;
 @class ORKQuestionResult;
+@class ORKTextAnswerFormatValidator;
 
 @interface ORKAnswerFormat ()
 
@@ -103,12 +106,20 @@ ORK_DESIGNATE_CODING_AND_SERIALIZATION_INITIALIZERS(ORKTextChoice)
 
 - (nullable NSString *)stringForAnswer:(id)answer;
 
+/**
+ The validator compiled from the answer format, or from its implied answer format. Formats
+ without checks of their own return a validator accepting every answer.
+ */
+- (ORKAnswerFormatValidator *)validator;
+
 @end
 
 
 #if TARGET_OS_IOS
 @interface ORKNumericAnswerFormat ()
 
+- (ORKNumericAnswerFormatValidator *)validator;
+
 - (nullable NSString *)sanitizedTextFieldText:(nullable NSString *)text decimalSeparator:(nullable NSString *)separator;
 
 @end
@@ -243,6 +254,8 @@ NSArray<Class> *ORKAllowableValueClasses(void);
 
 @interface ORKTextAnswerFormat () <ORKConfirmAnswerFormatProvider>
 
+- (ORKTextAnswerFormatValidator *)validator;
+
 @end
 
 
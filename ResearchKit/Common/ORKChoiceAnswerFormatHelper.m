@@ -41,6 +41,11 @@
 @implementation ORKChoiceAnswerFormatHelper {
     NSArray *_choices;
     BOOL _isValuePicker;
+    // First index of each choice value. Text choice other values are left out, they match by their own rules.
+    NSDictionary *_indexesByValue;
+    NSIndexSet *_textChoiceOtherIndexes;
+    // First index of each choice, so that equal choices resolve to the same index.
+    NSMapTable *_indexesByChoice;
 }
 
 - (instancetype)initWithAnswerFormat:(ORKAnswerFormat *)answerFormat {
@@ -48,10 +53,40 @@
     if (self) {
         _choices = [answerFormat choices];
         _isValuePicker = [answerFormat isValuePicker];
+        [self _buildIndexes];
     }
     return self;
 }
 
+- (void)_buildIndexes {
+    NSMutableDictionary *indexesByValue = [[NSMutableDictionary alloc] initWithCapacity:_choices.count];
+    NSMutableIndexSet *textChoiceOtherIndexes = [NSMutableIndexSet new];
+    NSMapTable *indexesByChoice = [NSMapTable strongToStrongObjectsMapTable];
+    
+    NSUInteger index = 0;
+    for (id<ORKAnswerOption> choice in _choices) {
+        if ([indexesByChoice objectForKey:choice] == nil) {
+            [indexesByChoice setObject:@(index) forKey:choice];
+        }
+#if TARGET_OS_IOS
+        if ([choice isKindOfClass:[ORKTextChoiceOther class]]) {
+            [textChoiceOtherIndexes addIndex:index];
+            index++;
+            continue;
+        }
+#endif
+        id value = choice.value;
+        if (value != nil && indexesByValue[value] == nil) {
+            indexesByValue[value] = @(index);
+        }
+        index++;
+    }
+    
+    _indexesByValue = [indexesByValue copy];
+    _textChoiceOtherIndexes = [textChoiceOtherIndexes copy];
+    _indexesByChoice = indexesByChoice;
+}
+
 - (NSUInteger)choiceCount {
     return _choices.count;
 }
@@ -81,41 +116,46 @@
 }
 
 - (id)answerForSelectedIndex:(NSUInteger)index {
-    return [self answerForSelectedIndexes:@[ @(index) ]];
+    id value = [self _answerValueForSelectedIndex:index];
+    return value ? @[ value ] : ORKNullAnswerValue();
 }
 
 - (id)answerForSelectedIndexes:(NSArray *)indexes {
-    NSMutableArray *array = [NSMutableArray new];
+    NSMutableArray *array = [[NSMutableArray alloc] initWithCapacity:indexes.count];
     
     for (NSNumber *indexNumber in indexes) {
-        
-        NSUInteger index = indexNumber.unsignedIntegerValue;
-        
-        if (index >= _choices.count) {
-            continue;
+        id value = [self _answerValueForSelectedIndex:indexNumber.unsignedIntegerValue];
+        if (value != nil) {
+            [array addObject:value];
         }
-        
-        id<ORKAnswerOption> choice = _choices[index];
+    }
+    return array.count > 0 ? [array copy] : ORKNullAnswerValue();
+}
+
+- (nullable id)_answerValueForSelectedIndex:(NSUInteger)index {
+    if (index >= _choices.count) {
+        return nil;
+    }
+    
+    if (_isValuePicker && index == 0) {
+        // Don't add to answer array if this index is the 1st value of a value picker
+        return nil;
+    }
+    
+    id<ORKAnswerOption> choice = _choices[index];
 #if TARGET_OS_IOS
-        ORKTextChoiceOther *textChoiceOther;
-        if ([choice isKindOfClass: [ORKTextChoiceOther class]]) {
-            textChoiceOther = (ORKTextChoiceOther *)choice;
-        }
-        id value = textChoiceOther.textViewText ? : choice.value;
+    ORKTextChoiceOther *textChoiceOther;
+    if ([choice isKindOfClass: [ORKTextChoiceOther class]]) {
+        textChoiceOther = (ORKTextChoiceOther *)choice;
+    }
+    id value = textChoiceOther.textViewText ? : choice.value;
 #else
-        id value = choice.value;
+    id value = choice.value;
 #endif
-        if (value == nil) {
-            value = _isValuePicker ? @(index - 1) : @(index);
-        }
-        
-        if (_isValuePicker && index == 0) {
-            // Don't add to answer array if this index is the 1st value of a value picker
-        } else {
-            [array addObject:value];
-        }
+    if (value == nil) {
+        value = _isValuePicker ? @(index - 1) : @(index);
     }
-    return array.count > 0 ? [array copy] : ORKNullAnswerValue();
+    return value;
 }
 
 - (NSNumber *)selectedIndexForAnswer:(nullable id)answer {
@@ -140,38 +180,9 @@
         }
         
         for (id answerValue in (NSArray *)answer) {
-            id<ORKAnswerOption> matchedChoice = nil;
-            BOOL isTextChoiceOtherResult = [self _isTextChoiceOtherResult:answerValue choices:_choices];
-            
-            for ( id<ORKAnswerOption> choice in _choices) {
-#if TARGET_OS_IOS
-                if ([choice isKindOfClass:[ORKTextChoiceOther class]]) {
-                    ORKTextChoiceOther *textChoiceOther = (ORKTextChoiceOther *)choice;
-                    if ([textChoiceOther.textViewText isEqual:answerValue]) {
-                        matchedChoice = choice;
-                        break;
-                    } else if (textChoiceOther.textViewInputOptional && textChoiceOther.textViewText.length <= 0 && [textChoiceOther.value isEqual:answerValue]) {
-                        matchedChoice = choice;
-                        break;
-                    } else if (isTextChoiceOtherResult) {
-                        textChoiceOther.textViewText = answerValue;
-                        matchedChoice = choice;
-                        break;
-                    }
-                    
-                } else if ([choice.value isEqual:answerValue]) {
-                    matchedChoice = choice;
-                    break;
-                }
-#else
-                if ([choice.value isEqual:answerValue]) {
-                    matchedChoice = choice;
-                    break;
-                }
-#endif
-            }
+            NSUInteger matchedIndex = [self _indexOfChoiceMatchingAnswerValue:answerValue];
             
-            if (nil == matchedChoice) {
+            if (matchedIndex == NSNotFound) {
                 
                 if (![answerValue isKindOfClass:[NSNumber class]]) {
                     @throw [NSException exceptionWithName:@"No matching choice found"
@@ -179,16 +190,15 @@
                                                  userInfo:nil];
                 }
                 
+                matchedIndex = ((NSNumber *)answerValue).unsignedIntegerValue;
                 if (_isValuePicker) {
-                    matchedChoice = _choices[((NSNumber *)answerValue).unsignedIntegerValue + 1];
-                } else {
-                    matchedChoice = _choices[((NSNumber *)answerValue).unsignedIntegerValue];
+                    matchedIndex += 1;
                 }
             }
             
-            if (matchedChoice) {
-                [indexArray addObject:@([_choices indexOfObject:matchedChoice])];
-            }
+            // Raises a range exception for indexes past the last choice.
+            id<ORKAnswerOption> matchedChoice = _choices[matchedIndex];
+            [indexArray addObject:[_indexesByChoice objectForKey:matchedChoice]];
         }
     }
     
@@ -201,18 +211,38 @@
     
 }
 
-- (BOOL)_isTextChoiceOtherResult:(id)answerValue choices:(NSArray *)choices {
-    if (answerValue == nil) {
-        return NO;
+- (NSUInteger)_indexOfChoiceMatchingAnswerValue:(id)answerValue {
+    NSNumber *valueIndex = _indexesByValue[answerValue];
+    NSUInteger matchedIndex = valueIndex ? valueIndex.unsignedIntegerValue : NSNotFound;
+    
+#if TARGET_OS_IOS
+    if (_textChoiceOtherIndexes.count == 0) {
+        return matchedIndex;
     }
     
-    for (id<ORKAnswerOption> choice in _choices) {
-        if ([choice.value isEqual:answerValue]){
-            return NO;
+    // A value no choice has is free-form text for the first text choice other.
+    BOOL isTextChoiceOtherResult = (valueIndex == nil);
+    for (NSUInteger index = _textChoiceOtherIndexes.firstIndex; isTextChoiceOtherResult && index != NSNotFound; index = [_textChoiceOtherIndexes indexGreaterThanIndex:index]) {
+        if ([((ORKTextChoiceOther *)_choices[index]).value isEqual:answerValue]) {
+            isTextChoiceOtherResult = NO;
+        }
+    }
+    
+    // Text choice others ahead of the first choice with an equal value take precedence.
+    for (NSUInteger index = _textChoiceOtherIndexes.firstIndex; index < matchedIndex && index != NSNotFound; index = [_textChoiceOtherIndexes indexGreaterThanIndex:index]) {
+        ORKTextChoiceOther *textChoiceOther = (ORKTextChoiceOther *)_choices[index];
+        if ([textChoiceOther.textViewText isEqual:answerValue]) {
+            return index;
+        } else if (textChoiceOther.textViewInputOptional && textChoiceOther.textViewText.length <= 0 && [textChoiceOther.value isEqual:answerValue]) {
+            return index;
+        } else if (isTextChoiceOtherResult) {
+            textChoiceOther.textViewText = answerValue;
+            return index;
         }
     }
+#endif
     
-    return YES;
+    return matchedIndex;
 }
 
 - (NSString *)stringForChoiceAnswer:(id)answer {
@@ -0,0 +1,69 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <ResearchKit/ORKDefines.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A point on the monotonic clock shared by all active tasks, in nanoseconds since boot.
+ 
+ The clock does not advance while the device sleeps and is never adjusted, so differences
+ between clock times are exact elapsed times. It has the same epoch as
+ `-[NSProcessInfo systemUptime]`, `UITouch.timestamp`, `CMLogItem.timestamp` and
+ `CACurrentMediaTime()`, and ticks with the host time used by `AVAudioTime`.
+ */
+typedef uint64_t ORKClockTime;
+
+/// Returns the current clock time.
+ORK_EXTERN ORKClockTime ORKClockNow(void) ORK_AVAILABLE_DECL;
+
+/// Returns the current clock time in seconds, on the same timebase as `-[NSProcessInfo systemUptime]`.
+ORK_EXTERN NSTimeInterval ORKClockSystemUptime(void) ORK_AVAILABLE_DECL;
+
+/// Converts a timestamp in seconds since boot, such as a sensor or touch timestamp, to a clock time.
+ORK_EXTERN ORKClockTime ORKClockTimeFromSystemUptime(NSTimeInterval systemUptime) ORK_AVAILABLE_DECL;
+
+/// Converts a clock time to seconds since boot.
+ORK_EXTERN NSTimeInterval ORKSystemUptimeFromClockTime(ORKClockTime clockTime) ORK_AVAILABLE_DECL;
+
+/// Converts an audio host time, in `mach_absolute_time` ticks, to a clock time.
+ORK_EXTERN ORKClockTime ORKClockTimeFromHostTime(uint64_t hostTime) ORK_AVAILABLE_DECL;
+
+/// Converts a clock time to an audio host time, in `mach_absolute_time` ticks.
+ORK_EXTERN uint64_t ORKHostTimeFromClockTime(ORKClockTime clockTime) ORK_AVAILABLE_DECL;
+
+/// Returns the time elapsed between two clock times, in seconds. The result is negative if `end` precedes `start`.
+ORK_EXTERN NSTimeInterval ORKTimeIntervalBetweenClockTimes(ORKClockTime start, ORKClockTime end) ORK_AVAILABLE_DECL;
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,82 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKClock.h"
+
+#include <mach/mach_time.h>
+
+
+static mach_timebase_info_data_t ORKClockTimebase(void) {
+    static mach_timebase_info_data_t timebase;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        (void)mach_timebase_info(&timebase);
+    });
+    return timebase;
+}
+
+// Scales without overflowing for any tick count reachable in practice.
+static uint64_t ORKScale(uint64_t value, uint32_t numerator, uint32_t denominator) {
+    if (numerator == denominator) {
+        return value;
+    }
+    return ((value / denominator) * numerator) + (((value % denominator) * numerator) / denominator);
+}
+
+ORKClockTime ORKClockNow(void) {
+    return ORKClockTimeFromHostTime(mach_absolute_time());
+}
+
+NSTimeInterval ORKClockSystemUptime(void) {
+    return ORKSystemUptimeFromClockTime(ORKClockNow());
+}
+
+ORKClockTime ORKClockTimeFromSystemUptime(NSTimeInterval systemUptime) {
+    return systemUptime > 0 ? (ORKClockTime)llround(systemUptime * NSEC_PER_SEC) : 0;
+}
+
+NSTimeInterval ORKSystemUptimeFromClockTime(ORKClockTime clockTime) {
+    return (NSTimeInterval)clockTime / NSEC_PER_SEC;
+}
+
+ORKClockTime ORKClockTimeFromHostTime(uint64_t hostTime) {
+    mach_timebase_info_data_t timebase = ORKClockTimebase();
+    return ORKScale(hostTime, timebase.numer, timebase.denom);
+}
+
+uint64_t ORKHostTimeFromClockTime(ORKClockTime clockTime) {
+    mach_timebase_info_data_t timebase = ORKClockTimebase();
+    return ORKScale(clockTime, timebase.denom, timebase.numer);
+}
+
+NSTimeInterval ORKTimeIntervalBetweenClockTimes(ORKClockTime start, ORKClockTime end) {
+    return end >= start ? (NSTimeInterval)(end - start) / NSEC_PER_SEC : -((NSTimeInterval)(start - end) / NSEC_PER_SEC);
+}
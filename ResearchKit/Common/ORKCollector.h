@@ -157,6 +157,10 @@ ORK_CLASS_AVAILABLE
  
  It cannot be initiated directly.
  Use `addMotionActivityCollectorWithStartDate:`to add one to a `ORKDataCollectionManager`.
+ 
+ An activity lasts until the next one starts, so activities with the same states and confidence as
+ the activity before them are left out when serializing. `serializedDataForObjects:` writes
+ compact JSON directly, without creating a dictionary for each activity.
  */
 ORK_CLASS_AVAILABLE
 @interface ORKMotionActivityCollector : ORKCollector
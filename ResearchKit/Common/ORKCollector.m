@@ -36,6 +36,7 @@
 #import "CMMotionActivity+ORKJSONDictionary.h"
 #import "ORKHealthSampleQueryOperation.h"
 #import "ORKMotionActivityQueryOperation.h"
+#import "ORKMotionActivityEncoder.h"
 #import <CoreMotion/CoreMotion.h>
 
 
@@ -320,18 +321,54 @@ static NSString *const ItemIdentifierFormatWithTwoPlaceholders = @"org.researchk
     ORK_ENCODE_OBJ(aCoder, lastDate);
 }
 
+static ORKMotionActivitySample ORKMotionActivitySampleFromActivity(CMMotionActivity *activity) {
+    ORKMotionActivityStates states = 0;
+    states |= activity.unknown ? ORKMotionActivityStateUnknown : 0;
+    states |= activity.stationary ? ORKMotionActivityStateStationary : 0;
+    states |= activity.walking ? ORKMotionActivityStateWalking : 0;
+    states |= activity.running ? ORKMotionActivityStateRunning : 0;
+    states |= activity.automotive ? ORKMotionActivityStateAutomotive : 0;
+    return (ORKMotionActivitySample){ activity.startDate.timeIntervalSince1970, states, (ORKMotionActivityConfidence)activity.confidence };
+}
+
+// Activities are written straight to compact JSON, leaving out those with the same state as the
+// activity before them.
+- (NSData *)serializedDataForObjects:(NSArray<CMMotionActivity *> *)objects {
+    ORKMotionActivityEncoder *encoder = ORKMotionActivityEncoderCreate();
+    if (!encoder) {
+        [NSException raise:NSMallocException format:@"Error allocating motion activity encoder"];
+        return nil;
+    }
+    for (CMMotionActivity *activity in objects) {
+        ORKMotionActivityEncoderAppend(encoder, ORKMotionActivitySampleFromActivity(activity));
+    }
+    size_t length = 0;
+    const uint8_t *bytes = ORKMotionActivityEncoderFinish(encoder, &length);
+    NSData *data = bytes ? [NSData dataWithBytes:bytes length:length] : nil;
+    ORKMotionActivityEncoderDestroy(encoder);
+    if (!data) {
+        [NSException raise:NSMallocException format:@"Error serializing %@ motion activities", @(objects.count)];
+    }
+    return data;
+}
+
 - (NSArray *)serializableObjectsForObjects:(NSArray<CMMotionActivity *> *)objects {
     // Expect an array of CMMotionActivity objects
     NSMutableArray *elements = [NSMutableArray arrayWithCapacity:[objects count]];
+    CMMotionActivity *previousActivity = nil;
     for (CMMotionActivity *activity in objects) {
+        if (previousActivity && [activity ork_hasSameStateAsActivity:previousActivity]) {
+            continue;
+        }
         [elements addObject:[activity ork_JSONDictionary]];
+        previousActivity = activity;
     }
     
     return elements;
 }
 
 - (ORKOperation *)collectionOperationWithManager:(ORKDataCollectionManager *)mananger {
-    if (! [CMMotionActivityManager isActivityAvailable]) {
+    if (!mananger.motionActivitySource) {
         return nil;
     }
     
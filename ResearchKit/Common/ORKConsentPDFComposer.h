@@ -0,0 +1,127 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ One captioned field in a row of signature fields: a line with text or an image above it and a
+ caption below it.
+ */
+@interface ORKConsentPDFSignatureField : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithCaption:(NSString *)caption text:(nullable NSString *)text;
+
+/**
+ Returns a field showing `pixelWidth` by `pixelHeight` 8-bit gray pixels, rows top to bottom.
+ Pass nil pixels for an empty field that is still to be signed.
+ */
+- (instancetype)initWithCaption:(NSString *)caption
+                grayscalePixels:(nullable NSData *)pixels
+                     pixelWidth:(NSUInteger)pixelWidth
+                    pixelHeight:(NSUInteger)pixelHeight NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, copy, readonly) NSString *caption;
+
+@property (nonatomic, copy, readonly, nullable) NSString *text;
+
+@property (nonatomic, copy, readonly, nullable) NSData *grayscalePixels;
+
+@property (nonatomic, readonly) NSUInteger pixelWidth;
+
+@property (nonatomic, readonly) NSUInteger pixelHeight;
+
+@end
+
+
+/**
+ Lays out consent document content and streams the resulting PDF to a file descriptor.
+ 
+ Content is added in reading order. Each page is written out as soon as the next block no
+ longer fits on it, so the memory used does not depend on the length of the document. The layout
+ follows the print style sheet of `ORKConsentDocument`: Helvetica text, headings one to four, and
+ rows of up to three signature fields. Text is set in the WinAnsi character set; characters
+ outside it are replaced.
+ 
+ The composer uses Foundation only, so it can run on any queue.
+ */
+@interface ORKConsentPDFComposer : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Returns a composer writing pages of the given size, in points, to `fileDescriptor`, which the
+ composer does not close.
+ */
+- (instancetype)initWithFileDescriptor:(int)fileDescriptor pageWidth:(double)pageWidth pageHeight:(double)pageHeight NS_DESIGNATED_INITIALIZER;
+
+/**
+ A format taking the page number and the page count as `long` arguments, used for a centered
+ footer on every page. Set it before adding content.
+ */
+@property (nonatomic, copy, nullable) NSString *pageNumberFormat;
+
+@property (nonatomic, readonly) NSUInteger numberOfPages;
+
+/**
+ Adds a heading of `level` 1 to 4, matching the `h1` to `h4` elements of the HTML document.
+ */
+- (void)addHeading:(NSString *)text level:(NSInteger)level;
+
+/**
+ Adds a paragraph. Line breaks in `text` start new lines.
+ */
+- (void)addParagraph:(NSString *)text;
+
+/**
+ Starts a new page, unless nothing has been drawn on the current one.
+ */
+- (void)addPageBreak;
+
+/**
+ Adds a row of signature fields. Fields beyond the third start another row.
+ */
+- (void)addSignatureFields:(NSArray<ORKConsentPDFSignatureField *> *)fields;
+
+/**
+ Ends the last page and writes the page tree and cross-reference table.
+ 
+ Returns NO and sets `error` if any write failed, in which case the output is incomplete.
+ */
+- (BOOL)finishWithError:(NSError * _Nullable *)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
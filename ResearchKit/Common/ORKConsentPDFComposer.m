@@ -0,0 +1,365 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKConsentPDFComposer.h"
+
+#import "ORKPDFStream.h"
+
+#import "ORKHelpers_Internal.h"
+
+
+static const double PageEdge = 72.0 / 4;
+static const double HeaderHeight = 25.0;
+static const double FooterHeight = 25.0;
+static const double FooterFontSize = 12.0;
+
+// Helvetica's ascender and descender are 0.718 and 0.207 em; half of the remaining leading goes above the ascender.
+static const double LineHeightMultiple = 1.2;
+static const double BaselineMultiple = (LineHeightMultiple - 0.718 - 0.207) / 2 + 0.718;
+
+static const double SignatureColumnPadding = 20.0;
+static const double SignatureRowMarginTop = 36.0;
+static const double SignatureBoxHeight = 50.0;
+static const double SignatureTextGap = 6.0;
+static const double SignatureRuleWidth = 1.0;
+static const double SignatureCaptionGap = 4.0;
+static const double SignatureCaptionFontSize = 12.0;
+
+typedef struct {
+    ORKPDFFont font;
+    double fontSize;
+    double marginTop;
+    double marginBottom;
+    BOOL centered;
+} ORKConsentPDFTextStyle;
+
+// Mirrors the WebKit defaults for `h1` to `h4` and `p`, with the document's print style sheet applied.
+static ORKConsentPDFTextStyle ORKConsentPDFHeadingStyle(NSInteger level) {
+    switch (level) {
+        case 1:
+            return (ORKConsentPDFTextStyle){ ORKPDFFontHelveticaBold, 24.0, 16.08, 16.08, YES };
+        case 2:
+            return (ORKConsentPDFTextStyle){ ORKPDFFontHelveticaBold, 18.0, 54.0, 14.94, YES };
+        case 3:
+            return (ORKConsentPDFTextStyle){ ORKPDFFontHelveticaBold, 14.0, 42.0, 14.0, NO };
+        default:
+            return (ORKConsentPDFTextStyle){ ORKPDFFontHelveticaBold, 12.0, 15.96, 15.96, NO };
+    }
+}
+
+static const ORKConsentPDFTextStyle ORKConsentPDFParagraphStyle = { ORKPDFFontHelvetica, 12.0, 12.0, 12.0, NO };
+
+static NSData *ORKConsentPDFEncodedText(NSString *text) {
+    return [text dataUsingEncoding:NSWindowsCP1252StringEncoding allowLossyConversion:YES] ? : [NSData data];
+}
+
+// Returns the end of the longest run of whole words from `start` that fits in `width`, or of as
+// many characters as fit if not even the first word does.
+static size_t ORKConsentPDFLineEnd(const uint8_t *bytes, size_t start, size_t end, ORKPDFFont font, double fontSize, double width) {
+    double lineWidth = 0;
+    size_t lastBreak = start;
+    for (size_t index = start; index < end; index++) {
+        if (bytes[index] == ' ') {
+            lastBreak = index;
+        }
+        lineWidth += ORKPDFFontTextWidth(font, fontSize, bytes + index, 1);
+        if (lineWidth > width && index > start) {
+            return (lastBreak > start) ? lastBreak : index;
+        }
+    }
+    return end;
+}
+
+static size_t ORKConsentPDFComposerFooter(void *context, size_t pageIndex, size_t pageCount, uint8_t *buffer, size_t capacity) {
+    NSString *format = (__bridge NSString *)context;
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wformat-nonliteral"
+    NSString *footer = [NSString stringWithFormat:format, (long)(pageIndex + 1), (long)pageCount];
+#pragma clang diagnostic pop
+    NSData *data = ORKConsentPDFEncodedText(footer);
+    size_t length = MIN(data.length, capacity);
+    memcpy(buffer, data.bytes, length);
+    return length;
+}
+
+
+@implementation ORKConsentPDFSignatureField
+
+- (instancetype)init {
+    ORKThrowMethodUnavailableException();
+}
+
+- (instancetype)initWithCaption:(NSString *)caption text:(NSString *)text {
+    self = [self initWithCaption:caption grayscalePixels:nil pixelWidth:0 pixelHeight:0];
+    if (self) {
+        _text = [text copy];
+    }
+    return self;
+}
+
+- (instancetype)initWithCaption:(NSString *)caption grayscalePixels:(NSData *)pixels pixelWidth:(NSUInteger)pixelWidth pixelHeight:(NSUInteger)pixelHeight {
+    NSParameterAssert(pixels == nil || pixels.length >= pixelWidth * pixelHeight);
+    self = [super init];
+    if (self) {
+        _caption = [caption copy];
+        _grayscalePixels = [pixels copy];
+        _pixelWidth = pixelWidth;
+        _pixelHeight = pixelHeight;
+    }
+    return self;
+}
+
+@end
+
+
+@implementation ORKConsentPDFComposer {
+    ORKPDFStream *_stream;
+    double _pageWidth;
+    double _pageHeight;
+    BOOL _pageOpen;
+    BOOL _pageEmpty;
+    BOOL _finished;
+    
+    // Distance of the next block from the top of the page, before its top margin.
+    double _cursor;
+    double _pendingMargin;
+}
+
+- (instancetype)init {
+    ORKThrowMethodUnavailableException();
+}
+
+- (instancetype)initWithFileDescriptor:(int)fileDescriptor pageWidth:(double)pageWidth pageHeight:(double)pageHeight {
+    self = [super init];
+    if (self) {
+        _stream = ORKPDFStreamCreate(fileDescriptor);
+        if (!_stream) {
+            @throw [NSException exceptionWithName:NSMallocException reason:@"Cannot allocate the PDF stream" userInfo:nil];
+        }
+        _pageWidth = pageWidth;
+        _pageHeight = pageHeight;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    ORKPDFStreamDestroy(_stream);
+}
+
+- (void)setPageNumberFormat:(NSString *)pageNumberFormat {
+    _pageNumberFormat = [pageNumberFormat copy];
+    double baseline = PageEdge + (FooterHeight - FooterFontSize * 0.718) / 2;
+    ORKPDFStreamSetFooter(_stream,
+                          _pageNumberFormat ? ORKConsentPDFComposerFooter : NULL,
+                          (__bridge void *)_pageNumberFormat,
+                          ORKPDFFontHelvetica,
+                          FooterFontSize,
+                          baseline);
+}
+
+- (NSUInteger)numberOfPages {
+    return ORKPDFStreamPageCount(_stream);
+}
+
+#pragma mark - Layout
+
+- (double)contentLeft {
+    return PageEdge;
+}
+
+- (double)contentWidth {
+    return _pageWidth - 2 * PageEdge;
+}
+
+- (double)contentBottom {
+    return _pageHeight - PageEdge - FooterHeight;
+}
+
+- (void)beginPageIfNeeded {
+    if (!_pageOpen) {
+        ORKPDFStreamBeginPage(_stream, _pageWidth, _pageHeight);
+        _pageOpen = YES;
+        _pageEmpty = YES;
+        _cursor = PageEdge + HeaderHeight;
+        _pendingMargin = 0;
+    }
+}
+
+- (void)endPage {
+    if (_pageOpen) {
+        ORKPDFStreamEndPage(_stream);
+        _pageOpen = NO;
+    }
+}
+
+// Returns the top of a box of `height` placed below the previous block, starting a new page if it
+// does not fit on this one. Adjacent margins collapse, and a margin at the top of a page is dropped.
+- (double)placeBoxWithHeight:(double)height marginTop:(double)marginTop {
+    [self beginPageIfNeeded];
+    double margin = _pageEmpty ? 0 : MAX(_pendingMargin, marginTop);
+    if (!_pageEmpty && _cursor + margin + height > [self contentBottom]) {
+        [self endPage];
+        [self beginPageIfNeeded];
+        margin = 0;
+    }
+    double top = _cursor + margin;
+    _cursor = top + height;
+    _pendingMargin = 0;
+    _pageEmpty = NO;
+    return top;
+}
+
+- (void)showText:(const uint8_t *)bytes length:(size_t)length font:(ORKPDFFont)font fontSize:(double)fontSize x:(double)x baseline:(double)baseline {
+    if (length > 0) {
+        ORKPDFStreamShowText(_stream, font, fontSize, x, _pageHeight - baseline, bytes, length);
+    }
+}
+
+- (void)addText:(NSString *)text style:(ORKConsentPDFTextStyle)style {
+    NSData *data = ORKConsentPDFEncodedText(text);
+    const uint8_t *bytes = data.bytes;
+    size_t length = data.length;
+    if (length == 0) {
+        return;
+    }
+    
+    double lineHeight = style.fontSize * LineHeightMultiple;
+    double width = [self contentWidth];
+    double marginTop = style.marginTop;
+    size_t paragraphStart = 0;
+    while (paragraphStart <= length) {
+        size_t paragraphEnd = paragraphStart;
+        while (paragraphEnd < length && bytes[paragraphEnd] != '\n') {
+            paragraphEnd++;
+        }
+        size_t lineStart = paragraphStart;
+        do {
+            size_t lineEnd = ORKConsentPDFLineEnd(bytes, lineStart, paragraphEnd, style.font, style.fontSize, width);
+            size_t visibleEnd = lineEnd;
+            while (visibleEnd > lineStart && (bytes[visibleEnd - 1] == ' ' || bytes[visibleEnd - 1] == '\r')) {
+                visibleEnd--;
+            }
+            
+            double top = [self placeBoxWithHeight:lineHeight marginTop:marginTop];
+            marginTop = 0;
+            double x = [self contentLeft];
+            if (style.centered) {
+                x += (width - ORKPDFFontTextWidth(style.font, style.fontSize, bytes + lineStart, visibleEnd - lineStart)) / 2;
+            }
+            [self showText:bytes + lineStart length:visibleEnd - lineStart font:style.font fontSize:style.fontSize x:x baseline:top + style.fontSize * BaselineMultiple];
+            
+            lineStart = lineEnd;
+            while (lineStart < paragraphEnd && bytes[lineStart] == ' ') {
+                lineStart++;
+            }
+        } while (lineStart < paragraphEnd);
+        paragraphStart = paragraphEnd + 1;
+    }
+    _pendingMargin = style.marginBottom;
+}
+
+- (void)drawSignatureField:(ORKConsentPDFSignatureField *)field left:(double)left top:(double)top width:(double)width {
+    double rule = top + SignatureBoxHeight;
+    ORKPDFStreamStrokeLine(_stream, left, _pageHeight - rule, left + width, _pageHeight - rule, SignatureRuleWidth);
+    
+    if (field.grayscalePixels && field.pixelWidth > 0 && field.pixelHeight > 0) {
+        // Fit the image to the box, keeping its aspect ratio, and stand it on the rule.
+        double maxHeight = SignatureBoxHeight - SignatureTextGap;
+        double scale = MIN(width / field.pixelWidth, maxHeight / field.pixelHeight);
+        double imageWidth = field.pixelWidth * scale;
+        double imageHeight = field.pixelHeight * scale;
+        double bottom = rule - SignatureTextGap / 2;
+        ORKPDFStreamDrawGrayImage(_stream, field.grayscalePixels.bytes, field.pixelWidth, field.pixelHeight,
+                                  left, _pageHeight - bottom, imageWidth, imageHeight);
+    } else if (field.text.length > 0) {
+        NSData *data = ORKConsentPDFEncodedText(field.text);
+        size_t length = ORKConsentPDFLineEnd(data.bytes, 0, data.length, ORKPDFFontHelvetica, ORKConsentPDFParagraphStyle.fontSize, width);
+        [self showText:data.bytes length:length font:ORKPDFFontHelvetica fontSize:ORKConsentPDFParagraphStyle.fontSize x:left baseline:rule - SignatureTextGap];
+    }
+    
+    NSData *caption = ORKConsentPDFEncodedText(field.caption);
+    size_t captionLength = ORKConsentPDFLineEnd(caption.bytes, 0, caption.length, ORKPDFFontHelvetica, SignatureCaptionFontSize, width);
+    double captionBaseline = rule + SignatureCaptionGap + SignatureCaptionFontSize * BaselineMultiple;
+    [self showText:caption.bytes length:captionLength font:ORKPDFFontHelvetica fontSize:SignatureCaptionFontSize x:left baseline:captionBaseline];
+}
+
+#pragma mark - Content
+
+- (void)addHeading:(NSString *)text level:(NSInteger)level {
+    [self addText:text style:ORKConsentPDFHeadingStyle(level)];
+}
+
+- (void)addParagraph:(NSString *)text {
+    [self addText:text style:ORKConsentPDFParagraphStyle];
+}
+
+- (void)addPageBreak {
+    if (_pageOpen && !_pageEmpty) {
+        [self endPage];
+    }
+}
+
+- (void)addSignatureFields:(NSArray<ORKConsentPDFSignatureField *> *)fields {
+    static const NSUInteger ColumnCount = 3;
+    double columnWidth = [self contentWidth] / ColumnCount;
+    double rowHeight = SignatureBoxHeight + SignatureCaptionGap + SignatureCaptionFontSize * LineHeightMultiple;
+    for (NSUInteger rowStart = 0; rowStart < fields.count; rowStart += ColumnCount) {
+        double top = [self placeBoxWithHeight:rowHeight marginTop:SignatureRowMarginTop];
+        NSUInteger rowEnd = MIN(rowStart + ColumnCount, fields.count);
+        for (NSUInteger index = rowStart; index < rowEnd; index++) {
+            double left = [self contentLeft] + (index - rowStart) * columnWidth;
+            [self drawSignatureField:fields[index] left:left top:top width:columnWidth - SignatureColumnPadding];
+        }
+    }
+}
+
+- (BOOL)finishWithError:(NSError **)error {
+    if (!_finished) {
+        _finished = YES;
+        if (ORKPDFStreamPageCount(_stream) == 0) {
+            // A document has at least one page, even an empty one.
+            [self beginPageIfNeeded];
+        }
+        [self endPage];
+        ORKPDFStreamFinish(_stream);
+    }
+    
+    int code = ORKPDFStreamError(_stream);
+    if (code != 0) {
+        if (error) {
+            *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:code userInfo:nil];
+        }
+        return NO;
+    }
+    return YES;
+}
+
+@end
@@ -78,6 +78,10 @@ NS_ASSUME_NONNULL_BEGIN
 /**
  Method for delivering the collected motion activities.
  
+ Activities are queried and delivered in windows of time, sized so that each holds a bounded number
+ of activities. Activities with the same states and confidence as the activity delivered before
+ them are left out.
+ 
  @param collector           The data collector.
  @param motionActivities    Collected motion activities.
  
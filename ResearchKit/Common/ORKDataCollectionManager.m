@@ -41,6 +41,15 @@
 
 static  NSString *const ORKDataCollectionPersistenceFileName = @".dataCollection.ork.data";
 
+@interface CMMotionActivityManager (ORKMotionActivitySource) <ORKMotionActivitySource>
+
+@end
+
+@implementation CMMotionActivityManager (ORKMotionActivitySource)
+
+@end
+
+
 @implementation ORKDataCollectionManager {
     dispatch_queue_t _queue;
     NSOperationQueue *_operationQueue;
@@ -90,6 +99,7 @@ static  NSString *const ORKDataCollectionPersistenceFileName = @".dataCollection
         NSString *queueId = [@"ResearchKit.DataCollection." stringByAppendingString:_managedDirectory];
         _queue = dispatch_queue_create([queueId cStringUsingEncoding:NSUTF8StringEncoding], DISPATCH_QUEUE_SERIAL);
         _operationQueue = [[NSOperationQueue alloc] init];
+        _motionActivityWindowPolicy = (ORKMotionActivityWindowPolicy){ .minimumDuration = 15 * 60, .maximumDuration = 7 * 24 * 60 * 60, .targetCount = 2000 };
     }
     return self;
 }
@@ -138,6 +148,10 @@ static inline void dispatch_sync_if_not_on_queue(dispatch_queue_t queue, dispatc
     return _activityManager;
 }
 
+- (id<ORKMotionActivitySource>)motionActivitySource {
+    return _motionActivitySource ? : self.activityManager;
+}
+
 - (NSArray<ORKCollector *> *)collectors {
     if (_collectors == nil) {
         NSData *data = [NSData dataWithContentsOfFile:[self persistFilePath]];
@@ -30,6 +30,7 @@
 
 
 #import "ORKDataCollectionManager.h"
+#import "ORKDataCollectionManager_Private.h"
 #import <CoreMotion/CoreMotion.h>
 
 
@@ -0,0 +1,77 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <ResearchKit/ORKDataCollectionManager.h>
+#import <ResearchKit/ORKMotionActivityEncoder.h>
+#import <CoreMotion/CoreMotion.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A source of motion activities, such as a `CMMotionActivityManager` object.
+ */
+@protocol ORKMotionActivitySource <NSObject>
+
+/**
+ Queries the activities between two dates, as `-[CMMotionActivityManager queryActivityStartingFromDate:toDate:toQueue:withHandler:]` does.
+ 
+ The activities are ordered by start date, and the first may be the activity in progress at the start date.
+ */
+- (void)queryActivityStartingFromDate:(NSDate *)start
+                               toDate:(NSDate *)end
+                              toQueue:(NSOperationQueue *)queue
+                          withHandler:(CMMotionActivityQueryHandler)handler;
+
+@end
+
+
+@interface ORKDataCollectionManager ()
+
+/**
+ The source of the motion activities collected by motion activity collectors.
+ 
+ The default value is a `CMMotionActivityManager` object, or `nil` if motion activity is not
+ available on the device. Set a different source to collect activities without CoreMotion.
+ */
+@property (nonatomic, strong, nullable) id<ORKMotionActivitySource> motionActivitySource;
+
+/**
+ The sizing of the windows in which motion activities are queried.
+ 
+ The first window is 6 hours long. The default policy aims for 2000 activities per window, with
+ windows between 15 minutes and 7 days long.
+ */
+@property (nonatomic) ORKMotionActivityWindowPolicy motionActivityWindowPolicy;
+
+@end
+
+NS_ASSUME_NONNULL_END
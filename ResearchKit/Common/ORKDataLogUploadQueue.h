@@ -0,0 +1,171 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ORKDataLoggerManager;
+
+/**
+ Moves chunks and manifests of finished logs to a server.
+ 
+ Chunks are content addressed: a transport may answer a chunk whose hash it already holds without
+ storing it again. Finishing a log must be idempotent for a given identifier, because a queue that
+ stops between the server's acknowledgement and its own journal write finishes the log again.
+ 
+ Completion handlers may be called on any queue, but each must be called exactly once.
+ */
+@protocol ORKDataLogUploadTransport <NSObject>
+
+/// Sends one chunk of a log. `contentHash` is the lowercase hexadecimal SHA-256 digest of `data`.
+- (void)uploadChunkWithContentHash:(NSString *)contentHash
+                              data:(NSData *)data
+                        completion:(void (^)(NSError * _Nullable error))completion;
+
+/**
+ Commits a log whose chunks have all been acknowledged.
+ 
+ The manifest lists the log's file name, length, SHA-256 digest, chunk size and chunks in the same
+ format as `-[ORKMediaArtifact manifestDictionary]`, so the server can assemble the file from the
+ chunks it holds.
+ */
+- (void)finishLogWithIdentifier:(NSString *)identifier
+                       manifest:(NSDictionary<NSString *, id> *)manifest
+                     completion:(void (^)(NSError * _Nullable error))completion;
+
+@end
+
+
+/**
+ Uploads the finished logs of an `ORKDataLoggerManager` through a transport.
+ 
+ Each pass enumerates the logs that are not yet marked uploaded, oldest first, and streams every
+ log through a fixed-size buffer, digesting and sending it chunk by chunk. Acknowledged chunks and
+ finished logs are appended to a journal file, so a queue created after a crash or cancellation
+ resumes where the last one stopped and skips the chunks the server already holds. A log is marked
+ uploaded only after the server has committed it; if the queue stops between the two, the next pass
+ marks it from the journal without sending it again.
+ 
+ Failed requests are retried with exponential backoff and jitter. When a request still fails after
+ `maximumAttemptCount` attempts, the pass stops and reports the transport's error.
+ */
+@interface ORKDataLogUploadQueue : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Creates a queue.
+ 
+ @param manager     The manager whose logs are uploaded.
+ @param transport   The transport that sends chunks and manifests.
+ @param journalURL  The file in which upload progress is kept. A hidden file in the manager's
+                    directory is not mistaken for a log.
+ */
+- (instancetype)initWithDataLoggerManager:(ORKDataLoggerManager *)manager
+                                transport:(id<ORKDataLogUploadTransport>)transport
+                               journalURL:(NSURL *)journalURL NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, strong, readonly) ORKDataLoggerManager *dataLoggerManager;
+
+@property (nonatomic, strong, readonly) id<ORKDataLogUploadTransport> transport;
+
+@property (nonatomic, copy, readonly) NSURL *journalURL;
+
+/// The chunk size of new uploads. Defaults to 4 MiB. Logs already in progress keep their chunks.
+@property (nonatomic) uint64_t chunkSize;
+
+/// The number of times a request is sent before the pass gives up. Defaults to 5.
+@property (nonatomic) NSUInteger maximumAttemptCount;
+
+/// The delay before the first retry, which doubles on every later retry. Defaults to 1 second.
+@property (nonatomic) NSTimeInterval initialRetryInterval;
+
+/// The longest delay between retries. Defaults to 60 seconds.
+@property (nonatomic) NSTimeInterval maximumRetryInterval;
+
+/// Whether logs are removed once they are marked uploaded. Defaults to `NO`.
+@property (nonatomic) BOOL removesUploadedLogs;
+
+/// Whether a pass is in progress.
+@property (nonatomic, readonly, getter=isUploading) BOOL uploading;
+
+/**
+ Uploads every log that needs upload.
+ 
+ If a pass is already in progress, the completion is called when that pass ends.
+ 
+ @param completion  Called on the main queue with the number of logs marked uploaded during the pass,
+                    and the error that stopped the pass, if any.
+ */
+- (void)uploadPendingLogsWithCompletion:(nullable void (^)(NSUInteger uploadedLogCount, NSError * _Nullable error))completion;
+
+/// Stops the current pass, leaving its progress in the journal. Its completion receives `NSUserCancelledError`.
+- (void)cancel;
+
+@end
+
+
+/**
+ A transport that keeps chunks and manifests in memory, for tests.
+ 
+ Chunks are stored once per hash. Completions are called asynchronously on a private queue.
+ */
+@interface ORKLoopbackDataLogUploadTransport : NSObject <ORKDataLogUploadTransport>
+
+/**
+ Called before every request with the log identifier for finish requests or the chunk hash for chunk
+ requests. Returning an error fails the request without storing anything.
+ */
+@property (copy, nullable) NSError * _Nullable (^requestHandler)(NSString * _Nullable identifier, NSString * _Nullable contentHash);
+
+/// The number of chunk requests received, including failed and duplicate ones.
+@property (nonatomic, readonly) NSUInteger chunkRequestCount;
+
+/// The number of finish requests received, including failed ones.
+@property (nonatomic, readonly) NSUInteger finishRequestCount;
+
+/// The number of distinct chunks stored.
+@property (nonatomic, readonly) NSUInteger storedChunkCount;
+
+/// The identifiers of committed logs.
+@property (nonatomic, copy, readonly) NSArray<NSString *> *finishedLogIdentifiers;
+
+/// The committed manifest for `identifier`.
+- (nullable NSDictionary<NSString *, id> *)manifestForLogIdentifier:(NSString *)identifier;
+
+/// Reassembles a committed log from its manifest and the stored chunks, or returns `nil` if a chunk is missing.
+- (nullable NSData *)dataForLogIdentifier:(NSString *)identifier;
+
+@end
+
+NS_ASSUME_NONNULL_END
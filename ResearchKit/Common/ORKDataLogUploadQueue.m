@@ -0,0 +1,828 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKDataLogUploadQueue.h"
+
+#import "ORKDataLogger.h"
+#import "ORKErrors.h"
+#import "ORKHelpers_Internal.h"
+
+#import <CommonCrypto/CommonDigest.h>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+static const uint64_t ORKDataLogUploadDefaultChunkSize = 4 * 1024 * 1024;
+static const NSUInteger ORKDataLogUploadDefaultMaximumAttemptCount = 5;
+static const NSTimeInterval ORKDataLogUploadDefaultInitialRetryInterval = 1;
+static const NSTimeInterval ORKDataLogUploadDefaultMaximumRetryInterval = 60;
+
+static NSString *const ORKDataLogUploadJournalChunkRecord = @"chunk";
+static NSString *const ORKDataLogUploadJournalFinishedRecord = @"done";
+
+static NSString *ORKDataLogUploadHexDigest(const unsigned char digest[CC_SHA256_DIGEST_LENGTH]) {
+    static const char hexDigits[] = "0123456789abcdef";
+    char hex[CC_SHA256_DIGEST_LENGTH * 2];
+    for (NSUInteger index = 0; index < CC_SHA256_DIGEST_LENGTH; index++) {
+        hex[2 * index] = hexDigits[digest[index] >> 4];
+        hex[2 * index + 1] = hexDigits[digest[index] & 0xF];
+    }
+    return [[NSString alloc] initWithBytes:hex length:sizeof(hex) encoding:NSASCIIStringEncoding];
+}
+
+static NSString *ORKDataLogUploadDataDigest(NSData *data) {
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, digest);
+    return ORKDataLogUploadHexDigest(digest);
+}
+
+static NSError *ORKDataLogUploadPOSIXError(int code, NSURL *fileURL) {
+    return [NSError errorWithDomain:NSPOSIXErrorDomain
+                               code:code
+                           userInfo:@{NSURLErrorKey: fileURL, NSFilePathErrorKey: fileURL.path ?: @""}];
+}
+
+static NSTimeInterval ORKDataLogUploadRetryDelay(NSUInteger attempt, NSTimeInterval initialInterval, NSTimeInterval maximumInterval) {
+    NSTimeInterval delay = MIN(maximumInterval, initialInterval * pow(2, MIN(attempt, 32)));
+    // Jitter between half and all of the delay keeps queues that failed together from retrying together.
+    return delay * (0.5 + 0.5 * arc4random_uniform(1001) / 1000.0);
+}
+
+
+/// The progress of one log, as recovered from the journal.
+@interface ORKDataLogUploadJournalEntry : NSObject
+
+@property (nonatomic) uint64_t chunkSize;
+
+@property (nonatomic, strong, readonly) NSMutableDictionary<NSNumber *, NSString *> *chunkHashes;
+
+/// The digest of the log once the server has committed it.
+@property (nonatomic, copy) NSString *finishedContentHash;
+
+@end
+
+
+@implementation ORKDataLogUploadJournalEntry
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _chunkHashes = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+@end
+
+
+/*
+ The journal is a text file with one tab-separated record per line:
+ 
+     chunk  <file name>  <chunk size>  <chunk index>  <chunk digest>
+     done   <file name>  <file digest>
+ 
+ Records are appended with a single write as they happen, and the file is rewritten with only the
+ live records when a pass starts and ends. A line torn by a crash has no newline and is ignored;
+ later records for the same chunk win.
+ */
+@interface ORKDataLogUploadJournal : NSObject
+
+- (instancetype)initWithURL:(NSURL *)url;
+
+@property (nonatomic, readonly, getter=isLoaded) BOOL loaded;
+
+- (BOOL)loadWithError:(NSError **)error;
+
+- (ORKDataLogUploadJournalEntry *)entryForFileName:(NSString *)fileName;
+
+- (BOOL)appendChunkForFileName:(NSString *)fileName
+                     chunkSize:(uint64_t)chunkSize
+                         index:(NSUInteger)index
+                   contentHash:(NSString *)contentHash
+                         error:(NSError **)error;
+
+- (BOOL)appendFinishedFileName:(NSString *)fileName contentHash:(NSString *)contentHash error:(NSError **)error;
+
+- (void)removeEntryForFileName:(NSString *)fileName;
+
+/// Rewrites the journal with the entries of `fileNames`, or with every entry if `fileNames` is `nil`.
+- (BOOL)compactKeepingFileNames:(NSSet<NSString *> *)fileNames error:(NSError **)error;
+
+- (void)close;
+
+@end
+
+
+@implementation ORKDataLogUploadJournal {
+    NSURL *_url;
+    NSMutableDictionary<NSString *, ORKDataLogUploadJournalEntry *> *_entries;
+    int _fd;
+}
+
+- (instancetype)initWithURL:(NSURL *)url {
+    self = [super init];
+    if (self) {
+        _url = [url copy];
+        _entries = [NSMutableDictionary dictionary];
+        _fd = -1;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self close];
+}
+
+- (void)close {
+    if (_fd >= 0) {
+        close(_fd);
+        _fd = -1;
+    }
+}
+
+- (BOOL)loadWithError:(NSError **)error {
+    NSError *readError = nil;
+    NSData *data = [NSData dataWithContentsOfURL:_url options:NSDataReadingUncached error:&readError];
+    if (!data) {
+        if ([readError.domain isEqualToString:NSCocoaErrorDomain] && readError.code == NSFileReadNoSuchFileError) {
+            _loaded = YES;
+            return YES;
+        }
+        if (error) {
+            *error = readError;
+        }
+        return NO;
+    }
+    
+    const char *bytes = data.bytes;
+    const char *end = bytes + data.length;
+    const char *line = bytes;
+    while (line < end) {
+        const char *newline = memchr(line, '\n', (size_t)(end - line));
+        if (!newline) {
+            break;
+        }
+        NSString *string = [[NSString alloc] initWithBytes:line length:(NSUInteger)(newline - line) encoding:NSUTF8StringEncoding];
+        [self applyRecord:[string componentsSeparatedByString:@"\t"]];
+        line = newline + 1;
+    }
+    _loaded = YES;
+    return YES;
+}
+
+- (void)applyRecord:(NSArray<NSString *> *)fields {
+    if (fields.count == 5 && [fields[0] isEqualToString:ORKDataLogUploadJournalChunkRecord]) {
+        uint64_t chunkSize = strtoull(fields[2].UTF8String, NULL, 10);
+        if (chunkSize == 0) {
+            return;
+        }
+        ORKDataLogUploadJournalEntry *entry = [self entryCreatingForFileName:fields[1]];
+        if (entry.chunkSize != chunkSize) {
+            [entry.chunkHashes removeAllObjects];
+            entry.chunkSize = chunkSize;
+        }
+        entry.chunkHashes[@(strtoull(fields[3].UTF8String, NULL, 10))] = fields[4];
+    } else if (fields.count == 3 && [fields[0] isEqualToString:ORKDataLogUploadJournalFinishedRecord]) {
+        [self entryCreatingForFileName:fields[1]].finishedContentHash = fields[2];
+    }
+}
+
+- (ORKDataLogUploadJournalEntry *)entryCreatingForFileName:(NSString *)fileName {
+    ORKDataLogUploadJournalEntry *entry = _entries[fileName];
+    if (!entry) {
+        entry = [ORKDataLogUploadJournalEntry new];
+        _entries[fileName] = entry;
+    }
+    return entry;
+}
+
+- (ORKDataLogUploadJournalEntry *)entryForFileName:(NSString *)fileName {
+    return _entries[fileName];
+}
+
+- (BOOL)appendChunkForFileName:(NSString *)fileName
+                     chunkSize:(uint64_t)chunkSize
+                         index:(NSUInteger)index
+                   contentHash:(NSString *)contentHash
+                         error:(NSError **)error {
+    NSString *record = [NSString stringWithFormat:@"%@\t%@\t%llu\t%lu\t%@\n", ORKDataLogUploadJournalChunkRecord, fileName, chunkSize, (unsigned long)index, contentHash];
+    if (![self appendRecord:record error:error]) {
+        return NO;
+    }
+    ORKDataLogUploadJournalEntry *entry = [self entryCreatingForFileName:fileName];
+    if (entry.chunkSize != chunkSize) {
+        [entry.chunkHashes removeAllObjects];
+        entry.chunkSize = chunkSize;
+    }
+    entry.chunkHashes[@(index)] = contentHash;
+    return YES;
+}
+
+- (BOOL)appendFinishedFileName:(NSString *)fileName contentHash:(NSString *)contentHash error:(NSError **)error {
+    NSString *record = [NSString stringWithFormat:@"%@\t%@\t%@\n", ORKDataLogUploadJournalFinishedRecord, fileName, contentHash];
+    if (![self appendRecord:record error:error]) {
+        return NO;
+    }
+    [self entryCreatingForFileName:fileName].finishedContentHash = contentHash;
+    return YES;
+}
+
+- (BOOL)appendRecord:(NSString *)record error:(NSError **)error {
+    if (_fd < 0) {
+        _fd = open(_url.fileSystemRepresentation, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0600);
+        if (_fd < 0) {
+            if (error) {
+                *error = ORKDataLogUploadPOSIXError(errno, _url);
+            }
+            return NO;
+        }
+    }
+    
+    // A record goes out in one write, so a crash tears at most the last line.
+    const char *bytes = record.UTF8String;
+    size_t length = strlen(bytes);
+    ssize_t written;
+    do {
+        written = write(_fd, bytes, length);
+    } while (written < 0 && errno == EINTR);
+    if (written != (ssize_t)length) {
+        if (error) {
+            *error = ORKDataLogUploadPOSIXError(written < 0 ? errno : EIO, _url);
+        }
+        return NO;
+    }
+    return YES;
+}
+
+- (void)removeEntryForFileName:(NSString *)fileName {
+    [_entries removeObjectForKey:fileName];
+}
+
+- (BOOL)compactKeepingFileNames:(NSSet<NSString *> *)fileNames error:(NSError **)error {
+    [self close];
+    if (fileNames) {
+        for (NSString *fileName in _entries.allKeys) {
+            if (![fileNames containsObject:fileName]) {
+                [_entries removeObjectForKey:fileName];
+            }
+        }
+    }
+    
+    if (_entries.count == 0) {
+        NSError *removeError = nil;
+        if (![[NSFileManager defaultManager] removeItemAtURL:_url error:&removeError] &&
+            !([removeError.domain isEqualToString:NSCocoaErrorDomain] && removeError.code == NSFileNoSuchFileError)) {
+            if (error) {
+                *error = removeError;
+            }
+            return NO;
+        }
+        return YES;
+    }
+    
+    NSMutableString *contents = [NSMutableString string];
+    [_entries enumerateKeysAndObjectsUsingBlock:^(NSString *fileName, ORKDataLogUploadJournalEntry *entry, BOOL *stop) {
+        [entry.chunkHashes enumerateKeysAndObjectsUsingBlock:^(NSNumber *index, NSString *contentHash, BOOL *stop) {
+            [contents appendFormat:@"%@\t%@\t%llu\t%@\t%@\n", ORKDataLogUploadJournalChunkRecord, fileName, entry.chunkSize, index, contentHash];
+        }];
+        if (entry.finishedContentHash) {
+            [contents appendFormat:@"%@\t%@\t%@\n", ORKDataLogUploadJournalFinishedRecord, fileName, entry.finishedContentHash];
+        }
+    }];
+    return [[contents dataUsingEncoding:NSUTF8StringEncoding] writeToURL:_url options:NSDataWritingAtomic error:error];
+}
+
+@end
+
+
+@interface ORKDataLogUploadItem : NSObject
+
+@property (nonatomic, strong) ORKDataLogger *dataLogger;
+
+@property (nonatomic, copy) NSURL *fileURL;
+
+@end
+
+
+@implementation ORKDataLogUploadItem
+
+@end
+
+
+@implementation ORKDataLogUploadQueue {
+    dispatch_queue_t _queue;
+    ORKDataLogUploadJournal *_journal;
+    NSMutableArray *_completions;
+    BOOL _uploading;
+    
+    // Bumped when a pass ends, so that late transport callbacks and retries are dropped.
+    NSUInteger _generation;
+    
+    // The settings of the current pass.
+    uint64_t _passChunkSize;
+    NSUInteger _passMaximumAttemptCount;
+    NSTimeInterval _passInitialRetryInterval;
+    NSTimeInterval _passMaximumRetryInterval;
+    BOOL _passRemovesUploadedLogs;
+    
+    NSArray<ORKDataLogUploadItem *> *_items;
+    NSUInteger _itemIndex;
+    NSUInteger _uploadedLogCount;
+    
+    // The log being read.
+    int _fd;
+    uint64_t _fileLength;
+    uint64_t _offset;
+    uint64_t _logChunkSize;
+    NSUInteger _chunkIndex;
+    CC_SHA256_CTX _fileContext;
+    NSMutableArray<NSDictionary<NSString *, id> *> *_manifestChunks;
+}
+
+- (instancetype)init {
+    ORKThrowMethodUnavailableException();
+}
+
+- (instancetype)initWithDataLoggerManager:(ORKDataLoggerManager *)manager
+                                transport:(id<ORKDataLogUploadTransport>)transport
+                               journalURL:(NSURL *)journalURL {
+    self = [super init];
+    if (self) {
+        _dataLoggerManager = manager;
+        _transport = transport;
+        _journalURL = [journalURL copy];
+        _chunkSize = ORKDataLogUploadDefaultChunkSize;
+        _maximumAttemptCount = ORKDataLogUploadDefaultMaximumAttemptCount;
+        _initialRetryInterval = ORKDataLogUploadDefaultInitialRetryInterval;
+        _maximumRetryInterval = ORKDataLogUploadDefaultMaximumRetryInterval;
+        
+        NSString *queueId = [@"ResearchKit.DataLogUploadQueue." stringByAppendingString:journalURL.lastPathComponent];
+        _queue = dispatch_queue_create([queueId cStringUsingEncoding:NSUTF8StringEncoding], DISPATCH_QUEUE_SERIAL);
+        _journal = [[ORKDataLogUploadJournal alloc] initWithURL:_journalURL];
+        _completions = [NSMutableArray array];
+        _fd = -1;
+    }
+    return self;
+}
+
+- (BOOL)isUploading {
+    __block BOOL uploading = NO;
+    dispatch_sync(_queue, ^{
+        uploading = self->_uploading;
+    });
+    return uploading;
+}
+
+- (void)uploadPendingLogsWithCompletion:(void (^)(NSUInteger, NSError *))completion {
+    dispatch_async(_queue, ^{
+        if (completion) {
+            [self->_completions addObject:[completion copy]];
+        }
+        if (self->_uploading) {
+            return;
+        }
+        self->_uploading = YES;
+        [self queue_beginPass];
+    });
+}
+
+- (void)cancel {
+    dispatch_async(_queue, ^{
+        if (self->_uploading) {
+            [self queue_endPassWithError:[NSError errorWithDomain:NSCocoaErrorDomain code:NSUserCancelledError userInfo:nil]];
+        }
+    });
+}
+
+- (void)queue_beginPass {
+    _passChunkSize = MAX(_chunkSize, 1);
+    _passMaximumAttemptCount = MAX(_maximumAttemptCount, 1);
+    _passInitialRetryInterval = _initialRetryInterval;
+    _passMaximumRetryInterval = _maximumRetryInterval;
+    _passRemovesUploadedLogs = _removesUploadedLogs;
+    _uploadedLogCount = 0;
+    
+    NSError *error = nil;
+    if (!_journal.loaded && ![_journal loadWithError:&error]) {
+        [self queue_endPassWithError:error];
+        return;
+    }
+    
+    NSMutableArray<ORKDataLogUploadItem *> *items = [NSMutableArray array];
+    NSMutableSet<NSString *> *fileNames = [NSMutableSet set];
+    BOOL success = [_dataLoggerManager enumerateLogsNeedingUpload:^(ORKDataLogger *dataLogger, NSURL *logFileUrl, BOOL *stop) {
+        ORKDataLogUploadItem *item = [ORKDataLogUploadItem new];
+        item.dataLogger = dataLogger;
+        item.fileURL = logFileUrl;
+        [items addObject:item];
+        [fileNames addObject:logFileUrl.lastPathComponent];
+    } error:&error];
+    
+    // Drop the progress of logs that were marked uploaded or removed since the journal was written.
+    if (!success || ![_journal compactKeepingFileNames:fileNames error:&error]) {
+        [self queue_endPassWithError:error];
+        return;
+    }
+    
+    _items = [items copy];
+    _itemIndex = 0;
+    [self queue_startNextLog];
+}
+
+- (void)queue_startNextLog {
+    while (_itemIndex < _items.count) {
+        ORKDataLogUploadItem *item = _items[_itemIndex];
+        NSString *fileName = item.fileURL.lastPathComponent;
+        ORKDataLogUploadJournalEntry *entry = [_journal entryForFileName:fileName];
+        NSError *error = nil;
+        
+        if (entry.finishedContentHash) {
+            // The server committed this log before the last pass stopped.
+            if (![self queue_markItemUploaded:item error:&error]) {
+                [self queue_endPassWithError:error];
+                return;
+            }
+            _itemIndex++;
+            continue;
+        }
+        
+        _fd = open(item.fileURL.fileSystemRepresentation, O_RDONLY | O_CLOEXEC);
+        struct stat status;
+        if (_fd >= 0 && fstat(_fd, &status) != 0) {
+            int code = errno;
+            close(_fd);
+            _fd = -1;
+            errno = code;
+        }
+        if (_fd < 0) {
+            if (errno == ENOENT) {
+                // Removed since the enumeration, for instance to stay under the manager's thresholds.
+                [_journal removeEntryForFileName:fileName];
+                _itemIndex++;
+                continue;
+            }
+            [self queue_endPassWithError:ORKDataLogUploadPOSIXError(errno, item.fileURL)];
+            return;
+        }
+        
+        // Each byte is read once, so keep it out of the cache.
+        fcntl(_fd, F_NOCACHE, 1);
+        _fileLength = (uint64_t)status.st_size;
+        _offset = 0;
+        _chunkIndex = 0;
+        _logChunkSize = entry.chunkSize ?: _passChunkSize;
+        _manifestChunks = [NSMutableArray array];
+        CC_SHA256_Init(&_fileContext);
+        [self queue_sendNextChunk];
+        return;
+    }
+    [self queue_endPassWithError:nil];
+}
+
+- (NSData *)queue_readChunkWithError:(NSError **)error {
+    if (_offset >= _fileLength) {
+        return nil;
+    }
+    NSMutableData *data = [NSMutableData dataWithLength:(NSUInteger)MIN(_logChunkSize, _fileLength - _offset)];
+    uint8_t *bytes = data.mutableBytes;
+    size_t length = 0;
+    while (length < data.length) {
+        ssize_t count = pread(_fd, bytes + length, data.length - length, (off_t)(_offset + length));
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (error) {
+                *error = ORKDataLogUploadPOSIXError(errno, _items[_itemIndex].fileURL);
+            }
+            return nil;
+        }
+        if (count == 0) {
+            break;
+        }
+        length += (size_t)count;
+    }
+    if (length == 0) {
+        return nil;
+    }
+    data.length = length;
+    CC_SHA256_Update(&_fileContext, bytes, (CC_LONG)length);
+    return data;
+}
+
+- (void)queue_sendNextChunk {
+    ORKDataLogUploadItem *item = _items[_itemIndex];
+    NSString *fileName = item.fileURL.lastPathComponent;
+    ORKDataLogUploadJournalEntry *entry = [_journal entryForFileName:fileName];
+    
+    while (YES) {
+        // Skipped chunks are read in this loop, so release each one before reading the next.
+        @autoreleasepool {
+            NSError *error = nil;
+            NSData *chunk = [self queue_readChunkWithError:&error];
+            if (!chunk) {
+                if (error) {
+                    [self queue_endPassWithError:error];
+                } else {
+                    [self queue_finishLog];
+                }
+                return;
+            }
+            
+            NSString *contentHash = ORKDataLogUploadDataDigest(chunk);
+            NSUInteger index = _chunkIndex;
+            uint64_t chunkSize = _logChunkSize;
+            [_manifestChunks addObject:@{
+                @"offset": @(_offset),
+                @"length": @(chunk.length),
+                @"sha256": contentHash
+            }];
+            _offset += chunk.length;
+            _chunkIndex++;
+            
+            if ([entry.chunkHashes[@(index)] isEqualToString:contentHash]) {
+                // Acknowledged before the last pass stopped.
+                continue;
+            }
+            
+            id<ORKDataLogUploadTransport> transport = _transport;
+            [self queue_sendRequest:^(void (^completion)(NSError *)) {
+                [transport uploadChunkWithContentHash:contentHash data:chunk completion:completion];
+            } attempt:0 success:^{
+                NSError *journalError = nil;
+                if (![self->_journal appendChunkForFileName:fileName chunkSize:chunkSize index:index contentHash:contentHash error:&journalError]) {
+                    [self queue_endPassWithError:journalError];
+                    return;
+                }
+                [self queue_sendNextChunk];
+            }];
+            return;
+        }
+    }
+}
+
+- (void)queue_finishLog {
+    close(_fd);
+    _fd = -1;
+    
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256_Final(digest, &_fileContext);
+    NSString *contentHash = ORKDataLogUploadHexDigest(digest);
+    
+    ORKDataLogUploadItem *item = _items[_itemIndex];
+    NSString *fileName = item.fileURL.lastPathComponent;
+    NSDictionary *manifest = @{
+        @"fileName": fileName,
+        @"length": @(_offset),
+        @"sha256": contentHash,
+        @"chunkSize": @(_logChunkSize),
+        @"chunks": [_manifestChunks copy]
+    };
+    _manifestChunks = nil;
+    
+    id<ORKDataLogUploadTransport> transport = _transport;
+    [self queue_sendRequest:^(void (^completion)(NSError *)) {
+        [transport finishLogWithIdentifier:fileName manifest:manifest completion:completion];
+    } attempt:0 success:^{
+        // The journal record comes first, so a log the server holds is never sent twice.
+        NSError *error = nil;
+        if (![self->_journal appendFinishedFileName:fileName contentHash:contentHash error:&error] ||
+            ![self queue_markItemUploaded:item error:&error]) {
+            [self queue_endPassWithError:error];
+            return;
+        }
+        self->_itemIndex++;
+        [self queue_startNextLog];
+    }];
+}
+
+- (BOOL)queue_markItemUploaded:(ORKDataLogUploadItem *)item error:(NSError **)error {
+    NSString *fileName = item.fileURL.lastPathComponent;
+    if (![item.dataLogger markFileUploaded:YES atURL:item.fileURL error:error]) {
+        if (![[NSFileManager defaultManager] fileExistsAtPath:item.fileURL.path]) {
+            [_journal removeEntryForFileName:fileName];
+            return YES;
+        }
+        return NO;
+    }
+    [_journal removeEntryForFileName:fileName];
+    _uploadedLogCount++;
+    
+    if (_passRemovesUploadedLogs) {
+        // A log left behind is already marked uploaded, so the manager's threshold cleanup removes it first.
+        [_dataLoggerManager removeUploadedFiles:@[item.fileURL] error:NULL];
+    }
+    return YES;
+}
+
+- (void)queue_sendRequest:(void (^)(void (^completion)(NSError *error)))request
+                  attempt:(NSUInteger)attempt
+                  success:(void (^)(void))success {
+    NSUInteger generation = _generation;
+    __block BOOL completed = NO;
+    request(^(NSError *error) {
+        dispatch_async(self->_queue, ^{
+            if (completed || generation != self->_generation) {
+                return;
+            }
+            completed = YES;
+            if (!error) {
+                success();
+                return;
+            }
+            if (attempt + 1 >= self->_passMaximumAttemptCount) {
+                [self queue_endPassWithError:error];
+                return;
+            }
+            NSTimeInterval delay = ORKDataLogUploadRetryDelay(attempt, self->_passInitialRetryInterval, self->_passMaximumRetryInterval);
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self->_queue, ^{
+                if (generation == self->_generation) {
+                    [self queue_sendRequest:request attempt:attempt + 1 success:success];
+                }
+            });
+        });
+    });
+}
+
+- (void)queue_endPassWithError:(NSError *)error {
+    _generation++;
+    if (_fd >= 0) {
+        close(_fd);
+        _fd = -1;
+    }
+    _items = nil;
+    _manifestChunks = nil;
+    
+    // Keep only the logs still in progress.
+    NSError *journalError = nil;
+    if (_journal.loaded && ![_journal compactKeepingFileNames:nil error:&journalError] && !error) {
+        error = journalError;
+    }
+    
+    NSArray *completions = [_completions copy];
+    [_completions removeAllObjects];
+    NSUInteger uploadedLogCount = _uploadedLogCount;
+    _uploading = NO;
+    
+    if (completions.count) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            for (void (^completion)(NSUInteger, NSError *) in completions) {
+                completion(uploadedLogCount, error);
+            }
+        });
+    }
+}
+
+@end
+
+
+@implementation ORKLoopbackDataLogUploadTransport {
+    dispatch_queue_t _queue;
+    NSMutableDictionary<NSString *, NSData *> *_chunks;
+    NSMutableDictionary<NSString *, NSDictionary<NSString *, id> *> *_manifests;
+    NSMutableArray<NSString *> *_finishedLogIdentifiers;
+    NSUInteger _chunkRequestCount;
+    NSUInteger _finishRequestCount;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _queue = dispatch_queue_create("ResearchKit.LoopbackDataLogUploadTransport", DISPATCH_QUEUE_SERIAL);
+        _chunks = [NSMutableDictionary dictionary];
+        _manifests = [NSMutableDictionary dictionary];
+        _finishedLogIdentifiers = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)uploadChunkWithContentHash:(NSString *)contentHash data:(NSData *)data completion:(void (^)(NSError *))completion {
+    dispatch_async(_queue, ^{
+        self->_chunkRequestCount++;
+        NSError * (^requestHandler)(NSString *, NSString *) = self.requestHandler;
+        NSError *error = requestHandler ? requestHandler(nil, contentHash) : nil;
+        if (!error && !self->_chunks[contentHash]) {
+            if ([ORKDataLogUploadDataDigest(data) isEqualToString:contentHash]) {
+                self->_chunks[contentHash] = [data copy];
+            } else {
+                error = [NSError errorWithDomain:ORKErrorDomain code:ORKErrorInvalidObject userInfo:@{@"sha256": contentHash}];
+            }
+        }
+        completion(error);
+    });
+}
+
+- (void)finishLogWithIdentifier:(NSString *)identifier manifest:(NSDictionary<NSString *, id> *)manifest completion:(void (^)(NSError *))completion {
+    dispatch_async(_queue, ^{
+        self->_finishRequestCount++;
+        NSError * (^requestHandler)(NSString *, NSString *) = self.requestHandler;
+        NSError *error = requestHandler ? requestHandler(identifier, nil) : nil;
+        if (!error) {
+            for (NSDictionary *chunk in manifest[@"chunks"]) {
+                if (!self->_chunks[chunk[@"sha256"]]) {
+                    error = [NSError errorWithDomain:ORKErrorDomain code:ORKErrorObjectNotFound userInfo:@{@"sha256": chunk[@"sha256"]}];
+                    break;
+                }
+            }
+        }
+        if (!error) {
+            if (!self->_manifests[identifier]) {
+                [self->_finishedLogIdentifiers addObject:identifier];
+            }
+            self->_manifests[identifier] = [manifest copy];
+        }
+        completion(error);
+    });
+}
+
+- (NSUInteger)chunkRequestCount {
+    __block NSUInteger count = 0;
+    dispatch_sync(_queue, ^{
+        count = self->_chunkRequestCount;
+    });
+    return count;
+}
+
+- (NSUInteger)finishRequestCount {
+    __block NSUInteger count = 0;
+    dispatch_sync(_queue, ^{
+        count = self->_finishRequestCount;
+    });
+    return count;
+}
+
+- (NSUInteger)storedChunkCount {
+    __block NSUInteger count = 0;
+    dispatch_sync(_queue, ^{
+        count = self->_chunks.count;
+    });
+    return count;
+}
+
+- (NSArray<NSString *> *)finishedLogIdentifiers {
+    __block NSArray<NSString *> *identifiers = nil;
+    dispatch_sync(_queue, ^{
+        identifiers = [self->_finishedLogIdentifiers copy];
+    });
+    return identifiers;
+}
+
+- (NSDictionary<NSString *, id> *)manifestForLogIdentifier:(NSString *)identifier {
+    __block NSDictionary<NSString *, id> *manifest = nil;
+    dispatch_sync(_queue, ^{
+        manifest = self->_manifests[identifier];
+    });
+    return manifest;
+}
+
+- (NSData *)dataForLogIdentifier:(NSString *)identifier {
+    __block NSMutableData *data = nil;
+    dispatch_sync(_queue, ^{
+        NSDictionary<NSString *, id> *manifest = self->_manifests[identifier];
+        if (!manifest) {
+            return;
+        }
+        data = [NSMutableData data];
+        for (NSDictionary *chunk in manifest[@"chunks"]) {
+            NSData *chunkData = self->_chunks[chunk[@"sha256"]];
+            if (!chunkData) {
+                data = nil;
+                return;
+            }
+            [data appendData:chunkData];
+        }
+    });
+    return data;
+}
+
+@end
@@ -363,7 +363,7 @@ ORK_CLASS_AVAILABLE
 /**
  The `ORKJSONLogFormatter` class represents a log formatter for producing JSON output.
  
- The JSON log formatter accepts `NSDictionary` objects for serialization.
+ The JSON log formatter accepts `NSDictionary` and `NSArray` objects for serialization.
  The JSON output is a dictionary that contains one key, `items`,
  which contains the array of logged items. The log itself does not contain
  any timestamp information, so the items should include such fields,
@@ -316,11 +316,11 @@ static NSInteger _ORKJSON_terminatorLength = 0;
 }
 
 - (BOOL)canAcceptLogObjectOfClass:(Class)c {
-    return [c isSubclassOfClass:[NSDictionary class]];
+    return [c isSubclassOfClass:[NSDictionary class]] || [c isSubclassOfClass:[NSArray class]];
 }
 
 - (BOOL)canAcceptLogObject:(id)object {
-    if ([object isKindOfClass:[NSDictionary class]] && [NSJSONSerialization isValidJSONObject:object]) {
+    if (([object isKindOfClass:[NSDictionary class]] || [object isKindOfClass:[NSArray class]]) && [NSJSONSerialization isValidJSONObject:object]) {
         return true;
     } else if ([object isKindOfClass:[NSData class]]) {
         if ([NSJSONSerialization JSONObjectWithData:object
@@ -39,6 +39,11 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic, nullable) ORKHTMLPDFPageRenderer *printRenderer;
 
+/**
+ The size of the pages written, Letter or A4 depending on the current locale.
+ */
++ (CGSize)defaultPageSize;
+
 - (void)writePDFFromHTML:(NSString *)html completionBlock:(void (^)(NSData *data, NSError *error))completionBlock;
 
 @end
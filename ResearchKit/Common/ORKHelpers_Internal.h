@@ -118,6 +118,9 @@ ORK_EXTERN BOOL ORKLoggingEnabled;
 #define ORK_ENCODE_UINT32(c,x)  [c encodeObject:[NSNumber numberWithUnsignedLongLong:_ ## x] forKey:@ORK_STRINGIFY(x)]
 #define ORK_DECODE_UINT32(d,x) _ ## x = (uint32_t)[(NSNumber *)[d decodeObjectOfClass:[NSNumber class] forKey:@ORK_STRINGIFY(x)] unsignedLongValue]
 
+#define ORK_ENCODE_UINT64(c,x)  [c encodeObject:[NSNumber numberWithUnsignedLongLong:_ ## x] forKey:@ORK_STRINGIFY(x)]
+#define ORK_DECODE_UINT64(d,x) _ ## x = (uint64_t)[(NSNumber *)[d decodeObjectOfClass:[NSNumber class] forKey:@ORK_STRINGIFY(x)] unsignedLongLongValue]
+
 #define ORK_DECODE_ENUM(d,x)  _ ## x = [d decodeIntegerForKey:@ORK_STRINGIFY(x)]
 #define ORK_ENCODE_ENUM(c,x)  [c encodeInteger:(NSInteger)_ ## x forKey:@ORK_STRINGIFY(x)]
 
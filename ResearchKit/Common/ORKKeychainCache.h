@@ -0,0 +1,104 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <ResearchKit/ORKSecureStorageBackend.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Collects the changes made inside `-[ORKKeychainCache performBatchUpdates:error:]`.
+ 
+ A later change to a key replaces an earlier one in the same batch.
+ */
+@interface ORKKeychainWriteBatch : NSObject
+
+- (void)setObject:(id<NSSecureCoding>)object forKey:(NSString *)key;
+
+- (void)removeObjectForKey:(NSString *)key;
+
+@end
+
+
+/**
+ A read-through, write-through cache in front of an `ORKSecureStorageBackend`.
+ 
+ Reads are served from the archived bytes held in memory after the first lookup of a key that found an item.
+ Lookups that find nothing are not cached, so a missing key goes to the backend on every read. The cached bytes
+ are zeroed when they are invalidated, replaced, or purged; all of them are purged when the app enters the
+ background or protected data becomes unavailable.
+ 
+ The cache is thread-safe.
+ */
+@interface ORKKeychainCache : NSObject
+
+/**
+ The cache used by `ORKKeychainWrapper`, backed by the keychain under the main bundle identifier.
+ */
++ (ORKKeychainCache *)sharedCache;
+
+- (instancetype)initWithBackend:(id<ORKSecureStorageBackend>)backend NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, strong, readonly) id<ORKSecureStorageBackend> backend;
+
+- (nullable id<NSSecureCoding>)objectForKey:(NSString *)key error:(NSError * _Nullable *)error;
+
+- (BOOL)setObject:(id<NSSecureCoding>)object forKey:(NSString *)key error:(NSError * _Nullable *)error;
+
+- (BOOL)removeObjectForKey:(NSString *)key error:(NSError * _Nullable *)error;
+
+/**
+ Stages the changes made by `updates` and writes them to the backend in one call.
+ 
+ If any object fails to archive, nothing is written. If the backend fails, the cached values for every key
+ in the batch are invalidated so the next read goes back to the backend. Reads made inside `updates` do not
+ see its staged changes.
+ */
+- (BOOL)performBatchUpdates:(void (NS_NOESCAPE ^)(ORKKeychainWriteBatch *batch))updates error:(NSError * _Nullable *)error;
+
+- (BOOL)removeAllObjectsWithError:(NSError * _Nullable *)error;
+
+/**
+ Zeroes and drops the cached value for `key`. The next read goes to the backend.
+ */
+- (void)invalidateObjectForKey:(NSString *)key;
+
+/**
+ Zeroes and drops every cached value.
+ */
+- (void)invalidateAllObjects;
+
+@end
+
+NS_ASSUME_NONNULL_END
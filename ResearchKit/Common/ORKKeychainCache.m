@@ -0,0 +1,258 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKKeychainCache.h"
+
+#import "ORKHelpers_Internal.h"
+
+#import <UIKit/UIKit.h>
+
+
+static NSSet<Class> *ORKKeychainCacheDecodableClasses(void) {
+    static NSSet<Class> *classes;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        classes = [NSSet setWithObjects:[NSMutableDictionary class], [NSData class], [NSString class], [NSNumber class], nil];
+    });
+    return classes;
+}
+
+static void ORKKeychainCacheZeroEntry(id entry) {
+    if ([entry isKindOfClass:[NSMutableData class]]) {
+        NSMutableData *data = entry;
+        memset_s(data.mutableBytes, data.length, 0, data.length);
+    }
+}
+
+
+@interface ORKKeychainWriteBatch ()
+
+@property (nonatomic, readonly) NSMutableDictionary<NSString *, id> *changes;
+
+@end
+
+
+@implementation ORKKeychainWriteBatch
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _changes = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (void)setObject:(id<NSSecureCoding>)object forKey:(NSString *)key {
+    ORKThrowInvalidArgumentExceptionIfNil(object)
+    ORKThrowInvalidArgumentExceptionIfNil(key)
+    _changes[key] = object;
+}
+
+- (void)removeObjectForKey:(NSString *)key {
+    ORKThrowInvalidArgumentExceptionIfNil(key)
+    _changes[key] = [NSNull null];
+}
+
+@end
+
+
+@implementation ORKKeychainCache {
+    dispatch_queue_t _queue;
+    
+    // Archived bytes owned by the cache. Keys with no item are not cached, so that an item added to the
+    // keychain by another process or a direct Security call is seen on the next read.
+    NSMutableDictionary<NSString *, NSMutableData *> *_entries;
+}
+
++ (ORKKeychainCache *)sharedCache {
+    static ORKKeychainCache *sharedCache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCache = [[ORKKeychainCache alloc] initWithBackend:[[ORKKeychainSecureStorageBackend alloc] initWithService:nil accessGroup:nil]];
+    });
+    return sharedCache;
+}
+
+- (instancetype)initWithBackend:(id<ORKSecureStorageBackend>)backend {
+    ORKThrowInvalidArgumentExceptionIfNil(backend)
+    self = [super init];
+    if (self) {
+        _backend = backend;
+        _queue = dispatch_queue_create("org.researchkit.keychainCache", DISPATCH_QUEUE_SERIAL);
+        _entries = [NSMutableDictionary dictionary];
+        
+        NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+        [center addObserver:self
+                   selector:@selector(purgeForNotification:)
+                       name:UIApplicationDidEnterBackgroundNotification
+                     object:nil];
+        [center addObserver:self
+                   selector:@selector(purgeForNotification:)
+                       name:UIApplicationProtectedDataWillBecomeUnavailable
+                     object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    for (id entry in _entries.objectEnumerator) {
+        ORKKeychainCacheZeroEntry(entry);
+    }
+}
+
+- (void)purgeForNotification:(NSNotification *)notification {
+    [self invalidateAllObjects];
+}
+
+#pragma mark - Cache entries
+
+// Must be called on _queue.
+- (void)setEntry:(nullable id)entry forKey:(NSString *)key {
+    ORKKeychainCacheZeroEntry(_entries[key]);
+    _entries[key] = entry;
+}
+
+- (void)invalidateObjectForKey:(NSString *)key {
+    dispatch_sync(_queue, ^{
+        [self setEntry:nil forKey:key];
+    });
+}
+
+- (void)invalidateAllObjects {
+    dispatch_sync(_queue, ^{
+        for (id entry in self->_entries.objectEnumerator) {
+            ORKKeychainCacheZeroEntry(entry);
+        }
+        [self->_entries removeAllObjects];
+    });
+}
+
+#pragma mark - Reads
+
+- (id<NSSecureCoding>)objectForKey:(NSString *)key error:(NSError **)errorOut {
+    ORKThrowInvalidArgumentExceptionIfNil(key)
+    __block id<NSSecureCoding> object = nil;
+    __block NSError *error = nil;
+    dispatch_sync(_queue, ^{
+        NSMutableData *entry = self->_entries[key];
+        if (entry == nil) {
+            NSData *data = [self->_backend dataForKey:key error:&error];
+            if (data == nil) {
+                // Misses and failures, such as a locked device, are not cached.
+                return;
+            }
+            entry = [data mutableCopy];
+            self->_entries[key] = entry;
+        }
+        
+        // Decode while the bytes cannot be zeroed underneath the unarchiver.
+        object = [NSKeyedUnarchiver unarchivedObjectOfClasses:ORKKeychainCacheDecodableClasses() fromData:entry error:NULL];
+    });
+    if (error != nil && errorOut != NULL) {
+        *errorOut = error;
+    }
+    return object;
+}
+
+#pragma mark - Writes
+
+- (BOOL)setObject:(id<NSSecureCoding>)object forKey:(NSString *)key error:(NSError **)errorOut {
+    return [self performBatchUpdates:^(ORKKeychainWriteBatch *batch) {
+        [batch setObject:object forKey:key];
+    } error:errorOut];
+}
+
+- (BOOL)removeObjectForKey:(NSString *)key error:(NSError **)errorOut {
+    return [self performBatchUpdates:^(ORKKeychainWriteBatch *batch) {
+        [batch removeObjectForKey:key];
+    } error:errorOut];
+}
+
+- (BOOL)performBatchUpdates:(void (NS_NOESCAPE ^)(ORKKeychainWriteBatch *))updates error:(NSError **)errorOut {
+    ORKKeychainWriteBatch *batch = [[ORKKeychainWriteBatch alloc] init];
+    updates(batch);
+    if (batch.changes.count == 0) {
+        return YES;
+    }
+    
+    NSMutableDictionary<NSString *, id> *changes = [NSMutableDictionary dictionaryWithCapacity:batch.changes.count];
+    for (NSString *key in batch.changes) {
+        id value = batch.changes[key];
+        if (value == [NSNull null]) {
+            changes[key] = value;
+            continue;
+        }
+        NSData *data = [NSKeyedArchiver archivedDataWithRootObject:value requiringSecureCoding:YES error:errorOut];
+        if (data == nil) {
+            return NO;
+        }
+        changes[key] = data;
+    }
+    
+    __block BOOL success = NO;
+    __block NSError *error = nil;
+    dispatch_sync(_queue, ^{
+        success = [self->_backend applyChanges:changes error:&error];
+        [changes enumerateKeysAndObjectsUsingBlock:^(NSString *key, id value, __unused BOOL *stop) {
+            if (!success) {
+                [self setEntry:nil forKey:key];
+            } else if (value == [NSNull null]) {
+                // Read back as a miss the next time, with the backend's own error.
+                [self setEntry:nil forKey:key];
+            } else {
+                [self setEntry:[value mutableCopy] forKey:key];
+            }
+        }];
+    });
+    if (!success && errorOut != NULL) {
+        *errorOut = error;
+    }
+    return success;
+}
+
+- (BOOL)removeAllObjectsWithError:(NSError **)errorOut {
+    __block BOOL success = NO;
+    __block NSError *error = nil;
+    dispatch_sync(_queue, ^{
+        success = [self->_backend removeAllDataWithError:&error];
+        for (id entry in self->_entries.objectEnumerator) {
+            ORKKeychainCacheZeroEntry(entry);
+        }
+        [self->_entries removeAllObjects];
+    });
+    if (!success && errorOut != NULL) {
+        *errorOut = error;
+    }
+    return success;
+}
+
+@end
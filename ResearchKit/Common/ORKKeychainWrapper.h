@@ -37,6 +37,15 @@ NS_ASSUME_NONNULL_BEGIN
 
 /**
  An abstraction layer for iOS keychain communication.
+ 
+ Values read or written through the wrapper are cached in memory, so repeated reads of a key do not go back
+ to the keychain. The cached copies are zeroed when the app enters the background or protected data becomes
+ unavailable.
+ 
+ A read of a key with no item is not cached; it goes to the keychain every time, so an item added by another
+ process sharing the keychain is found on the next read. An item that has been read is served from memory
+ until the app enters the background, so changes other processes make to it are not seen before then. Write
+ such items through the wrapper, or expect them to be read again after the next purge.
  */
 ORK_CLASS_AVAILABLE
 @interface ORKKeychainWrapper : NSObject
@@ -0,0 +1,170 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <ResearchKit/ORKTypes.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, ORKMediaArtifactIngestMethod) {
+    /// The source file was renamed into the store.
+    ORKMediaArtifactIngestMethodRename,
+    
+    /// The source file was cloned with copy-on-write, sharing its blocks with the source.
+    ORKMediaArtifactIngestMethodClone,
+    
+    /// The source file was copied in chunks through a fixed-size buffer.
+    ORKMediaArtifactIngestMethodStreamingCopy,
+    
+    /// The artifact was written from data in memory.
+    ORKMediaArtifactIngestMethodWrite,
+    
+    /// The artifact was already in the store's directory and was adopted in place.
+    ORKMediaArtifactIngestMethodAdopt
+};
+
+typedef NS_OPTIONS(NSUInteger, ORKMediaArtifactIngestOptions) {
+    /// Removes the source file once the artifact is stored, which allows it to be renamed.
+    ORKMediaArtifactIngestOptionMoveSource = 1 << 0,
+    
+    /// Always makes a streaming copy, even when the file could be renamed or cloned.
+    ORKMediaArtifactIngestOptionStreamingCopy = 1 << 1
+};
+
+/// A contiguous range of an artifact and the SHA-256 digest of its bytes.
+@interface ORKMediaArtifactChunk : NSObject
+
+@property (nonatomic, readonly) uint64_t offset;
+
+@property (nonatomic, readonly) uint64_t length;
+
+/// The lowercase hexadecimal SHA-256 digest of the chunk.
+@property (nonatomic, copy, readonly) NSString *contentHash;
+
+@end
+
+
+/**
+ A file held by an `ORKMediaArtifactStore`.
+ 
+ An artifact made by a streaming copy is digested on the copy pass. Any other artifact is
+ digested the first time `computeManifestWithError:` is called, so that storing a recording
+ never reads it back; until then `contentHash` and `chunks` are `nil`.
+ */
+@interface ORKMediaArtifact : NSObject
+
+@property (nonatomic, copy, readonly) NSURL *fileURL;
+
+@property (nonatomic, readonly) uint64_t length;
+
+/// The lowercase hexadecimal SHA-256 digest of the whole file, or `nil` if it has not been digested.
+@property (nonatomic, copy, readonly, nullable) NSString *contentHash;
+
+@property (nonatomic, readonly) uint64_t chunkSize;
+
+/**
+ The chunks of the file, in order, or `nil` if it has not been digested. Every chunk but the last
+ is `chunkSize` bytes long.
+ */
+@property (nonatomic, copy, readonly, nullable) NSArray<ORKMediaArtifactChunk *> *chunks;
+
+@property (nonatomic, readonly) ORKMediaArtifactIngestMethod ingestMethod;
+
+/**
+ Returns a JSON-compatible manifest of the artifact, listing its length, digest and chunks, which
+ an uploader can use to verify and resume a transfer chunk by chunk.
+ 
+ If the artifact has not been digested, this reads the whole file once, uncached, so call it off
+ the main thread. Like its store, an artifact is not thread safe.
+ 
+ @param error   On failure, a POSIX error describing the failure.
+ */
+- (nullable NSDictionary<NSString *, id> *)computeManifestWithError:(NSError * _Nullable *)error;
+
+@end
+
+
+/**
+ Stores recorded media files in a directory with a given file protection.
+ 
+ Files are ingested as cheaply as the file system allows: renamed when the source may be
+ moved, cloned with copy-on-write on volumes that support it, and otherwise copied through a
+ fixed-size buffer so that memory use does not grow with the file. The SHA-256 digests of the
+ file and of each chunk are computed on the same pass that copies the file, and are otherwise
+ left to `-[ORKMediaArtifact computeManifestWithError:]`.
+ 
+ A store is not thread safe; ingest from one queue at a time.
+ */
+@interface ORKMediaArtifactStore : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Creates a store. The directory is created when the first artifact is stored.
+- (instancetype)initWithDirectoryURL:(NSURL *)directoryURL
+                  fileProtectionMode:(ORKFileProtectionMode)fileProtectionMode NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, copy, readonly) NSURL *directoryURL;
+
+@property (nonatomic, readonly) ORKFileProtectionMode fileProtectionMode;
+
+/// The chunk size of artifact manifests. Defaults to 4 MiB.
+@property (nonatomic) uint64_t chunkSize;
+
+/// The size of the buffer used for streaming copies and digest passes. Defaults to 1 MiB.
+@property (nonatomic) size_t bufferSize;
+
+/**
+ Stores the file at `sourceURL` under `fileName`, replacing any artifact with that name.
+ 
+ The replacement is atomic: if the ingest fails, the existing artifact is left in place.
+ 
+ @param sourceURL   A file URL.
+ @param fileName    The name of the artifact within the store's directory.
+ @param options     Options for ingesting the file.
+ @param error       On failure, a POSIX or Cocoa error describing the failure.
+ */
+- (nullable ORKMediaArtifact *)ingestFileAtURL:(NSURL *)sourceURL
+                                      fileName:(NSString *)fileName
+                                       options:(ORKMediaArtifactIngestOptions)options
+                                         error:(NSError * _Nullable *)error;
+
+/// Atomically writes `data` under `fileName`, replacing any artifact with that name.
+- (nullable ORKMediaArtifact *)writeData:(NSData *)data
+                                fileName:(NSString *)fileName
+                                   error:(NSError * _Nullable *)error;
+
+/// Applies the store's file protection to a file that was recorded straight into its directory.
+- (nullable ORKMediaArtifact *)adoptFileAtURL:(NSURL *)fileURL error:(NSError * _Nullable *)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,485 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKMediaArtifactStore.h"
+
+#import "ORKHelpers_Internal.h"
+
+#import <CommonCrypto/CommonDigest.h>
+
+#include <fcntl.h>
+#include <sys/clonefile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+static const uint64_t ORKMediaArtifactDefaultChunkSize = 4 * 1024 * 1024;
+static const size_t ORKMediaArtifactDefaultBufferSize = 1024 * 1024;
+static const size_t ORKMediaArtifactBufferAlignment = 4096;
+
+static NSString *ORKMediaArtifactHexDigest(const unsigned char digest[CC_SHA256_DIGEST_LENGTH]) {
+    static const char hexDigits[] = "0123456789abcdef";
+    char hex[CC_SHA256_DIGEST_LENGTH * 2];
+    for (NSUInteger index = 0; index < CC_SHA256_DIGEST_LENGTH; index++) {
+        hex[2 * index] = hexDigits[digest[index] >> 4];
+        hex[2 * index + 1] = hexDigits[digest[index] & 0xF];
+    }
+    return [[NSString alloc] initWithBytes:hex length:sizeof(hex) encoding:NSASCIIStringEncoding];
+}
+
+static NSError *ORKMediaArtifactPOSIXError(int code, NSURL *fileURL) {
+    return [NSError errorWithDomain:NSPOSIXErrorDomain
+                               code:code
+                           userInfo:@{NSURLErrorKey: fileURL, NSFilePathErrorKey: fileURL.path ?: @""}];
+}
+
+static NSDataWritingOptions ORKDataWritingOptionsFromFileProtectionMode(ORKFileProtectionMode mode) {
+    switch (mode) {
+        case ORKFileProtectionComplete:
+            return NSDataWritingFileProtectionComplete;
+        case ORKFileProtectionCompleteUnlessOpen:
+            return NSDataWritingFileProtectionCompleteUnlessOpen;
+        case ORKFileProtectionCompleteUntilFirstUserAuthentication:
+            return NSDataWritingFileProtectionCompleteUntilFirstUserAuthentication;
+        case ORKFileProtectionNone:
+            return NSDataWritingFileProtectionNone;
+    }
+    return NSDataWritingFileProtectionNone;
+}
+
+static void *ORKMediaArtifactAllocateBuffer(size_t size) {
+    // Page-aligned buffers let uncached reads and writes bypass the buffer cache without bouncing.
+    void *buffer = NULL;
+    if (posix_memalign(&buffer, ORKMediaArtifactBufferAlignment, size) != 0) {
+        return NULL;
+    }
+    return buffer;
+}
+
+
+@implementation ORKMediaArtifactChunk
+
+- (instancetype)initWithOffset:(uint64_t)offset length:(uint64_t)length contentHash:(NSString *)contentHash {
+    self = [super init];
+    if (self) {
+        _offset = offset;
+        _length = length;
+        _contentHash = [contentHash copy];
+    }
+    return self;
+}
+
+@end
+
+
+/// Digests a file and its chunks as its bytes stream past, in any split.
+@interface ORKMediaArtifactDigester : NSObject
+
+- (instancetype)initWithChunkSize:(uint64_t)chunkSize;
+
+- (void)updateWithBytes:(const uint8_t *)bytes length:(size_t)length;
+
+/// Finishes the digests; call once, after the last bytes.
+- (void)finish;
+
+@property (nonatomic, readonly) uint64_t length;
+
+@property (nonatomic, copy, readonly) NSString *contentHash;
+
+@property (nonatomic, copy, readonly) NSArray<ORKMediaArtifactChunk *> *chunks;
+
+@end
+
+
+@implementation ORKMediaArtifactDigester {
+    uint64_t _chunkSize;
+    CC_SHA256_CTX _fileContext;
+    CC_SHA256_CTX _chunkContext;
+    uint64_t _chunkLength;
+    NSMutableArray<ORKMediaArtifactChunk *> *_chunkList;
+}
+
+- (instancetype)initWithChunkSize:(uint64_t)chunkSize {
+    self = [super init];
+    if (self) {
+        _chunkSize = MAX(chunkSize, 1);
+        _chunkList = [NSMutableArray new];
+        CC_SHA256_Init(&_fileContext);
+        CC_SHA256_Init(&_chunkContext);
+    }
+    return self;
+}
+
+- (void)finishChunk {
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256_Final(digest, &_chunkContext);
+    [_chunkList addObject:[[ORKMediaArtifactChunk alloc] initWithOffset:_length - _chunkLength
+                                                                 length:_chunkLength
+                                                            contentHash:ORKMediaArtifactHexDigest(digest)]];
+    _chunkLength = 0;
+    CC_SHA256_Init(&_chunkContext);
+}
+
+- (void)updateWithBytes:(const uint8_t *)bytes length:(size_t)length {
+    while (length > 0) {
+        // CC_SHA256_Update takes a 32-bit length.
+        size_t count = (size_t)MIN((uint64_t)length, MIN(_chunkSize - _chunkLength, (uint64_t)UINT32_MAX));
+        CC_SHA256_Update(&_fileContext, bytes, (CC_LONG)count);
+        CC_SHA256_Update(&_chunkContext, bytes, (CC_LONG)count);
+        _length += count;
+        _chunkLength += count;
+        bytes += count;
+        length -= count;
+        if (_chunkLength == _chunkSize) {
+            [self finishChunk];
+        }
+    }
+}
+
+- (void)finish {
+    if (_chunkLength > 0) {
+        [self finishChunk];
+    }
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256_Final(digest, &_fileContext);
+    _contentHash = ORKMediaArtifactHexDigest(digest);
+    _chunks = [_chunkList copy];
+}
+
+@end
+
+
+@implementation ORKMediaArtifact {
+    size_t _bufferSize;
+}
+
+- (instancetype)initWithFileURL:(NSURL *)fileURL
+                         length:(uint64_t)length
+                      chunkSize:(uint64_t)chunkSize
+                     bufferSize:(size_t)bufferSize
+                   ingestMethod:(ORKMediaArtifactIngestMethod)ingestMethod {
+    self = [super init];
+    if (self) {
+        _fileURL = [fileURL copy];
+        _length = length;
+        _chunkSize = MAX(chunkSize, 1);
+        _bufferSize = bufferSize;
+        _ingestMethod = ingestMethod;
+    }
+    return self;
+}
+
+- (void)takeDigestsFromDigester:(ORKMediaArtifactDigester *)digester {
+    _contentHash = digester.contentHash;
+    _chunks = digester.chunks;
+}
+
+- (BOOL)digestWithError:(NSError **)error {
+    int input = open(_fileURL.fileSystemRepresentation, O_RDONLY);
+    if (input < 0) {
+        if (error) {
+            *error = ORKMediaArtifactPOSIXError(errno, _fileURL);
+        }
+        return NO;
+    }
+    // The file is read once, so keep it out of the buffer cache.
+    fcntl(input, F_NOCACHE, 1);
+    
+    uint8_t *buffer = ORKMediaArtifactAllocateBuffer(_bufferSize);
+    ORKMediaArtifactDigester *digester = [[ORKMediaArtifactDigester alloc] initWithChunkSize:_chunkSize];
+    int readError = buffer ? 0 : ENOMEM;
+    while (buffer) {
+        ssize_t count = read(input, buffer, _bufferSize);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            readError = (count < 0) ? errno : 0;
+            break;
+        }
+        [digester updateWithBytes:buffer length:(size_t)count];
+    }
+    free(buffer);
+    close(input);
+    
+    if (readError != 0) {
+        if (error) {
+            *error = ORKMediaArtifactPOSIXError(readError, _fileURL);
+        }
+        return NO;
+    }
+    [digester finish];
+    _length = digester.length;
+    [self takeDigestsFromDigester:digester];
+    return YES;
+}
+
+- (NSDictionary<NSString *, id> *)computeManifestWithError:(NSError **)error {
+    if (!_contentHash && ![self digestWithError:error]) {
+        return nil;
+    }
+    NSMutableArray *chunks = [NSMutableArray arrayWithCapacity:_chunks.count];
+    for (ORKMediaArtifactChunk *chunk in _chunks) {
+        [chunks addObject:@{
+            @"offset": @(chunk.offset),
+            @"length": @(chunk.length),
+            @"sha256": chunk.contentHash
+        }];
+    }
+    return @{
+        @"fileName": _fileURL.lastPathComponent,
+        @"length": @(_length),
+        @"sha256": _contentHash,
+        @"chunkSize": @(_chunkSize),
+        @"chunks": [chunks copy]
+    };
+}
+
+@end
+
+
+@implementation ORKMediaArtifactStore
+
+- (instancetype)initWithDirectoryURL:(NSURL *)directoryURL fileProtectionMode:(ORKFileProtectionMode)fileProtectionMode {
+    NSParameterAssert(directoryURL.isFileURL);
+    self = [super init];
+    if (self) {
+        _directoryURL = [directoryURL copy];
+        _fileProtectionMode = fileProtectionMode;
+        _chunkSize = ORKMediaArtifactDefaultChunkSize;
+        _bufferSize = ORKMediaArtifactDefaultBufferSize;
+    }
+    return self;
+}
+
+#pragma mark Ingesting
+
+- (ORKMediaArtifact *)ingestFileAtURL:(NSURL *)sourceURL
+                             fileName:(NSString *)fileName
+                              options:(ORKMediaArtifactIngestOptions)options
+                                error:(NSError **)error {
+    NSURL *destinationURL = [self prepareDestinationForFileName:fileName error:error];
+    if (!destinationURL) {
+        return nil;
+    }
+    
+    const char *sourcePath = sourceURL.fileSystemRepresentation;
+    const char *destinationPath = destinationURL.fileSystemRepresentation;
+    BOOL moveSource = (options & ORKMediaArtifactIngestOptionMoveSource) != 0;
+    if (!(options & ORKMediaArtifactIngestOptionStreamingCopy)) {
+        // Both fail with EXDEV across volumes, and cloning fails with ENOTSUP off APFS; either way the copy below takes over.
+        if (moveSource && rename(sourcePath, destinationPath) == 0) {
+            return [self artifactForFileAtURL:destinationURL ingestMethod:ORKMediaArtifactIngestMethodRename error:error];
+        }
+        // clonefile won't replace an existing file, so clone to a hidden sibling and rename that into place.
+        NSURL *temporaryURL = [self temporaryURLForDestinationURL:destinationURL];
+        const char *temporaryPath = temporaryURL.fileSystemRepresentation;
+        unlink(temporaryPath);
+        if (clonefile(sourcePath, temporaryPath, 0) == 0) {
+            if (rename(temporaryPath, destinationPath) != 0) {
+                int renameError = errno;
+                unlink(temporaryPath);
+                if (error) {
+                    *error = ORKMediaArtifactPOSIXError(renameError, destinationURL);
+                }
+                return nil;
+            }
+            if (moveSource) {
+                unlink(sourcePath);
+            }
+            return [self artifactForFileAtURL:destinationURL ingestMethod:ORKMediaArtifactIngestMethodClone error:error];
+        }
+    }
+    
+    ORKMediaArtifactDigester *digester = [[ORKMediaArtifactDigester alloc] initWithChunkSize:_chunkSize];
+    if (![self copyFileAtURL:sourceURL toURL:destinationURL digester:digester error:error]) {
+        return nil;
+    }
+    if (moveSource) {
+        unlink(sourcePath);
+    }
+    [digester finish];
+    ORKMediaArtifact *artifact = [[ORKMediaArtifact alloc] initWithFileURL:destinationURL
+                                                                    length:digester.length
+                                                                 chunkSize:_chunkSize
+                                                                bufferSize:[self effectiveBufferSize]
+                                                              ingestMethod:ORKMediaArtifactIngestMethodStreamingCopy];
+    [artifact takeDigestsFromDigester:digester];
+    return artifact;
+}
+
+- (ORKMediaArtifact *)writeData:(NSData *)data fileName:(NSString *)fileName error:(NSError **)error {
+    NSURL *destinationURL = [self prepareDestinationForFileName:fileName error:error];
+    if (!destinationURL) {
+        return nil;
+    }
+    NSDataWritingOptions writingOptions = NSDataWritingAtomic | ORKDataWritingOptionsFromFileProtectionMode(_fileProtectionMode);
+    if (![data writeToURL:destinationURL options:writingOptions error:error]) {
+        return nil;
+    }
+    return [[ORKMediaArtifact alloc] initWithFileURL:destinationURL
+                                              length:data.length
+                                           chunkSize:_chunkSize
+                                          bufferSize:[self effectiveBufferSize]
+                                        ingestMethod:ORKMediaArtifactIngestMethodWrite];
+}
+
+- (ORKMediaArtifact *)adoptFileAtURL:(NSURL *)fileURL error:(NSError **)error {
+    return [self artifactForFileAtURL:fileURL ingestMethod:ORKMediaArtifactIngestMethodAdopt error:error];
+}
+
+#pragma mark File system
+
+- (NSURL *)prepareDestinationForFileName:(NSString *)fileName error:(NSError **)error {
+    NSParameterAssert(fileName.length > 0 && [fileName.lastPathComponent isEqualToString:fileName]);
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    if (![fileManager createDirectoryAtURL:_directoryURL
+               withIntermediateDirectories:YES
+                                attributes:@{NSFileProtectionKey: ORKFileProtectionFromMode(_fileProtectionMode)}
+                                     error:error]) {
+        return nil;
+    }
+    // Any existing artifact stays in place until its replacement is renamed over it.
+    return [_directoryURL URLByAppendingPathComponent:fileName isDirectory:NO];
+}
+
+- (NSURL *)temporaryURLForDestinationURL:(NSURL *)destinationURL {
+    return [_directoryURL URLByAppendingPathComponent:[NSString stringWithFormat:@".%@.partial", destinationURL.lastPathComponent]
+                                          isDirectory:NO];
+}
+
+- (void)applyFileProtectionToFileAtURL:(NSURL *)fileURL {
+    NSError *error = nil;
+    if (![[NSFileManager defaultManager] setAttributes:@{NSFileProtectionKey: ORKFileProtectionFromMode(_fileProtectionMode)}
+                                          ofItemAtPath:fileURL.path
+                                                 error:&error]) {
+        ORK_Log_Error("Error setting %@ on %@: %@", ORKFileProtectionFromMode(_fileProtectionMode), fileURL, error);
+    }
+}
+
+- (size_t)effectiveBufferSize {
+    return MAX(_bufferSize, ORKMediaArtifactBufferAlignment);
+}
+
+- (ORKMediaArtifact *)artifactForFileAtURL:(NSURL *)fileURL ingestMethod:(ORKMediaArtifactIngestMethod)ingestMethod error:(NSError **)error {
+    [self applyFileProtectionToFileAtURL:fileURL];
+    
+    // Only the length is read here; the digests wait for computeManifestWithError:.
+    struct stat status;
+    if (stat(fileURL.fileSystemRepresentation, &status) != 0) {
+        if (error) {
+            *error = ORKMediaArtifactPOSIXError(errno, fileURL);
+        }
+        return nil;
+    }
+    return [[ORKMediaArtifact alloc] initWithFileURL:fileURL
+                                              length:(uint64_t)status.st_size
+                                           chunkSize:_chunkSize
+                                          bufferSize:[self effectiveBufferSize]
+                                        ingestMethod:ingestMethod];
+}
+
+- (BOOL)copyFileAtURL:(NSURL *)sourceURL toURL:(NSURL *)destinationURL digester:(ORKMediaArtifactDigester *)digester error:(NSError **)error {
+    // Copy to a hidden sibling and rename it into place, so a partial copy is never mistaken for an artifact.
+    NSURL *temporaryURL = [self temporaryURLForDestinationURL:destinationURL];
+    int input = open(sourceURL.fileSystemRepresentation, O_RDONLY);
+    if (input < 0) {
+        if (error) {
+            *error = ORKMediaArtifactPOSIXError(errno, sourceURL);
+        }
+        return NO;
+    }
+    int output = open(temporaryURL.fileSystemRepresentation, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (output < 0) {
+        if (error) {
+            *error = ORKMediaArtifactPOSIXError(errno, temporaryURL);
+        }
+        close(input);
+        return NO;
+    }
+    // Protect the file before any bytes reach it.
+    [self applyFileProtectionToFileAtURL:temporaryURL];
+    fcntl(input, F_NOCACHE, 1);
+    fcntl(output, F_NOCACHE, 1);
+    
+    size_t bufferSize = [self effectiveBufferSize];
+    uint8_t *buffer = ORKMediaArtifactAllocateBuffer(bufferSize);
+    int copyError = buffer ? 0 : ENOMEM;
+    NSURL *failedURL = sourceURL;
+    while (buffer) {
+        ssize_t count = read(input, buffer, bufferSize);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            copyError = (count < 0) ? errno : 0;
+            break;
+        }
+        [digester updateWithBytes:buffer length:(size_t)count];
+        
+        for (ssize_t written = 0; written < count;) {
+            ssize_t result = write(output, buffer + written, (size_t)(count - written));
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            if (result < 0) {
+                copyError = errno;
+                failedURL = temporaryURL;
+                break;
+            }
+            written += result;
+        }
+        if (copyError != 0) {
+            break;
+        }
+    }
+    free(buffer);
+    close(input);
+    if (close(output) != 0 && copyError == 0) {
+        copyError = errno;
+        failedURL = temporaryURL;
+    }
+    
+    if (copyError == 0 && rename(temporaryURL.fileSystemRepresentation, destinationURL.fileSystemRepresentation) != 0) {
+        copyError = errno;
+        failedURL = destinationURL;
+    }
+    if (copyError != 0) {
+        unlink(temporaryURL.fileSystemRepresentation);
+        if (error) {
+            *error = ORKMediaArtifactPOSIXError(copyError, failedURL);
+        }
+        return NO;
+    }
+    return YES;
+}
+
+@end
@@ -0,0 +1,221 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "ORKMotionActivityEncoder.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+static const double ORKMotionActivityMaximumWindowScale = 4.0;
+
+static const char *const ORKMotionActivityStateNames[] = { "unknown", "stationary", "walking", "running", "automotive" };
+static const char *const ORKMotionActivityConfidenceNames[] = { "low", "medium", "high" };
+
+// The longest item: every state, a long confidence and a date with a five-digit year.
+static const size_t ORKMotionActivityMaximumItemLength = 160;
+
+bool ORKMotionActivitySampleHasSameState(ORKMotionActivitySample sample, ORKMotionActivitySample otherSample) {
+    return sample.states == otherSample.states && sample.confidence == otherSample.confidence;
+}
+
+struct ORKMotionActivityEncoder {
+    uint8_t *bytes;
+    size_t length;
+    size_t capacity;
+    bool failed;
+    
+    bool hasPreviousSample;
+    ORKMotionActivitySample previousSample;
+    size_t itemCount;
+    size_t coalescedCount;
+    
+    // The local time of the last date written, which is usually in the same hour as the next one.
+    bool hasCachedHour;
+    time_t cachedHourStart;
+    struct tm cachedHour;
+    char cachedOffset[8];
+};
+
+ORKMotionActivityEncoder *ORKMotionActivityEncoderCreate(void) {
+    ORKMotionActivityEncoder *encoder = calloc(1, sizeof(ORKMotionActivityEncoder));
+    if (!encoder) {
+        return NULL;
+    }
+    encoder->capacity = 4096;
+    encoder->bytes = malloc(encoder->capacity);
+    if (!encoder->bytes) {
+        free(encoder);
+        return NULL;
+    }
+    ORKMotionActivityEncoderReset(encoder);
+    return encoder;
+}
+
+void ORKMotionActivityEncoderDestroy(ORKMotionActivityEncoder *encoder) {
+    if (!encoder) {
+        return;
+    }
+    free(encoder->bytes);
+    free(encoder);
+}
+
+void ORKMotionActivityEncoderReset(ORKMotionActivityEncoder *encoder) {
+    static const char header[] = "{\"items\":[";
+    memcpy(encoder->bytes, header, sizeof(header) - 1);
+    encoder->length = sizeof(header) - 1;
+    encoder->failed = false;
+    encoder->hasPreviousSample = false;
+    encoder->itemCount = 0;
+    encoder->coalescedCount = 0;
+}
+
+static bool ORKMotionActivityEncoderReserve(ORKMotionActivityEncoder *encoder, size_t length) {
+    if (encoder->failed) {
+        return false;
+    }
+    if (encoder->length + length <= encoder->capacity) {
+        return true;
+    }
+    size_t capacity = encoder->capacity;
+    while (capacity < encoder->length + length) {
+        capacity *= 2;
+    }
+    uint8_t *bytes = realloc(encoder->bytes, capacity);
+    if (!bytes) {
+        encoder->failed = true;
+        return false;
+    }
+    encoder->bytes = bytes;
+    encoder->capacity = capacity;
+    return true;
+}
+
+static void ORKMotionActivityEncoderWrite(ORKMotionActivityEncoder *encoder, const char *string) {
+    const size_t length = strlen(string);
+    memcpy(encoder->bytes + encoder->length, string, length);
+    encoder->length += length;
+}
+
+// Writes the date in the format "yyyy-MM-dd'T'HH:mm:ssZ", as `ORKStringFromDateISO8601` does.
+static void ORKMotionActivityEncoderWriteDate(ORKMotionActivityEncoder *encoder, double startTime) {
+    const time_t time = (time_t)floor(startTime);
+    const time_t hourStart = time - (((time % 3600) + 3600) % 3600);
+    if (!encoder->hasCachedHour || hourStart != encoder->cachedHourStart) {
+        // Time zone offsets change on the hour, or on the half or quarter hour, which is rare
+        // enough not to cache across.
+        localtime_r(&hourStart, &encoder->cachedHour);
+        strftime(encoder->cachedOffset, sizeof(encoder->cachedOffset), "%z", &encoder->cachedHour);
+        encoder->cachedHourStart = hourStart;
+        encoder->hasCachedHour = (encoder->cachedHour.tm_min == 0);
+    }
+    struct tm local;
+    if (encoder->hasCachedHour) {
+        local = encoder->cachedHour;
+        const int seconds = (int)(time - hourStart);
+        local.tm_min = seconds / 60;
+        local.tm_sec = seconds % 60;
+    } else {
+        localtime_r(&time, &local);
+        strftime(encoder->cachedOffset, sizeof(encoder->cachedOffset), "%z", &local);
+    }
+    char date[40];
+    const int length = snprintf(date, sizeof(date), "%04d-%02d-%02dT%02d:%02d:%02d%s",
+                                local.tm_year + 1900, local.tm_mon + 1, local.tm_mday,
+                                local.tm_hour, local.tm_min, local.tm_sec, encoder->cachedOffset);
+    if (length > 0 && (size_t)length < sizeof(date)) {
+        memcpy(encoder->bytes + encoder->length, date, (size_t)length);
+        encoder->length += (size_t)length;
+    }
+}
+
+bool ORKMotionActivityEncoderAppend(ORKMotionActivityEncoder *encoder, ORKMotionActivitySample sample) {
+    if (encoder->hasPreviousSample && ORKMotionActivitySampleHasSameState(sample, encoder->previousSample)) {
+        encoder->coalescedCount++;
+        return false;
+    }
+    encoder->hasPreviousSample = true;
+    encoder->previousSample = sample;
+    if (!ORKMotionActivityEncoderReserve(encoder, ORKMotionActivityMaximumItemLength)) {
+        return false;
+    }
+    
+    ORKMotionActivityEncoderWrite(encoder, encoder->itemCount > 0 ? ",{\"confidence\":\"" : "{\"confidence\":\"");
+    const ORKMotionActivityConfidence confidence = sample.confidence <= ORKMotionActivityConfidenceHigh ? sample.confidence : ORKMotionActivityConfidenceLow;
+    ORKMotionActivityEncoderWrite(encoder, ORKMotionActivityConfidenceNames[confidence]);
+    ORKMotionActivityEncoderWrite(encoder, "\",\"activity\":[");
+    bool first = true;
+    for (size_t index = 0; index < sizeof(ORKMotionActivityStateNames) / sizeof(ORKMotionActivityStateNames[0]); index++) {
+        if (sample.states & (1 << index)) {
+            ORKMotionActivityEncoderWrite(encoder, first ? "\"" : ",\"");
+            ORKMotionActivityEncoderWrite(encoder, ORKMotionActivityStateNames[index]);
+            ORKMotionActivityEncoderWrite(encoder, "\"");
+            first = false;
+        }
+    }
+    ORKMotionActivityEncoderWrite(encoder, "],\"startDate\":\"");
+    ORKMotionActivityEncoderWriteDate(encoder, sample.startTime);
+    ORKMotionActivityEncoderWrite(encoder, "\"}");
+    encoder->itemCount++;
+    return true;
+}
+
+size_t ORKMotionActivityEncoderItemCount(const ORKMotionActivityEncoder *encoder) {
+    return encoder->itemCount;
+}
+
+size_t ORKMotionActivityEncoderCoalescedCount(const ORKMotionActivityEncoder *encoder) {
+    return encoder->coalescedCount;
+}
+
+const uint8_t *ORKMotionActivityEncoderFinish(ORKMotionActivityEncoder *encoder, size_t *length) {
+    if (!ORKMotionActivityEncoderReserve(encoder, 2)) {
+        *length = 0;
+        return NULL;
+    }
+    // The closing brackets are written past the end, so that more activities can still be appended.
+    encoder->bytes[encoder->length] = ']';
+    encoder->bytes[encoder->length + 1] = '}';
+    *length = encoder->length + 2;
+    return encoder->bytes;
+}
+
+double ORKMotionActivityNextWindowDuration(ORKMotionActivityWindowPolicy policy, double duration, size_t count) {
+    double scale = ORKMotionActivityMaximumWindowScale;
+    if (count > 0) {
+        scale = (double)policy.targetCount / (double)count;
+        scale = fmax(1.0 / ORKMotionActivityMaximumWindowScale, fmin(ORKMotionActivityMaximumWindowScale, scale));
+    }
+    return fmax(policy.minimumDuration, fmin(policy.maximumDuration, duration * scale));
+}
@@ -0,0 +1,145 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef ORKMotionActivityEncoder_h
+#define ORKMotionActivityEncoder_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*
+ Compact serialization of motion activity for data collection.
+ 
+ Activities are appended in order of their start dates and written straight to JSON in the format
+ of `-[CMMotionActivity ork_JSONDictionary]`, without creating an intermediate dictionary for each
+ activity. An activity lasts until the next one starts, so an activity with the same states and
+ confidence as the one before it carries no information and is left out.
+ 
+ The code is plain C so that it can be built and tested without Foundation or CoreMotion.
+ */
+
+enum {
+    ORKMotionActivityStateUnknown = 1 << 0,
+    ORKMotionActivityStateStationary = 1 << 1,
+    ORKMotionActivityStateWalking = 1 << 2,
+    ORKMotionActivityStateRunning = 1 << 3,
+    ORKMotionActivityStateAutomotive = 1 << 4,
+};
+typedef uint8_t ORKMotionActivityStates;
+
+/*
+ Confidence levels, with the values of `CMMotionActivityConfidence`.
+ */
+enum {
+    ORKMotionActivityConfidenceLow = 0,
+    ORKMotionActivityConfidenceMedium = 1,
+    ORKMotionActivityConfidenceHigh = 2,
+};
+typedef uint8_t ORKMotionActivityConfidence;
+
+typedef struct {
+    // The start date, in seconds since 1970.
+    double startTime;
+    ORKMotionActivityStates states;
+    ORKMotionActivityConfidence confidence;
+} ORKMotionActivitySample;
+
+/*
+ Returns true if the two activities have the same states and confidence.
+ */
+bool ORKMotionActivitySampleHasSameState(ORKMotionActivitySample sample, ORKMotionActivitySample otherSample);
+
+
+typedef struct ORKMotionActivityEncoder ORKMotionActivityEncoder;
+
+/*
+ Returns an encoder, or NULL if memory cannot be allocated. Dates are written in the local time
+ zone, like `ORKStringFromDateISO8601`.
+ */
+ORKMotionActivityEncoder *ORKMotionActivityEncoderCreate(void);
+
+void ORKMotionActivityEncoderDestroy(ORKMotionActivityEncoder *encoder);
+
+/*
+ Discards every appended activity.
+ */
+void ORKMotionActivityEncoderReset(ORKMotionActivityEncoder *encoder);
+
+/*
+ Appends an activity. Returns true if it was written, or false if it has the same state as the
+ previous activity and was left out.
+ */
+bool ORKMotionActivityEncoderAppend(ORKMotionActivityEncoder *encoder, ORKMotionActivitySample sample);
+
+/*
+ The number of activities written, and the number left out.
+ */
+size_t ORKMotionActivityEncoderItemCount(const ORKMotionActivityEncoder *encoder);
+size_t ORKMotionActivityEncoderCoalescedCount(const ORKMotionActivityEncoder *encoder);
+
+/*
+ Returns a JSON object of the form `{"items":[...]}` holding the activities written so far, and
+ sets `length` to its length in bytes. Returns NULL if memory could not be allocated. The bytes are
+ valid until the encoder is next changed.
+ */
+const uint8_t *ORKMotionActivityEncoderFinish(ORKMotionActivityEncoder *encoder, size_t *length);
+
+
+/*
+ Sizing of the windows in which motion activity is queried. CoreMotion returns every activity of a
+ window at once, so long windows of dense activity use a lot of memory, and short windows of sparse
+ activity take many queries.
+ */
+typedef struct {
+    // The shortest and longest windows, in seconds.
+    double minimumDuration;
+    double maximumDuration;
+    // The number of activities a window should return.
+    size_t targetCount;
+} ORKMotionActivityWindowPolicy;
+
+/*
+ Returns the duration of the next window, given the duration of the last window and the number of
+ activities it returned. The duration follows the density of the last window towards the target
+ count, changing by at most a factor of 4 per window.
+ */
+double ORKMotionActivityNextWindowDuration(ORKMotionActivityWindowPolicy policy, double duration, size_t count);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* ORKMotionActivityEncoder_h */
@@ -35,8 +35,11 @@
 #import "ORKHelpers_Internal.h"
 #import "ORKCollector_Internal.h"
 #import "ORKDataCollectionManager_Internal.h"
+#import "CMMotionActivity+ORKJSONDictionary.h"
 
 
+static const NSTimeInterval ORKMotionActivityInitialWindowDuration = 6 * 60 * 60;
+
 @implementation ORKMotionActivityQueryOperation {
     
     // All of these are strong references created at init time
@@ -44,6 +47,16 @@
     NSOperationQueue *_queue;
     NSDate *_currentDate;
     __weak ORKDataCollectionManager *_manager;
+    
+    // The activities are queried in windows from the current date to the end date, which is fixed
+    // when the operation starts. The duration of each window follows the density of the last one.
+    NSDate *_endDate;
+    NSTimeInterval _windowDuration;
+    
+    // The last activity delivered, so that activities with the same state are left out across
+    // windows too.
+    CMMotionActivity *_lastActivity;
+    BOOL _includesActivityInProgress;
 }
 
 - (instancetype)initWithCollector:(ORKMotionActivityCollector*)collector
@@ -79,7 +92,6 @@
     __block NSDate *startDate = nil;
     
     __block NSDate *lastDate = nil;
-    __block NSString *itemIdentifier = nil;
     
     [_manager onWorkQueueSync:^BOOL(ORKDataCollectionManager *manager) {
         BOOL changed = NO;
@@ -94,7 +106,6 @@
         
         lastDate = _collector.lastDate;
         startDate = _collector.startDate;
-        itemIdentifier = _collector.identifier;
         
         return changed;
     }];
@@ -102,36 +113,54 @@
     if (_currentDate == nil) {
         _currentDate = lastDate;
     }
-
-    __weak ORKMotionActivityQueryOperation * weakSelf = self;
+    
+    // The activity in progress at the date where the last collection ended was delivered with it.
+    _includesActivityInProgress = (_currentDate == nil);
     
     NSDate *queryBeginDate = _currentDate?:startDate;
-    NSDate *queryEndDate = [NSDate date];
+    _endDate = [NSDate date];
+    _windowDuration = ORKMotionActivityInitialWindowDuration;
     if (!queryBeginDate) {
+        // Without a start date, query everything at once.
         queryBeginDate = [NSDate distantPast];
+        _windowDuration = [_endDate timeIntervalSinceDate:queryBeginDate];
+    }
+    
+    [self queryWindowStartingFromDate:queryBeginDate];
+    
+    [self.lock unlock];
+    
+}
+
+- (void)queryWindowStartingFromDate:(NSDate *)queryBeginDate {
+    id<ORKMotionActivitySource> source = _manager.motionActivitySource;
+    if (!source) {
+        [self finishWithErrorCode:ORKErrorException];
+        return;
+    }
+    
+    NSDate *queryEndDate = [queryBeginDate dateByAddingTimeInterval:_windowDuration];
+    if ([queryEndDate compare:_endDate] != NSOrderedAscending) {
+        queryEndDate = _endDate;
     }
     
     ORK_Log_Debug("\nMotion Query: %@\n", @{@"from": queryBeginDate, @"to":queryEndDate});
     
-    // Run a single query up to current date
-    [_manager.activityManager queryActivityStartingFromDate:queryBeginDate toDate:queryEndDate toQueue:_queue withHandler:^(NSArray<CMMotionActivity *> *activities, NSError *error) {
+    __weak ORKMotionActivityQueryOperation * weakSelf = self;
+    [source queryActivityStartingFromDate:queryBeginDate toDate:queryEndDate toQueue:_queue withHandler:^(NSArray<CMMotionActivity *> *activities, NSError *error) {
         ORKMotionActivityQueryOperation *op = weakSelf;
         ORK_Log_Debug("\nMotion Query: %@\n", @{@"from": queryBeginDate, @"to":queryEndDate, @"returned count": @(activities.count)});
-        [op handleResults:activities queryBegin:queryBeginDate queryEnd:queryEndDate error:error itemIdentifier:itemIdentifier];
+        [op handleResults:activities queryBegin:queryBeginDate queryEnd:queryEndDate error:error];
     }];
-    
-    [self.lock unlock];
-    
 }
 
 /*
- Handles the results, and starts a new query if needed
+ Handles the results of one window, and queries the next window if needed
  */
 - (void)handleResults:(NSArray<CMMotionActivity *> *)results
           queryBegin:(NSDate *)queryBegin
             queryEnd:(NSDate *)queryEnd
-               error:(NSError *)error
-      itemIdentifier:(NSString *)itemIdentifier {
+               error:(NSError *)error {
     [self.lock lock];
     // Check our actual state under the lock
     
@@ -150,15 +179,22 @@
     
     [self.lock unlock];
     
-    if (results && [results count] > 0) {
-        CMMotionActivity *lastObject = (CMMotionActivity *)[results lastObject];
-        NSDate *lastObservedDate = lastObject.startDate;
-        if (![lastObservedDate isEqual:queryBegin] && [lastObservedDate earlierDate:queryBegin] == lastObservedDate && [results count] == 1) {
-            // Ignore a one-off if it was before the beginning of the query
-            [self safeFinish];
-            return;
+    // Leave out the activity in progress at the beginning of the window, which was delivered
+    // before, and activities with the same state as the activity before them.
+    NSMutableArray<CMMotionActivity *> *activities = [NSMutableArray arrayWithCapacity:results.count];
+    for (CMMotionActivity *activity in results) {
+        if (!_includesActivityInProgress && [activity.startDate compare:queryBegin] == NSOrderedAscending) {
+            continue;
         }
-        
+        if (_lastActivity && [activity ork_hasSameStateAsActivity:_lastActivity]) {
+            continue;
+        }
+        [activities addObject:activity];
+        _lastActivity = activity;
+    }
+    _includesActivityInProgress = NO;
+    
+    if (activities.count > 0) {
         __block BOOL handoutSuccess = NO;
         
         dispatch_semaphore_t sem = dispatch_semaphore_create(0);
@@ -168,7 +204,7 @@
             id<ORKDataCollectionManagerDelegate> delegate = _manager.delegate;
             
             if (delegate && [delegate respondsToSelector:@selector(motionActivityCollector:didCollectMotionActivities:)]) {
-                handoutSuccess = [delegate motionActivityCollector:_collector didCollectMotionActivities:results];
+                handoutSuccess = [delegate motionActivityCollector:_collector didCollectMotionActivities:activities];
             }
             
             dispatch_semaphore_signal(sem);
@@ -177,27 +213,28 @@
         dispatch_semaphore_wait(sem, DISPATCH_TIME_FOREVER);
         
         if (!handoutSuccess) {
+            // Stop here, so that the same window is collected again next time.
             self.error = [NSError errorWithDomain:ORKErrorDomain code:ORKErrorException userInfo:@{NSLocalizedFailureReasonErrorKey: @"Results were not properly delivered to the data collection manager delegate."}];
+            [self safeFinish];
+            return;
         }
-        
-        // If successfully reported to delegate, and we observed at
-        // least one valid sample, update the "current" date
-        // (the start date of the next query)
-        if (lastObservedDate && handoutSuccess) {
-            
-            // Write the query end as the finish date. This is ok because in CoreMotion
-            // entries are local and unlikely to be written for dates prior to "now".
-            NSDate *nextStartDate = queryEnd ? : lastObservedDate;
-            self->_currentDate = nextStartDate;
-            
-            // Store it on the collector
-            [_manager onWorkQueueAsync:^BOOL(ORKDataCollectionManager *manager) {
-                _collector.lastDate = nextStartDate;
-                return YES;
-            }];
-            
-        }
-            
+    }
+    
+    // Write the query end as the start of the next query. This is ok because in CoreMotion
+    // entries are local and unlikely to be written for dates prior to "now".
+    NSDate *nextStartDate = queryEnd;
+    self->_currentDate = nextStartDate;
+    
+    // Store it on the collector
+    [_manager onWorkQueueAsync:^BOOL(ORKDataCollectionManager *manager) {
+        _collector.lastDate = nextStartDate;
+        return YES;
+    }];
+    
+    if ([queryEnd compare:_endDate] == NSOrderedAscending) {
+        _windowDuration = ORKMotionActivityNextWindowDuration(_manager.motionActivityWindowPolicy, _windowDuration, results.count);
+        [self queryWindowStartingFromDate:queryEnd];
+        return;
     }
     
     [self safeFinish];
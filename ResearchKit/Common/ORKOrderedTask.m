@@ -30,10 +30,12 @@
  */
 
 #import "ORKOrderedTask.h"
+#import "ORKOrderedTask_Private.h"
 #import "ORKAnswerFormat.h"
 #import "ORKInstructionStep.h"
 #import "ORKCompletionStep.h"
 #import "ORKStep_Private.h"
+#import "ORKStepTemplate.h"
 #import "ORKHelpers_Internal.h"
 #import "ORKSkin.h"
 #if TARGET_OS_IOS
@@ -66,12 +68,19 @@
         _steps = steps;
         
         _progressLabelColor = ORKColor(ORKProgressLabelColorKey);
-        [self setUpArrayOfStepsThatShowProgress];
+        if (![_steps isKindOfClass:[ORKLazyStepArray class]]) {
+            // Templated steps are only built once progress is first asked for.
+            [self setUpArrayOfStepsThatShowProgress];
+        }
         [self validateParameters];
     }
     return self;
 }
 
+- (instancetype)initWithIdentifier:(NSString *)identifier stepTemplates:(NSArray<ORKStepTemplate *> *)stepTemplates {
+    return [self initWithIdentifier:identifier steps:[[ORKLazyStepArray alloc] initWithStepTemplates:stepTemplates]];
+}
+
 - (instancetype)copyWithSteps:(NSArray <ORKStep *> *)steps {
     ORKOrderedTask *task = [self copyWithZone:nil];
     task->_steps = ORKArrayCopyObjects(steps);
@@ -86,8 +95,9 @@
 }
 
 - (instancetype)copyWithZone:(NSZone *)zone {
+    NSArray *steps = [_steps isKindOfClass:[ORKLazyStepArray class]] ? [(ORKLazyStepArray *)_steps copyCopyingBuiltSteps] : ORKArrayCopyObjects(_steps);
     ORKOrderedTask *task = [[[self class] allocWithZone:zone] initWithIdentifier:[_identifier copy]
-                                                                           steps:ORKArrayCopyObjects(_steps)];
+                                                                           steps:steps];
     return task;
 }
 
@@ -108,6 +118,15 @@
 #pragma mark - ORKTask
 
 - (void)validateParameters {
+    if ([_steps isKindOfClass:[ORKLazyStepArray class]]) {
+        // Early termination steps of templated steps are not known until the steps are built.
+        NSArray<NSString *> *stepIdentifiers = ((ORKLazyStepArray *)_steps).stepIdentifiers;
+        if ([NSSet setWithArray:stepIdentifiers].count != stepIdentifiers.count) {
+            @throw [NSException exceptionWithName:NSGenericException reason:@"Each step should have a unique identifier" userInfo:nil];
+        }
+        return;
+    }
+    
     NSInteger stepCount = 0;
     NSMutableSet<NSString *> *uniqueStepIdentifiers = [NSMutableSet new];
     for (ORKStep *step in self.steps) {
@@ -175,9 +194,20 @@
 }
 
 - (NSUInteger)indexOfStep:(ORKStep *)step {
-    NSArray *identifiers = [_steps valueForKey:@"identifier"];
-    NSUInteger index = [identifiers indexOfObject:step.identifier];
-    return index;
+    return [self indexOfStepWithIdentifier:step.identifier];
+}
+
+- (NSUInteger)indexOfStepWithIdentifier:(NSString *)identifier {
+    if ([_steps isKindOfClass:[ORKLazyStepArray class]]) {
+        return [(ORKLazyStepArray *)_steps indexOfStepWithIdentifier:identifier];
+    }
+    NSUInteger count = _steps.count;
+    for (NSUInteger index = 0; index < count; index++) {
+        if ([_steps[index].identifier isEqual:identifier]) {
+            return index;
+        }
+    }
+    return NSNotFound;
 }
 
 - (ORKStep *)stepAfterStep:(ORKStep *)step withResult:(ORKTaskResult *)result {
@@ -226,6 +256,13 @@
 }
 
 - (ORKStep *)stepWithIdentifier:(NSString *)identifier {
+    if ([_steps isKindOfClass:[ORKLazyStepArray class]]) {
+        NSUInteger index = [self indexOfStepWithIdentifier:identifier];
+        if (index != NSNotFound) {
+            return _steps[index];
+        }
+    }
+    
     __block ORKStep *step = nil;
     [_steps enumerateObjectsUsingBlock:^(ORKStep *obj, NSUInteger idx, BOOL *stop) {
         if ([obj.identifier isEqualToString:identifier]) {
@@ -244,6 +281,10 @@
 - (ORKTaskProgress)progressOfCurrentStep:(ORKStep *)step withResult:(ORKTaskResult *)taskResult {
     ORKTaskProgress progress;
     
+    if (_stepsThatDisplayProgress == nil) {
+        [self setUpArrayOfStepsThatShowProgress];
+    }
+    
     if ([_stepsThatDisplayProgress containsObject:step.identifier]) {
         progress.current = [_stepsThatDisplayProgress indexOfObject:step.identifier];
         progress.total = _stepsThatDisplayProgress.count;
@@ -34,7 +34,7 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
-@class ORKCompletionStep, ORKStep;
+@class ORKCompletionStep, ORKStep, ORKStepTemplate;
 
 
 FOUNDATION_EXPORT NSString *const ORKInstruction0StepIdentifier;
@@ -68,9 +68,22 @@ FOUNDATION_EXPORT NSString *const ORKHeartRateRecorderIdentifier;
 
 FOUNDATION_EXPORT void ORKStepArrayAddStep(NSMutableArray<ORKStep *> *array, ORKStep *step);
 
+@interface ORKOrderedTask ()
+
+/**
+ Returns a task whose steps are built from `stepTemplates` the first time each one is accessed.
+ 
+ Step identifiers must be unique across the templates. Methods that look at every step, such as
+ `requestedPermissions`, build all of them.
+ */
+- (instancetype)initWithIdentifier:(NSString *)identifier stepTemplates:(NSArray<ORKStepTemplate *> *)stepTemplates;
+
+@end
+
 @interface ORKOrderedTask (ORKMakeTaskUtilities)
 
 + (ORKCompletionStep *)makeCompletionStep;
++ (ORKStepTemplate *)completionStepTemplate;
 + (NSDateComponentsFormatter *)textTimeFormatter;
 
 @end
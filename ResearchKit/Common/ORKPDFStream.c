@@ -0,0 +1,700 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "ORKPDFStream.h"
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+
+// Pending output is handed to the file descriptor once it grows past this size.
+static const size_t ORKPDFFlushThreshold = 64 * 1024;
+
+static const size_t ORKPDFFooterCapacity = 256;
+
+// Objects 1 through 4 are written up front; everything after them is numbered as it is created.
+enum {
+    ORKPDFCatalogObject = 1,
+    ORKPDFPagesObject = 2,
+    ORKPDFHelveticaObject = 3,
+    ORKPDFHelveticaBoldObject = 4,
+    ORKPDFFirstFreeObject = 5,
+};
+
+static const uint16_t ORKPDFHelveticaWidths[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    278, 278, 355, 556, 556, 889, 667, 191, 333, 333, 389, 584, 278, 333, 278, 278,
+    556, 556, 556, 556, 556, 556, 556, 556, 556, 556, 278, 278, 584, 584, 584, 556,
+    1015, 667, 667, 722, 722, 667, 611, 778, 722, 278, 500, 667, 556, 833, 722, 778,
+    667, 778, 722, 667, 611, 722, 667, 944, 667, 667, 611, 278, 278, 278, 469, 556,
+    333, 556, 556, 500, 556, 556, 278, 556, 556, 222, 222, 500, 222, 833, 556, 556,
+    556, 556, 333, 500, 278, 556, 500, 722, 500, 500, 500, 334, 260, 334, 584, 0,
+    556, 0, 222, 556, 333, 1000, 556, 556, 333, 1000, 667, 333, 1000, 0, 611, 0,
+    0, 222, 222, 333, 333, 350, 556, 1000, 333, 1000, 500, 333, 944, 0, 500, 667,
+    278, 333, 556, 556, 556, 556, 260, 556, 333, 737, 370, 556, 584, 333, 737, 333,
+    400, 584, 333, 333, 333, 556, 537, 278, 333, 333, 365, 556, 834, 834, 834, 611,
+    667, 667, 667, 667, 667, 667, 1000, 722, 667, 667, 667, 667, 278, 278, 278, 278,
+    722, 722, 778, 778, 778, 778, 778, 584, 778, 722, 722, 722, 722, 667, 667, 611,
+    556, 556, 556, 556, 556, 556, 889, 500, 556, 556, 556, 556, 278, 278, 278, 278,
+    556, 556, 556, 556, 556, 556, 556, 584, 611, 556, 556, 556, 556, 500, 556, 500,
+};
+
+static const uint16_t ORKPDFHelveticaBoldWidths[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    278, 333, 474, 556, 556, 889, 722, 238, 333, 333, 389, 584, 278, 333, 278, 278,
+    556, 556, 556, 556, 556, 556, 556, 556, 556, 556, 333, 333, 584, 584, 584, 611,
+    975, 722, 722, 722, 722, 667, 611, 778, 722, 278, 556, 722, 611, 833, 722, 778,
+    667, 778, 722, 667, 611, 722, 667, 944, 667, 667, 611, 333, 278, 333, 584, 556,
+    333, 556, 611, 556, 611, 556, 333, 611, 611, 278, 278, 556, 278, 889, 611, 611,
+    611, 611, 389, 556, 333, 611, 556, 778, 556, 556, 500, 389, 280, 389, 584, 0,
+    556, 0, 278, 556, 500, 1000, 556, 556, 333, 1000, 667, 333, 1000, 0, 611, 0,
+    0, 278, 278, 500, 500, 350, 556, 1000, 333, 1000, 556, 333, 944, 0, 500, 667,
+    278, 333, 556, 556, 556, 556, 280, 556, 333, 737, 370, 556, 584, 333, 737, 333,
+    400, 584, 333, 333, 333, 611, 556, 278, 333, 333, 365, 556, 834, 834, 834, 611,
+    722, 722, 722, 722, 722, 722, 1000, 722, 667, 667, 667, 667, 278, 278, 278, 278,
+    722, 722, 778, 778, 778, 778, 778, 584, 778, 722, 722, 722, 722, 667, 667, 611,
+    556, 556, 556, 556, 556, 556, 889, 556, 556, 556, 556, 556, 278, 278, 278, 278,
+    611, 611, 611, 611, 611, 611, 611, 584, 611, 611, 611, 611, 611, 556, 611, 556,
+};
+
+typedef struct {
+    uint8_t *bytes;
+    size_t length;
+    size_t capacity;
+} ORKPDFBuffer;
+
+typedef struct {
+    size_t pageObject;
+    size_t footerObject;
+    double width;
+    double height;
+} ORKPDFPageRecord;
+
+struct ORKPDFStream {
+    int fileDescriptor;
+    int error;
+    uint64_t flushedLength;
+    ORKPDFBuffer output;
+    
+    uint64_t *objectOffsets;
+    size_t objectCount;
+    size_t objectCapacity;
+    
+    ORKPDFPageRecord *pages;
+    size_t pageCount;
+    size_t pageCapacity;
+    
+    bool pageOpen;
+    double pageWidth;
+    double pageHeight;
+    ORKPDFBuffer content;
+    ORKPDFBuffer pageImages;
+    
+    ORKPDFFooterFunction footerFunction;
+    void *footerContext;
+    ORKPDFFont footerFont;
+    double footerFontSize;
+    double footerBaseline;
+    
+    bool finished;
+};
+
+
+#pragma mark - Buffers
+
+static bool ORKPDFBufferReserve(ORKPDFBuffer *buffer, size_t extra) {
+    if (buffer->length + extra <= buffer->capacity) {
+        return true;
+    }
+    size_t capacity = buffer->capacity ? buffer->capacity : 256;
+    while (capacity < buffer->length + extra) {
+        capacity *= 2;
+    }
+    uint8_t *bytes = realloc(buffer->bytes, capacity);
+    if (!bytes) {
+        return false;
+    }
+    buffer->bytes = bytes;
+    buffer->capacity = capacity;
+    return true;
+}
+
+static bool ORKPDFBufferAppend(ORKPDFBuffer *buffer, const void *bytes, size_t length) {
+    if (!ORKPDFBufferReserve(buffer, length)) {
+        return false;
+    }
+    memcpy(buffer->bytes + buffer->length, bytes, length);
+    buffer->length += length;
+    return true;
+}
+
+static bool ORKPDFBufferAppendString(ORKPDFBuffer *buffer, const char *string) {
+    return ORKPDFBufferAppend(buffer, string, strlen(string));
+}
+
+static bool ORKPDFBufferAppendInteger(ORKPDFBuffer *buffer, uint64_t value) {
+    char digits[20];
+    size_t count = 0;
+    do {
+        digits[sizeof(digits) - 1 - count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    return ORKPDFBufferAppend(buffer, digits + sizeof(digits) - count, count);
+}
+
+// Writes `value` rounded to hundredths without trailing zeros. printf is avoided because its decimal separator depends on the locale.
+static bool ORKPDFBufferAppendNumber(ORKPDFBuffer *buffer, double value) {
+    long long hundredths = llround(value * 100.0);
+    if (hundredths < 0) {
+        if (!ORKPDFBufferAppendString(buffer, "-")) {
+            return false;
+        }
+        hundredths = -hundredths;
+    }
+    if (!ORKPDFBufferAppendInteger(buffer, (uint64_t)(hundredths / 100))) {
+        return false;
+    }
+    int fraction = (int)(hundredths % 100);
+    if (fraction == 0) {
+        return true;
+    }
+    char decimals[4] = { '.', (char)('0' + fraction / 10), (char)('0' + fraction % 10), 0 };
+    if (decimals[2] == '0') {
+        decimals[2] = 0;
+    }
+    return ORKPDFBufferAppendString(buffer, decimals);
+}
+
+// Appends `text` as a literal string, escaping delimiters and anything that is not printable ASCII.
+static bool ORKPDFBufferAppendLiteralString(ORKPDFBuffer *buffer, const uint8_t *text, size_t length) {
+    if (!ORKPDFBufferReserve(buffer, length * 4 + 2)) {
+        return false;
+    }
+    uint8_t *cursor = buffer->bytes + buffer->length;
+    *cursor++ = '(';
+    for (size_t index = 0; index < length; index++) {
+        uint8_t byte = text[index];
+        if (byte == '(' || byte == ')' || byte == '\\') {
+            *cursor++ = '\\';
+            *cursor++ = byte;
+        } else if (byte < 32 || byte > 126) {
+            *cursor++ = '\\';
+            *cursor++ = (uint8_t)('0' + (byte >> 6));
+            *cursor++ = (uint8_t)('0' + ((byte >> 3) & 7));
+            *cursor++ = (uint8_t)('0' + (byte & 7));
+        } else {
+            *cursor++ = byte;
+        }
+    }
+    *cursor++ = ')';
+    buffer->length = (size_t)(cursor - buffer->bytes);
+    return true;
+}
+
+static void ORKPDFBufferFree(ORKPDFBuffer *buffer) {
+    free(buffer->bytes);
+    buffer->bytes = NULL;
+    buffer->length = 0;
+    buffer->capacity = 0;
+}
+
+
+#pragma mark - Output
+
+static bool ORKPDFStreamFail(ORKPDFStream *stream, int error) {
+    if (stream->error == 0) {
+        stream->error = error;
+    }
+    return false;
+}
+
+static bool ORKPDFStreamFlush(ORKPDFStream *stream) {
+    size_t written = 0;
+    while (written < stream->output.length) {
+        ssize_t result = write(stream->fileDescriptor, stream->output.bytes + written, stream->output.length - written);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return ORKPDFStreamFail(stream, errno);
+        }
+        written += (size_t)result;
+    }
+    stream->flushedLength += written;
+    stream->output.length = 0;
+    return true;
+}
+
+static bool ORKPDFStreamCheckOutput(ORKPDFStream *stream, bool appended) {
+    if (!appended) {
+        return ORKPDFStreamFail(stream, ENOMEM);
+    }
+    return stream->output.length < ORKPDFFlushThreshold || ORKPDFStreamFlush(stream);
+}
+
+static bool ORKPDFStreamWrite(ORKPDFStream *stream, const char *string) {
+    return ORKPDFStreamCheckOutput(stream, ORKPDFBufferAppendString(&stream->output, string));
+}
+
+static bool ORKPDFStreamWriteInteger(ORKPDFStream *stream, uint64_t value) {
+    return ORKPDFStreamCheckOutput(stream, ORKPDFBufferAppendInteger(&stream->output, value));
+}
+
+static bool ORKPDFStreamWriteNumber(ORKPDFStream *stream, double value) {
+    return ORKPDFStreamCheckOutput(stream, ORKPDFBufferAppendNumber(&stream->output, value));
+}
+
+static bool ORKPDFStreamWriteBytes(ORKPDFStream *stream, const uint8_t *bytes, size_t length) {
+    return ORKPDFStreamCheckOutput(stream, ORKPDFBufferAppend(&stream->output, bytes, length));
+}
+
+static uint64_t ORKPDFStreamPosition(const ORKPDFStream *stream) {
+    return stream->flushedLength + stream->output.length;
+}
+
+
+#pragma mark - Objects
+
+static size_t ORKPDFStreamAllocateObject(ORKPDFStream *stream) {
+    if (stream->objectCount == stream->objectCapacity) {
+        size_t capacity = stream->objectCapacity ? stream->objectCapacity * 2 : 64;
+        uint64_t *offsets = realloc(stream->objectOffsets, (capacity + 1) * sizeof(uint64_t));
+        if (!offsets) {
+            ORKPDFStreamFail(stream, ENOMEM);
+            return 0;
+        }
+        stream->objectOffsets = offsets;
+        stream->objectCapacity = capacity;
+    }
+    stream->objectCount++;
+    stream->objectOffsets[stream->objectCount] = 0;
+    return stream->objectCount;
+}
+
+static bool ORKPDFStreamBeginObject(ORKPDFStream *stream, size_t object) {
+    stream->objectOffsets[object] = ORKPDFStreamPosition(stream);
+    return ORKPDFStreamWriteInteger(stream, object) && ORKPDFStreamWrite(stream, " 0 obj\n");
+}
+
+static bool ORKPDFStreamWriteReference(ORKPDFStream *stream, size_t object) {
+    return ORKPDFStreamWriteInteger(stream, object) && ORKPDFStreamWrite(stream, " 0 R");
+}
+
+static bool ORKPDFStreamWriteFontResources(ORKPDFStream *stream) {
+    return (ORKPDFStreamWrite(stream, "/Font << /F1 ") &&
+            ORKPDFStreamWriteReference(stream, ORKPDFHelveticaObject) &&
+            ORKPDFStreamWrite(stream, " /F2 ") &&
+            ORKPDFStreamWriteReference(stream, ORKPDFHelveticaBoldObject) &&
+            ORKPDFStreamWrite(stream, " >>"));
+}
+
+static bool ORKPDFStreamWriteStreamObject(ORKPDFStream *stream, size_t object, const char *dictionary, const ORKPDFBuffer *data) {
+    return (ORKPDFStreamBeginObject(stream, object) &&
+            ORKPDFStreamWrite(stream, "<< ") &&
+            ORKPDFStreamWrite(stream, dictionary) &&
+            ORKPDFStreamWrite(stream, "/Length ") &&
+            ORKPDFStreamWriteInteger(stream, data->length) &&
+            ORKPDFStreamWrite(stream, " >>\nstream\n") &&
+            ORKPDFStreamWriteBytes(stream, data->bytes, data->length) &&
+            ORKPDFStreamWrite(stream, "\nendstream\nendobj\n"));
+}
+
+
+#pragma mark - Stream
+
+ORKPDFStream *ORKPDFStreamCreate(int fileDescriptor) {
+    ORKPDFStream *stream = calloc(1, sizeof(ORKPDFStream));
+    if (!stream) {
+        return NULL;
+    }
+    stream->fileDescriptor = fileDescriptor;
+    for (size_t object = 1; object < ORKPDFFirstFreeObject; object++) {
+        ORKPDFStreamAllocateObject(stream);
+    }
+    if (stream->error) {
+        ORKPDFStreamDestroy(stream);
+        return NULL;
+    }
+    ORKPDFStreamWrite(stream, "%PDF-1.4\n%\xE2\xE3\xCF\xD3\n");
+    
+    ORKPDFStreamBeginObject(stream, ORKPDFCatalogObject);
+    ORKPDFStreamWrite(stream, "<< /Type /Catalog /Pages ");
+    ORKPDFStreamWriteReference(stream, ORKPDFPagesObject);
+    ORKPDFStreamWrite(stream, " >>\nendobj\n");
+    
+    ORKPDFStreamBeginObject(stream, ORKPDFHelveticaObject);
+    ORKPDFStreamWrite(stream, "<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica /Encoding /WinAnsiEncoding >>\nendobj\n");
+    ORKPDFStreamBeginObject(stream, ORKPDFHelveticaBoldObject);
+    ORKPDFStreamWrite(stream, "<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica-Bold /Encoding /WinAnsiEncoding >>\nendobj\n");
+    return stream;
+}
+
+void ORKPDFStreamDestroy(ORKPDFStream *stream) {
+    if (!stream) {
+        return;
+    }
+    ORKPDFBufferFree(&stream->output);
+    ORKPDFBufferFree(&stream->content);
+    ORKPDFBufferFree(&stream->pageImages);
+    free(stream->objectOffsets);
+    free(stream->pages);
+    free(stream);
+}
+
+void ORKPDFStreamSetFooter(ORKPDFStream *stream, ORKPDFFooterFunction function, void *context, ORKPDFFont font, double fontSize, double baseline) {
+    stream->footerFunction = function;
+    stream->footerContext = context;
+    stream->footerFont = font;
+    stream->footerFontSize = fontSize;
+    stream->footerBaseline = baseline;
+}
+
+bool ORKPDFStreamBeginPage(ORKPDFStream *stream, double width, double height) {
+    if (stream->error) {
+        return false;
+    }
+    if (stream->pageOpen || stream->finished) {
+        return ORKPDFStreamFail(stream, EINVAL);
+    }
+    stream->pageOpen = true;
+    stream->pageWidth = width;
+    stream->pageHeight = height;
+    stream->content.length = 0;
+    stream->pageImages.length = 0;
+    return true;
+}
+
+static bool ORKPDFStreamCheckPage(ORKPDFStream *stream) {
+    if (stream->error) {
+        return false;
+    }
+    return stream->pageOpen || ORKPDFStreamFail(stream, EINVAL);
+}
+
+static bool ORKPDFBufferAppendText(ORKPDFBuffer *buffer, ORKPDFFont font, double fontSize, double x, double baseline, const uint8_t *text, size_t length) {
+    return (ORKPDFBufferAppendString(buffer, font == ORKPDFFontHelveticaBold ? "BT /F2 " : "BT /F1 ") &&
+            ORKPDFBufferAppendNumber(buffer, fontSize) &&
+            ORKPDFBufferAppendString(buffer, " Tf ") &&
+            ORKPDFBufferAppendNumber(buffer, x) &&
+            ORKPDFBufferAppendString(buffer, " ") &&
+            ORKPDFBufferAppendNumber(buffer, baseline) &&
+            ORKPDFBufferAppendString(buffer, " Td ") &&
+            ORKPDFBufferAppendLiteralString(buffer, text, length) &&
+            ORKPDFBufferAppendString(buffer, " Tj ET\n"));
+}
+
+bool ORKPDFStreamShowText(ORKPDFStream *stream, ORKPDFFont font, double fontSize, double x, double baseline, const uint8_t *text, size_t length) {
+    if (!ORKPDFStreamCheckPage(stream)) {
+        return false;
+    }
+    return ORKPDFBufferAppendText(&stream->content, font, fontSize, x, baseline, text, length) || ORKPDFStreamFail(stream, ENOMEM);
+}
+
+bool ORKPDFStreamStrokeLine(ORKPDFStream *stream, double x0, double y0, double x1, double y1, double lineWidth) {
+    if (!ORKPDFStreamCheckPage(stream)) {
+        return false;
+    }
+    ORKPDFBuffer *content = &stream->content;
+    bool appended = (ORKPDFBufferAppendNumber(content, lineWidth) &&
+                     ORKPDFBufferAppendString(content, " w ") &&
+                     ORKPDFBufferAppendNumber(content, x0) &&
+                     ORKPDFBufferAppendString(content, " ") &&
+                     ORKPDFBufferAppendNumber(content, y0) &&
+                     ORKPDFBufferAppendString(content, " m ") &&
+                     ORKPDFBufferAppendNumber(content, x1) &&
+                     ORKPDFBufferAppendString(content, " ") &&
+                     ORKPDFBufferAppendNumber(content, y1) &&
+                     ORKPDFBufferAppendString(content, " l S\n"));
+    return appended || ORKPDFStreamFail(stream, ENOMEM);
+}
+
+// Writes `pixels` with the RunLengthDecode filter's encoding: a run of 2 to 128 equal bytes is a
+// count byte of 257 - length and the byte, and anything else is a count byte of length - 1 and up to
+// 128 literal bytes. Signature images are mostly white, so they shrink to a fraction of their size.
+static bool ORKPDFStreamWriteRunLengthEncoded(ORKPDFStream *stream, const uint8_t *pixels, size_t count) {
+    size_t index = 0;
+    while (index < count) {
+        size_t run = 1;
+        while (index + run < count && run < 128 && pixels[index + run] == pixels[index]) {
+            run++;
+        }
+        if (run >= 2) {
+            uint8_t header[2] = { (uint8_t)(257 - run), pixels[index] };
+            if (!ORKPDFStreamWriteBytes(stream, header, sizeof(header))) {
+                return false;
+            }
+            index += run;
+            continue;
+        }
+        size_t start = index++;
+        while (index < count && index - start < 128 && !(index + 1 < count && pixels[index] == pixels[index + 1])) {
+            index++;
+        }
+        uint8_t header = (uint8_t)(index - start - 1);
+        if (!ORKPDFStreamWriteBytes(stream, &header, 1) || !ORKPDFStreamWriteBytes(stream, pixels + start, index - start)) {
+            return false;
+        }
+    }
+    uint8_t endOfData = 128;
+    return ORKPDFStreamWriteBytes(stream, &endOfData, 1);
+}
+
+bool ORKPDFStreamDrawGrayImage(ORKPDFStream *stream, const uint8_t *pixels, size_t pixelWidth, size_t pixelHeight, double x, double y, double width, double height) {
+    if (!ORKPDFStreamCheckPage(stream)) {
+        return false;
+    }
+    size_t image = ORKPDFStreamAllocateObject(stream);
+    size_t length = ORKPDFStreamAllocateObject(stream);
+    if (stream->error) {
+        return false;
+    }
+    
+    // The encoded length is only known once the data is written, so it follows in its own object.
+    bool written = (ORKPDFStreamBeginObject(stream, image) &&
+                    ORKPDFStreamWrite(stream, "<< /Type /XObject /Subtype /Image /Width ") &&
+                    ORKPDFStreamWriteInteger(stream, pixelWidth) &&
+                    ORKPDFStreamWrite(stream, " /Height ") &&
+                    ORKPDFStreamWriteInteger(stream, pixelHeight) &&
+                    ORKPDFStreamWrite(stream, " /ColorSpace /DeviceGray /BitsPerComponent 8 /Filter /RunLengthDecode /Length ") &&
+                    ORKPDFStreamWriteReference(stream, length) &&
+                    ORKPDFStreamWrite(stream, " >>\nstream\n"));
+    uint64_t dataStart = ORKPDFStreamPosition(stream);
+    written = (written &&
+               ORKPDFStreamWriteRunLengthEncoded(stream, pixels, pixelWidth * pixelHeight));
+    uint64_t dataLength = ORKPDFStreamPosition(stream) - dataStart;
+    written = (written &&
+               ORKPDFStreamWrite(stream, "\nendstream\nendobj\n") &&
+               ORKPDFStreamBeginObject(stream, length) &&
+               ORKPDFStreamWriteInteger(stream, dataLength) &&
+               ORKPDFStreamWrite(stream, "\nendobj\n"));
+    if (!written) {
+        return false;
+    }
+    
+    ORKPDFBuffer *content = &stream->content;
+    bool appended = (ORKPDFBufferAppend(&stream->pageImages, &image, sizeof(image)) &&
+                     ORKPDFBufferAppendString(content, "q ") &&
+                     ORKPDFBufferAppendNumber(content, width) &&
+                     ORKPDFBufferAppendString(content, " 0 0 ") &&
+                     ORKPDFBufferAppendNumber(content, height) &&
+                     ORKPDFBufferAppendString(content, " ") &&
+                     ORKPDFBufferAppendNumber(content, x) &&
+                     ORKPDFBufferAppendString(content, " ") &&
+                     ORKPDFBufferAppendNumber(content, y) &&
+                     ORKPDFBufferAppendString(content, " cm /Im") &&
+                     ORKPDFBufferAppendInteger(content, image) &&
+                     ORKPDFBufferAppendString(content, " Do Q\n"));
+    return appended || ORKPDFStreamFail(stream, ENOMEM);
+}
+
+bool ORKPDFStreamEndPage(ORKPDFStream *stream) {
+    if (!ORKPDFStreamCheckPage(stream)) {
+        return false;
+    }
+    if (stream->pageCount == stream->pageCapacity) {
+        size_t capacity = stream->pageCapacity ? stream->pageCapacity * 2 : 16;
+        ORKPDFPageRecord *pages = realloc(stream->pages, capacity * sizeof(ORKPDFPageRecord));
+        if (!pages) {
+            return ORKPDFStreamFail(stream, ENOMEM);
+        }
+        stream->pages = pages;
+        stream->pageCapacity = capacity;
+    }
+    
+    size_t footer = 0;
+    if (stream->footerFunction) {
+        // The footer is a form drawn by every page and written once the page count is known.
+        footer = ORKPDFStreamAllocateObject(stream);
+        if (!ORKPDFBufferAppendString(&stream->content, "/Footer Do\n")) {
+            return ORKPDFStreamFail(stream, ENOMEM);
+        }
+    }
+    size_t contents = ORKPDFStreamAllocateObject(stream);
+    size_t page = ORKPDFStreamAllocateObject(stream);
+    if (stream->error || !ORKPDFStreamWriteStreamObject(stream, contents, "", &stream->content)) {
+        return false;
+    }
+    
+    bool written = (ORKPDFStreamBeginObject(stream, page) &&
+                    ORKPDFStreamWrite(stream, "<< /Type /Page /Parent ") &&
+                    ORKPDFStreamWriteReference(stream, ORKPDFPagesObject) &&
+                    ORKPDFStreamWrite(stream, " /MediaBox [0 0 ") &&
+                    ORKPDFStreamWriteNumber(stream, stream->pageWidth) &&
+                    ORKPDFStreamWrite(stream, " ") &&
+                    ORKPDFStreamWriteNumber(stream, stream->pageHeight) &&
+                    ORKPDFStreamWrite(stream, "] /Resources << ") &&
+                    ORKPDFStreamWriteFontResources(stream));
+    size_t imageCount = stream->pageImages.length / sizeof(size_t);
+    if (written && (imageCount > 0 || footer)) {
+        written = ORKPDFStreamWrite(stream, " /XObject <<");
+        const size_t *images = (const size_t *)stream->pageImages.bytes;
+        for (size_t index = 0; written && index < imageCount; index++) {
+            written = (ORKPDFStreamWrite(stream, " /Im") &&
+                       ORKPDFStreamWriteInteger(stream, images[index]) &&
+                       ORKPDFStreamWrite(stream, " ") &&
+                       ORKPDFStreamWriteReference(stream, images[index]));
+        }
+        if (written && footer) {
+            written = ORKPDFStreamWrite(stream, " /Footer ") && ORKPDFStreamWriteReference(stream, footer);
+        }
+        written = written && ORKPDFStreamWrite(stream, " >>");
+    }
+    written = (written &&
+               ORKPDFStreamWrite(stream, " >> /Contents ") &&
+               ORKPDFStreamWriteReference(stream, contents) &&
+               ORKPDFStreamWrite(stream, " >>\nendobj\n"));
+    if (!written) {
+        return false;
+    }
+    
+    stream->pages[stream->pageCount++] = (ORKPDFPageRecord){
+        .pageObject = page,
+        .footerObject = footer,
+        .width = stream->pageWidth,
+        .height = stream->pageHeight,
+    };
+    stream->pageOpen = false;
+    return true;
+}
+
+static bool ORKPDFStreamWriteFooters(ORKPDFStream *stream) {
+    uint8_t text[ORKPDFFooterCapacity];
+    ORKPDFBuffer content = { 0 };
+    bool written = true;
+    for (size_t index = 0; written && index < stream->pageCount; index++) {
+        const ORKPDFPageRecord *page = &stream->pages[index];
+        if (!page->footerObject) {
+            continue;
+        }
+        size_t length = stream->footerFunction(stream->footerContext, index, stream->pageCount, text, sizeof(text));
+        length = length < sizeof(text) ? length : sizeof(text);
+        double x = (page->width - ORKPDFFontTextWidth(stream->footerFont, stream->footerFontSize, text, length)) / 2;
+        
+        content.length = 0;
+        if (!ORKPDFBufferAppendText(&content, stream->footerFont, stream->footerFontSize, x, stream->footerBaseline, text, length)) {
+            written = ORKPDFStreamFail(stream, ENOMEM);
+            break;
+        }
+        content.length--; // The trailing newline is supplied by the stream object.
+        written = (ORKPDFStreamBeginObject(stream, page->footerObject) &&
+                   ORKPDFStreamWrite(stream, "<< /Type /XObject /Subtype /Form /BBox [0 0 ") &&
+                   ORKPDFStreamWriteNumber(stream, page->width) &&
+                   ORKPDFStreamWrite(stream, " ") &&
+                   ORKPDFStreamWriteNumber(stream, page->height) &&
+                   ORKPDFStreamWrite(stream, "] /Resources << ") &&
+                   ORKPDFStreamWriteFontResources(stream) &&
+                   ORKPDFStreamWrite(stream, " >> /Length ") &&
+                   ORKPDFStreamWriteInteger(stream, content.length) &&
+                   ORKPDFStreamWrite(stream, " >>\nstream\n") &&
+                   ORKPDFStreamWriteBytes(stream, content.bytes, content.length) &&
+                   ORKPDFStreamWrite(stream, "\nendstream\nendobj\n"));
+    }
+    ORKPDFBufferFree(&content);
+    return written;
+}
+
+bool ORKPDFStreamFinish(ORKPDFStream *stream) {
+    if (stream->error) {
+        return false;
+    }
+    if (stream->pageOpen || stream->finished) {
+        return ORKPDFStreamFail(stream, EINVAL);
+    }
+    stream->finished = true;
+    
+    if (stream->footerFunction && !ORKPDFStreamWriteFooters(stream)) {
+        return false;
+    }
+    
+    bool written = (ORKPDFStreamBeginObject(stream, ORKPDFPagesObject) &&
+                    ORKPDFStreamWrite(stream, "<< /Type /Pages /Kids ["));
+    for (size_t index = 0; written && index < stream->pageCount; index++) {
+        written = ((index == 0 || ORKPDFStreamWrite(stream, " ")) &&
+                   ORKPDFStreamWriteReference(stream, stream->pages[index].pageObject));
+    }
+    written = (written &&
+               ORKPDFStreamWrite(stream, "] /Count ") &&
+               ORKPDFStreamWriteInteger(stream, stream->pageCount) &&
+               ORKPDFStreamWrite(stream, " >>\nendobj\n"));
+    if (!written) {
+        return false;
+    }
+    
+    uint64_t crossReferenceOffset = ORKPDFStreamPosition(stream);
+    written = (ORKPDFStreamWrite(stream, "xref\n0 ") &&
+               ORKPDFStreamWriteInteger(stream, stream->objectCount + 1) &&
+               ORKPDFStreamWrite(stream, "\n0000000000 65535 f \n"));
+    for (size_t object = 1; written && object <= stream->objectCount; object++) {
+        // Each entry is exactly 20 bytes: a 10-digit offset, the generation, and the in-use marker.
+        char entry[21] = "0000000000 00000 n \n";
+        uint64_t offset = stream->objectOffsets[object];
+        for (int digit = 9; digit >= 0; digit--) {
+            entry[digit] = (char)('0' + offset % 10);
+            offset /= 10;
+        }
+        written = ORKPDFStreamWrite(stream, entry);
+    }
+    written = (written &&
+               ORKPDFStreamWrite(stream, "trailer\n<< /Size ") &&
+               ORKPDFStreamWriteInteger(stream, stream->objectCount + 1) &&
+               ORKPDFStreamWrite(stream, " /Root ") &&
+               ORKPDFStreamWriteReference(stream, ORKPDFCatalogObject) &&
+               ORKPDFStreamWrite(stream, " >>\nstartxref\n") &&
+               ORKPDFStreamWriteInteger(stream, crossReferenceOffset) &&
+               ORKPDFStreamWrite(stream, "\n%%EOF\n"));
+    return written && ORKPDFStreamFlush(stream);
+}
+
+int ORKPDFStreamError(const ORKPDFStream *stream) {
+    return stream->error;
+}
+
+size_t ORKPDFStreamPageCount(const ORKPDFStream *stream) {
+    return stream->pageCount;
+}
+
+uint64_t ORKPDFStreamBytesWritten(const ORKPDFStream *stream) {
+    return ORKPDFStreamPosition(stream);
+}
+
+double ORKPDFFontTextWidth(ORKPDFFont font, double fontSize, const uint8_t *text, size_t length) {
+    const uint16_t *widths = (font == ORKPDFFontHelveticaBold) ? ORKPDFHelveticaBoldWidths : ORKPDFHelveticaWidths;
+    uint64_t total = 0;
+    for (size_t index = 0; index < length; index++) {
+        total += widths[text[index]];
+    }
+    return (double)total * fontSize / 1000.0;
+}
@@ -0,0 +1,122 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef ORKPDFStream_h
+#define ORKPDFStream_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*
+ A minimal PDF writer that streams each object to a file descriptor as soon as it is complete.
+ 
+ Only what the consent document needs is supported: the standard Helvetica and Helvetica-Bold
+ fonts with WinAnsi-encoded text, stroked lines, and 8-bit grayscale images. Page content is
+ buffered until the page ends, images are written as they are drawn, and the cross-reference
+ table records each object's offset as it is written, so memory use does not grow with the
+ number of pages. The output does not depend on the time or the locale, so the same calls
+ always produce the same bytes.
+ 
+ The writer is plain C so that it can be built and tested without Foundation.
+ */
+
+typedef struct ORKPDFStream ORKPDFStream;
+
+typedef enum {
+    ORKPDFFontHelvetica = 0,
+    ORKPDFFontHelveticaBold = 1,
+} ORKPDFFont;
+
+/*
+ Fills `buffer` with the WinAnsi-encoded footer for the page at `pageIndex` of `pageCount`, and
+ returns the number of bytes written, at most `capacity`.
+ */
+typedef size_t (*ORKPDFFooterFunction)(void *context, size_t pageIndex, size_t pageCount, uint8_t *buffer, size_t capacity);
+
+/*
+ Returns a writer that writes to `fileDescriptor`, which it does not close, or NULL if memory
+ cannot be allocated. The file header is written immediately.
+ */
+ORKPDFStream *ORKPDFStreamCreate(int fileDescriptor);
+
+void ORKPDFStreamDestroy(ORKPDFStream *stream);
+
+/*
+ Draws a footer, centered at `baseline` above the bottom of every page, with text from
+ `function`. The footer is written when the stream finishes, when the page count is known.
+ */
+void ORKPDFStreamSetFooter(ORKPDFStream *stream, ORKPDFFooterFunction function, void *context, ORKPDFFont font, double fontSize, double baseline);
+
+/*
+ Page coordinates have their origin at the bottom left of the page, in points.
+ */
+bool ORKPDFStreamBeginPage(ORKPDFStream *stream, double width, double height);
+
+bool ORKPDFStreamShowText(ORKPDFStream *stream, ORKPDFFont font, double fontSize, double x, double baseline, const uint8_t *text, size_t length);
+
+bool ORKPDFStreamStrokeLine(ORKPDFStream *stream, double x0, double y0, double x1, double y1, double lineWidth);
+
+/*
+ Draws `pixelWidth` by `pixelHeight` 8-bit gray pixels, rows top to bottom, into the given rectangle.
+ */
+bool ORKPDFStreamDrawGrayImage(ORKPDFStream *stream, const uint8_t *pixels, size_t pixelWidth, size_t pixelHeight, double x, double y, double width, double height);
+
+bool ORKPDFStreamEndPage(ORKPDFStream *stream);
+
+/*
+ Writes the page tree, the footers, and the cross-reference table. No page may be open.
+ */
+bool ORKPDFStreamFinish(ORKPDFStream *stream);
+
+/*
+ The `errno` value of the first failure, or 0. Once a call fails every later call fails too.
+ */
+int ORKPDFStreamError(const ORKPDFStream *stream);
+
+size_t ORKPDFStreamPageCount(const ORKPDFStream *stream);
+
+uint64_t ORKPDFStreamBytesWritten(const ORKPDFStream *stream);
+
+/*
+ The advance width of WinAnsi-encoded `text` set in `font` at `fontSize`, in points.
+ */
+double ORKPDFFontTextWidth(ORKPDFFont font, double fontSize, const uint8_t *text, size_t length);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* ORKPDFStream_h */
@@ -0,0 +1,100 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <ResearchKit/ORKDefines.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The `ORKRandomNumberGenerator` class is a seedable pseudorandom number generator used by active
+ tasks to generate their stimuli.
+ 
+ Two generators created with the same seed produce the same sequence of values, so a step that draws
+ all of its random choices from its generator can be replayed exactly from the seed recorded in its
+ `ORKRandomSeedResult`. The generator uses the xoshiro256** algorithm, whose state is expanded from
+ the 64-bit seed with SplitMix64. It is fast, but it is not suitable for cryptographic use.
+ 
+ A generator is not thread-safe; use it from one thread at a time.
+ */
+ORK_CLASS_AVAILABLE
+@interface ORKRandomNumberGenerator : NSObject <NSCopying>
+
+/**
+ Returns a generator seeded with a value from the system's cryptographic random number generator.
+ */
+- (instancetype)init;
+
+/**
+ Returns a generator that produces the sequence determined by `seed`.
+ 
+ @param seed    The seed of the generator.
+ 
+ @return A new generator.
+ */
+- (instancetype)initWithSeed:(uint64_t)seed NS_DESIGNATED_INITIALIZER;
+
+/**
+ The seed the generator was created with.
+ */
+@property (nonatomic, readonly) uint64_t seed;
+
+/**
+ Returns the next 64 random bits.
+ */
+- (uint64_t)nextUInt64;
+
+/**
+ Returns a uniformly distributed integer in the range `[0, upperBound)`, or `0` if `upperBound` is `0`.
+ 
+ This is a drop-in replacement for `arc4random_uniform`.
+ */
+- (uint32_t)uniformIntegerLessThan:(uint32_t)upperBound;
+
+/**
+ Returns a uniformly distributed double in the range `[0, 1)`.
+ */
+- (double)uniformDouble;
+
+/**
+ Returns `YES` or `NO` with equal probability.
+ */
+- (BOOL)randomBool;
+
+/**
+ Shuffles the array in place, with every permutation equally likely.
+ */
+- (void)shuffleArray:(NSMutableArray *)array;
+
+@end
+
+NS_ASSUME_NONNULL_END
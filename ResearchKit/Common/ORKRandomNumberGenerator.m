@@ -0,0 +1,131 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKRandomNumberGenerator.h"
+
+
+static inline uint64_t ORKRandomRotateLeft(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t ORKRandomSplitMix64(uint64_t *state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+
+@implementation ORKRandomNumberGenerator {
+    uint64_t _state[4];
+}
+
+- (instancetype)init {
+    uint64_t seed = 0;
+    arc4random_buf(&seed, sizeof(seed));
+    return [self initWithSeed:seed];
+}
+
+- (instancetype)initWithSeed:(uint64_t)seed {
+    self = [super init];
+    if (self) {
+        _seed = seed;
+        uint64_t splitMixState = seed;
+        for (NSUInteger index = 0; index < 4; index++) {
+            _state[index] = ORKRandomSplitMix64(&splitMixState);
+        }
+    }
+    return self;
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone {
+    ORKRandomNumberGenerator *generator = [[[self class] allocWithZone:zone] initWithSeed:_seed];
+    memcpy(generator->_state, _state, sizeof(_state));
+    return generator;
+}
+
+- (uint64_t)nextUInt64 {
+    const uint64_t result = ORKRandomRotateLeft(_state[1] * 5, 7) * 9;
+    const uint64_t t = _state[1] << 17;
+    
+    _state[2] ^= _state[0];
+    _state[3] ^= _state[1];
+    _state[1] ^= _state[2];
+    _state[0] ^= _state[3];
+    _state[2] ^= t;
+    _state[3] = ORKRandomRotateLeft(_state[3], 45);
+    
+    return result;
+}
+
+- (uint32_t)uniformIntegerLessThan:(uint32_t)upperBound {
+    if (upperBound < 2) {
+        return 0;
+    }
+    
+    // Lemire's multiply-and-shift, rejecting only the few products that would bias the result.
+    uint64_t product = (uint64_t)(uint32_t)([self nextUInt64] >> 32) * upperBound;
+    uint32_t low = (uint32_t)product;
+    if (low < upperBound) {
+        const uint32_t threshold = -upperBound % upperBound;
+        while (low < threshold) {
+            product = (uint64_t)(uint32_t)([self nextUInt64] >> 32) * upperBound;
+            low = (uint32_t)product;
+        }
+    }
+    return (uint32_t)(product >> 32);
+}
+
+- (double)uniformDouble {
+    return ([self nextUInt64] >> 11) * 0x1.0p-53;
+}
+
+- (BOOL)randomBool {
+    return ([self nextUInt64] >> 63) != 0;
+}
+
+- (void)shuffleArray:(NSMutableArray *)array {
+    NSUInteger count = array.count;
+    if (count < 2) {
+        return;
+    }
+    NSParameterAssert(count <= UINT32_MAX);
+    for (NSUInteger index = count - 1; index > 0; index--) {
+        NSUInteger otherIndex = [self uniformIntegerLessThan:(uint32_t)(index + 1)];
+        [array exchangeObjectAtIndex:index withObjectAtIndex:otherIndex];
+    }
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p; seed: %llu>", self.class.description, self, _seed];
+}
+
+@end
@@ -1,5 +1,5 @@
 /*
- Copyright (c) 2015, James Cox. All rights reserved.
+ Copyright (c) 2024, Apple Inc. All rights reserved.
  
  Redistribution and use in source and binary forms, with or without modification,
  are permitted provided that the following conditions are met:
@@ -29,20 +29,25 @@
  */
 
 
-@import Foundation;
+#import <ResearchKit/ORKResult.h>
 
 
 NS_ASSUME_NONNULL_BEGIN
 
-@interface ORKTowerOfHanoiTower : NSObject
-
-@property (nonatomic, copy, readonly) NSArray *disks;
-
-+ (instancetype)emptyTower;
-
-- (instancetype)initWithDisks:(NSArray *)disks;
+/**
+ The `ORKRandomSeedResult` class records the seed of the random number generator that produced
+ the stimuli of a step.
+ 
+ Create an `ORKRandomNumberGenerator` with the same seed to regenerate the stimuli exactly, for
+ example to replay a session or to validate an analysis offline.
+ */
+ORK_CLASS_AVAILABLE
+@interface ORKRandomSeedResult : ORKResult
 
-- (BOOL)recieveDiskFrom:(ORKTowerOfHanoiTower *)donorTower;
+/**
+ The seed of the generator.
+ */
+@property (nonatomic, assign) uint64_t seed;
 
 @end
 
@@ -1,5 +1,5 @@
 /*
- Copyright (c) 2015, James Cox. All rights reserved.
+ Copyright (c) 2024, Apple Inc. All rights reserved.
  
  Redistribution and use in source and binary forms, with or without modification,
  are permitted provided that the following conditions are met:
@@ -29,46 +29,51 @@
  */
 
 
-#import "ORKTowerOfHanoiTower.h"
+#import "ORKRandomSeedResult.h"
 
+#import "ORKResult_Private.h"
+#import "ORKHelpers_Internal.h"
 
-@interface ORKTowerOfHanoiTower ()
 
-@property (nonatomic, copy, readwrite) NSArray *disks;
+@implementation ORKRandomSeedResult
 
-@end
-
-
-@implementation ORKTowerOfHanoiTower
-
-+ (instancetype)emptyTower {
-    return [[ORKTowerOfHanoiTower alloc]initWithDisks:@[]];
+- (void)encodeWithCoder:(NSCoder *)aCoder {
+    [super encodeWithCoder:aCoder];
+    ORK_ENCODE_UINT64(aCoder, seed);
 }
 
-- (instancetype)initWithDisks:(NSArray *)disks {
-    self = [super init];
+- (instancetype)initWithCoder:(NSCoder *)aDecoder {
+    self = [super initWithCoder:aDecoder];
     if (self) {
-        _disks = disks;
+        ORK_DECODE_UINT64(aDecoder, seed);
     }
     return self;
 }
 
-- (BOOL)canRecieveDisk:(NSNumber *)disk {
-    return _disks.count == 0 || ((NSNumber *)_disks.lastObject).integerValue > disk.integerValue;
++ (BOOL)supportsSecureCoding {
+    return YES;
 }
 
-- (BOOL)recieveDiskFrom:(ORKTowerOfHanoiTower*)donorTower {
-    if (donorTower.disks.count == 0  || ![self canRecieveDisk:donorTower.disks.lastObject]) {
-        return NO;
-    }
-    NSMutableArray *recipientDisks = [self.disks mutableCopy];
-    NSMutableArray *donorDisks = [donorTower.disks mutableCopy];
-    [recipientDisks addObject:donorTower.disks.lastObject];
-    [donorDisks removeLastObject];
-    self.disks = recipientDisks;
-    donorTower.disks = donorDisks;
+- (BOOL)isEqual:(id)object {
+    BOOL isParentSame = [super isEqual:object];
     
-    return YES;
+    __typeof(self) castObject = object;
+    return (isParentSame &&
+            (self.seed == castObject.seed));
+}
+
+- (NSUInteger)hash {
+    return super.hash ^ (NSUInteger)self.seed;
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone {
+    ORKRandomSeedResult *result = [super copyWithZone:zone];
+    result.seed = self.seed;
+    return result;
+}
+
+- (NSString *)descriptionWithNumberOfPaddingSpaces:(NSUInteger)numberOfPaddingSpaces {
+    return [NSString stringWithFormat:@"%@; seed: %llu%@", [self descriptionPrefixWithNumberOfPaddingSpaces:numberOfPaddingSpaces], self.seed, self.descriptionSuffix];
 }
 
 @end
@@ -226,6 +226,14 @@ ORK_CLASS_AVAILABLE
  */
 @property (nonatomic, readonly) double frequency;
 
+/**
+ A Boolean value indicating whether the recorder estimates tremor features while recording.
+ 
+ When the value is `YES`, the recorder reports an `ORKTremorResult` in addition to its file result
+ when it stops. The default value is `NO`.
+ */
+@property (nonatomic) BOOL analyzesTremor;
+
 /**
  Returns an initialized device motion recorder configuration using the specified frequency.
  
@@ -328,6 +336,34 @@ ORK_CLASS_AVAILABLE
  */
 - (instancetype)initWithIdentifier:(NSString *)identifier NS_DESIGNATED_INITIALIZER;
 
+/**
+ A Boolean value indicating whether the recorder writes compact trajectory records.
+ 
+ When the value is `YES`, each location is logged as an array of fixed-point differences from the
+ previous location instead of a dictionary, and locations within `trajectoryTolerance` of the
+ simplified trajectory are left out. The log starts with a dictionary describing the encoding and
+ ends with one summarizing the locations that were left out. `ORKTrajectoryEncoder` restores the
+ uncompressed log format. The default value is `NO`.
+ */
+@property (nonatomic) BOOL compressesTrajectory;
+
+/**
+ The largest distance, in meters, by which a location left out of a compressed trajectory may
+ deviate from it.
+ 
+ The default value is 0, which keeps every location.
+ */
+@property (nonatomic) double trajectoryTolerance;
+
+/**
+ A Boolean value indicating whether the recorder estimates the distance walked while recording.
+ 
+ When the value is `YES`, the recorder reports an `ORKWalkingDistanceResult` in addition to its
+ file result when it stops. Pedometer recorders of the same step contribute their step counts to
+ the estimate, which bridges gaps in location coverage. The default value is `NO`.
+ */
+@property (nonatomic) BOOL estimatesWalkingDistance;
+
 /**
  Returns a new location recorder configuration initialized from data in the given unarchiver.
  
@@ -191,6 +191,10 @@
     return @"recorder";
 }
 
+- (ORKTimelineTimebase)timelineTimebase {
+    return ORKTimelineTimebaseSystemUptime;
+}
+
 - (NSString *)logName {
     return [NSString stringWithFormat:@"%@_%@", [self recorderType], _recorderUUID.UUIDString];
 }
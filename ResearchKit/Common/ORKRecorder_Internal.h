@@ -30,6 +30,7 @@
 
 
 #import "ORKRecorder_Private.h"
+#import "ORKTimelineAlignmentResult.h"
 
 
 NS_ASSUME_NONNULL_BEGIN
@@ -48,6 +49,9 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (NSString *)recorderType;
 
+// The timebase of the timestamps the recorder writes. Defaults to ORKTimelineTimebaseSystemUptime.
+- (ORKTimelineTimebase)timelineTimebase;
+
 - (nullable ORKDataLogger *)makeJSONDataLoggerWithError:(NSError * _Nullable *)error NS_REQUIRES_SUPER;
 
 - (void)reset NS_REQUIRES_SUPER;
@@ -0,0 +1,94 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Storage for small secrets, keyed by string.
+ 
+ Backends report a missing key the way the keychain does: `nil` with an `NSOSStatusErrorDomain` error whose
+ code is `errSecItemNotFound`.
+ */
+@protocol ORKSecureStorageBackend <NSObject>
+
+- (nullable NSData *)dataForKey:(NSString *)key error:(NSError * _Nullable *)error;
+
+/**
+ Applies a set of changes. Each value is the new data for its key, or `NSNull` to remove the key.
+ 
+ Changes are applied one key at a time; after a failure, some of the changes may have been applied.
+ */
+- (BOOL)applyChanges:(NSDictionary<NSString *, id> *)changes error:(NSError * _Nullable *)error;
+
+- (BOOL)removeAllDataWithError:(NSError * _Nullable *)error;
+
+@end
+
+
+/**
+ Stores generic password items in the keychain under one service.
+ */
+@interface ORKKeychainSecureStorageBackend : NSObject <ORKSecureStorageBackend>
+
+/**
+ Returns a backend for `service`, or for the main bundle identifier if `service` is nil.
+ */
+- (instancetype)initWithService:(nullable NSString *)service accessGroup:(nullable NSString *)accessGroup NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, copy, readonly) NSString *service;
+
+@property (nonatomic, copy, readonly, nullable) NSString *accessGroup;
+
+@end
+
+
+/**
+ Keeps items in a dictionary. Useful for tests and benchmarks off-device.
+ */
+@interface ORKInMemorySecureStorageBackend : NSObject <ORKSecureStorageBackend>
+
+/// The number of `dataForKey:error:` calls made so far.
+@property (readonly) NSUInteger readCount;
+
+/// The number of `applyChanges:error:` calls made so far.
+@property (readonly) NSUInteger writeCount;
+
+/// When set, `applyChanges:error:` and `removeAllDataWithError:` fail with this error and change nothing.
+@property (copy, nullable) NSError *writeError;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,252 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKSecureStorageBackend.h"
+
+#import "ORKHelpers_Internal.h"
+#import "ResearchKit/ResearchKit-Swift.h"
+
+#import <Security/Security.h>
+
+
+static NSString *ORKKeychainWrapperDefaultService(void) {
+    static NSString *defaultService;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        defaultService = [[NSBundle mainBundle] bundleIdentifier];
+    });
+    return defaultService;
+}
+
+static NSError *ORKKeychainErrorWithStatus(OSStatus status, NSString *messageKey) {
+    return [NSError errorWithDomain:NSOSStatusErrorDomain
+                               code:status
+                           userInfo:@{NSLocalizedDescriptionKey: ORKLocalizedString(messageKey, nil)}];
+}
+
+
+@implementation ORKKeychainSecureStorageBackend
+
+- (instancetype)initWithService:(NSString *)service accessGroup:(NSString *)accessGroup {
+    self = [super init];
+    if (self) {
+        _service = [(service ? : ORKKeychainWrapperDefaultService()) copy];
+        _accessGroup = [accessGroup copy];
+    }
+    return self;
+}
+
+- (NSMutableDictionary *)queryForKey:(NSString *)key {
+    NSMutableDictionary *query = [[NSMutableDictionary alloc] init];
+    [query setObject:(__bridge id)kSecClassGenericPassword forKey:(__bridge id)kSecClass];
+    [query setObject:_service forKey:(__bridge id)kSecAttrService];
+    if (key) {
+        [query setObject:key forKey:(__bridge id)kSecAttrAccount];
+    }
+#if !TARGET_IPHONE_SIMULATOR && defined(__IPHONE_OS_VERSION_MIN_REQUIRED)
+    if (_accessGroup) {
+        [query setObject:_accessGroup forKey:(__bridge id)kSecAttrAccessGroup];
+    }
+#endif
+    return query;
+}
+
+- (NSData *)dataForKey:(NSString *)key error:(NSError **)errorOut {
+    NSMutableDictionary *query = [self queryForKey:key];
+    [query setObject:(__bridge id)kCFBooleanTrue forKey:(__bridge id)kSecReturnData];
+    [query setObject:(__bridge id)kSecMatchLimitOne forKey:(__bridge id)kSecMatchLimit];
+    
+    CFTypeRef data = nil;
+    OSStatus status = SecItemCopyMatching((__bridge CFDictionaryRef)query, &data);
+    if (status != errSecSuccess) {
+        if (errorOut != NULL) {
+            *errorOut = ORKKeychainErrorWithStatus(status, @"KEYCHAIN_FIND_ERROR_MESSAGE");
+        }
+        return nil;
+    }
+    return (__bridge_transfer NSData *)data;
+}
+
+- (BOOL)setData:(NSData *)data forKey:(NSString *)key error:(NSError **)errorOut {
+    // Update first; only a missing item needs the second round trip to add it.
+    NSDictionary *query = [self queryForKey:key];
+    OSStatus status = SecItemUpdate((__bridge CFDictionaryRef)query, (__bridge CFDictionaryRef)@{(__bridge id)kSecValueData: data});
+    if (status == errSecSuccess) {
+        return YES;
+    }
+    if (status != errSecItemNotFound) {
+        if (errorOut != NULL) {
+            *errorOut = ORKKeychainErrorWithStatus(status, @"KEYCHAIN_UPDATE_ERROR_MESSAGE");
+        }
+        return NO;
+    }
+    
+    NSMutableDictionary *attributes = [self queryForKey:key];
+#if TARGET_OS_IPHONE || (defined(MAC_OS_X_VERSION_10_9) && MAC_OS_X_VERSION_MIN_REQUIRED >= MAC_OS_X_VERSION_10_9)
+    [attributes setObject:(__bridge id)kSecAttrAccessibleAfterFirstUnlock forKey:(__bridge id)kSecAttrAccessible];
+#endif
+    [attributes setObject:data forKey:(__bridge id)kSecValueData];
+    
+    status = SecItemAdd((__bridge CFDictionaryRef)attributes, NULL);
+    if (status != errSecSuccess) {
+        if (errorOut != NULL) {
+            *errorOut = ORKKeychainErrorWithStatus(status, @"KEYCHAIN_ADD_ERROR_MESSAGE");
+        }
+        return NO;
+    }
+    return YES;
+}
+
+- (BOOL)removeDataForKey:(NSString *)key error:(NSError **)errorOut {
+    OSStatus status = SecItemDelete((__bridge CFDictionaryRef)[self queryForKey:key]);
+    if (status != errSecSuccess && status != errSecItemNotFound) {
+        if (errorOut != NULL) {
+            *errorOut = ORKKeychainErrorWithStatus(status, @"KEYCHAIN_DELETE_ERROR_MESSAGE");
+        }
+        return NO;
+    }
+    return YES;
+}
+
+- (BOOL)applyChanges:(NSDictionary<NSString *, id> *)changes error:(NSError **)errorOut {
+    __block BOOL success = YES;
+    __block NSError *error = nil;
+    [changes enumerateKeysAndObjectsUsingBlock:^(NSString *key, id value, BOOL *stop) {
+        if (value == [NSNull null]) {
+            success = [self removeDataForKey:key error:&error];
+        } else {
+            success = [self setData:value forKey:key error:&error];
+        }
+        *stop = !success;
+    }];
+    if (!success && errorOut != NULL) {
+        *errorOut = error;
+    }
+    return success;
+}
+
+- (NSArray *)itemsWithError:(NSError **)errorOut {
+    NSMutableDictionary *query = [self queryForKey:nil];
+    [query setObject:(id)kCFBooleanTrue forKey:(__bridge id)kSecReturnAttributes];
+    [query setObject:(__bridge id)kSecMatchLimitAll forKey:(__bridge id)kSecMatchLimit];
+    
+    CFTypeRef result = nil;
+    OSStatus status = SecItemCopyMatching((__bridge CFDictionaryRef)query, &result);
+    if (status == errSecItemNotFound) {
+        return @[];
+    }
+    if (status != errSecSuccess) {
+        if (errorOut != NULL) {
+            *errorOut = ORKKeychainErrorWithStatus(status, @"KEYCHAIN_FIND_ERROR_MESSAGE");
+        }
+        return nil;
+    }
+    return (__bridge_transfer NSArray *)result;
+}
+
+- (BOOL)removeAllDataWithError:(NSError **)errorOut {
+    NSArray *items = [self itemsWithError:errorOut];
+    if (items == nil) {
+        return NO;
+    }
+    
+    BOOL returnValue = YES;
+    for (NSDictionary *item in items) {
+        NSMutableDictionary *itemToDelete = [[NSMutableDictionary alloc] initWithDictionary:item];
+        [itemToDelete setObject:(__bridge id)kSecClassGenericPassword forKey:(__bridge id)kSecClass];
+        
+        OSStatus status = SecItemDelete((__bridge CFDictionaryRef)itemToDelete);
+        if (status != errSecSuccess && status != errSecItemNotFound) {
+            if (errorOut != NULL) {
+                *errorOut = ORKKeychainErrorWithStatus(status, @"KEYCHAIN_DELETE_ERROR_MESSAGE");
+            }
+            returnValue = NO;
+        }
+    }
+    return returnValue;
+}
+
+@end
+
+
+@implementation ORKInMemorySecureStorageBackend {
+    NSMutableDictionary<NSString *, NSData *> *_items;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _items = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (NSData *)dataForKey:(NSString *)key error:(NSError **)errorOut {
+    @synchronized (self) {
+        _readCount++;
+        NSData *data = _items[key];
+        if (data == nil && errorOut != NULL) {
+            *errorOut = ORKKeychainErrorWithStatus(errSecItemNotFound, @"KEYCHAIN_FIND_ERROR_MESSAGE");
+        }
+        return data;
+    }
+}
+
+- (BOOL)applyChanges:(NSDictionary<NSString *, id> *)changes error:(NSError **)errorOut {
+    @synchronized (self) {
+        _writeCount++;
+        if (_writeError != nil) {
+            if (errorOut != NULL) {
+                *errorOut = _writeError;
+            }
+            return NO;
+        }
+        [changes enumerateKeysAndObjectsUsingBlock:^(NSString *key, id value, __unused BOOL *stop) {
+            self->_items[key] = (value == [NSNull null]) ? nil : [value copy];
+        }];
+        return YES;
+    }
+}
+
+- (BOOL)removeAllDataWithError:(NSError **)errorOut {
+    @synchronized (self) {
+        if (_writeError != nil) {
+            if (errorOut != NULL) {
+                *errorOut = _writeError;
+            }
+            return NO;
+        }
+        [_items removeAllObjects];
+        return YES;
+    }
+}
+
+@end
@@ -53,6 +53,14 @@ ORK_CLASS_AVAILABLE
  */
 @property (nonatomic, copy, nullable) NSArray <UIBezierPath *> *signaturePath;
 
+/**
+ Draws the signature path again at `scale` pixels per point.
+ 
+ The image has the size of `signatureImage`, or of the bounds of the signature path if there is
+ no image. Returns `nil` if there is no signature path.
+ */
+- (nullable UIImage *)signatureImageWithScale:(CGFloat)scale;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -33,6 +33,7 @@
 
 #import "ORKResult_Private.h"
 #import "ORKHelpers_Internal.h"
+#import "ORKStrokeCodec.h"
 
 
 @implementation ORKSignatureResult
@@ -40,10 +41,18 @@
 - (instancetype)initWithIdentifier:(NSString *)identifier
                     signatureImage:(UIImage *)signatureImage
                      signaturePath:(NSArray <UIBezierPath *> *)signaturePath {
+    return [self initWithIdentifier:identifier signatureImage:signatureImage signaturePath:signaturePath strokeSamples:nil];
+}
+
+- (instancetype)initWithIdentifier:(NSString *)identifier
+                    signatureImage:(UIImage *)signatureImage
+                     signaturePath:(NSArray <UIBezierPath *> *)signaturePath
+                     strokeSamples:(NSArray<NSData *> *)strokeSamples {
     self = [super initWithIdentifier:identifier];
     if (self) {
         _signatureImage = [signatureImage copy];
         _signaturePath = ORKArrayCopyObjects(signaturePath);
+        _strokeSamples = [strokeSamples copy];
     }
     return self;
 }
@@ -51,14 +60,31 @@
 - (void)encodeWithCoder:(NSCoder *)aCoder {
     [super encodeWithCoder:aCoder];
     ORK_ENCODE_IMAGE(aCoder, signatureImage);
-    ORK_ENCODE_OBJ(aCoder, signaturePath);
+    // Paths and samples are stored in the compact stroke encoding rather than as archived objects.
+    ORKStrokeCodec *codec = [ORKStrokeCodec new];
+    if (_signaturePath) {
+        [aCoder encodeObject:[codec dataWithPaths:_signaturePath] forKey:@"signatureStrokes"];
+    }
+    if (_strokeSamples) {
+        [aCoder encodeObject:[codec dataWithSamples:_strokeSamples] forKey:@"strokeSamples"];
+    }
 }
 
 - (instancetype)initWithCoder:(NSCoder *)aDecoder {
     self = [super initWithCoder:aDecoder];
     if (self) {
         ORK_DECODE_IMAGE(aDecoder, signatureImage);
-        ORK_DECODE_OBJ_ARRAY(aDecoder, signaturePath, UIBezierPath);
+        NSData *strokes = [aDecoder decodeObjectOfClass:[NSData class] forKey:@"signatureStrokes"];
+        if (strokes) {
+            _signaturePath = [ORKStrokeCodec pathsWithData:strokes error:NULL];
+        } else {
+            // Results archived before the stroke encoding keep the paths as objects.
+            ORK_DECODE_OBJ_ARRAY(aDecoder, signaturePath, UIBezierPath);
+        }
+        NSData *samples = [aDecoder decodeObjectOfClass:[NSData class] forKey:@"strokeSamples"];
+        if (samples) {
+            _strokeSamples = [ORKStrokeCodec samplesWithData:samples error:NULL];
+        }
     }
     return self;
 }
@@ -68,7 +94,7 @@
 }
 
 - (NSUInteger)hash {
-    return super.hash ^ self.signatureImage.hash ^ self.signaturePath.hash;
+    return super.hash ^ self.signatureImage.hash ^ self.signaturePath.hash ^ self.strokeSamples.hash;
 }
 
 - (BOOL)isEqual:(id)object {
@@ -77,14 +103,31 @@
     __typeof(self) castObject = object;
     return (isParentSame &&
             ORKEqualObjects(self.signatureImage, castObject.signatureImage) &&
-            ORKEqualObjects(self.signaturePath, castObject.signaturePath));
+            ORKEqualObjects(self.signaturePath, castObject.signaturePath) &&
+            ORKEqualObjects(self.strokeSamples, castObject.strokeSamples));
 }
 
 - (instancetype)copyWithZone:(NSZone *)zone {
     ORKSignatureResult *result = [super copyWithZone:zone];
     result->_signatureImage = [_signatureImage copy];
     result->_signaturePath = ORKArrayCopyObjects(_signaturePath);
+    result->_strokeSamples = [_strokeSamples copy];
     return result;
 }
 
+- (UIImage *)signatureImageWithScale:(CGFloat)scale {
+    if (_signaturePath == nil) {
+        return nil;
+    }
+    CGSize size = _signatureImage.size;
+    if (CGSizeEqualToSize(size, CGSizeZero)) {
+        CGRect bounds = CGRectZero;
+        for (UIBezierPath *path in _signaturePath) {
+            bounds = CGRectUnion(bounds, CGRectInset(path.bounds, -path.lineWidth / 2, -path.lineWidth / 2));
+        }
+        size = CGSizeMake(ceil(CGRectGetMaxX(bounds)), ceil(CGRectGetMaxY(bounds)));
+    }
+    return [ORKStrokeCodec imageWithPaths:_signaturePath size:size scale:scale];
+}
+
 @end
@@ -40,6 +40,17 @@ NS_ASSUME_NONNULL_BEGIN
                     signatureImage:(UIImage *)signatureImage
                      signaturePath:(NSArray <UIBezierPath *> *)signaturePath;
 
+- (instancetype)initWithIdentifier:(NSString *)identifier
+                    signatureImage:(UIImage *)signatureImage
+                     signaturePath:(NSArray <UIBezierPath *> *)signaturePath
+                     strokeSamples:(nullable NSArray<NSData *> *)strokeSamples;
+
+/**
+ The touch samples of each stroke, as `NSData` objects holding consecutive `ORKStrokeSample`
+ values, for kinematic analysis of the signature.
+ */
+@property (nonatomic, copy, nullable) NSArray<NSData *> *strokeSamples;
+
 @end
 
 NS_ASSUME_NONNULL_END
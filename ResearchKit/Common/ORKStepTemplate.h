@@ -0,0 +1,95 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ORKStep;
+
+typedef ORKStep * _Nonnull (^ORKStepTemplateBuilder)(NSString *stepIdentifier);
+
+/**
+ An immutable description of a step that is built when it is first needed.
+ 
+ The builder receives the template's identifier and must return a step with that identifier. It may run on
+ any thread, so it should only capture immutable values. It normally runs once per task that holds the
+ template; if several threads ask for the same unbuilt step at once, each may run it and only one step is kept.
+ */
+@interface ORKStepTemplate : NSObject
+
++ (instancetype)templateWithIdentifier:(NSString *)identifier builder:(ORKStepTemplateBuilder)builder;
+
+- (instancetype)init NS_UNAVAILABLE;
+
++ (instancetype)new NS_UNAVAILABLE;
+
+@property (nonatomic, copy, readonly) NSString *identifier;
+
+/**
+ Runs the builder and validates the step it returns.
+ */
+- (ORKStep *)makeStep;
+
+@end
+
+
+/**
+ An immutable array of steps described by templates. Each step is built the first time it is accessed and
+ then kept, so repeated accesses return the same object.
+ 
+ Identifier lookups use the templates and build nothing. Archiving the array builds every step and produces
+ a plain `NSArray`.
+ */
+@interface ORKLazyStepArray : NSArray<ORKStep *>
+
+- (instancetype)initWithStepTemplates:(NSArray<ORKStepTemplate *> *)stepTemplates;
+
+@property (nonatomic, copy, readonly) NSArray<NSString *> *stepIdentifiers;
+
+/**
+ Returns the index of the step with `identifier`, or `NSNotFound`.
+ */
+- (NSUInteger)indexOfStepWithIdentifier:(NSString *)identifier;
+
+- (BOOL)isStepBuiltAtIndex:(NSUInteger)index;
+
+/**
+ Returns an array with the same templates, holding copies of the steps that have been built so far.
+ */
+- (ORKLazyStepArray *)copyCopyingBuiltSteps;
+
+- (nullable instancetype)initWithCoder:(NSCoder *)coder NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
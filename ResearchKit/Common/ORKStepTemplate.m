@@ -0,0 +1,214 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKStepTemplate.h"
+
+#import "ORKHelpers_Internal.h"
+#import "ORKStep.h"
+
+#import <os/lock.h>
+
+
+@implementation ORKStepTemplate {
+    ORKStepTemplateBuilder _builder;
+}
+
++ (instancetype)templateWithIdentifier:(NSString *)identifier builder:(ORKStepTemplateBuilder)builder {
+    return [[self alloc] initWithIdentifier:identifier builder:builder];
+}
+
+- (instancetype)initWithIdentifier:(NSString *)identifier builder:(ORKStepTemplateBuilder)builder {
+    ORKThrowInvalidArgumentExceptionIfNil(identifier)
+    ORKThrowInvalidArgumentExceptionIfNil(builder)
+    self = [super init];
+    if (self) {
+        _identifier = [identifier copy];
+        _builder = [builder copy];
+    }
+    return self;
+}
+
+- (ORKStep *)makeStep {
+    ORKStep *step = _builder(_identifier);
+    if (![step.identifier isEqualToString:_identifier]) {
+        @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                       reason:[NSString stringWithFormat:@"Template %@ built a step with identifier %@", _identifier, step.identifier]
+                                     userInfo:nil];
+    }
+    [step validateParameters];
+    return step;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p; identifier: %@>", self.class.description, self, _identifier];
+}
+
+@end
+
+
+@interface ORKLazyStepArray ()
+
+- (instancetype)initWithStepTemplates:(NSArray<ORKStepTemplate *> *)stepTemplates builtSteps:(nullable NSArray *)builtSteps NS_DESIGNATED_INITIALIZER;
+
+@end
+
+
+@implementation ORKLazyStepArray {
+    NSArray<ORKStepTemplate *> *_stepTemplates;
+    NSDictionary<NSString *, NSNumber *> *_indexesByIdentifier;
+    
+    os_unfair_lock _lock;
+    // One slot per template: the built step, or NSNull until it is first accessed.
+    NSMutableArray *_builtSteps;
+}
+
+- (instancetype)initWithStepTemplates:(NSArray<ORKStepTemplate *> *)stepTemplates builtSteps:(NSArray *)builtSteps {
+    self = [super init];
+    if (self) {
+        _stepTemplates = [stepTemplates copy];
+        _lock = OS_UNFAIR_LOCK_INIT;
+        
+        NSUInteger count = _stepTemplates.count;
+        NSMutableArray<NSString *> *stepIdentifiers = [NSMutableArray arrayWithCapacity:count];
+        NSMutableDictionary<NSString *, NSNumber *> *indexesByIdentifier = [NSMutableDictionary dictionaryWithCapacity:count];
+        [_stepTemplates enumerateObjectsUsingBlock:^(ORKStepTemplate *stepTemplate, NSUInteger index, __unused BOOL *stop) {
+            [stepIdentifiers addObject:stepTemplate.identifier];
+            if (indexesByIdentifier[stepTemplate.identifier] == nil) {
+                indexesByIdentifier[stepTemplate.identifier] = @(index);
+            }
+        }];
+        _stepIdentifiers = [stepIdentifiers copy];
+        _indexesByIdentifier = [indexesByIdentifier copy];
+        
+        if (builtSteps != nil) {
+            _builtSteps = [builtSteps mutableCopy];
+        } else {
+            _builtSteps = [NSMutableArray arrayWithCapacity:count];
+            for (NSUInteger index = 0; index < count; index++) {
+                [_builtSteps addObject:[NSNull null]];
+            }
+        }
+    }
+    return self;
+}
+
+- (instancetype)initWithStepTemplates:(NSArray<ORKStepTemplate *> *)stepTemplates {
+    return [self initWithStepTemplates:stepTemplates builtSteps:nil];
+}
+
+- (instancetype)initWithObjects:(const id _Nonnull [])objects count:(NSUInteger)count {
+    NSMutableArray<ORKStepTemplate *> *stepTemplates = [NSMutableArray arrayWithCapacity:count];
+    NSMutableArray *builtSteps = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        ORKStep *step = objects[index];
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:step.identifier builder:^ORKStep *(__unused NSString *stepIdentifier) {
+            return step;
+        }]];
+        [builtSteps addObject:step];
+    }
+    return [self initWithStepTemplates:stepTemplates builtSteps:builtSteps];
+}
+
+- (instancetype)init {
+    return [self initWithStepTemplates:@[] builtSteps:nil];
+}
+
+- (instancetype)initWithCoder:(NSCoder *)coder {
+    ORKThrowMethodUnavailableException();
+}
+
+- (NSUInteger)indexOfStepWithIdentifier:(NSString *)identifier {
+    NSNumber *index = identifier ? _indexesByIdentifier[identifier] : nil;
+    return index ? index.unsignedIntegerValue : NSNotFound;
+}
+
+- (BOOL)isStepBuiltAtIndex:(NSUInteger)index {
+    os_unfair_lock_lock(&_lock);
+    BOOL isBuilt = (_builtSteps[index] != [NSNull null]);
+    os_unfair_lock_unlock(&_lock);
+    return isBuilt;
+}
+
+- (ORKLazyStepArray *)copyCopyingBuiltSteps {
+    os_unfair_lock_lock(&_lock);
+    NSMutableArray *builtSteps = [NSMutableArray arrayWithCapacity:_builtSteps.count];
+    for (id step in _builtSteps) {
+        [builtSteps addObject:(step == [NSNull null]) ? step : [step copy]];
+    }
+    os_unfair_lock_unlock(&_lock);
+    return [[ORKLazyStepArray alloc] initWithStepTemplates:_stepTemplates builtSteps:builtSteps];
+}
+
+#pragma mark NSArray
+
+- (NSUInteger)count {
+    return _stepTemplates.count;
+}
+
+- (ORKStep *)objectAtIndex:(NSUInteger)index {
+    if (index >= _stepTemplates.count) {
+        @throw [NSException exceptionWithName:NSRangeException
+                                       reason:[NSString stringWithFormat:@"index %lu beyond bounds [0 .. %ld]", (unsigned long)index, (long)_stepTemplates.count - 1]
+                                     userInfo:nil];
+    }
+    os_unfair_lock_lock(&_lock);
+    id step = _builtSteps[index];
+    os_unfair_lock_unlock(&_lock);
+    if (step != [NSNull null]) {
+        return step;
+    }
+    
+    // Build outside the lock, since a template may do arbitrary work. If another thread stored a
+    // step in the meantime, its step wins so that every caller sees the same object.
+    ORKStep *builtStep = [_stepTemplates[index] makeStep];
+    os_unfair_lock_lock(&_lock);
+    step = _builtSteps[index];
+    if (step == [NSNull null]) {
+        _builtSteps[index] = builtStep;
+        step = builtStep;
+    }
+    os_unfair_lock_unlock(&_lock);
+    return step;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    return self;
+}
+
+- (Class)classForCoder {
+    return [NSArray class];
+}
+
+- (Class)classForKeyedArchiver {
+    return [NSArray class];
+}
+
+@end
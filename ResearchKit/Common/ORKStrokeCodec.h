@@ -0,0 +1,107 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <UIKit/UIKit.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ One touch location of a stroke and the time it was reported, in seconds since system startup
+ as in `-[UITouch timestamp]`.
+ */
+typedef struct {
+    CGPoint location;
+    NSTimeInterval timestamp;
+} ORKStrokeSample;
+
+/**
+ Encodes freehand strokes in a compact binary form.
+ 
+ Coordinates are rounded to a fixed number of units per point and written as varints holding
+ the zigzag delta from the previous coordinate. Timestamps are written the same way, in units of
+ ten microseconds. A drawing of a few hundred curves takes a few kilobytes, a fraction of the size
+ of archiving the same `UIBezierPath` objects.
+ 
+ Decoding is lossless at the precision of the encoding: the decoded paths have the same elements,
+ line width, cap and join style, and encoding them again yields the same bytes. With the default
+ precision of 1/64 point, touch locations on half and quarter points are kept exactly.
+ 
+ Paths and samples are encoded separately, so the geometry used to redraw a drawing can be kept
+ without its timing, and the other way round.
+ */
+@interface ORKStrokeCodec : NSObject
+
+/**
+ Returns a codec with 64 units per point.
+ */
+- (instancetype)init;
+
+- (instancetype)initWithUnitsPerPoint:(NSUInteger)unitsPerPoint NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readonly) NSUInteger unitsPerPoint;
+
+/**
+ The distance, in points, by which simplified polylines may deviate from the input. Points are
+ removed from runs of line segments and from sample sequences with the Ramer-Douglas-Peucker
+ algorithm; curves and the first and last point of each run are always kept.
+ 
+ The default is 0, which keeps every point.
+ */
+@property (nonatomic) CGFloat simplificationTolerance;
+
+- (NSData *)dataWithPaths:(NSArray<UIBezierPath *> *)paths;
+
+/**
+ Encodes strokes given as `NSData` objects holding consecutive `ORKStrokeSample` values.
+ */
+- (NSData *)dataWithSamples:(NSArray<NSData *> *)strokes;
+
+/**
+ Decodes paths encoded by `dataWithPaths:`, with any precision. Returns nil and sets `error` if
+ the data is malformed.
+ */
++ (nullable NSArray<UIBezierPath *> *)pathsWithData:(NSData *)data error:(NSError * _Nullable *)error;
+
+/**
+ Decodes strokes encoded by `dataWithSamples:`, with any precision. Returns nil and sets `error`
+ if the data is malformed.
+ */
++ (nullable NSArray<NSData *> *)samplesWithData:(NSData *)data error:(NSError * _Nullable *)error;
+
+/**
+ Strokes `paths` in black on a transparent image of `size` points with `scale` pixels per point.
+ */
++ (UIImage *)imageWithPaths:(NSArray<UIBezierPath *> *)paths size:(CGSize)size scale:(CGFloat)scale;
+
+@end
+
+NS_ASSUME_NONNULL_END
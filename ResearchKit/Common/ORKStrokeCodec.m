@@ -0,0 +1,520 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKStrokeCodec.h"
+
+#import "ORKErrors.h"
+#import "ORKHelpers_Internal.h"
+
+
+static const uint8_t PathsFormat = 'P';
+static const uint8_t SamplesFormat = 'S';
+static const uint8_t FormatVersion = 1;
+static const NSUInteger DefaultUnitsPerPoint = 64;
+static const uint64_t TimeUnitsPerSecond = 100000;
+
+typedef NS_ENUM(uint8_t, ORKStrokeElementType) {
+    ORKStrokeElementTypeMove = 0,
+    ORKStrokeElementTypeLine,
+    ORKStrokeElementTypeQuadCurve,
+    ORKStrokeElementTypeCurve,
+    ORKStrokeElementTypeClose
+};
+
+static const NSUInteger PointCountForElementType[] = { 1, 1, 2, 3, 0 };
+
+typedef struct {
+    ORKStrokeElementType type;
+    CGPoint points[3];
+} ORKStrokeElement;
+
+#pragma mark - Writing
+
+typedef struct {
+    uint8_t *bytes;
+    size_t length;
+    size_t capacity;
+} ORKStrokeWriter;
+
+static void ORKStrokeWriterReserve(ORKStrokeWriter *writer, size_t count) {
+    if (writer->length + count <= writer->capacity) {
+        return;
+    }
+    size_t capacity = MAX(writer->capacity * 2, writer->length + count);
+    writer->bytes = reallocf(writer->bytes, capacity);
+    writer->capacity = writer->bytes ? capacity : 0;
+    if (!writer->bytes) {
+        @throw [NSException exceptionWithName:NSMallocException reason:@"Out of memory encoding strokes" userInfo:nil];
+    }
+}
+
+static void ORKStrokeWriterPutByte(ORKStrokeWriter *writer, uint8_t byte) {
+    ORKStrokeWriterReserve(writer, 1);
+    writer->bytes[writer->length++] = byte;
+}
+
+static void ORKStrokeWriterPutVarint(ORKStrokeWriter *writer, uint64_t value) {
+    ORKStrokeWriterReserve(writer, 10);
+    while (value >= 0x80) {
+        writer->bytes[writer->length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    writer->bytes[writer->length++] = (uint8_t)value;
+}
+
+static void ORKStrokeWriterPutSignedVarint(ORKStrokeWriter *writer, int64_t value) {
+    ORKStrokeWriterPutVarint(writer, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+static NSData *ORKStrokeWriterFinish(ORKStrokeWriter *writer) {
+    NSData *data = [NSData dataWithBytesNoCopy:writer->bytes length:writer->length freeWhenDone:YES];
+    *writer = (ORKStrokeWriter){0};
+    return data;
+}
+
+static int64_t ORKStrokeQuantize(CGFloat value, double unitsPerValue) {
+    double units = round(value * unitsPerValue);
+    if (!isfinite(units)) {
+        return 0;
+    }
+    return (int64_t)MAX(MIN(units, (double)INT64_MAX / 2), (double)INT64_MIN / 2);
+}
+
+#pragma mark - Reading
+
+typedef struct {
+    const uint8_t *bytes;
+    size_t length;
+    size_t offset;
+    BOOL failed;
+} ORKStrokeReader;
+
+static uint8_t ORKStrokeReaderGetByte(ORKStrokeReader *reader) {
+    if (reader->offset >= reader->length) {
+        reader->failed = YES;
+        return 0;
+    }
+    return reader->bytes[reader->offset++];
+}
+
+static uint64_t ORKStrokeReaderGetVarint(ORKStrokeReader *reader) {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        uint8_t byte = ORKStrokeReaderGetByte(reader);
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+    reader->failed = YES;
+    return 0;
+}
+
+static int64_t ORKStrokeReaderGetSignedVarint(ORKStrokeReader *reader) {
+    uint64_t value = ORKStrokeReaderGetVarint(reader);
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+// Counts are bounded by the bytes left, so malformed data cannot make the decoder allocate much.
+static NSUInteger ORKStrokeReaderGetCount(ORKStrokeReader *reader) {
+    uint64_t count = ORKStrokeReaderGetVarint(reader);
+    if (count > reader->length - reader->offset) {
+        reader->failed = YES;
+        return 0;
+    }
+    return (NSUInteger)count;
+}
+
+static BOOL ORKStrokeReaderBegin(ORKStrokeReader *reader, NSData *data, uint8_t format, double *unitsPerPoint) {
+    *reader = (ORKStrokeReader){ .bytes = data.bytes, .length = data.length };
+    if (ORKStrokeReaderGetByte(reader) != format || ORKStrokeReaderGetByte(reader) != FormatVersion) {
+        return NO;
+    }
+    uint64_t units = ORKStrokeReaderGetVarint(reader);
+    *unitsPerPoint = (double)units;
+    return !reader->failed && units > 0;
+}
+
+static NSError *ORKStrokeMalformedDataError(void) {
+    return [NSError errorWithDomain:ORKErrorDomain code:ORKErrorInvalidObject userInfo:@{NSLocalizedFailureReasonErrorKey: @"The stroke data is malformed."}];
+}
+
+#pragma mark - Simplification
+
+static CGFloat ORKStrokeSquaredDistanceToSegment(CGPoint point, CGPoint start, CGPoint end) {
+    CGFloat dx = end.x - start.x;
+    CGFloat dy = end.y - start.y;
+    CGFloat lengthSquared = dx * dx + dy * dy;
+    CGFloat t = 0;
+    if (lengthSquared > 0) {
+        t = ((point.x - start.x) * dx + (point.y - start.y) * dy) / lengthSquared;
+        t = MAX(0, MIN(1, t));
+    }
+    CGFloat ex = start.x + t * dx - point.x;
+    CGFloat ey = start.y + t * dy - point.y;
+    return ex * ex + ey * ey;
+}
+
+static CGPoint ORKStrokePointAtIndex(const void *base, size_t stride, NSUInteger index) {
+    return *(const CGPoint *)((const uint8_t *)base + index * stride);
+}
+
+/**
+ Marks the points from `first` to `last` that Ramer-Douglas-Peucker keeps for `tolerance`, where
+ point `i` is the `CGPoint` at `base + i * stride`. The first and last points are always kept.
+ `stack` needs room for `last - first + 1` pairs of indexes.
+ */
+static void ORKStrokeSimplify(const void *base, size_t stride, NSUInteger first, NSUInteger last,
+                              CGFloat tolerance, BOOL *keep, NSUInteger *stack) {
+    CGFloat toleranceSquared = tolerance * tolerance;
+    keep[first] = YES;
+    keep[last] = YES;
+    NSUInteger depth = 0;
+    stack[depth++] = first;
+    stack[depth++] = last;
+    while (depth > 0) {
+        NSUInteger end = stack[--depth];
+        NSUInteger start = stack[--depth];
+        CGPoint startPoint = ORKStrokePointAtIndex(base, stride, start);
+        CGPoint endPoint = ORKStrokePointAtIndex(base, stride, end);
+        CGFloat farthest = 0;
+        NSUInteger farthestIndex = start;
+        for (NSUInteger i = start + 1; i < end; i++) {
+            CGFloat distance = ORKStrokeSquaredDistanceToSegment(ORKStrokePointAtIndex(base, stride, i), startPoint, endPoint);
+            if (distance > farthest) {
+                farthest = distance;
+                farthestIndex = i;
+            }
+        }
+        if (farthest > toleranceSquared) {
+            keep[farthestIndex] = YES;
+            stack[depth++] = start;
+            stack[depth++] = farthestIndex;
+            stack[depth++] = farthestIndex;
+            stack[depth++] = end;
+        }
+    }
+}
+
+#pragma mark - Paths
+
+static NSMutableData *ORKStrokeElementsOfPath(CGPathRef path) {
+    NSMutableData *elements = [NSMutableData data];
+    CGPathApplyWithBlock(path, ^(const CGPathElement *pathElement) {
+        ORKStrokeElement element = {0};
+        switch (pathElement->type) {
+            case kCGPathElementMoveToPoint:
+                element.type = ORKStrokeElementTypeMove;
+                break;
+            case kCGPathElementAddLineToPoint:
+                element.type = ORKStrokeElementTypeLine;
+                break;
+            case kCGPathElementAddQuadCurveToPoint:
+                element.type = ORKStrokeElementTypeQuadCurve;
+                break;
+            case kCGPathElementAddCurveToPoint:
+                element.type = ORKStrokeElementTypeCurve;
+                break;
+            case kCGPathElementCloseSubpath:
+                element.type = ORKStrokeElementTypeClose;
+                break;
+        }
+        for (NSUInteger i = 0; i < PointCountForElementType[element.type]; i++) {
+            element.points[i] = pathElement->points[i];
+        }
+        [elements appendBytes:&element length:sizeof(element)];
+    });
+    return elements;
+}
+
+// Drops line elements that simplification removes from each run of lines.
+static void ORKStrokeSimplifyLineRuns(NSMutableData *elementData, CGFloat tolerance) {
+    ORKStrokeElement *elements = elementData.mutableBytes;
+    NSUInteger count = elementData.length / sizeof(ORKStrokeElement);
+    BOOL *keep = calloc(count, sizeof(BOOL));
+    NSUInteger *stack = malloc(sizeof(NSUInteger) * 2 * (count + 1));
+    NSUInteger index = 0;
+    while (index < count) {
+        keep[index] = YES;
+        // A run starts at the element ending on the first point of the first line.
+        if (elements[index].type != ORKStrokeElementTypeMove && elements[index].type != ORKStrokeElementTypeLine) {
+            index++;
+            continue;
+        }
+        NSUInteger last = index;
+        while (last + 1 < count && elements[last + 1].type == ORKStrokeElementTypeLine) {
+            last++;
+        }
+        if (last > index + 1) {
+            ORKStrokeSimplify(&elements[0].points[0], sizeof(ORKStrokeElement), index, last, tolerance, keep, stack);
+        }
+        index = last + 1;
+    }
+    NSUInteger kept = 0;
+    for (NSUInteger i = 0; i < count; i++) {
+        if (keep[i]) {
+            elements[kept++] = elements[i];
+        }
+    }
+    elementData.length = kept * sizeof(ORKStrokeElement);
+    free(keep);
+    free(stack);
+}
+
+#pragma mark - Codec
+
+@implementation ORKStrokeCodec
+
+- (instancetype)init {
+    return [self initWithUnitsPerPoint:DefaultUnitsPerPoint];
+}
+
+- (instancetype)initWithUnitsPerPoint:(NSUInteger)unitsPerPoint {
+    self = [super init];
+    if (self) {
+        _unitsPerPoint = MAX(unitsPerPoint, (NSUInteger)1);
+    }
+    return self;
+}
+
+- (NSData *)dataWithPaths:(NSArray<UIBezierPath *> *)paths {
+    double unitsPerPoint = _unitsPerPoint;
+    ORKStrokeWriter writer = {0};
+    ORKStrokeWriterPutByte(&writer, PathsFormat);
+    ORKStrokeWriterPutByte(&writer, FormatVersion);
+    ORKStrokeWriterPutVarint(&writer, _unitsPerPoint);
+    ORKStrokeWriterPutVarint(&writer, paths.count);
+    
+    int64_t previousX = 0;
+    int64_t previousY = 0;
+    for (UIBezierPath *path in paths) {
+        NSMutableData *elementData = ORKStrokeElementsOfPath(path.CGPath);
+        if (_simplificationTolerance > 0) {
+            ORKStrokeSimplifyLineRuns(elementData, _simplificationTolerance);
+        }
+        
+        ORKStrokeWriterPutVarint(&writer, (uint64_t)MAX(ORKStrokeQuantize(path.lineWidth, unitsPerPoint), 0));
+        ORKStrokeWriterPutByte(&writer, (uint8_t)((path.lineCapStyle & 0x3) | ((path.lineJoinStyle & 0x3) << 2)));
+        
+        const ORKStrokeElement *elements = elementData.bytes;
+        NSUInteger count = elementData.length / sizeof(ORKStrokeElement);
+        ORKStrokeWriterPutVarint(&writer, count);
+        for (NSUInteger i = 0; i < count; i++) {
+            ORKStrokeWriterPutByte(&writer, elements[i].type);
+            for (NSUInteger p = 0; p < PointCountForElementType[elements[i].type]; p++) {
+                int64_t x = ORKStrokeQuantize(elements[i].points[p].x, unitsPerPoint);
+                int64_t y = ORKStrokeQuantize(elements[i].points[p].y, unitsPerPoint);
+                ORKStrokeWriterPutSignedVarint(&writer, x - previousX);
+                ORKStrokeWriterPutSignedVarint(&writer, y - previousY);
+                previousX = x;
+                previousY = y;
+            }
+        }
+    }
+    return ORKStrokeWriterFinish(&writer);
+}
+
+- (NSData *)dataWithSamples:(NSArray<NSData *> *)strokes {
+    double unitsPerPoint = _unitsPerPoint;
+    ORKStrokeWriter writer = {0};
+    ORKStrokeWriterPutByte(&writer, SamplesFormat);
+    ORKStrokeWriterPutByte(&writer, FormatVersion);
+    ORKStrokeWriterPutVarint(&writer, _unitsPerPoint);
+    ORKStrokeWriterPutVarint(&writer, TimeUnitsPerSecond);
+    ORKStrokeWriterPutVarint(&writer, strokes.count);
+    
+    int64_t previousX = 0;
+    int64_t previousY = 0;
+    int64_t previousTime = 0;
+    for (NSData *stroke in strokes) {
+        const ORKStrokeSample *samples = stroke.bytes;
+        NSUInteger count = stroke.length / sizeof(ORKStrokeSample);
+        BOOL *keep = NULL;
+        if (_simplificationTolerance > 0 && count > 2) {
+            keep = calloc(count, sizeof(BOOL));
+            NSUInteger *stack = malloc(sizeof(NSUInteger) * 2 * (count + 1));
+            ORKStrokeSimplify(&samples[0].location, sizeof(ORKStrokeSample), 0, count - 1, _simplificationTolerance, keep, stack);
+            free(stack);
+        }
+        
+        NSUInteger kept = count;
+        if (keep) {
+            kept = 0;
+            for (NSUInteger i = 0; i < count; i++) {
+                kept += keep[i];
+            }
+        }
+        ORKStrokeWriterPutVarint(&writer, kept);
+        for (NSUInteger i = 0; i < count; i++) {
+            if (keep && !keep[i]) {
+                continue;
+            }
+            int64_t x = ORKStrokeQuantize(samples[i].location.x, unitsPerPoint);
+            int64_t y = ORKStrokeQuantize(samples[i].location.y, unitsPerPoint);
+            int64_t time = ORKStrokeQuantize(samples[i].timestamp, TimeUnitsPerSecond);
+            ORKStrokeWriterPutSignedVarint(&writer, x - previousX);
+            ORKStrokeWriterPutSignedVarint(&writer, y - previousY);
+            ORKStrokeWriterPutSignedVarint(&writer, time - previousTime);
+            previousX = x;
+            previousY = y;
+            previousTime = time;
+        }
+        free(keep);
+    }
+    return ORKStrokeWriterFinish(&writer);
+}
+
++ (NSArray<UIBezierPath *> *)pathsWithData:(NSData *)data error:(NSError **)error {
+    ORKStrokeReader reader;
+    double unitsPerPoint = 0;
+    if (!ORKStrokeReaderBegin(&reader, data, PathsFormat, &unitsPerPoint)) {
+        if (error) {
+            *error = ORKStrokeMalformedDataError();
+        }
+        return nil;
+    }
+    
+    NSUInteger pathCount = ORKStrokeReaderGetCount(&reader);
+    NSMutableArray<UIBezierPath *> *paths = [NSMutableArray arrayWithCapacity:pathCount];
+    int64_t x = 0;
+    int64_t y = 0;
+    for (NSUInteger pathIndex = 0; pathIndex < pathCount && !reader.failed; pathIndex++) {
+        CGFloat lineWidth = ORKStrokeReaderGetVarint(&reader) / unitsPerPoint;
+        uint8_t style = ORKStrokeReaderGetByte(&reader);
+        NSUInteger count = ORKStrokeReaderGetCount(&reader);
+        
+        CGMutablePathRef cgPath = CGPathCreateMutable();
+        BOOL hasCurrentPoint = NO;
+        for (NSUInteger i = 0; i < count && !reader.failed; i++) {
+            uint8_t type = ORKStrokeReaderGetByte(&reader);
+            if (type > ORKStrokeElementTypeClose || (type != ORKStrokeElementTypeMove && !hasCurrentPoint)) {
+                reader.failed = YES;
+                break;
+            }
+            CGPoint points[3];
+            for (NSUInteger p = 0; p < PointCountForElementType[type]; p++) {
+                x += ORKStrokeReaderGetSignedVarint(&reader);
+                y += ORKStrokeReaderGetSignedVarint(&reader);
+                points[p] = CGPointMake(x / unitsPerPoint, y / unitsPerPoint);
+            }
+            hasCurrentPoint = YES;
+            switch ((ORKStrokeElementType)type) {
+                case ORKStrokeElementTypeMove:
+                    CGPathMoveToPoint(cgPath, NULL, points[0].x, points[0].y);
+                    break;
+                case ORKStrokeElementTypeLine:
+                    CGPathAddLineToPoint(cgPath, NULL, points[0].x, points[0].y);
+                    break;
+                case ORKStrokeElementTypeQuadCurve:
+                    CGPathAddQuadCurveToPoint(cgPath, NULL, points[0].x, points[0].y, points[1].x, points[1].y);
+                    break;
+                case ORKStrokeElementTypeCurve:
+                    CGPathAddCurveToPoint(cgPath, NULL, points[0].x, points[0].y, points[1].x, points[1].y, points[2].x, points[2].y);
+                    break;
+                case ORKStrokeElementTypeClose:
+                    CGPathCloseSubpath(cgPath);
+                    break;
+            }
+        }
+        
+        UIBezierPath *path = [UIBezierPath bezierPathWithCGPath:cgPath];
+        CGPathRelease(cgPath);
+        path.lineWidth = lineWidth;
+        path.lineCapStyle = (CGLineCap)(style & 0x3);
+        path.lineJoinStyle = (CGLineJoin)((style >> 2) & 0x3);
+        [paths addObject:path];
+    }
+    
+    if (reader.failed) {
+        if (error) {
+            *error = ORKStrokeMalformedDataError();
+        }
+        return nil;
+    }
+    return [paths copy];
+}
+
++ (NSArray<NSData *> *)samplesWithData:(NSData *)data error:(NSError **)error {
+    ORKStrokeReader reader;
+    double unitsPerPoint = 0;
+    BOOL valid = ORKStrokeReaderBegin(&reader, data, SamplesFormat, &unitsPerPoint);
+    double timeUnitsPerSecond = valid ? (double)ORKStrokeReaderGetVarint(&reader) : 0;
+    if (!valid || reader.failed || timeUnitsPerSecond <= 0) {
+        if (error) {
+            *error = ORKStrokeMalformedDataError();
+        }
+        return nil;
+    }
+    
+    NSUInteger strokeCount = ORKStrokeReaderGetCount(&reader);
+    NSMutableArray<NSData *> *strokes = [NSMutableArray arrayWithCapacity:strokeCount];
+    int64_t x = 0;
+    int64_t y = 0;
+    int64_t time = 0;
+    for (NSUInteger strokeIndex = 0; strokeIndex < strokeCount && !reader.failed; strokeIndex++) {
+        NSUInteger count = ORKStrokeReaderGetCount(&reader);
+        NSMutableData *stroke = [NSMutableData dataWithLength:count * sizeof(ORKStrokeSample)];
+        ORKStrokeSample *samples = stroke.mutableBytes;
+        for (NSUInteger i = 0; i < count && !reader.failed; i++) {
+            x += ORKStrokeReaderGetSignedVarint(&reader);
+            y += ORKStrokeReaderGetSignedVarint(&reader);
+            time += ORKStrokeReaderGetSignedVarint(&reader);
+            samples[i] = (ORKStrokeSample){
+                .location = CGPointMake(x / unitsPerPoint, y / unitsPerPoint),
+                .timestamp = time / timeUnitsPerSecond
+            };
+        }
+        [strokes addObject:stroke];
+    }
+    
+    if (reader.failed) {
+        if (error) {
+            *error = ORKStrokeMalformedDataError();
+        }
+        return nil;
+    }
+    return [strokes copy];
+}
+
++ (UIImage *)imageWithPaths:(NSArray<UIBezierPath *> *)paths size:(CGSize)size scale:(CGFloat)scale {
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat preferredFormat];
+    format.scale = scale;
+    format.opaque = NO;
+    UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:size format:format];
+    return [renderer imageWithActions:^(UIGraphicsImageRendererContext * _Nonnull rendererContext) {
+        [[UIColor blackColor] setStroke];
+        for (UIBezierPath *path in paths) {
+            [path stroke];
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,89 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <ResearchKit/ORKClock.h>
+#import <ResearchKit/ORKTimelineAlignmentResult.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The identifier of the wall clock stream that every aligner tracks.
+ORK_EXTERN NSString *const ORKTimelineWallClockStreamIdentifier ORK_AVAILABLE_DECL;
+
+/**
+ Builds an `ORKTimelineAlignmentResult` for the data streams collected during a step.
+ 
+ Streams in the system uptime and host time timebases are tied to the clock and are aligned
+ exactly. For other streams, the aligner fits a line through pairs of stream and clock times
+ observed while the step runs, which captures both the offset and the drift of the stream
+ clock. The fit is a running least squares fit, so each observation costs constant time and
+ memory. Wall clock streams without observations of their own, such as recorders that write
+ wall clock timestamps, share the fit of the wall clock stream.
+ 
+ An aligner is not thread safe.
+ */
+@interface ORKTimelineAligner : NSObject
+
+/**
+ Adds a stream. Adding a stream that already exists has no effect.
+ 
+ @param identifier  The identifier of the stream, such as a recorder identifier.
+ @param timebase    The timebase of the stream timestamps.
+ */
+- (void)addStreamWithIdentifier:(NSString *)identifier timebase:(ORKTimelineTimebase)timebase;
+
+/**
+ Records that the stream read `streamTime` at the clock time `clockTime`.
+ 
+ Observations of streams that are aligned exactly, and of unknown streams, are ignored.
+ */
+- (void)observeStreamTime:(double)streamTime clockTime:(ORKClockTime)clockTime forStreamWithIdentifier:(NSString *)identifier;
+
+/// Records the current wall clock time against the clock.
+- (void)observeWallClock;
+
+/**
+ Discards the observations of a stream, for example after its clock stopped while the step
+ was suspended.
+ */
+- (void)restartStreamWithIdentifier:(NSString *)identifier;
+
+/**
+ Returns a result describing the alignment of every stream.
+ 
+ @param identifier  The identifier of the result.
+ */
+- (ORKTimelineAlignmentResult *)resultWithIdentifier:(NSString *)identifier;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,172 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKTimelineAligner.h"
+
+
+NSString *const ORKTimelineWallClockStreamIdentifier = @"wallClock";
+
+// Running least squares fit of clock time against stream time. Both are measured from the
+// first observation to keep full precision for wall clock timestamps.
+typedef struct {
+    NSInteger count;
+    double originStreamTime;
+    double originSystemUptime;
+    double meanX;
+    double meanY;
+    double sumSquaredX;
+    double sumSquaredY;
+    double sumProduct;
+} ORKTimelineFit;
+
+static void ORKTimelineFitAdd(ORKTimelineFit *fit, double streamTime, double systemUptime) {
+    if (fit->count == 0) {
+        fit->originStreamTime = streamTime;
+        fit->originSystemUptime = systemUptime;
+    }
+    const double x = streamTime - fit->originStreamTime;
+    const double y = systemUptime - fit->originSystemUptime;
+    fit->count += 1;
+    const double dx = x - fit->meanX;
+    const double dy = y - fit->meanY;
+    fit->meanX += dx / fit->count;
+    fit->meanY += dy / fit->count;
+    fit->sumSquaredX += dx * (x - fit->meanX);
+    fit->sumSquaredY += dy * (y - fit->meanY);
+    fit->sumProduct += dx * (y - fit->meanY);
+}
+
+
+@interface ORKTimelineStream : NSObject {
+@public
+    ORKTimelineFit _fit;
+}
+
+@property (nonatomic, copy) NSString *identifier;
+
+@property (nonatomic) ORKTimelineTimebase timebase;
+
+@end
+
+
+@implementation ORKTimelineStream
+
+- (BOOL)isExact {
+    return (_timebase == ORKTimelineTimebaseSystemUptime || _timebase == ORKTimelineTimebaseHostTime);
+}
+
+- (ORKTimelineStreamAlignment *)alignmentWithFit:(const ORKTimelineFit *)fit {
+    ORKTimelineStreamAlignment *alignment = [ORKTimelineStreamAlignment new];
+    alignment.identifier = _identifier;
+    alignment.timebase = _timebase;
+    
+    if (_timebase == ORKTimelineTimebaseHostTime) {
+        alignment.rate = ORKSystemUptimeFromClockTime(ORKClockTimeFromHostTime(NSEC_PER_SEC)) / NSEC_PER_SEC;
+    } else if (![self isExact] && fit->count > 0) {
+        const double rate = (fit->count > 1 && fit->sumSquaredX > 0) ? fit->sumProduct / fit->sumSquaredX : 1;
+        alignment.rate = rate;
+        alignment.referenceStreamTime = fit->originStreamTime + fit->meanX;
+        alignment.referenceSystemUptime = fit->originSystemUptime + fit->meanY;
+        alignment.sampleCount = fit->count;
+        alignment.residual = sqrt(MAX(0, (fit->sumSquaredY - (rate * fit->sumProduct)) / fit->count));
+    }
+    return alignment;
+}
+
+@end
+
+
+@implementation ORKTimelineAligner {
+    NSMutableArray<ORKTimelineStream *> *_streams;
+    NSMutableDictionary<NSString *, ORKTimelineStream *> *_streamsByIdentifier;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _streams = [NSMutableArray new];
+        _streamsByIdentifier = [NSMutableDictionary new];
+        [self addStreamWithIdentifier:ORKTimelineWallClockStreamIdentifier timebase:ORKTimelineTimebaseWallClock];
+    }
+    return self;
+}
+
+- (void)addStreamWithIdentifier:(NSString *)identifier timebase:(ORKTimelineTimebase)timebase {
+    if (_streamsByIdentifier[identifier]) {
+        return;
+    }
+    ORKTimelineStream *stream = [ORKTimelineStream new];
+    stream.identifier = identifier;
+    stream.timebase = timebase;
+    [_streams addObject:stream];
+    _streamsByIdentifier[identifier] = stream;
+}
+
+- (void)observeStreamTime:(double)streamTime clockTime:(ORKClockTime)clockTime forStreamWithIdentifier:(NSString *)identifier {
+    ORKTimelineStream *stream = _streamsByIdentifier[identifier];
+    if (!stream || [stream isExact]) {
+        return;
+    }
+    ORKTimelineFitAdd(&stream->_fit, streamTime, ORKSystemUptimeFromClockTime(clockTime));
+}
+
+- (void)observeWallClock {
+    // Bracket the wall clock read and use the midpoint, which halves the read latency error.
+    ORKClockTime before = ORKClockNow();
+    NSTimeInterval wallClockTime = [NSDate date].timeIntervalSince1970;
+    ORKClockTime after = ORKClockNow();
+    [self observeStreamTime:wallClockTime clockTime:before + ((after - before) / 2) forStreamWithIdentifier:ORKTimelineWallClockStreamIdentifier];
+}
+
+- (void)restartStreamWithIdentifier:(NSString *)identifier {
+    ORKTimelineStream *stream = _streamsByIdentifier[identifier];
+    if (stream) {
+        stream->_fit = (ORKTimelineFit){ 0 };
+    }
+}
+
+- (ORKTimelineAlignmentResult *)resultWithIdentifier:(NSString *)identifier {
+    ORKTimelineAlignmentResult *result = [[ORKTimelineAlignmentResult alloc] initWithIdentifier:identifier];
+    NSMutableArray *streamAlignments = [NSMutableArray arrayWithCapacity:_streams.count];
+    ORKTimelineStream *wallClockStream = _streamsByIdentifier[ORKTimelineWallClockStreamIdentifier];
+    for (ORKTimelineStream *stream in _streams) {
+        // Wall clock streams that weren't observed themselves read the same clock as the wall clock stream.
+        const ORKTimelineFit *fit = &stream->_fit;
+        if (stream.timebase == ORKTimelineTimebaseWallClock && fit->count == 0) {
+            fit = &wallClockStream->_fit;
+        }
+        [streamAlignments addObject:[stream alignmentWithFit:fit]];
+    }
+    result.streamAlignments = streamAlignments;
+    return result;
+}
+
+@end
@@ -0,0 +1,143 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <ResearchKit/ORKResult.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ORKTimelineStreamAlignment;
+
+/**
+ The timebase in which a stream of timestamps is expressed.
+ */
+typedef NS_ENUM(NSInteger, ORKTimelineTimebase) {
+    /// Seconds since boot, as used by sensor and touch timestamps and `-[NSProcessInfo systemUptime]`.
+    ORKTimelineTimebaseSystemUptime = 0,
+    
+    /// Audio host time, in `mach_absolute_time` ticks.
+    ORKTimelineTimebaseHostTime,
+    
+    /// Seconds since 1970, as used by dates.
+    ORKTimelineTimebaseWallClock,
+    
+    /// Seconds of active step runtime, which does not advance while the step is suspended.
+    ORKTimelineTimebaseStepRuntime
+} ORK_ENUM_AVAILABLE;
+
+/**
+ The `ORKTimelineAlignmentResult` class records how the timestamps of each data stream
+ collected during a step map onto a common timeline.
+ 
+ The common timeline is the system uptime, in seconds since boot. Use the stream alignments
+ to merge the files produced by different recorders, together with the timestamps in other
+ results, into a single ordered sequence of events.
+ */
+ORK_CLASS_AVAILABLE
+@interface ORKTimelineAlignmentResult : ORKResult
+
+/**
+ An array of stream alignments, in which each item is an `ORKTimelineStreamAlignment`
+ object describing one data stream.
+ */
+@property (nonatomic, copy, nullable) NSArray<ORKTimelineStreamAlignment *> *streamAlignments;
+
+/**
+ Returns the alignment of the stream with the given identifier, such as a recorder identifier.
+ 
+ @param identifier  The identifier of the stream.
+ 
+ @return The stream alignment, or `nil` if there is no stream with that identifier.
+ */
+- (nullable ORKTimelineStreamAlignment *)streamAlignmentForIdentifier:(NSString *)identifier;
+
+@end
+
+
+/**
+ The `ORKTimelineStreamAlignment` class describes the linear mapping from the timestamps of a
+ data stream onto the system uptime.
+ 
+ A stream timestamp `t` maps to the system uptime
+ `referenceSystemUptime + (t - referenceStreamTime) * rate`.
+ */
+ORK_CLASS_AVAILABLE
+@interface ORKTimelineStreamAlignment : NSObject <NSCopying, NSSecureCoding>
+
+/**
+ The identifier of the stream, such as a recorder identifier.
+ */
+@property (nonatomic, copy, nullable) NSString *identifier;
+
+/**
+ The timebase in which the stream timestamps are expressed.
+ */
+@property (nonatomic, assign) ORKTimelineTimebase timebase;
+
+/**
+ The stream timestamp of the reference point.
+ */
+@property (nonatomic, assign) double referenceStreamTime;
+
+/**
+ The system uptime of the reference point, in seconds.
+ */
+@property (nonatomic, assign) NSTimeInterval referenceSystemUptime;
+
+/**
+ The number of seconds of system uptime per unit of stream time.
+ 
+ For streams measured in seconds, `rate - 1` is the drift of the stream clock.
+ */
+@property (nonatomic, assign) double rate;
+
+/**
+ The number of observations used to estimate the mapping; `0` when the mapping is exact.
+ */
+@property (nonatomic, assign) NSInteger sampleCount;
+
+/**
+ The root mean square difference, in seconds, between the observations and the mapping.
+ */
+@property (nonatomic, assign) NSTimeInterval residual;
+
+/**
+ Maps a stream timestamp onto the system uptime.
+ 
+ @param streamTime  A timestamp of the stream.
+ 
+ @return The system uptime, in seconds.
+ */
+- (NSTimeInterval)systemUptimeForStreamTime:(double)streamTime;
+
+@end
+
+NS_ASSUME_NONNULL_END
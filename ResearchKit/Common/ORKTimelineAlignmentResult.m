@@ -0,0 +1,169 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKTimelineAlignmentResult.h"
+
+#import "ORKResult_Private.h"
+#import "ORKHelpers_Internal.h"
+
+
+@implementation ORKTimelineAlignmentResult
+
+- (void)encodeWithCoder:(NSCoder *)aCoder {
+    [super encodeWithCoder:aCoder];
+    ORK_ENCODE_OBJ(aCoder, streamAlignments);
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder {
+    self = [super initWithCoder:aDecoder];
+    if (self) {
+        ORK_DECODE_OBJ_ARRAY(aDecoder, streamAlignments, ORKTimelineStreamAlignment);
+    }
+    return self;
+}
+
++ (BOOL)supportsSecureCoding {
+    return YES;
+}
+
+- (BOOL)isEqual:(id)object {
+    BOOL isParentSame = [super isEqual:object];
+    
+    __typeof(self) castObject = object;
+    return (isParentSame &&
+            ORKEqualObjects(self.streamAlignments, castObject.streamAlignments));
+}
+
+- (NSUInteger)hash {
+    return super.hash ^ self.streamAlignments.hash;
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone {
+    ORKTimelineAlignmentResult *result = [super copyWithZone:zone];
+    result.streamAlignments = ORKArrayCopyObjects(self.streamAlignments);
+    return result;
+}
+
+- (ORKTimelineStreamAlignment *)streamAlignmentForIdentifier:(NSString *)identifier {
+    for (ORKTimelineStreamAlignment *streamAlignment in self.streamAlignments) {
+        if ([streamAlignment.identifier isEqualToString:identifier]) {
+            return streamAlignment;
+        }
+    }
+    return nil;
+}
+
+- (NSString *)descriptionWithNumberOfPaddingSpaces:(NSUInteger)numberOfPaddingSpaces {
+    return [NSString stringWithFormat:@"%@; streamAlignments: %@%@", [self descriptionPrefixWithNumberOfPaddingSpaces:numberOfPaddingSpaces], self.streamAlignments, self.descriptionSuffix];
+}
+
+@end
+
+
+@implementation ORKTimelineStreamAlignment
+
++ (BOOL)supportsSecureCoding {
+    return YES;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _rate = 1;
+    }
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder {
+    ORK_ENCODE_OBJ(aCoder, identifier);
+    ORK_ENCODE_ENUM(aCoder, timebase);
+    ORK_ENCODE_DOUBLE(aCoder, referenceStreamTime);
+    ORK_ENCODE_DOUBLE(aCoder, referenceSystemUptime);
+    ORK_ENCODE_DOUBLE(aCoder, rate);
+    ORK_ENCODE_INTEGER(aCoder, sampleCount);
+    ORK_ENCODE_DOUBLE(aCoder, residual);
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder {
+    self = [super init];
+    if (self) {
+        ORK_DECODE_OBJ_CLASS(aDecoder, identifier, NSString);
+        ORK_DECODE_ENUM(aDecoder, timebase);
+        ORK_DECODE_DOUBLE(aDecoder, referenceStreamTime);
+        ORK_DECODE_DOUBLE(aDecoder, referenceSystemUptime);
+        ORK_DECODE_DOUBLE(aDecoder, rate);
+        ORK_DECODE_INTEGER(aDecoder, sampleCount);
+        ORK_DECODE_DOUBLE(aDecoder, residual);
+    }
+    return self;
+}
+
+- (BOOL)isEqual:(id)object {
+    if ([self class] != [object class]) {
+        return NO;
+    }
+    
+    __typeof(self) castObject = object;
+    
+    return (ORKEqualObjects(self.identifier, castObject.identifier) &&
+            (self.timebase == castObject.timebase) &&
+            (self.referenceStreamTime == castObject.referenceStreamTime) &&
+            (self.referenceSystemUptime == castObject.referenceSystemUptime) &&
+            (self.rate == castObject.rate) &&
+            (self.sampleCount == castObject.sampleCount) &&
+            (self.residual == castObject.residual));
+}
+
+- (NSUInteger)hash {
+    return self.identifier.hash ^ self.timebase;
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone {
+    ORKTimelineStreamAlignment *streamAlignment = [[[self class] allocWithZone:zone] init];
+    streamAlignment.identifier = self.identifier;
+    streamAlignment.timebase = self.timebase;
+    streamAlignment.referenceStreamTime = self.referenceStreamTime;
+    streamAlignment.referenceSystemUptime = self.referenceSystemUptime;
+    streamAlignment.rate = self.rate;
+    streamAlignment.sampleCount = self.sampleCount;
+    streamAlignment.residual = self.residual;
+    return streamAlignment;
+}
+
+- (NSTimeInterval)systemUptimeForStreamTime:(double)streamTime {
+    return _referenceSystemUptime + ((streamTime - _referenceStreamTime) * _rate);
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p; identifier: %@; timebase: %@; referenceStreamTime: %@; referenceSystemUptime: %@; rate: %@; sampleCount: %@; residual: %@>", self.class.description, self, self.identifier, @(self.timebase), @(self.referenceStreamTime), @(self.referenceSystemUptime), @(self.rate), @(self.sampleCount), @(self.residual)];
+}
+
+@end
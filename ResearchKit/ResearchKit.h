@@ -79,13 +79,17 @@
 #import <ResearchKit/ORKFrontFacingCameraStepResult.h>
 #import <ResearchKit/ORKPasscodeResult.h>
 #import <ResearchKit/ORKQuestionResult.h>
+#import <ResearchKit/ORKRandomSeedResult.h>
 #import <ResearchKit/ORKSignatureResult.h>
+#import <ResearchKit/ORKTimelineAlignmentResult.h>
 #import <ResearchKit/ORKVideoInstructionStepResult.h>
 #import <ResearchKit/ORKWebViewStepResult.h>
 #import <ResearchKit/ORKResultPredicate.h>
 
 #import <ResearchKit/ORKRecorder.h>
 
+#import <ResearchKit/ORKRandomNumberGenerator.h>
+
 #import <ResearchKit/ORKConsentDocument.h>
 #import <ResearchKit/ORKConsentDocument+ORKInstructionStep.h>
 #import <ResearchKit/ORKConsentSection.h>
@@ -30,18 +30,25 @@
 
 #import <ResearchKit/CLLocationManager+ResearchKit.h>
 #import <ResearchKit/ORKActiveStep_Internal.h>
+#import <ResearchKit/ORKAnswerFormatValidator.h>
 #import <ResearchKit/ORKAnswerFormat_Internal.h>
 #import <ResearchKit/ORKAnswerFormat_Private.h>
 #import <ResearchKit/ORKBodyItem_Internal.h>
 #import <ResearchKit/ORKChoiceAnswerFormatHelper.h>
+#import <ResearchKit/ORKClock.h>
 #import <ResearchKit/ORKCollectionResult_Private.h>
 #import <ResearchKit/ORKConsentDocument_Private.h>
 #import <ResearchKit/ORKConsentSection_Private.h>
+#import <ResearchKit/ORKDataCollectionManager_Private.h>
+#import <ResearchKit/ORKDataLogUploadQueue.h>
 #import <ResearchKit/ORKDataLogger.h>
 #import <ResearchKit/ORKDevice_Private.h>
 #import <ResearchKit/ORKErrors.h>
 #import <ResearchKit/ORKHelpers_Internal.h>
 #import <ResearchKit/ORKHelpers_Private.h>
+#import <ResearchKit/ORKKeychainCache.h>
+#import <ResearchKit/ORKMediaArtifactStore.h>
+#import <ResearchKit/ORKMotionActivityEncoder.h>
 #import <ResearchKit/ORKOrderedTask_Private.h>
 #import <ResearchKit/ORKPageStep_Private.h>
 #import <ResearchKit/ORKPredicateFormItemVisibilityRule_Private.h>
@@ -49,9 +56,13 @@
 #import <ResearchKit/ORKQuestionStep_Private.h>
 #import <ResearchKit/ORKRecorder_Private.h>
 #import <ResearchKit/ORKResult_Private.h>
+#import <ResearchKit/ORKSecureStorageBackend.h>
 #import <ResearchKit/ORKSignatureResult_Private.h>
 #import <ResearchKit/ORKSkin_Private.h>
 #import <ResearchKit/ORKStepNavigationRule_Private.h>
+#import <ResearchKit/ORKStepTemplate.h>
+#import <ResearchKit/ORKStrokeCodec.h>
 #import <ResearchKit/ORKStep_Private.h>
+#import <ResearchKit/ORKTimelineAligner.h>
 #import <ResearchKit/ORKTypes_Private.h>
 #import <ResearchKit/ORKWebViewStepResult_Private.h>
@@ -172,6 +172,24 @@ ORK_CLASS_AVAILABLE
  */
 - (void)makeCustomPDFWithRenderer:(ORKHTMLPDFPageRenderer *)renderer
                 completionHandler:(void (^)(NSData * _Nullable PDFData, NSError * _Nullable error))handler;
+
+/**
+ Writes the document's content into a PDF file at the specified URL, without a web view.
+ 
+ The document is laid out and written out page by page as it is generated, so this method can
+ be called on any queue and its memory use does not depend on the length of the document. Text
+ is set in Helvetica, and characters that the PDF's standard encoding cannot represent are
+ replaced. Documents with `htmlReviewContent`, or with sections that have `htmlContent`, cannot
+ be laid out natively; use `makePDFWithCompletionHandler:` for them.
+ 
+ @param url         The file URL to write to. An existing file is replaced only once the whole
+                   PDF has been written.
+ @param error       The error that occurred, if the PDF could not be written.
+ 
+ @return `YES` if the whole PDF was written; otherwise, `NO`.
+ */
+- (BOOL)writePDFToURL:(NSURL *)url error:(NSError * _Nullable *)error;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -33,6 +33,7 @@
 
 #import "ORKConsentDocument_Internal.h"
 
+#import "ORKConsentPDFComposer.h"
 #import "ORKConsentSection_Private.h"
 #import "ORKConsentSectionFormatter.h"
 #import "ORKConsentSignature.h"
@@ -43,6 +44,9 @@
 #import "ORKErrors.h"
 #import "ORKSkin_Private.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
 static NSString *const _ORKSignaturesKey = @"signatures";
 
 @implementation ORKConsentDocument {
@@ -115,6 +119,76 @@ static NSString *const _ORKSignaturesKey = @"signatures";
 
 }
 
+- (BOOL)writePDFToURL:(NSURL *)url error:(NSError **)error {
+    BOOL hasHTMLContent = (_htmlReviewContent != nil);
+    for (ORKConsentSection *section in _sections) {
+        hasHTMLContent = hasHTMLContent || (!section.omitFromDocument && section.htmlContent != nil);
+    }
+    if (hasHTMLContent) {
+        if (error) {
+            *error = [NSError errorWithDomain:ORKErrorDomain code:ORKErrorInvalidObject userInfo:@{NSLocalizedFailureReasonErrorKey: @"HTML content can only be rendered by makePDFWithCompletionHandler:."}];
+        }
+        return NO;
+    }
+    
+    // Collect the signature fields first, since a signature without a title throws.
+    NSMutableArray<NSArray<ORKConsentPDFSignatureField *> *> *signatureFields = [NSMutableArray array];
+    for (ORKConsentSignature *signature in self.signatures) {
+        [signatureFields addObject:[_signatureFormatter PDFSignatureFieldsForSignature:signature]];
+    }
+    
+    // Write to a hidden sibling and rename it into place, so a failed write leaves any existing file intact.
+    NSURL *temporaryURL = [url.URLByDeletingLastPathComponent URLByAppendingPathComponent:[NSString stringWithFormat:@".%@.partial", url.lastPathComponent]
+                                                                              isDirectory:NO];
+    int fileDescriptor = open(temporaryURL.fileSystemRepresentation, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fileDescriptor < 0) {
+        if (error) {
+            *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:@{NSURLErrorKey: temporaryURL}];
+        }
+        return NO;
+    }
+    
+    CGSize pageSize = [ORKHTMLPDFWriter defaultPageSize];
+    ORKConsentPDFComposer *composer = [[ORKConsentPDFComposer alloc] initWithFileDescriptor:fileDescriptor
+                                                                                  pageWidth:pageSize.width
+                                                                                 pageHeight:pageSize.height];
+    composer.pageNumberFormat = ORKLocalizedString(@"CONSENT_PAGE_NUMBER_FORMAT", nil);
+    
+    // Same content and order as the HTML for print.
+    [composer addHeading:_title ? : @"" level:3];
+    for (ORKConsentSection *section in _sections) {
+        if (!section.omitFromDocument) {
+            [composer addHeading:section.formalTitle ? : (section.title ? : @"") level:4];
+            [composer addParagraph:section.content ? : @""];
+        }
+    }
+    
+    [composer addPageBreak];
+    [composer addHeading:_signaturePageTitle ? : @"" level:4];
+    [composer addParagraph:_signaturePageContent ? : @""];
+    for (NSArray<ORKConsentPDFSignatureField *> *fields in signatureFields) {
+        [composer addSignatureFields:fields];
+    }
+    
+    BOOL success = [composer finishWithError:error];
+    if (close(fileDescriptor) != 0 && success) {
+        if (error) {
+            *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:@{NSURLErrorKey: temporaryURL}];
+        }
+        success = NO;
+    }
+    if (success && rename(temporaryURL.fileSystemRepresentation, url.fileSystemRepresentation) != 0) {
+        if (error) {
+            *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:@{NSURLErrorKey: url}];
+        }
+        success = NO;
+    }
+    if (!success) {
+        unlink(temporaryURL.fileSystemRepresentation);
+    }
+    return success;
+}
+
 #pragma mark - Private
 
 - (NSString *)mobileHTMLWithTitle:(NSString *)title detail:(NSString *)detail {
@@ -35,12 +35,15 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class ORKConsentPDFSignatureField;
 @class ORKConsentSignature;
 
 @interface ORKConsentSignatureFormatter : NSObject
 
 - (NSString *)HTMLForSignature:(ORKConsentSignature *)signature;
 
+- (NSArray<ORKConsentPDFSignatureField *> *)PDFSignatureFieldsForSignature:(ORKConsentSignature *)signature;
+
 @end
 
 NS_ASSUME_NONNULL_END
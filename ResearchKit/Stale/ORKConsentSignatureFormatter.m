@@ -32,11 +32,39 @@
 
 #import "ORKConsentSignatureFormatter.h"
 
+#import "ORKConsentPDFComposer.h"
 #import "ORKConsentSignature.h"
 
 #import "ORKHelpers_Internal.h"
 
 
+// Flattens the image onto white, since the PDF field has no alpha channel.
+static NSData *ORKGrayscalePixelsOfImage(UIImage *image, size_t *pixelWidth, size_t *pixelHeight) {
+    CGImageRef cgImage = image.CGImage;
+    if (cgImage == NULL) {
+        return nil;
+    }
+    size_t width = CGImageGetWidth(cgImage);
+    size_t height = CGImageGetHeight(cgImage);
+    NSMutableData *pixels = [NSMutableData dataWithLength:width * height];
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceGray();
+    CGContextRef context = CGBitmapContextCreate(pixels.mutableBytes, width, height, 8, width, colorSpace, (CGBitmapInfo)kCGImageAlphaNone);
+    CGColorSpaceRelease(colorSpace);
+    if (context == NULL) {
+        return nil;
+    }
+    CGRect rect = CGRectMake(0, 0, width, height);
+    CGContextSetGrayFillColor(context, 1.0, 1.0);
+    CGContextFillRect(context, rect);
+    CGContextDrawImage(context, rect, cgImage);
+    CGContextRelease(context);
+    
+    *pixelWidth = width;
+    *pixelHeight = height;
+    return pixels;
+}
+
+
 @implementation ORKConsentSignatureFormatter
 
 - (NSString *)HTMLForSignature:(ORKConsentSignature *)signature {
@@ -109,4 +137,44 @@
     return body;
 }
 
+- (NSArray<ORKConsentPDFSignatureField *> *)PDFSignatureFieldsForSignature:(ORKConsentSignature *)signature {
+    NSMutableArray<ORKConsentPDFSignatureField *> *fields = [NSMutableArray array];
+    
+    if (signature.title == nil) {
+        @throw [NSException exceptionWithName:NSObjectNotAvailableException reason:@"Signature title is missing" userInfo:nil];
+    }
+    
+    if (signature.requiresSignatureImage || signature.signatureImage) {
+        size_t pixelWidth = 0;
+        size_t pixelHeight = 0;
+        NSData *pixels = signature.signatureImage ? ORKGrayscalePixelsOfImage(signature.signatureImage, &pixelWidth, &pixelHeight) : nil;
+        [fields addObject:[[ORKConsentPDFSignatureField alloc] initWithCaption:ORKLocalizedString(@"CONSENT_DOC_LINE_SIGNATURE", nil)
+                                                               grayscalePixels:pixels
+                                                                    pixelWidth:pixelWidth
+                                                                   pixelHeight:pixelHeight]];
+    }
+    
+    if (signature.requiresName || signature.familyName || signature.givenName) {
+        NSMutableArray *names = [NSMutableArray array];
+        if (signature.givenName) {
+            [names addObject:signature.givenName];
+        }
+        if (signature.familyName) {
+            [names addObject:signature.familyName];
+        }
+        if (ORKCurrentLocalePresentsFamilyNameFirst()) {
+            names = [[[names reverseObjectEnumerator] allObjects] mutableCopy];
+        }
+        [fields addObject:[[ORKConsentPDFSignatureField alloc] initWithCaption:ORKLocalizedString(@"CONSENT_DOC_LINE_PRINTED_NAME", nil)
+                                                                          text:[names componentsJoinedByString:@" "]]];
+    }
+    
+    if (fields.count > 0) {
+        [fields addObject:[[ORKConsentPDFSignatureField alloc] initWithCaption:ORKLocalizedString(@"CONSENT_DOC_LINE_DATE", nil)
+                                                                          text:signature.signatureDate]];
+    }
+    
+    return [fields copy];
+}
+
 @end
@@ -32,6 +32,7 @@
 #import "ORKAmslerGridResult.h"
 #import "ORKResult_Private.h"
 #import "ORKHelpers_Internal.h"
+#import "ORKStrokeCodec.h"
 
 @implementation ORKAmslerGridResult
 
@@ -52,7 +53,9 @@
 - (void)encodeWithCoder:(NSCoder *)aCoder {
     [super encodeWithCoder:aCoder];
     ORK_ENCODE_IMAGE(aCoder, image);
-    ORK_ENCODE_OBJ(aCoder, path);
+    if (_path) {
+        [aCoder encodeObject:[[ORKStrokeCodec new] dataWithPaths:_path] forKey:@"pathStrokes"];
+    }
     ORK_ENCODE_ENUM(aCoder, eyeSide);
 }
 
@@ -60,7 +63,12 @@
     self = [super initWithCoder:aDecoder];
     if (self) {
         ORK_DECODE_IMAGE(aDecoder, image);
-        ORK_DECODE_OBJ_ARRAY(aDecoder, path, UIBezierPath);
+        NSData *strokes = [aDecoder decodeObjectOfClass:[NSData class] forKey:@"pathStrokes"];
+        if (strokes) {
+            _path = [ORKStrokeCodec pathsWithData:strokes error:NULL];
+        } else {
+            ORK_DECODE_OBJ_ARRAY(aDecoder, path, UIBezierPath);
+        }
         ORK_DECODE_ENUM(aDecoder, eyeSide);
     }
     return self;
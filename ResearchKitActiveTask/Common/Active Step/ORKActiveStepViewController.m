@@ -44,6 +44,8 @@
 #import "ORKStepViewController_Internal.h"
 #import "ORKTaskViewController_Internal.h"
 #import "ORKRecorder_Internal.h"
+#import "ORKLocationRecorder.h"
+#import "ORKPedometerRecorder.h"
 
 #import "ORKStepView_Private.h"
 #import "ORKStepContentView.h"
@@ -52,6 +54,7 @@
 #import "ORKCollectionResult_Private.h"
 #import "ORKResult.h"
 #import "ORKTask.h"
+#import "ORKTimelineAligner.h"
 
 #import "ORKAccessibility.h"
 #import "ORKHelpers_Internal.h"
@@ -59,11 +62,15 @@
 
 NSString * const ORKActiveStepViewAccessibilityIdentifier = @"ORKActiveStepView";
 
+static NSString *const ORKTimelineAlignmentResultIdentifier = @"timelineAlignment";
+static NSString *const ORKActiveStepRuntimeStreamIdentifier = @"runtime";
+
 @interface ORKActiveStepViewController () {
     ORKActiveStepView *_activeStepView;
     ORKActiveStepTimer *_activeStepTimer;
 
     NSArray *_recorderResults;
+    ORKTimelineAligner *_timelineAligner;
     
     SystemSoundID _alertSound;
     NSURL *_alertSoundURL;
@@ -274,6 +281,10 @@ NSString * const ORKActiveStepViewAccessibilityIdentifier = @"ORKActiveStepView"
     if (_recorderResults) {
         sResult.results = [sResult.results arrayByAddingObjectsFromArray:_recorderResults] ? : _recorderResults;
     }
+    if (_timelineAligner) {
+        ORKTimelineAlignmentResult *alignmentResult = [_timelineAligner resultWithIdentifier:ORKTimelineAlignmentResultIdentifier];
+        sResult.results = [sResult.results arrayByAddingObject:alignmentResult] ? : @[alignmentResult];
+    }
     return sResult;
 }
 
@@ -308,11 +319,33 @@ NSString * const ORKActiveStepViewAccessibilityIdentifier = @"ORKActiveStepView"
             [recorders addObject:recorder];
         }
     }
+    [self shareWalkingDistanceEstimatorAmongRecorders:recorders];
     self.recorders = recorders;
     
     [self recordersDidChange];
 }
 
+// Pedometer recorders contribute their step counts to the distance estimate of the step's location recorder.
+- (void)shareWalkingDistanceEstimatorAmongRecorders:(NSArray<ORKRecorder *> *)recorders {
+#if ORK_FEATURE_CLLOCATIONMANAGER_AUTHORIZATION
+    ORKWalkingDistanceEstimator *estimator = nil;
+    for (ORKRecorder *recorder in recorders) {
+        if ([recorder isKindOfClass:[ORKLocationRecorder class]] && ((ORKLocationRecorder *)recorder).walkingDistanceEstimator) {
+            estimator = ((ORKLocationRecorder *)recorder).walkingDistanceEstimator;
+            break;
+        }
+    }
+    if (!estimator) {
+        return;
+    }
+    for (ORKRecorder *recorder in recorders) {
+        if ([recorder isKindOfClass:[ORKPedometerRecorder class]]) {
+            ((ORKPedometerRecorder *)recorder).walkingDistanceEstimator = estimator;
+        }
+    }
+#endif
+}
+
 - (void)setOutputDirectory:(NSURL *)outputDirectory {
     [super setOutputDirectory:outputDirectory];
     [self prepareStep];
@@ -346,6 +379,7 @@ NSString * const ORKActiveStepViewAccessibilityIdentifier = @"ORKActiveStepView"
     [self recordersWillStart];
     // Start recorders
     for (ORKRecorder *recorder in self.recorders) {
+        [_timelineAligner addStreamWithIdentifier:recorder.identifier timebase:[recorder timelineTimebase]];
         [recorder viewController:self willStartStepWithView:self.customViewContainer];
         [recorder start];
     }
@@ -369,7 +403,12 @@ NSString * const ORKActiveStepViewAccessibilityIdentifier = @"ORKActiveStepView"
 - (void)start {
     ORK_Log_Debug("%@",self);
     self.started = YES;
+    _timelineAligner = [ORKTimelineAligner new];
     [self startTimer];
+    if (_activeStepTimer) {
+        [_timelineAligner addStreamWithIdentifier:ORKActiveStepRuntimeStreamIdentifier timebase:ORKTimelineTimebaseStepRuntime];
+    }
+    [self observeTimeline];
     [_activeStepView.activeCustomView startStep:self];
     
     [self startRecorders];
@@ -398,6 +437,7 @@ NSString * const ORKActiveStepViewAccessibilityIdentifier = @"ORKActiveStepView"
         return;
     }
     
+    [self observeTimeline];
     [_activeStepTimer pause];
     [_activeStepView.activeCustomView suspendStep:self];
     
@@ -411,6 +451,9 @@ NSString * const ORKActiveStepViewAccessibilityIdentifier = @"ORKActiveStepView"
     }
     
     [_activeStepTimer resume];
+    // The runtime did not advance while suspended, so earlier observations no longer apply.
+    [_timelineAligner restartStreamWithIdentifier:ORKActiveStepRuntimeStreamIdentifier];
+    [self observeTimeline];
     [self prepareRecorders];
     [self startRecorders];
     [_activeStepView.activeCustomView resumeStep:self];
@@ -423,6 +466,7 @@ NSString * const ORKActiveStepViewAccessibilityIdentifier = @"ORKActiveStepView"
     }
     
     self.finished = YES;
+    [self observeTimeline];
     [_activeStepTimer pause];
     [_activeStepView.activeCustomView finishStep:self];
     [self stopRecorders];
@@ -475,7 +519,17 @@ NSString * const ORKActiveStepViewAccessibilityIdentifier = @"ORKActiveStepView"
     }
 }
 
+- (void)observeTimeline {
+    [_timelineAligner observeWallClock];
+    if (_activeStepTimer) {
+        [_timelineAligner observeStreamTime:_activeStepTimer.runtime clockTime:ORKClockNow() forStreamWithIdentifier:ORKActiveStepRuntimeStreamIdentifier];
+    }
+}
+
 - (void)countDownTimerFired:(ORKActiveStepTimer *)timer finished:(BOOL)finished {
+    if (!finished) {
+        [self observeTimeline];
+    }
     if (finished) {
         [self finish];
     }
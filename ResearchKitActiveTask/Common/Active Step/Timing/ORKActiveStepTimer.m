@@ -30,26 +30,17 @@
 
 
 #import "ORKActiveStepTimer.h"
+#import "ORKTickScheduler.h"
+#import "ORKClock.h"
 #import "ORKHelpers_Internal.h"
 
 @import UIKit;
-#include <mach/mach.h>
-#include <mach/mach_time.h>
-
-static NSTimeInterval timeIntervalFromMachTime(uint64_t delta) {
-    static mach_timebase_info_data_t sTimebaseInfo;
-    if (sTimebaseInfo.denom == 0) {
-        (void)mach_timebase_info(&sTimebaseInfo);
-    }
-    uint64_t elapsedNano = delta * sTimebaseInfo.numer / sTimebaseInfo.denom;
-    return elapsedNano * 1.0 / NSEC_PER_SEC;
-}
 
 @implementation ORKActiveStepTimer {
-    uint64_t _startTime;
+    ORKClockTime _startTime;
     NSTimeInterval _preExistingRuntime;
     dispatch_queue_t _queue;
-    dispatch_source_t _timer;
+    ORKTickSubscription *_subscription;
     uint32_t _isRunning;
 }
 
@@ -103,9 +94,8 @@ static NSTimeInterval timeIntervalFromMachTime(uint64_t delta) {
 
 - (NSTimeInterval)queue_runtime {
     NSTimeInterval runtime = _preExistingRuntime;
-    if (_timer != NULL) {
-        uint64_t now = mach_absolute_time();
-        runtime += timeIntervalFromMachTime(now - _startTime);
+    if (_subscription != nil) {
+        runtime += ORKTimeIntervalBetweenClockTimes(_startTime, ORKClockNow());
     }
     return runtime;
 }
@@ -116,12 +106,6 @@ static NSTimeInterval timeIntervalFromMachTime(uint64_t delta) {
     });
 }
 
-- (void)hiqueue_event {
-    dispatch_sync(_queue, ^{
-        [self queue_event];
-    });
-}
-
 - (void)queue_event {
     
     NSTimeInterval runtime = [self queue_runtime];
@@ -136,15 +120,14 @@ static NSTimeInterval timeIntervalFromMachTime(uint64_t delta) {
 }
 
 - (void)queue_clearTimer {
-    if (_timer != NULL) {
-        
-        dispatch_source_cancel(_timer);
-        _timer = NULL;
+    if (_subscription != nil) {
+        [_subscription invalidate];
+        _subscription = nil;
     }
 }
 
 - (void)queue_resume {
-    if (_timer != NULL) {
+    if (_subscription != nil) {
         // Already resumed
         return;
     }
@@ -154,37 +137,31 @@ static NSTimeInterval timeIntervalFromMachTime(uint64_t delta) {
         return;
     }
     
-    _timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER,
-                                    0, 0, dispatch_get_global_queue(QOS_CLASS_USER_INTERACTIVE, 0));
-    if (_timer == NULL) {
-        assert(0);
-        return;
-    }
-    ORKWeakTypeOf(self) weakSelf = self;
-    dispatch_source_set_event_handler(_timer, ^{
-        ORKStrongTypeOf(self) strongSelf = weakSelf;
-        [strongSelf hiqueue_event];
-    });
-    
     NSTimeInterval timeUntilNextFire = (floor(_preExistingRuntime / _interval) + 1)*_interval -  _preExistingRuntime;
     
-    _startTime = mach_absolute_time();
-    dispatch_source_set_timer(_timer,
-                              dispatch_time(DISPATCH_TIME_NOW, timeUntilNextFire * NSEC_PER_SEC),
-                              _interval * NSEC_PER_SEC,
-                              0.05 * NSEC_PER_SEC);
-    dispatch_resume(_timer);
+    // Deadlines are computed from the start time, so ticks stay on interval boundaries of the
+    // runtime however late individual wakeups are, and are coalesced with other active timers.
+    _startTime = ORKClockNow();
+    ORKWeakTypeOf(self) weakSelf = self;
+    _subscription = [[ORKTickScheduler sharedScheduler] scheduleTicksWithInterval:_interval
+                                                                    firstDeadline:_startTime + ORKClockTimeFromSystemUptime(timeUntilNextFire)
+                                                                           leeway:MIN(0.05, _interval * 0.25)
+                                                                            queue:_queue
+                                                                          handler:^(NSUInteger tickIndex, ORKClockTime deadline) {
+        ORKStrongTypeOf(self) strongSelf = weakSelf;
+        [strongSelf queue_event];
+    }];
 }
 
 - (void)queue_pauseAtFinish:(BOOL)atFinish {
-    if (_timer == NULL) {
+    if (_subscription == nil) {
         // Not running
         return;
     }
     
-    uint64_t now = mach_absolute_time();
+    ORKClockTime now = ORKClockNow();
     [self queue_clearTimer];
-    _preExistingRuntime += timeIntervalFromMachTime(now - _startTime);
+    _preExistingRuntime += ORKTimeIntervalBetweenClockTimes(_startTime, now);
     _startTime = 0;
     
 }
@@ -0,0 +1,133 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <ResearchKit/ORKClock.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Jitter statistics for delivered ticks.
+ 
+ Lateness is the time between a tick's deadline and the wakeup that delivered it. Ticks that
+ fall due while a wakeup is delayed by more than a whole interval are not delivered in a burst;
+ they are counted as missed and the next delivered tick is the most recent deadline.
+ */
+typedef struct {
+    NSUInteger tickCount;
+    NSUInteger missedTickCount;
+    NSTimeInterval meanLateness;
+    NSTimeInterval maximumLateness;
+    NSTimeInterval latenessStandardDeviation;
+} ORKTickStatistics;
+
+/**
+ Called for each delivered tick with the zero-based index of the tick and its deadline.
+ Deadlines are `firstDeadline + tickIndex * interval`, so they never accumulate drift.
+ */
+typedef void (^ORKTickHandler)(NSUInteger tickIndex, ORKClockTime deadline);
+
+@class ORKTickScheduler;
+
+/// A repeating tick registered with an `ORKTickScheduler`.
+@interface ORKTickSubscription : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, readonly) NSTimeInterval interval;
+
+@property (nonatomic, readonly) NSTimeInterval leeway;
+
+@property (nonatomic, readonly) ORKClockTime firstDeadline;
+
+@property (nonatomic, readonly, getter=isValid) BOOL valid;
+
+@property (nonatomic, readonly) ORKTickStatistics statistics;
+
+/// Stops delivering ticks. Ticks already dispatched to the handler queue are dropped.
+- (void)invalidate;
+
+@end
+
+/**
+ Delivers repeating ticks for any number of subscribers from a single one-shot timer.
+ 
+ Each wakeup serves every subscription that has fallen due. The timer is armed for the last
+ deadline that keeps every pending tick within its own leeway, so subscribers with the same
+ period and nearby phases are coalesced into one wakeup.
+ */
+@interface ORKTickScheduler : NSObject
+
+/// The scheduler shared by the active step timers and the active task view controllers.
++ (ORKTickScheduler *)sharedScheduler;
+
+/**
+ Schedules ticks every `interval` seconds, starting at `firstDeadline`.
+ 
+ The handler is called asynchronously on `queue`. If `queue` is `nil`, it is called
+ synchronously on the scheduler's internal queue and must return quickly.
+ */
+- (ORKTickSubscription *)scheduleTicksWithInterval:(NSTimeInterval)interval
+                                     firstDeadline:(ORKClockTime)firstDeadline
+                                            leeway:(NSTimeInterval)leeway
+                                             queue:(nullable dispatch_queue_t)queue
+                                           handler:(ORKTickHandler)handler;
+
+/// Schedules ticks every `interval` seconds from now, with a leeway of a tenth of the interval.
+- (ORKTickSubscription *)scheduleTicksWithInterval:(NSTimeInterval)interval
+                                             queue:(nullable dispatch_queue_t)queue
+                                           handler:(ORKTickHandler)handler;
+
+/// The number of times the scheduler has woken up to deliver ticks.
+@property (nonatomic, readonly) NSUInteger wakeupCount;
+
+/// Statistics for every tick delivered by the scheduler.
+@property (nonatomic, readonly) ORKTickStatistics statistics;
+
+/**
+ Returns a scheduler that never arms a timer. Call `-wakeAtClockTime:` to deliver ticks,
+ which allows the scheduler to be driven on simulated time.
+ */
+- (instancetype)initWithManualWakeups;
+
+/// The earliest pending deadline, or `UINT64_MAX` if there are no subscriptions.
+@property (nonatomic, readonly) ORKClockTime nextDeadline;
+
+/// The latest time a wakeup can happen without exceeding the leeway of any pending tick.
+@property (nonatomic, readonly) ORKClockTime latestWakeupTime;
+
+/// Delivers every tick whose deadline is at or before `clockTime`.
+- (void)wakeAtClockTime:(ORKClockTime)clockTime;
+
+@end
+
+NS_ASSUME_NONNULL_END
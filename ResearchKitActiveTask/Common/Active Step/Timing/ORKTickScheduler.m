@@ -0,0 +1,387 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKTickScheduler.h"
+#import "ORKHelpers_Internal.h"
+
+
+static const void *ORKTickSchedulerQueueKey = &ORKTickSchedulerQueueKey;
+
+typedef struct {
+    NSUInteger count;
+    NSUInteger missedCount;
+    double mean;
+    double sumOfSquares;
+    double maximum;
+} ORKTickAccumulator;
+
+static void ORKTickAccumulatorAdd(ORKTickAccumulator *accumulator, double lateness, NSUInteger missedCount) {
+    // Welford's running mean and variance.
+    accumulator->count += 1;
+    accumulator->missedCount += missedCount;
+    double delta = lateness - accumulator->mean;
+    accumulator->mean += delta / accumulator->count;
+    accumulator->sumOfSquares += delta * (lateness - accumulator->mean);
+    accumulator->maximum = MAX(accumulator->maximum, lateness);
+}
+
+static ORKTickStatistics ORKTickStatisticsFromAccumulator(ORKTickAccumulator accumulator) {
+    ORKTickStatistics statistics;
+    statistics.tickCount = accumulator.count;
+    statistics.missedTickCount = accumulator.missedCount;
+    statistics.meanLateness = accumulator.mean;
+    statistics.maximumLateness = accumulator.maximum;
+    statistics.latenessStandardDeviation = (accumulator.count > 1) ? sqrt(accumulator.sumOfSquares / (accumulator.count - 1)) : 0;
+    return statistics;
+}
+
+static uint64_t ORKNanosecondsFromTimeInterval(NSTimeInterval interval) {
+    return (interval > 0) ? (uint64_t)llround(interval * NSEC_PER_SEC) : 0;
+}
+
+
+@interface ORKTickScheduler ()
+
+- (void)queue_sync:(dispatch_block_t)block;
+
+- (void)removeSubscription:(ORKTickSubscription *)subscription;
+
+@end
+
+
+@interface ORKTickSubscription ()
+
+- (instancetype)initWithScheduler:(ORKTickScheduler *)scheduler
+                         interval:(NSTimeInterval)interval
+                    firstDeadline:(ORKClockTime)firstDeadline
+                           leeway:(NSTimeInterval)leeway
+                            queue:(dispatch_queue_t)queue
+                          handler:(ORKTickHandler)handler;
+
+- (ORKClockTime)queue_nextDeadline;
+
+- (void)deliverTickWithIndex:(NSUInteger)tickIndex deadline:(ORKClockTime)deadline;
+
+@end
+
+
+@implementation ORKTickSubscription {
+    @package
+    __weak ORKTickScheduler *_scheduler;
+    uint64_t _intervalNanoseconds;
+    uint64_t _leewayNanoseconds;
+    NSUInteger _nextTickIndex;
+    dispatch_queue_t _queue;
+    ORKTickHandler _handler;
+    ORKTickAccumulator _accumulator;
+    BOOL _valid;
+}
+
+- (instancetype)initWithScheduler:(ORKTickScheduler *)scheduler
+                         interval:(NSTimeInterval)interval
+                    firstDeadline:(ORKClockTime)firstDeadline
+                           leeway:(NSTimeInterval)leeway
+                            queue:(dispatch_queue_t)queue
+                          handler:(ORKTickHandler)handler {
+    self = [super init];
+    if (self) {
+        _scheduler = scheduler;
+        _interval = interval;
+        _leeway = leeway;
+        _firstDeadline = firstDeadline;
+        _intervalNanoseconds = MAX(ORKNanosecondsFromTimeInterval(interval), 1);
+        _leewayNanoseconds = ORKNanosecondsFromTimeInterval(leeway);
+        _queue = queue;
+        _handler = [handler copy];
+        _valid = YES;
+    }
+    return self;
+}
+
+- (ORKClockTime)queue_nextDeadline {
+    return _firstDeadline + (ORKClockTime)_nextTickIndex * _intervalNanoseconds;
+}
+
+- (BOOL)isValid {
+    __block BOOL valid = NO;
+    [_scheduler queue_sync:^{
+        valid = _valid;
+    }];
+    return valid;
+}
+
+- (ORKTickStatistics)statistics {
+    __block ORKTickAccumulator accumulator = {0};
+    [_scheduler queue_sync:^{
+        accumulator = _accumulator;
+    }];
+    return ORKTickStatisticsFromAccumulator(accumulator);
+}
+
+- (void)invalidate {
+    [_scheduler removeSubscription:self];
+}
+
+- (void)deliverTickWithIndex:(NSUInteger)tickIndex deadline:(ORKClockTime)deadline {
+    __block ORKTickHandler handler = nil;
+    [_scheduler queue_sync:^{
+        if (_valid) {
+            handler = _handler;
+        }
+    }];
+    if (handler) {
+        handler(tickIndex, deadline);
+    }
+}
+
+@end
+
+
+@implementation ORKTickScheduler {
+    dispatch_queue_t _queue;
+    dispatch_source_t _timer;
+    NSMutableArray<ORKTickSubscription *> *_subscriptions;
+    ORKTickAccumulator _accumulator;
+    NSUInteger _wakeupCount;
+    BOOL _manualWakeups;
+}
+
++ (ORKTickScheduler *)sharedScheduler {
+    static ORKTickScheduler *sharedScheduler = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedScheduler = [[ORKTickScheduler alloc] init];
+    });
+    return sharedScheduler;
+}
+
+- (instancetype)init {
+    return [self initWithManualWakeups:NO];
+}
+
+- (instancetype)initWithManualWakeups {
+    return [self initWithManualWakeups:YES];
+}
+
+- (instancetype)initWithManualWakeups:(BOOL)manualWakeups {
+    self = [super init];
+    if (self) {
+        _manualWakeups = manualWakeups;
+        _subscriptions = [NSMutableArray new];
+        dispatch_queue_attr_t attributes = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_USER_INTERACTIVE, 0);
+        _queue = dispatch_queue_create("org.researchkit.tickscheduler", attributes);
+        dispatch_queue_set_specific(_queue, ORKTickSchedulerQueueKey, (__bridge void *)self, NULL);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_timer != NULL) {
+        dispatch_source_cancel(_timer);
+    }
+}
+
+- (void)queue_sync:(dispatch_block_t)block {
+    // Handlers without a queue run on the scheduler queue and may call back into the scheduler.
+    if (dispatch_get_specific(ORKTickSchedulerQueueKey) == (__bridge void *)self) {
+        block();
+    } else {
+        dispatch_sync(_queue, block);
+    }
+}
+
+- (ORKTickSubscription *)scheduleTicksWithInterval:(NSTimeInterval)interval queue:(dispatch_queue_t)queue handler:(ORKTickHandler)handler {
+    ORKClockTime firstDeadline = ORKClockNow() + ORKNanosecondsFromTimeInterval(interval);
+    return [self scheduleTicksWithInterval:interval firstDeadline:firstDeadline leeway:interval * 0.1 queue:queue handler:handler];
+}
+
+- (ORKTickSubscription *)scheduleTicksWithInterval:(NSTimeInterval)interval
+                                     firstDeadline:(ORKClockTime)firstDeadline
+                                            leeway:(NSTimeInterval)leeway
+                                             queue:(dispatch_queue_t)queue
+                                           handler:(ORKTickHandler)handler {
+    if (!handler) {
+        @throw [NSException exceptionWithName:NSInvalidArgumentException reason:@"Handler is required" userInfo:nil];
+    }
+    if (interval <= 0) {
+        @throw [NSException exceptionWithName:NSInvalidArgumentException reason:@"Interval must be positive" userInfo:nil];
+    }
+    ORKTickSubscription *subscription = [[ORKTickSubscription alloc] initWithScheduler:self
+                                                                              interval:interval
+                                                                         firstDeadline:firstDeadline
+                                                                                leeway:MAX(leeway, 0)
+                                                                                 queue:queue
+                                                                               handler:handler];
+    [self queue_sync:^{
+        [_subscriptions addObject:subscription];
+        [self queue_armTimer];
+    }];
+    return subscription;
+}
+
+- (void)removeSubscription:(ORKTickSubscription *)subscription {
+    [self queue_sync:^{
+        if (!subscription->_valid) {
+            return;
+        }
+        subscription->_valid = NO;
+        // Release the handler so that owners captured by it are not kept alive.
+        subscription->_handler = nil;
+        [_subscriptions removeObjectIdenticalTo:subscription];
+        [self queue_armTimer];
+    }];
+}
+
+- (NSUInteger)wakeupCount {
+    __block NSUInteger wakeupCount = 0;
+    [self queue_sync:^{
+        wakeupCount = _wakeupCount;
+    }];
+    return wakeupCount;
+}
+
+- (ORKTickStatistics)statistics {
+    __block ORKTickAccumulator accumulator = {0};
+    [self queue_sync:^{
+        accumulator = _accumulator;
+    }];
+    return ORKTickStatisticsFromAccumulator(accumulator);
+}
+
+- (ORKClockTime)nextDeadline {
+    __block ORKClockTime nextDeadline = UINT64_MAX;
+    [self queue_sync:^{
+        nextDeadline = [self queue_nextDeadline];
+    }];
+    return nextDeadline;
+}
+
+- (ORKClockTime)latestWakeupTime {
+    __block ORKClockTime latestWakeupTime = UINT64_MAX;
+    [self queue_sync:^{
+        latestWakeupTime = [self queue_latestWakeupTime];
+    }];
+    return latestWakeupTime;
+}
+
+- (ORKClockTime)queue_nextDeadline {
+    ORKClockTime nextDeadline = UINT64_MAX;
+    for (ORKTickSubscription *subscription in _subscriptions) {
+        nextDeadline = MIN(nextDeadline, [subscription queue_nextDeadline]);
+    }
+    return nextDeadline;
+}
+
+- (ORKClockTime)queue_latestWakeupTime {
+    ORKClockTime latestWakeupTime = UINT64_MAX;
+    for (ORKTickSubscription *subscription in _subscriptions) {
+        latestWakeupTime = MIN(latestWakeupTime, [subscription queue_nextDeadline] + subscription->_leewayNanoseconds);
+    }
+    return latestWakeupTime;
+}
+
+- (void)queue_armTimer {
+    if (_manualWakeups) {
+        return;
+    }
+    if (_timer == NULL) {
+        _timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, _queue);
+        if (_timer == NULL) {
+            assert(0);
+            return;
+        }
+        ORKWeakTypeOf(self) weakSelf = self;
+        dispatch_source_set_event_handler(_timer, ^{
+            ORKStrongTypeOf(self) strongSelf = weakSelf;
+            [strongSelf wakeAtClockTime:ORKClockNow()];
+        });
+        dispatch_source_set_timer(_timer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+        dispatch_resume(_timer);
+    }
+    
+    ORKClockTime nextDeadline = [self queue_nextDeadline];
+    if (nextDeadline == UINT64_MAX) {
+        dispatch_source_set_timer(_timer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+        return;
+    }
+    // A one-shot timer for the last deadline that can share a wakeup with the earliest one
+    // without any pending tick exceeding its own leeway. The remaining slack is handed to the
+    // system as timer leeway so it can coalesce the wakeup with other timers.
+    ORKClockTime latestWakeupTime = [self queue_latestWakeupTime];
+    ORKClockTime fireTime = nextDeadline;
+    for (ORKTickSubscription *subscription in _subscriptions) {
+        ORKClockTime deadline = [subscription queue_nextDeadline];
+        if (deadline <= latestWakeupTime) {
+            fireTime = MAX(fireTime, deadline);
+        }
+    }
+    ORKClockTime now = ORKClockNow();
+    uint64_t delay = (fireTime > now) ? fireTime - now : 0;
+    dispatch_source_set_timer(_timer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)delay), DISPATCH_TIME_FOREVER, latestWakeupTime - fireTime);
+}
+
+- (void)wakeAtClockTime:(ORKClockTime)clockTime {
+    NSMutableArray<dispatch_block_t> *synchronousDeliveries = [NSMutableArray new];
+    [self queue_sync:^{
+        _wakeupCount += 1;
+        for (ORKTickSubscription *subscription in _subscriptions) {
+            if ([subscription queue_nextDeadline] > clockTime) {
+                continue;
+            }
+            // Deliver the most recent deadline rather than a burst of the ones missed.
+            NSUInteger tickIndex = (NSUInteger)((clockTime - subscription.firstDeadline) / subscription->_intervalNanoseconds);
+            NSUInteger missedCount = tickIndex - subscription->_nextTickIndex;
+            ORKClockTime deadline = subscription.firstDeadline + (ORKClockTime)tickIndex * subscription->_intervalNanoseconds;
+            subscription->_nextTickIndex = tickIndex + 1;
+            
+            double lateness = ORKTimeIntervalBetweenClockTimes(deadline, clockTime);
+            ORKTickAccumulatorAdd(&subscription->_accumulator, lateness, missedCount);
+            ORKTickAccumulatorAdd(&_accumulator, lateness, missedCount);
+            
+            dispatch_block_t delivery = ^{
+                [subscription deliverTickWithIndex:tickIndex deadline:deadline];
+            };
+            if (subscription->_queue != nil) {
+                dispatch_async(subscription->_queue, delivery);
+            } else {
+                [synchronousDeliveries addObject:delivery];
+            }
+        }
+        [self queue_armTimer];
+    }];
+    
+    // Handlers without a queue run on the scheduler queue, outside the loop over subscriptions.
+    for (dispatch_block_t delivery in synchronousDeliveries) {
+        [self queue_sync:delivery];
+    }
+}
+
+@end
@@ -57,6 +57,7 @@
 #import "ORKSpatialSpanMemoryStep.h"
 #import "ORKSpeechRecognitionStep.h"
 #import "ORKStep_Private.h"
+#import "ORKStepTemplate.h"
 #import "ORKStroopStep.h"
 #import "ORKTappingIntervalStep.h"
 #import "ORKAudioFitnessStep.h"
@@ -160,6 +161,19 @@ void ORKStepArrayAddStep(NSMutableArray *array, ORKStep *step) {
     return [recorderConfigurations copy];
 }
 
+// Walking steps estimate the distance walked from the location and pedometer recorders.
++ (NSArray<ORKRecorderConfiguration*>*)makeWalkingRecorderConfigurationsWithOptions:(ORKPredefinedTaskOption)options {
+    NSArray<ORKRecorderConfiguration*> *recorderConfigurations = [self makeRecorderConfigurationsWithOptions:options];
+#if ORK_FEATURE_CLLOCATIONMANAGER_AUTHORIZATION
+    for (ORKRecorderConfiguration *recorderConfiguration in recorderConfigurations) {
+        if ([recorderConfiguration isKindOfClass:[ORKLocationRecorderConfiguration class]]) {
+            ((ORKLocationRecorderConfiguration *)recorderConfiguration).estimatesWalkingDistance = YES;
+        }
+    }
+#endif
+    return recorderConfigurations;
+}
+
 + (ORKCompletionStep *)makeCompletionStep {
     ORKCompletionStep *step = [[ORKCompletionStep alloc] initWithIdentifier:ORKConclusionStepIdentifier];
     step.title = ORKLocalizedString(@"TASK_COMPLETE_TITLE", nil);
@@ -169,6 +183,12 @@ void ORKStepArrayAddStep(NSMutableArray *array, ORKStep *step) {
     return step;
 }
 
++ (ORKStepTemplate *)completionStepTemplate {
+    return [ORKStepTemplate templateWithIdentifier:ORKConclusionStepIdentifier builder:^ORKStep *(NSString *stepIdentifier) {
+        return [self makeCompletionStep];
+    }];
+}
+
 + (NSDateComponentsFormatter *)textTimeFormatter {
     NSDateComponentsFormatter *formatter = [NSDateComponentsFormatter new];
     formatter.unitsStyle = NSDateComponentsFormatterUnitsStyleSpellOut;
@@ -735,7 +755,7 @@ NSString *const ORKFitnessRestStepIdentifier = @"fitness.rest";
             fitnessStep.title = ORKLocalizedString(@"FITNESS_TASK_TITLE", nil);
             fitnessStep.text = [NSString localizedStringWithFormat:ORKLocalizedString(@"FITNESS_WALK_INSTRUCTION_FORMAT", nil), [formatter stringFromTimeInterval:walkDuration]];
             fitnessStep.spokenInstruction = fitnessStep.text;
-            fitnessStep.recorderConfigurations = [self makeRecorderConfigurationsWithOptions:options];
+            fitnessStep.recorderConfigurations = [self makeWalkingRecorderConfigurationsWithOptions:options];
             fitnessStep.shouldContinueOnFinish = YES;
             fitnessStep.optional = NO;
             fitnessStep.shouldStartTimerAutomatically = YES;
@@ -791,150 +811,157 @@ NSString *const ORKSixMinuteWalkFatigueIdentifier = @"6mwt.fatigue";
                                             options:(ORKPredefinedTaskOption)options {
 
     NSTimeInterval walkDuration = 360; // 6 minutes
-    NSMutableArray *steps = [NSMutableArray array];
+    NSMutableArray<ORKStepTemplate *> *stepTemplates = [NSMutableArray array];
 
     if (!(options & ORKPredefinedTaskOptionExcludeInstructions)) {
 
         // Explanation Step
-        ORKInstructionStep *explainStep = [[ORKInstructionStep alloc] initWithIdentifier:ORKInstruction0StepIdentifier];
-        explainStep.iconImage = [UIImage systemImageNamed:@"figure.walk"];
-        explainStep.shouldAutomaticallyAdjustImageTintColor = YES;
-        explainStep.title = ORKLocalizedString(@"6MWT_TASK_TITLE", nil);
-        explainStep.text = intendedUseDescription ? : ORKLocalizedString(@"6MWT_INTRO", nil);
-        explainStep.bodyItems = @[
-            [[ORKBodyItem alloc] initWithText:ORKLocalizedString(@"6MWT_INTRO_DETAILS", nil)
-                                   detailText:nil
-                                        image:nil
-                                learnMoreItem:nil
-                                bodyItemStyle:ORKBodyItemStyleText],
-
-            [[ORKBodyItem alloc] initWithText:ORKLocalizedString(@"6MWT_INTRO_DETAIL_TIME", nil)
-                                   detailText:nil
-                                        image:[UIImage systemImageNamed:@"stopwatch"]
-                                learnMoreItem:nil
-                                bodyItemStyle:ORKBodyItemStyleImage],
-
-            [[ORKBodyItem alloc] initWithText:ORKLocalizedString(@"6MWT_INTRO_DETAIL_WATCH", nil)
-                                   detailText:nil
-                                        image:[UIImage systemImageNamed:@"applewatch"]
-                                learnMoreItem:nil
-                                bodyItemStyle:ORKBodyItemStyleImage],
-
-            [[ORKBodyItem alloc] initWithText:ORKLocalizedString(@"6MWT_INTRO_DETAIL_CLOTHING", nil)
-                                   detailText:nil
-                                        image:[UIImage systemImageNamed:@"figure.wave"]
-                                learnMoreItem:nil
-                                bodyItemStyle:ORKBodyItemStyleImage],
-
-            [[ORKBodyItem alloc] initWithText:ORKLocalizedString(@"6MWT_INTRO_DETAIL_LOCATION", nil)
-                                   detailText:nil
-                                        image:[UIImage systemImageNamed:@"location"]
-                                learnMoreItem:nil
-                                bodyItemStyle:ORKBodyItemStyleImage]
-        ];
-
-        ORKStepArrayAddStep(steps, explainStep);
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:ORKInstruction0StepIdentifier builder:^ORKStep *(NSString *stepIdentifier) {
+            ORKInstructionStep *explainStep = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
+            explainStep.iconImage = [UIImage systemImageNamed:@"figure.walk"];
+            explainStep.shouldAutomaticallyAdjustImageTintColor = YES;
+            explainStep.title = ORKLocalizedString(@"6MWT_TASK_TITLE", nil);
+            explainStep.text = intendedUseDescription ? : ORKLocalizedString(@"6MWT_INTRO", nil);
+            explainStep.bodyItems = @[
+                [[ORKBodyItem alloc] initWithText:ORKLocalizedString(@"6MWT_INTRO_DETAILS", nil)
+                                       detailText:nil
+                                            image:nil
+                                    learnMoreItem:nil
+                                    bodyItemStyle:ORKBodyItemStyleText],
+
+                [[ORKBodyItem alloc] initWithText:ORKLocalizedString(@"6MWT_INTRO_DETAIL_TIME", nil)
+                                       detailText:nil
+                                            image:[UIImage systemImageNamed:@"stopwatch"]
+                                    learnMoreItem:nil
+                                    bodyItemStyle:ORKBodyItemStyleImage],
+
+                [[ORKBodyItem alloc] initWithText:ORKLocalizedString(@"6MWT_INTRO_DETAIL_WATCH", nil)
+                                       detailText:nil
+                                            image:[UIImage systemImageNamed:@"applewatch"]
+                                    learnMoreItem:nil
+                                    bodyItemStyle:ORKBodyItemStyleImage],
+
+                [[ORKBodyItem alloc] initWithText:ORKLocalizedString(@"6MWT_INTRO_DETAIL_CLOTHING", nil)
+                                       detailText:nil
+                                            image:[UIImage systemImageNamed:@"figure.wave"]
+                                    learnMoreItem:nil
+                                    bodyItemStyle:ORKBodyItemStyleImage],
+
+                [[ORKBodyItem alloc] initWithText:ORKLocalizedString(@"6MWT_INTRO_DETAIL_LOCATION", nil)
+                                       detailText:nil
+                                            image:[UIImage systemImageNamed:@"location"]
+                                    learnMoreItem:nil
+                                    bodyItemStyle:ORKBodyItemStyleImage]
+            ];
+
+            return explainStep;
+        }]];
 
         // Instructions Step
-        ORKInstructionStep *instructStep = [[ORKInstructionStep alloc] initWithIdentifier:ORKInstruction1StepIdentifier];
-        instructStep.iconImage = [UIImage systemImageNamed:@"figure.walk"];
-        instructStep.title = ORKLocalizedString(@"6MWT_INSTRUCTIONS_TITLE", nil);
-
-        instructStep.bodyItems = @[
-            [[ORKBodyItem alloc] initWithText:ORKLocalizedString(@"6MWT_INSTRUCTIONS_1", nil)
-                                   detailText:nil
-                                        image:[UIImage systemImageNamed:@"1.circle"]
-                                learnMoreItem:nil
-                                bodyItemStyle:ORKBodyItemStyleImage],
-
-            [[ORKBodyItem alloc] initWithText:ORKLocalizedString(@"6MWT_INSTRUCTIONS_2", nil)
-                                   detailText:nil
-                                        image:[UIImage systemImageNamed:@"2.circle"]
-                                learnMoreItem:nil
-                                bodyItemStyle:ORKBodyItemStyleImage],
-
-            [[ORKBodyItem alloc] initWithText:ORKLocalizedString(@"6MWT_INSTRUCTIONS_3", nil)
-                                   detailText:nil
-                                        image:[UIImage systemImageNamed:@"3.circle"]
-                                learnMoreItem:nil
-                                bodyItemStyle:ORKBodyItemStyleImage],
-
-            [[ORKBodyItem alloc] initWithText:ORKLocalizedString(@"6MWT_INSTRUCTIONS_4", nil)
-                                   detailText:nil
-                                        image:[UIImage systemImageNamed:@"4.circle"]
-                                learnMoreItem:nil
-                                bodyItemStyle:ORKBodyItemStyleImage],
-        ];
-
-        ORKStepArrayAddStep(steps, instructStep);
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:ORKInstruction1StepIdentifier builder:^ORKStep *(NSString *stepIdentifier) {
+            ORKInstructionStep *instructStep = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
+            instructStep.iconImage = [UIImage systemImageNamed:@"figure.walk"];
+            instructStep.title = ORKLocalizedString(@"6MWT_INSTRUCTIONS_TITLE", nil);
+
+            instructStep.bodyItems = @[
+                [[ORKBodyItem alloc] initWithText:ORKLocalizedString(@"6MWT_INSTRUCTIONS_1", nil)
+                                       detailText:nil
+                                            image:[UIImage systemImageNamed:@"1.circle"]
+                                    learnMoreItem:nil
+                                    bodyItemStyle:ORKBodyItemStyleImage],
+
+                [[ORKBodyItem alloc] initWithText:ORKLocalizedString(@"6MWT_INSTRUCTIONS_2", nil)
+                                       detailText:nil
+                                            image:[UIImage systemImageNamed:@"2.circle"]
+                                    learnMoreItem:nil
+                                    bodyItemStyle:ORKBodyItemStyleImage],
+
+                [[ORKBodyItem alloc] initWithText:ORKLocalizedString(@"6MWT_INSTRUCTIONS_3", nil)
+                                       detailText:nil
+                                            image:[UIImage systemImageNamed:@"3.circle"]
+                                    learnMoreItem:nil
+                                    bodyItemStyle:ORKBodyItemStyleImage],
+
+                [[ORKBodyItem alloc] initWithText:ORKLocalizedString(@"6MWT_INSTRUCTIONS_4", nil)
+                                       detailText:nil
+                                            image:[UIImage systemImageNamed:@"4.circle"]
+                                    learnMoreItem:nil
+                                    bodyItemStyle:ORKBodyItemStyleImage],
+            ];
+
+            return instructStep;
+        }]];
     }
 
     // Fitness Step
-    ORKFitnessStep *fitnessStep = [[ORKFitnessStep alloc] initWithIdentifier:ORKSixMinuteWalkStepIdentifier];
-    fitnessStep.stepDuration = walkDuration;
-    fitnessStep.title = ORKLocalizedString(@"6MWT_TEST_IN_PROGRESS", nil);
-    fitnessStep.text = ORKLocalizedString(@"6MWT_TEST_IN_PROGRESS_DETAIL", nil);
-    fitnessStep.spokenInstruction = fitnessStep.text;
-    fitnessStep.recorderConfigurations = [self makeRecorderConfigurationsWithOptions:options];
-    fitnessStep.shouldContinueOnFinish = YES;
-    fitnessStep.optional = NO;
-    fitnessStep.shouldStartTimerAutomatically = YES;
-    fitnessStep.shouldVibrateOnStart = YES;
-    fitnessStep.shouldVibrateOnFinish = YES;
-    fitnessStep.shouldPlaySoundOnStart = YES;
-    fitnessStep.shouldPlaySoundOnFinish = YES;
-    fitnessStep.shouldSpeakRemainingTimeAtHalfway = YES;
-    fitnessStep.shouldSpeakCountDown = YES;
-    ORKStepArrayAddStep(steps, fitnessStep);
+    [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:ORKSixMinuteWalkStepIdentifier builder:^ORKStep *(NSString *stepIdentifier) {
+        ORKFitnessStep *fitnessStep = [[ORKFitnessStep alloc] initWithIdentifier:stepIdentifier];
+        fitnessStep.stepDuration = walkDuration;
+        fitnessStep.title = ORKLocalizedString(@"6MWT_TEST_IN_PROGRESS", nil);
+        fitnessStep.text = ORKLocalizedString(@"6MWT_TEST_IN_PROGRESS_DETAIL", nil);
+        fitnessStep.spokenInstruction = fitnessStep.text;
+        fitnessStep.recorderConfigurations = [self makeWalkingRecorderConfigurationsWithOptions:options];
+        fitnessStep.shouldContinueOnFinish = YES;
+        fitnessStep.optional = NO;
+        fitnessStep.shouldStartTimerAutomatically = YES;
+        fitnessStep.shouldVibrateOnStart = YES;
+        fitnessStep.shouldVibrateOnFinish = YES;
+        fitnessStep.shouldPlaySoundOnStart = YES;
+        fitnessStep.shouldPlaySoundOnFinish = YES;
+        fitnessStep.shouldSpeakRemainingTimeAtHalfway = YES;
+        fitnessStep.shouldSpeakCountDown = YES;
+        return fitnessStep;
+    }]];
 
     if (!(options & ORKPredefinedTaskOptionExcludeConclusion)) {
 
         // Follow Up Question Step
-        ORKFormStep *formStep = [[ORKFormStep alloc] initWithIdentifier:ORKFollowUpQuestions0StepIdentifier];
-        formStep.title = ORKLocalizedString(@"6MWT_QUESTIONS_TITLE", nil);
-        formStep.detailText = ORKLocalizedString(@"6MWT_QUESTIONS_DETAIL", nil);
-        formStep.showsProgress = NO;
-        formStep.formItems = @[
-            [[ORKFormItem alloc] initWithIdentifier:ORKSixMinuteWalkShortnessOfBreathIdentifier
-                                               text:ORKLocalizedString(@"6MWT_QUESTIONS_BREATH", nil)
-                                         detailText:nil
-                                      learnMoreItem:nil
-                                      showsProgress:NO
-                                       answerFormat:[ORKAnswerFormat
-                                                     scaleAnswerFormatWithMaximumValue:10
-                                                     minimumValue:1
-                                                     defaultValue:5
-                                                     step:1
-                                                     vertical:NO
-                                                     maximumValueDescription:ORKLocalizedString(@"6MWT_HIGH_SCORE", nil)
-                                                     minimumValueDescription:ORKLocalizedString(@"6MWT_LOW_SCORE", nil)]
-                                            tagText:nil
-                                           optional:NO],
-
-            [[ORKFormItem alloc] initWithIdentifier:ORKSixMinuteWalkFatigueIdentifier
-                                               text:ORKLocalizedString(@"6MWT_QUESTIONS_FATIGUE", nil)
-                                         detailText:nil
-                                      learnMoreItem:nil
-                                      showsProgress:NO
-                                       answerFormat:[ORKAnswerFormat
-                                                     scaleAnswerFormatWithMaximumValue:10
-                                                     minimumValue:1
-                                                     defaultValue:5
-                                                     step:1
-                                                     vertical:NO
-                                                     maximumValueDescription:ORKLocalizedString(@"6MWT_HIGH_SCORE", nil)
-                                                     minimumValueDescription:ORKLocalizedString(@"6MWT_LOW_SCORE", nil)]
-                                            tagText:nil
-                                           optional:NO]
-        ];
-        ORKStepArrayAddStep(steps, formStep);
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:ORKFollowUpQuestions0StepIdentifier builder:^ORKStep *(NSString *stepIdentifier) {
+            ORKFormStep *formStep = [[ORKFormStep alloc] initWithIdentifier:stepIdentifier];
+            formStep.title = ORKLocalizedString(@"6MWT_QUESTIONS_TITLE", nil);
+            formStep.detailText = ORKLocalizedString(@"6MWT_QUESTIONS_DETAIL", nil);
+            formStep.showsProgress = NO;
+            formStep.formItems = @[
+                [[ORKFormItem alloc] initWithIdentifier:ORKSixMinuteWalkShortnessOfBreathIdentifier
+                                                   text:ORKLocalizedString(@"6MWT_QUESTIONS_BREATH", nil)
+                                             detailText:nil
+                                          learnMoreItem:nil
+                                          showsProgress:NO
+                                           answerFormat:[ORKAnswerFormat
+                                                         scaleAnswerFormatWithMaximumValue:10
+                                                         minimumValue:1
+                                                         defaultValue:5
+                                                         step:1
+                                                         vertical:NO
+                                                         maximumValueDescription:ORKLocalizedString(@"6MWT_HIGH_SCORE", nil)
+                                                         minimumValueDescription:ORKLocalizedString(@"6MWT_LOW_SCORE", nil)]
+                                                tagText:nil
+                                               optional:NO],
+
+                [[ORKFormItem alloc] initWithIdentifier:ORKSixMinuteWalkFatigueIdentifier
+                                                   text:ORKLocalizedString(@"6MWT_QUESTIONS_FATIGUE", nil)
+                                             detailText:nil
+                                          learnMoreItem:nil
+                                          showsProgress:NO
+                                           answerFormat:[ORKAnswerFormat
+                                                         scaleAnswerFormatWithMaximumValue:10
+                                                         minimumValue:1
+                                                         defaultValue:5
+                                                         step:1
+                                                         vertical:NO
+                                                         maximumValueDescription:ORKLocalizedString(@"6MWT_HIGH_SCORE", nil)
+                                                         minimumValueDescription:ORKLocalizedString(@"6MWT_LOW_SCORE", nil)]
+                                                tagText:nil
+                                               optional:NO]
+            ];
+            return formStep;
+        }]];
 
         // Completion Step
-        ORKInstructionStep *completionStep = [self makeCompletionStep];
-        ORKStepArrayAddStep(steps, completionStep);
+        [stepTemplates addObject:[self completionStepTemplate]];
     }
 
-    ORKOrderedTask *task = [[ORKOrderedTask alloc] initWithIdentifier:identifier steps:steps];
+    ORKOrderedTask *task = [[ORKOrderedTask alloc] initWithIdentifier:identifier stepTemplates:stepTemplates];
     return task;
 }
 
@@ -1946,11 +1973,11 @@ NSString *const ORKdBHLToneAudiometryStep2Identifier = @"dBHL2.tone.audiometry";
         @throw [NSException exceptionWithName:NSGenericException reason:@"Audio collection cannot be excluded from audio task" userInfo:nil];
     }
 
-    NSMutableArray *steps = [NSMutableArray array];
+    NSMutableArray<ORKStepTemplate *> *stepTemplates = [NSMutableArray array];
     
     if (!(options & ORKPredefinedTaskOptionExcludeInstructions)) {
-        {
-            ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:ORKInstruction0StepIdentifier];
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:ORKInstruction0StepIdentifier builder:^ORKStep *(NSString *stepIdentifier) {
+            ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
             step.title = ORKLocalizedString(@"dBHL_TONE_AUDIOMETRY_INTRO_TITLE", nil);
             step.detailText = ORKLocalizedString(@"dBHL_TONE_AUDIOMETRY_INTRO_TEXT_2", nil);
             step.image = [UIImage imageNamed:@"audiometry" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
@@ -1968,14 +1995,14 @@ NSString *const ORKdBHLToneAudiometryStep2Identifier = @"dBHL2.tone.audiometry";
             item6.useSecondaryColor = YES;
             step.bodyItems = @[item1, item2, item3, item4, item5, item6];
             
-            ORKStepArrayAddStep(steps, step);
-        }
+            return step;
+        }]];
         
     }
     
     if (!(options & ORKPredefinedTaskOptionExcludeInstructions)) {
-        {
-            ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:ORKInstruction1StepIdentifier];
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:ORKInstruction1StepIdentifier builder:^ORKStep *(NSString *stepIdentifier) {
+            ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
             step.title = ORKLocalizedString(@"dBHL_TONE_AUDIOMETRY_TASK_TITLE", nil);
             step.text = ORKLocalizedString(@"dBHL_TONE_AUDIOMETRY_INTRO_TEXT", nil);
             if (UIAccessibilityIsVoiceOverRunning()) {
@@ -1986,63 +2013,62 @@ NSString *const ORKdBHLToneAudiometryStep2Identifier = @"dBHL2.tone.audiometry";
             step.shouldTintImages = YES;
             step.shouldAutomaticallyAdjustImageTintColor = YES;
 
-            ORKStepArrayAddStep(steps, step);
-        }
+            return step;
+        }]];
         
     }
     
-    {
-        ORKEnvironmentSPLMeterStep *step = [[ORKEnvironmentSPLMeterStep alloc] initWithIdentifier:@"splMeter"];
+    [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:@"splMeter" builder:^ORKStep *(NSString *stepIdentifier) {
+        ORKEnvironmentSPLMeterStep *step = [[ORKEnvironmentSPLMeterStep alloc] initWithIdentifier:stepIdentifier];
         step.requiredContiguousSamples = 5;
         step.thresholdValue = 45;
         step.title = ORKLocalizedString(@"ENVIRONMENTSPL_TITLE_2", nil);
         step.text = ORKLocalizedString(@"ENVIRONMENTSPL_INTRO_TEXT_2", nil);
         
-        ORKStepArrayAddStep(steps, step);
-    }
+        return step;
+    }]];
     
-    {
-        ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:ORKInstruction2StepIdentifier];
+    [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:ORKInstruction2StepIdentifier builder:^ORKStep *(NSString *stepIdentifier) {
+        ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
         step.title = ORKLocalizedString(@"dBHL_TONE_AUDIOMETRY_STEP_TITLE_RIGHT_EAR", nil);
         step.shouldTintImages = YES;
         step.shouldAutomaticallyAdjustImageTintColor = YES;
 
-        ORKStepArrayAddStep(steps, step);
-    }
+        return step;
+    }]];
     
-    {
-        ORKdBHLToneAudiometryStep *step = [[ORKdBHLToneAudiometryStep alloc] initWithIdentifier:ORKdBHLToneAudiometryStep1Identifier];
+    [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:ORKdBHLToneAudiometryStep1Identifier builder:^ORKStep *(NSString *stepIdentifier) {
+        ORKdBHLToneAudiometryStep *step = [[ORKdBHLToneAudiometryStep alloc] initWithIdentifier:stepIdentifier];
         step.title = ORKLocalizedString(@"dBHL_TONE_AUDIOMETRY_TASK_TITLE_2", nil);
         step.stepDuration = CGFLOAT_MAX;
         // manually adding the headphone type here for testing purposes within ORKCatalog
         step.headphoneType = ORKHeadphoneTypeIdentifierAirPodsGen1;
         step.earPreference = ORKAudioChannelRight;
-        ORKStepArrayAddStep(steps, step);
-    }
+        return step;
+    }]];
     
-    {
-        ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:ORKInstruction3StepIdentifier];
+    [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:ORKInstruction3StepIdentifier builder:^ORKStep *(NSString *stepIdentifier) {
+        ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
         step.title = ORKLocalizedString(@"dBHL_TONE_AUDIOMETRY_STEP_TITLE_LEFT_EAR", nil);
         step.shouldAutomaticallyAdjustImageTintColor = YES;
-        ORKStepArrayAddStep(steps, step);
-    }
+        return step;
+    }]];
     
-    {
-        ORKdBHLToneAudiometryStep *step = [[ORKdBHLToneAudiometryStep alloc] initWithIdentifier:ORKdBHLToneAudiometryStep2Identifier];
+    [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:ORKdBHLToneAudiometryStep2Identifier builder:^ORKStep *(NSString *stepIdentifier) {
+        ORKdBHLToneAudiometryStep *step = [[ORKdBHLToneAudiometryStep alloc] initWithIdentifier:stepIdentifier];
         step.title = ORKLocalizedString(@"dBHL_TONE_AUDIOMETRY_TASK_TITLE_2", nil);
         step.stepDuration = CGFLOAT_MAX;
         step.earPreference = ORKAudioChannelLeft;
         // manually adding the headphone type here for testing purposes within ORKCatalog
         step.headphoneType = ORKHeadphoneTypeIdentifierAirPodsGen1;
-        ORKStepArrayAddStep(steps, step);
-    }
+        return step;
+    }]];
     
     if (!(options & ORKPredefinedTaskOptionExcludeConclusion)) {
-        ORKInstructionStep *step = [self makeCompletionStep];
-        ORKStepArrayAddStep(steps, step);
+        [stepTemplates addObject:[self completionStepTemplate]];
     }
     
-    ORKNavigableOrderedTask *task = [[ORKNavigableOrderedTask alloc] initWithIdentifier:identifier steps:steps];
+    ORKNavigableOrderedTask *task = [[ORKNavigableOrderedTask alloc] initWithIdentifier:identifier stepTemplates:stepTemplates];
     
     return task;
 }
@@ -2426,7 +2452,7 @@ NSString *const ORKPSATStepIdentifier = @"psat";
                               seriesLength:(NSInteger)seriesLength
                                    options:(ORKPredefinedTaskOption)options {
     
-    NSMutableArray *steps = [NSMutableArray array];
+    NSMutableArray<ORKStepTemplate *> *stepTemplates = [NSMutableArray array];
     NSString *versionTitle = @"";
     NSString *versionDetailText = @"";
     
@@ -2442,8 +2468,8 @@ NSString *const ORKPSATStepIdentifier = @"psat";
     }
     
     if (!(options & ORKPredefinedTaskOptionExcludeInstructions)) {
-        {
-            ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:ORKInstruction0StepIdentifier];
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:ORKInstruction0StepIdentifier builder:^ORKStep *(NSString *stepIdentifier) {
+            ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
             step.title = versionTitle;
             step.detailText = versionDetailText;
             step.text = intendedUseDescription;
@@ -2452,10 +2478,10 @@ NSString *const ORKPSATStepIdentifier = @"psat";
             step.shouldTintImages = YES;
             step.shouldAutomaticallyAdjustImageTintColor = YES;
 
-            ORKStepArrayAddStep(steps, step);
-        }
-        {
-            ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:ORKInstruction1StepIdentifier];
+            return step;
+        }]];
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:ORKInstruction1StepIdentifier builder:^ORKStep *(NSString *stepIdentifier) {
+            ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
             step.title = versionTitle;
             
             NSDateComponentsFormatter *secondsFormatter = [NSDateComponentsFormatter new];
@@ -2469,20 +2495,20 @@ NSString *const ORKPSATStepIdentifier = @"psat";
             step.detailText = ORKLocalizedString(@"PSAT_CALL_TO_ACTION", nil);
             step.shouldAutomaticallyAdjustImageTintColor = YES;
 
-            ORKStepArrayAddStep(steps, step);
-        }
+            return step;
+        }]];
     }
     
-    {
-        ORKCountdownStep *step = [[ORKCountdownStep alloc] initWithIdentifier:ORKCountdownStepIdentifier];
+    [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:ORKCountdownStepIdentifier builder:^ORKStep *(NSString *stepIdentifier) {
+        ORKCountdownStep *step = [[ORKCountdownStep alloc] initWithIdentifier:stepIdentifier];
         step.stepDuration = 5.0;
         step.title = versionTitle;
 
-        ORKStepArrayAddStep(steps, step);
-    }
+        return step;
+    }]];
     
-    {
-        ORKPSATStep *step = [[ORKPSATStep alloc] initWithIdentifier:ORKPSATStepIdentifier];
+    [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:ORKPSATStepIdentifier builder:^ORKStep *(NSString *stepIdentifier) {
+        ORKPSATStep *step = [[ORKPSATStep alloc] initWithIdentifier:stepIdentifier];
         step.title = versionTitle;
         step.text = ORKLocalizedString(@"PSAT_INITIAL_INSTRUCTION", nil);
         step.stepDuration = (seriesLength + 1) * interStimulusInterval;
@@ -2491,16 +2517,14 @@ NSString *const ORKPSATStepIdentifier = @"psat";
         step.stimulusDuration = stimulusDuration;
         step.seriesLength = seriesLength;
         
-        ORKStepArrayAddStep(steps, step);
-    }
+        return step;
+    }]];
     
     if (!(options & ORKPredefinedTaskOptionExcludeConclusion)) {
-        ORKInstructionStep *step = [self makeCompletionStep];
-        
-        ORKStepArrayAddStep(steps, step);
+        [stepTemplates addObject:[self completionStepTemplate]];
     }
     
-    ORKOrderedTask *task = [[ORKOrderedTask alloc] initWithIdentifier:identifier steps:[steps copy]];
+    ORKOrderedTask *task = [[ORKOrderedTask alloc] initWithIdentifier:identifier stepTemplates:stepTemplates];
     
     return task;
 }
@@ -2514,24 +2538,29 @@ NSString *const ORKTremorTestBendArmStepIdentifier = @"tremor.handAtShoulderLeng
 NSString *const ORKTremorTestTouchNoseStepIdentifier = @"tremor.handToNose";
 NSString *const ORKTremorTestTurnWristStepIdentifier = @"tremor.handQueenWave";
 
+static ORKDeviceMotionRecorderConfiguration *ORKTremorDeviceMotionRecorderConfiguration(NSString *identifier) {
+    ORKDeviceMotionRecorderConfiguration *configuration = [[ORKDeviceMotionRecorderConfiguration alloc] initWithIdentifier:identifier frequency:100.0];
+    configuration.analyzesTremor = YES;
+    return configuration;
+}
+
 + (NSString *)stepIdentifier:(NSString *)stepIdentifier withHandIdentifier:(NSString *)handIdentifier {
     return [NSString stringWithFormat:@"%@.%@", stepIdentifier, handIdentifier];
 }
 
-+ (NSMutableArray *)stepsForOneHandTremorTestTaskWithIdentifier:(NSString *)identifier
-                                             activeStepDuration:(NSTimeInterval)activeStepDuration
-                                              activeTaskOptions:(ORKTremorActiveTaskOption)activeTaskOptions
-                                                       lastHand:(BOOL)lastHand
-                                                       leftHand:(BOOL)leftHand
-                                                 handIdentifier:(NSString *)handIdentifier
-                                                introDetailText:(NSString *)detailText
-                                                        options:(ORKPredefinedTaskOption)options {
-    NSMutableArray<ORKStep *> *steps = [NSMutableArray array];
++ (NSMutableArray<ORKStepTemplate *> *)stepTemplatesForOneHandTremorTestTaskWithIdentifier:(NSString *)identifier
+                                                                     activeStepDuration:(NSTimeInterval)activeStepDuration
+                                                                      activeTaskOptions:(ORKTremorActiveTaskOption)activeTaskOptions
+                                                                               lastHand:(BOOL)lastHand
+                                                                               leftHand:(BOOL)leftHand
+                                                                         handIdentifier:(NSString *)handIdentifier
+                                                                        introDetailText:(NSString *)detailText
+                                                                                options:(ORKPredefinedTaskOption)options {
+    NSMutableArray<ORKStepTemplate *> *stepTemplates = [NSMutableArray array];
     NSString *stepFinishedInstruction = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_FINISHED_INSTRUCTION", nil);
     BOOL rightHand = !leftHand && ![handIdentifier isEqualToString:ORKActiveTaskMostAffectedHandIdentifier];
     
-    {
-        NSString *stepIdentifier = [self stepIdentifier:ORKInstruction1StepIdentifier withHandIdentifier:handIdentifier];
+    [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:[self stepIdentifier:ORKInstruction1StepIdentifier withHandIdentifier:handIdentifier] builder:^ORKStep *(NSString *stepIdentifier) {
         ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
         step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
         
@@ -2553,45 +2582,44 @@ NSString *const ORKTremorTestTurnWristStepIdentifier = @"tremor.handQueenWave";
         step.shouldTintImages = YES;
         step.shouldAutomaticallyAdjustImageTintColor = YES;
 
-        ORKStepArrayAddStep(steps, step);
-    }
+        return step;
+    }]];
 
     if (!(activeTaskOptions & ORKTremorActiveTaskOptionExcludeHandInLap)) {
         if (!(options & ORKPredefinedTaskOptionExcludeInstructions)) {
-            NSString *stepIdentifier = [self stepIdentifier:ORKInstruction2StepIdentifier withHandIdentifier:handIdentifier];
-            ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
-            step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
-            step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_IN_LAP_INTRO", nil);
-            step.detailText = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_INTRO_TEXT", nil);
-            step.image = [UIImage imageNamed:@"tremortest3a" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
-            //            TODO: Awaiting newer assets.
-            step.imageContentMode = UIViewContentModeScaleAspectFit;
-            step.auxiliaryImage = [UIImage imageNamed:@"tremortest3b" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
-            if (leftHand) {
-                step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_IN_LAP_INTRO_LEFT", nil);
-                step.image = [step.image ork_flippedImage:UIImageOrientationUpMirrored];
-                step.auxiliaryImage = [step.auxiliaryImage ork_flippedImage:UIImageOrientationUpMirrored];
-            } else if (rightHand) {
-                step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_IN_LAP_INTRO_RIGHT", nil);
-            }
-            step.shouldTintImages = YES;
-            step.shouldAutomaticallyAdjustImageTintColor = YES;
+            [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:[self stepIdentifier:ORKInstruction2StepIdentifier withHandIdentifier:handIdentifier] builder:^ORKStep *(NSString *stepIdentifier) {
+                ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
+                step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
+                step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_IN_LAP_INTRO", nil);
+                step.detailText = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_INTRO_TEXT", nil);
+                step.image = [UIImage imageNamed:@"tremortest3a" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
+                //            TODO: Awaiting newer assets.
+                step.imageContentMode = UIViewContentModeScaleAspectFit;
+                step.auxiliaryImage = [UIImage imageNamed:@"tremortest3b" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
+                if (leftHand) {
+                    step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_IN_LAP_INTRO_LEFT", nil);
+                    step.image = [step.image ork_flippedImage:UIImageOrientationUpMirrored];
+                    step.auxiliaryImage = [step.auxiliaryImage ork_flippedImage:UIImageOrientationUpMirrored];
+                } else if (rightHand) {
+                    step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_IN_LAP_INTRO_RIGHT", nil);
+                }
+                step.shouldTintImages = YES;
+                step.shouldAutomaticallyAdjustImageTintColor = YES;
 
-            ORKStepArrayAddStep(steps, step);
+                return step;
+            }]];
         }
         
-        {
-            NSString *stepIdentifier = [self stepIdentifier:ORKCountdown1StepIdentifier withHandIdentifier:handIdentifier];
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:[self stepIdentifier:ORKCountdown1StepIdentifier withHandIdentifier:handIdentifier] builder:^ORKStep *(NSString *stepIdentifier) {
             ORKCountdownStep *step = [[ORKCountdownStep alloc] initWithIdentifier:stepIdentifier];
             step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
-            ORKStepArrayAddStep(steps, step);
-        }
+            return step;
+        }]];
         
-        {
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:[self stepIdentifier:ORKTremorTestInLapStepIdentifier withHandIdentifier:handIdentifier] builder:^ORKStep *(NSString *stepIdentifier) {
             NSString *titleFormat = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_IN_LAP_INSTRUCTION_%ld", nil);
-            NSString *stepIdentifier = [self stepIdentifier:ORKTremorTestInLapStepIdentifier withHandIdentifier:handIdentifier];
             ORKActiveStep *step = [[ORKActiveStep alloc] initWithIdentifier:stepIdentifier];
-            step.recorderConfigurations = @[[[ORKAccelerometerRecorderConfiguration alloc] initWithIdentifier:@"ac1_acc" frequency:100.0], [[ORKDeviceMotionRecorderConfiguration alloc] initWithIdentifier:@"ac1_motion" frequency:100.0]];
+            step.recorderConfigurations = @[[[ORKAccelerometerRecorderConfiguration alloc] initWithIdentifier:@"ac1_acc" frequency:100.0], ORKTremorDeviceMotionRecorderConfiguration(@"ac1_motion")];
             step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
             step.text = [NSString localizedStringWithFormat:titleFormat, (long)activeStepDuration];
             step.spokenInstruction = step.text;
@@ -2604,46 +2632,45 @@ NSString *const ORKTremorTestTurnWristStepIdentifier = @"tremor.handQueenWave";
             step.shouldContinueOnFinish = NO;
             step.shouldStartTimerAutomatically = YES;
             
-            ORKStepArrayAddStep(steps, step);
-        }
+            return step;
+        }]];
     }
     
     if (!(activeTaskOptions & ORKTremorActiveTaskOptionExcludeHandAtShoulderHeight)) {
         if (!(options & ORKPredefinedTaskOptionExcludeInstructions)) {
-            NSString *stepIdentifier = [self stepIdentifier:ORKInstruction4StepIdentifier withHandIdentifier:handIdentifier];
-            ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
-            step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
-            step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_EXTEND_ARM_INTRO", nil);
-            step.detailText = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_INTRO_TEXT", nil);
-            step.image = [UIImage imageNamed:@"tremortest4a" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
-            //            TODO: Awaiting newer assets.
-            step.imageContentMode = UIViewContentModeScaleAspectFit;
-            step.auxiliaryImage = [UIImage imageNamed:@"tremortest4b" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
-            if (leftHand) {
-                step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_EXTEND_ARM_INTRO_LEFT", nil);
-                step.image = [step.image ork_flippedImage:UIImageOrientationUpMirrored];
-                step.auxiliaryImage = [step.auxiliaryImage ork_flippedImage:UIImageOrientationUpMirrored];
-            } else if (rightHand) {
-                step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_EXTEND_ARM_INTRO_RIGHT", nil);
-            }
-            step.shouldTintImages = YES;
-            step.shouldAutomaticallyAdjustImageTintColor = YES;
+            [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:[self stepIdentifier:ORKInstruction4StepIdentifier withHandIdentifier:handIdentifier] builder:^ORKStep *(NSString *stepIdentifier) {
+                ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
+                step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
+                step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_EXTEND_ARM_INTRO", nil);
+                step.detailText = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_INTRO_TEXT", nil);
+                step.image = [UIImage imageNamed:@"tremortest4a" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
+                //            TODO: Awaiting newer assets.
+                step.imageContentMode = UIViewContentModeScaleAspectFit;
+                step.auxiliaryImage = [UIImage imageNamed:@"tremortest4b" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
+                if (leftHand) {
+                    step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_EXTEND_ARM_INTRO_LEFT", nil);
+                    step.image = [step.image ork_flippedImage:UIImageOrientationUpMirrored];
+                    step.auxiliaryImage = [step.auxiliaryImage ork_flippedImage:UIImageOrientationUpMirrored];
+                } else if (rightHand) {
+                    step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_EXTEND_ARM_INTRO_RIGHT", nil);
+                }
+                step.shouldTintImages = YES;
+                step.shouldAutomaticallyAdjustImageTintColor = YES;
 
-            ORKStepArrayAddStep(steps, step);
+                return step;
+            }]];
         }
         
-        {
-            NSString *stepIdentifier = [self stepIdentifier:ORKCountdown2StepIdentifier withHandIdentifier:handIdentifier];
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:[self stepIdentifier:ORKCountdown2StepIdentifier withHandIdentifier:handIdentifier] builder:^ORKStep *(NSString *stepIdentifier) {
             ORKCountdownStep *step = [[ORKCountdownStep alloc] initWithIdentifier:stepIdentifier];
             step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
-            ORKStepArrayAddStep(steps, step);
-        }
+            return step;
+        }]];
         
-        {
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:[self stepIdentifier:ORKTremorTestExtendArmStepIdentifier withHandIdentifier:handIdentifier] builder:^ORKStep *(NSString *stepIdentifier) {
             NSString *titleFormat = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_EXTEND_ARM_INSTRUCTION_%ld", nil);
-            NSString *stepIdentifier = [self stepIdentifier:ORKTremorTestExtendArmStepIdentifier withHandIdentifier:handIdentifier];
             ORKActiveStep *step = [[ORKActiveStep alloc] initWithIdentifier:stepIdentifier];
-            step.recorderConfigurations = @[[[ORKAccelerometerRecorderConfiguration alloc] initWithIdentifier:@"ac2_acc" frequency:100.0], [[ORKDeviceMotionRecorderConfiguration alloc] initWithIdentifier:@"ac2_motion" frequency:100.0]];
+            step.recorderConfigurations = @[[[ORKAccelerometerRecorderConfiguration alloc] initWithIdentifier:@"ac2_acc" frequency:100.0], ORKTremorDeviceMotionRecorderConfiguration(@"ac2_motion")];
             step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
             step.text = [NSString localizedStringWithFormat:titleFormat, (long)activeStepDuration];
             step.spokenInstruction = step.text;
@@ -2662,45 +2689,44 @@ NSString *const ORKTremorTestTurnWristStepIdentifier = @"tremor.handQueenWave";
             step.shouldContinueOnFinish = NO;
             step.shouldStartTimerAutomatically = YES;
             
-            ORKStepArrayAddStep(steps, step);
-        }
+            return step;
+        }]];
     }
     
     if (!(activeTaskOptions & ORKTremorActiveTaskOptionExcludeHandAtShoulderHeightElbowBent)) {
         if (!(options & ORKPredefinedTaskOptionExcludeInstructions)) {
-            NSString *stepIdentifier = [self stepIdentifier:ORKInstruction5StepIdentifier withHandIdentifier:handIdentifier];
-            ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
-            step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
-            step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_BEND_ARM_INTRO", nil);
-            step.detailText = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_INTRO_TEXT", nil);
-            step.image = [UIImage imageNamed:@"tremortest5a" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
-            step.imageContentMode = UIViewContentModeScaleAspectFit;
-            step.auxiliaryImage = [UIImage imageNamed:@"tremortest5b" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
-            if (leftHand) {
-                step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_BEND_ARM_INTRO_LEFT", nil);
-                step.image = [step.image ork_flippedImage:UIImageOrientationUpMirrored];
-                step.auxiliaryImage = [step.auxiliaryImage ork_flippedImage:UIImageOrientationUpMirrored];
-            } else if (rightHand) {
-                step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_BEND_ARM_INTRO_RIGHT", nil);
-            }
-            step.shouldTintImages = YES;
-            step.shouldAutomaticallyAdjustImageTintColor = YES;
+            [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:[self stepIdentifier:ORKInstruction5StepIdentifier withHandIdentifier:handIdentifier] builder:^ORKStep *(NSString *stepIdentifier) {
+                ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
+                step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
+                step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_BEND_ARM_INTRO", nil);
+                step.detailText = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_INTRO_TEXT", nil);
+                step.image = [UIImage imageNamed:@"tremortest5a" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
+                step.imageContentMode = UIViewContentModeScaleAspectFit;
+                step.auxiliaryImage = [UIImage imageNamed:@"tremortest5b" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
+                if (leftHand) {
+                    step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_BEND_ARM_INTRO_LEFT", nil);
+                    step.image = [step.image ork_flippedImage:UIImageOrientationUpMirrored];
+                    step.auxiliaryImage = [step.auxiliaryImage ork_flippedImage:UIImageOrientationUpMirrored];
+                } else if (rightHand) {
+                    step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_BEND_ARM_INTRO_RIGHT", nil);
+                }
+                step.shouldTintImages = YES;
+                step.shouldAutomaticallyAdjustImageTintColor = YES;
 
-            ORKStepArrayAddStep(steps, step);
+                return step;
+            }]];
         }
         
-        {
-            NSString *stepIdentifier = [self stepIdentifier:ORKCountdown3StepIdentifier withHandIdentifier:handIdentifier];
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:[self stepIdentifier:ORKCountdown3StepIdentifier withHandIdentifier:handIdentifier] builder:^ORKStep *(NSString *stepIdentifier) {
             ORKCountdownStep *step = [[ORKCountdownStep alloc] initWithIdentifier:stepIdentifier];
             step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
-            ORKStepArrayAddStep(steps, step);
-        }
+            return step;
+        }]];
         
-        {
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:[self stepIdentifier:ORKTremorTestBendArmStepIdentifier withHandIdentifier:handIdentifier] builder:^ORKStep *(NSString *stepIdentifier) {
             NSString *titleFormat = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_BEND_ARM_INSTRUCTION_%ld", nil);
-            NSString *stepIdentifier = [self stepIdentifier:ORKTremorTestBendArmStepIdentifier withHandIdentifier:handIdentifier];
             ORKActiveStep *step = [[ORKActiveStep alloc] initWithIdentifier:stepIdentifier];
-            step.recorderConfigurations = @[[[ORKAccelerometerRecorderConfiguration alloc] initWithIdentifier:@"ac3_acc" frequency:100.0], [[ORKDeviceMotionRecorderConfiguration alloc] initWithIdentifier:@"ac3_motion" frequency:100.0]];
+            step.recorderConfigurations = @[[[ORKAccelerometerRecorderConfiguration alloc] initWithIdentifier:@"ac3_acc" frequency:100.0], ORKTremorDeviceMotionRecorderConfiguration(@"ac3_motion")];
             step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
             step.text = [NSString localizedStringWithFormat:titleFormat, (long)activeStepDuration];
             step.spokenInstruction = step.text;
@@ -2713,45 +2739,44 @@ NSString *const ORKTremorTestTurnWristStepIdentifier = @"tremor.handQueenWave";
             step.shouldContinueOnFinish = NO;
             step.shouldStartTimerAutomatically = YES;
             
-            ORKStepArrayAddStep(steps, step);
-        }
+            return step;
+        }]];
     }
     
     if (!(activeTaskOptions & ORKTremorActiveTaskOptionExcludeHandToNose)) {
         if (!(options & ORKPredefinedTaskOptionExcludeInstructions)) {
-            NSString *stepIdentifier = [self stepIdentifier:ORKInstruction6StepIdentifier withHandIdentifier:handIdentifier];
-            ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
-            step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
-            step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_TOUCH_NOSE_INTRO", nil);
-            step.detailText = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_INTRO_TEXT", nil);
-            step.image = [UIImage imageNamed:@"tremortest6a" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
-            step.imageContentMode = UIViewContentModeCenter;
-            step.auxiliaryImage = [UIImage imageNamed:@"tremortest6b" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
-            if (leftHand) {
-                step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_TOUCH_NOSE_INTRO_LEFT", nil);
-                step.image = [step.image ork_flippedImage:UIImageOrientationUpMirrored];
-                step.auxiliaryImage = [step.auxiliaryImage ork_flippedImage:UIImageOrientationUpMirrored];
-            } else if (rightHand) {
-                step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_TOUCH_NOSE_INTRO_RIGHT", nil);
-            }
-            step.shouldTintImages = YES;
-            step.shouldAutomaticallyAdjustImageTintColor = YES;
+            [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:[self stepIdentifier:ORKInstruction6StepIdentifier withHandIdentifier:handIdentifier] builder:^ORKStep *(NSString *stepIdentifier) {
+                ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
+                step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
+                step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_TOUCH_NOSE_INTRO", nil);
+                step.detailText = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_INTRO_TEXT", nil);
+                step.image = [UIImage imageNamed:@"tremortest6a" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
+                step.imageContentMode = UIViewContentModeCenter;
+                step.auxiliaryImage = [UIImage imageNamed:@"tremortest6b" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
+                if (leftHand) {
+                    step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_TOUCH_NOSE_INTRO_LEFT", nil);
+                    step.image = [step.image ork_flippedImage:UIImageOrientationUpMirrored];
+                    step.auxiliaryImage = [step.auxiliaryImage ork_flippedImage:UIImageOrientationUpMirrored];
+                } else if (rightHand) {
+                    step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_TOUCH_NOSE_INTRO_RIGHT", nil);
+                }
+                step.shouldTintImages = YES;
+                step.shouldAutomaticallyAdjustImageTintColor = YES;
 
-            ORKStepArrayAddStep(steps, step);
+                return step;
+            }]];
         }
         
-        {
-            NSString *stepIdentifier = [self stepIdentifier:ORKCountdown4StepIdentifier withHandIdentifier:handIdentifier];
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:[self stepIdentifier:ORKCountdown4StepIdentifier withHandIdentifier:handIdentifier] builder:^ORKStep *(NSString *stepIdentifier) {
             ORKCountdownStep *step = [[ORKCountdownStep alloc] initWithIdentifier:stepIdentifier];
             step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
-            ORKStepArrayAddStep(steps, step);
-        }
+            return step;
+        }]];
         
-        {
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:[self stepIdentifier:ORKTremorTestTouchNoseStepIdentifier withHandIdentifier:handIdentifier] builder:^ORKStep *(NSString *stepIdentifier) {
             NSString *titleFormat = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_TOUCH_NOSE_INSTRUCTION_%ld", nil);
-            NSString *stepIdentifier = [self stepIdentifier:ORKTremorTestTouchNoseStepIdentifier withHandIdentifier:handIdentifier];
             ORKActiveStep *step = [[ORKActiveStep alloc] initWithIdentifier:stepIdentifier];
-            step.recorderConfigurations = @[[[ORKAccelerometerRecorderConfiguration alloc] initWithIdentifier:@"ac4_acc" frequency:100.0], [[ORKDeviceMotionRecorderConfiguration alloc] initWithIdentifier:@"ac4_motion" frequency:100.0]];
+            step.recorderConfigurations = @[[[ORKAccelerometerRecorderConfiguration alloc] initWithIdentifier:@"ac4_acc" frequency:100.0], ORKTremorDeviceMotionRecorderConfiguration(@"ac4_motion")];
             step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
             step.text = [NSString localizedStringWithFormat:titleFormat, (long)activeStepDuration];
             step.spokenInstruction = step.text;
@@ -2764,43 +2789,42 @@ NSString *const ORKTremorTestTurnWristStepIdentifier = @"tremor.handQueenWave";
             step.shouldContinueOnFinish = NO;
             step.shouldStartTimerAutomatically = YES;
             
-            ORKStepArrayAddStep(steps, step);
-        }
+            return step;
+        }]];
     }
     
     if (!(activeTaskOptions & ORKTremorActiveTaskOptionExcludeQueenWave)) {
         if (!(options & ORKPredefinedTaskOptionExcludeInstructions)) {
-            NSString *stepIdentifier = [self stepIdentifier:ORKInstruction7StepIdentifier withHandIdentifier:handIdentifier];
-            ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
-            step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
-            step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_TURN_WRIST_INTRO", nil);
-            step.detailText = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_INTRO_TEXT", nil);
-            step.image = [UIImage imageNamed:@"tremortest7" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
-            step.imageContentMode = UIViewContentModeCenter;
-            if (leftHand) {
-                step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_TURN_WRIST_INTRO_LEFT", nil);
-                step.image = [step.image ork_flippedImage:UIImageOrientationUpMirrored];
-            } else if (rightHand) {
-                step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_TURN_WRIST_INTRO_RIGHT", nil);
-            }
-            step.shouldTintImages = YES;
-            step.shouldAutomaticallyAdjustImageTintColor = YES;
+            [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:[self stepIdentifier:ORKInstruction7StepIdentifier withHandIdentifier:handIdentifier] builder:^ORKStep *(NSString *stepIdentifier) {
+                ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
+                step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
+                step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_TURN_WRIST_INTRO", nil);
+                step.detailText = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_INTRO_TEXT", nil);
+                step.image = [UIImage imageNamed:@"tremortest7" inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:nil];
+                step.imageContentMode = UIViewContentModeCenter;
+                if (leftHand) {
+                    step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_TURN_WRIST_INTRO_LEFT", nil);
+                    step.image = [step.image ork_flippedImage:UIImageOrientationUpMirrored];
+                } else if (rightHand) {
+                    step.text = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_TURN_WRIST_INTRO_RIGHT", nil);
+                }
+                step.shouldTintImages = YES;
+                step.shouldAutomaticallyAdjustImageTintColor = YES;
 
-            ORKStepArrayAddStep(steps, step);
+                return step;
+            }]];
         }
         
-        {
-            NSString *stepIdentifier = [self stepIdentifier:ORKCountdown5StepIdentifier withHandIdentifier:handIdentifier];
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:[self stepIdentifier:ORKCountdown5StepIdentifier withHandIdentifier:handIdentifier] builder:^ORKStep *(NSString *stepIdentifier) {
             ORKCountdownStep *step = [[ORKCountdownStep alloc] initWithIdentifier:stepIdentifier];
             step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
-            ORKStepArrayAddStep(steps, step);
-        }
+            return step;
+        }]];
         
-        {
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:[self stepIdentifier:ORKTremorTestTurnWristStepIdentifier withHandIdentifier:handIdentifier] builder:^ORKStep *(NSString *stepIdentifier) {
             NSString *titleFormat = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_TURN_WRIST_INSTRUCTION_%ld", nil);
-            NSString *stepIdentifier = [self stepIdentifier:ORKTremorTestTurnWristStepIdentifier withHandIdentifier:handIdentifier];
             ORKActiveStep *step = [[ORKActiveStep alloc] initWithIdentifier:stepIdentifier];
-            step.recorderConfigurations = @[[[ORKAccelerometerRecorderConfiguration alloc] initWithIdentifier:@"ac5_acc" frequency:100.0], [[ORKDeviceMotionRecorderConfiguration alloc] initWithIdentifier:@"ac5_motion" frequency:100.0]];
+            step.recorderConfigurations = @[[[ORKAccelerometerRecorderConfiguration alloc] initWithIdentifier:@"ac5_acc" frequency:100.0], ORKTremorDeviceMotionRecorderConfiguration(@"ac5_motion")];
             step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
             step.text = [NSString localizedStringWithFormat:titleFormat, (long)activeStepDuration];
             step.spokenInstruction = step.text;
@@ -2813,21 +2837,27 @@ NSString *const ORKTremorTestTurnWristStepIdentifier = @"tremor.handQueenWave";
             step.shouldContinueOnFinish = NO;
             step.shouldStartTimerAutomatically = YES;
             
-            ORKStepArrayAddStep(steps, step);
-        }
+            return step;
+        }]];
     }
     
     // fix the spoken instruction on the last included step, depending on which hand we're on
-    ORKActiveStep *lastStep = (ORKActiveStep *)[steps lastObject];
+    NSString *finishedSpokenInstruction = nil;
     if (lastHand) {
-        lastStep.finishedSpokenInstruction = ORKLocalizedString(@"TREMOR_TEST_COMPLETED_INSTRUCTION", nil);
+        finishedSpokenInstruction = ORKLocalizedString(@"TREMOR_TEST_COMPLETED_INSTRUCTION", nil);
     } else if (leftHand) {
-        lastStep.finishedSpokenInstruction = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_SWITCH_HANDS_RIGHT_INSTRUCTION", nil);
+        finishedSpokenInstruction = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_SWITCH_HANDS_RIGHT_INSTRUCTION", nil);
     } else {
-        lastStep.finishedSpokenInstruction = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_SWITCH_HANDS_LEFT_INSTRUCTION", nil);
+        finishedSpokenInstruction = ORKLocalizedString(@"TREMOR_TEST_ACTIVE_STEP_SWITCH_HANDS_LEFT_INSTRUCTION", nil);
     }
+    ORKStepTemplate *lastStepTemplate = [stepTemplates lastObject];
+    stepTemplates[stepTemplates.count - 1] = [ORKStepTemplate templateWithIdentifier:lastStepTemplate.identifier builder:^ORKStep *(NSString *stepIdentifier) {
+        ORKActiveStep *lastStep = (ORKActiveStep *)[lastStepTemplate makeStep];
+        lastStep.finishedSpokenInstruction = finishedSpokenInstruction;
+        return lastStep;
+    }];
     
-    return steps;
+    return stepTemplates;
 }
 
 + (ORKNavigableOrderedTask *)tremorTestTaskWithIdentifier:(NSString *)identifier
@@ -2837,15 +2867,15 @@ NSString *const ORKTremorTestTurnWristStepIdentifier = @"tremor.handQueenWave";
                                               handOptions:(ORKPredefinedTaskHandOption)handOptions
                                                   options:(ORKPredefinedTaskOption)options {
     
-    NSMutableArray<__kindof ORKStep *> *steps = [NSMutableArray array];
+    NSMutableArray<ORKStepTemplate *> *stepTemplates = [NSMutableArray array];
     // coin toss for which hand first (in case we're doing both)
     BOOL leftFirstIfDoingBoth = arc4random_uniform(2) == 1;
     BOOL doingBoth = ((handOptions & ORKPredefinedTaskHandOptionLeft) && (handOptions & ORKPredefinedTaskHandOptionRight));
     BOOL firstIsLeft = (leftFirstIfDoingBoth && doingBoth) || (!doingBoth && (handOptions & ORKPredefinedTaskHandOptionLeft));
     
     if (!(options & ORKPredefinedTaskOptionExcludeInstructions)) {
-        {
-            ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:ORKInstruction0StepIdentifier];
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:ORKInstruction0StepIdentifier builder:^ORKStep *(NSString *stepIdentifier) {
+            ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
             step.title = ORKLocalizedString(@"TREMOR_TEST_TITLE", nil);
             step.detailText = intendedUseDescription;
             step.text = ORKLocalizedString(@"TREMOR_TEST_INTRO_1_DETAIL", nil);
@@ -2857,8 +2887,8 @@ NSString *const ORKTremorTestTurnWristStepIdentifier = @"tremor.handQueenWave";
             step.shouldTintImages = YES;
             step.shouldAutomaticallyAdjustImageTintColor = YES;
 
-            ORKStepArrayAddStep(steps, step);
-        }
+            return step;
+        }]];
     }
     
     // Build the string for the detail texts
@@ -2893,19 +2923,21 @@ NSString *const ORKTremorTestTurnWristStepIdentifier = @"tremor.handQueenWave";
 
         ORKAnswerFormat *answerFormat = [ORKAnswerFormat choiceAnswerFormatWithStyle:ORKChoiceAnswerStyleSingleChoice
                                                                          textChoices:@[skipRight, skipLeft, skipNeither]];
-        ORKQuestionStep *step = [ORKQuestionStep questionStepWithIdentifier:ORKActiveTaskSkipHandStepIdentifier
-                                                                      title:ORKLocalizedString(@"TREMOR_TEST_TITLE", nil)
-                                                                   question:detailText
-                                                                     answer:answerFormat];
-        step.optional = NO;
-        
-        ORKStepArrayAddStep(steps, step);
+        [stepTemplates addObject:[ORKStepTemplate templateWithIdentifier:ORKActiveTaskSkipHandStepIdentifier builder:^ORKStep *(NSString *stepIdentifier) {
+            ORKQuestionStep *step = [ORKQuestionStep questionStepWithIdentifier:stepIdentifier
+                                                                          title:ORKLocalizedString(@"TREMOR_TEST_TITLE", nil)
+                                                                       question:detailText
+                                                                         answer:answerFormat];
+            step.optional = NO;
+            
+            return step;
+        }]];
     }
     
     // right or most-affected hand
-    NSArray<__kindof ORKStep *> *rightSteps = nil;
+    NSArray<ORKStepTemplate *> *rightStepTemplates = nil;
     if (handOptions == ORKPredefinedTaskHandOptionUnspecified) {
-        rightSteps = [self stepsForOneHandTremorTestTaskWithIdentifier:identifier
+        rightStepTemplates = [self stepTemplatesForOneHandTremorTestTaskWithIdentifier:identifier
                                                     activeStepDuration:activeStepDuration
                                                      activeTaskOptions:activeTaskOptions
                                                               lastHand:YES
@@ -2914,7 +2946,7 @@ NSString *const ORKTremorTestTurnWristStepIdentifier = @"tremor.handQueenWave";
                                                        introDetailText:detailText
                                                                options:options];
     } else if (handOptions & ORKPredefinedTaskHandOptionRight) {
-        rightSteps = [self stepsForOneHandTremorTestTaskWithIdentifier:identifier
+        rightStepTemplates = [self stepTemplatesForOneHandTremorTestTaskWithIdentifier:identifier
                                                     activeStepDuration:activeStepDuration
                                                      activeTaskOptions:activeTaskOptions
                                                               lastHand:firstIsLeft
@@ -2925,9 +2957,9 @@ NSString *const ORKTremorTestTurnWristStepIdentifier = @"tremor.handQueenWave";
     }
     
     // left hand
-    NSArray<__kindof ORKStep *> *leftSteps = nil;
+    NSArray<ORKStepTemplate *> *leftStepTemplates = nil;
     if (handOptions & ORKPredefinedTaskHandOptionLeft) {
-        leftSteps = [self stepsForOneHandTremorTestTaskWithIdentifier:identifier
+        leftStepTemplates = [self stepTemplatesForOneHandTremorTestTaskWithIdentifier:identifier
                                                    activeStepDuration:activeStepDuration
                                                     activeTaskOptions:activeTaskOptions
                                                              lastHand:!firstIsLeft || !(handOptions & ORKPredefinedTaskHandOptionRight)
@@ -2937,27 +2969,25 @@ NSString *const ORKTremorTestTurnWristStepIdentifier = @"tremor.handQueenWave";
                                                               options:options];
     }
     
-    if (firstIsLeft && leftSteps != nil) {
-        [steps addObjectsFromArray:leftSteps];
+    if (firstIsLeft && leftStepTemplates != nil) {
+        [stepTemplates addObjectsFromArray:leftStepTemplates];
     }
     
-    if (rightSteps != nil) {
-        [steps addObjectsFromArray:rightSteps];
+    if (rightStepTemplates != nil) {
+        [stepTemplates addObjectsFromArray:rightStepTemplates];
     }
     
-    if (!firstIsLeft && leftSteps != nil) {
-        [steps addObjectsFromArray:leftSteps];
+    if (!firstIsLeft && leftStepTemplates != nil) {
+        [stepTemplates addObjectsFromArray:leftStepTemplates];
     }
     
     BOOL hasCompletionStep = NO;
     if (!(options & ORKPredefinedTaskOptionExcludeConclusion)) {
         hasCompletionStep = YES;
-        ORKCompletionStep *step = [self makeCompletionStep];
-        
-        ORKStepArrayAddStep(steps, step);
+        [stepTemplates addObject:[self completionStepTemplate]];
     }
 
-    ORKNavigableOrderedTask *task = [[ORKNavigableOrderedTask alloc] initWithIdentifier:identifier steps:steps];
+    ORKNavigableOrderedTask *task = [[ORKNavigableOrderedTask alloc] initWithIdentifier:identifier stepTemplates:stepTemplates];
     
     if (doingBoth) {
         // Setup rules for skipping all the steps in either the left or right hand if called upon to do so.
@@ -2967,15 +2997,15 @@ NSString *const ORKTremorTestTurnWristStepIdentifier = @"tremor.handQueenWave";
         NSPredicate *predicateLeft = [ORKResultPredicate predicateForChoiceQuestionResultWithResultSelector:resultSelector expectedAnswerValue:ORKActiveTaskLeftHandIdentifier];
         
         // Setup rule for skipping first hand
-        NSString *secondHandIdentifier = firstIsLeft ? [[rightSteps firstObject] identifier] : [[leftSteps firstObject] identifier];
+        NSString *secondHandIdentifier = firstIsLeft ? [[rightStepTemplates firstObject] identifier] : [[leftStepTemplates firstObject] identifier];
         NSPredicate *firstPredicate = firstIsLeft ? predicateLeft : predicateRight;
         ORKStepNavigationRule *skipFirst = [[ORKPredicateStepNavigationRule alloc] initWithResultPredicates:@[firstPredicate]
                                                                                  destinationStepIdentifiers:@[secondHandIdentifier]];
         [task setNavigationRule:skipFirst forTriggerStepIdentifier:ORKActiveTaskSkipHandStepIdentifier];
         
         // Setup rule for skipping the second hand
-        NSString *triggerIdentifier = firstIsLeft ? [[leftSteps lastObject] identifier] : [[rightSteps lastObject] identifier];
-        NSString *conclusionIdentifier = hasCompletionStep ? [[steps lastObject] identifier] : ORKNullStepIdentifier;
+        NSString *triggerIdentifier = firstIsLeft ? [[leftStepTemplates lastObject] identifier] : [[rightStepTemplates lastObject] identifier];
+        NSString *conclusionIdentifier = hasCompletionStep ? [[stepTemplates lastObject] identifier] : ORKNullStepIdentifier;
         NSPredicate *secondPredicate = firstIsLeft ? predicateRight : predicateLeft;
         ORKStepNavigationRule *skipSecond = [[ORKPredicateStepNavigationRule alloc] initWithResultPredicates:@[secondPredicate]
                                                                                   destinationStepIdentifiers:@[conclusionIdentifier]];
@@ -49,6 +49,14 @@ ORK_CLASS_AVAILABLE
  */
 @property (nonatomic, readonly) double frequency;
 
+/**
+ A Boolean value indicating whether the recorder extracts gait features while recording.
+ 
+ When the value is `YES`, the recorder reports an `ORKGaitResult` in addition to its file result
+ when it stops. The default value is `NO`.
+ */
+@property (nonatomic) BOOL extractsGaitFeatures;
+
 /**
  Returns an initialized accelerometer recorder using the specified frequency.
  
@@ -36,7 +36,10 @@
 #import "ORKRecorder_Internal.h"
 
 #import "ORKHelpers_Internal.h"
+#import "ORKClock.h"
 #import "CMAccelerometerData+ORKJSONDictionary.h"
+#import "ORKGaitFeatureExtractor.h"
+#import "ORKGaitResult.h"
 
 @import CoreMotion;
 
@@ -44,6 +47,8 @@
 @interface ORKAccelerometerRecorder () {
     ORKDataLogger *_logger;
     NSError *_recordingError;
+    NSOperationQueue *_updateQueue;
+    ORKGaitFeatureExtractor *_gaitFeatureExtractor;
 }
 
 @property (nonatomic, strong) CMMotionManager *motionManager;
@@ -108,14 +113,24 @@
     
     self.motionManager.accelerometerUpdateInterval = 1.0 / _frequency;
     
-    self.uptime = [NSProcessInfo processInfo].systemUptime;
+    self.uptime = ORKClockSystemUptime();
     
     [self.motionManager stopAccelerometerUpdates];
     
-    [self.motionManager startAccelerometerUpdatesToQueue:[[NSOperationQueue alloc] init] withHandler:^(CMAccelerometerData *data, NSError *error) {
+    // Updates are handled serially so the gait feature extractor sees samples in order.
+    _updateQueue = [[NSOperationQueue alloc] init];
+    _updateQueue.maxConcurrentOperationCount = 1;
+    _gaitFeatureExtractor = self.extractsGaitFeatures ? [[ORKGaitFeatureExtractor alloc] initWithFrequency:_frequency] : nil;
+    ORKGaitFeatureExtractor *gaitFeatureExtractor = _gaitFeatureExtractor;
+    
+    [self.motionManager startAccelerometerUpdatesToQueue:_updateQueue withHandler:^(CMAccelerometerData *data, NSError *error) {
          BOOL success = NO;
          if (data) {
              success = [self->_logger append:[data ork_JSONDictionary] error:&error];
+             [gaitFeatureExtractor appendAccelerationWithTimestamp:data.timestamp
+                                                                 x:data.acceleration.x
+                                                                 y:data.acceleration.y
+                                                                 z:data.acceleration.z];
          }
          if (!success) {
              dispatch_async(dispatch_get_main_queue(), ^{
@@ -132,7 +147,9 @@
 
 - (void)stop {
     [self doStopRecording];
+    [_updateQueue waitUntilAllOperationsAreFinished];
     [_logger finishCurrentLog];
+    [self reportGaitResult];
     
     NSError *error = _recordingError;
     _recordingError = nil;
@@ -146,6 +163,16 @@
     [super stop];
 }
 
+- (void)reportGaitResult {
+    id<ORKRecorderDelegate> localDelegate = self.delegate;
+    if (_gaitFeatureExtractor.sampleCount > 0 && [localDelegate respondsToSelector:@selector(recorder:didCompleteWithResult:)]) {
+        ORKGaitResult *result = [_gaitFeatureExtractor resultWithIdentifier:[self.identifier stringByAppendingString:@".gait"]];
+        result.startDate = self.startDate;
+        [localDelegate recorder:self didCompleteWithResult:result];
+    }
+    _gaitFeatureExtractor = nil;
+}
+
 - (void)doStopRecording {
     if (self.isRecording) {
         [self.motionManager stopAccelerometerUpdates];
@@ -155,7 +182,7 @@
 
 - (void)finishRecordingWithError:(NSError *)error {
     [self doStopRecording];
-    [super finishRecordingWithError:nil];
+    [super finishRecordingWithError:error];
 }
 
 - (void)reset {
@@ -0,0 +1,114 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <ResearchKit/ORKDefines.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The decimation factor that merges every level drained in one call into a single level, so
+ display updates receive at most one level per screen refresh.
+ */
+ORK_EXTERN const NSUInteger ORKAudioLevelMeterDecimationPerDrain;
+
+
+/**
+ Carries audio levels from an audio thread to the user interface.
+ 
+ One producer, typically an audio tap or a recorder callback, writes levels into a lock-free
+ single-producer, single-consumer ring. Writing never allocates, locks or dispatches, so it is
+ safe on real-time threads; if the ring is full the level is dropped and counted.
+ 
+ One consumer, typically the main thread, drains the ring. With display updates started, the
+ ring is drained once per screen refresh and the handler receives the levels gathered since
+ the previous refresh, merged by taking the maximum of each run of `decimationFactor` levels.
+ With `ORKAudioLevelMeterDecimationPerDrain` the handler receives one level per refresh, however
+ many buffers the producer wrote.
+ */
+@interface ORKAudioLevelMeter : NSObject
+
+/// Creates a meter with a ring of 1024 levels, decimated to one level per drain.
+- (instancetype)init;
+
+/// The capacity is rounded up to a power of two. Pass 1 for `decimationFactor` to keep every level.
+- (instancetype)initWithCapacity:(NSUInteger)capacity decimationFactor:(NSUInteger)decimationFactor NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readonly) NSUInteger capacity;
+
+@property (nonatomic, readonly) NSUInteger decimationFactor;
+
+#pragma mark Producer
+
+/// Writes a level. Returns `NO` if the ring is full and the level was dropped.
+- (BOOL)writeLevel:(float)level;
+
+/**
+ Writes the smoothed peak of a buffer of samples, mapped from -60 dBFS...0 dBFS to 0...1.
+ 
+ The peak in decibels is low-pass filtered across calls, matching the level graphs of the
+ speech steps.
+ */
+- (BOOL)writePeakLevelOfSamples:(const float *)samples frameCount:(NSUInteger)frameCount;
+
+/// The number of levels written since the meter was created.
+@property (nonatomic, readonly) uint64_t writtenLevelCount;
+
+/// The number of levels dropped because the consumer fell behind.
+@property (nonatomic, readonly) uint64_t droppedLevelCount;
+
+#pragma mark Consumer
+
+/// Copies up to `maximumCount` levels out of the ring and returns how many were copied.
+- (NSUInteger)readLevels:(float *)levels maximumCount:(NSUInteger)maximumCount;
+
+/**
+ Drains the ring and returns its levels decimated by `decimationFactor`. A partial run of
+ levels is kept and merged into the next call. With `ORKAudioLevelMeterDecimationPerDrain`
+ the result holds the maximum of the drained levels, or is empty if there were none.
+ */
+- (NSArray<NSNumber *> *)drainDecimatedLevels;
+
+/**
+ Drains the ring on the main run loop once per display refresh, calling `handler` with the
+ decimated levels whenever there are any.
+ */
+- (void)startDisplayUpdatesWithHandler:(void (^)(NSArray<NSNumber *> *levels))handler;
+
+- (void)stopDisplayUpdates;
+
+/// Discards the levels in the ring. Call from the consumer.
+- (void)discardLevels;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,229 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKAudioLevelMeter.h"
+
+#import "ORKHelpers_Internal.h"
+
+@import Accelerate;
+@import QuartzCore;
+
+#include <stdatomic.h>
+
+
+typedef struct {
+    // The indices live on separate cache lines so that producer and consumer do not contend.
+    _Alignas(64) _Atomic(uint64_t) writeIndex;
+    _Alignas(64) _Atomic(uint64_t) readIndex;
+    _Alignas(64) _Atomic(uint64_t) droppedCount;
+    uint64_t mask;
+    float levels[];
+} ORKAudioLevelRing;
+
+const NSUInteger ORKAudioLevelMeterDecimationPerDrain = 0;
+
+static const float ORKAudioLevelPeakSmoothing = 0.3;
+
+static BOOL ORKAudioLevelRingWrite(ORKAudioLevelRing *ring, float level) {
+    uint64_t writeIndex = atomic_load_explicit(&ring->writeIndex, memory_order_relaxed);
+    uint64_t readIndex = atomic_load_explicit(&ring->readIndex, memory_order_acquire);
+    if (writeIndex - readIndex > ring->mask) {
+        atomic_fetch_add_explicit(&ring->droppedCount, 1, memory_order_relaxed);
+        return NO;
+    }
+    ring->levels[writeIndex & ring->mask] = level;
+    atomic_store_explicit(&ring->writeIndex, writeIndex + 1, memory_order_release);
+    return YES;
+}
+
+static NSUInteger ORKAudioLevelRingRead(ORKAudioLevelRing *ring, float *levels, NSUInteger maximumCount) {
+    uint64_t readIndex = atomic_load_explicit(&ring->readIndex, memory_order_relaxed);
+    uint64_t writeIndex = atomic_load_explicit(&ring->writeIndex, memory_order_acquire);
+    NSUInteger count = (NSUInteger)MIN(writeIndex - readIndex, (uint64_t)maximumCount);
+    for (NSUInteger index = 0; index < count; index++) {
+        levels[index] = ring->levels[(readIndex + index) & ring->mask];
+    }
+    atomic_store_explicit(&ring->readIndex, readIndex + count, memory_order_release);
+    return count;
+}
+
+
+@interface ORKAudioLevelMeterDisplayLinkTarget : NSObject
+
+@property (nonatomic, weak) ORKAudioLevelMeter *meter;
+
+@end
+
+
+@interface ORKAudioLevelMeter ()
+
+- (void)displayLinkDidFire;
+
+@end
+
+
+@implementation ORKAudioLevelMeterDisplayLinkTarget
+
+- (void)displayLinkDidFire:(CADisplayLink *)displayLink {
+    // The display link retains its target, so it points back at the meter weakly.
+    ORKAudioLevelMeter *meter = self.meter;
+    if (meter) {
+        [meter displayLinkDidFire];
+    } else {
+        [displayLink invalidate];
+    }
+}
+
+@end
+
+
+@implementation ORKAudioLevelMeter {
+    ORKAudioLevelRing *_ring;
+    float _peakPower;
+    float *_drainBuffer;
+    float _pendingMaximum;
+    NSUInteger _pendingCount;
+    CADisplayLink *_displayLink;
+    void (^_displayHandler)(NSArray<NSNumber *> *levels);
+}
+
+- (instancetype)init {
+    return [self initWithCapacity:1024 decimationFactor:ORKAudioLevelMeterDecimationPerDrain];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity decimationFactor:(NSUInteger)decimationFactor {
+    self = [super init];
+    if (self) {
+        NSUInteger roundedCapacity = 1;
+        while (roundedCapacity < capacity) {
+            roundedCapacity <<= 1;
+        }
+        _capacity = roundedCapacity;
+        _decimationFactor = decimationFactor;
+        
+        void *ring = NULL;
+        if (posix_memalign(&ring, 64, sizeof(ORKAudioLevelRing) + roundedCapacity * sizeof(float)) != 0) {
+            return nil;
+        }
+        _ring = ring;
+        atomic_init(&_ring->writeIndex, 0);
+        atomic_init(&_ring->readIndex, 0);
+        atomic_init(&_ring->droppedCount, 0);
+        _ring->mask = roundedCapacity - 1;
+        _drainBuffer = calloc(roundedCapacity, sizeof(float));
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_displayLink invalidate];
+    free(_ring);
+    free(_drainBuffer);
+}
+
+- (BOOL)writeLevel:(float)level {
+    return ORKAudioLevelRingWrite(_ring, level);
+}
+
+- (BOOL)writePeakLevelOfSamples:(const float *)samples frameCount:(NSUInteger)frameCount {
+    float peak = 0;
+    vDSP_maxmgv(samples, 1, &peak, frameCount);
+    float peakPower = (peak == 0) ? -100 : 20 * log10f(peak);
+    _peakPower = ORKAudioLevelPeakSmoothing * peakPower + (1 - ORKAudioLevelPeakSmoothing) * _peakPower;
+    return ORKAudioLevelRingWrite(_ring, MAX(_peakPower / 60.0f, -1) + 1);
+}
+
+- (uint64_t)writtenLevelCount {
+    return atomic_load_explicit(&_ring->writeIndex, memory_order_relaxed);
+}
+
+- (uint64_t)droppedLevelCount {
+    return atomic_load_explicit(&_ring->droppedCount, memory_order_relaxed);
+}
+
+- (NSUInteger)readLevels:(float *)levels maximumCount:(NSUInteger)maximumCount {
+    return ORKAudioLevelRingRead(_ring, levels, maximumCount);
+}
+
+- (NSArray<NSNumber *> *)drainDecimatedLevels {
+    NSUInteger count = ORKAudioLevelRingRead(_ring, _drainBuffer, _capacity);
+    if (count == 0) {
+        return @[];
+    }
+    if (_decimationFactor == ORKAudioLevelMeterDecimationPerDrain) {
+        float maximum = 0;
+        vDSP_maxv(_drainBuffer, 1, &maximum, count);
+        return @[@(maximum)];
+    }
+    NSMutableArray<NSNumber *> *levels = [NSMutableArray arrayWithCapacity:(count + _pendingCount) / _decimationFactor];
+    for (NSUInteger index = 0; index < count; index++) {
+        _pendingMaximum = (_pendingCount == 0) ? _drainBuffer[index] : MAX(_pendingMaximum, _drainBuffer[index]);
+        _pendingCount += 1;
+        if (_pendingCount == _decimationFactor) {
+            [levels addObject:@(_pendingMaximum)];
+            _pendingCount = 0;
+        }
+    }
+    return [levels copy];
+}
+
+- (void)startDisplayUpdatesWithHandler:(void (^)(NSArray<NSNumber *> *))handler {
+    NSParameterAssert(handler);
+    _displayHandler = [handler copy];
+    if (_displayLink) {
+        return;
+    }
+    ORKAudioLevelMeterDisplayLinkTarget *target = [ORKAudioLevelMeterDisplayLinkTarget new];
+    target.meter = self;
+    _displayLink = [CADisplayLink displayLinkWithTarget:target selector:@selector(displayLinkDidFire:)];
+    [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+}
+
+- (void)stopDisplayUpdates {
+    [_displayLink invalidate];
+    _displayLink = nil;
+    _displayHandler = nil;
+}
+
+- (void)displayLinkDidFire {
+    NSArray<NSNumber *> *levels = [self drainDecimatedLevels];
+    if (levels.count > 0 && _displayHandler) {
+        _displayHandler(levels);
+    }
+}
+
+- (void)discardLevels {
+    uint64_t writeIndex = atomic_load_explicit(&_ring->writeIndex, memory_order_acquire);
+    atomic_store_explicit(&_ring->readIndex, writeIndex, memory_order_release);
+    _pendingCount = 0;
+}
+
+@end
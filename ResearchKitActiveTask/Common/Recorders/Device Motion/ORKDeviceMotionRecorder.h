@@ -59,6 +59,22 @@ ORK_CLASS_AVAILABLE
  */
 @property (nonatomic, readonly) double frequency;
 
+/**
+ A Boolean value indicating whether the recorder extracts gait features while recording.
+ 
+ When the value is `YES`, the recorder reports an `ORKGaitResult` in addition to its file result
+ when it stops. The default value is `NO`.
+ */
+@property (nonatomic) BOOL extractsGaitFeatures;
+
+/**
+ A Boolean value indicating whether the recorder estimates tremor features while recording.
+ 
+ When the value is `YES`, the recorder reports an `ORKTremorResult` in addition to its file result
+ when it stops. The default value is `NO`.
+ */
+@property (nonatomic) BOOL analyzesTremor;
+
 /**
  Returns an initialized device motion recorder using the specified frequency.
  
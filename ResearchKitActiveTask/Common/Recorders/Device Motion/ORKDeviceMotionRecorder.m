@@ -36,13 +36,20 @@
 #import "ORKRecorder_Internal.h"
 
 #import "ORKHelpers_Internal.h"
+#import "ORKClock.h"
 #import "CMDeviceMotion+ORKJSONDictionary.h"
+#import "ORKGaitFeatureExtractor.h"
+#import "ORKGaitResult.h"
+#import "ORKTremorAnalyzer.h"
+#import "ORKTremorResult.h"
 
 @import CoreMotion;
 
 
 @interface ORKDeviceMotionRecorder () {
     ORKDataLogger *_logger;
+    ORKGaitFeatureExtractor *_gaitFeatureExtractor;
+    ORKTremorAnalyzer *_tremorAnalyzer;
 }
 
 @property (nonatomic, strong) CMMotionManager *motionManager;
@@ -99,14 +106,25 @@
     self.motionManager = [self createMotionManager];
     self.motionManager.deviceMotionUpdateInterval = 1.0 / _frequency;
     
-    self.uptime = [NSProcessInfo processInfo].systemUptime;
+    self.uptime = ORKClockSystemUptime();
     
     [self.motionManager stopDeviceMotionUpdates];
     
+    _gaitFeatureExtractor = self.extractsGaitFeatures ? [[ORKGaitFeatureExtractor alloc] initWithFrequency:_frequency] : nil;
+    ORKGaitFeatureExtractor *gaitFeatureExtractor = _gaitFeatureExtractor;
+    _tremorAnalyzer = self.analyzesTremor ? [[ORKTremorAnalyzer alloc] initWithFrequency:_frequency] : nil;
+    ORKTremorAnalyzer *tremorAnalyzer = _tremorAnalyzer;
+    
     [self.motionManager startDeviceMotionUpdatesToQueue:[NSOperationQueue mainQueue] withHandler:^(CMDeviceMotion *data, NSError *error) {
          BOOL success = NO;
          if (data) {
              success = [self->_logger append:[data ork_JSONDictionary] error:&error];
+             [gaitFeatureExtractor appendUserAccelerationWithTimestamp:data.timestamp
+                                                          acceleration:(ORKGaitVector){ data.userAcceleration.x, data.userAcceleration.y, data.userAcceleration.z }
+                                                               gravity:(ORKGaitVector){ data.gravity.x, data.gravity.y, data.gravity.z }];
+             [tremorAnalyzer appendSampleWithTimestamp:data.timestamp
+                                      userAcceleration:(ORKTremorVector){ data.userAcceleration.x, data.userAcceleration.y, data.userAcceleration.z }
+                                          rotationRate:(ORKTremorVector){ data.rotationRate.x, data.rotationRate.y, data.rotationRate.z }];
              id delegate = self.delegate;
              if ([delegate respondsToSelector:@selector(deviceMotionRecorderDidUpdateWithMotion:)]) {
                  [delegate deviceMotionRecorderDidUpdateWithMotion:data];
@@ -127,6 +145,8 @@
 - (void)stop {
     [self doStopRecording];
     [_logger finishCurrentLog];
+    [self reportGaitResult];
+    [self reportTremorResult];
     
     NSError *error = nil;
     __block NSURL *fileUrl = nil;
@@ -139,6 +159,26 @@
     [super stop];
 }
 
+- (void)reportGaitResult {
+    id<ORKRecorderDelegate> localDelegate = self.delegate;
+    if (_gaitFeatureExtractor.sampleCount > 0 && [localDelegate respondsToSelector:@selector(recorder:didCompleteWithResult:)]) {
+        ORKGaitResult *result = [_gaitFeatureExtractor resultWithIdentifier:[self.identifier stringByAppendingString:@".gait"]];
+        result.startDate = self.startDate;
+        [localDelegate recorder:self didCompleteWithResult:result];
+    }
+    _gaitFeatureExtractor = nil;
+}
+
+- (void)reportTremorResult {
+    id<ORKRecorderDelegate> localDelegate = self.delegate;
+    if (_tremorAnalyzer.sampleCount > 0 && [localDelegate respondsToSelector:@selector(recorder:didCompleteWithResult:)]) {
+        ORKTremorResult *result = [_tremorAnalyzer resultWithIdentifier:[self.identifier stringByAppendingString:@".tremor"]];
+        result.startDate = self.startDate;
+        [localDelegate recorder:self didCompleteWithResult:result];
+    }
+    _tremorAnalyzer = nil;
+}
+
 - (void)doStopRecording {
     if (self.isRecording) {
         [self.motionManager stopDeviceMotionUpdates];
@@ -186,16 +226,19 @@
 #pragma clang diagnostic pop
 
 - (ORKRecorder *)recorderForStep:(ORKStep *)step outputDirectory:(NSURL *)outputDirectory {
-    return [[ORKDeviceMotionRecorder alloc] initWithIdentifier:self.identifier
-                                                     frequency:self.frequency
-                                                          step:step
-                                               outputDirectory:outputDirectory];
+    ORKDeviceMotionRecorder *recorder = [[ORKDeviceMotionRecorder alloc] initWithIdentifier:self.identifier
+                                                                                  frequency:self.frequency
+                                                                                       step:step
+                                                                            outputDirectory:outputDirectory];
+    recorder.analyzesTremor = self.analyzesTremor;
+    return recorder;
 }
 
 - (instancetype)initWithCoder:(NSCoder *)aDecoder {
     self = [super initWithCoder:aDecoder];
     if (self) {
         ORK_DECODE_DOUBLE(aDecoder, frequency);
+        ORK_DECODE_BOOL(aDecoder, analyzesTremor);
     }
     return self;
 }
@@ -203,6 +246,7 @@
 - (void)encodeWithCoder:(NSCoder *)aCoder {
     [super encodeWithCoder:aCoder];
     ORK_ENCODE_DOUBLE(aCoder, frequency);
+    ORK_ENCODE_BOOL(aCoder, analyzesTremor);
 }
 
 + (BOOL)supportsSecureCoding {
@@ -214,7 +258,8 @@
     
     __typeof(self) castObject = object;
     return (isParentSame &&
-            (self.frequency == castObject.frequency));
+            (self.frequency == castObject.frequency) &&
+            (self.analyzesTremor == castObject.analyzesTremor));
 }
 
 - (ORKPermissionMask)requestedPermissionMask {
@@ -0,0 +1,165 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <CoreLocation/CoreLocation.h>
+#import <ResearchKit/ORKDefines.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ORKWalkingDistanceResult;
+
+/**
+ The `ORKWalkingDistanceEstimator` class estimates the distance walked from a stream of locations and
+ pedometer step counts.
+ 
+ Locations less accurate than `maximumHorizontalAccuracy` are discarded. The rest are smoothed with
+ a constant-velocity Kalman filter, and the distance grows with the filtered speed. While the
+ pedometer reports no steps, the user is taken to be standing still and no distance is added, so
+ location noise does not accumulate.
+ 
+ When no accurate location arrives for longer than `maximumLocationInterval`, the distance walked
+ in the gap is the number of steps taken times the step length. The step length is calibrated
+ against the filtered distance while locations are available. Before enough steps have been
+ calibrated, it is derived from the pedometer's own distance estimate, if any. Without a pedometer,
+ a gap is bridged by the straight line between the locations on either side.
+ 
+ Each sample takes constant time, and memory use does not grow with the length of the recording,
+ so the estimate can be read at any time while recording. The estimator is not thread-safe;
+ samples must be appended and the estimate read from one queue at a time.
+ */
+ORK_CLASS_AVAILABLE
+@interface ORKWalkingDistanceEstimator : NSObject
+
+/**
+ The largest horizontal accuracy, in meters, of the locations that are used. The default value
+ is 20 meters.
+ */
+@property (nonatomic) CLLocationAccuracy maximumHorizontalAccuracy;
+
+/**
+ The longest interval between accurate locations, in seconds, that is not treated as a gap. The
+ default value is 5 seconds.
+ */
+@property (nonatomic) NSTimeInterval maximumLocationInterval;
+
+/**
+ The estimated distance walked so far, in meters, including the distance walked since the last
+ accurate location.
+ */
+@property (nonatomic, readonly) CLLocationDistance distance;
+
+/**
+ The current pace, in seconds per meter, or 0 if the user is not walking.
+ 
+ The pace is derived from the filtered speed, averaged over about ten seconds, or from the step
+ cadence during a gap.
+ */
+@property (nonatomic, readonly) double pace;
+
+/**
+ The average pace so far, in seconds per meter, or 0 if no distance was walked.
+ */
+@property (nonatomic, readonly) double averagePace;
+
+/**
+ The fraction of the time so far during which no accurate location was available, from 0 to 1.
+ */
+@property (nonatomic, readonly) double locationGapFraction;
+
+/**
+ The step length, in meters, used to bridge gaps.
+ */
+@property (nonatomic, readonly) double stepLength;
+
+/**
+ The latest cumulative step count reported by the pedometer.
+ */
+@property (nonatomic, readonly) NSInteger numberOfSteps;
+
+/**
+ The time between the first and the latest sample, in seconds.
+ */
+@property (nonatomic, readonly) NSTimeInterval duration;
+
+/**
+ The number of locations used, and the number discarded as inaccurate or out of order.
+ */
+@property (nonatomic, readonly) NSUInteger acceptedLocationCount;
+@property (nonatomic, readonly) NSUInteger rejectedLocationCount;
+
+/**
+ Appends a location. Locations must be appended in the order of their timestamps.
+ */
+- (void)appendLocation:(CLLocation *)location;
+
+/**
+ Appends a pedometer update.
+ 
+ @param numberOfSteps   The number of steps taken since recording started.
+ @param distance        The distance walked since recording started, as estimated by the pedometer,
+                            in meters, or a negative value if the pedometer has no estimate.
+ @param date            The end date of the pedometer update.
+ */
+- (void)appendPedometerStepCount:(NSInteger)numberOfSteps distance:(double)distance date:(NSDate *)date;
+
+/**
+ Feeds the entries of JSON logs written by a location recorder and a pedometer recorder through the
+ estimator, in the order of their timestamps. Compressed location logs are supported.
+ 
+ @param locationURL     The URL of the location log, or nil.
+ @param pedometerURL    The URL of the pedometer log, or nil.
+ @param error           On failure, the error that occurred.
+ 
+ @return `YES` if the logs were replayed; otherwise, `NO`.
+ */
+- (BOOL)replayLocationLogAtURL:(nullable NSURL *)locationURL
+             pedometerLogAtURL:(nullable NSURL *)pedometerURL
+                         error:(NSError * _Nullable *)error;
+
+/**
+ Discards all accumulated state.
+ */
+- (void)reset;
+
+/**
+ Returns a result summarizing the estimate so far.
+ 
+ @param identifier  The identifier of the result.
+ 
+ @return A walking distance result.
+ */
+- (ORKWalkingDistanceResult *)resultWithIdentifier:(NSString *)identifier;
+
+@end
+
+NS_ASSUME_NONNULL_END
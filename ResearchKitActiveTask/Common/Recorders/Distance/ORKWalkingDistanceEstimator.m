@@ -0,0 +1,439 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKWalkingDistanceEstimator.h"
+
+#import "ORKWalkingDistanceResult.h"
+#import "ORKTrajectoryEncoder.h"
+
+#import "ORKHelpers_Internal.h"
+
+
+static const double ORKWalkingMetersPerDegree = 6371008.8 * M_PI / 180.0;
+
+// The spectral density of the acceleration allowed by the Kalman filter, in m²/s³. Walking speed
+// changes slowly, so a small value smooths away most of the location noise.
+static const double ORKWalkingAccelerationNoiseDensity = 0.05;
+static const double ORKWalkingInitialSpeedVariance = 4.0;
+static const NSTimeInterval ORKWalkingPaceTimeConstant = 10.0;
+static const double ORKWalkingMinimumSpeed = 0.1;
+
+static const double ORKWalkingDefaultStepLength = 0.7;
+static const double ORKWalkingMinimumCalibrationSteps = 20;
+
+typedef struct {
+    NSTimeInterval date;
+    double numberOfSteps;
+} ORKWalkingPedometerSample;
+
+
+@implementation ORKWalkingDistanceEstimator {
+    BOOL _hasStart;
+    NSTimeInterval _startTime;
+    NSTimeInterval _latestTime;
+    
+    // Kalman filter state, in meters east and north of the first location. Both axes share one
+    // covariance, because their noise is the same.
+    BOOL _hasOrigin;
+    CLLocationCoordinate2D _origin;
+    BOOL _hasLocation;
+    NSTimeInterval _lastLocationTime;
+    double _positionX;
+    double _positionY;
+    double _velocityX;
+    double _velocityY;
+    double _positionVariance;
+    double _positionVelocityCovariance;
+    double _velocityVariance;
+    double _smoothedSpeed;
+    
+    // The two latest pedometer updates.
+    ORKWalkingPedometerSample _pedometerSamples[2];
+    NSUInteger _pedometerSampleCount;
+    double _pedometerDistance;
+    double _stepsAtLastLocation;
+    
+    double _committedDistance;
+    double _calibrationDistance;
+    double _calibrationSteps;
+    NSTimeInterval _gapDuration;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _maximumHorizontalAccuracy = 20.0;
+        _maximumLocationInterval = 5.0;
+        [self reset];
+    }
+    return self;
+}
+
+- (void)reset {
+    _hasStart = NO;
+    _startTime = 0;
+    _latestTime = 0;
+    _hasOrigin = NO;
+    _hasLocation = NO;
+    _lastLocationTime = 0;
+    _positionX = 0;
+    _positionY = 0;
+    _velocityX = 0;
+    _velocityY = 0;
+    _positionVariance = 0;
+    _positionVelocityCovariance = 0;
+    _velocityVariance = 0;
+    _smoothedSpeed = 0;
+    _pedometerSampleCount = 0;
+    _pedometerDistance = -1;
+    _stepsAtLastLocation = 0;
+    _committedDistance = 0;
+    _calibrationDistance = 0;
+    _calibrationSteps = 0;
+    _gapDuration = 0;
+    _acceptedLocationCount = 0;
+    _rejectedLocationCount = 0;
+}
+
+- (void)noteTime:(NSTimeInterval)time {
+    if (!_hasStart) {
+        _hasStart = YES;
+        _startTime = time;
+        _latestTime = time;
+    }
+    _latestTime = MAX(_latestTime, time);
+}
+
+// The cumulative step count at `time`, interpolated between the two latest pedometer updates.
+// Attributing steps through this function keeps the sum of the attributed steps equal to the step
+// count, however the pedometer updates interleave with the locations.
+- (double)stepsAtTime:(NSTimeInterval)time {
+    if (_pedometerSampleCount == 0) {
+        return 0;
+    }
+    const ORKWalkingPedometerSample latest = _pedometerSamples[_pedometerSampleCount - 1];
+    if (_pedometerSampleCount == 1 || time >= latest.date) {
+        return latest.numberOfSteps;
+    }
+    const ORKWalkingPedometerSample previous = _pedometerSamples[0];
+    if (time <= previous.date) {
+        return previous.numberOfSteps;
+    }
+    return previous.numberOfSteps + ((latest.numberOfSteps - previous.numberOfSteps) * (time - previous.date) / (latest.date - previous.date));
+}
+
+- (double)stepLength {
+    if (_calibrationSteps >= ORKWalkingMinimumCalibrationSteps && _calibrationDistance > 0) {
+        return _calibrationDistance / _calibrationSteps;
+    }
+    const double steps = _pedometerSampleCount > 0 ? _pedometerSamples[_pedometerSampleCount - 1].numberOfSteps : 0;
+    if (_pedometerDistance > 0 && steps > 0) {
+        return _pedometerDistance / steps;
+    }
+    return ORKWalkingDefaultStepLength;
+}
+
+- (NSInteger)numberOfSteps {
+    return _pedometerSampleCount > 0 ? (NSInteger)_pedometerSamples[_pedometerSampleCount - 1].numberOfSteps : 0;
+}
+
+- (BOOL)isInGap {
+    return !_hasLocation || (_latestTime - _lastLocationTime > _maximumLocationInterval);
+}
+
+- (void)appendPedometerStepCount:(NSInteger)numberOfSteps distance:(double)distance date:(NSDate *)date {
+    const NSTimeInterval time = date.timeIntervalSinceReferenceDate;
+    [self noteTime:time];
+    if (_pedometerSampleCount == 2) {
+        _pedometerSamples[0] = _pedometerSamples[1];
+        _pedometerSampleCount = 1;
+    }
+    _pedometerSamples[_pedometerSampleCount++] = (ORKWalkingPedometerSample){ time, (double)numberOfSteps };
+    _pedometerDistance = distance;
+}
+
+- (void)startFilterAtX:(double)x y:(double)y variance:(double)variance time:(NSTimeInterval)time steps:(double)steps {
+    _positionX = x;
+    _positionY = y;
+    _velocityX = 0;
+    _velocityY = 0;
+    _positionVariance = variance;
+    _positionVelocityCovariance = 0;
+    _velocityVariance = ORKWalkingInitialSpeedVariance;
+    _smoothedSpeed = 0;
+    _hasLocation = YES;
+    _lastLocationTime = time;
+    _stepsAtLastLocation = steps;
+}
+
+- (void)appendLocation:(CLLocation *)location {
+    const NSTimeInterval time = location.timestamp.timeIntervalSinceReferenceDate;
+    const CLLocationAccuracy accuracy = location.horizontalAccuracy;
+    if (accuracy < 0 || accuracy > _maximumHorizontalAccuracy || (_hasLocation && time <= _lastLocationTime)) {
+        _rejectedLocationCount++;
+        [self noteTime:time];
+        return;
+    }
+    [self noteTime:time];
+    _acceptedLocationCount++;
+    
+    const CLLocationCoordinate2D coordinate = location.coordinate;
+    if (!_hasOrigin) {
+        _hasOrigin = YES;
+        _origin = coordinate;
+    }
+    const double x = (coordinate.longitude - _origin.longitude) * ORKWalkingMetersPerDegree * cos(_origin.latitude * M_PI / 180.0);
+    const double y = (coordinate.latitude - _origin.latitude) * ORKWalkingMetersPerDegree;
+    const double measurementVariance = accuracy * accuracy;
+    const double steps = [self stepsAtTime:time];
+    
+    if (!_hasLocation) {
+        // Steps taken before the first location.
+        if (_pedometerSampleCount > 0) {
+            _committedDistance += steps * self.stepLength;
+        }
+        if (time - _startTime > _maximumLocationInterval) {
+            _gapDuration += time - _startTime;
+        }
+        [self startFilterAtX:x y:y variance:measurementVariance time:time steps:steps];
+        return;
+    }
+    
+    const NSTimeInterval interval = time - _lastLocationTime;
+    if (interval > _maximumLocationInterval) {
+        _gapDuration += interval;
+        if (_pedometerSampleCount > 0) {
+            _committedDistance += (steps - _stepsAtLastLocation) * self.stepLength;
+        } else {
+            _committedDistance += hypot(x - _positionX, y - _positionY);
+        }
+        [self startFilterAtX:x y:y variance:measurementVariance time:time steps:steps];
+        return;
+    }
+    
+    // Predict.
+    const double q = ORKWalkingAccelerationNoiseDensity;
+    const double positionVariance = _positionVariance + (2 * interval * _positionVelocityCovariance) + (interval * interval * _velocityVariance) + (q * interval * interval * interval / 3);
+    const double positionVelocityCovariance = _positionVelocityCovariance + (interval * _velocityVariance) + (q * interval * interval / 2);
+    const double velocityVariance = _velocityVariance + (q * interval);
+    const double predictedX = _positionX + (_velocityX * interval);
+    const double predictedY = _positionY + (_velocityY * interval);
+    
+    // Update.
+    const double innovationVariance = positionVariance + measurementVariance;
+    const double positionGain = positionVariance / innovationVariance;
+    const double velocityGain = positionVelocityCovariance / innovationVariance;
+    const double innovationX = x - predictedX;
+    const double innovationY = y - predictedY;
+    const double previousSpeed = hypot(_velocityX, _velocityY);
+    _positionX = predictedX + (positionGain * innovationX);
+    _positionY = predictedY + (positionGain * innovationY);
+    _velocityX += velocityGain * innovationX;
+    _velocityY += velocityGain * innovationY;
+    _positionVariance = (1 - positionGain) * positionVariance;
+    _positionVelocityCovariance = (1 - positionGain) * positionVelocityCovariance;
+    _velocityVariance = velocityVariance - (velocityGain * positionVelocityCovariance);
+    
+    // The user is standing still if the latest pedometer update, ending shortly before this
+    // location, counted no steps.
+    const BOOL stationary = (_pedometerSampleCount == 2 &&
+                             _pedometerSamples[1].numberOfSteps <= _pedometerSamples[0].numberOfSteps &&
+                             _pedometerSamples[1].date >= time - _maximumLocationInterval);
+    const double speed = hypot(_velocityX, _velocityY);
+    const double distance = stationary ? 0 : 0.5 * (previousSpeed + speed) * interval;
+    if (stationary) {
+        _velocityX = 0;
+        _velocityY = 0;
+    }
+    _smoothedSpeed += ((stationary ? 0 : speed) - _smoothedSpeed) * (1 - exp(-interval / ORKWalkingPaceTimeConstant));
+    
+    _committedDistance += distance;
+    if (_pedometerSampleCount > 0) {
+        _calibrationDistance += distance;
+        _calibrationSteps += steps - _stepsAtLastLocation;
+    }
+    _lastLocationTime = time;
+    _stepsAtLastLocation = steps;
+}
+
+- (CLLocationDistance)distance {
+    double distance = _committedDistance;
+    if (_pedometerSampleCount > 0 && [self isInGap]) {
+        const double steps = _pedometerSamples[_pedometerSampleCount - 1].numberOfSteps - _stepsAtLastLocation;
+        if (steps > 0) {
+            distance += steps * self.stepLength;
+        }
+    }
+    return distance;
+}
+
+- (double)pace {
+    double speed = 0;
+    if (![self isInGap]) {
+        speed = _smoothedSpeed;
+    } else if (_pedometerSampleCount == 2 && _pedometerSamples[1].date > _pedometerSamples[0].date) {
+        const double cadence = (_pedometerSamples[1].numberOfSteps - _pedometerSamples[0].numberOfSteps) / (_pedometerSamples[1].date - _pedometerSamples[0].date);
+        speed = cadence * self.stepLength;
+    }
+    return speed > ORKWalkingMinimumSpeed ? 1.0 / speed : 0;
+}
+
+- (NSTimeInterval)duration {
+    return _hasStart ? _latestTime - _startTime : 0;
+}
+
+- (double)averagePace {
+    const CLLocationDistance distance = self.distance;
+    return distance > 0 ? self.duration / distance : 0;
+}
+
+- (double)locationGapFraction {
+    const NSTimeInterval duration = self.duration;
+    if (duration <= 0) {
+        return 0;
+    }
+    NSTimeInterval gapDuration = _gapDuration;
+    if (!_hasLocation) {
+        gapDuration = duration;
+    } else if ([self isInGap]) {
+        gapDuration += _latestTime - _lastLocationTime;
+    }
+    return gapDuration / duration;
+}
+
+- (ORKWalkingDistanceResult *)resultWithIdentifier:(NSString *)identifier {
+    ORKWalkingDistanceResult *result = [[ORKWalkingDistanceResult alloc] initWithIdentifier:identifier];
+    result.distance = self.distance;
+    result.averagePace = self.averagePace;
+    result.locationGapFraction = self.locationGapFraction;
+    result.stepLength = self.stepLength;
+    result.numberOfSteps = self.numberOfSteps;
+    result.duration = self.duration;
+    return result;
+}
+
+#pragma mark - Replay
+
+static NSArray *ORKWalkingLogItems(NSURL *URL, NSError **error) {
+    NSData *data = [NSData dataWithContentsOfURL:URL options:NSDataReadingMappedIfSafe error:error];
+    if (!data) {
+        return nil;
+    }
+    NSDictionary *log = [NSJSONSerialization JSONObjectWithData:data options:0 error:error];
+    if (!log) {
+        return nil;
+    }
+    NSArray *items = [log isKindOfClass:[NSDictionary class]] ? log[@"items"] : nil;
+    if (![items isKindOfClass:[NSArray class]]) {
+        if (error) {
+            *error = [NSError errorWithDomain:NSCocoaErrorDomain
+                                         code:NSFileReadCorruptFileError
+                                     userInfo:@{NSURLErrorKey: URL}];
+        }
+        return nil;
+    }
+    return items;
+}
+
+static CLLocation *ORKWalkingLocationFromDictionary(NSDictionary *dictionary) {
+    NSDate *timestamp = [dictionary isKindOfClass:[NSDictionary class]] ? ORKDateFromStringISO8601(dictionary[@"timestamp"]) : nil;
+    if (!timestamp) {
+        return nil;
+    }
+    NSDictionary *coordinate = dictionary[@"coordinate"];
+    const BOOL hasCoordinate = [coordinate isKindOfClass:[NSDictionary class]] && dictionary[@"horizontalAccuracy"];
+    return [[CLLocation alloc] initWithCoordinate:hasCoordinate ? CLLocationCoordinate2DMake([coordinate[@"latitude"] doubleValue], [coordinate[@"longitude"] doubleValue]) : kCLLocationCoordinate2DInvalid
+                                         altitude:[dictionary[@"altitude"] doubleValue]
+                               horizontalAccuracy:hasCoordinate ? [dictionary[@"horizontalAccuracy"] doubleValue] : -1
+                                 verticalAccuracy:dictionary[@"verticalAccuracy"] ? [dictionary[@"verticalAccuracy"] doubleValue] : -1
+                                           course:dictionary[@"course"] ? [dictionary[@"course"] doubleValue] : -1
+                                            speed:dictionary[@"speed"] ? [dictionary[@"speed"] doubleValue] : -1
+                                        timestamp:timestamp];
+}
+
+- (BOOL)replayLocationLogAtURL:(NSURL *)locationURL pedometerLogAtURL:(NSURL *)pedometerURL error:(NSError **)error {
+    NSMutableArray<CLLocation *> *locations = [NSMutableArray array];
+    if (locationURL) {
+        NSArray *items = ORKWalkingLogItems(locationURL, error);
+        if (!items) {
+            return NO;
+        }
+#if ORK_FEATURE_CLLOCATIONMANAGER_AUTHORIZATION
+        if ([items.firstObject isKindOfClass:[NSDictionary class]] && items.firstObject[@"trajectory"]) {
+            items = [ORKTrajectoryEncoder locationDictionariesWithRecords:items error:error];
+            if (!items) {
+                return NO;
+            }
+        }
+#endif
+        for (NSDictionary *item in items) {
+            CLLocation *location = ORKWalkingLocationFromDictionary(item);
+            if (location) {
+                [locations addObject:location];
+            }
+        }
+    }
+    
+    NSMutableArray<NSDictionary *> *pedometerItems = [NSMutableArray array];
+    if (pedometerURL) {
+        NSArray *items = ORKWalkingLogItems(pedometerURL, error);
+        if (!items) {
+            return NO;
+        }
+        for (NSDictionary *item in items) {
+            if ([item isKindOfClass:[NSDictionary class]] && ORKDateFromStringISO8601(item[@"endDate"]) && item[@"numberOfSteps"]) {
+                [pedometerItems addObject:item];
+            }
+        }
+    }
+    
+    // Merge the two logs by time, taking pedometer updates first when the times are equal.
+    NSUInteger locationIndex = 0;
+    NSUInteger pedometerIndex = 0;
+    while (locationIndex < locations.count || pedometerIndex < pedometerItems.count) {
+        NSDictionary *pedometerItem = pedometerIndex < pedometerItems.count ? pedometerItems[pedometerIndex] : nil;
+        NSDate *pedometerDate = pedometerItem ? ORKDateFromStringISO8601(pedometerItem[@"endDate"]) : nil;
+        CLLocation *location = locationIndex < locations.count ? locations[locationIndex] : nil;
+        if (pedometerItem && (!location || [pedometerDate compare:location.timestamp] != NSOrderedDescending)) {
+            NSNumber *distance = pedometerItem[@"distance"];
+            [self appendPedometerStepCount:[pedometerItem[@"numberOfSteps"] integerValue]
+                                  distance:distance ? distance.doubleValue : -1
+                                      date:pedometerDate];
+            pedometerIndex++;
+        } else {
+            [self appendLocation:location];
+            locationIndex++;
+        }
+    }
+    return YES;
+}
+
+@end
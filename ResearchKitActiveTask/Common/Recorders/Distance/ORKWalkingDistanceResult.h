@@ -0,0 +1,84 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <ResearchKit/ORKResult.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The `ORKWalkingDistanceResult` class summarizes the distance walked during a step, estimated on the
+ device from location and pedometer data.
+ 
+ A walking distance result is produced alongside the file result of a location recorder when walking
+ distance estimation is enabled on the recorder. Its identifier is the recorder identifier followed
+ by the `.distance` suffix.
+ */
+ORK_CLASS_AVAILABLE
+@interface ORKWalkingDistanceResult : ORKResult
+
+/**
+ The estimated distance walked, in meters.
+ */
+@property (nonatomic, assign) double distance;
+
+/**
+ The average pace over the step, in seconds per meter, or 0 if no distance was walked.
+ */
+@property (nonatomic, assign) double averagePace;
+
+/**
+ The fraction of the step during which no sufficiently accurate location was available, from 0
+ to 1.
+ 
+ The distance walked during these gaps is estimated from the step count.
+ */
+@property (nonatomic, assign) double locationGapFraction;
+
+/**
+ The step length used to estimate the distance walked during gaps, in meters.
+ */
+@property (nonatomic, assign) double stepLength;
+
+/**
+ The number of steps counted by the pedometer.
+ */
+@property (nonatomic, assign) NSInteger numberOfSteps;
+
+/**
+ The duration covered by the location and pedometer data.
+ */
+@property (nonatomic, assign) NSTimeInterval duration;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,107 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKWalkingDistanceResult.h"
+
+#import "ORKResult_Private.h"
+#import "ORKHelpers_Internal.h"
+
+
+@implementation ORKWalkingDistanceResult
+
+- (void)encodeWithCoder:(NSCoder *)aCoder {
+    [super encodeWithCoder:aCoder];
+    ORK_ENCODE_DOUBLE(aCoder, distance);
+    ORK_ENCODE_DOUBLE(aCoder, averagePace);
+    ORK_ENCODE_DOUBLE(aCoder, locationGapFraction);
+    ORK_ENCODE_DOUBLE(aCoder, stepLength);
+    ORK_ENCODE_INTEGER(aCoder, numberOfSteps);
+    ORK_ENCODE_DOUBLE(aCoder, duration);
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder {
+    self = [super initWithCoder:aDecoder];
+    if (self) {
+        ORK_DECODE_DOUBLE(aDecoder, distance);
+        ORK_DECODE_DOUBLE(aDecoder, averagePace);
+        ORK_DECODE_DOUBLE(aDecoder, locationGapFraction);
+        ORK_DECODE_DOUBLE(aDecoder, stepLength);
+        ORK_DECODE_INTEGER(aDecoder, numberOfSteps);
+        ORK_DECODE_DOUBLE(aDecoder, duration);
+    }
+    return self;
+}
+
++ (BOOL)supportsSecureCoding {
+    return YES;
+}
+
+- (BOOL)isEqual:(id)object {
+    BOOL isParentSame = [super isEqual:object];
+    
+    __typeof(self) castObject = object;
+    return (isParentSame &&
+            (self.distance == castObject.distance) &&
+            (self.averagePace == castObject.averagePace) &&
+            (self.locationGapFraction == castObject.locationGapFraction) &&
+            (self.stepLength == castObject.stepLength) &&
+            (self.numberOfSteps == castObject.numberOfSteps) &&
+            (self.duration == castObject.duration));
+}
+
+- (NSUInteger)hash {
+    return super.hash ^ self.numberOfSteps;
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone {
+    ORKWalkingDistanceResult *result = [super copyWithZone:zone];
+    result.distance = self.distance;
+    result.averagePace = self.averagePace;
+    result.locationGapFraction = self.locationGapFraction;
+    result.stepLength = self.stepLength;
+    result.numberOfSteps = self.numberOfSteps;
+    result.duration = self.duration;
+    return result;
+}
+
+- (NSString *)descriptionWithNumberOfPaddingSpaces:(NSUInteger)numberOfPaddingSpaces {
+    return [NSString stringWithFormat:@"%@; distance: %@; averagePace: %@; locationGapFraction: %@; stepLength: %@; steps: %@; duration: %@%@",
+            [self descriptionPrefixWithNumberOfPaddingSpaces:numberOfPaddingSpaces],
+            @(self.distance),
+            @(self.averagePace),
+            @(self.locationGapFraction),
+            @(self.stepLength),
+            @(self.numberOfSteps),
+            @(self.duration),
+            self.descriptionSuffix];
+}
+
+@end
@@ -0,0 +1,147 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <ResearchKit/ORKDefines.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ORKGaitResult;
+
+/**
+ A three-axis acceleration vector, in units of g.
+ */
+typedef struct {
+    double x;
+    double y;
+    double z;
+} ORKGaitVector;
+
+/**
+ The `ORKGaitFeatureExtractor` class computes step count, cadence and gait regularity from a
+ stream of acceleration samples.
+ 
+ Each sample is processed as it arrives using fixed memory: the vertical acceleration is high-pass
+ filtered to remove gravity, smoothed, passed through an adaptive-threshold peak detector
+ and accumulated into autocorrelation sums over a bounded window of lags. The extractor is not
+ thread-safe; samples must be appended from one queue at a time.
+ */
+ORK_CLASS_AVAILABLE
+@interface ORKGaitFeatureExtractor : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Returns an initialized gait feature extractor.
+ 
+ @param frequency   The nominal sampling frequency of the acceleration stream, in hertz (Hz).
+ 
+ @return An initialized gait feature extractor.
+ */
+- (instancetype)initWithFrequency:(double)frequency NS_DESIGNATED_INITIALIZER;
+
+/**
+ The nominal sampling frequency of the acceleration stream, in hertz (Hz).
+ */
+@property (nonatomic, readonly) double frequency;
+
+/**
+ The number of samples appended so far.
+ */
+@property (nonatomic, readonly) NSUInteger sampleCount;
+
+/**
+ The number of steps detected so far.
+ */
+@property (nonatomic, readonly) NSInteger numberOfSteps;
+
+/**
+ Appends a raw accelerometer sample, which includes gravity, in units of g.
+ 
+ The magnitude of the acceleration is used as an estimate of the vertical acceleration.
+ 
+ @param timestamp   The time at which the sample was taken, in seconds.
+ @param x           The acceleration along the x axis.
+ @param y           The acceleration along the y axis.
+ @param z           The acceleration along the z axis.
+ */
+- (void)appendAccelerationWithTimestamp:(NSTimeInterval)timestamp x:(double)x y:(double)y z:(double)z;
+
+/**
+ Appends a device motion sample, in units of g.
+ 
+ The user acceleration is projected onto the gravity vector to obtain the vertical acceleration.
+ 
+ @param timestamp       The time at which the sample was taken, in seconds.
+ @param acceleration    The user acceleration, with gravity removed.
+ @param gravity         The gravity vector.
+ */
+- (void)appendUserAccelerationWithTimestamp:(NSTimeInterval)timestamp
+                               acceleration:(ORKGaitVector)acceleration
+                                    gravity:(ORKGaitVector)gravity;
+
+/**
+ Appends a vertical acceleration sample, in units of g.
+ 
+ @param timestamp               The time at which the sample was taken, in seconds.
+ @param verticalAcceleration    The acceleration along the gravity axis.
+ */
+- (void)appendSampleWithTimestamp:(NSTimeInterval)timestamp verticalAcceleration:(double)verticalAcceleration;
+
+/**
+ Feeds every sample of a JSON log written by an accelerometer or device motion recorder through
+ the extractor.
+ 
+ @param URL     The URL of the log file.
+ @param error   On failure, the error that occurred.
+ 
+ @return `YES` if the log was replayed; otherwise, `NO`.
+ */
+- (BOOL)replayJSONLogAtURL:(NSURL *)URL error:(NSError * _Nullable *)error;
+
+/**
+ Discards all accumulated state.
+ */
+- (void)reset;
+
+/**
+ Returns a result summarizing the gait features extracted so far.
+ 
+ @param identifier  The identifier of the result.
+ 
+ @return A gait result.
+ */
+- (ORKGaitResult *)resultWithIdentifier:(NSString *)identifier;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,272 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKGaitFeatureExtractor.h"
+
+#import "ORKGaitResult.h"
+
+#import "ORKHelpers_Internal.h"
+
+
+static const double GravityCutoffFrequency = 0.3;
+static const double SmoothingCutoffFrequency = 3.0;
+static const double EnergyCutoffFrequency = 0.25;
+static const double PeakThresholdFactor = 0.6;
+static const double MinimumPeakAmplitude = 0.02;
+static const NSTimeInterval MinimumStepInterval = 0.25;
+static const NSTimeInterval MaximumStepInterval = 2.0;
+static const NSTimeInterval MaximumStepPeriod = 1.0;
+static const NSUInteger MaximumLagCount = 512;
+
+static double ORKGaitSmoothingFactor(double cutoffFrequency, double samplingFrequency) {
+    const double dt = 1.0 / samplingFrequency;
+    const double rc = 1.0 / (2.0 * M_PI * cutoffFrequency);
+    return dt / (rc + dt);
+}
+
+static ORKGaitVector ORKGaitVectorFromDictionary(NSDictionary *dictionary) {
+    return (ORKGaitVector){ [dictionary[@"x"] doubleValue], [dictionary[@"y"] doubleValue], [dictionary[@"z"] doubleValue] };
+}
+
+
+@implementation ORKGaitFeatureExtractor {
+    double _gravityFactor;
+    double _smoothingFactor;
+    double _energyFactor;
+    
+    double _gravity;
+    double _filtered;
+    double _energy;
+    
+    double _previousValue;
+    double _previousPreviousValue;
+    NSTimeInterval _previousTimestamp;
+    NSTimeInterval _firstTimestamp;
+    NSTimeInterval _lastPeakTimestamp;
+    
+    double _stepIntervalSum;
+    NSUInteger _stepIntervalCount;
+    
+    // Ring buffer of the last `_maximumLag + 1` filtered values, and the running sums of their
+    // lagged products.
+    NSUInteger _maximumLag;
+    double *_history;
+    double *_lagSums;
+}
+
+- (instancetype)initWithFrequency:(double)frequency {
+    self = [super init];
+    if (self) {
+        _frequency = frequency > 0 ? frequency : 1;
+        _gravityFactor = ORKGaitSmoothingFactor(GravityCutoffFrequency, _frequency);
+        _smoothingFactor = ORKGaitSmoothingFactor(SmoothingCutoffFrequency, _frequency);
+        _energyFactor = ORKGaitSmoothingFactor(EnergyCutoffFrequency, _frequency);
+        _maximumLag = MIN((NSUInteger)lround(2 * MaximumStepPeriod * _frequency), MaximumLagCount);
+        _history = calloc(_maximumLag + 1, sizeof(double));
+        _lagSums = calloc(_maximumLag + 1, sizeof(double));
+        [self reset];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_history);
+    free(_lagSums);
+}
+
+- (void)reset {
+    _sampleCount = 0;
+    _numberOfSteps = 0;
+    _gravity = 0;
+    _filtered = 0;
+    _energy = 0;
+    _previousValue = 0;
+    _previousPreviousValue = 0;
+    _previousTimestamp = 0;
+    _firstTimestamp = 0;
+    _lastPeakTimestamp = -INFINITY;
+    _stepIntervalSum = 0;
+    _stepIntervalCount = 0;
+    memset(_history, 0, (_maximumLag + 1) * sizeof(double));
+    memset(_lagSums, 0, (_maximumLag + 1) * sizeof(double));
+}
+
+- (void)appendAccelerationWithTimestamp:(NSTimeInterval)timestamp x:(double)x y:(double)y z:(double)z {
+    [self appendSampleWithTimestamp:timestamp verticalAcceleration:sqrt((x * x) + (y * y) + (z * z))];
+}
+
+- (void)appendUserAccelerationWithTimestamp:(NSTimeInterval)timestamp
+                               acceleration:(ORKGaitVector)acceleration
+                                    gravity:(ORKGaitVector)gravity {
+    const double gravityMagnitude = sqrt((gravity.x * gravity.x) + (gravity.y * gravity.y) + (gravity.z * gravity.z));
+    double verticalAcceleration = 0;
+    if (gravityMagnitude > 0) {
+        verticalAcceleration = ((acceleration.x * gravity.x) + (acceleration.y * gravity.y) + (acceleration.z * gravity.z)) / gravityMagnitude;
+    }
+    [self appendSampleWithTimestamp:timestamp verticalAcceleration:verticalAcceleration];
+}
+
+- (void)appendSampleWithTimestamp:(NSTimeInterval)timestamp verticalAcceleration:(double)verticalAcceleration {
+    if (_sampleCount == 0) {
+        _gravity = verticalAcceleration;
+        _firstTimestamp = timestamp;
+    }
+    
+    _gravity += _gravityFactor * (verticalAcceleration - _gravity);
+    _filtered += _smoothingFactor * ((verticalAcceleration - _gravity) - _filtered);
+    const double value = _filtered;
+    _energy += _energyFactor * ((value * value) - _energy);
+    
+    const NSUInteger n = _sampleCount;
+    const NSUInteger historyLength = _maximumLag + 1;
+    _history[n % historyLength] = value;
+    const NSUInteger lagCount = MIN(n, _maximumLag);
+    for (NSUInteger lag = 0; lag <= lagCount; lag++) {
+        _lagSums[lag] += value * _history[(n - lag) % historyLength];
+    }
+    
+    // The previous value is a step if it is a local maximum above the adaptive threshold and far
+    // enough from the last step.
+    if (n >= 2) {
+        const double threshold = MAX(PeakThresholdFactor * sqrt(_energy), MinimumPeakAmplitude);
+        const double peak = _previousValue;
+        const NSTimeInterval interval = _previousTimestamp - _lastPeakTimestamp;
+        if (peak > _previousPreviousValue && peak >= value && peak > threshold && interval >= MinimumStepInterval) {
+            if (_numberOfSteps > 0 && interval <= MaximumStepInterval) {
+                _stepIntervalSum += interval;
+                _stepIntervalCount += 1;
+            }
+            _numberOfSteps += 1;
+            _lastPeakTimestamp = _previousTimestamp;
+        }
+    }
+    
+    _previousPreviousValue = _previousValue;
+    _previousValue = value;
+    _previousTimestamp = timestamp;
+    _sampleCount += 1;
+}
+
+- (double)autocorrelationAtLag:(NSUInteger)lag {
+    if (lag >= _sampleCount || _lagSums[0] <= 0) {
+        return 0;
+    }
+    const double variance = _lagSums[0] / _sampleCount;
+    const double covariance = _lagSums[lag] / (_sampleCount - lag);
+    return MAX(-1.0, MIN(1.0, covariance / variance));
+}
+
+- (NSUInteger)dominantLagFrom:(NSUInteger)minimumLag to:(NSUInteger)maximumLag value:(double *)value {
+    NSUInteger dominantLag = 0;
+    double dominantValue = -1.0;
+    maximumLag = MIN(maximumLag, _maximumLag);
+    for (NSUInteger lag = MAX(minimumLag, 1); lag <= maximumLag; lag++) {
+        const double candidate = [self autocorrelationAtLag:lag];
+        if (candidate > dominantValue) {
+            dominantValue = candidate;
+            dominantLag = lag;
+        }
+    }
+    *value = MAX(dominantValue, 0.0);
+    return dominantLag;
+}
+
+- (ORKGaitResult *)resultWithIdentifier:(NSString *)identifier {
+    ORKGaitResult *result = [[ORKGaitResult alloc] initWithIdentifier:identifier];
+    result.numberOfSteps = _numberOfSteps;
+    result.duration = _sampleCount > 0 ? _previousTimestamp - _firstTimestamp : 0;
+    if (_stepIntervalCount > 0) {
+        result.cadence = 60.0 / (_stepIntervalSum / _stepIntervalCount);
+    }
+    
+    // Search for the step period around the mean step interval when steps were detected, so the
+    // stride peak of a fast walk is not mistaken for the step peak.
+    NSTimeInterval minimumStepPeriod = MinimumStepInterval;
+    NSTimeInterval maximumStepPeriod = MaximumStepPeriod;
+    if (_stepIntervalCount > 0) {
+        const NSTimeInterval meanStepInterval = _stepIntervalSum / _stepIntervalCount;
+        minimumStepPeriod = MAX(minimumStepPeriod, 0.75 * meanStepInterval);
+        maximumStepPeriod = MIN(maximumStepPeriod, 1.25 * meanStepInterval);
+    }
+    double stepRegularity = 0;
+    NSUInteger stepLag = [self dominantLagFrom:(NSUInteger)lround(minimumStepPeriod * _frequency)
+                                            to:(NSUInteger)lround(maximumStepPeriod * _frequency)
+                                         value:&stepRegularity];
+    double strideRegularity = 0;
+    if (stepLag > 0) {
+        [self dominantLagFrom:(stepLag * 3) / 2 to:(stepLag * 5) / 2 value:&strideRegularity];
+    }
+    result.stepRegularity = stepRegularity;
+    result.strideRegularity = strideRegularity;
+    result.gaitSymmetry = strideRegularity > 0 ? stepRegularity / strideRegularity : 0;
+    return result;
+}
+
+- (BOOL)replayJSONLogAtURL:(NSURL *)URL error:(NSError **)error {
+    NSData *data = [NSData dataWithContentsOfURL:URL options:NSDataReadingMappedIfSafe error:error];
+    if (!data) {
+        return NO;
+    }
+    NSDictionary *log = [NSJSONSerialization JSONObjectWithData:data options:0 error:error];
+    if (!log) {
+        return NO;
+    }
+    NSArray *items = [log isKindOfClass:[NSDictionary class]] ? log[@"items"] : nil;
+    if (![items isKindOfClass:[NSArray class]]) {
+        if (error) {
+            *error = [NSError errorWithDomain:NSCocoaErrorDomain
+                                         code:NSFileReadCorruptFileError
+                                     userInfo:@{NSURLErrorKey: URL}];
+        }
+        return NO;
+    }
+    
+    for (NSDictionary *item in items) {
+        NSTimeInterval timestamp = [item[@"timestamp"] doubleValue];
+        NSDictionary *userAcceleration = item[@"userAcceleration"];
+        if (userAcceleration) {
+            // Device motion entry
+            NSDictionary *gravity = item[@"gravity"];
+            [self appendUserAccelerationWithTimestamp:timestamp
+                                         acceleration:ORKGaitVectorFromDictionary(userAcceleration)
+                                              gravity:ORKGaitVectorFromDictionary(gravity)];
+        } else {
+            // Accelerometer entry
+            [self appendAccelerationWithTimestamp:timestamp
+                                                x:[item[@"x"] doubleValue]
+                                                y:[item[@"y"] doubleValue]
+                                                z:[item[@"z"] doubleValue]];
+        }
+    }
+    return YES;
+}
+
+@end
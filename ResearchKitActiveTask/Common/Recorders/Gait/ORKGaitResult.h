@@ -0,0 +1,90 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <ResearchKit/ORKResult.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The `ORKGaitResult` class summarizes the gait features extracted while recording motion data
+ during a walking step.
+ 
+ A gait result is produced alongside the file result of an accelerometer or device motion
+ recorder when gait feature extraction is enabled on the recorder. Its identifier is the
+ recorder identifier followed by the `.gait` suffix.
+ */
+ORK_CLASS_AVAILABLE
+@interface ORKGaitResult : ORKResult
+
+/**
+ The number of steps detected in the acceleration signal.
+ */
+@property (nonatomic, assign) NSInteger numberOfSteps;
+
+/**
+ The walking cadence, in steps per minute.
+ 
+ Only intervals between consecutive steps that are shorter than two seconds contribute to the
+ cadence, so pauses do not lower the value.
+ */
+@property (nonatomic, assign) double cadence;
+
+/**
+ The normalized autocorrelation of the acceleration signal at the dominant step period.
+ 
+ Values close to 1 indicate that consecutive steps are very similar.
+ */
+@property (nonatomic, assign) double stepRegularity;
+
+/**
+ The normalized autocorrelation of the acceleration signal at the dominant stride period.
+ 
+ Values close to 1 indicate that consecutive strides are very similar.
+ */
+@property (nonatomic, assign) double strideRegularity;
+
+/**
+ The ratio of step regularity to stride regularity.
+ 
+ Values close to 1 indicate that the left and right steps are symmetric.
+ */
+@property (nonatomic, assign) double gaitSymmetry;
+
+/**
+ The duration of the analyzed signal.
+ */
+@property (nonatomic, assign) NSTimeInterval duration;
+
+@end
+
+NS_ASSUME_NONNULL_END
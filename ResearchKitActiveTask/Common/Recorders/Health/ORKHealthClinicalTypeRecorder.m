@@ -124,6 +124,10 @@
     return _healthClinicalType.identifier;
 }
 
+- (ORKTimelineTimebase)timelineTimebase {
+    return ORKTimelineTimebaseWallClock;
+}
+
 - (void)stop {
     if (!_isRecording) {
         return;
@@ -253,6 +253,10 @@ static const NSInteger _HealthAnchoredQueryLimit = 100;
     return _quantityType.identifier;
 }
 
+- (ORKTimelineTimebase)timelineTimebase {
+    return ORKTimelineTimebaseWallClock;
+}
+
 - (void)stop {
     if (!_isRecording) {
         return;
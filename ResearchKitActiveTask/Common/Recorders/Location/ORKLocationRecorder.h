@@ -36,6 +36,8 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class ORKWalkingDistanceEstimator;
+
 /**
  The `ORKLocationRecorder` class represents a recorder for collecting location data from CoreLocation.
  
@@ -66,6 +68,27 @@ ORK_CLASS_AVAILABLE
  */
 @property (nonatomic, strong, nullable, readonly) CLLocationManager *locationManager;
 
+/**
+ A Boolean value indicating whether the recorder writes compact trajectory records.
+ 
+ See `-[ORKLocationRecorderConfiguration compressesTrajectory]`. The default value is `NO`.
+ */
+@property (nonatomic) BOOL compressesTrajectory;
+
+/**
+ The largest distance, in meters, by which a location left out of a compressed trajectory may
+ deviate from it. The default value is 0.
+ */
+@property (nonatomic) double trajectoryTolerance;
+
+/**
+ The walking distance estimator, if any, to which the recorder appends its locations.
+ 
+ The estimator is reset when the recorder starts, and the recorder reports an
+ `ORKWalkingDistanceResult` from it when it stops.
+ */
+@property (nonatomic, strong, nullable) ORKWalkingDistanceEstimator *walkingDistanceEstimator;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -36,7 +36,13 @@
 
 #import "ORKRecorder_Internal.h"
 
+#import "ORKHelpers_Internal.h"
+#import "ORKClock.h"
+
 #import "CLLocation+ORKJSONDictionary.h"
+#import "ORKTrajectoryEncoder.h"
+#import "ORKWalkingDistanceEstimator.h"
+#import "ORKWalkingDistanceResult.h"
 
 #import <ResearchKit/CLLocationManager+ResearchKit.h>
 
@@ -45,6 +51,7 @@
 
 @interface ORKLocationRecorder () <CLLocationManagerDelegate> {
     ORKDataLogger *_logger;
+    ORKTrajectoryEncoder *_trajectoryEncoder;
     NSError *_recordingError;
     BOOL _started;
 }
@@ -74,6 +81,10 @@
     return @"location";
 }
 
+- (ORKTimelineTimebase)timelineTimebase {
+    return ORKTimelineTimebaseWallClock;
+}
+
 
 // Test Seam - unit tests don't support background updates or pausing.
 - (CLLocationManager *)createLocationManager {
@@ -95,6 +106,11 @@
         }
     }
     
+    if (self.compressesTrajectory && !_trajectoryEncoder) {
+        _trajectoryEncoder = [[ORKTrajectoryEncoder alloc] initWithTolerance:self.trajectoryTolerance];
+    }
+    [_walkingDistanceEstimator reset];
+    
     self.locationManager = [self createLocationManager];
     self.locationManager.delegate = self;
 
@@ -103,7 +119,7 @@
         locationManagerAuthRequestsAllowed = [self.locationManager ork_requestWhenInUseAuthorization];
     }
 
-    self.uptime = [NSProcessInfo processInfo].systemUptime;
+    self.uptime = ORKClockSystemUptime();
     [self.locationManager ork_startUpdatingLocation];
     
     if (locationManagerAuthRequestsAllowed == NO) {
@@ -121,10 +137,19 @@
 
 - (void)stop {
     [self doStopRecording];
-    [_logger finishCurrentLog];
     
     NSError *error = _recordingError;
     _recordingError = nil;
+    if (_trajectoryEncoder) {
+        NSArray *records = [_trajectoryEncoder recordsByFinishing];
+        _trajectoryEncoder = nil;
+        if (!error) {
+            [_logger appendObjects:records error:&error];
+        }
+    }
+    [_logger finishCurrentLog];
+    [self reportWalkingDistanceResult];
+    
     __block NSURL *fileUrl = nil;
     [_logger enumerateLogs:^(NSURL *logFileUrl, BOOL *stop) {
         fileUrl = logFileUrl;
@@ -135,13 +160,30 @@
     [super stop];
 }
 
+- (void)reportWalkingDistanceResult {
+    id<ORKRecorderDelegate> localDelegate = self.delegate;
+    if (_walkingDistanceEstimator.duration > 0 && [localDelegate respondsToSelector:@selector(recorder:didCompleteWithResult:)]) {
+        ORKWalkingDistanceResult *result = [_walkingDistanceEstimator resultWithIdentifier:[self.identifier stringByAppendingString:@".distance"]];
+        result.startDate = self.startDate;
+        [localDelegate recorder:self didCompleteWithResult:result];
+    }
+}
+
 - (void)locationManager:(CLLocationManager *)manager
      didUpdateLocations:(NSArray<CLLocation *> *)locations {
 
     BOOL success = YES;
     NSParameterAssert(locations.count >= 0);
     NSError *error = nil;
-    if (locations) {
+    for (CLLocation *location in locations) {
+        [_walkingDistanceEstimator appendLocation:location];
+    }
+    if (locations && _trajectoryEncoder) {
+        NSArray *records = [_trajectoryEncoder recordsByEncodingLocations:locations];
+        if (records.count > 0) {
+            success = [_logger appendObjects:records error:&error];
+        }
+    } else if (locations) {
         NSMutableArray *dictionaries = [NSMutableArray arrayWithCapacity:locations.count];
         [locations enumerateObjectsUsingBlock:^(CLLocation *obj, NSUInteger idx, BOOL *stop) {
             NSDictionary *d = [obj ork_JSONDictionary];
@@ -171,6 +213,7 @@
     [super reset];
     
     _logger = nil;
+    _trajectoryEncoder = nil;
 }
 
 - (NSString *)mimeType {
@@ -187,14 +230,32 @@
 }
 
 - (ORKRecorder *)recorderForStep:(ORKStep *)step outputDirectory:(NSURL *)outputDirectory {
-    return [[ORKLocationRecorder alloc] initWithIdentifier:self.identifier step:step outputDirectory:outputDirectory];
+    ORKLocationRecorder *recorder = [[ORKLocationRecorder alloc] initWithIdentifier:self.identifier step:step outputDirectory:outputDirectory];
+    recorder.compressesTrajectory = self.compressesTrajectory;
+    recorder.trajectoryTolerance = self.trajectoryTolerance;
+    if (self.estimatesWalkingDistance) {
+        recorder.walkingDistanceEstimator = [ORKWalkingDistanceEstimator new];
+    }
+    return recorder;
 }
 
 - (instancetype)initWithCoder:(NSCoder *)aDecoder {
     self = [super initWithCoder:aDecoder];
+    if (self) {
+        ORK_DECODE_BOOL(aDecoder, compressesTrajectory);
+        ORK_DECODE_DOUBLE(aDecoder, trajectoryTolerance);
+        ORK_DECODE_BOOL(aDecoder, estimatesWalkingDistance);
+    }
     return self;
 }
 
+- (void)encodeWithCoder:(NSCoder *)aCoder {
+    [super encodeWithCoder:aCoder];
+    ORK_ENCODE_BOOL(aCoder, compressesTrajectory);
+    ORK_ENCODE_DOUBLE(aCoder, trajectoryTolerance);
+    ORK_ENCODE_BOOL(aCoder, estimatesWalkingDistance);
+}
+
 + (BOOL)supportsSecureCoding {
     return YES;
 }
@@ -202,7 +263,11 @@
 - (BOOL)isEqual:(id)object {
     BOOL isParentSame = [super isEqual:object];
     
-    return isParentSame;
+    __typeof(self) castObject = object;
+    return (isParentSame &&
+            (self.compressesTrajectory == castObject.compressesTrajectory) &&
+            (self.trajectoryTolerance == castObject.trajectoryTolerance) &&
+            (self.estimatesWalkingDistance == castObject.estimatesWalkingDistance));
 }
 
 - (ORKPermissionMask)requestedPermissionMask {
@@ -0,0 +1,134 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#if ORK_FEATURE_CLLOCATIONMANAGER_AUTHORIZATION
+#import <Foundation/Foundation.h>
+#import <CoreLocation/CoreLocation.h>
+#import <ResearchKit/ORKDefines.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The `ORKTrajectoryEncoder` class converts a stream of locations into compact log records.
+ 
+ The first record is a dictionary describing the encoding. Each location that is kept becomes an
+ array of integers: the time in milliseconds, the latitude and longitude in units of 10^-7 degrees
+ and the altitude in centimeters, each as the difference from the previous record, followed by the
+ horizontal and vertical accuracy in centimeters, the course in hundredths of a degree, the speed in
+ centimeters per second and the floor level. Values that the location does not have are `null`,
+ and trailing `null` values are left out. A record typically takes under a quarter of the space of the
+ dictionary written by `-[CLLocation ork_JSONDictionary]`.
+ 
+ When the tolerance is greater than zero, locations are also simplified as they arrive. A location
+ is discarded while every location since the last kept one lies within the tolerance of the straight
+ line between that location and the newest one, at the time it was recorded. Because the distance
+ is measured at the time of the discarded location, interpolating the kept locations in time
+ recovers any discarded position to within the tolerance. Altitude, accuracy, course and speed are
+ not considered, and are lost for discarded locations.
+ 
+ The encoder is not thread-safe; locations must be encoded from one queue at a time.
+ */
+ORK_CLASS_AVAILABLE
+@interface ORKTrajectoryEncoder : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Returns an initialized trajectory encoder.
+ 
+ @param tolerance   The largest distance, in meters, by which a discarded location may deviate from
+                        the simplified trajectory. Pass 0 to keep every location.
+ 
+ @return An initialized trajectory encoder.
+ */
+- (instancetype)initWithTolerance:(CLLocationDistance)tolerance NS_DESIGNATED_INITIALIZER;
+
+/**
+ The largest distance, in meters, by which a discarded location may deviate from the simplified
+ trajectory.
+ */
+@property (nonatomic, readonly) CLLocationDistance tolerance;
+
+/**
+ The number of locations encoded so far.
+ */
+@property (nonatomic, readonly) NSUInteger locationCount;
+
+/**
+ The number of locations discarded so far. Locations that are still being considered are not
+ counted.
+ */
+@property (nonatomic, readonly) NSUInteger discardedLocationCount;
+
+/**
+ The largest distance, in meters, between a discarded location and the simplified trajectory at the
+ time the location was recorded. This never exceeds `tolerance`.
+ */
+@property (nonatomic, readonly) CLLocationDistance maximumDiscardedError;
+
+/**
+ The mean distance, in meters, between the discarded locations and the simplified trajectory.
+ */
+@property (nonatomic, readonly) CLLocationDistance meanDiscardedError;
+
+/**
+ Returns the records for the locations that can be written so far.
+ 
+ The last location is held back until a later location shows whether it can be discarded, so the
+ result may be empty.
+ */
+- (NSArray *)recordsByEncodingLocations:(NSArray<CLLocation *> *)locations;
+
+/**
+ Returns the records for the locations that were held back, followed by a dictionary summarizing
+ the locations that were discarded. The encoder can be reused afterwards, starting a new trajectory.
+ */
+- (NSArray *)recordsByFinishing;
+
+/**
+ Returns the `ork_JSONDictionary` representation of each location in `records`. Timestamps are
+ restored to the second, and other values to the precision of the encoding.
+ 
+ Returns nil and sets `error` if the records were not written by a trajectory encoder.
+ */
++ (nullable NSArray<NSDictionary *> *)locationDictionariesWithRecords:(NSArray *)records error:(NSError * _Nullable *)error;
+
+/**
+ Returns a JSON log in the format written by `ORKLocationRecorder` without trajectory compression,
+ from the contents of a compressed log.
+ */
++ (nullable NSData *)JSONLogDataWithCompressedLogData:(NSData *)data error:(NSError * _Nullable *)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
+#endif
@@ -0,0 +1,360 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#if ORK_FEATURE_CLLOCATIONMANAGER_AUTHORIZATION
+
+#import "ORKTrajectoryEncoder.h"
+
+#import "ORKErrors.h"
+#import "ORKHelpers_Internal.h"
+
+
+static const NSInteger ORKTrajectoryFormatVersion = 1;
+static const double ORKTrajectoryCoordinateUnitsPerDegree = 1e7;
+static const double ORKTrajectoryTimeUnitsPerSecond = 1e3;
+static const double ORKTrajectoryUnitsPerMeter = 1e2;
+static const double ORKTrajectoryCourseUnitsPerDegree = 1e2;
+static const double ORKTrajectoryMetersPerDegree = 6371008.8 * M_PI / 180.0;
+
+// Bounds the work done for each location, which is proportional to the number of locations being
+// considered for removal.
+static const NSUInteger ORKTrajectoryMaximumWindowLength = 256;
+
+static NSString *const ORKTrajectoryHeaderKey = @"trajectory";
+static NSString *const ORKTrajectorySummaryKey = @"summary";
+
+typedef NS_ENUM(NSUInteger, ORKTrajectoryField) {
+    ORKTrajectoryFieldTime = 0,
+    ORKTrajectoryFieldLatitude,
+    ORKTrajectoryFieldLongitude,
+    ORKTrajectoryFieldHorizontalAccuracy,
+    ORKTrajectoryFieldAltitude,
+    ORKTrajectoryFieldVerticalAccuracy,
+    ORKTrajectoryFieldCourse,
+    ORKTrajectoryFieldSpeed,
+    ORKTrajectoryFieldFloor,
+    ORKTrajectoryFieldCount
+};
+
+typedef struct {
+    NSTimeInterval time;
+    CLLocationDegrees latitude;
+    CLLocationDegrees longitude;
+} ORKTrajectoryPoint;
+
+static ORKTrajectoryPoint ORKTrajectoryPointWithLocation(CLLocation *location) {
+    return (ORKTrajectoryPoint){ location.timestamp.timeIntervalSince1970, location.coordinate.latitude, location.coordinate.longitude };
+}
+
+static double ORKTrajectoryLongitudeDifference(CLLocationDegrees longitude, CLLocationDegrees origin) {
+    double difference = fmod(longitude - origin, 360.0);
+    if (difference > 180.0) {
+        difference -= 360.0;
+    } else if (difference < -180.0) {
+        difference += 360.0;
+    }
+    return difference;
+}
+
+// The distance in meters between `point` and the position on the segment from `start` to `end` at the
+// time of `point`, using an equirectangular projection around `start`.
+static double ORKTrajectorySynchronizedDistance(ORKTrajectoryPoint point, ORKTrajectoryPoint start, ORKTrajectoryPoint end) {
+    const double metersPerDegreeLongitude = ORKTrajectoryMetersPerDegree * cos(start.latitude * M_PI / 180.0);
+    const double pointX = ORKTrajectoryLongitudeDifference(point.longitude, start.longitude) * metersPerDegreeLongitude;
+    const double pointY = (point.latitude - start.latitude) * ORKTrajectoryMetersPerDegree;
+    const double endX = ORKTrajectoryLongitudeDifference(end.longitude, start.longitude) * metersPerDegreeLongitude;
+    const double endY = (end.latitude - start.latitude) * ORKTrajectoryMetersPerDegree;
+    
+    const NSTimeInterval span = end.time - start.time;
+    const double fraction = span > 0 ? MIN(MAX((point.time - start.time) / span, 0.0), 1.0) : 0.0;
+    return hypot(pointX - (fraction * endX), pointY - (fraction * endY));
+}
+
+static int64_t ORKTrajectoryQuantize(double value, double unitsPerValue) {
+    return llround(value * unitsPerValue);
+}
+
+static NSError *ORKTrajectoryMalformedRecordsError(void) {
+    return [NSError errorWithDomain:ORKErrorDomain code:ORKErrorInvalidObject userInfo:@{NSLocalizedFailureReasonErrorKey: @"The trajectory records are malformed."}];
+}
+
+
+@implementation ORKTrajectoryEncoder {
+    BOOL _wroteHeader;
+    int64_t _previousTime;
+    int64_t _previousLatitude;
+    int64_t _previousLongitude;
+    int64_t _previousAltitude;
+    
+    BOOL _hasAnchor;
+    ORKTrajectoryPoint _anchor;
+    ORKTrajectoryPoint _window[ORKTrajectoryMaximumWindowLength];
+    NSUInteger _windowLength;
+    CLLocation *_lastWindowLocation;
+    
+    double _totalDiscardedError;
+}
+
+- (instancetype)initWithTolerance:(CLLocationDistance)tolerance {
+    self = [super init];
+    if (self) {
+        _tolerance = MAX(tolerance, 0);
+    }
+    return self;
+}
+
+- (CLLocationDistance)meanDiscardedError {
+    return _discardedLocationCount > 0 ? _totalDiscardedError / _discardedLocationCount : 0;
+}
+
+- (NSArray *)recordForLocation:(CLLocation *)location {
+    id values[ORKTrajectoryFieldCount];
+    for (NSUInteger field = 0; field < ORKTrajectoryFieldCount; field++) {
+        values[field] = [NSNull null];
+    }
+    
+    // Rounding down keeps the second of the timestamp when it is restored.
+    const int64_t time = (int64_t)floor(location.timestamp.timeIntervalSince1970 * ORKTrajectoryTimeUnitsPerSecond);
+    values[ORKTrajectoryFieldTime] = @(time - _previousTime);
+    _previousTime = time;
+    
+    if (location.horizontalAccuracy >= 0) {
+        const int64_t latitude = ORKTrajectoryQuantize(location.coordinate.latitude, ORKTrajectoryCoordinateUnitsPerDegree);
+        const int64_t longitude = ORKTrajectoryQuantize(location.coordinate.longitude, ORKTrajectoryCoordinateUnitsPerDegree);
+        values[ORKTrajectoryFieldLatitude] = @(latitude - _previousLatitude);
+        values[ORKTrajectoryFieldLongitude] = @(longitude - _previousLongitude);
+        values[ORKTrajectoryFieldHorizontalAccuracy] = @(ORKTrajectoryQuantize(location.horizontalAccuracy, ORKTrajectoryUnitsPerMeter));
+        _previousLatitude = latitude;
+        _previousLongitude = longitude;
+    }
+    if (location.verticalAccuracy >= 0) {
+        const int64_t altitude = ORKTrajectoryQuantize(location.altitude, ORKTrajectoryUnitsPerMeter);
+        values[ORKTrajectoryFieldAltitude] = @(altitude - _previousAltitude);
+        values[ORKTrajectoryFieldVerticalAccuracy] = @(ORKTrajectoryQuantize(location.verticalAccuracy, ORKTrajectoryUnitsPerMeter));
+        _previousAltitude = altitude;
+    }
+    if (location.course >= 0) {
+        values[ORKTrajectoryFieldCourse] = @(ORKTrajectoryQuantize(location.course, ORKTrajectoryCourseUnitsPerDegree));
+    }
+    if (location.speed >= 0) {
+        values[ORKTrajectoryFieldSpeed] = @(ORKTrajectoryQuantize(location.speed, ORKTrajectoryUnitsPerMeter));
+    }
+    if (location.floor) {
+        values[ORKTrajectoryFieldFloor] = @(location.floor.level);
+    }
+    
+    NSUInteger count = ORKTrajectoryFieldCount;
+    while (values[count - 1] == [NSNull null]) {
+        count--;
+    }
+    return [NSArray arrayWithObjects:values count:count];
+}
+
+// Writes the newest location in the window and discards the others, which all lie within the
+// tolerance of the segment ending at it.
+- (void)flushWindowIntoRecords:(NSMutableArray *)records {
+    if (_windowLength == 0) {
+        return;
+    }
+    const ORKTrajectoryPoint end = _window[_windowLength - 1];
+    for (NSUInteger index = 0; index + 1 < _windowLength; index++) {
+        const double error = ORKTrajectorySynchronizedDistance(_window[index], _anchor, end);
+        _maximumDiscardedError = MAX(_maximumDiscardedError, error);
+        _totalDiscardedError += error;
+    }
+    _discardedLocationCount += _windowLength - 1;
+    
+    [records addObject:[self recordForLocation:_lastWindowLocation]];
+    _anchor = end;
+    _windowLength = 0;
+    _lastWindowLocation = nil;
+}
+
+- (BOOL)windowFitsSegmentEndingAtPoint:(ORKTrajectoryPoint)end {
+    if (_windowLength == ORKTrajectoryMaximumWindowLength) {
+        return NO;
+    }
+    for (NSUInteger index = 0; index < _windowLength; index++) {
+        if (ORKTrajectorySynchronizedDistance(_window[index], _anchor, end) > _tolerance) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+- (NSArray *)recordsByEncodingLocations:(NSArray<CLLocation *> *)locations {
+    NSMutableArray *records = [NSMutableArray arrayWithCapacity:locations.count + 1];
+    if (!_wroteHeader) {
+        [records addObject:@{ ORKTrajectoryHeaderKey: @{ @"version": @(ORKTrajectoryFormatVersion),
+                                                         @"tolerance": @(_tolerance) } }];
+        _wroteHeader = YES;
+    }
+    
+    for (CLLocation *location in locations) {
+        _locationCount++;
+        
+        if (_tolerance <= 0 || location.horizontalAccuracy < 0) {
+            // Locations without a position end the simplified segment.
+            [self flushWindowIntoRecords:records];
+            [records addObject:[self recordForLocation:location]];
+            _hasAnchor = NO;
+            continue;
+        }
+        
+        const ORKTrajectoryPoint point = ORKTrajectoryPointWithLocation(location);
+        if (!_hasAnchor) {
+            [records addObject:[self recordForLocation:location]];
+            _anchor = point;
+            _hasAnchor = YES;
+            continue;
+        }
+        if (![self windowFitsSegmentEndingAtPoint:point]) {
+            [self flushWindowIntoRecords:records];
+        }
+        _window[_windowLength++] = point;
+        _lastWindowLocation = location;
+    }
+    return records;
+}
+
+- (NSArray *)recordsByFinishing {
+    NSMutableArray *records = [NSMutableArray array];
+    if (!_wroteHeader) {
+        [records addObjectsFromArray:[self recordsByEncodingLocations:@[]]];
+    }
+    [self flushWindowIntoRecords:records];
+    _hasAnchor = NO;
+    
+    [records addObject:@{ ORKTrajectorySummaryKey: @{ @"locationCount": @(_locationCount),
+                                                      @"discardedLocationCount": @(_discardedLocationCount),
+                                                      @"maximumDiscardedError": @(_maximumDiscardedError),
+                                                      @"meanDiscardedError": @(self.meanDiscardedError) } }];
+    return records;
+}
+
+#pragma mark - Decoding
+
++ (NSArray<NSDictionary *> *)locationDictionariesWithRecords:(NSArray *)records error:(NSError **)error {
+    NSDictionary *header = [records.firstObject isKindOfClass:[NSDictionary class]] ? records.firstObject[ORKTrajectoryHeaderKey] : nil;
+    if (![header isKindOfClass:[NSDictionary class]] || [header[@"version"] integerValue] != ORKTrajectoryFormatVersion) {
+        if (error) {
+            *error = ORKTrajectoryMalformedRecordsError();
+        }
+        return nil;
+    }
+    
+    NSMutableArray<NSDictionary *> *dictionaries = [NSMutableArray arrayWithCapacity:records.count];
+    int64_t time = 0;
+    int64_t latitude = 0;
+    int64_t longitude = 0;
+    int64_t altitude = 0;
+    for (NSUInteger recordIndex = 1; recordIndex < records.count; recordIndex++) {
+        NSArray *record = records[recordIndex];
+        if ([record isKindOfClass:[NSDictionary class]] && ((NSDictionary *)record)[ORKTrajectorySummaryKey]) {
+            continue;
+        }
+        if (![record isKindOfClass:[NSArray class]] || record.count == 0) {
+            if (error) {
+                *error = ORKTrajectoryMalformedRecordsError();
+            }
+            return nil;
+        }
+        
+        NSNumber *values[ORKTrajectoryFieldCount];
+        for (NSUInteger field = 0; field < ORKTrajectoryFieldCount; field++) {
+            id value = field < record.count ? record[field] : nil;
+            if (value && value != [NSNull null] && ![value isKindOfClass:[NSNumber class]]) {
+                if (error) {
+                    *error = ORKTrajectoryMalformedRecordsError();
+                }
+                return nil;
+            }
+            values[field] = (value == [NSNull null]) ? nil : value;
+        }
+        if (!values[ORKTrajectoryFieldTime]) {
+            if (error) {
+                *error = ORKTrajectoryMalformedRecordsError();
+            }
+            return nil;
+        }
+        
+        time += values[ORKTrajectoryFieldTime].longLongValue;
+        NSDate *timestamp = [NSDate dateWithTimeIntervalSince1970:time / ORKTrajectoryTimeUnitsPerSecond];
+        NSMutableDictionary *dictionary = [@{ @"timestamp": ORKStringFromDateISO8601(timestamp) } mutableCopy];
+        
+        if (values[ORKTrajectoryFieldLatitude] && values[ORKTrajectoryFieldLongitude] && values[ORKTrajectoryFieldHorizontalAccuracy]) {
+            latitude += values[ORKTrajectoryFieldLatitude].longLongValue;
+            longitude += values[ORKTrajectoryFieldLongitude].longLongValue;
+            dictionary[@"coordinate"] = @{ @"latitude": [NSDecimalNumber numberWithDouble:latitude / ORKTrajectoryCoordinateUnitsPerDegree],
+                                           @"longitude": [NSDecimalNumber numberWithDouble:longitude / ORKTrajectoryCoordinateUnitsPerDegree] };
+            dictionary[@"horizontalAccuracy"] = [NSDecimalNumber numberWithDouble:values[ORKTrajectoryFieldHorizontalAccuracy].doubleValue / ORKTrajectoryUnitsPerMeter];
+        }
+        if (values[ORKTrajectoryFieldAltitude] && values[ORKTrajectoryFieldVerticalAccuracy]) {
+            altitude += values[ORKTrajectoryFieldAltitude].longLongValue;
+            dictionary[@"altitude"] = [NSDecimalNumber numberWithDouble:altitude / ORKTrajectoryUnitsPerMeter];
+            dictionary[@"verticalAccuracy"] = [NSDecimalNumber numberWithDouble:values[ORKTrajectoryFieldVerticalAccuracy].doubleValue / ORKTrajectoryUnitsPerMeter];
+        }
+        if (values[ORKTrajectoryFieldCourse]) {
+            dictionary[@"course"] = [NSDecimalNumber numberWithDouble:values[ORKTrajectoryFieldCourse].doubleValue / ORKTrajectoryCourseUnitsPerDegree];
+        }
+        if (values[ORKTrajectoryFieldSpeed]) {
+            dictionary[@"speed"] = [NSDecimalNumber numberWithDouble:values[ORKTrajectoryFieldSpeed].doubleValue / ORKTrajectoryUnitsPerMeter];
+        }
+        if (values[ORKTrajectoryFieldFloor]) {
+            dictionary[@"floor"] = @(values[ORKTrajectoryFieldFloor].integerValue);
+        }
+        [dictionaries addObject:dictionary];
+    }
+    return dictionaries;
+}
+
++ (NSData *)JSONLogDataWithCompressedLogData:(NSData *)data error:(NSError **)error {
+    NSDictionary *log = [NSJSONSerialization JSONObjectWithData:data options:0 error:error];
+    if (!log) {
+        return nil;
+    }
+    NSArray *records = [log isKindOfClass:[NSDictionary class]] ? log[@"items"] : nil;
+    if (![records isKindOfClass:[NSArray class]]) {
+        if (error) {
+            *error = ORKTrajectoryMalformedRecordsError();
+        }
+        return nil;
+    }
+    NSArray<NSDictionary *> *items = [self locationDictionariesWithRecords:records error:error];
+    if (!items) {
+        return nil;
+    }
+    return [NSJSONSerialization dataWithJSONObject:@{ @"items": items } options:0 error:error];
+}
+
+@end
+
+#endif
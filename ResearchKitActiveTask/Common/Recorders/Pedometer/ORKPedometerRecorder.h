@@ -36,6 +36,7 @@
 NS_ASSUME_NONNULL_BEGIN
 
 @class ORKPedometerRecorder;
+@class ORKWalkingDistanceEstimator;
 
 @protocol ORKPedometerRecorderDelegate <ORKRecorderDelegate>
 
@@ -61,6 +62,13 @@ ORK_CLASS_AVAILABLE
 // Negative if an invalid value.
 @property (nonatomic, readonly) NSInteger totalDistance;
 
+/**
+ The walking distance estimator, if any, to which the recorder appends its pedometer updates.
+ 
+ The estimator is usually shared with a location recorder of the same step, which owns it.
+ */
+@property (nonatomic, strong, nullable) ORKWalkingDistanceEstimator *walkingDistanceEstimator;
+
 /**
  Returns an initialized pedometer recorder.
  
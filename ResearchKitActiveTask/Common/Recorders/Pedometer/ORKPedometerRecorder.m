@@ -32,6 +32,7 @@
 #import "ORKPedometerRecorder.h"
 
 #import "ORKDataLogger.h"
+#import "ORKWalkingDistanceEstimator.h"
 
 #import "ORKRecorder_Internal.h"
 
@@ -76,6 +77,10 @@
         _totalDistance = -1;
     }
     
+    [_walkingDistanceEstimator appendPedometerStepCount:_totalNumberOfSteps
+                                               distance:pedometerData.distance ? pedometerData.distance.doubleValue : -1
+                                                   date:pedometerData.endDate];
+    
     id delegate = self.delegate;
     if ([delegate respondsToSelector:@selector(pedometerRecorderDidUpdate:)]) {
         [delegate pedometerRecorderDidUpdate:self];
@@ -136,6 +141,10 @@
     return @"pedometer";
 }
 
+- (ORKTimelineTimebase)timelineTimebase {
+    return ORKTimelineTimebaseWallClock;
+}
+
 - (void)stop {
     [self doStopRecording];
     [_logger finishCurrentLog];
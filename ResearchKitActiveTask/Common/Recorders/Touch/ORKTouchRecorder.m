@@ -35,6 +35,8 @@
 
 #import "ORKRecorder_Internal.h"
 
+#import "ORKClock.h"
+
 #import "UITouch+ORKJSONDictionary.h"
 
 
@@ -130,7 +132,7 @@
         [super start];
         
         self.touchArray = [NSMutableArray array];
-        _uptime = [NSProcessInfo processInfo].systemUptime;
+        _uptime = ORKClockSystemUptime();
     } else {
         @throw [NSException exceptionWithName:NSGenericException
                                        reason:@"No touch capture view provided"
@@ -0,0 +1,121 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <ResearchKit/ORKDefines.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ORKTremorResult;
+
+/**
+ A three-axis motion vector.
+ */
+typedef struct {
+    double x;
+    double y;
+    double z;
+} ORKTremorVector;
+
+/**
+ The `ORKTremorAnalyzer` class estimates tremor features from a stream of device motion samples.
+ 
+ User acceleration and rotation rate are analyzed separately. Each is accumulated into a power
+ spectrum using Welch's method, over segments of about two and a half seconds that overlap by half,
+ with the spectra of the three axes added together. Memory use is fixed and does not grow with the
+ length of the recording. The analyzer is not thread-safe; samples must be appended from one queue
+ at a time.
+ */
+ORK_CLASS_AVAILABLE
+@interface ORKTremorAnalyzer : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Returns an initialized tremor analyzer.
+ 
+ @param frequency   The nominal sampling frequency of the device motion stream, in hertz (Hz).
+ 
+ @return An initialized tremor analyzer.
+ */
+- (instancetype)initWithFrequency:(double)frequency NS_DESIGNATED_INITIALIZER;
+
+/**
+ The nominal sampling frequency of the device motion stream, in hertz (Hz).
+ */
+@property (nonatomic, readonly) double frequency;
+
+/**
+ The number of samples appended so far.
+ */
+@property (nonatomic, readonly) NSUInteger sampleCount;
+
+/**
+ Appends a device motion sample.
+ 
+ @param timestamp           The time at which the sample was taken, in seconds.
+ @param userAcceleration    The user acceleration, with gravity removed, in units of g.
+ @param rotationRate        The rotation rate, in radians per second.
+ */
+- (void)appendSampleWithTimestamp:(NSTimeInterval)timestamp
+                 userAcceleration:(ORKTremorVector)userAcceleration
+                     rotationRate:(ORKTremorVector)rotationRate;
+
+/**
+ Feeds every sample of a JSON log written by a device motion recorder through the analyzer.
+ 
+ Entries without a user acceleration and a rotation rate are skipped.
+ 
+ @param URL     The URL of the log file.
+ @param error   On failure, the error that occurred.
+ 
+ @return `YES` if the log was replayed; otherwise, `NO`.
+ */
+- (BOOL)replayJSONLogAtURL:(NSURL *)URL error:(NSError * _Nullable *)error;
+
+/**
+ Discards all accumulated state.
+ */
+- (void)reset;
+
+/**
+ Returns a result summarizing the tremor features estimated so far.
+ 
+ @param identifier  The identifier of the result.
+ 
+ @return A tremor result.
+ */
+- (ORKTremorResult *)resultWithIdentifier:(NSString *)identifier;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,157 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKTremorAnalyzer.h"
+
+#import "ORKTremorResult.h"
+#import "ORKTremorSpectrum.h"
+
+#import "ORKHelpers_Internal.h"
+
+
+static const NSTimeInterval SegmentDuration = 2.5;
+static const size_t MinimumSegmentLength = 16;
+static const size_t AxisCount = 3;
+
+// The smallest power of two that spans the segment duration, so that neighboring bins are at most
+// 0.4 Hz apart.
+static size_t ORKTremorSegmentLength(double frequency) {
+    size_t length = MinimumSegmentLength;
+    while (length < SegmentDuration * frequency) {
+        length <<= 1;
+    }
+    return length;
+}
+
+static ORKTremorVector ORKTremorVectorFromDictionary(NSDictionary *dictionary) {
+    return (ORKTremorVector){ [dictionary[@"x"] doubleValue], [dictionary[@"y"] doubleValue], [dictionary[@"z"] doubleValue] };
+}
+
+
+@implementation ORKTremorAnalyzer {
+    ORKTremorSpectrum *_accelerationSpectrum;
+    ORKTremorSpectrum *_rotationRateSpectrum;
+    NSTimeInterval _firstTimestamp;
+    NSTimeInterval _lastTimestamp;
+}
+
+- (instancetype)initWithFrequency:(double)frequency {
+    self = [super init];
+    if (self) {
+        _frequency = frequency > 0 ? frequency : 1;
+        const size_t segmentLength = ORKTremorSegmentLength(_frequency);
+        _accelerationSpectrum = ORKTremorSpectrumCreate(_frequency, segmentLength, AxisCount);
+        _rotationRateSpectrum = ORKTremorSpectrumCreate(_frequency, segmentLength, AxisCount);
+        [self reset];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    ORKTremorSpectrumDestroy(_accelerationSpectrum);
+    ORKTremorSpectrumDestroy(_rotationRateSpectrum);
+}
+
+- (void)reset {
+    _sampleCount = 0;
+    _firstTimestamp = 0;
+    _lastTimestamp = 0;
+    ORKTremorSpectrumReset(_accelerationSpectrum);
+    ORKTremorSpectrumReset(_rotationRateSpectrum);
+}
+
+- (void)appendSampleWithTimestamp:(NSTimeInterval)timestamp
+                 userAcceleration:(ORKTremorVector)userAcceleration
+                     rotationRate:(ORKTremorVector)rotationRate {
+    if (_sampleCount == 0) {
+        _firstTimestamp = timestamp;
+    }
+    
+    const double accelerationValues[] = { userAcceleration.x, userAcceleration.y, userAcceleration.z };
+    const double rotationRateValues[] = { rotationRate.x, rotationRate.y, rotationRate.z };
+    ORKTremorSpectrumAppend(_accelerationSpectrum, accelerationValues);
+    ORKTremorSpectrumAppend(_rotationRateSpectrum, rotationRateValues);
+    
+    _lastTimestamp = timestamp;
+    _sampleCount += 1;
+}
+
+- (ORKTremorResult *)resultWithIdentifier:(NSString *)identifier {
+    ORKTremorResult *result = [[ORKTremorResult alloc] initWithIdentifier:identifier];
+    result.duration = _sampleCount > 0 ? _lastTimestamp - _firstTimestamp : 0;
+    
+    const ORKTremorFeatures acceleration = ORKTremorSpectrumFeatures(_accelerationSpectrum);
+    result.accelerationDominantFrequency = acceleration.dominantFrequency;
+    result.accelerationLowBandPower = acceleration.lowBandPower;
+    result.accelerationHighBandPower = acceleration.highBandPower;
+    result.accelerationHarmonicRatio = acceleration.harmonicRatio;
+    
+    const ORKTremorFeatures rotationRate = ORKTremorSpectrumFeatures(_rotationRateSpectrum);
+    result.rotationRateDominantFrequency = rotationRate.dominantFrequency;
+    result.rotationRateLowBandPower = rotationRate.lowBandPower;
+    result.rotationRateHighBandPower = rotationRate.highBandPower;
+    result.rotationRateHarmonicRatio = rotationRate.harmonicRatio;
+    return result;
+}
+
+- (BOOL)replayJSONLogAtURL:(NSURL *)URL error:(NSError **)error {
+    NSData *data = [NSData dataWithContentsOfURL:URL options:NSDataReadingMappedIfSafe error:error];
+    if (!data) {
+        return NO;
+    }
+    NSDictionary *log = [NSJSONSerialization JSONObjectWithData:data options:0 error:error];
+    if (!log) {
+        return NO;
+    }
+    NSArray *items = [log isKindOfClass:[NSDictionary class]] ? log[@"items"] : nil;
+    if (![items isKindOfClass:[NSArray class]]) {
+        if (error) {
+            *error = [NSError errorWithDomain:NSCocoaErrorDomain
+                                         code:NSFileReadCorruptFileError
+                                     userInfo:@{NSURLErrorKey: URL}];
+        }
+        return NO;
+    }
+    
+    for (NSDictionary *item in items) {
+        NSDictionary *userAcceleration = item[@"userAcceleration"];
+        NSDictionary *rotationRate = item[@"rotationRate"];
+        if (!userAcceleration || !rotationRate) {
+            continue;
+        }
+        [self appendSampleWithTimestamp:[item[@"timestamp"] doubleValue]
+                       userAcceleration:ORKTremorVectorFromDictionary(userAcceleration)
+                           rotationRate:ORKTremorVectorFromDictionary(rotationRate)];
+    }
+    return YES;
+}
+
+@end
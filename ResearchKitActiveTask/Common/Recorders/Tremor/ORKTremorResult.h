@@ -0,0 +1,104 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <ResearchKit/ORKResult.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The `ORKTremorResult` class summarizes the tremor features estimated while recording device
+ motion during one hand pose of the tremor test.
+ 
+ A tremor result is produced alongside the file result of a device motion recorder when tremor
+ analysis is enabled on its configuration. Its identifier is the recorder identifier followed by
+ the `.tremor` suffix, and it is part of the step result of the pose that was recorded.
+ 
+ Band powers are the sums of the power spectral density of the three axes over the band, in g²
+ for user acceleration and in rad²/s² for rotation rate.
+ */
+ORK_CLASS_AVAILABLE
+@interface ORKTremorResult : ORKResult
+
+/**
+ The frequency of the highest spectral peak of the user acceleration between 2 and 15 Hz, in
+ hertz (Hz), or 0 if there is none.
+ */
+@property (nonatomic, assign) double accelerationDominantFrequency;
+
+/**
+ The power of the user acceleration between 3 and 7 Hz, where parkinsonian and essential tremor
+ usually fall.
+ */
+@property (nonatomic, assign) double accelerationLowBandPower;
+
+/**
+ The power of the user acceleration between 8 and 12 Hz, where physiological tremor usually falls.
+ */
+@property (nonatomic, assign) double accelerationHighBandPower;
+
+/**
+ The power of the user acceleration at the second to fifth harmonics of the dominant frequency,
+ relative to the power at the dominant frequency.
+ */
+@property (nonatomic, assign) double accelerationHarmonicRatio;
+
+/**
+ The frequency of the highest spectral peak of the rotation rate between 2 and 15 Hz, in hertz
+ (Hz), or 0 if there is none.
+ */
+@property (nonatomic, assign) double rotationRateDominantFrequency;
+
+/**
+ The power of the rotation rate between 3 and 7 Hz.
+ */
+@property (nonatomic, assign) double rotationRateLowBandPower;
+
+/**
+ The power of the rotation rate between 8 and 12 Hz.
+ */
+@property (nonatomic, assign) double rotationRateHighBandPower;
+
+/**
+ The power of the rotation rate at the second to fifth harmonics of the dominant frequency,
+ relative to the power at the dominant frequency.
+ */
+@property (nonatomic, assign) double rotationRateHarmonicRatio;
+
+/**
+ The duration of the analyzed signal.
+ */
+@property (nonatomic, assign) NSTimeInterval duration;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,122 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKTremorResult.h"
+
+#import "ORKResult_Private.h"
+#import "ORKHelpers_Internal.h"
+
+
+@implementation ORKTremorResult
+
+- (void)encodeWithCoder:(NSCoder *)aCoder {
+    [super encodeWithCoder:aCoder];
+    ORK_ENCODE_DOUBLE(aCoder, accelerationDominantFrequency);
+    ORK_ENCODE_DOUBLE(aCoder, accelerationLowBandPower);
+    ORK_ENCODE_DOUBLE(aCoder, accelerationHighBandPower);
+    ORK_ENCODE_DOUBLE(aCoder, accelerationHarmonicRatio);
+    ORK_ENCODE_DOUBLE(aCoder, rotationRateDominantFrequency);
+    ORK_ENCODE_DOUBLE(aCoder, rotationRateLowBandPower);
+    ORK_ENCODE_DOUBLE(aCoder, rotationRateHighBandPower);
+    ORK_ENCODE_DOUBLE(aCoder, rotationRateHarmonicRatio);
+    ORK_ENCODE_DOUBLE(aCoder, duration);
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder {
+    self = [super initWithCoder:aDecoder];
+    if (self) {
+        ORK_DECODE_DOUBLE(aDecoder, accelerationDominantFrequency);
+        ORK_DECODE_DOUBLE(aDecoder, accelerationLowBandPower);
+        ORK_DECODE_DOUBLE(aDecoder, accelerationHighBandPower);
+        ORK_DECODE_DOUBLE(aDecoder, accelerationHarmonicRatio);
+        ORK_DECODE_DOUBLE(aDecoder, rotationRateDominantFrequency);
+        ORK_DECODE_DOUBLE(aDecoder, rotationRateLowBandPower);
+        ORK_DECODE_DOUBLE(aDecoder, rotationRateHighBandPower);
+        ORK_DECODE_DOUBLE(aDecoder, rotationRateHarmonicRatio);
+        ORK_DECODE_DOUBLE(aDecoder, duration);
+    }
+    return self;
+}
+
++ (BOOL)supportsSecureCoding {
+    return YES;
+}
+
+- (BOOL)isEqual:(id)object {
+    BOOL isParentSame = [super isEqual:object];
+    
+    __typeof(self) castObject = object;
+    return (isParentSame &&
+            (self.accelerationDominantFrequency == castObject.accelerationDominantFrequency) &&
+            (self.accelerationLowBandPower == castObject.accelerationLowBandPower) &&
+            (self.accelerationHighBandPower == castObject.accelerationHighBandPower) &&
+            (self.accelerationHarmonicRatio == castObject.accelerationHarmonicRatio) &&
+            (self.rotationRateDominantFrequency == castObject.rotationRateDominantFrequency) &&
+            (self.rotationRateLowBandPower == castObject.rotationRateLowBandPower) &&
+            (self.rotationRateHighBandPower == castObject.rotationRateHighBandPower) &&
+            (self.rotationRateHarmonicRatio == castObject.rotationRateHarmonicRatio) &&
+            (self.duration == castObject.duration));
+}
+
+- (NSUInteger)hash {
+    return super.hash ^ @(self.accelerationDominantFrequency).hash ^ @(self.rotationRateDominantFrequency).hash;
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone {
+    ORKTremorResult *result = [super copyWithZone:zone];
+    result.accelerationDominantFrequency = self.accelerationDominantFrequency;
+    result.accelerationLowBandPower = self.accelerationLowBandPower;
+    result.accelerationHighBandPower = self.accelerationHighBandPower;
+    result.accelerationHarmonicRatio = self.accelerationHarmonicRatio;
+    result.rotationRateDominantFrequency = self.rotationRateDominantFrequency;
+    result.rotationRateLowBandPower = self.rotationRateLowBandPower;
+    result.rotationRateHighBandPower = self.rotationRateHighBandPower;
+    result.rotationRateHarmonicRatio = self.rotationRateHarmonicRatio;
+    result.duration = self.duration;
+    return result;
+}
+
+- (NSString *)descriptionWithNumberOfPaddingSpaces:(NSUInteger)numberOfPaddingSpaces {
+    return [NSString stringWithFormat:@"%@; acceleration: %@ Hz (%@, %@, %@); rotationRate: %@ Hz (%@, %@, %@); duration: %@%@",
+            [self descriptionPrefixWithNumberOfPaddingSpaces:numberOfPaddingSpaces],
+            @(self.accelerationDominantFrequency),
+            @(self.accelerationLowBandPower),
+            @(self.accelerationHighBandPower),
+            @(self.accelerationHarmonicRatio),
+            @(self.rotationRateDominantFrequency),
+            @(self.rotationRateLowBandPower),
+            @(self.rotationRateHighBandPower),
+            @(self.rotationRateHarmonicRatio),
+            @(self.duration),
+            self.descriptionSuffix];
+}
+
+@end
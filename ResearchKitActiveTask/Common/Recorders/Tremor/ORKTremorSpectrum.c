@@ -0,0 +1,472 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "ORKTremorSpectrum.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__APPLE__)
+#include <Accelerate/Accelerate.h>
+#define ORK_TREMOR_HAS_VDSP 1
+#else
+#define ORK_TREMOR_HAS_VDSP 0
+#endif
+
+
+static const double ORKTremorMinimumFrequency = 2.0;
+static const double ORKTremorMaximumFrequency = 15.0;
+static const double ORKTremorLowBandMinimumFrequency = 3.0;
+static const double ORKTremorLowBandMaximumFrequency = 7.0;
+static const double ORKTremorHighBandMinimumFrequency = 8.0;
+static const double ORKTremorHighBandMaximumFrequency = 12.0;
+static const size_t ORKTremorHighestHarmonic = 5;
+
+// The main lobe of a Hann window spans two bins on either side of a peak.
+static const size_t ORKTremorPeakHalfWidth = 2;
+
+#pragma mark - FFT
+
+struct ORKTremorFFT {
+    size_t length;
+    size_t halfLength;
+    bool portable;
+#if ORK_TREMOR_HAS_VDSP
+    vDSP_Length log2Length;
+    FFTSetupD setup;
+#endif
+    // The samples are transformed as a complex signal of half the length, with even samples in the
+    // real part and odd samples in the imaginary part.
+    double *real;
+    double *imaginary;
+    size_t *bitReversal;
+    double *twiddleCosines;
+    double *twiddleSines;
+    double *unpackCosines;
+    double *unpackSines;
+};
+
+ORKTremorFFT *ORKTremorFFTCreate(size_t length, bool portable) {
+    if (length < 4 || (length & (length - 1)) != 0) {
+        return NULL;
+    }
+    
+    ORKTremorFFT *fft = calloc(1, sizeof(ORKTremorFFT));
+    if (!fft) {
+        return NULL;
+    }
+    fft->length = length;
+    fft->halfLength = length / 2;
+    fft->portable = portable || !ORK_TREMOR_HAS_VDSP;
+    
+    const size_t halfLength = fft->halfLength;
+    fft->real = calloc(halfLength, sizeof(double));
+    fft->imaginary = calloc(halfLength, sizeof(double));
+    if (!fft->real || !fft->imaginary) {
+        ORKTremorFFTDestroy(fft);
+        return NULL;
+    }
+    
+#if ORK_TREMOR_HAS_VDSP
+    if (!fft->portable) {
+        fft->log2Length = 0;
+        while (((size_t)1 << fft->log2Length) < length) {
+            fft->log2Length++;
+        }
+        fft->setup = vDSP_create_fftsetupD(fft->log2Length, kFFTRadix2);
+        if (!fft->setup) {
+            ORKTremorFFTDestroy(fft);
+            return NULL;
+        }
+        return fft;
+    }
+#endif
+    
+    fft->bitReversal = calloc(halfLength, sizeof(size_t));
+    fft->twiddleCosines = calloc(halfLength / 2 + 1, sizeof(double));
+    fft->twiddleSines = calloc(halfLength / 2 + 1, sizeof(double));
+    fft->unpackCosines = calloc(halfLength, sizeof(double));
+    fft->unpackSines = calloc(halfLength, sizeof(double));
+    if (!fft->bitReversal || !fft->twiddleCosines || !fft->twiddleSines || !fft->unpackCosines || !fft->unpackSines) {
+        ORKTremorFFTDestroy(fft);
+        return NULL;
+    }
+    
+    size_t bits = 0;
+    while (((size_t)1 << bits) < halfLength) {
+        bits++;
+    }
+    for (size_t index = 0; index < halfLength; index++) {
+        size_t reversed = 0;
+        for (size_t bit = 0; bit < bits; bit++) {
+            reversed |= ((index >> bit) & 1) << (bits - 1 - bit);
+        }
+        fft->bitReversal[index] = reversed;
+    }
+    for (size_t index = 0; index < halfLength / 2 + 1; index++) {
+        fft->twiddleCosines[index] = cos(2 * M_PI * index / halfLength);
+        fft->twiddleSines[index] = sin(2 * M_PI * index / halfLength);
+    }
+    for (size_t index = 0; index < halfLength; index++) {
+        fft->unpackCosines[index] = cos(2 * M_PI * index / length);
+        fft->unpackSines[index] = sin(2 * M_PI * index / length);
+    }
+    return fft;
+}
+
+void ORKTremorFFTDestroy(ORKTremorFFT *fft) {
+    if (!fft) {
+        return;
+    }
+#if ORK_TREMOR_HAS_VDSP
+    if (fft->setup) {
+        vDSP_destroy_fftsetupD(fft->setup);
+    }
+#endif
+    free(fft->real);
+    free(fft->imaginary);
+    free(fft->bitReversal);
+    free(fft->twiddleCosines);
+    free(fft->twiddleSines);
+    free(fft->unpackCosines);
+    free(fft->unpackSines);
+    free(fft);
+}
+
+static void ORKTremorFFTPowerPortable(ORKTremorFFT *fft, const double *samples, double *power) {
+    const size_t halfLength = fft->halfLength;
+    double *real = fft->real;
+    double *imaginary = fft->imaginary;
+    
+    for (size_t index = 0; index < halfLength; index++) {
+        const size_t reversed = fft->bitReversal[index];
+        real[reversed] = samples[2 * index];
+        imaginary[reversed] = samples[(2 * index) + 1];
+    }
+    
+    // Iterative radix-2 decimation in time.
+    for (size_t span = 2; span <= halfLength; span <<= 1) {
+        const size_t half = span / 2;
+        const size_t stride = halfLength / span;
+        for (size_t start = 0; start < halfLength; start += span) {
+            for (size_t offset = 0; offset < half; offset++) {
+                const double cosine = fft->twiddleCosines[offset * stride];
+                const double sine = fft->twiddleSines[offset * stride];
+                const size_t top = start + offset;
+                const size_t bottom = top + half;
+                const double bottomReal = (real[bottom] * cosine) + (imaginary[bottom] * sine);
+                const double bottomImaginary = (imaginary[bottom] * cosine) - (real[bottom] * sine);
+                real[bottom] = real[top] - bottomReal;
+                imaginary[bottom] = imaginary[top] - bottomImaginary;
+                real[top] += bottomReal;
+                imaginary[top] += bottomImaginary;
+            }
+        }
+    }
+    
+    // Separate the transforms of the even and odd samples, and combine them into the transform of
+    // the real signal.
+    power[0] = (real[0] + imaginary[0]) * (real[0] + imaginary[0]);
+    power[halfLength] = (real[0] - imaginary[0]) * (real[0] - imaginary[0]);
+    for (size_t index = 1; index < halfLength; index++) {
+        const double mirroredReal = real[halfLength - index];
+        const double mirroredImaginary = -imaginary[halfLength - index];
+        const double evenReal = 0.5 * (real[index] + mirroredReal);
+        const double evenImaginary = 0.5 * (imaginary[index] + mirroredImaginary);
+        const double oddReal = 0.5 * (imaginary[index] - mirroredImaginary);
+        const double oddImaginary = -0.5 * (real[index] - mirroredReal);
+        const double cosine = fft->unpackCosines[index];
+        const double sine = fft->unpackSines[index];
+        const double transformReal = evenReal + (oddReal * cosine) + (oddImaginary * sine);
+        const double transformImaginary = evenImaginary + (oddImaginary * cosine) - (oddReal * sine);
+        power[index] = (transformReal * transformReal) + (transformImaginary * transformImaginary);
+    }
+}
+
+void ORKTremorFFTPower(ORKTremorFFT *fft, const double *samples, double *power) {
+#if ORK_TREMOR_HAS_VDSP
+    if (!fft->portable) {
+        const size_t halfLength = fft->halfLength;
+        DSPDoubleSplitComplex split = { fft->real, fft->imaginary };
+        vDSP_ctozD((const DSPDoubleComplex *)samples, 2, &split, 1, halfLength);
+        vDSP_fft_zripD(fft->setup, &split, 1, fft->log2Length, kFFTDirection_Forward);
+        
+        // vDSP scales the transform by 2, and packs the Nyquist bin into the imaginary part of the
+        // DC bin.
+        const double nyquist = split.imagp[0];
+        split.imagp[0] = 0;
+        vDSP_zvmagsD(&split, 1, power, 1, halfLength);
+        const double scale = 0.25;
+        vDSP_vsmulD(power, 1, &scale, power, 1, halfLength);
+        power[halfLength] = scale * nyquist * nyquist;
+        return;
+    }
+#endif
+    ORKTremorFFTPowerPortable(fft, samples, power);
+}
+
+#pragma mark - Spectrum
+
+struct ORKTremorSpectrum {
+    double samplingFrequency;
+    size_t segmentLength;
+    size_t hopLength;
+    size_t axisCount;
+    size_t binCount;
+    
+    size_t sampleCount;
+    size_t segmentCount;
+    
+    ORKTremorFFT *fft;
+    double *window;
+    double windowPower;
+    
+    // One ring buffer of the last `segmentLength` values for each axis, all written at `position`.
+    double *history;
+    size_t position;
+    
+    double *segment;
+    double *power;
+    double *powerSums;
+    double *density;
+};
+
+ORKTremorSpectrum *ORKTremorSpectrumCreate(double samplingFrequency, size_t segmentLength, size_t axisCount) {
+    if (!(samplingFrequency > 0) || axisCount == 0) {
+        return NULL;
+    }
+    ORKTremorFFT *fft = ORKTremorFFTCreate(segmentLength, false);
+    if (!fft) {
+        return NULL;
+    }
+    
+    ORKTremorSpectrum *spectrum = calloc(1, sizeof(ORKTremorSpectrum));
+    if (!spectrum) {
+        ORKTremorFFTDestroy(fft);
+        return NULL;
+    }
+    spectrum->samplingFrequency = samplingFrequency;
+    spectrum->segmentLength = segmentLength;
+    spectrum->hopLength = segmentLength / 2;
+    spectrum->axisCount = axisCount;
+    spectrum->binCount = (segmentLength / 2) + 1;
+    spectrum->fft = fft;
+    spectrum->window = calloc(segmentLength, sizeof(double));
+    spectrum->history = calloc(segmentLength * axisCount, sizeof(double));
+    spectrum->segment = calloc(segmentLength, sizeof(double));
+    spectrum->power = calloc(spectrum->binCount, sizeof(double));
+    spectrum->powerSums = calloc(spectrum->binCount, sizeof(double));
+    spectrum->density = calloc(spectrum->binCount, sizeof(double));
+    if (!spectrum->window || !spectrum->history || !spectrum->segment || !spectrum->power || !spectrum->powerSums || !spectrum->density) {
+        ORKTremorSpectrumDestroy(spectrum);
+        return NULL;
+    }
+    
+    // A periodic Hann window, which overlaps by half to a constant sum.
+    for (size_t index = 0; index < segmentLength; index++) {
+        const double value = 0.5 - (0.5 * cos(2 * M_PI * index / segmentLength));
+        spectrum->window[index] = value;
+        spectrum->windowPower += value * value;
+    }
+    return spectrum;
+}
+
+void ORKTremorSpectrumDestroy(ORKTremorSpectrum *spectrum) {
+    if (!spectrum) {
+        return;
+    }
+    ORKTremorFFTDestroy(spectrum->fft);
+    free(spectrum->window);
+    free(spectrum->history);
+    free(spectrum->segment);
+    free(spectrum->power);
+    free(spectrum->powerSums);
+    free(spectrum->density);
+    free(spectrum);
+}
+
+void ORKTremorSpectrumReset(ORKTremorSpectrum *spectrum) {
+    spectrum->sampleCount = 0;
+    spectrum->segmentCount = 0;
+    spectrum->position = 0;
+    memset(spectrum->powerSums, 0, spectrum->binCount * sizeof(double));
+}
+
+static void ORKTremorSpectrumAddSegment(ORKTremorSpectrum *spectrum) {
+    const size_t length = spectrum->segmentLength;
+    const size_t position = spectrum->position;
+    double *segment = spectrum->segment;
+    
+    for (size_t axis = 0; axis < spectrum->axisCount; axis++) {
+        // The oldest value is the one about to be overwritten.
+        const double *history = spectrum->history + (axis * length);
+        memcpy(segment, history + position, (length - position) * sizeof(double));
+        memcpy(segment + (length - position), history, position * sizeof(double));
+        
+        double mean = 0;
+        for (size_t index = 0; index < length; index++) {
+            mean += segment[index];
+        }
+        mean /= length;
+        for (size_t index = 0; index < length; index++) {
+            segment[index] = (segment[index] - mean) * spectrum->window[index];
+        }
+        
+        ORKTremorFFTPower(spectrum->fft, segment, spectrum->power);
+        for (size_t bin = 0; bin < spectrum->binCount; bin++) {
+            spectrum->powerSums[bin] += spectrum->power[bin];
+        }
+    }
+    spectrum->segmentCount += 1;
+}
+
+void ORKTremorSpectrumAppend(ORKTremorSpectrum *spectrum, const double *values) {
+    const size_t length = spectrum->segmentLength;
+    for (size_t axis = 0; axis < spectrum->axisCount; axis++) {
+        spectrum->history[(axis * length) + spectrum->position] = values[axis];
+    }
+    spectrum->position = (spectrum->position + 1) % length;
+    spectrum->sampleCount += 1;
+    
+    if (spectrum->sampleCount >= length && ((spectrum->sampleCount - length) % spectrum->hopLength) == 0) {
+        ORKTremorSpectrumAddSegment(spectrum);
+    }
+}
+
+size_t ORKTremorSpectrumSampleCount(const ORKTremorSpectrum *spectrum) {
+    return spectrum->sampleCount;
+}
+
+size_t ORKTremorSpectrumSegmentCount(const ORKTremorSpectrum *spectrum) {
+    return spectrum->segmentCount;
+}
+
+double ORKTremorSpectrumBinWidth(const ORKTremorSpectrum *spectrum) {
+    return spectrum->samplingFrequency / spectrum->segmentLength;
+}
+
+const double *ORKTremorSpectrumDensity(ORKTremorSpectrum *spectrum, size_t *binCount) {
+    const size_t count = spectrum->binCount;
+    if (spectrum->segmentCount == 0) {
+        memset(spectrum->density, 0, count * sizeof(double));
+    } else {
+        // Bins other than DC and Nyquist also hold the power of the negative frequencies.
+        const double scale = 1.0 / (spectrum->samplingFrequency * spectrum->windowPower * spectrum->segmentCount);
+        for (size_t bin = 0; bin < count; bin++) {
+            const double factor = (bin == 0 || bin == count - 1) ? 1.0 : 2.0;
+            spectrum->density[bin] = factor * scale * spectrum->powerSums[bin];
+        }
+    }
+    if (binCount) {
+        *binCount = count;
+    }
+    return spectrum->density;
+}
+
+static double ORKTremorBandPower(const double *density, size_t binCount, double binWidth, double minimumFrequency, double maximumFrequency) {
+    double power = 0;
+    for (size_t bin = (size_t)ceil(minimumFrequency / binWidth); bin < binCount && bin * binWidth <= maximumFrequency; bin++) {
+        power += density[bin] * binWidth;
+    }
+    return power;
+}
+
+static double ORKTremorPeakPower(const double *density, size_t binCount, double binWidth, size_t centerBin) {
+    const size_t firstBin = centerBin > ORKTremorPeakHalfWidth ? centerBin - ORKTremorPeakHalfWidth : 0;
+    const size_t lastBin = centerBin + ORKTremorPeakHalfWidth < binCount ? centerBin + ORKTremorPeakHalfWidth : binCount - 1;
+    double power = 0;
+    for (size_t bin = firstBin; bin <= lastBin; bin++) {
+        power += density[bin] * binWidth;
+    }
+    return power;
+}
+
+ORKTremorFeatures ORKTremorSpectrumFeatures(ORKTremorSpectrum *spectrum) {
+    ORKTremorFeatures features = { 0, 0, 0, 0 };
+    if (spectrum->segmentCount == 0) {
+        return features;
+    }
+    
+    size_t binCount = 0;
+    const double *density = ORKTremorSpectrumDensity(spectrum, &binCount);
+    const double binWidth = ORKTremorSpectrumBinWidth(spectrum);
+    
+    features.lowBandPower = ORKTremorBandPower(density, binCount, binWidth, ORKTremorLowBandMinimumFrequency, ORKTremorLowBandMaximumFrequency);
+    features.highBandPower = ORKTremorBandPower(density, binCount, binWidth, ORKTremorHighBandMinimumFrequency, ORKTremorHighBandMaximumFrequency);
+    
+    // The peak is searched away from the edges, so that both of its neighbors exist.
+    const size_t firstBin = (size_t)ceil(ORKTremorMinimumFrequency / binWidth);
+    size_t lastBin = (size_t)floor(ORKTremorMaximumFrequency / binWidth);
+    if (lastBin > binCount - 2) {
+        lastBin = binCount - 2;
+    }
+    size_t peakBin = 0;
+    double peakDensity = 0;
+    for (size_t bin = firstBin > 0 ? firstBin : 1; bin <= lastBin; bin++) {
+        if (density[bin] > peakDensity) {
+            peakDensity = density[bin];
+            peakBin = bin;
+        }
+    }
+    if (peakBin == 0) {
+        return features;
+    }
+    
+    // A parabola through the logarithms of the peak and its neighbors locates the peak between
+    // bins; the main lobe of a Hann window is close to Gaussian.
+    double offset = 0;
+    const double previous = density[peakBin - 1];
+    const double next = density[peakBin + 1];
+    if (previous > 0 && next > 0) {
+        const double logPrevious = log(previous);
+        const double logPeak = log(peakDensity);
+        const double logNext = log(next);
+        const double curvature = logPrevious - (2 * logPeak) + logNext;
+        if (curvature < 0) {
+            offset = 0.5 * (logPrevious - logNext) / curvature;
+            offset = fmax(-0.5, fmin(0.5, offset));
+        }
+    }
+    features.dominantFrequency = (peakBin + offset) * binWidth;
+    
+    const double fundamentalPower = ORKTremorPeakPower(density, binCount, binWidth, peakBin);
+    double harmonicPower = 0;
+    for (size_t harmonic = 2; harmonic <= ORKTremorHighestHarmonic; harmonic++) {
+        const size_t harmonicBin = (size_t)lround(harmonic * features.dominantFrequency / binWidth);
+        if (harmonicBin + ORKTremorPeakHalfWidth >= binCount) {
+            break;
+        }
+        harmonicPower += ORKTremorPeakPower(density, binCount, binWidth, harmonicBin);
+    }
+    features.harmonicRatio = fundamentalPower > 0 ? harmonicPower / fundamentalPower : 0;
+    return features;
+}
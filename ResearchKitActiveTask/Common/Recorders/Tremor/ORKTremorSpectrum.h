@@ -0,0 +1,138 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef ORKTremorSpectrum_h
+#define ORKTremorSpectrum_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*
+ Streaming spectral analysis of tremor in a multi-axis motion signal.
+ 
+ Samples are appended one at a time. Every half segment, the most recent segment of each axis has
+ its mean removed, is multiplied by a Hann window and transformed, and its power is added to a
+ running sum, following Welch's method with 50% overlap. The spectra of the axes are added, so the
+ estimate does not depend on how the device is held. Memory use is fixed by the segment length and
+ does not grow with the length of the recording.
+ 
+ Transforms use vDSP on Apple platforms and a portable radix-2 implementation elsewhere. The code
+ is plain C so that it can be built and tested without Foundation.
+ */
+
+/*
+ A real-input fast Fourier transform of a fixed power-of-two length.
+ */
+typedef struct ORKTremorFFT ORKTremorFFT;
+
+/*
+ Returns a transform of `length` samples, or NULL if `length` is not a power of two of at least 4
+ or memory cannot be allocated. When `portable` is true, the portable implementation is used even
+ where vDSP is available.
+ */
+ORKTremorFFT *ORKTremorFFTCreate(size_t length, bool portable);
+
+void ORKTremorFFTDestroy(ORKTremorFFT *fft);
+
+/*
+ Writes the squared magnitude of each of the `length / 2 + 1` non-negative frequency bins of
+ `samples`, which holds `length` values, to `power`. The transform is unnormalized.
+ */
+void ORKTremorFFTPower(ORKTremorFFT *fft, const double *samples, double *power);
+
+
+typedef struct ORKTremorSpectrum ORKTremorSpectrum;
+
+typedef struct {
+    // The frequency of the highest peak between 2 and 15 Hz, in hertz, or 0 if there is none.
+    double dominantFrequency;
+    // The power between 3 and 7 Hz, where parkinsonian and essential tremor usually fall.
+    double lowBandPower;
+    // The power between 8 and 12 Hz, where physiological tremor usually falls.
+    double highBandPower;
+    // The power at the second to fifth harmonics of the dominant frequency, relative to the power
+    // at the dominant frequency.
+    double harmonicRatio;
+} ORKTremorFeatures;
+
+/*
+ Returns a spectrum of signals sampled at `samplingFrequency` hertz with `axisCount` axes, analyzed
+ in segments of `segmentLength` samples, or NULL if the arguments are invalid or memory cannot be
+ allocated. `segmentLength` must be a power of two of at least 4.
+ */
+ORKTremorSpectrum *ORKTremorSpectrumCreate(double samplingFrequency, size_t segmentLength, size_t axisCount);
+
+void ORKTremorSpectrumDestroy(ORKTremorSpectrum *spectrum);
+
+/*
+ Discards every appended sample.
+ */
+void ORKTremorSpectrumReset(ORKTremorSpectrum *spectrum);
+
+/*
+ Appends one sample, with a value for each axis.
+ */
+void ORKTremorSpectrumAppend(ORKTremorSpectrum *spectrum, const double *values);
+
+size_t ORKTremorSpectrumSampleCount(const ORKTremorSpectrum *spectrum);
+
+/*
+ The number of segments averaged so far. The spectrum is empty until a full segment is appended.
+ */
+size_t ORKTremorSpectrumSegmentCount(const ORKTremorSpectrum *spectrum);
+
+/*
+ The frequency spacing of the spectrum bins, in hertz.
+ */
+double ORKTremorSpectrumBinWidth(const ORKTremorSpectrum *spectrum);
+
+/*
+ Returns the one-sided power spectral density averaged over the segments so far, in squared signal
+ units per hertz, and sets `binCount` to its `segmentLength / 2 + 1` bins. Bin `k` is centered at
+ `k` times the bin width. The values are valid until the spectrum is next changed.
+ */
+const double *ORKTremorSpectrumDensity(ORKTremorSpectrum *spectrum, size_t *binCount);
+
+/*
+ Returns the tremor features of the averaged spectrum. Every feature is 0 before the first segment
+ is complete.
+ */
+ORKTremorFeatures ORKTremorSpectrumFeatures(ORKTremorSpectrum *spectrum);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* ORKTremorSpectrum_h */
@@ -41,6 +41,7 @@
 #import "ORKFrontFacingCameraStepResult.h"
 #import "ORKFrontFacingCameraStepViewController.h"
 #import "ORKHelpers_Internal.h"
+#import "ORKMediaArtifactStore.h"
 #import "ORKNavigationContainerView_Internal.h"
 #import "ORKResult_Private.h"
 #import "ORKStepContainerView_Private.h"
@@ -299,21 +300,31 @@
     {
         //Save video to permanant file
         NSString *outputFileName = [NSUUID new].UUIDString;
-        _savedFileName = [outputFileName stringByAppendingPathExtension:@"mov"];
+        NSString *savedFileName = [outputFileName stringByAppendingPathExtension:@"mov"];
         
         NSURL *docURL = [NSFileManager.defaultManager URLsForDirectory:NSDocumentDirectory inDomains:NSUserDomainMask].lastObject;
-        docURL = [docURL URLByAppendingPathComponent:_savedFileName];
+        ORKMediaArtifactStore *store = [[ORKMediaArtifactStore alloc] initWithDirectoryURL:docURL
+                                                                       fileProtectionMode:ORKFileProtectionCompleteUnlessOpen];
         
-        NSData *data = [NSData dataWithContentsOfURL:_tempOutputURL];
-        BOOL wasDataSavedToURL = [data writeToURL:docURL atomically:YES];
+        // The temporary directory is on the same volume, so the recording is renamed rather than read and rewritten.
+        NSError *error = nil;
+        ORKMediaArtifact *artifact = [store ingestFileAtURL:_tempOutputURL
+                                                   fileName:savedFileName
+                                                    options:ORKMediaArtifactIngestOptionMoveSource
+                                                      error:&error];
         
-        if (wasDataSavedToURL)
+        if (artifact)
         {
-            //remove video saved to temp directory if it was saved successfully in the document directory
-            _savedFileURL = docURL;
-            [self deleteTempVideoFile];
+            //the video was moved out of the temp directory, so there is nothing left to remove
+            _savedFileName = savedFileName;
+            _savedFileURL = artifact.fileURL;
+            _tempOutputURL = nil;
             [self finish];
         }
+        else
+        {
+            ORK_Log_Error("Error saving video to %@: %@", docURL, error);
+        }
     }
 }
 
@@ -46,6 +46,7 @@
 #import "ORKNavigableOrderedTask.h"
 #import "ORKVerticalContainerView_Internal.h"
 #import "ORKHelpers_Internal.h"
+#import "ORKClock.h"
 
 
 @interface ORKHolePegTestPlaceStepViewController () <ORKHolePegTestPlaceContentViewDelegate>
@@ -135,9 +136,9 @@
 
 - (void)saveSampleWithDistance:(CGFloat)distance {
     ORKHolePegTestSample *sample = [[ORKHolePegTestSample alloc] init];
-    sample.time = CACurrentMediaTime() - self.sampleStart;
+    sample.time = ORKClockSystemUptime() - self.sampleStart;
     sample.distance = distance;
-    self.sampleStart = CACurrentMediaTime();
+    self.sampleStart = ORKClockSystemUptime();
     
     [self.samples addObject:sample];
 }
@@ -146,7 +147,7 @@
 
 - (void)holePegTestPlaceDidProgress:(ORKHolePegTestPlaceContentView *)holePegTestPlaceContentView {
     if (!self.isStarted) {
-        self.sampleStart = CACurrentMediaTime();
+        self.sampleStart = ORKClockSystemUptime();
         [self start];
     }
     
@@ -44,6 +44,7 @@
 
 #import "ORKVerticalContainerView_Internal.h"
 #import "ORKHelpers_Internal.h"
+#import "ORKClock.h"
 #import "ORKCollectionResult_Private.h"
 
 
@@ -99,7 +100,7 @@
 #pragma mark - step life cycle methods
 
 - (void)start {
-    self.sampleStart = CACurrentMediaTime();
+    self.sampleStart = ORKClockSystemUptime();
     self.successes = 0;
     self.failures = 0;
     self.samples = [NSMutableArray array];
@@ -140,9 +141,9 @@
 
 - (void)saveSampleWithDistance:(CGFloat)distance {
     ORKHolePegTestSample *sample = [[ORKHolePegTestSample alloc] init];
-    sample.time = CACurrentMediaTime() - self.sampleStart;
+    sample.time = ORKClockSystemUptime() - self.sampleStart;
     sample.distance = distance;
-    self.sampleStart = CACurrentMediaTime();
+    self.sampleStart = ORKClockSystemUptime();
     
     [self.samples addObject:sample];
 }
@@ -50,6 +50,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 // Samples should be in the range of (0, 1).
 - (void)addSample:(NSNumber *)sample;
+- (void)addSamples:(NSArray<NSNumber *> *)samples;
 - (void)removeAllSamples;
 - (void)setGraphViewHidden:(BOOL)hidden;
 
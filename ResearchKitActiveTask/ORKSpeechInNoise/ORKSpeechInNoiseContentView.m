@@ -174,10 +174,15 @@ static CGFloat const ORKSpeechInNoiseContentViewVerticalMargin = 44;
 - (void)addSample:(NSNumber *)sample
 {
     NSAssert(sample != nil, @"Sample should be non-nil");
+    [self addSamples:@[sample]];
+}
+
+- (void)addSamples:(NSArray<NSNumber *> *)samples
+{
     if (!_samples) {
         _samples = [NSMutableArray array];
     }
-    [_samples addObject:sample];
+    [_samples addObjectsFromArray:samples];
     
     _samples = [ORKLastNSamples(_samples, 500) mutableCopy];
     
@@ -0,0 +1,120 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <AVFoundation/AVFoundation.h>
+#import <ResearchKit/ORKDefines.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ORKSpeechInNoiseStep;
+@class ORKSpeechInNoiseStimulusBank;
+
+/**
+ Mixes `frameCount` samples as `(speech + noise * noiseGain) * filter` into `output`.
+ 
+ `filter` may be `NULL`, in which case the mix is not filtered. `output` may alias `speech`.
+ */
+ORK_EXTERN void ORKSpeechInNoiseMix(const float *speech,
+                                    const float *noise,
+                                    float noiseGain,
+                                    const float * _Nullable filter,
+                                    float *output,
+                                    NSUInteger frameCount) ORK_AVAILABLE_DECL;
+
+/// The files and noise gain that make up one speech-in-noise trial.
+@interface ORKSpeechInNoiseStimulus : NSObject <NSCopying>
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Without a noise file the speech is played as recorded, which is what looping steps play.
+ */
+- (instancetype)initWithSpeechURL:(NSURL *)speechURL
+                         noiseURL:(nullable NSURL *)noiseURL
+                        filterURL:(nullable NSURL *)filterURL
+                        noiseGain:(double)noiseGain NS_DESIGNATED_INITIALIZER;
+
+/// Resolves the files of a step, or returns `nil` if one of them cannot be found.
++ (nullable instancetype)stimulusWithStep:(ORKSpeechInNoiseStep *)step;
+
+@property (nonatomic, copy, readonly) NSURL *speechURL;
+
+@property (nonatomic, copy, readonly, nullable) NSURL *noiseURL;
+
+@property (nonatomic, copy, readonly, nullable) NSURL *filterURL;
+
+@property (nonatomic, readonly) double noiseGain;
+
+@end
+
+/**
+ Produces the mixed buffer for each trial from the tracks of a stimulus bank.
+ 
+ Mixes are made lazily, into buffers taken from a pool, and the next trial's mix can be
+ prepared in the background while the current one plays. The mixer is thread-safe.
+ */
+@interface ORKSpeechInNoiseMixer : NSObject
+
++ (ORKSpeechInNoiseMixer *)sharedMixer;
+
+- (instancetype)initWithStimulusBank:(ORKSpeechInNoiseStimulusBank *)stimulusBank NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, readonly) ORKSpeechInNoiseStimulusBank *stimulusBank;
+
+/// The maximum number of idle buffers kept for reuse. Defaults to 2.
+@property (nonatomic) NSUInteger maximumPooledBufferCount;
+
+/// The number of idle buffers in the pool.
+@property (nonatomic, readonly) NSUInteger pooledBufferCount;
+
+/**
+ Returns a mono buffer with the mix for a stimulus, using a prefetched mix if there is one.
+ The noise segment starts at a random offset into the noise track.
+ */
+- (nullable AVAudioPCMBuffer *)bufferForStimulus:(ORKSpeechInNoiseStimulus *)stimulus error:(NSError * _Nullable *)error;
+
+/// Returns a freshly made mix with the noise segment starting at `noiseOffset` frames.
+- (nullable AVAudioPCMBuffer *)bufferForStimulus:(ORKSpeechInNoiseStimulus *)stimulus
+                                     noiseOffset:(uint64_t)noiseOffset
+                                           error:(NSError * _Nullable *)error;
+
+/// Prepares the mix for a stimulus in the background. Only the two most recent prefetches are kept.
+- (void)prefetchStimulus:(ORKSpeechInNoiseStimulus *)stimulus;
+
+/// Returns a buffer that is no longer being played to the pool.
+- (void)recycleBuffer:(AVAudioPCMBuffer *)buffer;
+
+@end
+
+NS_ASSUME_NONNULL_END
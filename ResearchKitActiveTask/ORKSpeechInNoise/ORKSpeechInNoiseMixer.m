@@ -0,0 +1,289 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKSpeechInNoiseMixer.h"
+
+#import "ORKSpeechInNoiseStep.h"
+#import "ORKSpeechInNoiseStimulusBank.h"
+
+#import "ORKErrors.h"
+#import "ORKHelpers_Internal.h"
+
+@import Accelerate;
+
+
+static const NSUInteger ORKSpeechInNoiseMaximumPrefetchCount = 2;
+
+void ORKSpeechInNoiseMix(const float *speech, const float *noise, float noiseGain, const float *filter, float *output, NSUInteger frameCount) {
+    vDSP_vsma(noise, 1, &noiseGain, speech, 1, output, 1, frameCount);
+    if (filter != NULL) {
+        vDSP_vmul(output, 1, filter, 1, output, 1, frameCount);
+    }
+}
+
+static NSError *ORKSpeechInNoiseMixerError(NSString *description) {
+    return [NSError errorWithDomain:ORKErrorDomain code:ORKErrorInvalidObject userInfo:@{NSLocalizedDescriptionKey: description}];
+}
+
+
+@implementation ORKSpeechInNoiseStimulus
+
+- (instancetype)initWithSpeechURL:(NSURL *)speechURL noiseURL:(NSURL *)noiseURL filterURL:(NSURL *)filterURL noiseGain:(double)noiseGain {
+    self = [super init];
+    if (self) {
+        _speechURL = [speechURL copy];
+        _noiseURL = [noiseURL copy];
+        _filterURL = [filterURL copy];
+        _noiseGain = noiseGain;
+    }
+    return self;
+}
+
++ (instancetype)stimulusWithStep:(ORKSpeechInNoiseStep *)step {
+    NSURL *speechURL = nil;
+    if (step.speechFilePath != nil) {
+        speechURL = [NSURL fileURLWithPath:step.speechFilePath isDirectory:NO];
+    } else if (step.speechFileNameWithExtension != nil) {
+        speechURL = [ORKSpeechInNoiseStimulusBank URLForAudioFileNamed:step.speechFileNameWithExtension];
+    }
+    if (speechURL == nil) {
+        return nil;
+    }
+    if (step.willAudioLoop) {
+        return [[self alloc] initWithSpeechURL:speechURL noiseURL:nil filterURL:nil noiseGain:0];
+    }
+    
+    NSURL *noiseURL = step.noiseFileNameWithExtension ? [ORKSpeechInNoiseStimulusBank URLForAudioFileNamed:step.noiseFileNameWithExtension] : nil;
+    NSURL *filterURL = step.filterFileNameWithExtension ? [ORKSpeechInNoiseStimulusBank URLForAudioFileNamed:step.filterFileNameWithExtension] : nil;
+    if ((step.noiseFileNameWithExtension && !noiseURL) || (step.filterFileNameWithExtension && !filterURL)) {
+        return nil;
+    }
+    return [[self alloc] initWithSpeechURL:speechURL noiseURL:noiseURL filterURL:filterURL noiseGain:step.gainAppliedToNoise];
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone {
+    return self;
+}
+
+- (BOOL)isEqual:(id)object {
+    if ([self class] != [object class]) {
+        return NO;
+    }
+    __typeof(self) castObject = object;
+    return (ORKEqualObjects(self.speechURL, castObject.speechURL)
+            && ORKEqualObjects(self.noiseURL, castObject.noiseURL)
+            && ORKEqualObjects(self.filterURL, castObject.filterURL)
+            && self.noiseGain == castObject.noiseGain);
+}
+
+- (NSUInteger)hash {
+    return _speechURL.hash ^ _noiseURL.hash ^ _filterURL.hash ^ @(_noiseGain).hash;
+}
+
+@end
+
+
+@implementation ORKSpeechInNoiseMixer {
+    dispatch_queue_t _queue;
+    dispatch_queue_t _prefetchQueue;
+    NSMutableArray<AVAudioPCMBuffer *> *_pool;
+    NSMutableArray<ORKSpeechInNoiseStimulus *> *_prefetchedStimuli;
+    NSMutableDictionary<ORKSpeechInNoiseStimulus *, AVAudioPCMBuffer *> *_prefetchedBuffers;
+    NSCountedSet<ORKSpeechInNoiseStimulus *> *_stimuliBeingPrefetched;
+}
+
++ (ORKSpeechInNoiseMixer *)sharedMixer {
+    static ORKSpeechInNoiseMixer *sharedMixer = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedMixer = [[ORKSpeechInNoiseMixer alloc] initWithStimulusBank:[ORKSpeechInNoiseStimulusBank sharedBank]];
+    });
+    return sharedMixer;
+}
+
+- (instancetype)initWithStimulusBank:(ORKSpeechInNoiseStimulusBank *)stimulusBank {
+    self = [super init];
+    if (self) {
+        _stimulusBank = stimulusBank;
+        _maximumPooledBufferCount = 2;
+        _queue = dispatch_queue_create("org.researchkit.speechinnoise.mixer", DISPATCH_QUEUE_SERIAL);
+        _prefetchQueue = dispatch_queue_create("org.researchkit.speechinnoise.prefetch", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_USER_INITIATED, 0));
+        _pool = [NSMutableArray new];
+        _prefetchedStimuli = [NSMutableArray new];
+        _prefetchedBuffers = [NSMutableDictionary new];
+        _stimuliBeingPrefetched = [NSCountedSet new];
+    }
+    return self;
+}
+
+- (NSUInteger)pooledBufferCount {
+    __block NSUInteger count = 0;
+    dispatch_sync(_queue, ^{
+        count = _pool.count;
+    });
+    return count;
+}
+
+- (AVAudioPCMBuffer *)dequeueBufferWithFormat:(AVAudioFormat *)format frameCapacity:(AVAudioFrameCount)frameCapacity {
+    __block AVAudioPCMBuffer *buffer = nil;
+    dispatch_sync(_queue, ^{
+        for (AVAudioPCMBuffer *pooledBuffer in _pool) {
+            if ([pooledBuffer.format isEqual:format] && pooledBuffer.frameCapacity >= frameCapacity) {
+                buffer = pooledBuffer;
+                break;
+            }
+        }
+        if (buffer) {
+            [_pool removeObjectIdenticalTo:buffer];
+        }
+    });
+    if (!buffer) {
+        buffer = [[AVAudioPCMBuffer alloc] initWithPCMFormat:format frameCapacity:frameCapacity];
+    }
+    buffer.frameLength = frameCapacity;
+    return buffer;
+}
+
+- (void)recycleBuffer:(AVAudioPCMBuffer *)buffer {
+    dispatch_sync(_queue, ^{
+        if (_pool.count < _maximumPooledBufferCount && [_pool indexOfObjectIdenticalTo:buffer] == NSNotFound) {
+            [_pool addObject:buffer];
+        }
+    });
+}
+
+- (AVAudioPCMBuffer *)bufferForStimulus:(ORKSpeechInNoiseStimulus *)stimulus error:(NSError **)error {
+    __block BOOL beingPrefetched = NO;
+    dispatch_sync(_queue, ^{
+        beingPrefetched = [_stimuliBeingPrefetched containsObject:stimulus];
+    });
+    if (beingPrefetched) {
+        // Finishing the prefetch in flight is quicker than starting the mix again.
+        dispatch_sync(_prefetchQueue, ^{});
+    }
+    
+    __block AVAudioPCMBuffer *buffer = nil;
+    dispatch_sync(_queue, ^{
+        buffer = _prefetchedBuffers[stimulus];
+        if (buffer) {
+            [_prefetchedBuffers removeObjectForKey:stimulus];
+            [_prefetchedStimuli removeObject:stimulus];
+        }
+    });
+    if (buffer) {
+        return buffer;
+    }
+    return [self bufferForStimulus:stimulus noiseOffset:UINT64_MAX error:error];
+}
+
+- (AVAudioPCMBuffer *)bufferForStimulus:(ORKSpeechInNoiseStimulus *)stimulus noiseOffset:(uint64_t)noiseOffset error:(NSError **)error {
+    ORKSpeechInNoisePCMTrack *speech = [_stimulusBank trackForAudioFileAtURL:stimulus.speechURL error:error];
+    if (!speech) {
+        return nil;
+    }
+    ORKSpeechInNoisePCMTrack *noise = nil;
+    if (stimulus.noiseURL) {
+        noise = [_stimulusBank trackForAudioFileAtURL:stimulus.noiseURL error:error];
+        if (!noise) {
+            return nil;
+        }
+    }
+    ORKSpeechInNoisePCMTrack *filter = nil;
+    if (stimulus.noiseURL && stimulus.filterURL) {
+        filter = [_stimulusBank trackForAudioFileAtURL:stimulus.filterURL error:error];
+        if (!filter) {
+            return nil;
+        }
+    }
+    
+    // The filter window sets the length of the trial, as it fades the mix in and out.
+    uint64_t frameCount = filter ? MIN(speech.frameCount, filter.frameCount) : speech.frameCount;
+    if ((noise && (noise.sampleRate != speech.sampleRate || noise.frameCount < frameCount)) ||
+        (filter && filter.sampleRate != speech.sampleRate) || frameCount > UINT32_MAX) {
+        if (error) {
+            *error = ORKSpeechInNoiseMixerError(@"The speech, noise and filter files do not match");
+        }
+        return nil;
+    }
+    
+    AVAudioFormat *format = [[AVAudioFormat alloc] initStandardFormatWithSampleRate:speech.sampleRate channels:1];
+    AVAudioPCMBuffer *buffer = [self dequeueBufferWithFormat:format frameCapacity:(AVAudioFrameCount)frameCount];
+    float *output = buffer.floatChannelData[0];
+    
+    if (noise) {
+        uint64_t maximumOffset = noise.frameCount - frameCount;
+        if (noiseOffset == UINT64_MAX) {
+            noiseOffset = (maximumOffset > 0) ? arc4random_uniform((uint32_t)MIN(maximumOffset, UINT32_MAX)) : 0;
+        }
+        noiseOffset = MIN(noiseOffset, maximumOffset);
+        ORKSpeechInNoiseMix(speech.samples, noise.samples + noiseOffset, (float)stimulus.noiseGain,
+                            filter ? filter.samples : NULL, output, (NSUInteger)frameCount);
+    } else {
+        memcpy(output, speech.samples, (size_t)frameCount * sizeof(float));
+    }
+    return buffer;
+}
+
+- (void)prefetchStimulus:(ORKSpeechInNoiseStimulus *)stimulus {
+    __block BOOL alreadyPrefetched = NO;
+    dispatch_sync(_queue, ^{
+        alreadyPrefetched = (_prefetchedBuffers[stimulus] != nil || [_stimuliBeingPrefetched containsObject:stimulus]);
+        if (!alreadyPrefetched) {
+            [_stimuliBeingPrefetched addObject:stimulus];
+        }
+    });
+    if (alreadyPrefetched) {
+        return;
+    }
+    
+    dispatch_async(_prefetchQueue, ^{
+        AVAudioPCMBuffer *buffer = [self bufferForStimulus:stimulus noiseOffset:UINT64_MAX error:nil];
+        dispatch_sync(_queue, ^{
+            [_stimuliBeingPrefetched removeObject:stimulus];
+            if (!buffer) {
+                return;
+            }
+            _prefetchedBuffers[stimulus] = buffer;
+            [_prefetchedStimuli addObject:stimulus];
+            if (_prefetchedStimuli.count > ORKSpeechInNoiseMaximumPrefetchCount) {
+                ORKSpeechInNoiseStimulus *oldestStimulus = _prefetchedStimuli.firstObject;
+                [_prefetchedStimuli removeObjectAtIndex:0];
+                AVAudioPCMBuffer *oldestBuffer = _prefetchedBuffers[oldestStimulus];
+                [_prefetchedBuffers removeObjectForKey:oldestStimulus];
+                if (_pool.count < _maximumPooledBufferCount) {
+                    [_pool addObject:oldestBuffer];
+                }
+            }
+        });
+    });
+}
+
+@end
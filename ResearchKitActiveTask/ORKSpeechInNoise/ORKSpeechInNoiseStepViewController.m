@@ -37,8 +37,11 @@
 #import "ORKSpeechInNoiseStepViewController_Private.h"
 #import "ORKStepContainerView_Private.h"
 #import "ORKSpeechInNoiseContentView.h"
+#import "ORKSpeechInNoiseMixer.h"
 #import "ORKSpeechInNoiseStep.h"
 #import "ORKSpeechInNoiseResult.h"
+#import "ORKSpeechInNoiseStimulusBank.h"
+#import "ORKAudioLevelMeter.h"
 
 #import "ORKCollectionResult_Private.h"
 #import "ORKHelpers_Internal.h"
@@ -56,13 +59,9 @@
     AVAudioEngine *_audioEngine;
     AVAudioPlayerNode *_playerNode;
     AVAudioMixerNode *_mixerNode;
-    float _peakPower;
+    ORKAudioLevelMeter *_levelMeter;
     float _toneDuration;
-    AVAudioPCMBuffer *_noiseAudioBuffer;
-    AVAudioPCMBuffer *_speechAudioBuffer;
-    AVAudioPCMBuffer *_filterAudioBuffer;
-    AVAudioFrameCount _speechToneCapacity;
-    AVAudioFrameCount _noiseToneCapacity;
+    AVAudioPCMBuffer *_stimulusAudioBuffer;
     BOOL _installedTap;
 }
 
@@ -73,9 +72,6 @@
 - (void)viewDidLoad {
     [super viewDidLoad];
     
-    _noiseAudioBuffer = [[AVAudioPCMBuffer alloc] init];
-    _speechAudioBuffer = [[AVAudioPCMBuffer alloc] init];
-    _filterAudioBuffer = [[AVAudioPCMBuffer alloc] init];
     _installedTap = NO;
     
     [self setupContentView];
@@ -104,11 +100,12 @@
     [super viewWillDisappear:animated];
     if (_playerNode) {
         [_playerNode stop];
-        [_mixerNode removeTapOnBus:0];
+        [self removeTap];
         [_audioEngine stop];
-        _noiseAudioBuffer = nil;
-        _speechAudioBuffer = nil;
-        _filterAudioBuffer = nil;
+        if (_stimulusAudioBuffer) {
+            [[ORKSpeechInNoiseMixer sharedMixer] recycleBuffer:_stimulusAudioBuffer];
+            _stimulusAudioBuffer = nil;
+        }
         _audioEngine = nil;
         _playerNode = nil;
         _mixerNode = nil;
@@ -116,105 +113,84 @@
 }
 
 - (void)setupBuffers {
-    
-    if ([[self speechInNoiseStep] speechFilePath] != nil)
-    {
-        NSURL *url = [NSURL fileURLWithPath:[self speechInNoiseStep].speechFilePath isDirectory:NO];
-        [self loadFileAtURL:url intoBuffer:&_speechAudioBuffer];
+    // The corpus is decoded once into the shared stimulus bank; each trial only mixes the
+    // mapped tracks, or takes the mix prefetched while the previous trial was playing.
+    ORKSpeechInNoiseMixer *mixer = [ORKSpeechInNoiseMixer sharedMixer];
+    if (_stimulusAudioBuffer) {
+        [mixer recycleBuffer:_stimulusAudioBuffer];
     }
-    else
-    {
-        [self loadFileName:[self speechInNoiseStep].speechFileNameWithExtension intoBuffer:&_speechAudioBuffer];
+    ORKSpeechInNoiseStimulus *stimulus = [ORKSpeechInNoiseStimulus stimulusWithStep:[self speechInNoiseStep]];
+    NSError *error = nil;
+    _stimulusAudioBuffer = stimulus ? [mixer bufferForStimulus:stimulus error:&error] : nil;
+    if (!_stimulusAudioBuffer) {
+        ORK_Log_Error("Failed to prepare the speech in noise stimulus: %@", error);
+        return;
     }
-    
-    [self loadFileName:[self speechInNoiseStep].noiseFileNameWithExtension intoBuffer:&_noiseAudioBuffer];
-    [self loadFileName:[self speechInNoiseStep].filterFileNameWithExtension intoBuffer:&_filterAudioBuffer];
+    _toneDuration = _stimulusAudioBuffer.frameLength / _stimulusAudioBuffer.format.sampleRate;
     
     _mixerNode = _audioEngine.mainMixerNode;
-    [_audioEngine connect:_playerNode to:_mixerNode format:_speechAudioBuffer.format];
+    [_audioEngine connect:_playerNode to:_mixerNode format:_stimulusAudioBuffer.format];
     [_audioEngine startAndReturnError:nil];
     
-    if ([self speechInNoiseStep].willAudioLoop) {
-        [_playerNode scheduleBuffer:_speechAudioBuffer atTime:nil options:AVAudioPlayerNodeBufferLoops completionHandler:nil];
-    } else {
-        int randomOffset = arc4random_uniform(_noiseToneCapacity - _speechToneCapacity);
-        for (int i = 0; i < _speechToneCapacity; i++) {
-            _speechAudioBuffer.floatChannelData[0][i] += _noiseAudioBuffer.floatChannelData[0][i + randomOffset] * [self speechInNoiseStep].gainAppliedToNoise;
-        }
-        for (int i = 0; i < _speechToneCapacity; i++) {
-            _speechAudioBuffer.floatChannelData[0][i] *= _filterAudioBuffer.floatChannelData[0][i];
-        }
-        [_playerNode scheduleBuffer:_speechAudioBuffer atTime:nil options:AVAudioPlayerNodeBufferInterrupts completionHandler:nil];
-    }
-}
-
-- (void)loadFileAtURL:(NSURL *)url intoBuffer:(AVAudioPCMBuffer * __strong *)buffer {
-    
-    AVAudioFile *audioFile = [[AVAudioFile alloc] initForReading:url error:nil];
-    AVAudioFormat *audioFileFormat = audioFile.processingFormat;
-    AVAudioFrameCount audioFileCapacity = (AVAudioFrameCount)audioFile.length;
-    
-    if (*buffer == _filterAudioBuffer)
-    {
-        _speechToneCapacity = audioFileCapacity;
-    }
-    else if (*buffer == _noiseAudioBuffer)
-    {
-        _noiseToneCapacity = audioFileCapacity;
-    }
-    else
-    {
-        AVAsset *asset = [AVURLAsset URLAssetWithURL:url options:nil];
-        CMTime audioDuration = asset.duration;
-        _toneDuration = CMTimeGetSeconds(audioDuration);
-    }
-    
-    *buffer = [[AVAudioPCMBuffer alloc] initWithPCMFormat:audioFileFormat frameCapacity:audioFileCapacity];
+    AVAudioPlayerNodeBufferOptions options = [self speechInNoiseStep].willAudioLoop ? AVAudioPlayerNodeBufferLoops : AVAudioPlayerNodeBufferInterrupts;
+    [_playerNode scheduleBuffer:_stimulusAudioBuffer atTime:nil options:options completionHandler:nil];
     
-    [audioFile readIntoBuffer:*buffer error:nil];
+    [self prefetchNextStimulus];
 }
 
-- (void)loadFileName: (NSString *)file intoBuffer: (AVAudioPCMBuffer * __strong *)buffer {
-    NSArray *fileComponents = [file componentsSeparatedByString:@"."];
-    NSString *fileName = fileComponents[0];
-    NSString *fileExtension = fileComponents[1];
-    
-    NSURL *fileURL = [[NSBundle bundleForClass:[self class]] URLForResource:fileName withExtension:fileExtension];
-    
-    if (fileURL == nil) {
-        fileURL = [[NSBundle mainBundle] URLForResource:fileName withExtension:fileExtension];
+- (void)prefetchNextStimulus {
+    ORKTaskViewController *taskViewController = self.taskViewController;
+    if (!taskViewController) {
+        return;
+    }
+    // Trials are usually separated by a speech recognition step, so look a few steps ahead.
+    ORKTaskResult *taskResult = taskViewController.result;
+    ORKStep *nextStep = self.step;
+    for (NSInteger lookahead = 0; lookahead < 4 && nextStep; lookahead++) {
+        nextStep = [taskViewController.task stepAfterStep:nextStep withResult:taskResult];
+        if ([nextStep isKindOfClass:[ORKSpeechInNoiseStep class]]) {
+            ORKSpeechInNoiseStimulus *nextStimulus = [ORKSpeechInNoiseStimulus stimulusWithStep:(ORKSpeechInNoiseStep *)nextStep];
+            if (nextStimulus) {
+                [[ORKSpeechInNoiseMixer sharedMixer] prefetchStimulus:nextStimulus];
+            }
+            return;
+        }
     }
-    
-    [self loadFileAtURL:fileURL intoBuffer:buffer];
 }
 
 - (void)installTap {
     
     AVAudioFormat *mainMixerFormat = [[_audioEngine mainMixerNode] outputFormatForBus:0];
     
+    // The tap only writes levels into the meter; the graph drains them once per display refresh.
+    if (!_levelMeter) {
+        _levelMeter = [ORKAudioLevelMeter new];
+    }
+    ORKAudioLevelMeter *levelMeter = _levelMeter;
     [_mixerNode installTapOnBus:0 bufferSize:64 format:mainMixerFormat block:^(AVAudioPCMBuffer * _Nonnull buffer5, AVAudioTime * _Nonnull when) {
         float * const *channelData = [buffer5 floatChannelData];
         if (channelData[0]) {
-            float avgValue = 0;
-            unsigned long nFrames = [buffer5 frameLength];
-            
-            vDSP_maxmgv(channelData[0], 1 , &avgValue, nFrames);
-            float lvlLowPassTrig = 0.3;
-            self->_peakPower = lvlLowPassTrig * ((avgValue == 0)? -100 : 20* log10(avgValue)) + (1 - lvlLowPassTrig) * self->_peakPower;
-            float clampedValue = MAX(self->_peakPower / 60.0, -1) + 1;
-            
-            dispatch_async(dispatch_get_main_queue(), ^{
-                [self->_speechInNoiseContentView addSample:@(clampedValue)];
-            });
+            [levelMeter writePeakLevelOfSamples:channelData[0] frameCount:[buffer5 frameLength]];
         }
     }];
     
+    ORKWeakTypeOf(self) weakSelf = self;
+    [_levelMeter startDisplayUpdatesWithHandler:^(NSArray<NSNumber *> *levels) {
+        ORKStrongTypeOf(weakSelf) strongSelf = weakSelf;
+        [strongSelf.speechInNoiseContentView addSamples:levels];
+    }];
+}
+
+- (void)removeTap {
+    [_mixerNode removeTapOnBus:0];
+    [_levelMeter stopDisplayUpdates];
+    [_levelMeter discardLevels];
 }
 
 - (void)tapButtonPressed {
     if (_playerNode.isPlaying) {
         [_playerNode stop];
-        [_mixerNode removeTapOnBus:0];
+        [self removeTap];
         [self finish];
     } else {
         [self.navigationItem setHidesBackButton:YES animated:YES];
@@ -234,7 +210,7 @@
             dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(_toneDuration * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
                 ORKStrongTypeOf(weakSelf) strongSelf = weakSelf;
                 [self->_playerNode stop];
-                [self->_mixerNode removeTapOnBus:0];
+                [self removeTap];
                 
                 if (![self shouldBlockFinishOfStep]) {
                     [strongSelf finish];
@@ -0,0 +1,86 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The decoded samples of one audio file, as 32-bit float PCM of its first channel.
+ 
+ The samples are memory-mapped from the bank's cache file, so they are backed by clean pages
+ that the system can evict and that are shared by every trial playing the same file.
+ */
+@interface ORKSpeechInNoisePCMTrack : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, readonly) const float *samples NS_RETURNS_INNER_POINTER;
+
+@property (nonatomic, readonly) uint64_t frameCount;
+
+@property (nonatomic, readonly) double sampleRate;
+
+@property (nonatomic, readonly) NSTimeInterval duration;
+
+@end
+
+/**
+ Decodes the speech-in-noise corpus once into a PCM cache on disk and maps it back on demand.
+ 
+ Decoding happens the first time a file is requested; afterwards tracks are mapped from the
+ cache file without touching the compressed or integer source, across trials and launches.
+ The bank is thread-safe.
+ */
+@interface ORKSpeechInNoiseStimulusBank : NSObject
+
+/// The bank shared by all speech-in-noise steps, caching into the app's caches directory.
++ (ORKSpeechInNoiseStimulusBank *)sharedBank;
+
+- (instancetype)initWithCacheDirectoryURL:(NSURL *)cacheDirectoryURL NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, copy, readonly) NSURL *cacheDirectoryURL;
+
+/// Returns the track for an audio file, decoding it into the cache if needed.
+- (nullable ORKSpeechInNoisePCMTrack *)trackForAudioFileAtURL:(NSURL *)url error:(NSError * _Nullable *)error;
+
+/// Releases the mapped tracks and deletes the cache files.
+- (void)removeCachedTracks;
+
+/// Resolves a file name such as `Sentence1.wav` in the framework bundle, then the main bundle.
++ (nullable NSURL *)URLForAudioFileNamed:(NSString *)fileNameWithExtension;
+
+@end
+
+NS_ASSUME_NONNULL_END
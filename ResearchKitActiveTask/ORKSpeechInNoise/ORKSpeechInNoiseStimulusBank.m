@@ -0,0 +1,241 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKSpeechInNoiseStimulusBank.h"
+
+#import "ORKSpeechInNoiseStep.h"
+
+#import "ORKErrors.h"
+#import "ORKHelpers_Internal.h"
+
+#import <AVFoundation/AVFoundation.h>
+
+
+static const uint32_t ORKPCMCacheMagic = 0x504B524F; // "ORKP"
+static const uint32_t ORKPCMCacheVersion = 1;
+static const AVAudioFrameCount ORKPCMCacheDecodeChunkFrames = 32768;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    double sampleRate;
+    uint64_t frameCount;
+} ORKPCMCacheHeader;
+
+static NSError *ORKStimulusBankError(NSString *description, NSError *underlyingError) {
+    NSMutableDictionary *userInfo = [NSMutableDictionary dictionaryWithObject:description forKey:NSLocalizedDescriptionKey];
+    if (underlyingError) {
+        userInfo[NSUnderlyingErrorKey] = underlyingError;
+    }
+    return [NSError errorWithDomain:ORKErrorDomain code:ORKErrorInvalidObject userInfo:userInfo];
+}
+
+
+@implementation ORKSpeechInNoisePCMTrack {
+    NSData *_data;
+}
+
+- (nullable instancetype)initWithMappedData:(NSData *)data {
+    if (data.length < sizeof(ORKPCMCacheHeader)) {
+        return nil;
+    }
+    ORKPCMCacheHeader header;
+    memcpy(&header, data.bytes, sizeof(header));
+    if (header.magic != ORKPCMCacheMagic || header.version != ORKPCMCacheVersion || header.sampleRate <= 0 ||
+        data.length != sizeof(header) + header.frameCount * sizeof(float)) {
+        return nil;
+    }
+    self = [super init];
+    if (self) {
+        _data = data;
+        _frameCount = header.frameCount;
+        _sampleRate = header.sampleRate;
+    }
+    return self;
+}
+
+- (const float *)samples {
+    return (const float *)((const uint8_t *)_data.bytes + sizeof(ORKPCMCacheHeader));
+}
+
+- (NSTimeInterval)duration {
+    return _frameCount / _sampleRate;
+}
+
+@end
+
+
+@implementation ORKSpeechInNoiseStimulusBank {
+    dispatch_queue_t _queue;
+    NSMutableDictionary<NSString *, ORKSpeechInNoisePCMTrack *> *_tracks;
+}
+
++ (ORKSpeechInNoiseStimulusBank *)sharedBank {
+    static ORKSpeechInNoiseStimulusBank *sharedBank = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSURL *cachesURL = [[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask].firstObject;
+        sharedBank = [[ORKSpeechInNoiseStimulusBank alloc] initWithCacheDirectoryURL:[cachesURL URLByAppendingPathComponent:@"ORKSpeechInNoise" isDirectory:YES]];
+    });
+    return sharedBank;
+}
+
+- (instancetype)initWithCacheDirectoryURL:(NSURL *)cacheDirectoryURL {
+    self = [super init];
+    if (self) {
+        _cacheDirectoryURL = [cacheDirectoryURL copy];
+        _queue = dispatch_queue_create("org.researchkit.speechinnoise.bank", DISPATCH_QUEUE_SERIAL);
+        _tracks = [NSMutableDictionary new];
+    }
+    return self;
+}
+
++ (nullable NSURL *)URLForAudioFileNamed:(NSString *)fileNameWithExtension {
+    NSString *fileName = fileNameWithExtension.stringByDeletingPathExtension;
+    NSString *fileExtension = fileNameWithExtension.pathExtension;
+    NSURL *fileURL = [[NSBundle bundleForClass:[ORKSpeechInNoiseStep class]] URLForResource:fileName withExtension:fileExtension];
+    if (fileURL == nil) {
+        fileURL = [[NSBundle mainBundle] URLForResource:fileName withExtension:fileExtension];
+    }
+    return fileURL;
+}
+
+- (NSString *)cacheFileNameForAudioFileAtURL:(NSURL *)url {
+    // Keyed by path, size and modification date so that a replaced source file is decoded again.
+    NSDictionary<NSFileAttributeKey, id> *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:url.path error:nil];
+    unsigned long long size = [attributes fileSize];
+    unsigned long long modificationTime = (unsigned long long)[[attributes fileModificationDate] timeIntervalSince1970];
+    return [NSString stringWithFormat:@"%@-%lx-%llx-%llx.pcm",
+            url.lastPathComponent.stringByDeletingPathExtension, (unsigned long)url.path.hash, size, modificationTime];
+}
+
+- (nullable ORKSpeechInNoisePCMTrack *)trackForAudioFileAtURL:(NSURL *)url error:(NSError **)error {
+    __block ORKSpeechInNoisePCMTrack *track = nil;
+    __block NSError *trackError = nil;
+    dispatch_sync(_queue, ^{
+        track = [self queue_trackForAudioFileAtURL:url error:&trackError];
+    });
+    if (!track && error) {
+        *error = trackError;
+    }
+    return track;
+}
+
+- (nullable ORKSpeechInNoisePCMTrack *)queue_trackForAudioFileAtURL:(NSURL *)url error:(NSError **)error {
+    NSString *cacheFileName = [self cacheFileNameForAudioFileAtURL:url];
+    ORKSpeechInNoisePCMTrack *track = _tracks[cacheFileName];
+    if (track) {
+        return track;
+    }
+    
+    NSURL *cacheFileURL = [_cacheDirectoryURL URLByAppendingPathComponent:cacheFileName isDirectory:NO];
+    NSData *data = [NSData dataWithContentsOfURL:cacheFileURL options:NSDataReadingMappedAlways error:nil];
+    track = data ? [[ORKSpeechInNoisePCMTrack alloc] initWithMappedData:data] : nil;
+    if (!track) {
+        if (![self decodeAudioFileAtURL:url toCacheFileURL:cacheFileURL error:error]) {
+            return nil;
+        }
+        data = [NSData dataWithContentsOfURL:cacheFileURL options:NSDataReadingMappedAlways error:error];
+        track = data ? [[ORKSpeechInNoisePCMTrack alloc] initWithMappedData:data] : nil;
+        if (!track) {
+            if (error && data) {
+                *error = ORKStimulusBankError(@"The cached PCM file is invalid", nil);
+            }
+            return nil;
+        }
+    }
+    _tracks[cacheFileName] = track;
+    return track;
+}
+
+- (BOOL)decodeAudioFileAtURL:(NSURL *)url toCacheFileURL:(NSURL *)cacheFileURL error:(NSError **)error {
+    NSError *underlyingError = nil;
+    AVAudioFile *audioFile = [[AVAudioFile alloc] initForReading:url error:&underlyingError];
+    if (!audioFile) {
+        if (error) {
+            *error = ORKStimulusBankError(@"The audio file could not be opened", underlyingError);
+        }
+        return NO;
+    }
+    
+    if (![[NSFileManager defaultManager] createDirectoryAtURL:_cacheDirectoryURL withIntermediateDirectories:YES attributes:nil error:error]) {
+        return NO;
+    }
+    
+    // Decode in chunks into a temporary file, so the whole file is never resident at once.
+    NSURL *temporaryURL = [cacheFileURL URLByAppendingPathExtension:[NSUUID UUID].UUIDString];
+    FILE *file = fopen(temporaryURL.fileSystemRepresentation, "wb");
+    if (file == NULL) {
+        if (error) {
+            *error = ORKStimulusBankError(@"The PCM cache file could not be created", nil);
+        }
+        return NO;
+    }
+    
+    ORKPCMCacheHeader header = { ORKPCMCacheMagic, ORKPCMCacheVersion, audioFile.processingFormat.sampleRate, 0 };
+    BOOL success = (fwrite(&header, sizeof(header), 1, file) == 1);
+    AVAudioPCMBuffer *buffer = [[AVAudioPCMBuffer alloc] initWithPCMFormat:audioFile.processingFormat frameCapacity:ORKPCMCacheDecodeChunkFrames];
+    while (success && audioFile.framePosition < audioFile.length) {
+        success = [audioFile readIntoBuffer:buffer error:&underlyingError];
+        if (success && buffer.frameLength == 0) {
+            break;
+        }
+        if (success) {
+            success = (fwrite(buffer.floatChannelData[0], sizeof(float), buffer.frameLength, file) == buffer.frameLength);
+            header.frameCount += buffer.frameLength;
+        }
+    }
+    if (success) {
+        success = (fseek(file, 0, SEEK_SET) == 0) && (fwrite(&header, sizeof(header), 1, file) == 1);
+    }
+    success = (fclose(file) == 0) && success;
+    
+    if (success) {
+        [[NSFileManager defaultManager] removeItemAtURL:cacheFileURL error:nil];
+        success = [[NSFileManager defaultManager] moveItemAtURL:temporaryURL toURL:cacheFileURL error:&underlyingError];
+    }
+    if (!success) {
+        [[NSFileManager defaultManager] removeItemAtURL:temporaryURL error:nil];
+        if (error) {
+            *error = ORKStimulusBankError(@"The audio file could not be decoded", underlyingError);
+        }
+    }
+    return success;
+}
+
+- (void)removeCachedTracks {
+    dispatch_sync(_queue, ^{
+        [_tracks removeAllObjects];
+        [[NSFileManager defaultManager] removeItemAtURL:_cacheDirectoryURL error:nil];
+    });
+}
+
+@end
@@ -0,0 +1,93 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <ResearchKitActiveTask/ORKPSATResult.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ORKPSATStep;
+@class ORKRandomNumberGenerator;
+
+/**
+ The UI-free state machine behind the PSAT step.
+ 
+ The engine is driven by two events: `advanceAtTime:` when the next digit is presented, and
+ `submitAnswer:atTime:` when the participant picks a sum. Times are supplied by the caller, so a
+ scripted session produces the same result as one driven by the step view controller.
+ */
+@interface ORKPSATEngine : NSObject
+
+/**
+ Returns `seriesLength + 1` digits between 1 and 9, with no digit repeated twice in a row.
+ */
++ (NSArray<NSNumber *> *)digitsWithSeriesLength:(NSInteger)seriesLength
+                          randomNumberGenerator:(ORKRandomNumberGenerator *)randomNumberGenerator;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Returns an engine presenting `digits`, which must hold `seriesLength + 1` values.
+ */
+- (instancetype)initWithPSATStep:(ORKPSATStep *)step digits:(NSArray<NSNumber *> *)digits NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, copy, readonly) NSArray<NSNumber *> *digits;
+
+/**
+ The index of the digit currently presented. The initial digit has index 0.
+ */
+@property (nonatomic, readonly) NSUInteger currentDigitIndex;
+
+/**
+ The digit currently presented, or nil once the series is over.
+ */
+@property (nonatomic, readonly, nullable) NSNumber *currentDigit;
+
+@property (nonatomic, readonly, getter=isFinished) BOOL finished;
+
+@property (nonatomic, copy, readonly) NSArray<ORKPSATSample *> *samples;
+
+/**
+ Closes the answer window for the current digit, recording a sample for it, and presents the next digit.
+ */
+- (void)advanceAtTime:(NSTimeInterval)time;
+
+/**
+ Records `answer` as the sum for the current digit. A later answer for the same digit replaces it.
+ */
+- (void)submitAnswer:(NSInteger)answer atTime:(NSTimeInterval)time;
+
+- (ORKPSATResult *)resultWithIdentifier:(NSString *)identifier;
+
+@end
+
+NS_ASSUME_NONNULL_END
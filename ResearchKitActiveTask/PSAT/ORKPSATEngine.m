@@ -0,0 +1,154 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKPSATEngine.h"
+
+#import "ORKPSATStep.h"
+#import "ORKRandomNumberGenerator.h"
+
+#import "ORKHelpers_Internal.h"
+
+
+@implementation ORKPSATEngine {
+    ORKPSATStep *_step;
+    NSMutableArray<ORKPSATSample *> *_samples;
+    NSInteger _currentAnswer;
+    NSTimeInterval _answerStart;
+    NSTimeInterval _answerEnd;
+}
+
++ (NSArray<NSNumber *> *)digitsWithSeriesLength:(NSInteger)seriesLength
+                          randomNumberGenerator:(ORKRandomNumberGenerator *)randomNumberGenerator {
+    NSMutableArray *array = [[NSMutableArray alloc] initWithCapacity:seriesLength + 1];
+    NSUInteger digit = 0;
+    for (NSInteger i = 0; i < seriesLength + 1; i++) {
+        do
+        {
+            digit = [randomNumberGenerator uniformIntegerLessThan:9] + 1;
+        } while (digit == ((NSNumber *)[array lastObject]).integerValue);
+        [array addObject:@(digit)];
+    }
+    return [array copy];
+}
+
+- (instancetype)init {
+    ORKThrowMethodUnavailableException();
+}
+
+- (instancetype)initWithPSATStep:(ORKPSATStep *)step digits:(NSArray<NSNumber *> *)digits {
+    NSParameterAssert(digits.count == (NSUInteger)step.seriesLength + 1);
+    self = [super init];
+    if (self) {
+        _step = step;
+        _digits = [digits copy];
+        _samples = [NSMutableArray arrayWithCapacity:step.seriesLength];
+        _currentAnswer = -1;
+    }
+    return self;
+}
+
+- (NSNumber *)currentDigit {
+    return _currentDigitIndex < _digits.count ? _digits[_currentDigitIndex] : nil;
+}
+
+- (BOOL)isFinished {
+    return _currentDigitIndex >= _digits.count;
+}
+
+- (NSArray<ORKPSATSample *> *)samples {
+    return [_samples copy];
+}
+
+- (void)advanceAtTime:(NSTimeInterval)time {
+    if (self.finished) {
+        return;
+    }
+    if (_currentDigitIndex > 0) {
+        [self saveSample];
+    }
+    _currentDigitIndex++;
+    _answerStart = time;
+    _answerEnd = 0;
+    _currentAnswer = -1;
+}
+
+- (void)submitAnswer:(NSInteger)answer atTime:(NSTimeInterval)time {
+    if (_currentDigitIndex == 0 || self.finished) {
+        return;
+    }
+    _currentAnswer = answer;
+    _answerEnd = time;
+}
+
+- (void)saveSample {
+    ORKPSATSample *sample = [[ORKPSATSample alloc] init];
+    NSInteger previousDigit = _digits[_currentDigitIndex - 1].integerValue;
+    NSInteger currentDigit = _digits[_currentDigitIndex].integerValue;
+    sample.correct = previousDigit + currentDigit == _currentAnswer ? YES : NO;
+    sample.digit = currentDigit;
+    sample.answer = _currentAnswer;
+    sample.time = _answerEnd == 0 ? _step.interStimulusInterval : _answerEnd - _answerStart;
+    [_samples addObject:sample];
+}
+
+- (ORKPSATResult *)resultWithIdentifier:(NSString *)identifier {
+    ORKPSATResult *PSATResult = [[ORKPSATResult alloc] initWithIdentifier:identifier];
+    PSATResult.presentationMode = _step.presentationMode;
+    PSATResult.interStimulusInterval = _step.interStimulusInterval;
+    if (_step.presentationMode & ORKPSATPresentationModeVisual) {
+        PSATResult.stimulusDuration = _step.stimulusDuration;
+    } else {
+        PSATResult.stimulusDuration = 0.0;
+    }
+    PSATResult.length = _step.seriesLength;
+    PSATResult.initialDigit = _digits.firstObject.integerValue;
+    NSInteger totalCorrect = 0;
+    BOOL previousAnswerCorrect = NO;
+    NSInteger totalDyad = 0;
+    NSTimeInterval totalTime = 0.0;
+    for (ORKPSATSample *sample in _samples) {
+        totalTime += sample.time;
+        if (sample.isCorrect) {
+            totalCorrect++;
+            if (previousAnswerCorrect) {
+                totalDyad++;
+            }
+        }
+        previousAnswerCorrect = sample.isCorrect;
+    }
+    PSATResult.totalCorrect = totalCorrect;
+    PSATResult.totalTime = totalTime;
+    PSATResult.totalDyad = totalDyad;
+    PSATResult.samples = [_samples copy];
+    return PSATResult;
+}
+
+@end
@@ -41,24 +41,21 @@
 
 #import "ORKActiveStepViewController_Internal.h"
 #import "ORKCollectionResult_Private.h"
+#import "ORKPSATEngine.h"
 #import "ORKPSATResult.h"
 #import "ORKPSATStep.h"
 #import "ORKResult.h"
 #import "ORKStepViewController_Internal.h"
 
 #import "ORKHelpers_Internal.h"
+#import "ORKClock.h"
 
 
 @interface ORKPSATStepViewController () <ORKPSATKeyboardViewDelegate>
 
-@property (nonatomic, strong) NSMutableArray *samples;
 @property (nonatomic, strong) ORKPSATContentView *psatContentView;
-@property (nonatomic, strong) NSArray<NSNumber *> *digits;
-@property (nonatomic, assign) NSUInteger currentDigitIndex;
-@property (nonatomic, assign) NSInteger currentAnswer;
+@property (nonatomic, strong) ORKPSATEngine *engine;
 @property (nonatomic, strong) ORKActiveStepTimer *clearDigitsTimer;
-@property (nonatomic, assign) NSTimeInterval answerStart;
-@property (nonatomic, assign) NSTimeInterval answerEnd;
 
 @end
 
@@ -80,19 +77,6 @@
     return (ORKPSATStep *)self.step;
 }
 
-- (NSArray *)arrayWithPSATDigits {
-    NSMutableArray *array = [[NSMutableArray alloc] initWithCapacity:[self psatStep].seriesLength + 1];
-    NSUInteger digit = 0;
-    for (NSUInteger i = 0; i < [self psatStep].seriesLength + 1; i++) {
-        do
-        {
-            digit = (arc4random() % (9)) + 1;
-        } while (digit == ((NSNumber *)[array lastObject]).integerValue);
-        [array addObject:@(digit)];
-    }
-    return array;
-}
-
 - (void)initializeInternalButtonItems {
     [super initializeInternalButtonItems];
     
@@ -119,36 +103,9 @@
     
     NSMutableArray *results = [NSMutableArray arrayWithArray:sResult.results];
     
-    ORKPSATResult *PSATResult = [[ORKPSATResult alloc] initWithIdentifier:self.step.identifier];
-    PSATResult.presentationMode = [self psatStep].presentationMode;
-    PSATResult.interStimulusInterval = [self psatStep].interStimulusInterval;
-    if ([self psatStep].presentationMode & ORKPSATPresentationModeVisual) {
-        PSATResult.stimulusDuration = [self psatStep].stimulusDuration;
-    } else {
-        PSATResult.stimulusDuration = 0.0;
+    if (self.engine) {
+        [results addObject:[self.engine resultWithIdentifier:self.step.identifier]];
     }
-    PSATResult.length = [self psatStep].seriesLength;
-    PSATResult.initialDigit = self.digits[0].integerValue;
-    NSInteger totalCorrect = 0;
-    BOOL previousAnswerCorrect = NO;
-    NSInteger totalDyad = 0;
-    CGFloat totalTime = 0.0;
-    for (ORKPSATSample *sample in self.samples) {
-        totalTime += sample.time;
-        if (sample.isCorrect) {
-            totalCorrect++;
-            if (previousAnswerCorrect) {
-                totalDyad++;
-            }
-        }
-        previousAnswerCorrect = sample.isCorrect;
-    }
-    PSATResult.totalCorrect = totalCorrect;
-    PSATResult.totalTime = totalTime;
-    PSATResult.totalDyad = totalDyad;
-    PSATResult.samples = self.samples;
-
-    [results addObject:PSATResult];
     
     sResult.results = [results copy];
     
@@ -156,12 +113,11 @@
 }
 
 - (void)start {
-    self.digits = [self arrayWithPSATDigits];
-    self.currentDigitIndex = 0;
-    [self.psatContentView setAddition:self.currentDigitIndex forTotal:[self psatStep].seriesLength withDigit:self.digits[self.currentDigitIndex]];
+    NSArray<NSNumber *> *digits = [ORKPSATEngine digitsWithSeriesLength:[self psatStep].seriesLength
+                                                  randomNumberGenerator:self.randomNumberGenerator];
+    self.engine = [[ORKPSATEngine alloc] initWithPSATStep:[self psatStep] digits:digits];
+    [self.psatContentView setAddition:self.engine.currentDigitIndex forTotal:[self psatStep].seriesLength withDigit:self.engine.currentDigit];
     [self.psatContentView setProgress:0.001 animated:NO];
-    self.currentAnswer = -1;
-    self.samples = [NSMutableArray array];
     
     if ([self psatStep].presentationMode & ORKPSATPresentationModeVisual &&
         ([self psatStep].interStimulusInterval - [self psatStep].stimulusDuration) > 0.05 ) {
@@ -198,23 +154,17 @@
 }
 
 - (void)countDownTimerFired:(ORKActiveStepTimer *)timer finished:(BOOL)finished {
-    if (self.currentDigitIndex == 0) {
+    if (self.engine.currentDigitIndex == 0) {
         [self.psatContentView setEnabled:YES];
         [self.activeStepView updateTitle:self.step.title text:ORKLocalizedString(@"PSAT_INSTRUCTION", nil)];
-    } else {
-        [self saveSample];
     }
     
-    self.currentDigitIndex++;
-    self.answerStart = CACurrentMediaTime();
-    self.answerEnd = 0;
+    [self.engine advanceAtTime:ORKClockSystemUptime()];
     
-    if (self.currentDigitIndex <= [self psatStep].seriesLength) {
-        [self.psatContentView setAddition:self.currentDigitIndex forTotal:[self psatStep].seriesLength withDigit:self.digits[self.currentDigitIndex]];
+    if (!self.engine.finished) {
+        [self.psatContentView setAddition:self.engine.currentDigitIndex forTotal:[self psatStep].seriesLength withDigit:self.engine.currentDigit];
     }
     
-    self.currentAnswer = -1;
-    
     CGFloat progress = finished ? 1 : (timer.runtime / timer.duration);
     [self.psatContentView setProgress:progress animated:YES];
     
@@ -222,26 +172,13 @@
 }
 
 - (void)clearDigitsTimerFired {
-    [self.psatContentView setAddition:self.currentDigitIndex forTotal:[self psatStep].seriesLength withDigit:@(-1)];
-}
-
-- (void)saveSample {
-    ORKPSATSample *sample = [[ORKPSATSample alloc] init];
-    NSInteger previousDigit = self.digits[self.currentDigitIndex - 1].integerValue;
-    NSInteger currentDigit = self.digits[self.currentDigitIndex].integerValue;;
-    sample.correct = previousDigit + currentDigit == self.currentAnswer ? YES : NO;
-    sample.digit = currentDigit;
-    sample.answer = self.currentAnswer;
-    sample.time = self.answerEnd == 0 ? [self psatStep].interStimulusInterval : self.answerEnd - self.answerStart;
-    
-    [self.samples addObject:sample];
+    [self.psatContentView setAddition:self.engine.currentDigitIndex forTotal:[self psatStep].seriesLength withDigit:@(-1)];
 }
 
 #pragma mark - keyboard view delegate
 
 - (void)keyboardView:(ORKPSATKeyboardView *)keyboardView didSelectAnswer:(NSInteger)answer {
-    self.currentAnswer = answer;
-    self.answerEnd = CACurrentMediaTime();
+    [self.engine submitAnswer:answer atTime:ORKClockSystemUptime()];
 }
 
 @end
@@ -47,6 +47,7 @@
 #import "ORKResult.h"
 
 #import "ORKHelpers_Internal.h"
+#import "ORKClock.h"
 
 #import <AudioToolbox/AudioServices.h>
 
@@ -135,7 +136,9 @@ static const NSTimeInterval OutcomeAnimationDuration = 0.3;
 
 - (ORKStepResult *)result {
     ORKStepResult *stepResult = [super result];
-    stepResult.results = [self.addedResults arrayByAddingObjectsFromArray:_results] ? : _results;
+    NSMutableArray *results = [NSMutableArray arrayWithArray:stepResult.results];
+    [results addObjectsFromArray:_results];
+    stepResult.results = [results copy];
     return stepResult;
 }
 
@@ -228,7 +231,7 @@ static const NSTimeInterval OutcomeAnimationDuration = 0.3;
 - (void)stimulusTimerDidFire {
     _stimulusStartDate = [NSDate date];
     
-    _stimulusTimestamp = [NSProcessInfo processInfo].systemUptime;
+    _stimulusTimestamp = ORKClockSystemUptime();
     [_reactionTimeContentView setStimulusHidden:NO];
     _validResult = YES;
     [self startTimeoutTimer];
@@ -262,7 +265,7 @@ static const NSTimeInterval OutcomeAnimationDuration = 0.3;
 - (NSNumber*) getRandomInterval {
     NSArray* values = @[@2,@4,@6];
 
-    int randIndex = arc4random() % [values count];
+    int randIndex = [self.randomNumberGenerator uniformIntegerLessThan:(uint32_t)[values count]];
     return (NSNumber*)values[randIndex];
 }
 
@@ -0,0 +1,110 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <ResearchKitActiveTask/ORKReactionTimeResult.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ORKFileResult;
+@class ORKRandomNumberGenerator;
+@class ORKReactionTimeStep;
+
+typedef NS_ENUM(NSInteger, ORKReactionTimeAttemptOutcome) {
+    /// The participant moved the device after the stimulus was presented.
+    ORKReactionTimeAttemptOutcomeSuccess,
+    /// The attempt ended before the stimulus was presented, or was interrupted.
+    ORKReactionTimeAttemptOutcomeFailure,
+    /// The step's timeout elapsed before the participant reacted.
+    ORKReactionTimeAttemptOutcomeTimeout,
+};
+
+/**
+ The UI-free state machine behind the reaction time step.
+ 
+ An attempt starts by waiting `stimulusIntervalWithRandomNumberGenerator:`, then calling
+ `presentStimulusAtTime:`. It ends with `finishAttemptWithFileResult:` once the motion recording stops,
+ either because `isReactionWithUserAccelerationX:y:z:` returned YES or because the attempt was timed
+ out or invalidated. Times are supplied by the caller, so a scripted session produces the same
+ results as one driven by the step view controller.
+ */
+@interface ORKReactionTimeEngine : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithReactionTimeStep:(ORKReactionTimeStep *)step NS_DESIGNATED_INITIALIZER;
+
+/**
+ The successful attempts so far, in order.
+ */
+@property (nonatomic, copy, readonly) NSArray<ORKReactionTimeResult *> *results;
+
+/**
+ YES once the step's `numberOfAttempts` successful attempts have been recorded.
+ */
+@property (nonatomic, readonly, getter=isFinished) BOOL finished;
+
+/**
+ Returns the delay before the next stimulus, drawn uniformly between the step's minimum and maximum
+ stimulus intervals.
+ */
+- (NSTimeInterval)stimulusIntervalWithRandomNumberGenerator:(ORKRandomNumberGenerator *)randomNumberGenerator;
+
+/**
+ Marks the stimulus as presented at `time`. An attempt finished after this counts as a success unless it
+ was timed out or invalidated first.
+ */
+- (void)presentStimulusAtTime:(NSTimeInterval)time;
+
+/**
+ Returns YES when the magnitude of the user acceleration exceeds the step's threshold.
+ */
+- (BOOL)isReactionWithUserAccelerationX:(double)x y:(double)y z:(double)z;
+
+/**
+ Marks the current attempt as timed out.
+ */
+- (void)timeOutAttempt;
+
+/**
+ Marks the current attempt as failed, for example because the app resigned active.
+ */
+- (void)invalidateAttempt;
+
+/**
+ Ends the current attempt, recording a result with `fileResult` if it succeeded, and returns its outcome.
+ */
+- (ORKReactionTimeAttemptOutcome)finishAttemptWithFileResult:(nullable ORKFileResult *)fileResult;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,108 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKReactionTimeEngine.h"
+
+#import "ORKRandomNumberGenerator.h"
+#import "ORKReactionTimeStep.h"
+
+#import "ORKHelpers_Internal.h"
+
+
+@implementation ORKReactionTimeEngine {
+    ORKReactionTimeStep *_step;
+    NSMutableArray<ORKReactionTimeResult *> *_results;
+    NSTimeInterval _stimulusTimestamp;
+    BOOL _validResult;
+    BOOL _timedOut;
+}
+
+- (instancetype)init {
+    ORKThrowMethodUnavailableException();
+}
+
+- (instancetype)initWithReactionTimeStep:(ORKReactionTimeStep *)step {
+    self = [super init];
+    if (self) {
+        _step = step;
+        _results = [NSMutableArray arrayWithCapacity:MAX(step.numberOfAttempts, 0)];
+    }
+    return self;
+}
+
+- (NSArray<ORKReactionTimeResult *> *)results {
+    return [_results copy];
+}
+
+- (BOOL)isFinished {
+    return (NSInteger)_results.count >= _step.numberOfAttempts;
+}
+
+- (NSTimeInterval)stimulusIntervalWithRandomNumberGenerator:(ORKRandomNumberGenerator *)randomNumberGenerator {
+    NSTimeInterval range = _step.maximumStimulusInterval - _step.minimumStimulusInterval;
+    return _step.minimumStimulusInterval + [randomNumberGenerator uniformDouble] * range;
+}
+
+- (void)presentStimulusAtTime:(NSTimeInterval)time {
+    _stimulusTimestamp = time;
+    _validResult = YES;
+}
+
+- (BOOL)isReactionWithUserAccelerationX:(double)x y:(double)y z:(double)z {
+    return sqrt(x * x + y * y + z * z) > _step.thresholdAcceleration;
+}
+
+- (void)timeOutAttempt {
+    _validResult = NO;
+    _timedOut = YES;
+}
+
+- (void)invalidateAttempt {
+    _validResult = NO;
+}
+
+- (ORKReactionTimeAttemptOutcome)finishAttemptWithFileResult:(ORKFileResult *)fileResult {
+    ORKReactionTimeAttemptOutcome outcome = ORKReactionTimeAttemptOutcomeFailure;
+    if (_validResult) {
+        ORKReactionTimeResult *result = [[ORKReactionTimeResult alloc] initWithIdentifier:_step.identifier];
+        result.timestamp = _stimulusTimestamp;
+        result.fileResult = fileResult;
+        [_results addObject:result];
+        outcome = ORKReactionTimeAttemptOutcomeSuccess;
+    } else if (_timedOut) {
+        outcome = ORKReactionTimeAttemptOutcomeTimeout;
+    }
+    _validResult = NO;
+    _timedOut = NO;
+    return outcome;
+}
+
+@end
@@ -38,11 +38,12 @@
 #import "ORKStepViewController_Internal.h"
 
 #import "ORKCollectionResult_Private.h"
-#import "ORKReactionTimeResult.h"
+#import "ORKReactionTimeEngine.h"
 #import "ORKReactionTimeStep.h"
 #import "ORKResult.h"
 
 #import "ORKHelpers_Internal.h"
+#import "ORKClock.h"
 
 #import <AudioToolbox/AudioServices.h>
 #import <CoreMotion/CMDeviceMotion.h>
@@ -50,12 +51,9 @@
 
 @implementation ORKReactionTimeViewController {
     ORKReactionTimeContentView *_reactionTimeContentView;
-    NSMutableArray *_results;
+    ORKReactionTimeEngine *_engine;
     NSTimer *_stimulusTimer;
     NSTimer *_timeoutTimer;
-    NSTimeInterval _stimulusTimestamp;
-    BOOL _validResult;
-    BOOL _timedOut;
     BOOL _shouldIndicateFailure;
 }
 
@@ -66,8 +64,8 @@ static const NSTimeInterval OutcomeAnimationDuration = 0.3;
 - (void)viewDidLoad {
     [super viewDidLoad];
     // Do any additional setup after loading the view.
+    _engine = [[ORKReactionTimeEngine alloc] initWithReactionTimeStep:[self reactionTimeStep]];
     [self configureTitle];
-    _results = [NSMutableArray new];
     _reactionTimeContentView = [ORKReactionTimeContentView new];
     self.activeStepView.activeCustomView = _reactionTimeContentView;
     [_reactionTimeContentView setStimulusHidden:YES];
@@ -95,12 +93,7 @@ static const NSTimeInterval OutcomeAnimationDuration = 0.3;
 #if TARGET_IPHONE_SIMULATOR
 - (void)motionBegan:(UIEventSubtype)motion withEvent:(UIEvent *)event {
     if (event.type == UIEventSubtypeMotionShake) {
-        if (_validResult) {
-            ORKReactionTimeResult *reactionTimeResult = [[ORKReactionTimeResult alloc] initWithIdentifier:self.step.identifier];
-            reactionTimeResult.timestamp = _stimulusTimestamp;
-            [_results addObject:reactionTimeResult];
-        }
-        [self attemptDidFinish];
+        [self attemptDidFinishWithFileResult:nil];
     }
 }
 #endif
@@ -108,13 +101,15 @@ static const NSTimeInterval OutcomeAnimationDuration = 0.3;
 
 - (ORKStepResult *)result {
     ORKStepResult *stepResult = [super result];
-    stepResult.results = [self.addedResults arrayByAddingObjectsFromArray:_results] ? : _results;
+    NSMutableArray *results = [NSMutableArray arrayWithArray:stepResult.results];
+    [results addObjectsFromArray:_engine.results];
+    stepResult.results = [results copy];
     return stepResult;
 }
 
 - (void)applicationWillResignActive:(NSNotification *)notification {
     [super applicationWillResignActive:notification];
-    _validResult = NO;
+    [_engine invalidateAttempt];
     [_stimulusTimer invalidate];
     [_timeoutTimer invalidate];
 }
@@ -127,21 +122,14 @@ static const NSTimeInterval OutcomeAnimationDuration = 0.3;
 #pragma mark - ORKRecorderDelegate
 
 - (void)recorder:(ORKRecorder *)recorder didCompleteWithResult:(ORKResult *)result {
-    if (_validResult) {
-        ORKReactionTimeResult *reactionTimeResult = [[ORKReactionTimeResult alloc] initWithIdentifier:self.step.identifier];
-        reactionTimeResult.timestamp = _stimulusTimestamp;
-        reactionTimeResult.fileResult = (ORKFileResult *)result;
-        [_results addObject:reactionTimeResult];
-    }
-    [self attemptDidFinish];
+    [self attemptDidFinishWithFileResult:(ORKFileResult *)result];
 }
 
 #pragma mark - ORKDeviceMotionRecorderDelegate
 
 - (void)deviceMotionRecorderDidUpdateWithMotion:(CMDeviceMotion *)motion {
     CMAcceleration v = motion.userAcceleration;
-    double vectorMagnitude = sqrt(((v.x * v.x) + (v.y * v.y) + (v.z * v.z)));
-    if (vectorMagnitude > [self reactionTimeStep].thresholdAcceleration) {
+    if ([_engine isReactionWithUserAccelerationX:v.x y:v.y z:v.z]) {
         [self stopRecorders];
     }
 }
@@ -154,26 +142,25 @@ static const NSTimeInterval OutcomeAnimationDuration = 0.3;
 
 - (void)configureTitle {
     NSString *format = ORKLocalizedString(@"REACTION_TIME_TASK_ATTEMPTS_FORMAT", nil);
-    NSString *text = [NSString stringWithFormat:format, ORKLocalizedStringFromNumber(@(_results.count + 1)), ORKLocalizedStringFromNumber(@([self reactionTimeStep].numberOfAttempts))];
+    NSString *text = [NSString stringWithFormat:format, ORKLocalizedStringFromNumber(@(_engine.results.count + 1)), ORKLocalizedStringFromNumber(@([self reactionTimeStep].numberOfAttempts))];
     [self.activeStepView updateTitle:ORKLocalizedString(@"REACTION_TIME_TASK_ACTIVE_STEP_TITLE", nil) text:text];
 }
 
-- (void)attemptDidFinish {
+- (void)attemptDidFinishWithFileResult:(nullable ORKFileResult *)fileResult {
     dispatch_async(dispatch_get_main_queue(), ^(void) {
+        ORKReactionTimeAttemptOutcome outcome = [self->_engine finishAttemptWithFileResult:fileResult];
         void (^completion)(void) = ^{
-            if (self->_results.count == [self reactionTimeStep].numberOfAttempts) {
+            if (self->_engine.finished) {
                 [self finish];
             } else {
                 [self resetAfterDelay:2];
             }
         };
-        if (self->_validResult) {
+        if (outcome == ORKReactionTimeAttemptOutcomeSuccess) {
             [self indicateSuccess:completion];
         } else {
-            [self indicateFailure:completion];
+            [self indicateFailure:completion timedOut:outcome == ORKReactionTimeAttemptOutcomeTimeout];
         }
-        self->_validResult = NO;
-        self->_timedOut = NO;
         [self->_stimulusTimer invalidate];
         [self->_timeoutTimer invalidate];
     });
@@ -184,12 +171,12 @@ static const NSTimeInterval OutcomeAnimationDuration = 0.3;
     AudioServicesPlaySystemSound([self reactionTimeStep].successSound);
 }
 
-- (void)indicateFailure:(void(^)(void))completion {
+- (void)indicateFailure:(void(^)(void))completion timedOut:(BOOL)timedOut {
     if (!_shouldIndicateFailure) {
         return;
     }
     [_reactionTimeContentView startFailureAnimationWithDuration:OutcomeAnimationDuration completion:completion];
-    SystemSoundID sound = _timedOut ? [self reactionTimeStep].timeoutSound : [self reactionTimeStep].failureSound;
+    SystemSoundID sound = timedOut ? [self reactionTimeStep].timeoutSound : [self reactionTimeStep].failureSound;
     AudioServicesPlayAlertSound(sound);
 }
 
@@ -202,13 +189,12 @@ static const NSTimeInterval OutcomeAnimationDuration = 0.3;
 }
 
 - (void)startStimulusTimer {
-    _stimulusTimer = [NSTimer scheduledTimerWithTimeInterval:[self stimulusInterval] target:self selector:@selector(stimulusTimerDidFire) userInfo:nil repeats:NO];
+    _stimulusTimer = [NSTimer scheduledTimerWithTimeInterval:[_engine stimulusIntervalWithRandomNumberGenerator:self.randomNumberGenerator] target:self selector:@selector(stimulusTimerDidFire) userInfo:nil repeats:NO];
 }
 
 - (void)stimulusTimerDidFire {
-    _stimulusTimestamp = [NSProcessInfo processInfo].systemUptime;
+    [_engine presentStimulusAtTime:ORKClockSystemUptime()];
     [_reactionTimeContentView setStimulusHidden:NO];
-    _validResult = YES;
     [self startTimeoutTimer];
 }
 
@@ -220,21 +206,13 @@ static const NSTimeInterval OutcomeAnimationDuration = 0.3;
 }
 
 - (void)timeoutTimerDidFire {
-    _validResult = NO;
-    _timedOut = YES;
+    [_engine timeOutAttempt];
     [self stopRecorders];
     
 #if TARGET_IPHONE_SIMULATOR
     // Device motion recorder won't work, so manually trigger didfinish
-    [self attemptDidFinish];
+    [self attemptDidFinishWithFileResult:nil];
 #endif
 }
 
-- (NSTimeInterval)stimulusInterval {
-    ORKReactionTimeStep *step = [self reactionTimeStep];
-    NSTimeInterval range = step.maximumStimulusInterval - step.minimumStimulusInterval;
-    NSTimeInterval randomFactor = ((NSTimeInterval)arc4random() / RAND_MAX) * range;
-    return randomFactor + step.minimumStimulusInterval;
-}
-
 @end
@@ -62,6 +62,7 @@ FOUNDATION_EXPORT const unsigned char ResearchKitActiveTaskVersionString[];
 #import <ResearchKitActiveTask/ORKEnvironmentSPLMeterStepViewController.h>
 #import <ResearchKitActiveTask/ORKFitnessStepViewController.h>
 #import <ResearchKitActiveTask/ORKFrontFacingCameraStepViewController.h>
+#import <ResearchKitActiveTask/ORKGaitResult.h>
 #import <ResearchKitActiveTask/ORKHolePegTestPlaceStepViewController.h>
 #import <ResearchKitActiveTask/ORKHolePegTestRemoveStepViewController.h>
 #import <ResearchKitActiveTask/ORKHolePegTestResult.h>
@@ -101,12 +102,16 @@ FOUNDATION_EXPORT const unsigned char ResearchKitActiveTaskVersionString[];
 #import <ResearchKitActiveTask/ORKTouchAbilityTouch.h>
 #import <ResearchKitActiveTask/ORKTouchAbilityTrack.h>
 #import <ResearchKitActiveTask/ORKTouchAbilityTrial.h>
+#import <ResearchKitActiveTask/ORKTouchAbilityTrialMetrics.h>
 #import <ResearchKitActiveTask/ORKTouchAnywhereStep.h>
 #import <ResearchKitActiveTask/ORKTouchAnywhereStepViewController.h>
 #import <ResearchKitActiveTask/ORKTowerOfHanoiResult.h>
 #import <ResearchKitActiveTask/ORKTowerOfHanoiStepViewController.h>
 #import <ResearchKitActiveTask/ORKTrailmakingResult.h>
 #import <ResearchKitActiveTask/ORKTrailmakingStepViewController.h>
+#import <ResearchKitActiveTask/ORKTremorResult.h>
 #import <ResearchKitActiveTask/ORKUSDZModelManager.h>
 #import <ResearchKitActiveTask/ORKUSDZModelManagerResult.h>
+#import <ResearchKitActiveTask/ORKWalkingDistanceEstimator.h>
+#import <ResearchKitActiveTask/ORKWalkingDistanceResult.h>
 #import <ResearchKitActiveTask/ORKWalkingTaskStepViewController.h>
@@ -28,12 +28,14 @@
  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#import <ResearchKitActiveTask/CLLocation+ORKJSONDictionary.h>
 #import <ResearchKitActiveTask/ORKAccelerometerRecorder.h>
 #import <ResearchKitActiveTask/ORKActiveStepTimer.h>
 #import <ResearchKitActiveTask/ORKActiveStepView.h>
 #import <ResearchKitActiveTask/ORKActiveStepViewController_Internal.h>
 #import <ResearchKitActiveTask/ORKAmslerGridStep.h>
 #import <ResearchKitActiveTask/ORKAudioFitnessStep.h>
+#import <ResearchKitActiveTask/ORKAudioLevelMeter.h>
 #import <ResearchKitActiveTask/ORKAudioLevelNavigationRule.h>
 #import <ResearchKitActiveTask/ORKAudioMeteringView.h>
 #import <ResearchKitActiveTask/ORKAudiometry.h>
@@ -46,6 +48,7 @@
 #import <ResearchKitActiveTask/ORKDeviceMotionRecorder.h>
 #import <ResearchKitActiveTask/ORKEnvironmentSPLMeterStepViewController_Private.h>
 #import <ResearchKitActiveTask/ORKFitnessStep.h>
+#import <ResearchKitActiveTask/ORKGaitFeatureExtractor.h>
 #import <ResearchKitActiveTask/ORKHealthClinicalTypeRecorder.h>
 #import <ResearchKitActiveTask/ORKHealthQuantityTypeRecorder.h>
 #import <ResearchKitActiveTask/ORKHolePegTestPlaceStep.h>
@@ -53,20 +56,28 @@
 #import <ResearchKitActiveTask/ORKLocationRecorder.h>
 #import <ResearchKitActiveTask/ORKNormalizedReactionTimeViewController.h>
 #import <ResearchKitActiveTask/ORKPedometerRecorder.h>
+#import <ResearchKitActiveTask/ORKPSATEngine.h>
 #import <ResearchKitActiveTask/ORKPSATStep.h>
 #import <ResearchKitActiveTask/ORKRangeOfMotionStep.h>
+#import <ResearchKitActiveTask/ORKReactionTimeEngine.h>
 #import <ResearchKitActiveTask/ORKReactionTimeStep.h>
 #import <ResearchKitActiveTask/ORKShoulderRangeOfMotionStep.h>
 #import <ResearchKitActiveTask/ORKSpatialSpanMemoryStep.h>
 #import <ResearchKitActiveTask/ORKSpeechInNoiseContentView.h>
+#import <ResearchKitActiveTask/ORKSpeechInNoiseMixer.h>
 #import <ResearchKitActiveTask/ORKSpeechInNoiseStepViewController_Private.h>
+#import <ResearchKitActiveTask/ORKSpeechInNoiseStimulusBank.h>
 #import <ResearchKitActiveTask/ORKSpeechRecognitionContentView.h>
 #import <ResearchKitActiveTask/ORKSpeechRecognitionStepViewController_Private.h>
 #import <ResearchKitActiveTask/ORKStreamingAudioRecorder.h>
+#import <ResearchKitActiveTask/ORKStroopEngine.h>
 #import <ResearchKitActiveTask/ORKStroopStep.h>
 #import <ResearchKitActiveTask/ORKTappingIntervalStep.h>
+#import <ResearchKitActiveTask/ORKTappingSampleBuffer.h>
+#import <ResearchKitActiveTask/ORKTickScheduler.h>
 #import <ResearchKitActiveTask/ORKTimedWalkStep.h>
 #import <ResearchKitActiveTask/ORKToneAudiometryStep.h>
+#import <ResearchKitActiveTask/ORKToneSynthesisEngine.h>
 #import <ResearchKitActiveTask/ORKTouchAbilityContentView.h>
 #import <ResearchKitActiveTask/ORKTouchAbilityLongPressStep.h>
 #import <ResearchKitActiveTask/ORKTouchAbilityPinchStep.h>
@@ -77,7 +88,11 @@
 #import <ResearchKitActiveTask/ORKTouchAbilityTapStep.h>
 #import <ResearchKitActiveTask/ORKTouchAbilityTouchTracker.h>
 #import <ResearchKitActiveTask/ORKTouchRecorder.h>
+#import <ResearchKitActiveTask/ORKTowerOfHanoiEngine.h>
 #import <ResearchKitActiveTask/ORKTowerOfHanoiStep.h>
 #import <ResearchKitActiveTask/ORKTrailmakingStep.h>
+#import <ResearchKitActiveTask/ORKTrajectoryEncoder.h>
+#import <ResearchKitActiveTask/ORKTremorAnalyzer.h>
+#import <ResearchKitActiveTask/ORKTremorSpectrum.h>
 #import <ResearchKitActiveTask/ORKVoiceEngine.h>
 #import <ResearchKitActiveTask/ORKWalkingTaskStep.h>
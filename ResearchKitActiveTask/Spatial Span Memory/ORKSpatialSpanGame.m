@@ -32,6 +32,7 @@
 #import "ORKSpatialSpanGame.h"
 
 #import "ORKHelpers_Internal.h"
+#import "ORKRandomNumberGenerator.h"
 
 
 @implementation ORKSpatialSpanGame {
@@ -55,11 +56,11 @@
         _sequence[i] = i;
     }
     
-    // Knuth algorithm: swap each with a random element elsewhere in the array.
+    // Fisher-Yates shuffle driven by the seed, so that the same seed always gives the same game.
     // Note: we will only use the first _sequenceLength elements of this array
-    srandom(_seed);
-    for (NSInteger i = 0; i < _gameSize; i++) {
-        NSInteger rand_i = arc4random() % _gameSize;
+    ORKRandomNumberGenerator *generator = [[ORKRandomNumberGenerator alloc] initWithSeed:_seed];
+    for (NSInteger i = _gameSize - 1; i > 0; i--) {
+        NSInteger rand_i = [generator uniformIntegerLessThan:(uint32_t)(i + 1)];
         NSInteger tmp = _sequence[i];
         _sequence[i] = _sequence[rand_i];
         _sequence[rand_i] = tmp;
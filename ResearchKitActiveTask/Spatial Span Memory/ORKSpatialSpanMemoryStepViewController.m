@@ -50,6 +50,7 @@
 #import "ORKNavigationContainerView_Internal.h"
 
 #import "ORKHelpers_Internal.h"
+#import "ORKClock.h"
 #import "ORKSkin.h"
 
 #import <QuartzCore/CABase.h>
@@ -296,7 +297,7 @@ typedef void (^_ORKStateHandler)(ORKState *fromState, ORKState *_toState, id con
 }
 
 - (void)updateGameRecordOnStartingGamePlay {
-    _gameStartTime = CACurrentMediaTime();
+    _gameStartTime = ORKClockSystemUptime();
 }
 
 - (void)handleUserTap:(UITapGestureRecognizer *)tapRecognizer {
@@ -309,7 +310,7 @@ typedef void (^_ORKStateHandler)(ORKState *fromState, ORKState *_toState, id con
 - (void)updateGameRecordOnTouch:(NSInteger)targetIndex location:(CGPoint)location {
     ORKSpatialSpanMemoryGameTouchSample *sample = [ORKSpatialSpanMemoryGameTouchSample new];
     
-    sample.timestamp = CACurrentMediaTime() - _gameStartTime;
+    sample.timestamp = ORKClockSystemUptime() - _gameStartTime;
     sample.location = location;
     sample.targetIndex = targetIndex;
     
@@ -393,7 +394,9 @@ typedef void (^_ORKStateHandler)(ORKState *fromState, ORKState *_toState, id con
     NSInteger sequenceLength = _nextGameSequenceLength;
     _gridSize = [self gridSizeForSpan:sequenceLength];
     
-    ORKSpatialSpanGame *game = [[ORKSpatialSpanGame alloc] initWithGameSize:_gridSize.width * _gridSize.height sequenceLength:sequenceLength seed:0];
+    // Seed each game from the step's generator; zero would ask the game for a random seed.
+    uint32_t seed = [self.randomNumberGenerator uniformIntegerLessThan:UINT32_MAX] + 1;
+    ORKSpatialSpanGame *game = [[ORKSpatialSpanGame alloc] initWithGameSize:_gridSize.width * _gridSize.height sequenceLength:sequenceLength seed:seed];
     ORKSpatialSpanGameState *gameState = [[ORKSpatialSpanGameState alloc] initWithGame:game];
     
     _currentGameState = gameState;
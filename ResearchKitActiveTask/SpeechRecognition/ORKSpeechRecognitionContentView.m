@@ -317,10 +317,14 @@ static CGFloat const ORKSpeechRecognitionContentBottomLayoutMargin = 44.0;
     
     NSAssert(sample != nil, @"Sample should be non-nil");
     
+    [self addSamples:@[sample]];
+}
+
+- (void)addSamples:(NSArray<NSNumber *> *)samples {
     if (!_samples) {
         _samples = [NSMutableArray array];
     }
-    [_samples addObject:sample];
+    [_samples addObjectsFromArray:samples];
     
     _samples = [ORKLastNSamples(_samples, 500) mutableCopy];
     
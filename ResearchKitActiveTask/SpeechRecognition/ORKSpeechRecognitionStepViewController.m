@@ -46,6 +46,7 @@
 #import "ORKSpeechRecognitionContentView.h"
 #import "ORKStreamingAudioRecorder.h"
 #import "ORKAudioStreamer.h"
+#import "ORKAudioLevelMeter.h"
 #import "ORKSpeechRecognizer.h"
 #import "ORKSpeechRecognitionStep.h"
 #import "ORKSpeechRecognitionError.h"
@@ -72,7 +73,7 @@
     dispatch_queue_t _speechRecognitionQueue;
     ORKSpeechRecognitionResult *_localResult;
     BOOL _errorState;
-    float _peakPower;
+    ORKAudioLevelMeter *_levelMeter;
     BOOL _allowUserToRecordInsteadOnNextStep;
 }
 
@@ -95,6 +96,7 @@
 
     _localResult = [[ORKSpeechRecognitionResult alloc] initWithIdentifier:self.step.identifier];
     _speechRecognitionQueue = dispatch_queue_create("SpeechRecognitionQueue", DISPATCH_QUEUE_SERIAL);
+    _levelMeter = [ORKAudioLevelMeter new];
 }
 
 - (void)setupContentView {
@@ -260,6 +262,8 @@
         [_speechRecognizer endAudio];
     }
     
+    [_levelMeter stopDisplayUpdates];
+    
     if (error)
     {
         ORK_Log_Error("Speech recognition failed with error message: \"%@\"", error.localizedDescription);
@@ -294,6 +298,8 @@
 {
     [super suspend];
     
+    [_levelMeter stopDisplayUpdates];
+    [_levelMeter discardLevels];
     [_speechRecognitionContentView removeAllSamples];
     
     [_speechRecognitionContentView.recordButton setButtonType:ORKRecordButtonTypeRecord animated:YES];
@@ -403,19 +409,10 @@
     }
     [_speechRecognizer addAudio:buffer];
     
-    // audio metering display
+    // audio metering display, drained by the content view once per display refresh
     float * const *channelData = [buffer floatChannelData];
     if (channelData[0]) {
-        float avgValue = 0;
-        unsigned long nFrames = [buffer frameLength];
-        vDSP_maxmgv(channelData[0], 1 , &avgValue, nFrames);
-        float lvlLowPassTrig = 0.3;
-        _peakPower = lvlLowPassTrig * ((avgValue == 0)? -100 : 20* log10(avgValue)) + (1 - lvlLowPassTrig) * _peakPower;
-        float clampedValue = MAX(_peakPower / 60.0, -1) + 1;
-        
-        dispatch_async(dispatch_get_main_queue(), ^{
-            [self->_speechRecognitionContentView addSample:@(clampedValue)];
-        });
+        [_levelMeter writePeakLevelOfSamples:channelData[0] frameCount:[buffer frameLength]];
     }
 }
 
@@ -489,6 +486,12 @@
 
 - (void)recordersWillStart {
     ORK_Log_Debug("Recorder is starting");
+    
+    ORKWeakTypeOf(self) weakSelf = self;
+    [_levelMeter startDisplayUpdatesWithHandler:^(NSArray<NSNumber *> *levels) {
+        ORKStrongTypeOf(weakSelf) strongSelf = weakSelf;
+        [strongSelf.speechRecognitionContentView addSamples:levels];
+    }];
 }
 
 @end
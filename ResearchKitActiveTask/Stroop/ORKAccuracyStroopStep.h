@@ -29,6 +29,7 @@
  */
 
 #import <ResearchKit/ORKActiveStep.h>
+#import <ResearchKit/ORKRandomNumberGenerator.h>
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -58,8 +59,23 @@ ORK_CLASS_AVAILABLE
  The value of this property is generated based on the `baseDisplayColor` and `isColorMatching`
  properties. If `isColorMatching` is false, the actual display color will be randomly generated
  to be a color that is not the base display color.
+ 
+ Each read draws from a new, unseeded generator, so the value can't be replayed. Use
+ `actualDisplayColorWithRandomNumberGenerator:` instead.
+*/
+@property (nonatomic, readonly) UIColor *actualDisplayColor DEPRECATED_MSG_ATTRIBUTE("Use '-actualDisplayColorWithRandomNumberGenerator:' instead.");
+
+/**
+ Returns the color the text of the label names, drawing it from `randomNumberGenerator`.
+ 
+ If `isColorMatching` is true, this is the base display color and nothing is drawn. Otherwise it
+ is drawn from the colors other than the base display color.
+ 
+ @param randomNumberGenerator   The generator to draw the color from.
+ 
+ @return The color the text of the label names.
 */
-@property (nonatomic, readonly) UIColor *actualDisplayColor;
+- (UIColor *)actualDisplayColorWithRandomNumberGenerator:(ORKRandomNumberGenerator *)randomNumberGenerator;
 
 + (NSArray <UIColor *> *)colors;
 
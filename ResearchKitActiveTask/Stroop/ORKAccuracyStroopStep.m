@@ -94,9 +94,19 @@
 }
 
 - (UIColor *)actualDisplayColor {
-    return self.isColorMatching ?
-    self.baseDisplayColor :
-    ORKAccuracyStroopStep.colors[arc4random_uniform(((uint32_t) ORKAccuracyStroopStep.colors.count))];
+    return [self actualDisplayColorWithRandomNumberGenerator:[ORKRandomNumberGenerator new]];
+}
+
+- (UIColor *)actualDisplayColorWithRandomNumberGenerator:(ORKRandomNumberGenerator *)randomNumberGenerator {
+    if (self.isColorMatching) {
+        return self.baseDisplayColor;
+    }
+    NSMutableArray<UIColor *> *colors = [ORKAccuracyStroopStep.colors mutableCopy];
+    [colors removeObject:self.baseDisplayColor];
+    if (colors.count == 0) {
+        return self.baseDisplayColor;
+    }
+    return colors[[randomNumberGenerator uniformIntegerLessThan:(uint32_t)colors.count]];
 }
 
 @end
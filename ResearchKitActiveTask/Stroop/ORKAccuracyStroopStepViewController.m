@@ -92,7 +92,7 @@
     self.colorLabel = nil;
     
     self.colorLabel = UILabel.new;
-    self.colorLabel.text = self.accuracyStroopStep.actualDisplayColor.textRepresentation;
+    self.colorLabel.text = [self.accuracyStroopStep actualDisplayColorWithRandomNumberGenerator:self.randomNumberGenerator].textRepresentation;
     self.colorLabel.textColor = self.accuracyStroopStep.baseDisplayColor;
     self.colorLabel.font = [UIFont systemFontOfSize:35.0 weight:UIFontWeightMedium];
     [self.view addSubview:self.colorLabel];
@@ -182,8 +182,8 @@
     
     for (int colorIndex = 0; colorIndex < ORKAccuracyStroopStep.colors.count; colorIndex++) {
         // Obtain random location for color circle within bounds
-        int randomR = (int)arc4random_uniform(numRows);
-        int randomC = (int)arc4random_uniform(numColumns);
+        int randomR = (int)[self.randomNumberGenerator uniformIntegerLessThan:numRows];
+        int randomC = (int)[self.randomNumberGenerator uniformIntegerLessThan:numColumns];
 
         ORK_Log_Debug("Trying placement for color: %d at (r, c): (%d, %d)", colorIndex, randomR, randomC);
         
@@ -0,0 +1,93 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <ResearchKitActiveTask/ORKStroopResult.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ORKRandomNumberGenerator;
+
+/**
+ The UI-free state machine behind the Stroop step.
+ 
+ Colors are identified by name. Each trial shows a color name as text, drawn either in the color it
+ names or in one of the other colors, and ends when `selectColorName:atTime:` is called. Times are
+ supplied by the caller, so a scripted session produces the same results as one driven by the step
+ view controller.
+ */
+@interface ORKStroopEngine : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Returns an engine running `numberOfAttempts` trials over `colorNames`.
+ 
+ The order of `colorNames` decides which mismatched color a given draw picks, so the same names,
+ order, and generator seed always produce the same trials.
+ */
+- (instancetype)initWithIdentifier:(NSString *)identifier
+                        colorNames:(NSArray<NSString *> *)colorNames
+                  numberOfAttempts:(NSInteger)numberOfAttempts
+             randomNumberGenerator:(ORKRandomNumberGenerator *)randomNumberGenerator NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, copy, readonly) NSArray<NSString *> *colorNames;
+
+@property (nonatomic, readonly) NSInteger numberOfAttempts;
+
+/**
+ The color name shown as text in the current trial, or nil between trials.
+ */
+@property (nonatomic, copy, readonly, nullable) NSString *currentText;
+
+/**
+ The name of the color the current text is drawn in, or nil between trials.
+ */
+@property (nonatomic, copy, readonly, nullable) NSString *currentColorName;
+
+@property (nonatomic, readonly, getter=isFinished) BOOL finished;
+
+@property (nonatomic, copy, readonly) NSArray<ORKStroopResult *> *results;
+
+/**
+ Draws the next trial. Returns NO, drawing nothing, when all attempts have been made.
+ */
+- (BOOL)startTrialAtTime:(NSTimeInterval)time;
+
+/**
+ Records the participant's choice for the current trial and ends it. Returns nil between trials.
+ */
+- (nullable ORKStroopResult *)selectColorName:(NSString *)colorName atTime:(NSTimeInterval)time;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,111 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKStroopEngine.h"
+
+#import "ORKRandomNumberGenerator.h"
+
+#import "ORKHelpers_Internal.h"
+
+
+@implementation ORKStroopEngine {
+    NSString *_identifier;
+    NSArray<NSString *> *_sortedColorNames;
+    ORKRandomNumberGenerator *_randomNumberGenerator;
+    NSMutableArray<ORKStroopResult *> *_results;
+    NSTimeInterval _startTime;
+}
+
+- (instancetype)init {
+    ORKThrowMethodUnavailableException();
+}
+
+- (instancetype)initWithIdentifier:(NSString *)identifier
+                        colorNames:(NSArray<NSString *> *)colorNames
+                  numberOfAttempts:(NSInteger)numberOfAttempts
+             randomNumberGenerator:(ORKRandomNumberGenerator *)randomNumberGenerator {
+    NSParameterAssert(colorNames.count > 1);
+    self = [super init];
+    if (self) {
+        _identifier = [identifier copy];
+        _colorNames = [colorNames copy];
+        // Sort the names so that the same seed always picks the same text.
+        _sortedColorNames = [_colorNames sortedArrayUsingSelector:@selector(compare:)];
+        _numberOfAttempts = numberOfAttempts;
+        _randomNumberGenerator = randomNumberGenerator;
+        _results = [NSMutableArray arrayWithCapacity:MAX(numberOfAttempts, 0)];
+    }
+    return self;
+}
+
+- (BOOL)isFinished {
+    return (NSInteger)_results.count >= _numberOfAttempts;
+}
+
+- (NSArray<ORKStroopResult *> *)results {
+    return [_results copy];
+}
+
+- (BOOL)startTrialAtTime:(NSTimeInterval)time {
+    if (self.finished) {
+        return NO;
+    }
+    BOOL congruent = [_randomNumberGenerator randomBool];
+    NSString *text = _sortedColorNames[[_randomNumberGenerator uniformIntegerLessThan:(uint32_t)_sortedColorNames.count]];
+    if (congruent) {
+        _currentColorName = text;
+    } else {
+        NSMutableArray<NSString *> *otherColorNames = [_colorNames mutableCopy];
+        [otherColorNames removeObject:text];
+        _currentColorName = otherColorNames[[_randomNumberGenerator uniformIntegerLessThan:(uint32_t)otherColorNames.count]];
+    }
+    _currentText = text;
+    _startTime = time;
+    return YES;
+}
+
+- (ORKStroopResult *)selectColorName:(NSString *)colorName atTime:(NSTimeInterval)time {
+    if (_currentText == nil) {
+        return nil;
+    }
+    ORKStroopResult *stroopResult = [[ORKStroopResult alloc] initWithIdentifier:_identifier];
+    stroopResult.startTime = _startTime;
+    stroopResult.endTime = time;
+    stroopResult.color = _currentColorName;
+    stroopResult.text = _currentText;
+    stroopResult.colorSelected = colorName;
+    [_results addObject:stroopResult];
+    _currentText = nil;
+    _currentColorName = nil;
+    return stroopResult;
+}
+
+@end
@@ -32,6 +32,7 @@
 #import "ORKStroopStepViewController.h"
 #import "ORKActiveStepView.h"
 #import "ORKStroopContentView.h"
+#import "ORKStroopEngine.h"
 #import "ORKActiveStepViewController_Internal.h"
 #import "ORKStepViewController_Internal.h"
 #import "ORKStroopResult.h"
@@ -39,6 +40,7 @@
 #import "ORKCollectionResult_Private.h"
 #import "ORKStroopStep.h"
 #import "ORKHelpers_Internal.h"
+#import "ORKClock.h"
 #import "ORKNavigationContainerView_Internal.h"
 
 
@@ -46,8 +48,7 @@
 
 @property (nonatomic, strong) ORKStroopContentView *stroopContentView;
 @property (nonatomic, strong) NSDictionary *colors;
-@property (nonatomic, strong) NSDictionary *differentColorLabels;
-@property (nonatomic) NSUInteger questionNumber;
+@property (nonatomic, strong) ORKStroopEngine *engine;
 
 @end
 
@@ -62,10 +63,6 @@
     NSString *_blueString;
     NSString *_yellowString;
     NSTimer *_nextQuestionTimer;
-    
-    NSMutableArray *_results;
-    NSTimeInterval _startTime;
-    NSTimeInterval _endTime;
 }
 
 - (instancetype)initWithStep:(ORKStep *)step {
@@ -84,7 +81,6 @@
 
 - (void)viewDidLoad {
     [super viewDidLoad];
-    _results = [NSMutableArray new];
     _redString = ORKLocalizedString(@"STROOP_COLOR_RED", nil);
     _greenString = ORKLocalizedString(@"STROOP_COLOR_GREEN", nil);
     _blueString = ORKLocalizedString(@"STROOP_COLOR_BLUE", nil);
@@ -100,15 +96,8 @@
                     _yellowString: _yellow,
                     _greenString: _green,
                     };
-    
-    self.differentColorLabels = @{
-                                  _redString: @[_blue, _green, _yellow],
-                                  _blueString: @[_red, _green, _yellow,],
-                                  _yellowString: @[_red, _blue, _green],
-                                  _greenString: @[_red, _blue, _yellow],
-                                  };
-
-    self.questionNumber = 0;
+
+
     _stroopContentView = [ORKStroopContentView new];
     self.activeStepView.activeCustomView = _stroopContentView;
     
@@ -127,19 +116,19 @@
 }
 
 - (void)buttonPressed:(id)sender {
-    if (![self.stroopContentView.colorLabelText isEqualToString:@" "]) {
+    if (self.engine.currentText != nil) {
         [self setButtonsDisabled];
         if (sender == self.stroopContentView.RButton) {
-            [self createResult:[self.colors allKeysForObject:self.stroopContentView.colorLabelColor][0] withText:self.stroopContentView.colorLabelText withColorSelected:_redString];
+            [self.engine selectColorName:_redString atTime:ORKClockSystemUptime()];
         }
         else if (sender == self.stroopContentView.GButton) {
-            [self createResult:[self.colors allKeysForObject:self.stroopContentView.colorLabelColor][0] withText:self.stroopContentView.colorLabelText withColorSelected:_greenString];
+            [self.engine selectColorName:_greenString atTime:ORKClockSystemUptime()];
         }
         else if (sender == self.stroopContentView.BButton) {
-            [self createResult:[self.colors allKeysForObject:self.stroopContentView.colorLabelColor][0] withText:self.stroopContentView.colorLabelText withColorSelected:_blueString];
+            [self.engine selectColorName:_blueString atTime:ORKClockSystemUptime()];
         }
         else if (sender == self.stroopContentView.YButton) {
-            [self createResult:[self.colors allKeysForObject:self.stroopContentView.colorLabelColor][0] withText:self.stroopContentView.colorLabelText withColorSelected:_yellowString];
+            [self.engine selectColorName:_yellowString atTime:ORKClockSystemUptime()];
         }
         self.stroopContentView.colorLabelText = @" ";
         _nextQuestionTimer = [NSTimer scheduledTimerWithTimeInterval:0.5
@@ -171,33 +160,25 @@
 
 - (ORKStepResult *)result {
     ORKStepResult *stepResult = [super result];
-    if (_results) {
-         stepResult.results = [_results copy];
+    NSArray<ORKStroopResult *> *results = self.engine.results;
+    if (results) {
+         stepResult.results = [stepResult.results arrayByAddingObjectsFromArray:results] ? : results;
     }
     return stepResult;
 }
 
 - (void)start {
     [super start];
+    // Red, blue, green, yellow is the order the mismatched colors were always drawn from.
+    self.engine = [[ORKStroopEngine alloc] initWithIdentifier:self.step.identifier
+                                                   colorNames:@[_redString, _blueString, _greenString, _yellowString]
+                                             numberOfAttempts:[self stroopStep].numberOfAttempts
+                                        randomNumberGenerator:self.randomNumberGenerator];
     [self startQuestion];
 }
 
-
-#pragma mark - ORKResult
-
-- (void)createResult:(NSString *)color withText:(NSString *)text withColorSelected:(NSString *)colorSelected {
-    ORKStroopResult *stroopResult = [[ORKStroopResult alloc] initWithIdentifier:self.step.identifier];
-    stroopResult.startTime = _startTime;
-    stroopResult.endTime =  [NSProcessInfo processInfo].systemUptime;
-    stroopResult.color = color;
-    stroopResult.text = text;
-    stroopResult.colorSelected = colorSelected;
-    [_results addObject:stroopResult];
-}
-
 - (void)startNextQuestionOrFinish {
-    self.questionNumber = self.questionNumber + 1;
-    if (self.questionNumber == ([self stroopStep].numberOfAttempts)) {
+    if (self.engine.finished) {
         [self finish];
     } else {
         [self startQuestion];
@@ -205,25 +186,12 @@
 }
 
 - (void)startQuestion {
-    int pattern = arc4random() % 2;
-    if (pattern == 0) {
-        int index = arc4random() % [self.colors.allKeys count];
-        NSString *text = [self.colors.allKeys objectAtIndex:index];
-        self.stroopContentView.colorLabelText = text;
-        UIColor *color = [self.colors valueForKey:text];
-        self.stroopContentView.colorLabelColor = color;
-    }
-    else {
-        int index = arc4random() % [self.differentColorLabels.allKeys count];
-        NSString *text = [self.differentColorLabels.allKeys objectAtIndex:index];
-        self.stroopContentView.colorLabelText = text;
-        NSArray *colorArray = [self.differentColorLabels valueForKey:text];
-        int randomColor = arc4random() % colorArray.count;
-        UIColor *color = [colorArray objectAtIndex:randomColor];
-        self.stroopContentView.colorLabelColor = color;
+    if (![self.engine startTrialAtTime:ORKClockSystemUptime()]) {
+        return;
     }
+    self.stroopContentView.colorLabelText = self.engine.currentText;
+    self.stroopContentView.colorLabelColor = self.colors[self.engine.currentColorName];
     [self setButtonsEnabled];
-    _startTime = [NSProcessInfo processInfo].systemUptime;
 }
 
 - (void)setButtonsDisabled {
@@ -32,6 +32,7 @@
 #import "ORKTappingIntervalResult.h"
 
 #import "ORKResult_Private.h"
+#import "ORKTappingSampleBuffer.h"
 #import "ORKHelpers_Internal.h"
 
 
@@ -89,11 +90,17 @@
 @end
 
 
+// Samples are archived as one block of packed records. Archives written before the packed format store an
+// array of ORKTappingSample objects under the "samples" key, which is still read.
+static NSString *const ORKTappingIntervalResultSampleRecordsKey = @"sampleRecords";
+
 @implementation ORKTappingIntervalResult
 
 - (void)encodeWithCoder:(NSCoder *)aCoder {
     [super encodeWithCoder:aCoder];
-    ORK_ENCODE_OBJ(aCoder, samples);
+    if (_samples != nil) {
+        [aCoder encodeObject:[[ORKTappingSampleArray sampleArrayWithSamples:_samples] archivedRecords] forKey:ORKTappingIntervalResultSampleRecordsKey];
+    }
     ORK_ENCODE_CGRECT(aCoder, buttonRect1);
     ORK_ENCODE_CGRECT(aCoder, buttonRect2);
     ORK_ENCODE_CGSIZE(aCoder, stepViewSize);
@@ -102,7 +109,12 @@
 - (instancetype)initWithCoder:(NSCoder *)aDecoder {
     self = [super initWithCoder:aDecoder];
     if (self) {
-        ORK_DECODE_OBJ_ARRAY(aDecoder, samples, ORKTappingSample);
+        NSData *sampleRecords = [aDecoder decodeObjectOfClass:[NSData class] forKey:ORKTappingIntervalResultSampleRecordsKey];
+        if (sampleRecords != nil) {
+            _samples = [ORKTappingSampleArray sampleArrayWithArchivedRecords:sampleRecords];
+        } else {
+            ORK_DECODE_OBJ_ARRAY(aDecoder, samples, ORKTappingSample);
+        }
         ORK_DECODE_CGRECT(aDecoder, buttonRect1);
         ORK_DECODE_CGRECT(aDecoder, buttonRect2);
         ORK_DECODE_CGSIZE(aDecoder, stepViewSize);
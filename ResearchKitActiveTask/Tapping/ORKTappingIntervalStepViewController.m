@@ -41,15 +41,17 @@
 #import "ORKActiveStepView.h"
 #import "ORKCollectionResult_Private.h"
 #import "ORKTappingIntervalResult.h"
+#import "ORKTappingSampleBuffer.h"
 #import "ORKStep.h"
 #import "ORKNavigationContainerView_Internal.h"
 
 #import "ORKHelpers_Internal.h"
+#import "ORKClock.h"
 
 
 @interface ORKTappingIntervalStepViewController () <UIGestureRecognizerDelegate>
 
-@property (nonatomic, strong) NSMutableArray *samples;
+@property (nonatomic, strong) ORKTappingSampleBuffer *samples;
 
 @end
 
@@ -130,7 +132,7 @@
     tappingResult.buttonRect2 = _buttonRect2;
     tappingResult.stepViewSize = _viewSize;
     
-    tappingResult.samples = _samples;
+    tappingResult.samples = [_samples snapshot];
     
     [results addObject:tappingResult];
     sResult.results = [results copy];
@@ -154,13 +156,7 @@
     // Add new sample
     mediaTime = mediaTime-_tappingStart;
     
-    ORKTappingSample *sample = [[ORKTappingSample alloc] init];
-    sample.buttonIdentifier = buttonIdentifier;
-    sample.location = location;
-    sample.duration = 0;
-    sample.timestamp = mediaTime;
-
-    [self.samples addObject:sample];
+    [self.samples appendSampleWithTimestamp:mediaTime location:location buttonIdentifier:buttonIdentifier];
     
     if (buttonIdentifier == ORKTappingButtonIdentifierLeft || buttonIdentifier == ORKTappingButtonIdentifierRight) {
         _hitButtonCount++;
@@ -183,19 +179,8 @@
     }
     NSTimeInterval mediaTime = touch.timestamp;
     
-    // Take last sample for buttonIdentifier, and fill duration
-    ORKTappingSample *sample = [self lastSampleWithEmptyDurationForButton:buttonIdentifier];
-    sample.duration = mediaTime - sample.timestamp - _tappingStart;
-}
-
-- (ORKTappingSample *)lastSampleWithEmptyDurationForButton:(ORKTappingButtonIdentifier)buttonIdentifier{
-    NSEnumerator *enumerator = [self.samples reverseObjectEnumerator];
-    for (ORKTappingSample *sample in enumerator) {
-        if (sample.buttonIdentifier == buttonIdentifier && sample.duration == 0) {
-            return sample;
-        }
-    }
-    return nil;
+    // Take last open sample for buttonIdentifier, and fill duration
+    [self.samples closeOpenSampleForButton:buttonIdentifier atTimestamp:mediaTime - _tappingStart];
 }
 
 - (void)fillSampleDurationIfAnyButtonPressed {
@@ -205,17 +190,10 @@
      * The value of this property is the time, in seconds, since system startup the touch either originated or was last changed.
      * For a definition of the time-since-boot value, see the description of the systemUptime method of the NSProcessInfo class.
      */
-    NSTimeInterval mediaTime = [[NSProcessInfo processInfo] systemUptime];
-    
-    ORKTappingSample *tapButton1LastSample = [self lastSampleWithEmptyDurationForButton:ORKTappingButtonIdentifierLeft];
-    if (tapButton1LastSample) {
-        tapButton1LastSample.duration = mediaTime - tapButton1LastSample.timestamp - _tappingStart;
-    }
+    NSTimeInterval mediaTime = ORKClockSystemUptime();
     
-    ORKTappingSample *tapButton2LastSample = [self lastSampleWithEmptyDurationForButton:ORKTappingButtonIdentifierRight];
-    if (tapButton2LastSample) {
-        tapButton2LastSample.duration = mediaTime - tapButton2LastSample.timestamp - _tappingStart;
-    }
+    [self.samples closeOpenSampleForButton:ORKTappingButtonIdentifierLeft atTimestamp:mediaTime - _tappingStart];
+    [self.samples closeOpenSampleForButton:ORKTappingButtonIdentifierRight atTimestamp:mediaTime - _tappingStart];
 }
 
 - (void)stepDidFinish {
@@ -264,7 +242,7 @@
     
     if (self.samples == nil) {
         // Start timer on first touch event on button
-        _samples = [NSMutableArray array];
+        _samples = [ORKTappingSampleBuffer new];
         _hitButtonCount = 0;
         [self start];
     }
@@ -0,0 +1,130 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <ResearchKitActiveTask/ORKTappingIntervalResult.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The plain storage for one tapping sample.
+ */
+typedef struct {
+    NSTimeInterval timestamp;
+    NSTimeInterval duration;
+    CGPoint location;
+    ORKTappingButtonIdentifier buttonIdentifier;
+} ORKTappingSampleRecord;
+
+
+/**
+ An immutable array of tapping samples backed by contiguous `ORKTappingSampleRecord` storage.
+ 
+ `ORKTappingSample` objects are created the first time an element is accessed, so results that are only
+ archived or serialized never allocate per-sample objects. Copying the array returns the receiver, and archiving it directly produces a plain `NSArray`.
+ */
+@interface ORKTappingSampleArray : NSArray<ORKTappingSample *>
+
+/**
+ Returns an array holding a copy of `count` records.
+ */
+- (instancetype)initWithRecords:(const ORKTappingSampleRecord *_Nullable)records count:(NSUInteger)count;
+
+/**
+ Returns an array packed from `ORKTappingSample` objects.
+ */
+- (instancetype)initWithObjects:(const id _Nonnull [_Nullable])objects count:(NSUInteger)count;
+
+/**
+ Returns `samples` if it is already a sample array, or a packed copy of it otherwise.
+ */
++ (instancetype)sampleArrayWithSamples:(NSArray<ORKTappingSample *> *)samples;
+
+/**
+ Returns an array unpacked from data produced by `archivedRecords`, or nil if the data is malformed.
+ */
++ (nullable instancetype)sampleArrayWithArchivedRecords:(NSData *)data;
+
+/**
+ Calls `block` once per sample, in order, without materializing sample objects.
+ */
+- (void)enumerateRecordsUsingBlock:(void (NS_NOESCAPE ^)(const ORKTappingSampleRecord *record, NSUInteger index, BOOL *stop))block;
+
+/**
+ The samples packed as fixed-size little-endian records, suitable for archiving.
+ */
+- (NSData *)archivedRecords;
+
+- (nullable instancetype)initWithCoder:(NSCoder *)coder NS_UNAVAILABLE;
+
+@end
+
+
+/**
+ The live sample buffer behind a tapping step.
+ 
+ The buffer appends records to contiguous storage and keeps, per button, a stack of presses that have not
+ been released yet, so closing a press takes constant time. `snapshot` shares the storage with the returned
+ array; the next mutation copies it first, so snapshots never observe later taps.
+ 
+ The buffer is not thread-safe; use it from one queue. Snapshots may be used from any thread.
+ */
+@interface ORKTappingSampleBuffer : NSObject
+
+/**
+ The number of samples recorded so far.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ Appends a sample with zero duration. Presses on the left and right buttons stay open until
+ `closeOpenSampleForButton:atTimestamp:` is called for that button.
+ */
+- (void)appendSampleWithTimestamp:(NSTimeInterval)timestamp
+                         location:(CGPoint)location
+                 buttonIdentifier:(ORKTappingButtonIdentifier)buttonIdentifier;
+
+/**
+ Sets the duration of the most recent open press on `buttonIdentifier` so that it ends at `timestamp`.
+ 
+ @return `NO` if the button has no open press.
+ */
+- (BOOL)closeOpenSampleForButton:(ORKTappingButtonIdentifier)buttonIdentifier atTimestamp:(NSTimeInterval)timestamp;
+
+/**
+ Returns an immutable array of the samples recorded so far.
+ */
+- (ORKTappingSampleArray *)snapshot;
+
+@end
+
+NS_ASSUME_NONNULL_END
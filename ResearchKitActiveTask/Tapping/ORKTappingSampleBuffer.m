@@ -0,0 +1,466 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKTappingSampleBuffer.h"
+
+#import "ORKHelpers_Internal.h"
+
+#import <os/lock.h>
+
+
+static const NSUInteger ORKTappingSampleStorageMinimumCapacity = 64;
+
+// Left and right presses are tracked; presses outside the buttons are never released.
+static const NSUInteger ORKTappingSampleBufferOpenPressSlotCount = ORKTappingButtonIdentifierRight + 1;
+
+static BOOL ORKTappingSampleBufferTracksButton(ORKTappingButtonIdentifier buttonIdentifier) {
+    return (buttonIdentifier == ORKTappingButtonIdentifierLeft || buttonIdentifier == ORKTappingButtonIdentifierRight);
+}
+
+static void *ORKTappingSampleReallocate(void *pointer, NSUInteger count, size_t elementSize) {
+    if (count > SIZE_MAX / elementSize) {
+        @throw [NSException exceptionWithName:NSMallocException reason:@"Tapping sample storage overflow" userInfo:nil];
+    }
+    void *result = realloc(pointer, count * elementSize);
+    if (result == NULL) {
+        @throw [NSException exceptionWithName:NSMallocException reason:@"Unable to grow tapping sample storage" userInfo:nil];
+    }
+    return result;
+}
+
+static ORKTappingSampleRecord ORKTappingSampleRecordFromSample(ORKTappingSample *sample) {
+    return (ORKTappingSampleRecord) {
+        .timestamp = sample.timestamp,
+        .duration = sample.duration,
+        .location = sample.location,
+        .buttonIdentifier = sample.buttonIdentifier
+    };
+}
+
+static ORKTappingSample *ORKTappingSampleFromRecord(const ORKTappingSampleRecord *record) {
+    ORKTappingSample *sample = [[ORKTappingSample alloc] init];
+    sample.timestamp = record->timestamp;
+    sample.duration = record->duration;
+    sample.location = record->location;
+    sample.buttonIdentifier = record->buttonIdentifier;
+    return sample;
+}
+
+static BOOL ORKTappingSampleRecordsEqual(const ORKTappingSampleRecord *a, const ORKTappingSampleRecord *b) {
+    // Same comparison as -[ORKTappingSample isEqual:].
+    return ((a->timestamp == b->timestamp) &&
+            (a->duration == b->duration) &&
+            CGPointEqualToPoint(a->location, b->location) &&
+            (a->buttonIdentifier == b->buttonIdentifier));
+}
+
+#pragma mark - Archived record layout
+
+// Each archived record is five little-endian 64-bit fields: timestamp, duration, x, y (IEEE 754 doubles)
+// and the button identifier (a signed integer). The layout does not depend on the host's CGFloat or NSInteger.
+typedef struct {
+    uint64_t timestamp;
+    uint64_t duration;
+    uint64_t x;
+    uint64_t y;
+    uint64_t buttonIdentifier;
+} ORKTappingSampleArchivedRecord;
+
+static uint64_t ORKTappingSampleArchiveDouble(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return CFSwapInt64HostToLittle(bits);
+}
+
+static double ORKTappingSampleUnarchiveDouble(uint64_t value) {
+    uint64_t bits = CFSwapInt64LittleToHost(value);
+    double result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+static ORKTappingSampleArchivedRecord ORKTappingSampleArchiveRecord(const ORKTappingSampleRecord *record) {
+    return (ORKTappingSampleArchivedRecord) {
+        .timestamp = ORKTappingSampleArchiveDouble(record->timestamp),
+        .duration = ORKTappingSampleArchiveDouble(record->duration),
+        .x = ORKTappingSampleArchiveDouble(record->location.x),
+        .y = ORKTappingSampleArchiveDouble(record->location.y),
+        .buttonIdentifier = CFSwapInt64HostToLittle((uint64_t)(int64_t)record->buttonIdentifier)
+    };
+}
+
+static ORKTappingSampleRecord ORKTappingSampleUnarchiveRecord(const ORKTappingSampleArchivedRecord *record) {
+    return (ORKTappingSampleRecord) {
+        .timestamp = ORKTappingSampleUnarchiveDouble(record->timestamp),
+        .duration = ORKTappingSampleUnarchiveDouble(record->duration),
+        .location = CGPointMake(ORKTappingSampleUnarchiveDouble(record->x), ORKTappingSampleUnarchiveDouble(record->y)),
+        .buttonIdentifier = (ORKTappingButtonIdentifier)(int64_t)CFSwapInt64LittleToHost(record->buttonIdentifier)
+    };
+}
+
+
+#pragma mark - ORKTappingSampleStorage
+
+/**
+ Growable record storage. Once a snapshot references it, it is never mutated again.
+ */
+@interface ORKTappingSampleStorage : NSObject {
+@public
+    ORKTappingSampleRecord *_records;
+    NSUInteger _count;
+    NSUInteger _capacity;
+}
+
+@end
+
+
+@implementation ORKTappingSampleStorage
+
+- (void)dealloc {
+    free(_records);
+}
+
+- (void)reserveCapacity:(NSUInteger)capacity {
+    if (capacity <= _capacity) {
+        return;
+    }
+    NSUInteger newCapacity = MAX(_capacity, ORKTappingSampleStorageMinimumCapacity);
+    while (newCapacity < capacity) {
+        newCapacity *= 2;
+    }
+    _records = ORKTappingSampleReallocate(_records, newCapacity, sizeof(ORKTappingSampleRecord));
+    _capacity = newCapacity;
+}
+
+- (void)appendRecords:(const ORKTappingSampleRecord *)records count:(NSUInteger)count {
+    if (count == 0) {
+        return;
+    }
+    [self reserveCapacity:_count + count];
+    memcpy(_records + _count, records, count * sizeof(ORKTappingSampleRecord));
+    _count += count;
+}
+
+- (ORKTappingSampleStorage *)mutableCopyReservingCapacity:(NSUInteger)capacity {
+    ORKTappingSampleStorage *storage = [ORKTappingSampleStorage new];
+    [storage reserveCapacity:MAX(capacity, _count)];
+    [storage appendRecords:_records count:_count];
+    return storage;
+}
+
+@end
+
+
+#pragma mark - ORKTappingSampleArray
+
+@interface ORKTappingSampleArray ()
+
+- (instancetype)initWithStorage:(ORKTappingSampleStorage *)storage NS_DESIGNATED_INITIALIZER;
+
+@end
+
+
+@implementation ORKTappingSampleArray {
+    ORKTappingSampleStorage *_storage;
+    
+    os_unfair_lock _objectsLock;
+    NSArray<ORKTappingSample *> *_objects;
+}
+
+- (instancetype)initWithStorage:(ORKTappingSampleStorage *)storage {
+    self = [super init];
+    if (self) {
+        _storage = storage;
+        _objectsLock = OS_UNFAIR_LOCK_INIT;
+    }
+    return self;
+}
+
+- (instancetype)initWithRecords:(const ORKTappingSampleRecord *)records count:(NSUInteger)count {
+    ORKTappingSampleStorage *storage = [ORKTappingSampleStorage new];
+    if (records != NULL) {
+        [storage appendRecords:records count:count];
+    }
+    return [self initWithStorage:storage];
+}
+
+- (instancetype)initWithObjects:(const id _Nonnull [])objects count:(NSUInteger)count {
+    ORKTappingSampleStorage *storage = [ORKTappingSampleStorage new];
+    [storage reserveCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        ORKTappingSampleRecord record = ORKTappingSampleRecordFromSample(objects[index]);
+        [storage appendRecords:&record count:1];
+    }
+    return [self initWithStorage:storage];
+}
+
+- (instancetype)init {
+    return [self initWithRecords:NULL count:0];
+}
+
+- (instancetype)initWithCoder:(NSCoder *)coder {
+    ORKThrowMethodUnavailableException();
+}
+
++ (instancetype)sampleArrayWithSamples:(NSArray<ORKTappingSample *> *)samples {
+    if ([samples isKindOfClass:[ORKTappingSampleArray class]]) {
+        return (ORKTappingSampleArray *)samples;
+    }
+    ORKTappingSampleStorage *storage = [ORKTappingSampleStorage new];
+    [storage reserveCapacity:samples.count];
+    for (ORKTappingSample *sample in samples) {
+        ORKTappingSampleRecord record = ORKTappingSampleRecordFromSample(sample);
+        [storage appendRecords:&record count:1];
+    }
+    return [[self alloc] initWithStorage:storage];
+}
+
++ (instancetype)sampleArrayWithArchivedRecords:(NSData *)data {
+    if (data.length % sizeof(ORKTappingSampleArchivedRecord) != 0) {
+        return nil;
+    }
+    NSUInteger count = data.length / sizeof(ORKTappingSampleArchivedRecord);
+    ORKTappingSampleStorage *storage = [ORKTappingSampleStorage new];
+    [storage reserveCapacity:count];
+    const uint8_t *bytes = data.bytes;
+    for (NSUInteger index = 0; index < count; index++) {
+        ORKTappingSampleArchivedRecord archived;
+        memcpy(&archived, bytes + index * sizeof(archived), sizeof(archived));
+        storage->_records[index] = ORKTappingSampleUnarchiveRecord(&archived);
+    }
+    storage->_count = count;
+    return [[self alloc] initWithStorage:storage];
+}
+
+- (NSArray<ORKTappingSample *> *)materializedObjectsIfAny {
+    os_unfair_lock_lock(&_objectsLock);
+    NSArray<ORKTappingSample *> *objects = _objects;
+    os_unfair_lock_unlock(&_objectsLock);
+    return objects;
+}
+
+- (NSArray<ORKTappingSample *> *)materializedObjects {
+    os_unfair_lock_lock(&_objectsLock);
+    if (_objects == nil) {
+        NSUInteger count = _storage->_count;
+        NSMutableArray<ORKTappingSample *> *objects = [NSMutableArray arrayWithCapacity:count];
+        for (NSUInteger index = 0; index < count; index++) {
+            [objects addObject:ORKTappingSampleFromRecord(&_storage->_records[index])];
+        }
+        _objects = [objects copy];
+    }
+    NSArray<ORKTappingSample *> *objects = _objects;
+    os_unfair_lock_unlock(&_objectsLock);
+    return objects;
+}
+
+- (void)enumerateRecordsUsingBlock:(void (NS_NOESCAPE ^)(const ORKTappingSampleRecord *, NSUInteger, BOOL *))block {
+    // Samples handed out by -objectAtIndex: are mutable, so once they exist they are the source of truth.
+    NSArray<ORKTappingSample *> *objects = [self materializedObjectsIfAny];
+    BOOL stop = NO;
+    NSUInteger count = _storage->_count;
+    for (NSUInteger index = 0; index < count && !stop; index++) {
+        if (objects) {
+            ORKTappingSampleRecord record = ORKTappingSampleRecordFromSample(objects[index]);
+            block(&record, index, &stop);
+        } else {
+            block(&_storage->_records[index], index, &stop);
+        }
+    }
+}
+
+- (NSData *)archivedRecords {
+    NSMutableData *data = [NSMutableData dataWithLength:_storage->_count * sizeof(ORKTappingSampleArchivedRecord)];
+    ORKTappingSampleArchivedRecord *archived = data.mutableBytes;
+    [self enumerateRecordsUsingBlock:^(const ORKTappingSampleRecord *record, NSUInteger index, __unused BOOL *stop) {
+        archived[index] = ORKTappingSampleArchiveRecord(record);
+    }];
+    return data;
+}
+
+#pragma mark NSArray
+
+- (NSUInteger)count {
+    return _storage->_count;
+}
+
+- (ORKTappingSample *)objectAtIndex:(NSUInteger)index {
+    if (index >= _storage->_count) {
+        @throw [NSException exceptionWithName:NSRangeException
+                                       reason:[NSString stringWithFormat:@"index %lu beyond bounds [0 .. %ld]", (unsigned long)index, (long)_storage->_count - 1]
+                                     userInfo:nil];
+    }
+    return [self materializedObjects][index];
+}
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id __unsafe_unretained _Nullable [])buffer count:(NSUInteger)len {
+    return [[self materializedObjects] countByEnumeratingWithState:state objects:buffer count:len];
+}
+
+- (BOOL)isEqualToArray:(NSArray *)otherArray {
+    if (![otherArray isKindOfClass:[ORKTappingSampleArray class]]) {
+        return [super isEqualToArray:otherArray];
+    }
+    ORKTappingSampleArray *other = (ORKTappingSampleArray *)otherArray;
+    if (other == self) {
+        return YES;
+    }
+    if (other.count != self.count) {
+        return NO;
+    }
+    if ([self materializedObjectsIfAny] == nil && [other materializedObjectsIfAny] == nil) {
+        const ORKTappingSampleRecord *otherRecords = other->_storage->_records;
+        __block BOOL isEqual = YES;
+        [self enumerateRecordsUsingBlock:^(const ORKTappingSampleRecord *record, NSUInteger index, BOOL *stop) {
+            if (!ORKTappingSampleRecordsEqual(record, &otherRecords[index])) {
+                isEqual = NO;
+                *stop = YES;
+            }
+        }];
+        return isEqual;
+    }
+    return [super isEqualToArray:otherArray];
+}
+
+- (BOOL)isEqual:(id)object {
+    if ([object isKindOfClass:[NSArray class]]) {
+        return [self isEqualToArray:object];
+    }
+    return NO;
+}
+
+- (NSUInteger)hash {
+    return _storage->_count;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    return self;
+}
+
+- (Class)classForCoder {
+    return [NSArray class];
+}
+
+- (Class)classForKeyedArchiver {
+    return [NSArray class];
+}
+
+@end
+
+
+#pragma mark - ORKTappingSampleBuffer
+
+@implementation ORKTappingSampleBuffer {
+    ORKTappingSampleStorage *_storage;
+    ORKTappingSampleArray *_snapshot;
+    
+    // For each sample, the index of the press on the same button that was open before it, or NSNotFound.
+    NSUInteger *_previousOpenIndexes;
+    NSUInteger _previousOpenIndexesCapacity;
+    NSUInteger _openIndexes[ORKTappingSampleBufferOpenPressSlotCount];
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _storage = [ORKTappingSampleStorage new];
+        for (NSUInteger slot = 0; slot < ORKTappingSampleBufferOpenPressSlotCount; slot++) {
+            _openIndexes[slot] = NSNotFound;
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_previousOpenIndexes);
+}
+
+- (NSUInteger)count {
+    return _storage->_count;
+}
+
+- (void)prepareStorageForMutationWithAdditionalCount:(NSUInteger)additionalCount {
+    if (_snapshot != nil) {
+        // The last snapshot owns the current storage; write to a private copy from now on.
+        _storage = [_storage mutableCopyReservingCapacity:_storage->_capacity];
+        _snapshot = nil;
+    }
+    [_storage reserveCapacity:_storage->_count + additionalCount];
+}
+
+- (void)appendSampleWithTimestamp:(NSTimeInterval)timestamp
+                         location:(CGPoint)location
+                 buttonIdentifier:(ORKTappingButtonIdentifier)buttonIdentifier {
+    [self prepareStorageForMutationWithAdditionalCount:1];
+    
+    NSUInteger index = _storage->_count;
+    ORKTappingSampleRecord record = {
+        .timestamp = timestamp,
+        .duration = 0,
+        .location = location,
+        .buttonIdentifier = buttonIdentifier
+    };
+    [_storage appendRecords:&record count:1];
+    
+    if (ORKTappingSampleBufferTracksButton(buttonIdentifier)) {
+        if (index >= _previousOpenIndexesCapacity) {
+            _previousOpenIndexesCapacity = _storage->_capacity;
+            _previousOpenIndexes = ORKTappingSampleReallocate(_previousOpenIndexes, _previousOpenIndexesCapacity, sizeof(NSUInteger));
+        }
+        _previousOpenIndexes[index] = _openIndexes[buttonIdentifier];
+        _openIndexes[buttonIdentifier] = index;
+    }
+}
+
+- (BOOL)closeOpenSampleForButton:(ORKTappingButtonIdentifier)buttonIdentifier atTimestamp:(NSTimeInterval)timestamp {
+    if (!ORKTappingSampleBufferTracksButton(buttonIdentifier)) {
+        return NO;
+    }
+    NSUInteger index = _openIndexes[buttonIdentifier];
+    if (index == NSNotFound) {
+        return NO;
+    }
+    [self prepareStorageForMutationWithAdditionalCount:0];
+    
+    ORKTappingSampleRecord *record = &_storage->_records[index];
+    record->duration = timestamp - record->timestamp;
+    _openIndexes[buttonIdentifier] = _previousOpenIndexes[index];
+    return YES;
+}
+
+- (ORKTappingSampleArray *)snapshot {
+    if (_snapshot == nil) {
+        _snapshot = [[ORKTappingSampleArray alloc] initWithStorage:_storage];
+    }
+    return _snapshot;
+}
+
+@end
@@ -52,18 +52,14 @@
 
 #import "ORKAudioGenerator.h"
 
+#import "ORKToneSynthesisEngine.h"
+
 @import AudioToolbox;
 
 
 @interface ORKAudioGenerator () {
-  @public
     AudioComponentInstance _toneUnit;
-    double _frequency;
-    double _theta;
-    ORKAudioChannel _activeChannel;
-    BOOL _playsStereo;
-    double _fadeInFactor;
-    NSTimeInterval _fadeInDuration;
+    ORKToneSynthesisEngine *_engine;
 }
 
 - (void)setupAudioSession;
@@ -77,60 +73,13 @@
 const double ORKSineWaveToneGeneratorAmplitudeDefault = 0.03f;
 const double ORKSineWaveToneGeneratorSampleRateDefault = 44100.0f;
 
-static OSStatus ORKAudioGeneratorRenderTone(void *inRefCon,
-                                            AudioUnitRenderActionFlags *ioActionFlags,
-                                            const AudioTimeStamp 		*inTimeStamp,
-                                            UInt32 					inBusNumber,
-                                            UInt32 					inNumberFrames,
-                                            AudioBufferList 			*ioData) {
-    // Fixed amplitude is good enough for our purposes
-    const double amplitude = ORKSineWaveToneGeneratorAmplitudeDefault;
-
-    // Get the tone parameters out of the view controller
-    ORKAudioGenerator *audioGenerator = (__bridge ORKAudioGenerator *)inRefCon;
-    double theta = audioGenerator->_theta;
-    double theta_increment = 2.0 * M_PI * audioGenerator->_frequency / ORKSineWaveToneGeneratorSampleRateDefault;
-
-    double fadeInFactor = audioGenerator->_fadeInFactor;
-
-    // This is a mono tone generator so we only need the first buffer
-    Float32 *bufferActive    = (Float32 *)ioData->mBuffers[audioGenerator->_activeChannel].mData;
-    Float32 *bufferNonActive = (Float32 *)ioData->mBuffers[1 - audioGenerator->_activeChannel].mData;
-
-    // Generate the samples
-    for (UInt32 frame = 0; frame < inNumberFrames; frame++) {
-        double bufferValue = sin(theta) * amplitude * pow(10, 2 * fadeInFactor - 2);
-        bufferActive[frame] = bufferValue;
-        if (audioGenerator->_playsStereo) {
-            bufferNonActive[frame] = bufferValue;
-        } else {
-            bufferNonActive[frame] = 0;
-        }
-
-        theta += theta_increment;
-        if (theta > 2.0 * M_PI) {
-            theta -= 2.0 * M_PI;
-        }
-
-        fadeInFactor += 1.0 / (ORKSineWaveToneGeneratorSampleRateDefault * audioGenerator->_fadeInDuration);
-        if (fadeInFactor >= 1) {
-            fadeInFactor = 1;
-        }
-    }
-
-    // Store the theta back in the view controller
-    audioGenerator->_theta = theta;
-    audioGenerator->_fadeInFactor = fadeInFactor;
-
-    return noErr;
-}
-
 
 @implementation ORKAudioGenerator
 
 - (instancetype)init {
     self = [super init];
     if (self) {
+        _engine = [[ORKToneSynthesisEngine alloc] initWithSampleRate:ORKSineWaveToneGeneratorSampleRateDefault];
         [self setupAudioSession];
         
         // Automatically stop and then restart audio playback when the app resigns active.
@@ -165,26 +114,32 @@ static OSStatus ORKAudioGeneratorRenderTone(void *inRefCon,
 }
 
 - (double)volumeAmplitude {
-    return ORKSineWaveToneGeneratorAmplitudeDefault * pow(10, 2 * _fadeInFactor - 2);
+    return _engine.currentAmplitude;
 }
 
 - (void)playSoundAtFrequency:(double)playFrequency {
-    _frequency = playFrequency;
-    _fadeInFactor = 0;
-    _fadeInDuration = 0.5;
-    _playsStereo = YES;
+    ORKToneSynthesisStimulus *stimulus = [ORKToneSynthesisStimulus toneWithFrequency:playFrequency
+                                                                           amplitude:ORKSineWaveToneGeneratorAmplitudeDefault];
+    stimulus.fadeInDuration = 0.5;
 
-    [self play];
+    [self playStimulus:stimulus];
 }
 
 - (void)playSoundAtFrequency:(double)playFrequency
                    onChannel:(ORKAudioChannel)playChannel
               fadeInDuration:(NSTimeInterval)duration {
-    _frequency = playFrequency;
-    _activeChannel = playChannel;
-    _fadeInFactor = 0;
-    _fadeInDuration = duration;
-    _playsStereo = NO;
+    ORKToneSynthesisStimulus *stimulus = [ORKToneSynthesisStimulus toneWithFrequency:playFrequency
+                                                                           amplitude:ORKSineWaveToneGeneratorAmplitudeDefault];
+    stimulus.fadeInDuration = duration;
+    [stimulus setGain:0 forChannel:(playChannel == ORKAudioChannelLeft) ? ORKAudioChannelRight : ORKAudioChannelLeft];
+
+    [self playStimulus:stimulus];
+}
+
+- (void)playStimulus:(ORKToneSynthesisStimulus *)stimulus {
+    // A new tone replaces the previous one and fades in from the start of the next buffer.
+    [_engine stopAllVoicesAtSampleTime:ORKToneSynthesisSampleTimeImmediate fadeOutDuration:0];
+    [_engine startStimulus:stimulus atSampleTime:ORKToneSynthesisSampleTimeImmediate];
 
     [self play];
 }
@@ -245,8 +200,8 @@ static OSStatus ORKAudioGeneratorRenderTone(void *inRefCon,
 
     // Set our tone rendering function on the unit
     AURenderCallbackStruct input;
-    input.inputProc = ORKAudioGeneratorRenderTone;
-    input.inputProcRefCon = (__bridge void *)(self);
+    input.inputProc = ORKToneSynthesisEngineRenderCallback;
+    input.inputProcRefCon = _engine.renderCallbackRefCon;
     error = AudioUnitSetProperty(_toneUnit,
                                kAudioUnitProperty_SetRenderCallback,
                                kAudioUnitScope_Input,
@@ -119,9 +119,7 @@
             [self.frequencies addObject:@[self.listOfFrequencies[i], [NSNumber numberWithInt:j]]];
         }
     }
-    for (int k = 0; k<[self.frequencies count]; k++) {
-        [self.frequencies exchangeObjectAtIndex:(arc4random() % [self.frequencies count]) withObjectAtIndex:(arc4random() % [self.frequencies count])];
-    }
+    [self.randomNumberGenerator shuffleArray:self.frequencies];
 }
 
 - (void)viewDidAppear:(BOOL)animated {
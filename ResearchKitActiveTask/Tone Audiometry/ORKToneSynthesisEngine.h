@@ -0,0 +1,178 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <AVFoundation/AVFoundation.h>
+#import <AudioToolbox/AudioToolbox.h>
+#import <ResearchKit/ORKTypes.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, ORKToneSynthesisStimulusType) {
+    /// A pure sinusoid.
+    ORKToneSynthesisStimulusTypeTone,
+    
+    /// White noise passed through a band-pass filter.
+    ORKToneSynthesisStimulusTypeBandLimitedNoise
+};
+
+/// A position on the engine's timeline, counted in frames rendered since the engine was created.
+typedef int64_t ORKToneSynthesisSampleTime;
+
+/// Schedules an event at the first frame of the next rendered buffer.
+ORK_EXTERN const ORKToneSynthesisSampleTime ORKToneSynthesisSampleTimeImmediate;
+
+/// Identifies a voice started on an engine. Zero is never a valid voice.
+typedef uint64_t ORKToneSynthesisVoice;
+
+ORK_EXTERN const ORKToneSynthesisVoice ORKToneSynthesisVoiceNone;
+
+/**
+ Describes one voice to be synthesized by an `ORKToneSynthesisEngine`.
+ 
+ The envelope of a voice follows the curve used by the tone audiometry generators:
+ `amplitude * 10^(2f - 2)`, with `f` moving linearly between 0 and 1 over the fade duration.
+ */
+@interface ORKToneSynthesisStimulus : NSObject <NSCopying>
+
++ (instancetype)toneWithFrequency:(double)frequency amplitude:(double)amplitude;
+
+/// The noise is filtered by a band-pass biquad centered on the geometric mean of the band edges.
++ (instancetype)noiseWithLowerFrequency:(double)lowerFrequency
+                         upperFrequency:(double)upperFrequency
+                              amplitude:(double)amplitude;
+
+@property (nonatomic, readonly) ORKToneSynthesisStimulusType type;
+
+/// The frequency of a tone, in hertz.
+@property (nonatomic, readonly) double frequency;
+
+/// The band edges of a noise stimulus, in hertz.
+@property (nonatomic, readonly) double lowerFrequency;
+
+@property (nonatomic, readonly) double upperFrequency;
+
+/// The peak amplitude, from 0 to 1. For noise, this is the peak of the unfiltered noise.
+@property (nonatomic) double amplitude;
+
+/// The duration of the fade-in at the start of the voice. Defaults to 0, which starts at full amplitude.
+@property (nonatomic) NSTimeInterval fadeInDuration;
+
+/// The gain applied to one output channel of the voice. Both channels default to 1.
+- (void)setGain:(double)gain forChannel:(ORKAudioChannel)channel;
+
+- (double)gainForChannel:(ORKAudioChannel)channel;
+
+@end
+
+
+/**
+ Synthesizes tones and band-limited noise into stereo, non-interleaved float buffers.
+ 
+ Voices are scheduled at sample-accurate positions on the engine's timeline. Scheduling calls
+ never touch the render state directly: they post commands to a lock-free queue that the render
+ thread drains at the start of every buffer, so rendering never blocks or allocates.
+ 
+ Oscillators, envelopes and mixing are computed a buffer at a time with Accelerate. The same
+ render path drives a real-time audio unit through `ORKToneSynthesisEngineRenderCallback` or
+ fills buffers offline, so stimuli can be checked without audio hardware.
+ 
+ Render from a single thread at a time.
+ */
+@interface ORKToneSynthesisEngine : NSObject
+
+/// Creates an engine at 44.1 kHz.
+- (instancetype)init;
+
+- (instancetype)initWithSampleRate:(double)sampleRate NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readonly) double sampleRate;
+
+/// The number of frames rendered so far, as of the end of the last rendered buffer.
+@property (nonatomic, readonly) ORKToneSynthesisSampleTime sampleTime;
+
+/// The summed envelope amplitude of the sounding voices at the end of the last rendered buffer.
+@property (nonatomic, readonly) double currentAmplitude;
+
+/// The number of voices scheduled or sounding at the end of the last rendered buffer.
+@property (nonatomic, readonly) NSUInteger activeVoiceCount;
+
+/**
+ Starts a voice at `sampleTime`. A time in the past starts the voice with the next buffer.
+ 
+ Returns `ORKToneSynthesisVoiceNone` if the command queue is full.
+ */
+- (ORKToneSynthesisVoice)startStimulus:(ORKToneSynthesisStimulus *)stimulus
+                          atSampleTime:(ORKToneSynthesisSampleTime)sampleTime;
+
+/// Fades a voice out from `sampleTime` and then releases it. A duration of 0 stops it on that frame.
+- (BOOL)stopVoice:(ORKToneSynthesisVoice)voice
+     atSampleTime:(ORKToneSynthesisSampleTime)sampleTime
+  fadeOutDuration:(NSTimeInterval)fadeOutDuration;
+
+- (BOOL)stopAllVoicesAtSampleTime:(ORKToneSynthesisSampleTime)sampleTime
+                  fadeOutDuration:(NSTimeInterval)fadeOutDuration;
+
+/// The gain applied to every voice on one output channel, read at the start of each buffer.
+- (void)setGain:(float)gain forChannel:(ORKAudioChannel)channel;
+
+- (float)gainForChannel:(ORKAudioChannel)channel;
+
+/**
+ Renders `frameCount` frames into the buffers of `bufferList`, which hold one channel each.
+ Buffers past the second are left untouched.
+ */
+- (void)renderFrameCount:(UInt32)frameCount intoBufferList:(AudioBufferList *)bufferList;
+
+/// Renders `frameCount` frames into a new stereo buffer.
+- (nullable AVAudioPCMBuffer *)renderOfflineWithFrameCount:(AVAudioFrameCount)frameCount;
+
+/**
+ The `inputProcRefCon` to install with `ORKToneSynthesisEngineRenderCallback`. It points at the
+ engine's render state and stays valid as long as the engine does.
+ */
+@property (nonatomic, readonly) void *renderCallbackRefCon;
+
+@end
+
+/**
+ An audio unit render callback whose `inRefCon` is an engine's `renderCallbackRefCon`.
+ 
+ It renders without sending Objective-C messages, so it is safe on the real-time audio thread.
+ */
+ORK_EXTERN OSStatus ORKToneSynthesisEngineRenderCallback(void *inRefCon,
+                                                         AudioUnitRenderActionFlags *ioActionFlags,
+                                                         const AudioTimeStamp *inTimeStamp,
+                                                         UInt32 inBusNumber,
+                                                         UInt32 inNumberFrames,
+                                                         AudioBufferList *ioData);
+
+NS_ASSUME_NONNULL_END
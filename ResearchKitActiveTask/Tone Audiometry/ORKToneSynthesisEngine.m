@@ -0,0 +1,579 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKToneSynthesisEngine.h"
+
+#import "ORKHelpers_Internal.h"
+
+@import Accelerate;
+
+#include <os/lock.h>
+#include <stdatomic.h>
+
+
+const ORKToneSynthesisSampleTime ORKToneSynthesisSampleTimeImmediate = -1;
+const ORKToneSynthesisVoice ORKToneSynthesisVoiceNone = 0;
+
+#define ORKToneSynthesisMaximumSliceFrameCount 4096
+#define ORKToneSynthesisVoiceCapacity 16
+#define ORKToneSynthesisCommandCapacity 64
+#define ORKToneSynthesisChannelCount 2
+
+static const ORKToneSynthesisSampleTime ORKToneSynthesisSampleTimeNever = INT64_MAX;
+
+typedef NS_ENUM(NSInteger, ORKToneSynthesisCommandType) {
+    ORKToneSynthesisCommandTypeStart,
+    ORKToneSynthesisCommandTypeStop,
+    ORKToneSynthesisCommandTypeStopAll
+};
+
+typedef struct {
+    ORKToneSynthesisStimulusType type;
+    double phaseIncrement;
+    float filterCoefficients[5];
+    float amplitude;
+    float channelGains[ORKToneSynthesisChannelCount];
+    // Envelope steps are in units of the fade factor per frame; zero means no fade.
+    double fadeInStep;
+} ORKToneSynthesisVoiceParameters;
+
+typedef struct {
+    ORKToneSynthesisCommandType type;
+    ORKToneSynthesisVoice voice;
+    ORKToneSynthesisSampleTime sampleTime;
+    double fadeOutStep;
+    ORKToneSynthesisVoiceParameters parameters;
+} ORKToneSynthesisCommand;
+
+typedef struct {
+    ORKToneSynthesisVoice voice;
+    ORKToneSynthesisVoiceParameters parameters;
+    ORKToneSynthesisSampleTime startTime;
+    ORKToneSynthesisSampleTime stopTime;
+    double fadeOutStep;
+    BOOL stopping;
+    double phase;
+    double fade;
+    uint32_t noiseState;
+    // The last two inputs and outputs of the band-pass filter, oldest first.
+    float filterInputHistory[2];
+    float filterOutputHistory[2];
+} ORKToneSynthesisVoiceState;
+
+typedef struct {
+    // Written by the scheduling threads, read by the render thread.
+    _Alignas(64) _Atomic(uint64_t) commandWriteIndex;
+    _Alignas(64) _Atomic(uint64_t) commandReadIndex;
+    ORKToneSynthesisCommand commands[ORKToneSynthesisCommandCapacity];
+    _Atomic(float) channelGains[ORKToneSynthesisChannelCount];
+    
+    // Published by the render thread at the end of every buffer.
+    _Alignas(64) _Atomic(int64_t) publishedSampleTime;
+    _Atomic(double) publishedAmplitude;
+    _Atomic(uint64_t) publishedVoiceCount;
+    
+    // Owned by the render thread.
+    _Alignas(64) ORKToneSynthesisSampleTime sampleTime;
+    ORKToneSynthesisVoiceState voices[ORKToneSynthesisVoiceCapacity];
+    double phases[ORKToneSynthesisMaximumSliceFrameCount];
+    double envelope[ORKToneSynthesisMaximumSliceFrameCount];
+    float envelopeGains[ORKToneSynthesisMaximumSliceFrameCount];
+    float signal[ORKToneSynthesisMaximumSliceFrameCount];
+    float noiseInput[ORKToneSynthesisMaximumSliceFrameCount + 2];
+    float noiseOutput[ORKToneSynthesisMaximumSliceFrameCount + 2];
+} ORKToneSynthesisState;
+
+static const double ORKToneSynthesisEnvelopeScale = 2.0 * M_LN10;
+
+static double ORKToneSynthesisEnvelopeGain(double fade) {
+    return pow(10, 2 * fade - 2);
+}
+
+static double ORKToneSynthesisStepForDuration(NSTimeInterval duration, double sampleRate) {
+    return duration > 0 ? 1.0 / (sampleRate * duration) : 0;
+}
+
+#pragma mark Render thread
+
+static void ORKToneSynthesisReleaseVoice(ORKToneSynthesisVoiceState *voice) {
+    voice->voice = ORKToneSynthesisVoiceNone;
+}
+
+static void ORKToneSynthesisScheduleStop(ORKToneSynthesisState *state, ORKToneSynthesisVoiceState *voice, const ORKToneSynthesisCommand *command) {
+    ORKToneSynthesisSampleTime stopTime = command->sampleTime < 0 ? state->sampleTime : command->sampleTime;
+    if (stopTime <= voice->startTime) {
+        // The voice would stop before it was ever heard.
+        ORKToneSynthesisReleaseVoice(voice);
+        return;
+    }
+    if (voice->stopping) {
+        // A voice that is already fading out can only be cut shorter, and only from now.
+        if (stopTime <= state->sampleTime && (command->fadeOutStep <= 0 || command->fadeOutStep > voice->fadeOutStep)) {
+            voice->fadeOutStep = command->fadeOutStep;
+        }
+        return;
+    }
+    voice->stopTime = stopTime;
+    voice->fadeOutStep = command->fadeOutStep;
+}
+
+static void ORKToneSynthesisApplyCommand(ORKToneSynthesisState *state, const ORKToneSynthesisCommand *command) {
+    switch (command->type) {
+        case ORKToneSynthesisCommandTypeStart: {
+            for (NSUInteger index = 0; index < ORKToneSynthesisVoiceCapacity; index++) {
+                ORKToneSynthesisVoiceState *voice = &state->voices[index];
+                if (voice->voice != ORKToneSynthesisVoiceNone) {
+                    continue;
+                }
+                memset(voice, 0, sizeof(*voice));
+                voice->voice = command->voice;
+                voice->parameters = command->parameters;
+                voice->startTime = MAX(command->sampleTime, state->sampleTime);
+                voice->stopTime = ORKToneSynthesisSampleTimeNever;
+                voice->fade = command->parameters.fadeInStep > 0 ? 0 : 1;
+                // Any nonzero seed works for xorshift; derive it from the voice so renders are repeatable.
+                voice->noiseState = (uint32_t)(command->voice * 2654435761u) | 1;
+                break;
+            }
+            // With every voice busy the start is dropped, as a real-time thread cannot grow the pool.
+            break;
+        }
+        case ORKToneSynthesisCommandTypeStop: {
+            for (NSUInteger index = 0; index < ORKToneSynthesisVoiceCapacity; index++) {
+                ORKToneSynthesisVoiceState *voice = &state->voices[index];
+                if (voice->voice == command->voice) {
+                    ORKToneSynthesisScheduleStop(state, voice, command);
+                    break;
+                }
+            }
+            break;
+        }
+        case ORKToneSynthesisCommandTypeStopAll: {
+            for (NSUInteger index = 0; index < ORKToneSynthesisVoiceCapacity; index++) {
+                ORKToneSynthesisVoiceState *voice = &state->voices[index];
+                if (voice->voice != ORKToneSynthesisVoiceNone) {
+                    ORKToneSynthesisScheduleStop(state, voice, command);
+                }
+            }
+            break;
+        }
+    }
+}
+
+static void ORKToneSynthesisApplyCommands(ORKToneSynthesisState *state) {
+    uint64_t readIndex = atomic_load_explicit(&state->commandReadIndex, memory_order_relaxed);
+    uint64_t writeIndex = atomic_load_explicit(&state->commandWriteIndex, memory_order_acquire);
+    for (; readIndex != writeIndex; readIndex++) {
+        ORKToneSynthesisApplyCommand(state, &state->commands[readIndex % ORKToneSynthesisCommandCapacity]);
+    }
+    atomic_store_explicit(&state->commandReadIndex, readIndex, memory_order_release);
+}
+
+static const float *ORKToneSynthesisRenderOscillator(ORKToneSynthesisState *state, ORKToneSynthesisVoiceState *voice, UInt32 frameCount) {
+    if (voice->parameters.type == ORKToneSynthesisStimulusTypeTone) {
+        double phase = voice->phase;
+        double phaseIncrement = voice->parameters.phaseIncrement;
+        int count = (int)frameCount;
+        vDSP_vrampD(&phase, &phaseIncrement, state->phases, 1, frameCount);
+        vvsin(state->phases, state->phases, &count);
+        vDSP_vdpsp(state->phases, 1, state->signal, 1, frameCount);
+        voice->phase = fmod(phase + phaseIncrement * frameCount, 2.0 * M_PI);
+        return state->signal;
+    }
+    
+    // The filter reads two frames of history ahead of each buffer.
+    float *input = state->noiseInput;
+    float *output = state->noiseOutput;
+    memcpy(input, voice->filterInputHistory, sizeof(voice->filterInputHistory));
+    memcpy(output, voice->filterOutputHistory, sizeof(voice->filterOutputHistory));
+    uint32_t noiseState = voice->noiseState;
+    for (UInt32 frame = 0; frame < frameCount; frame++) {
+        noiseState ^= noiseState << 13;
+        noiseState ^= noiseState >> 17;
+        noiseState ^= noiseState << 5;
+        input[frame + 2] = (float)(int32_t)noiseState * (1.0f / 2147483648.0f);
+    }
+    voice->noiseState = noiseState;
+    vDSP_deq22(input, 1, voice->parameters.filterCoefficients, output, 1, frameCount);
+    memcpy(voice->filterInputHistory, input + frameCount, sizeof(voice->filterInputHistory));
+    memcpy(voice->filterOutputHistory, output + frameCount, sizeof(voice->filterOutputHistory));
+    return output + 2;
+}
+
+static void ORKToneSynthesisRenderSegment(ORKToneSynthesisState *state,
+                                          ORKToneSynthesisVoiceState *voice,
+                                          float *outputs[ORKToneSynthesisChannelCount],
+                                          const float channelGains[ORKToneSynthesisChannelCount],
+                                          UInt32 offset,
+                                          UInt32 frameCount) {
+    const float *oscillator = ORKToneSynthesisRenderOscillator(state, voice, frameCount);
+    float *signal = state->signal;
+    float amplitude = voice->parameters.amplitude;
+    
+    double fadeStep = voice->stopping ? -voice->fadeOutStep : (voice->fade < 1 ? voice->parameters.fadeInStep : 0);
+    if (fadeStep == 0) {
+        vDSP_vsmul(oscillator, 1, &amplitude, signal, 1, frameCount);
+    } else {
+        // 10^(2f - 2) == exp(2 ln(10) f - 2 ln(10)), with f clamped to the fade range.
+        double fade = voice->fade;
+        double lowerFade = 0;
+        double upperFade = 1;
+        double envelopeScale = ORKToneSynthesisEnvelopeScale;
+        double envelopeOffset = -ORKToneSynthesisEnvelopeScale;
+        int count = (int)frameCount;
+        vDSP_vrampD(&fade, &fadeStep, state->envelope, 1, frameCount);
+        vDSP_vclipD(state->envelope, 1, &lowerFade, &upperFade, state->envelope, 1, frameCount);
+        vDSP_vsmsaD(state->envelope, 1, &envelopeScale, &envelopeOffset, state->envelope, 1, frameCount);
+        vvexp(state->envelope, state->envelope, &count);
+        vDSP_vdpsp(state->envelope, 1, state->envelopeGains, 1, frameCount);
+        vDSP_vmul(oscillator, 1, state->envelopeGains, 1, signal, 1, frameCount);
+        vDSP_vsmul(signal, 1, &amplitude, signal, 1, frameCount);
+        voice->fade = MIN(MAX(fade + fadeStep * frameCount, 0), 1);
+    }
+    
+    for (NSUInteger channel = 0; channel < ORKToneSynthesisChannelCount; channel++) {
+        float gain = voice->parameters.channelGains[channel] * channelGains[channel];
+        if (outputs[channel] && gain != 0) {
+            vDSP_vsma(signal, 1, &gain, outputs[channel] + offset, 1, outputs[channel] + offset, 1, frameCount);
+        }
+    }
+}
+
+static void ORKToneSynthesisRenderVoice(ORKToneSynthesisState *state,
+                                        ORKToneSynthesisVoiceState *voice,
+                                        float *outputs[ORKToneSynthesisChannelCount],
+                                        const float channelGains[ORKToneSynthesisChannelCount],
+                                        UInt32 frameCount) {
+    ORKToneSynthesisSampleTime sliceStart = state->sampleTime;
+    ORKToneSynthesisSampleTime sliceEnd = sliceStart + frameCount;
+    if (voice->startTime >= sliceEnd) {
+        return;
+    }
+    
+    // Split the slice where the voice starts, where its fade-out starts and where it falls silent.
+    UInt32 frame = (UInt32)MAX(voice->startTime - sliceStart, 0);
+    while (frame < frameCount) {
+        ORKToneSynthesisSampleTime now = sliceStart + frame;
+        if (!voice->stopping && now >= voice->stopTime) {
+            voice->stopping = YES;
+        }
+        
+        UInt32 segmentFrameCount = frameCount - frame;
+        if (voice->stopping) {
+            if (voice->fadeOutStep <= 0 || voice->fade <= 0) {
+                ORKToneSynthesisReleaseVoice(voice);
+                return;
+            }
+            segmentFrameCount = (UInt32)MIN((double)segmentFrameCount, ceil(voice->fade / voice->fadeOutStep));
+        } else if (voice->stopTime < sliceEnd) {
+            segmentFrameCount = (UInt32)(voice->stopTime - now);
+        }
+        
+        ORKToneSynthesisRenderSegment(state, voice, outputs, channelGains, frame, segmentFrameCount);
+        frame += segmentFrameCount;
+    }
+    
+    if (voice->stopping && voice->fade <= 0) {
+        ORKToneSynthesisReleaseVoice(voice);
+    }
+}
+
+static void ORKToneSynthesisPublish(ORKToneSynthesisState *state) {
+    double amplitude = 0;
+    uint64_t voiceCount = 0;
+    for (NSUInteger index = 0; index < ORKToneSynthesisVoiceCapacity; index++) {
+        ORKToneSynthesisVoiceState *voice = &state->voices[index];
+        if (voice->voice == ORKToneSynthesisVoiceNone) {
+            continue;
+        }
+        voiceCount++;
+        if (voice->startTime < state->sampleTime) {
+            amplitude += voice->parameters.amplitude * ORKToneSynthesisEnvelopeGain(voice->fade);
+        }
+    }
+    atomic_store_explicit(&state->publishedAmplitude, amplitude, memory_order_relaxed);
+    atomic_store_explicit(&state->publishedVoiceCount, voiceCount, memory_order_relaxed);
+    atomic_store_explicit(&state->publishedSampleTime, state->sampleTime, memory_order_release);
+}
+
+static void ORKToneSynthesisRender(ORKToneSynthesisState *state, UInt32 frameCount, AudioBufferList *bufferList) {
+    float *outputs[ORKToneSynthesisChannelCount] = { NULL };
+    for (UInt32 channel = 0; channel < MIN(bufferList->mNumberBuffers, (UInt32)ORKToneSynthesisChannelCount); channel++) {
+        outputs[channel] = (float *)bufferList->mBuffers[channel].mData;
+        vDSP_vclr(outputs[channel], 1, frameCount);
+    }
+    
+    for (UInt32 offset = 0; offset < frameCount;) {
+        UInt32 sliceFrameCount = MIN(frameCount - offset, (UInt32)ORKToneSynthesisMaximumSliceFrameCount);
+        
+        // Parameters change only on buffer boundaries.
+        ORKToneSynthesisApplyCommands(state);
+        float channelGains[ORKToneSynthesisChannelCount];
+        float *sliceOutputs[ORKToneSynthesisChannelCount];
+        for (NSUInteger channel = 0; channel < ORKToneSynthesisChannelCount; channel++) {
+            channelGains[channel] = atomic_load_explicit(&state->channelGains[channel], memory_order_relaxed);
+            sliceOutputs[channel] = outputs[channel] ? outputs[channel] + offset : NULL;
+        }
+        
+        for (NSUInteger index = 0; index < ORKToneSynthesisVoiceCapacity; index++) {
+            ORKToneSynthesisVoiceState *voice = &state->voices[index];
+            if (voice->voice != ORKToneSynthesisVoiceNone) {
+                ORKToneSynthesisRenderVoice(state, voice, sliceOutputs, channelGains, sliceFrameCount);
+            }
+        }
+        
+        state->sampleTime += sliceFrameCount;
+        offset += sliceFrameCount;
+    }
+    
+    ORKToneSynthesisPublish(state);
+}
+
+OSStatus ORKToneSynthesisEngineRenderCallback(void *inRefCon,
+                                              AudioUnitRenderActionFlags *ioActionFlags,
+                                              const AudioTimeStamp *inTimeStamp,
+                                              UInt32 inBusNumber,
+                                              UInt32 inNumberFrames,
+                                              AudioBufferList *ioData) {
+    ORKToneSynthesisRender((ORKToneSynthesisState *)inRefCon, inNumberFrames, ioData);
+    return noErr;
+}
+
+
+@implementation ORKToneSynthesisStimulus {
+    double _channelGains[ORKToneSynthesisChannelCount];
+}
+
++ (instancetype)toneWithFrequency:(double)frequency amplitude:(double)amplitude {
+    ORKToneSynthesisStimulus *stimulus = [[self alloc] initWithType:ORKToneSynthesisStimulusTypeTone amplitude:amplitude];
+    stimulus->_frequency = frequency;
+    return stimulus;
+}
+
++ (instancetype)noiseWithLowerFrequency:(double)lowerFrequency
+                         upperFrequency:(double)upperFrequency
+                              amplitude:(double)amplitude {
+    NSParameterAssert(lowerFrequency > 0 && upperFrequency > lowerFrequency);
+    ORKToneSynthesisStimulus *stimulus = [[self alloc] initWithType:ORKToneSynthesisStimulusTypeBandLimitedNoise amplitude:amplitude];
+    stimulus->_lowerFrequency = lowerFrequency;
+    stimulus->_upperFrequency = upperFrequency;
+    return stimulus;
+}
+
+- (instancetype)initWithType:(ORKToneSynthesisStimulusType)type amplitude:(double)amplitude {
+    self = [super init];
+    if (self) {
+        _type = type;
+        _amplitude = amplitude;
+        for (NSUInteger channel = 0; channel < ORKToneSynthesisChannelCount; channel++) {
+            _channelGains[channel] = 1;
+        }
+    }
+    return self;
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone {
+    ORKToneSynthesisStimulus *stimulus = [[[self class] allocWithZone:zone] initWithType:_type amplitude:_amplitude];
+    stimulus->_frequency = _frequency;
+    stimulus->_lowerFrequency = _lowerFrequency;
+    stimulus->_upperFrequency = _upperFrequency;
+    stimulus->_fadeInDuration = _fadeInDuration;
+    memcpy(stimulus->_channelGains, _channelGains, sizeof(_channelGains));
+    return stimulus;
+}
+
+- (void)setGain:(double)gain forChannel:(ORKAudioChannel)channel {
+    NSParameterAssert(channel < ORKToneSynthesisChannelCount);
+    _channelGains[channel] = gain;
+}
+
+- (double)gainForChannel:(ORKAudioChannel)channel {
+    NSParameterAssert(channel < ORKToneSynthesisChannelCount);
+    return _channelGains[channel];
+}
+
+- (ORKToneSynthesisVoiceParameters)voiceParametersForSampleRate:(double)sampleRate {
+    ORKToneSynthesisVoiceParameters parameters = { 0 };
+    parameters.type = _type;
+    parameters.amplitude = _amplitude;
+    parameters.fadeInStep = ORKToneSynthesisStepForDuration(_fadeInDuration, sampleRate);
+    for (NSUInteger channel = 0; channel < ORKToneSynthesisChannelCount; channel++) {
+        parameters.channelGains[channel] = _channelGains[channel];
+    }
+    
+    if (_type == ORKToneSynthesisStimulusTypeTone) {
+        parameters.phaseIncrement = 2.0 * M_PI * _frequency / sampleRate;
+    } else {
+        // A constant 0 dB peak gain band-pass biquad, from the Audio EQ Cookbook.
+        double upperFrequency = MIN(_upperFrequency, 0.49 * sampleRate);
+        double centerFrequency = sqrt(_lowerFrequency * upperFrequency);
+        double q = centerFrequency / MAX(upperFrequency - _lowerFrequency, 1);
+        double omega = 2.0 * M_PI * centerFrequency / sampleRate;
+        double alpha = sin(omega) / (2.0 * q);
+        double a0 = 1.0 + alpha;
+        parameters.filterCoefficients[0] = alpha / a0;
+        parameters.filterCoefficients[1] = 0;
+        parameters.filterCoefficients[2] = -alpha / a0;
+        parameters.filterCoefficients[3] = -2.0 * cos(omega) / a0;
+        parameters.filterCoefficients[4] = (1.0 - alpha) / a0;
+    }
+    return parameters;
+}
+
+@end
+
+
+@implementation ORKToneSynthesisEngine {
+    ORKToneSynthesisState *_state;
+    os_unfair_lock _commandLock;
+    ORKToneSynthesisVoice _lastVoice;
+}
+
+- (instancetype)init {
+    return [self initWithSampleRate:44100.0];
+}
+
+- (instancetype)initWithSampleRate:(double)sampleRate {
+    NSParameterAssert(sampleRate > 0);
+    self = [super init];
+    if (self) {
+        _sampleRate = sampleRate;
+        _commandLock = OS_UNFAIR_LOCK_INIT;
+        _state = calloc(1, sizeof(ORKToneSynthesisState));
+        if (!_state) {
+            return nil;
+        }
+        for (NSUInteger channel = 0; channel < ORKToneSynthesisChannelCount; channel++) {
+            atomic_init(&_state->channelGains[channel], 1.0f);
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_state);
+}
+
+- (ORKToneSynthesisSampleTime)sampleTime {
+    return atomic_load_explicit(&_state->publishedSampleTime, memory_order_acquire);
+}
+
+- (double)currentAmplitude {
+    return atomic_load_explicit(&_state->publishedAmplitude, memory_order_relaxed);
+}
+
+- (NSUInteger)activeVoiceCount {
+    return (NSUInteger)atomic_load_explicit(&_state->publishedVoiceCount, memory_order_relaxed);
+}
+
+- (BOOL)enqueueCommand:(ORKToneSynthesisCommand *)command {
+    // The lock only orders scheduling threads among themselves; the render thread never takes it.
+    os_unfair_lock_lock(&_commandLock);
+    uint64_t writeIndex = atomic_load_explicit(&_state->commandWriteIndex, memory_order_relaxed);
+    uint64_t readIndex = atomic_load_explicit(&_state->commandReadIndex, memory_order_acquire);
+    BOOL enqueued = writeIndex - readIndex < ORKToneSynthesisCommandCapacity;
+    if (enqueued) {
+        if (command->type == ORKToneSynthesisCommandTypeStart) {
+            command->voice = ++_lastVoice;
+        }
+        _state->commands[writeIndex % ORKToneSynthesisCommandCapacity] = *command;
+        atomic_store_explicit(&_state->commandWriteIndex, writeIndex + 1, memory_order_release);
+    }
+    os_unfair_lock_unlock(&_commandLock);
+    
+    if (!enqueued) {
+        ORK_Log_Error("Tone synthesis command queue is full; dropping command");
+    }
+    return enqueued;
+}
+
+- (ORKToneSynthesisVoice)startStimulus:(ORKToneSynthesisStimulus *)stimulus
+                          atSampleTime:(ORKToneSynthesisSampleTime)sampleTime {
+    ORKToneSynthesisCommand command = { 0 };
+    command.type = ORKToneSynthesisCommandTypeStart;
+    command.sampleTime = sampleTime;
+    command.parameters = [stimulus voiceParametersForSampleRate:_sampleRate];
+    return [self enqueueCommand:&command] ? command.voice : ORKToneSynthesisVoiceNone;
+}
+
+- (BOOL)stopVoice:(ORKToneSynthesisVoice)voice
+     atSampleTime:(ORKToneSynthesisSampleTime)sampleTime
+  fadeOutDuration:(NSTimeInterval)fadeOutDuration {
+    if (voice == ORKToneSynthesisVoiceNone) {
+        return NO;
+    }
+    ORKToneSynthesisCommand command = { 0 };
+    command.type = ORKToneSynthesisCommandTypeStop;
+    command.voice = voice;
+    command.sampleTime = sampleTime;
+    command.fadeOutStep = ORKToneSynthesisStepForDuration(fadeOutDuration, _sampleRate);
+    return [self enqueueCommand:&command];
+}
+
+- (BOOL)stopAllVoicesAtSampleTime:(ORKToneSynthesisSampleTime)sampleTime
+                  fadeOutDuration:(NSTimeInterval)fadeOutDuration {
+    ORKToneSynthesisCommand command = { 0 };
+    command.type = ORKToneSynthesisCommandTypeStopAll;
+    command.sampleTime = sampleTime;
+    command.fadeOutStep = ORKToneSynthesisStepForDuration(fadeOutDuration, _sampleRate);
+    return [self enqueueCommand:&command];
+}
+
+- (void)setGain:(float)gain forChannel:(ORKAudioChannel)channel {
+    NSParameterAssert(channel < ORKToneSynthesisChannelCount);
+    atomic_store_explicit(&_state->channelGains[channel], gain, memory_order_relaxed);
+}
+
+- (float)gainForChannel:(ORKAudioChannel)channel {
+    NSParameterAssert(channel < ORKToneSynthesisChannelCount);
+    return atomic_load_explicit(&_state->channelGains[channel], memory_order_relaxed);
+}
+
+- (void *)renderCallbackRefCon {
+    return _state;
+}
+
+- (void)renderFrameCount:(UInt32)frameCount intoBufferList:(AudioBufferList *)bufferList {
+    ORKToneSynthesisRender(_state, frameCount, bufferList);
+}
+
+- (AVAudioPCMBuffer *)renderOfflineWithFrameCount:(AVAudioFrameCount)frameCount {
+    AVAudioFormat *format = [[AVAudioFormat alloc] initStandardFormatWithSampleRate:_sampleRate channels:ORKToneSynthesisChannelCount];
+    AVAudioPCMBuffer *buffer = [[AVAudioPCMBuffer alloc] initWithPCMFormat:format frameCapacity:frameCount];
+    if (!buffer) {
+        return nil;
+    }
+    buffer.frameLength = frameCount;
+    [self renderFrameCount:frameCount intoBufferList:buffer.mutableAudioBufferList];
+    return buffer;
+}
+
+@end
@@ -33,7 +33,7 @@
 #import "ORKResult_Private.h"
 #import "ORKHelpers_Internal.h"
 #import "ORKTouchAbilityTrial.h"
-#import "ORKTouchAbilityTapTrial.h"
+#import "ORKTouchAbilityLongPressTrial.h"
 
 @implementation ORKTouchAbilityLongPressResult
 
@@ -48,7 +48,7 @@
 
 - (instancetype)initWithCoder:(NSCoder *)aDecoder {
     if (self = [super initWithCoder:aDecoder]) {
-        ORK_DECODE_OBJ_ARRAY(aDecoder, trials, ORKTouchAbilityTapTrial);
+        ORK_DECODE_OBJ_ARRAY(aDecoder, trials, ORKTouchAbilityLongPressTrial);
     }
     return self;
 }
@@ -146,12 +146,7 @@
         }
     }
     
-    NSUInteger count = [points count];
-    for (NSUInteger i = 0; i < count; i++) {
-        NSUInteger nElements = count - i;
-        NSUInteger n = (arc4random() % nElements) + i;
-        [points exchangeObjectAtIndex:i withObjectAtIndex:n];
-    }
+    [self.randomNumberGenerator shuffleArray:points];
     
     return points;
 }
@@ -28,6 +28,7 @@
  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #import "ORKTouchAbilityPinchResult.h"
+#import "ORKTouchAbilityPinchTrial.h"
 #import "ORKHelpers_Internal.h"
 
 @implementation ORKTouchAbilityPinchResult
@@ -39,7 +40,7 @@
 
 - (instancetype)initWithCoder:(NSCoder *)aDecoder {
     if (self = [super initWithCoder:aDecoder]) {
-        ORK_ENCODE_OBJ(aDecoder, trials);
+        ORK_DECODE_OBJ_ARRAY(aDecoder, trials, ORKTouchAbilityPinchTrial);
     }
     return self;
 }
@@ -123,12 +123,7 @@
     NSMutableArray *array = @[@(1.0/2.0), @(2.0/3.0), @(3.0/2.0), @2.0].mutableCopy;
     [array addObjectsFromArray:array];
     
-    NSUInteger count = [array count];
-    for (NSUInteger i = 0; i < count; i++) {
-        NSUInteger nElements = count - i;
-        NSUInteger n = (arc4random() % nElements) + i;
-        [array exchangeObjectAtIndex:i withObjectAtIndex:n];
-    }
+    [self.randomNumberGenerator shuffleArray:array];
     
     return [array copy];
 }
@@ -29,6 +29,7 @@
  */
 
 #import "ORKTouchAbilityRotationResult.h"
+#import "ORKTouchAbilityRotationTrial.h"
 #import "ORKHelpers_Internal.h"
 
 @implementation ORKTouchAbilityRotationResult
@@ -40,7 +41,7 @@
 
 - (instancetype)initWithCoder:(NSCoder *)aDecoder {
     if (self = [super initWithCoder:aDecoder]) {
-        ORK_ENCODE_OBJ(aDecoder, trials);
+        ORK_DECODE_OBJ_ARRAY(aDecoder, trials, ORKTouchAbilityRotationTrial);
     }
     return self;
 }
@@ -124,12 +124,7 @@
     NSMutableArray *array = @[@(M_PI/3.0), @(M_PI/6.0), @(-M_PI/6.0), @(-M_PI/3.0)].mutableCopy;
     [array addObjectsFromArray:array];
     
-    NSUInteger count = [array count];
-    for (NSUInteger i = 0; i < count; i++) {
-        NSUInteger nElements = count - i;
-        NSUInteger n = (arc4random() % nElements) + i;
-        [array exchangeObjectAtIndex:i withObjectAtIndex:n];
-    }
+    [self.randomNumberGenerator shuffleArray:array];
     
     return [array copy];
 }
@@ -29,6 +29,7 @@
  */
 
 #import "ORKTouchAbilityScrollResult.h"
+#import "ORKTouchAbilityScrollTrial.h"
 #import "ORKHelpers_Internal.h"
 
 @implementation ORKTouchAbilityScrollResult
@@ -40,7 +41,7 @@
 
 - (instancetype)initWithCoder:(NSCoder *)aDecoder {
     if (self = [super initWithCoder:aDecoder]) {
-        ORK_ENCODE_OBJ(aDecoder, trials);
+        ORK_DECODE_OBJ_ARRAY(aDecoder, trials, ORKTouchAbilityScrollTrial);
     }
     return self;
 }
@@ -151,12 +151,7 @@ ORKTouchAbilityContentViewDelegate
     [array addObject:TrialData(19, 5, 11, 7)];
     [array addObjectsFromArray:array];
     
-    NSUInteger count = [array count];
-    for (NSUInteger i = 0; i < count; i++) {
-        NSUInteger nElements = count - i;
-        NSUInteger n = (arc4random() % nElements) + i;
-        [array exchangeObjectAtIndex:i withObjectAtIndex:n];
-    }
+    [self.randomNumberGenerator shuffleArray:array];
     
     return [array copy];
 }
@@ -132,12 +132,7 @@
                                    @(UISwipeGestureRecognizerDirectionRight)].mutableCopy;
     [directions addObjectsFromArray:directions];
     
-    NSUInteger count = [directions count];
-    for (NSUInteger i = 0; i < count; i++) {
-        NSUInteger nElements = count - i;
-        NSUInteger n = (arc4random() % nElements) + i;
-        [directions exchangeObjectAtIndex:i withObjectAtIndex:n];
-    }
+    [self.randomNumberGenerator shuffleArray:directions];
     
     return [directions copy];
 }
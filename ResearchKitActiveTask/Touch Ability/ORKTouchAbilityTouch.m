@@ -32,6 +32,7 @@
 
 #import "ORKTouchAbilityTouch.h"
 #import "ORKHelpers_Internal.h"
+#import "ORKClock.h"
 
 @interface ORKTouchAbilityTouch ()
 
@@ -147,7 +148,7 @@
 - (instancetype)initWithUITouch:(UITouch *)touch {
     self = [super init];
     if (self) {
-        self.timestamp = touch.timestamp + [NSDate dateWithTimeIntervalSinceNow:-[[NSProcessInfo processInfo] systemUptime]].timeIntervalSince1970;
+        self.timestamp = touch.timestamp + [NSDate dateWithTimeIntervalSinceNow:-ORKClockSystemUptime()].timeIntervalSince1970;
         self.phase = touch.phase;
         self.tapCount = touch.tapCount;
         self.type = touch.type;
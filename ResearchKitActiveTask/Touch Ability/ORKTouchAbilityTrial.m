@@ -33,7 +33,6 @@
 #import "ORKTouchAbilityTrial_Internal.h"
 #import "ORKTouchAbilityTrack.h"
 #import "ORKTouchAbilityGestureRecoginzerEvent.h"
-#import "ORKTouchAbilityTapTrial.h"
 
 #import "ORKHelpers_Internal.h"
 
@@ -55,7 +54,7 @@
     if (self) {
         ORK_DECODE_OBJ_CLASS(aDecoder, startDate, NSDate);
         ORK_DECODE_OBJ_CLASS(aDecoder, endDate, NSDate);
-        ORK_DECODE_OBJ_ARRAY(aDecoder, tracks, ORKTouchAbilityTapTrial);
+        ORK_DECODE_OBJ_ARRAY(aDecoder, tracks, ORKTouchAbilityTrack);
         ORK_DECODE_OBJ_ARRAY(aDecoder, gestureRecognizerEvents, ORKTouchAbilityGestureRecoginzerEvent);
     }
     return self;
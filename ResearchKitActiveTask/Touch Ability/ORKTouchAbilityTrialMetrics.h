@@ -0,0 +1,193 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <UIKit/UIKit.h>
+#import <ResearchKit/ORKDefines.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ORKTouchAbilityTrial;
+
+/**
+ A single position sample of a touch track, in window coordinates.
+ */
+typedef struct {
+    NSTimeInterval timestamp;
+    CGPoint location;
+} ORKTouchAbilitySample;
+
+/**
+ Kinematic metrics derived from one or more touch tracks.
+ 
+ Speeds are expressed in points per second, accelerations in points per second squared and jerk
+ in points per second cubed.
+ */
+typedef struct {
+    NSUInteger sampleCount;
+    NSTimeInterval duration;
+    double pathLength;
+    double displacement;
+    double peakSpeed;
+    double peakAcceleration;
+    double sumOfSquaredJerk;
+    NSUInteger jerkSampleCount;
+    NSTimeInterval dwellTime;
+} ORKTouchAbilityKinematics;
+
+/**
+ The speed, in points per second, below which a touch is considered to be dwelling.
+ */
+ORK_EXTERN const double ORKTouchAbilityDefaultDwellSpeedThreshold;
+
+/**
+ Computes the kinematics of a single touch track in one pass over its samples.
+ 
+ Samples must be ordered by timestamp. Samples that share a timestamp with their predecessor
+ contribute to the path length but not to the velocity profile.
+ 
+ @param samples                 A contiguous array of samples.
+ @param count                   The number of samples in the array.
+ @param dwellSpeedThreshold     The speed below which time is accumulated as dwell time.
+ 
+ @return The kinematics of the track.
+ */
+ORK_EXTERN ORKTouchAbilityKinematics ORKTouchAbilityKinematicsForSamples(const ORKTouchAbilitySample *samples,
+                                                                         NSUInteger count,
+                                                                         double dwellSpeedThreshold);
+
+/**
+ Accumulates the kinematics of another track into an aggregate.
+ */
+ORK_EXTERN void ORKTouchAbilityKinematicsAccumulate(ORKTouchAbilityKinematics *aggregate,
+                                                    ORKTouchAbilityKinematics kinematics);
+
+
+/**
+ The `ORKTouchAbilityTrialMetrics` class summarizes the kinematics of a touch ability trial.
+ 
+ Metrics are derived from the trial's raw tracks only, so they can be computed at the end of a
+ trial or later on results that were decoded from an archive.
+ */
+ORK_CLASS_AVAILABLE
+@interface ORKTouchAbilityTrialMetrics : NSObject <NSCopying>
+
++ (instancetype)new NS_UNAVAILABLE;
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Computes the metrics of a trial.
+ 
+ @param trial   The trial to analyze.
+ 
+ @return The metrics of the trial.
+ */
++ (instancetype)metricsForTrial:(ORKTouchAbilityTrial *)trial;
+
+/**
+ Computes the metrics of a trial using a custom dwell speed threshold.
+ 
+ @param trial                   The trial to analyze.
+ @param dwellSpeedThreshold     The speed, in points per second, below which a touch is dwelling.
+ 
+ @return The metrics of the trial.
+ */
++ (instancetype)metricsForTrial:(ORKTouchAbilityTrial *)trial dwellSpeedThreshold:(double)dwellSpeedThreshold;
+
+/**
+ The number of tracks in the trial.
+ */
+@property (nonatomic, readonly) NSUInteger trackCount;
+
+/**
+ The number of touch samples across all tracks.
+ */
+@property (nonatomic, readonly) NSUInteger sampleCount;
+
+/**
+ The total time during which at least one track was being sampled, summed over tracks.
+ */
+@property (nonatomic, readonly) NSTimeInterval duration;
+
+/**
+ The total distance traveled by all tracks, in points.
+ */
+@property (nonatomic, readonly) double pathLength;
+
+/**
+ The ratio of the straight-line displacement to the path length, between 0 and 1.
+ 
+ The value is 1 when every track moves in a straight line, and 0 when no track moves.
+ */
+@property (nonatomic, readonly) double pathEfficiency;
+
+/**
+ The average speed across all tracks.
+ */
+@property (nonatomic, readonly) double meanSpeed;
+
+/**
+ The highest speed reached by any track.
+ */
+@property (nonatomic, readonly) double peakSpeed;
+
+/**
+ The highest acceleration magnitude reached by any track.
+ */
+@property (nonatomic, readonly) double peakAcceleration;
+
+/**
+ The root mean square of the jerk magnitude across all tracks.
+ */
+@property (nonatomic, readonly) double rootMeanSquareJerk;
+
+/**
+ The time spent moving slower than the dwell speed threshold.
+ */
+@property (nonatomic, readonly) NSTimeInterval dwellTime;
+
+/**
+ The difference between the resulting and the target scale of a pinch trial.
+ 
+ The value is `NAN` for trials that are not pinch trials.
+ */
+@property (nonatomic, readonly) double scaleError;
+
+/**
+ The difference, in radians, between the resulting and the target rotation of a rotation trial.
+ 
+ The value is `NAN` for trials that are not rotation trials.
+ */
+@property (nonatomic, readonly) double rotationError;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,267 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKTouchAbilityTrialMetrics.h"
+
+#import "ORKTouchAbilityPinchTrial.h"
+#import "ORKTouchAbilityRotationTrial.h"
+#import "ORKTouchAbilityTouch.h"
+#import "ORKTouchAbilityTrack.h"
+#import "ORKTouchAbilityTrial.h"
+
+#import "ORKHelpers_Internal.h"
+
+
+const double ORKTouchAbilityDefaultDwellSpeedThreshold = 20.0;
+
+ORKTouchAbilityKinematics ORKTouchAbilityKinematicsForSamples(const ORKTouchAbilitySample *samples,
+                                                              NSUInteger count,
+                                                              double dwellSpeedThreshold) {
+    ORKTouchAbilityKinematics kinematics = {0};
+    kinematics.sampleCount = count;
+    if (count == 0) {
+        return kinematics;
+    }
+    
+    const ORKTouchAbilitySample first = samples[0];
+    const ORKTouchAbilitySample last = samples[count - 1];
+    kinematics.duration = last.timestamp - first.timestamp;
+    kinematics.displacement = hypot(last.location.x - first.location.x, last.location.y - first.location.y);
+    
+    // Velocities are taken at the midpoint of each segment, accelerations at the midpoint of two
+    // consecutive velocities, and so on, so every derivative only needs the previous one.
+    BOOL hasVelocity = NO;
+    BOOL hasAcceleration = NO;
+    double previousVelocityX = 0.0;
+    double previousVelocityY = 0.0;
+    double previousVelocityTime = 0.0;
+    double previousAccelerationX = 0.0;
+    double previousAccelerationY = 0.0;
+    double previousAccelerationTime = 0.0;
+    
+    for (NSUInteger index = 1; index < count; index++) {
+        const ORKTouchAbilitySample previous = samples[index - 1];
+        const ORKTouchAbilitySample current = samples[index];
+        const double dx = current.location.x - previous.location.x;
+        const double dy = current.location.y - previous.location.y;
+        const double dt = current.timestamp - previous.timestamp;
+        const double distance = hypot(dx, dy);
+        kinematics.pathLength += distance;
+        if (dt <= 0.0) {
+            continue;
+        }
+        
+        const double speed = distance / dt;
+        kinematics.peakSpeed = MAX(kinematics.peakSpeed, speed);
+        if (speed < dwellSpeedThreshold) {
+            kinematics.dwellTime += dt;
+        }
+        
+        const double velocityX = dx / dt;
+        const double velocityY = dy / dt;
+        const double velocityTime = previous.timestamp + (dt / 2.0);
+        if (hasVelocity) {
+            const double accelerationInterval = velocityTime - previousVelocityTime;
+            const double accelerationX = (velocityX - previousVelocityX) / accelerationInterval;
+            const double accelerationY = (velocityY - previousVelocityY) / accelerationInterval;
+            const double accelerationTime = previousVelocityTime + (accelerationInterval / 2.0);
+            kinematics.peakAcceleration = MAX(kinematics.peakAcceleration, hypot(accelerationX, accelerationY));
+            if (hasAcceleration) {
+                const double jerkInterval = accelerationTime - previousAccelerationTime;
+                const double jerkX = (accelerationX - previousAccelerationX) / jerkInterval;
+                const double jerkY = (accelerationY - previousAccelerationY) / jerkInterval;
+                kinematics.sumOfSquaredJerk += (jerkX * jerkX) + (jerkY * jerkY);
+                kinematics.jerkSampleCount += 1;
+            }
+            previousAccelerationX = accelerationX;
+            previousAccelerationY = accelerationY;
+            previousAccelerationTime = accelerationTime;
+            hasAcceleration = YES;
+        }
+        previousVelocityX = velocityX;
+        previousVelocityY = velocityY;
+        previousVelocityTime = velocityTime;
+        hasVelocity = YES;
+    }
+    
+    return kinematics;
+}
+
+void ORKTouchAbilityKinematicsAccumulate(ORKTouchAbilityKinematics *aggregate,
+                                         ORKTouchAbilityKinematics kinematics) {
+    aggregate->sampleCount += kinematics.sampleCount;
+    aggregate->duration += kinematics.duration;
+    aggregate->pathLength += kinematics.pathLength;
+    aggregate->displacement += kinematics.displacement;
+    aggregate->peakSpeed = MAX(aggregate->peakSpeed, kinematics.peakSpeed);
+    aggregate->peakAcceleration = MAX(aggregate->peakAcceleration, kinematics.peakAcceleration);
+    aggregate->sumOfSquaredJerk += kinematics.sumOfSquaredJerk;
+    aggregate->jerkSampleCount += kinematics.jerkSampleCount;
+    aggregate->dwellTime += kinematics.dwellTime;
+}
+
+
+@implementation ORKTouchAbilityTrialMetrics {
+    ORKTouchAbilityKinematics _kinematics;
+}
+
++ (instancetype)new {
+    ORKThrowMethodUnavailableException();
+}
+
+- (instancetype)init {
+    ORKThrowMethodUnavailableException();
+}
+
++ (instancetype)metricsForTrial:(ORKTouchAbilityTrial *)trial {
+    return [self metricsForTrial:trial dwellSpeedThreshold:ORKTouchAbilityDefaultDwellSpeedThreshold];
+}
+
++ (instancetype)metricsForTrial:(ORKTouchAbilityTrial *)trial dwellSpeedThreshold:(double)dwellSpeedThreshold {
+    ORKTouchAbilityKinematics aggregate = {0};
+    
+    // One sample buffer is reused for every track so each track is analyzed over contiguous memory.
+    NSUInteger capacity = 0;
+    ORKTouchAbilitySample *samples = NULL;
+    for (ORKTouchAbilityTrack *track in trial.tracks) {
+        NSArray<ORKTouchAbilityTouch *> *touches = track.touches;
+        NSUInteger count = touches.count;
+        if (count > capacity) {
+            capacity = count;
+            samples = reallocf(samples, capacity * sizeof(ORKTouchAbilitySample));
+            if (samples == NULL) {
+                capacity = 0;
+                break;
+            }
+        }
+        NSUInteger index = 0;
+        for (ORKTouchAbilityTouch *touch in touches) {
+            samples[index++] = (ORKTouchAbilitySample){ touch.timestamp, touch.locationInWindow };
+        }
+        ORKTouchAbilityKinematicsAccumulate(&aggregate, ORKTouchAbilityKinematicsForSamples(samples, count, dwellSpeedThreshold));
+    }
+    free(samples);
+    
+    double scaleError = NAN;
+    if ([trial isKindOfClass:[ORKTouchAbilityPinchTrial class]]) {
+        ORKTouchAbilityPinchTrial *pinchTrial = (ORKTouchAbilityPinchTrial *)trial;
+        scaleError = pinchTrial.resultScale - pinchTrial.targetScale;
+    }
+    
+    double rotationError = NAN;
+    if ([trial isKindOfClass:[ORKTouchAbilityRotationTrial class]]) {
+        ORKTouchAbilityRotationTrial *rotationTrial = (ORKTouchAbilityRotationTrial *)trial;
+        rotationError = rotationTrial.resultRotation - rotationTrial.targetRotation;
+    }
+    
+    return [[self alloc] initWithKinematics:aggregate
+                                 trackCount:trial.tracks.count
+                                 scaleError:scaleError
+                              rotationError:rotationError];
+}
+
+- (instancetype)initWithKinematics:(ORKTouchAbilityKinematics)kinematics
+                        trackCount:(NSUInteger)trackCount
+                        scaleError:(double)scaleError
+                     rotationError:(double)rotationError {
+    self = [super init];
+    if (self) {
+        _kinematics = kinematics;
+        _trackCount = trackCount;
+        _scaleError = scaleError;
+        _rotationError = rotationError;
+    }
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    // Metrics are immutable
+    return self;
+}
+
+- (NSUInteger)sampleCount {
+    return _kinematics.sampleCount;
+}
+
+- (NSTimeInterval)duration {
+    return _kinematics.duration;
+}
+
+- (double)pathLength {
+    return _kinematics.pathLength;
+}
+
+- (double)pathEfficiency {
+    if (_kinematics.pathLength <= 0.0) {
+        return 0.0;
+    }
+    return MIN(1.0, _kinematics.displacement / _kinematics.pathLength);
+}
+
+- (double)meanSpeed {
+    if (_kinematics.duration <= 0.0) {
+        return 0.0;
+    }
+    return _kinematics.pathLength / _kinematics.duration;
+}
+
+- (double)peakSpeed {
+    return _kinematics.peakSpeed;
+}
+
+- (double)peakAcceleration {
+    return _kinematics.peakAcceleration;
+}
+
+- (double)rootMeanSquareJerk {
+    if (_kinematics.jerkSampleCount == 0) {
+        return 0.0;
+    }
+    return sqrt(_kinematics.sumOfSquaredJerk / _kinematics.jerkSampleCount);
+}
+
+- (NSTimeInterval)dwellTime {
+    return _kinematics.dwellTime;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p; tracks: %@; samples: %@; path length: %.2f; efficiency: %.3f; peak speed: %.2f; dwell: %.3f>",
+            self.class.description,
+            self,
+            @(self.trackCount),
+            @(self.sampleCount),
+            self.pathLength,
+            self.pathEfficiency,
+            self.peakSpeed,
+            self.dwellTime];
+}
+
+@end
@@ -0,0 +1,129 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <ResearchKitActiveTask/ORKTowerOfHanoiResult.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The largest number of disks an `ORKTowerOfHanoiEngine` supports.
+ */
+ORK_EXTERN const NSUInteger ORKTowerOfHanoiEngineMaximumNumberOfDisks;
+
+
+/**
+ The UI-free state machine behind the Tower of Hanoi step.
+ 
+ The puzzle starts with every disk on the first tower and is solved when every disk is on the last
+ one. Each tower is kept as a bitmask of the disks on it, so checking and making a move never
+ allocates. The engine also keeps the number of moves still needed to solve the puzzle from its
+ current state, updated as each move is made, from which it derives efficiency metrics.
+ 
+ Move times are supplied by the caller and reported relative to the first move, so a scripted
+ session produces the same result as one driven by the step view controller.
+ */
+@interface ORKTowerOfHanoiEngine : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Returns an engine for a puzzle of `numberOfDisks` disks, which must not exceed
+ `ORKTowerOfHanoiEngineMaximumNumberOfDisks`.
+ */
+- (instancetype)initWithNumberOfDisks:(NSUInteger)numberOfDisks NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readonly) NSUInteger numberOfDisks;
+
+@property (nonatomic, readonly) NSUInteger numberOfTowers;
+
+/**
+ Records the time the puzzle was first shown, from which `planningLatency` is measured.
+ */
+- (void)beginAtTime:(NSTimeInterval)time;
+
+/**
+ The disk sizes on the tower at `towerIndex`, from the bottom up. The smallest disk has size 1.
+ */
+- (NSArray<NSNumber *> *)disksOnTowerAtIndex:(NSUInteger)towerIndex;
+
+/**
+ Returns whether the top disk of the donor tower may be placed on the recipient tower.
+ */
+- (BOOL)canMoveDiskFromTowerAtIndex:(NSUInteger)donorTowerIndex toTowerAtIndex:(NSUInteger)recipientTowerIndex;
+
+/**
+ Moves the top disk of the donor tower onto the recipient tower and records the move.
+ Returns NO, leaving the towers untouched, if the move is not legal.
+ */
+- (BOOL)moveDiskFromTowerAtIndex:(NSUInteger)donorTowerIndex toTowerAtIndex:(NSUInteger)recipientTowerIndex atTime:(NSTimeInterval)time;
+
+@property (nonatomic, readonly) NSUInteger numberOfMoves;
+
+/**
+ The moves made so far. The move objects are created on each access.
+ */
+@property (nonatomic, copy, readonly) NSArray<ORKTowerOfHanoiMove *> *moves;
+
+@property (nonatomic, readonly, getter=isSolved) BOOL solved;
+
+/**
+ The number of moves an optimal solution takes, `2^numberOfDisks - 1`.
+ */
+@property (nonatomic, readonly) uint64_t minimumNumberOfMoves;
+
+/**
+ The fewest moves that would solve the puzzle from its current state.
+ */
+@property (nonatomic, readonly) uint64_t remainingNumberOfMoves;
+
+/**
+ The number of moves made beyond the progress they made toward the goal:
+ `numberOfMoves - (minimumNumberOfMoves - remainingNumberOfMoves)`.
+ */
+@property (nonatomic, readonly) uint64_t excessMoveCount;
+
+/**
+ The number of moves that left the puzzle further from solved than before.
+ */
+@property (nonatomic, readonly) NSUInteger regressionMoveCount;
+
+/**
+ The time between `beginAtTime:` and the first move, or 0 if either has not happened.
+ */
+@property (nonatomic, readonly) NSTimeInterval planningLatency;
+
+- (ORKTowerOfHanoiResult *)resultWithIdentifier:(NSString *)identifier;
+
+@end
+
+NS_ASSUME_NONNULL_END
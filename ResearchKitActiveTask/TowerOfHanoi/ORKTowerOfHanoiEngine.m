@@ -0,0 +1,210 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKTowerOfHanoiEngine.h"
+
+#import "ORKHelpers_Internal.h"
+
+
+const NSUInteger ORKTowerOfHanoiEngineMaximumNumberOfDisks = 32;
+
+static const NSUInteger NumberOfTowers = 3;
+static const uint8_t TargetTowerIndex = NumberOfTowers - 1;
+
+typedef struct {
+    NSTimeInterval timestamp;
+    uint8_t donorTowerIndex;
+    uint8_t recipientTowerIndex;
+} ORKTowerOfHanoiMoveRecord;
+
+// Disk `i` (size `i + 1`) is bit `i` of a tower mask, so the top disk of a tower is its lowest set bit.
+static inline uint32_t ORKTopDiskBit(uint32_t tower) {
+    return tower & (~tower + 1);
+}
+
+
+@implementation ORKTowerOfHanoiEngine {
+    uint32_t _towers[NumberOfTowers];
+    
+    // For each disk, the tower it has to reach in the optimal solution from the current state, given the
+    // positions of the larger disks, and the moves that disk accounts for in that solution.
+    uint8_t _goalTowerIndex[ORKTowerOfHanoiEngineMaximumNumberOfDisks];
+    uint64_t _diskCost[ORKTowerOfHanoiEngineMaximumNumberOfDisks];
+    
+    ORKTowerOfHanoiMoveRecord *_moveRecords;
+    NSUInteger _moveCapacity;
+    NSTimeInterval _startTime;
+    BOOL _started;
+}
+
+- (instancetype)init {
+    ORKThrowMethodUnavailableException();
+}
+
+- (instancetype)initWithNumberOfDisks:(NSUInteger)numberOfDisks {
+    NSParameterAssert(numberOfDisks <= ORKTowerOfHanoiEngineMaximumNumberOfDisks);
+    self = [super init];
+    if (self) {
+        _numberOfDisks = MIN(numberOfDisks, ORKTowerOfHanoiEngineMaximumNumberOfDisks);
+        _minimumNumberOfMoves = ((uint64_t)1 << _numberOfDisks) - 1;
+        _towers[0] = (uint32_t)_minimumNumberOfMoves;
+        if (_numberOfDisks > 0) {
+            [self updateDistanceFromDiskAtIndex:_numberOfDisks - 1];
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_moveRecords);
+}
+
+- (NSUInteger)numberOfTowers {
+    return NumberOfTowers;
+}
+
+- (void)beginAtTime:(NSTimeInterval)time {
+    _startTime = time;
+    _started = YES;
+}
+
+- (uint8_t)towerIndexOfDiskAtIndex:(NSUInteger)diskIndex {
+    uint32_t bit = (uint32_t)1 << diskIndex;
+    return (_towers[0] & bit) ? 0 : ((_towers[1] & bit) ? 1 : 2);
+}
+
+// Disks larger than `diskIndex` keep their goals and costs, so only the disks up to it are revisited.
+- (void)updateDistanceFromDiskAtIndex:(NSUInteger)diskIndex {
+    uint8_t goal = TargetTowerIndex;
+    if (diskIndex + 1 < _numberOfDisks) {
+        uint8_t largerGoal = _goalTowerIndex[diskIndex + 1];
+        uint8_t largerTower = [self towerIndexOfDiskAtIndex:diskIndex + 1];
+        goal = (largerTower == largerGoal) ? largerGoal : (uint8_t)(NumberOfTowers - largerTower - largerGoal);
+    }
+    for (NSInteger index = (NSInteger)diskIndex; index >= 0; index--) {
+        uint8_t tower = [self towerIndexOfDiskAtIndex:index];
+        _remainingNumberOfMoves -= _diskCost[index];
+        _goalTowerIndex[index] = goal;
+        if (tower == goal) {
+            _diskCost[index] = 0;
+        } else {
+            // The smaller disks have to clear onto the third tower before this one can reach its goal,
+            // then follow it there: 2^index moves in all, counting the move of this disk.
+            _diskCost[index] = (uint64_t)1 << index;
+            goal = (uint8_t)(NumberOfTowers - tower - goal);
+        }
+        _remainingNumberOfMoves += _diskCost[index];
+    }
+}
+
+- (NSArray<NSNumber *> *)disksOnTowerAtIndex:(NSUInteger)towerIndex {
+    NSMutableArray<NSNumber *> *disks = [NSMutableArray array];
+    for (NSInteger index = (NSInteger)_numberOfDisks - 1; index >= 0; index--) {
+        if (_towers[towerIndex] & ((uint32_t)1 << index)) {
+            [disks addObject:@(index + 1)];
+        }
+    }
+    return [disks copy];
+}
+
+- (BOOL)canMoveDiskFromTowerAtIndex:(NSUInteger)donorTowerIndex toTowerAtIndex:(NSUInteger)recipientTowerIndex {
+    if (donorTowerIndex >= NumberOfTowers || recipientTowerIndex >= NumberOfTowers || donorTowerIndex == recipientTowerIndex) {
+        return NO;
+    }
+    uint32_t disk = ORKTopDiskBit(_towers[donorTowerIndex]);
+    uint32_t recipientTop = ORKTopDiskBit(_towers[recipientTowerIndex]);
+    return disk != 0 && (recipientTop == 0 || disk < recipientTop);
+}
+
+- (BOOL)moveDiskFromTowerAtIndex:(NSUInteger)donorTowerIndex toTowerAtIndex:(NSUInteger)recipientTowerIndex atTime:(NSTimeInterval)time {
+    if (![self canMoveDiskFromTowerAtIndex:donorTowerIndex toTowerAtIndex:recipientTowerIndex]) {
+        return NO;
+    }
+    uint32_t disk = ORKTopDiskBit(_towers[donorTowerIndex]);
+    _towers[donorTowerIndex] ^= disk;
+    _towers[recipientTowerIndex] |= disk;
+    
+    uint64_t previousRemainingNumberOfMoves = _remainingNumberOfMoves;
+    [self updateDistanceFromDiskAtIndex:__builtin_ctz(disk)];
+    if (_remainingNumberOfMoves > previousRemainingNumberOfMoves) {
+        _regressionMoveCount++;
+    }
+    
+    if (_numberOfMoves == _moveCapacity) {
+        _moveCapacity = MAX(_moveCapacity * 2, 16);
+        _moveRecords = reallocf(_moveRecords, _moveCapacity * sizeof(ORKTowerOfHanoiMoveRecord));
+    }
+    _moveRecords[_numberOfMoves] = (ORKTowerOfHanoiMoveRecord){
+        .timestamp = time,
+        .donorTowerIndex = (uint8_t)donorTowerIndex,
+        .recipientTowerIndex = (uint8_t)recipientTowerIndex,
+    };
+    _numberOfMoves++;
+    return YES;
+}
+
+- (NSArray<ORKTowerOfHanoiMove *> *)moves {
+    NSMutableArray<ORKTowerOfHanoiMove *> *moves = [NSMutableArray arrayWithCapacity:_numberOfMoves];
+    for (NSUInteger index = 0; index < _numberOfMoves; index++) {
+        ORKTowerOfHanoiMove *move = [[ORKTowerOfHanoiMove alloc] init];
+        move.donorTowerIndex = _moveRecords[index].donorTowerIndex;
+        move.recipientTowerIndex = _moveRecords[index].recipientTowerIndex;
+        move.timestamp = _moveRecords[index].timestamp - _moveRecords[0].timestamp;
+        [moves addObject:move];
+    }
+    return [moves copy];
+}
+
+- (BOOL)isSolved {
+    return _remainingNumberOfMoves == 0;
+}
+
+- (uint64_t)excessMoveCount {
+    // An optimal solution lowers the remaining count by exactly one per move.
+    return _numberOfMoves + _remainingNumberOfMoves - _minimumNumberOfMoves;
+}
+
+- (NSTimeInterval)planningLatency {
+    return (_started && _numberOfMoves > 0) ? _moveRecords[0].timestamp - _startTime : 0;
+}
+
+- (ORKTowerOfHanoiResult *)resultWithIdentifier:(NSString *)identifier {
+    ORKTowerOfHanoiResult *result = [[ORKTowerOfHanoiResult alloc] initWithIdentifier:identifier];
+    result.moves = self.moves;
+    result.puzzleWasSolved = self.solved;
+    result.minimumNumberOfMoves = (NSInteger)_minimumNumberOfMoves;
+    result.excessMoveCount = (NSInteger)self.excessMoveCount;
+    result.regressionMoveCount = _regressionMoveCount;
+    result.planningLatency = self.planningLatency;
+    return result;
+}
+
+@end
@@ -62,6 +62,31 @@ ORK_CLASS_AVAILABLE
  */
 @property (nonatomic, copy, nullable) NSArray<ORKTowerOfHanoiMove *> *moves;
 
+/**
+ The number of moves an optimal solution of the puzzle takes.
+ */
+@property (nonatomic, assign) NSInteger minimumNumberOfMoves;
+
+/**
+ The number of moves made beyond the progress they made toward the goal:
+ `numberOfMoves - (minimumNumberOfMoves - remainingNumberOfMoves)`, where `numberOfMoves` is the
+ number of `moves` and `remainingNumberOfMoves` is the fewest moves that would solve the puzzle
+ from its final state.
+ 
+ The value is 0 when every move brought the puzzle one move closer to being solved.
+ */
+@property (nonatomic, assign) NSInteger excessMoveCount;
+
+/**
+ The number of moves that left the puzzle further from being solved than before.
+ */
+@property (nonatomic, assign) NSInteger regressionMoveCount;
+
+/**
+ The time between the puzzle being shown and the first move, in seconds.
+ */
+@property (nonatomic, assign) NSTimeInterval planningLatency;
+
 @end
 
 
@@ -41,6 +41,10 @@
     [super encodeWithCoder:aCoder];
     ORK_ENCODE_OBJ(aCoder, moves);
     ORK_ENCODE_BOOL(aCoder, puzzleWasSolved);
+    ORK_ENCODE_INTEGER(aCoder, minimumNumberOfMoves);
+    ORK_ENCODE_INTEGER(aCoder, excessMoveCount);
+    ORK_ENCODE_INTEGER(aCoder, regressionMoveCount);
+    ORK_ENCODE_DOUBLE(aCoder, planningLatency);
 }
 
 - (id)initWithCoder:(NSCoder *)aDecoder {
@@ -48,6 +52,10 @@
     if (self) {
         ORK_DECODE_OBJ_ARRAY(aDecoder, moves, ORKTowerOfHanoiMove);
         ORK_DECODE_BOOL(aDecoder, puzzleWasSolved);
+        ORK_DECODE_INTEGER(aDecoder, minimumNumberOfMoves);
+        ORK_DECODE_INTEGER(aDecoder, excessMoveCount);
+        ORK_DECODE_INTEGER(aDecoder, regressionMoveCount);
+        ORK_DECODE_DOUBLE(aDecoder, planningLatency);
     }
     return self;
 }
@@ -61,22 +69,30 @@
     __typeof(self) castObject = object;
     return isParentSame &&
     self.puzzleWasSolved == castObject.puzzleWasSolved &&
+    self.minimumNumberOfMoves == castObject.minimumNumberOfMoves &&
+    self.excessMoveCount == castObject.excessMoveCount &&
+    self.regressionMoveCount == castObject.regressionMoveCount &&
+    self.planningLatency == castObject.planningLatency &&
     ORKEqualObjects(self.moves, castObject.moves);
 }
 
 - (NSUInteger)hash {
-    return super.hash ^ self.puzzleWasSolved ^ self.moves.hash;
+    return super.hash ^ self.puzzleWasSolved ^ self.moves.hash ^ self.excessMoveCount ^ self.regressionMoveCount;
 }
 
 - (instancetype)copyWithZone:(NSZone *)zone {
     ORKTowerOfHanoiResult *result = [super copyWithZone:zone];
     result.puzzleWasSolved = self.puzzleWasSolved;
     result.moves = [self.moves copy];
+    result.minimumNumberOfMoves = self.minimumNumberOfMoves;
+    result.excessMoveCount = self.excessMoveCount;
+    result.regressionMoveCount = self.regressionMoveCount;
+    result.planningLatency = self.planningLatency;
     return result;
 }
 
 - (NSString *)descriptionWithNumberOfPaddingSpaces:(NSUInteger)numberOfPaddingSpaces {
-    return [NSString stringWithFormat:@"%@; puzzleSolved: %d; moves: %@%@", [self descriptionPrefixWithNumberOfPaddingSpaces:numberOfPaddingSpaces], self.puzzleWasSolved, self.moves, self.descriptionSuffix];
+    return [NSString stringWithFormat:@"%@; puzzleSolved: %d; excessMoves: %ld; regressionMoves: %ld; planningLatency: %.3f; moves: %@%@", [self descriptionPrefixWithNumberOfPaddingSpaces:numberOfPaddingSpaces], self.puzzleWasSolved, (long)self.excessMoveCount, (long)self.regressionMoveCount, self.planningLatency, self.moves, self.descriptionSuffix];
 }
 
 @end
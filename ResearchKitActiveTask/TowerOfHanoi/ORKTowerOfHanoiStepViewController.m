@@ -39,20 +39,19 @@
 #import "ORKStepViewController_Internal.h"
 
 #import "ORKCollectionResult_Private.h"
+#import "ORKTowerOfHanoiEngine.h"
 #import "ORKTowerOfHanoiResult.h"
 #import "ORKTowerOfHanoiStep.h"
-#import "ORKTowerOfHanoiTower.h"
+#import "ORKTickScheduler.h"
 
+#import "ORKClock.h"
 #import "ORKHelpers_Internal.h"
 #import "ORKSkin.h"
 
 
-static const NSUInteger NumberOfTowers = 3;
-
 @interface ORKTowerOfHanoiViewController () <ORKTowerOfHanoiTowerViewDataSource, ORKTowerOfHanoiTowerViewDelegate>
 
 @property (nonatomic, strong) NSDateComponentsFormatter *dateComponentsFormatter;
-@property (nonatomic, strong) NSMutableArray *moves;
 
 @end
 
@@ -61,9 +60,9 @@ static const NSUInteger NumberOfTowers = 3;
     ORKActiveStepCustomView *_towerOfHanoiCustomView;
     NSNumber *_selectedIndex;
     NSArray *_variableConstraints;
-    NSMutableArray *_towers;
+    ORKTowerOfHanoiEngine *_engine;
     NSArray *_towerViews;
-    NSTimer *_timer;
+    ORKTickSubscription *_timerSubscription;
     NSInteger _secondsElapsed;
     NSDate *_firstMoveDate;
 }
@@ -76,7 +75,7 @@ static const NSUInteger NumberOfTowers = 3;
     _towerOfHanoiCustomView.translatesAutoresizingMaskIntoConstraints = NO;
     self.activeStepView.activeCustomView = _towerOfHanoiCustomView;
     
-    [self setUpTowers];
+    _engine = [[ORKTowerOfHanoiEngine alloc] initWithNumberOfDisks:[self numberOfDisks]];
     [self setUpTowerViews];
     [self reloadData];
     NSString *title = ORKLocalizedString(@"TOWER_OF_HANOI_TASK_ACTIVE_STEP_INTRO_TEXT", nil);
@@ -84,9 +83,16 @@ static const NSUInteger NumberOfTowers = 3;
     [self.activeStepView updateTitle:title text:text];
 }
 
+- (void)viewDidAppear:(BOOL)animated {
+    [super viewDidAppear:animated];
+    if (_engine.numberOfMoves == 0) {
+        [_engine beginAtTime:ORKClockSystemUptime()];
+    }
+}
+
 - (void)viewWillDisappear:(BOOL)animated {
     [super viewWillDisappear:animated];
-    [_timer invalidate];
+    [_timerSubscription invalidate];
 }
 
 - (void)updateViewConstraints {
@@ -116,9 +122,7 @@ static const NSUInteger NumberOfTowers = 3;
 
 - (ORKResult *)result {
     ORKStepResult *stepResult = [super result];
-    ORKTowerOfHanoiResult *result = [[ORKTowerOfHanoiResult alloc] initWithIdentifier:self.step.identifier];
-    result.moves = self.moves;
-    result.puzzleWasSolved = [self puzzleIsSolved];
+    ORKTowerOfHanoiResult *result = _engine ? [_engine resultWithIdentifier:self.step.identifier] : [[ORKTowerOfHanoiResult alloc] initWithIdentifier:self.step.identifier];
     if (_firstMoveDate != nil) {
         result.startDate = _firstMoveDate;
     }
@@ -130,14 +134,13 @@ static const NSUInteger NumberOfTowers = 3;
  
 - (NSUInteger)numberOfDisksInTowerOfHanoiView:(ORKTowerOfHanoiTowerView *)towerView {
     NSInteger towerIndex = [_towerViews indexOfObject:towerView];
-    ORKTowerOfHanoiTower *tower = _towers[towerIndex];
-    return tower.disks.count;
+    return [_engine disksOnTowerAtIndex:towerIndex].count;
 }
  
 - (NSNumber *)towerOfHanoiView:(ORKTowerOfHanoiTowerView *)towerView diskAtIndex:(NSUInteger)index {
     NSInteger towerIndex = [_towerViews indexOfObject:towerView];
-    ORKTowerOfHanoiTower *tower = _towers[towerIndex];
-    return (index >= tower.disks.count) ? nil :tower.disks[index];
+    NSArray<NSNumber *> *disks = [_engine disksOnTowerAtIndex:towerIndex];
+    return (index >= disks.count) ? nil : disks[index];
 }
 
 #pragma mark - ORKTowerOfHanoiTowerViewDelegate
@@ -162,13 +165,6 @@ static const NSUInteger NumberOfTowers = 3;
 
 #pragma mark - ORKTowerOfHanoiViewController
 
-- (NSMutableArray *)moves {
-    if (_moves == nil) {
-        _moves = [NSMutableArray array];
-    }
-    return _moves;
-}
-
 - (NSDateComponentsFormatter *)dateComponentsFormatter {
     if (_dateComponentsFormatter == nil) {
         _dateComponentsFormatter = [NSDateComponentsFormatter new];
@@ -184,7 +180,7 @@ static const NSUInteger NumberOfTowers = 3;
 }
 
 - (void)updateTitleText {
-    NSString *moves = ORKLocalizedStringFromNumber(@(self.moves.count));
+    NSString *moves = ORKLocalizedStringFromNumber(@(_engine.numberOfMoves));
     NSString *time = [self.dateComponentsFormatter stringFromTimeInterval:_secondsElapsed];
     NSString *title = ORKLocalizedString(@"TOWER_OF_HANOI_TASK_ACTIVE_STEP_INTRO_TEXT", nil);
     NSString *text = [NSString localizedStringWithFormat:ORKLocalizedString(@"TOWER_OF_HANOI_TASK_ACTIVE_STEP_PROGRESS_TEXT", nil), moves, time];
@@ -198,31 +194,19 @@ static const NSUInteger NumberOfTowers = 3;
     }
 }
 
-- (BOOL)puzzleIsSolved {
-    return ((ORKTowerOfHanoiTower *)_towers.lastObject).disks.count == [self numberOfDisks];
-}
-
 - (void)evaluatePuzzle {
-    if ([self puzzleIsSolved]) {
+    if (_engine.solved) {
         [self finish];
     }
 }
 
-- (void)setUpTowers {
-    NSMutableArray *diskStack = [NSMutableArray array];
-    for (NSInteger disk = [self numberOfDisks] ; disk > 0 ; disk--) {
-        [diskStack addObject: @(disk)];
-    }
-    _towers = [@[[[ORKTowerOfHanoiTower alloc] initWithDisks:diskStack], [ORKTowerOfHanoiTower emptyTower], [ORKTowerOfHanoiTower emptyTower]] mutableCopy];
-}
-
 - (void)setUpTowerViews {
     NSMutableArray *towerViews = [NSMutableArray array];
-    for (NSInteger index = 0 ; index < 3 ; index++) {
+    for (NSUInteger index = 0 ; index < _engine.numberOfTowers ; index++) {
         ORKTowerOfHanoiTowerView *towerView = [[ORKTowerOfHanoiTowerView alloc] initWithFrame:CGRectZero maximumNumberOfDisks:[self numberOfDisks]];
         towerView.delegate = self;
         towerView.dataSource = self;
-        towerView.targeted = (index == NumberOfTowers - 1);
+        towerView.targeted = (index == _engine.numberOfTowers - 1);
         [towerViews addObject:towerView];
         towerView.translatesAutoresizingMaskIntoConstraints = NO;
         [_towerOfHanoiCustomView addSubview:towerView];
@@ -231,10 +215,8 @@ static const NSUInteger NumberOfTowers = 3;
 }
 
 - (void)transferDiskFromTowerAtIndex:(NSInteger)donorTowerIndex toTowerAtIndex:(NSInteger)recipientTowerIndex {
-    ORKTowerOfHanoiTower *donorTower = _towers[donorTowerIndex];
-    ORKTowerOfHanoiTower *recipientTower = _towers[recipientTowerIndex];
-    if ([recipientTower recieveDiskFrom:donorTower]) {
-        [self makeMoveFromTowerAtIndex:donorTowerIndex toTowerAtIndex:recipientTowerIndex];
+    if ([_engine moveDiskFromTowerAtIndex:donorTowerIndex toTowerAtIndex:recipientTowerIndex atTime:ORKClockSystemUptime()]) {
+        [self didMakeMove];
     } else {
         NSNumber *donorSize = [self towerOfHanoiView:_towerViews[donorTowerIndex] diskAtIndex:0];
         NSNumber *recipientSize = [self towerOfHanoiView:_towerViews[recipientTowerIndex] diskAtIndex:0];
@@ -249,26 +231,22 @@ static const NSUInteger NumberOfTowers = 3;
     }
 }
 
-- (void)makeMoveFromTowerAtIndex:(NSUInteger)donorTowerIndex toTowerAtIndex:(NSUInteger)recipientTowerIndex {
-    ORKTowerOfHanoiMove *move = [[ORKTowerOfHanoiMove alloc] init];
-    move.donorTowerIndex = donorTowerIndex;
-    move.recipientTowerIndex = recipientTowerIndex;
-    move.timestamp = (self.moves.count == 0) ? 0 : fabs([_firstMoveDate timeIntervalSinceNow]);
-    [_moves addObject:move];
-    [self didMakeMove];
-}
-
 - (void)didMakeMove {
     _selectedIndex = nil;
-    if (self.moves.count == 1) {
+    if (_engine.numberOfMoves == 1) {
         _firstMoveDate = [NSDate date];
-        _timer = [NSTimer scheduledTimerWithTimeInterval:1 target:self selector:@selector(timerTicked) userInfo:nil repeats:YES];
+        ORKWeakTypeOf(self) weakSelf = self;
+        _timerSubscription = [[ORKTickScheduler sharedScheduler] scheduleTicksWithInterval:1 queue:dispatch_get_main_queue() handler:^(NSUInteger tickIndex, ORKClockTime deadline) {
+            ORKStrongTypeOf(self) strongSelf = weakSelf;
+            [strongSelf timerTickedWithIndex:tickIndex];
+        }];
     }
     [self updateTitleText];
 }
 
-- (void)timerTicked {
-    _secondsElapsed++;
+- (void)timerTickedWithIndex:(NSUInteger)tickIndex {
+    // Derived from the tick index so that a delayed tick does not lose a second.
+    _secondsElapsed = tickIndex + 1;
     [self updateTitleText];
 }
 
@@ -32,6 +32,7 @@
 #import "ORKTrailmakingStepViewController.h"
 
 #import "ORKActiveStepTimer.h"
+#import "ORKTickScheduler.h"
 #import "ORKActiveStepView.h"
 #import "ORKTrailmakingContentView.h"
 #import "ORKActiveStepCustomView.h"
@@ -59,7 +60,7 @@
     int _nextIndex;
     int _errors;
     NSMutableArray *_taps;
-    NSTimer *_updateTimer;
+    ORKTickSubscription *_updateTimerSubscription;
     UILabel *_timerLabel;
 }
 
@@ -105,7 +106,7 @@
     [self.view addSubview:_timerLabel];
 }
 
-- (void)timerUpdated:(NSTimer*)timer {
+- (void)timerUpdated {
     NSTimeInterval elapsed = [[NSDate date] timeIntervalSinceDate: self.presentedDate];
     
     NSDateComponentsFormatter *durationFormatter = [NSDateComponentsFormatter new];
@@ -126,7 +127,11 @@
 - (void)viewDidAppear:(BOOL)animated {
     [super viewDidAppear:animated];
     [self start];
-    _updateTimer = [NSTimer scheduledTimerWithTimeInterval:0.1 target:self selector:@selector(timerUpdated:) userInfo:nil repeats:YES];
+    ORKWeakTypeOf(self) weakSelf = self;
+    _updateTimerSubscription = [[ORKTickScheduler sharedScheduler] scheduleTicksWithInterval:0.1 queue:dispatch_get_main_queue() handler:^(NSUInteger tickIndex, ORKClockTime deadline) {
+        ORKStrongTypeOf(self) strongSelf = weakSelf;
+        [strongSelf timerUpdated];
+    }];
     if (UIAccessibilityIsVoiceOverRunning()) {
         // Put focus on the direct touch area immediately so that the first touch gets registered
         UIAccessibilityPostNotification(UIAccessibilityLayoutChangedNotification, _trailmakingContentView);
@@ -138,9 +143,9 @@
 - (void)viewWillDisappear:(BOOL)animated {
     [super viewWillDisappear:animated];
     
-    if (_updateTimer != nil) {
-        [_updateTimer invalidate];
-        _updateTimer = nil;
+    if (_updateTimerSubscription != nil) {
+        [_updateTimerSubscription invalidate];
+        _updateTimerSubscription = nil;
     }
 }
 
@@ -208,8 +213,8 @@
             _trailmakingContentView.linesToDraw = _nextIndex - 1;
             if (_nextIndex == _trailmakingContentView.tapButtons.count) {
                 [self performSelector:@selector(finish) withObject:nil afterDelay:1.5];
-                [_updateTimer invalidate];
-                _updateTimer = nil;
+                [_updateTimerSubscription invalidate];
+                _updateTimerSubscription = nil;
             }
             tap.incorrect = NO;
             
@@ -249,10 +254,11 @@
 }
 
 - (NSArray*)fetchRandomTest {
-    const int testNum = arc4random_uniform((uint32_t)[[self testData] count]);
-    const bool invertX = arc4random_uniform(2) == 1;
-    const bool invertY = arc4random_uniform(2) == 1;
-    const bool reverse = arc4random_uniform(2) == 1;
+    ORKRandomNumberGenerator *generator = self.randomNumberGenerator;
+    const int testNum = [generator uniformIntegerLessThan:(uint32_t)[[self testData] count]];
+    const bool invertX = [generator randomBool];
+    const bool invertY = [generator randomBool];
+    const bool reverse = [generator randomBool];
     
     NSMutableArray* points = [NSMutableArray array];
     NSString* testPointsStr = [self.testData objectAtIndex:testNum];
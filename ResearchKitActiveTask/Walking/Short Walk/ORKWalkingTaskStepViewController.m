@@ -38,6 +38,8 @@
 
 #import "ORKActiveStepViewController_Internal.h"
 #import <ResearchKitUI/ORKStepViewController_Internal.h>
+#import "ORKAccelerometerRecorder.h"
+#import "ORKDeviceMotionRecorder.h"
 #import "ORKPedometerRecorder.h"
 
 #import "ORKStep_Private.h"
@@ -161,6 +163,18 @@
     _intendedSteps = [[self walkingTaskStep] numberOfStepsPerLeg];
 }
 
+- (void)recordersDidChange {
+    [super recordersDidChange];
+    
+    for (ORKRecorder *recorder in self.recorders) {
+        if ([recorder isKindOfClass:[ORKAccelerometerRecorder class]]) {
+            ((ORKAccelerometerRecorder *)recorder).extractsGaitFeatures = YES;
+        } else if ([recorder isKindOfClass:[ORKDeviceMotionRecorder class]]) {
+            ((ORKDeviceMotionRecorder *)recorder).extractsGaitFeatures = YES;
+        }
+    }
+}
+
 - (void)pedometerRecorderDidUpdate:(ORKPedometerRecorder *)pedometerRecorder {
     NSInteger numberOfSteps = [pedometerRecorder totalNumberOfSteps];
     ORK_Log_Debug("Steps: %lld", (long long)numberOfSteps);
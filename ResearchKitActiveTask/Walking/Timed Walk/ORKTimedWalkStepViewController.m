@@ -31,8 +31,10 @@
 
 #import "ORKTimedWalkStepViewController.h"
 
+#import "ORKAccelerometerRecorder.h"
 #import "ORKActiveStepTimer.h"
 #import "ORKActiveStepView.h"
+#import "ORKDeviceMotionRecorder.h"
 #import "ORKStepContainerView_Private.h"
 #import "ORKNavigationContainerView_Internal.h"
 #import "ORKTimedWalkContentView.h"
@@ -90,6 +92,18 @@
     self.timerUpdateInterval = 0.1f;
 }
 
+- (void)recordersDidChange {
+    [super recordersDidChange];
+    
+    for (ORKRecorder *recorder in self.recorders) {
+        if ([recorder isKindOfClass:[ORKAccelerometerRecorder class]]) {
+            ((ORKAccelerometerRecorder *)recorder).extractsGaitFeatures = YES;
+        } else if ([recorder isKindOfClass:[ORKDeviceMotionRecorder class]]) {
+            ((ORKDeviceMotionRecorder *)recorder).extractsGaitFeatures = YES;
+        }
+    }
+}
+
 - (void)finish {
     [super finish];
     
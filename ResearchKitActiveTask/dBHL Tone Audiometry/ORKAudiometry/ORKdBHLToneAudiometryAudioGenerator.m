@@ -53,6 +53,8 @@
 
 #import "ORKdBHLToneAudiometryAudioGenerator.h"
 
+#import "ORKToneSynthesisEngine.h"
+
 @import AudioToolbox;
 
 typedef NSString * ORKVolumeCurveFilename NS_STRING_ENUM;
@@ -68,25 +70,18 @@ NSString * const retsplBaseFilename = @"retspl_%@";
 NSString * const filenameExtension = @"plist";
 
 @interface ORKdBHLToneAudiometryAudioGenerator () {
-@public
-    AudioComponentInstance _toneUnit;
     AUGraph _mGraph;
     AUNode _outputNode;
     AUNode _mixerNode;
     AudioUnit _mMixer;
+    ORKToneSynthesisEngine *_engine;
     double _frequency;
-    double _theta;
     ORKAudioChannel _activeChannel;
-    BOOL _playsStereo;
-    BOOL _rampUp;
-    double _fadeInFactor;
     double _globaldBHL;
-    NSNumber *_amplitudeGain;
     NSTimeInterval _fadeInDuration;
     NSDictionary *_sensitivityPerFrequency;
     NSDictionary *_volumeCurve;
     NSDictionary *_retspl;
-    int _lastNodeInput;
 }
 
 - (NSNumber *)dbHLtoAmplitude: (double)dbHL atFrequency:(double)frequency;
@@ -96,93 +91,13 @@ NSString * const filenameExtension = @"plist";
 const double DeviceVolumeMinimumValue = 0.0625;
 const double ORKdBHLSineWaveToneGeneratorSampleRateDefault = 44100.0f;
 
-static OSStatus ORKdBHLAudioGeneratorRenderTone(void *inRefCon,
-                                                AudioUnitRenderActionFlags *ioActionFlags,
-                                                const AudioTimeStamp         *inTimeStamp,
-                                                UInt32                     inBusNumber,
-                                                UInt32                     inNumberFrames,
-                                                AudioBufferList             *ioData) {
-    // Get the tone parameters out of the view controller
-    ORKdBHLToneAudiometryAudioGenerator *audioGenerator = (__bridge ORKdBHLToneAudiometryAudioGenerator *)inRefCon;
-    double amplitude;
-
-    amplitude = [audioGenerator->_amplitudeGain doubleValue];
-    
-    double theta = audioGenerator->_theta;
-    double theta_increment = 2.0 * M_PI * audioGenerator->_frequency / ORKdBHLSineWaveToneGeneratorSampleRateDefault;
-    
-    double fadeInFactor = audioGenerator->_fadeInFactor;
-    
-    // This is a mono tone generator so we only need the first buffer
-    Float32 *bufferActive    = (Float32 *)ioData->mBuffers[audioGenerator->_activeChannel].mData;
-    Float32 *bufferNonActive = (Float32 *)ioData->mBuffers[1 - audioGenerator->_activeChannel].mData;
-    
-    // Generate the samples
-    for (UInt32 frame = 0; frame < inNumberFrames; frame++) {
-        double bufferValue;
-        
-        bufferValue = sin(theta) * amplitude * pow(10, 2.0 * fadeInFactor - 2);
-        
-        bufferActive[frame] = bufferValue;
-        if (audioGenerator->_playsStereo) {
-            bufferNonActive[frame] = bufferValue;
-        } else {
-            bufferNonActive[frame] = 0;
-        }
-        
-        theta += theta_increment;
-        if (theta > 2.0 * M_PI) {
-            theta -= 2.0 * M_PI;
-        }
-        if (audioGenerator->_rampUp) {
-            fadeInFactor += 1.0 / (ORKdBHLSineWaveToneGeneratorSampleRateDefault * audioGenerator->_fadeInDuration);
-            if (fadeInFactor >= 1) {
-                fadeInFactor = 1;
-            }
-        } else {
-            fadeInFactor -= 1.0 / (ORKdBHLSineWaveToneGeneratorSampleRateDefault * audioGenerator->_fadeInDuration);
-            if (fadeInFactor <= 0) {
-                fadeInFactor = 0;
-            }
-        }
-    }
-    
-    // Store the theta back in the view controller
-    audioGenerator->_theta = theta;
-    audioGenerator->_fadeInFactor = fadeInFactor;
-    
-    return noErr;
-}
-
-static OSStatus ORKdBHLAudioGeneratorZeroTone(void *inRefCon,
-                                             AudioUnitRenderActionFlags *ioActionFlags,
-                                             const AudioTimeStamp         *inTimeStamp,
-                                             UInt32                     inBusNumber,
-                                             UInt32                     inNumberFrames,
-                                             AudioBufferList             *ioData) {
-    // Get the tone parameters out of the view controller
-    ORKdBHLToneAudiometryAudioGenerator *audioGenerator = (__bridge ORKdBHLToneAudiometryAudioGenerator *)inRefCon;
- 
-    // This is a mono tone generator so we only need the first buffer
-    Float32 *bufferActive    = (Float32 *)ioData->mBuffers[audioGenerator->_activeChannel].mData;
-    Float32 *bufferNonActive = (Float32 *)ioData->mBuffers[1 - audioGenerator->_activeChannel].mData;
-    
-    // Generate the samples
-    for (UInt32 frame = 0; frame < inNumberFrames; frame++) {
-        double bufferValue = 0;
-        bufferActive[frame] = bufferValue;
-        bufferNonActive[frame] = bufferValue;
-    }
-
-    return noErr;
-}
-
 @implementation ORKdBHLToneAudiometryAudioGenerator
 
 - (instancetype)initForHeadphoneType:(ORKHeadphoneTypeIdentifier)headphoneType {
     self = [super init];
     if (self) {
-        _lastNodeInput = 0;
+        _engine = [[ORKToneSynthesisEngine alloc] initWithSampleRate:ORKdBHLSineWaveToneGeneratorSampleRateDefault];
+        _fadeInDuration = 0.2;
         
         NSString *headphoneTypeUppercased = [headphoneType uppercaseString];
         ORKHeadphoneTypeIdentifier headphoneTypeIdentifier;
@@ -224,9 +139,6 @@ static OSStatus ORKdBHLAudioGeneratorZeroTone(void *inRefCon,
 
 - (void)dealloc {
     if (_mGraph) {
-        int nodeInput = (_lastNodeInput % 2) + 1;
-        AUGraphDisconnectNodeInput(_mGraph, _mixerNode, nodeInput);
-        AUGraphUpdate(_mGraph, NULL);
         AUGraphStop(_mGraph);
         AUGraphUninitialize(_mGraph);
         _mGraph = nil;
@@ -240,9 +152,6 @@ static OSStatus ORKdBHLAudioGeneratorZeroTone(void *inRefCon,
                         dBHL:(double)dBHL {
     _frequency = playFrequency;
     _activeChannel = playChannel;
-    _fadeInFactor = 0;
-    _fadeInDuration = 0.2;
-    _rampUp = YES;
     _globaldBHL = dBHL;
     
     [self play];
@@ -274,19 +183,18 @@ static OSStatus ORKdBHLAudioGeneratorZeroTone(void *inRefCon,
         AUGraphOpen(_mGraph);
         AUGraphNodeInfo(_mGraph, _mixerNode, NULL, &_mMixer);
         
-        UInt32 numbuses = 3;
+        // A single input carries every tone; the engine replaces and fades them itself.
+        UInt32 numbuses = 1;
         UInt32 size = sizeof(numbuses);
         AudioUnitSetProperty(_mMixer, kAudioUnitProperty_ElementCount, kAudioUnitScope_Input, 0, &numbuses, size);
         
         AudioStreamBasicDescription desc;
         for (int i = 0; i < numbuses; ++i) {
             AURenderCallbackStruct renderCallbackStruct;
-            renderCallbackStruct.inputProcRefCon = (__bridge void *)(self);
+            renderCallbackStruct.inputProcRefCon = _engine.renderCallbackRefCon;
+            renderCallbackStruct.inputProc = ORKToneSynthesisEngineRenderCallback;
+            AUGraphSetNodeInputCallback(_mGraph, _mixerNode, i, &renderCallbackStruct);
             
-            if (i == 0) {
-                renderCallbackStruct.inputProc = ORKdBHLAudioGeneratorZeroTone;
-                AUGraphSetNodeInputCallback(_mGraph, _mixerNode, 0, &renderCallbackStruct);
-            }
             size = sizeof(desc);
             AudioUnitGetProperty(  _mMixer,
                                     kAudioUnitProperty_StreamFormat,
@@ -352,37 +260,18 @@ static OSStatus ORKdBHLAudioGeneratorZeroTone(void *inRefCon,
 }
 
 - (void)play {
-    _amplitudeGain = [self dbHLtoAmplitude:_globaldBHL atFrequency:_frequency];
-    AURenderCallbackStruct renderCallbackStruct;
-    renderCallbackStruct.inputProcRefCon = (__bridge void *)(self);
-    renderCallbackStruct.inputProc = ORKdBHLAudioGeneratorRenderTone;
-    _lastNodeInput += 1;
-    int connect = 0;
-    int disconnect = 0;
-    if ((_lastNodeInput % 2) == 0) {
-        connect = 1;
-        disconnect = 2;
-    } else {
-        connect = 2;
-        disconnect = 1;
-    }
-    AUGraphDisconnectNodeInput(_mGraph, _mixerNode, disconnect);
-    AUGraphSetNodeInputCallback(_mGraph, _mixerNode, connect, &renderCallbackStruct);
-    AUGraphUpdate(_mGraph, NULL);
+    NSNumber *amplitudeGain = [self dbHLtoAmplitude:_globaldBHL atFrequency:_frequency];
+    ORKToneSynthesisStimulus *stimulus = [ORKToneSynthesisStimulus toneWithFrequency:_frequency amplitude:amplitudeGain.doubleValue];
+    stimulus.fadeInDuration = _fadeInDuration;
+    [stimulus setGain:0 forChannel:(_activeChannel == ORKAudioChannelLeft) ? ORKAudioChannelRight : ORKAudioChannelLeft];
+    
+    [_engine stopAllVoicesAtSampleTime:ORKToneSynthesisSampleTimeImmediate fadeOutDuration:0];
+    [_engine startStimulus:stimulus atSampleTime:ORKToneSynthesisSampleTimeImmediate];
 }
 
 - (void)stop {
     if (_mGraph) {
-        _rampUp = NO;
-        int nodeInput = (_lastNodeInput % 2) + 1;
-        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(_fadeInDuration * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
-            if (self->_mGraph) {
-                dispatch_async(dispatch_get_main_queue(), ^{
-                    AUGraphDisconnectNodeInput(self->_mGraph, self->_mixerNode, nodeInput);
-                    AUGraphUpdate(self->_mGraph, NULL);
-                }); 
-            }
-        });
+        [_engine stopAllVoicesAtSampleTime:ORKToneSynthesisSampleTimeImmediate fadeOutDuration:_fadeInDuration];
     }
 }
 
@@ -267,8 +267,8 @@ NSString * const ORKdBHLToneAudiometryStepViewAccessibilityIdentifier = @"ORKdBH
     const NSTimeInterval toneDuration = [self dBHLToneAudiometryStep].toneDuration;
     const NSTimeInterval postStimulusDelay = [self dBHLToneAudiometryStep].postStimulusDelay;
     
-    double delay1 = arc4random_uniform([self dBHLToneAudiometryStep].maxRandomPreStimulusDelay - 1);
-    double delay2 = (double)arc4random_uniform(10)/10;
+    double delay1 = [self.randomNumberGenerator uniformIntegerLessThan:(uint32_t)([self dBHLToneAudiometryStep].maxRandomPreStimulusDelay - 1)];
+    double delay2 = (double)[self.randomNumberGenerator uniformIntegerLessThan:10]/10;
     double preStimulusDelay = delay1 + delay2 + 1;
     [self.audiometryEngine registerPreStimulusDelay:preStimulusDelay];
     
@@ -37,6 +37,7 @@
 #import "ORKRoundTappingButton.h"
 #import "ORKEnvironmentSPLMeterContentView.h"
 #import "ORKRingView.h"
+#import "ORKAudioLevelMeter.h"
 
 #import "ORKEnvironmentSPLMeterStepViewController_Private.h"
 #import "ORKActiveStepViewController_Internal.h"
@@ -51,6 +52,8 @@
 
 #import "ORKHelpers_Internal.h"
 #import <AVFoundation/AVFoundation.h>
+
+@import Accelerate;
 #include <sys/sysctl.h>
 
 static const NSTimeInterval SPL_METER_PLAY_DELAY_VOICEOVER = 3.0;
@@ -78,6 +81,7 @@ NSString * const ORKEnvironmentSPLMeterStepViewAccessibilityIdentifier = @"ORKEn
     AVAudioSessionMode _savedSessionMode;
     AVAudioSessionCategoryOptions _savedSessionCategoryOptions;
     UINotificationFeedbackGenerator *_notificationFeedbackGenerator;
+    ORKAudioLevelMeter *_progressBarMeter;
 }
 
 @property (nonatomic, strong) ORKEnvironmentSPLMeterContentView *environmentSPLMeterContentView;
@@ -101,6 +105,7 @@ NSString * const ORKEnvironmentSPLMeterStepViewAccessibilityIdentifier = @"ORKEn
         _recordedSamples = [NSMutableArray new];
         _audioEngine = [[AVAudioEngine alloc] init];
         _eqUnit = [[AVAudioUnitEQ alloc] initWithNumberOfBands:6];
+        _progressBarMeter = [ORKAudioLevelMeter new];
     }
     
     return self;
@@ -345,10 +350,7 @@ NSString * const ORKEnvironmentSPLMeterStepViewAccessibilityIdentifier = @"ORKEn
                                    }
                                    int sampleCount = self->_samplingInterval * self->_countToFetch;
                                    float rms = 0.0;
-                                   for (int i = 0; i < buffer.frameLength; i++) {
-                                       float value = [@(buffer.floatChannelData[0][i]) floatValue];
-                                       rms +=  value * value;
-                                   }
+                                   vDSP_svesq(buffer.floatChannelData[0], 1, &rms, buffer.frameLength);
                                    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
                                        [self->_rmsBuffer addObject:@(rms)];
                                        
@@ -372,15 +374,12 @@ NSString * const ORKEnvironmentSPLMeterStepViewAccessibilityIdentifier = @"ORKEn
                                            [self evaluateThreshold:self->_spl];
                                            [self->_rmsBuffer removeAllObjects];
                                        } else {
+                                           // The bar shows the latest level at each display refresh.
                                            if (rms > 0.0 && self->_sampleRate > 0.0) {
                                                float spl = (20 * log10f(sqrtf(rms/(float)self->_sampleRate))) - self->_sensitivityOffset + 96;
-                                               dispatch_async(dispatch_get_main_queue(), ^{
-                                                   [self.environmentSPLMeterContentView setProgressBar:(spl/self->_thresholdValue)];
-                                               });
+                                               [self->_progressBarMeter writeLevel:(spl/self->_thresholdValue)];
                                            } else {
-                                               dispatch_async(dispatch_get_main_queue(), ^{
-                                                   [self.environmentSPLMeterContentView setProgressBar:(self->_spl/self->_thresholdValue)];
-                                               });
+                                               [self->_progressBarMeter writeLevel:(self->_spl/self->_thresholdValue)];
                                            }
                                        }
                                        dispatch_semaphore_signal(self->_semaphoreRms);
@@ -394,6 +393,11 @@ NSString * const ORKEnvironmentSPLMeterStepViewAccessibilityIdentifier = @"ORKEn
                                    });
                                }
                            }];
+        ORKWeakTypeOf(self) weakSelf = self;
+        [_progressBarMeter startDisplayUpdatesWithHandler:^(NSArray<NSNumber *> *levels) {
+            ORKStrongTypeOf(weakSelf) strongSelf = weakSelf;
+            [strongSelf.environmentSPLMeterContentView setProgressBar:levels.lastObject.doubleValue];
+        }];
         if (!_audioEngine.isRunning && !otherAudioIsProhibitingMeasurement) {
             NSError *error = nil;
             [_audioEngine startAndReturnError:&error];
@@ -435,6 +439,7 @@ NSString * const ORKEnvironmentSPLMeterStepViewAccessibilityIdentifier = @"ORKEn
 }
 
 - (void)stopAudioEngine {
+    [_progressBarMeter stopDisplayUpdates];
     if ([_audioEngine isRunning]) {
         dispatch_semaphore_signal(_semaphoreRms);
         dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
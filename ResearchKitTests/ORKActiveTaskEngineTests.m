@@ -0,0 +1,265 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKit;
+@import ResearchKitActiveTask;
+@import ResearchKitActiveTask_Private;
+
+
+static const NSUInteger ORKActiveTaskEngineBenchmarkDiskCount = 12;
+
+
+@interface ORKActiveTaskEngineTests : XCTestCase
+
+@end
+
+
+@implementation ORKActiveTaskEngineTests
+
+- (ORKPSATStep *)PSATStepWithSeriesLength:(NSInteger)seriesLength {
+    ORKPSATStep *step = [[ORKPSATStep alloc] initWithIdentifier:@"psat"];
+    step.presentationMode = ORKPSATPresentationModeVisual;
+    step.interStimulusInterval = 3.0;
+    step.stimulusDuration = 1.0;
+    step.seriesLength = seriesLength;
+    return step;
+}
+
+- (void)solveTowerOfHanoi:(ORKTowerOfHanoiEngine *)engine disks:(NSUInteger)disks from:(NSUInteger)from to:(NSUInteger)to via:(NSUInteger)via time:(NSTimeInterval *)time {
+    if (disks == 0) {
+        return;
+    }
+    [self solveTowerOfHanoi:engine disks:disks - 1 from:from to:via via:to time:time];
+    [engine moveDiskFromTowerAtIndex:from toTowerAtIndex:to atTime:*time];
+    *time += 1.0;
+    [self solveTowerOfHanoi:engine disks:disks - 1 from:via to:to via:from time:time];
+}
+
+- (void)testPSATScriptedSession {
+    ORKPSATStep *step = [self PSATStepWithSeriesLength:4];
+    ORKPSATEngine *engine = [[ORKPSATEngine alloc] initWithPSATStep:step digits:@[@3, @5, @2, @9, @4]];
+    XCTAssertEqualObjects(engine.currentDigit, @3);
+    
+    // Answers given before the first sum is due are ignored.
+    [engine submitAnswer:8 atTime:0.5];
+    [engine advanceAtTime:3.0];
+    XCTAssertEqualObjects(engine.currentDigit, @5);
+    [engine submitAnswer:8 atTime:4.0];
+    [engine advanceAtTime:6.0];
+    [engine submitAnswer:7 atTime:7.5];
+    [engine advanceAtTime:9.0];
+    [engine submitAnswer:10 atTime:10.0];
+    [engine advanceAtTime:12.0];
+    // No answer for the last sum.
+    [engine advanceAtTime:15.0];
+    XCTAssertTrue(engine.finished);
+    XCTAssertNil(engine.currentDigit);
+    
+    ORKPSATResult *result = [engine resultWithIdentifier:@"psat"];
+    XCTAssertEqual(result.initialDigit, 3);
+    XCTAssertEqual(result.length, 4);
+    XCTAssertEqual(result.stimulusDuration, 1.0);
+    XCTAssertEqual(result.samples.count, 4);
+    XCTAssertEqual(result.totalCorrect, 2);
+    XCTAssertEqual(result.totalDyad, 1);
+    XCTAssertEqualWithAccuracy(result.totalTime, 1.0 + 1.5 + 1.0 + 3.0, 1e-9);
+    XCTAssertFalse(result.samples[2].isCorrect);
+    XCTAssertEqual(result.samples[3].answer, -1);
+}
+
+- (void)testPSATDigitsAreReproducible {
+    ORKRandomNumberGenerator *generator = [[ORKRandomNumberGenerator alloc] initWithSeed:9];
+    NSArray<NSNumber *> *digits = [ORKPSATEngine digitsWithSeriesLength:60 randomNumberGenerator:generator];
+    XCTAssertEqual(digits.count, 61);
+    for (NSUInteger index = 0; index < digits.count; index++) {
+        XCTAssertGreaterThanOrEqual(digits[index].integerValue, 1);
+        XCTAssertLessThanOrEqual(digits[index].integerValue, 9);
+        if (index > 0) {
+            XCTAssertNotEqualObjects(digits[index], digits[index - 1]);
+        }
+    }
+    generator = [[ORKRandomNumberGenerator alloc] initWithSeed:9];
+    XCTAssertEqualObjects([ORKPSATEngine digitsWithSeriesLength:60 randomNumberGenerator:generator], digits);
+}
+
+- (void)testStroopScriptedSession {
+    NSArray<NSString *> *colorNames = @[@"red", @"blue", @"green", @"yellow"];
+    ORKStroopEngine *engine = [[ORKStroopEngine alloc] initWithIdentifier:@"stroop"
+                                                               colorNames:colorNames
+                                                         numberOfAttempts:20
+                                                    randomNumberGenerator:[[ORKRandomNumberGenerator alloc] initWithSeed:3]];
+    XCTAssertNil([engine selectColorName:@"red" atTime:0]);
+    
+    NSTimeInterval time = 100;
+    NSMutableArray<NSString *> *shownColors = [NSMutableArray array];
+    while ([engine startTrialAtTime:time]) {
+        XCTAssertTrue([colorNames containsObject:engine.currentText]);
+        XCTAssertTrue([colorNames containsObject:engine.currentColorName]);
+        [shownColors addObject:engine.currentColorName];
+        ORKStroopResult *result = [engine selectColorName:engine.currentColorName atTime:time + 0.75];
+        XCTAssertEqual(result.endTime - result.startTime, 0.75);
+        XCTAssertNil(engine.currentText);
+        time += 1;
+    }
+    XCTAssertTrue(engine.finished);
+    XCTAssertEqual(engine.results.count, 20);
+    for (ORKStroopResult *result in engine.results) {
+        XCTAssertEqualObjects(result.identifier, @"stroop");
+        XCTAssertEqualObjects(result.color, result.colorSelected);
+    }
+    
+    ORKStroopEngine *replay = [[ORKStroopEngine alloc] initWithIdentifier:@"stroop"
+                                                               colorNames:colorNames
+                                                         numberOfAttempts:20
+                                                    randomNumberGenerator:[[ORKRandomNumberGenerator alloc] initWithSeed:3]];
+    for (NSString *color in shownColors) {
+        XCTAssertTrue([replay startTrialAtTime:0]);
+        XCTAssertEqualObjects(replay.currentColorName, color);
+        [replay selectColorName:color atTime:0];
+    }
+}
+
+- (void)testAccuracyStroopDisplayColorIsReproducible {
+    ORKAccuracyStroopStep *step = [[ORKAccuracyStroopStep alloc] initWithIdentifier:@"accuracyStroop"];
+    step.baseDisplayColor = UIColor.systemRedColor;
+    ORKRandomNumberGenerator *generator = [[ORKRandomNumberGenerator alloc] initWithSeed:5];
+    XCTAssertEqualObjects([step actualDisplayColorWithRandomNumberGenerator:generator], UIColor.systemRedColor);
+    
+    step.isColorMatching = NO;
+    NSMutableArray<UIColor *> *colors = [NSMutableArray array];
+    for (NSUInteger index = 0; index < 50; index++) {
+        UIColor *color = [step actualDisplayColorWithRandomNumberGenerator:generator];
+        XCTAssertNotEqualObjects(color, UIColor.systemRedColor);
+        XCTAssertTrue([ORKAccuracyStroopStep.colors containsObject:color]);
+        [colors addObject:color];
+    }
+    
+    ORKRandomNumberGenerator *replay = [[ORKRandomNumberGenerator alloc] initWithSeed:5];
+    for (UIColor *color in colors) {
+        XCTAssertEqualObjects([step actualDisplayColorWithRandomNumberGenerator:replay], color);
+    }
+}
+
+- (void)testTowerOfHanoiRejectsIllegalMoves {
+    ORKTowerOfHanoiEngine *engine = [[ORKTowerOfHanoiEngine alloc] initWithNumberOfDisks:3];
+    XCTAssertEqualObjects([engine disksOnTowerAtIndex:0], (@[@3, @2, @1]));
+    XCTAssertFalse([engine moveDiskFromTowerAtIndex:1 toTowerAtIndex:0 atTime:0]);
+    XCTAssertFalse([engine moveDiskFromTowerAtIndex:0 toTowerAtIndex:0 atTime:0]);
+    XCTAssertTrue([engine moveDiskFromTowerAtIndex:0 toTowerAtIndex:2 atTime:10]);
+    XCTAssertFalse([engine moveDiskFromTowerAtIndex:0 toTowerAtIndex:2 atTime:11]);
+    XCTAssertTrue([engine moveDiskFromTowerAtIndex:0 toTowerAtIndex:1 atTime:12.5]);
+    XCTAssertEqual(engine.moves.count, 2);
+    XCTAssertEqual(engine.moves[0].timestamp, 0);
+    XCTAssertEqual(engine.moves[1].timestamp, 2.5);
+    XCTAssertFalse(engine.solved);
+}
+
+- (void)testTowerOfHanoiScriptedSolution {
+    ORKTowerOfHanoiEngine *engine = [[ORKTowerOfHanoiEngine alloc] initWithNumberOfDisks:5];
+    NSTimeInterval time = 0;
+    [self solveTowerOfHanoi:engine disks:5 from:0 to:2 via:1 time:&time];
+    XCTAssertTrue(engine.solved);
+    
+    ORKTowerOfHanoiResult *result = [engine resultWithIdentifier:@"hanoi"];
+    XCTAssertTrue(result.puzzleWasSolved);
+    XCTAssertEqual(result.moves.count, 31);
+    XCTAssertEqual(result.moves.lastObject.timestamp, 30);
+    XCTAssertEqualObjects([engine disksOnTowerAtIndex:2], (@[@5, @4, @3, @2, @1]));
+}
+
+- (void)testReactionTimeScriptedSession {
+    ORKReactionTimeStep *step = [[ORKReactionTimeStep alloc] initWithIdentifier:@"reaction"];
+    step.minimumStimulusInterval = 2.0;
+    step.maximumStimulusInterval = 4.0;
+    step.timeout = 3.0;
+    step.numberOfAttempts = 2;
+    step.thresholdAcceleration = 0.5;
+    ORKReactionTimeEngine *engine = [[ORKReactionTimeEngine alloc] initWithReactionTimeStep:step];
+    
+    ORKRandomNumberGenerator *generator = [[ORKRandomNumberGenerator alloc] initWithSeed:5];
+    for (NSUInteger index = 0; index < 100; index++) {
+        NSTimeInterval interval = [engine stimulusIntervalWithRandomNumberGenerator:generator];
+        XCTAssertGreaterThanOrEqual(interval, 2.0);
+        XCTAssertLessThanOrEqual(interval, 4.0);
+    }
+    XCTAssertFalse([engine isReactionWithUserAccelerationX:0.3 y:0.3 z:0.3]);
+    XCTAssertTrue([engine isReactionWithUserAccelerationX:0.3 y:0.3 z:0.4]);
+    
+    // Moving before the stimulus fails the attempt.
+    XCTAssertEqual([engine finishAttemptWithFileResult:nil], ORKReactionTimeAttemptOutcomeFailure);
+    [engine presentStimulusAtTime:10.0];
+    [engine timeOutAttempt];
+    XCTAssertEqual([engine finishAttemptWithFileResult:nil], ORKReactionTimeAttemptOutcomeTimeout);
+    [engine presentStimulusAtTime:20.0];
+    [engine invalidateAttempt];
+    XCTAssertEqual([engine finishAttemptWithFileResult:nil], ORKReactionTimeAttemptOutcomeFailure);
+    XCTAssertEqual(engine.results.count, 0);
+    
+    ORKFileResult *fileResult = [[ORKFileResult alloc] initWithIdentifier:@"motion"];
+    [engine presentStimulusAtTime:30.0];
+    XCTAssertEqual([engine finishAttemptWithFileResult:fileResult], ORKReactionTimeAttemptOutcomeSuccess);
+    XCTAssertFalse(engine.finished);
+    [engine presentStimulusAtTime:40.0];
+    XCTAssertEqual([engine finishAttemptWithFileResult:nil], ORKReactionTimeAttemptOutcomeSuccess);
+    XCTAssertTrue(engine.finished);
+    
+    XCTAssertEqual(engine.results.count, 2);
+    XCTAssertEqualObjects(engine.results[0].identifier, @"reaction");
+    XCTAssertEqual(engine.results[0].timestamp, 30.0);
+    XCTAssertEqual(engine.results[0].fileResult, fileResult);
+    XCTAssertEqual(engine.results[1].timestamp, 40.0);
+}
+
+- (void)testHeadlessSessionPerformance {
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        ORKTowerOfHanoiEngine *engine = [[ORKTowerOfHanoiEngine alloc] initWithNumberOfDisks:ORKActiveTaskEngineBenchmarkDiskCount];
+        NSTimeInterval time = 0;
+        [self solveTowerOfHanoi:engine disks:ORKActiveTaskEngineBenchmarkDiskCount from:0 to:2 via:1 time:&time];
+        XCTAssertTrue(engine.solved);
+        
+        ORKRandomNumberGenerator *generator = [[ORKRandomNumberGenerator alloc] initWithSeed:1];
+        for (NSUInteger session = 0; session < 100; session++) {
+            ORKPSATStep *step = [self PSATStepWithSeriesLength:60];
+            ORKPSATEngine *psat = [[ORKPSATEngine alloc] initWithPSATStep:step
+                                                                  digits:[ORKPSATEngine digitsWithSeriesLength:60 randomNumberGenerator:generator]];
+            NSTimeInterval now = 0;
+            while (!psat.finished) {
+                [psat advanceAtTime:now];
+                [psat submitAnswer:psat.currentDigit.integerValue atTime:now + 1];
+                now += 3;
+            }
+            XCTAssertEqual([psat resultWithIdentifier:@"psat"].samples.count, 60);
+        }
+    }];
+}
+
+@end
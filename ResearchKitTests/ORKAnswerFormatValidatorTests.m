@@ -0,0 +1,248 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKit;
+@import ResearchKit_Private;
+
+
+@interface ORKAnswerFormatValidatorTests : XCTestCase
+
+@end
+
+
+@implementation ORKAnswerFormatValidatorTests {
+    NSDictionary<NSString *, ORKAnswerFormat *> *_answerFormats;
+}
+
+- (void)setUp {
+    [super setUp];
+    NSRegularExpression *digits = [NSRegularExpression regularExpressionWithPattern:@"^[0-9]{3}$" options:0 error:nil];
+    NSRegularExpression *lowercase = [NSRegularExpression regularExpressionWithPattern:@"[a-z]" options:0 error:nil];
+    NSRegularExpression *anyCase = [NSRegularExpression regularExpressionWithPattern:@"[a-z]" options:NSRegularExpressionCaseInsensitive error:nil];
+    _answerFormats = @{
+        @"text": [ORKAnswerFormat textAnswerFormat],
+        @"limited": [ORKAnswerFormat textAnswerFormatWithMaximumLength:5],
+        @"digits": [ORKAnswerFormat textAnswerFormatWithValidationRegularExpression:digits invalidMessage:@"Invalid"],
+        @"lowercase": [ORKAnswerFormat textAnswerFormatWithValidationRegularExpression:lowercase invalidMessage:@"Invalid"],
+        @"anyCase": [ORKAnswerFormat textAnswerFormatWithValidationRegularExpression:anyCase invalidMessage:@"Invalid"],
+        @"email": [ORKAnswerFormat emailAnswerFormat],
+        @"range": [[ORKNumericAnswerFormat alloc] initWithStyle:ORKNumericAnswerStyleInteger unit:nil minimum:@0 maximum:@10],
+        @"unbounded": [ORKAnswerFormat integerAnswerFormatWithUnit:nil],
+        @"atLeastFive": [[ORKNumericAnswerFormat alloc] initWithStyle:ORKNumericAnswerStyleInteger unit:nil minimum:@5 maximum:nil],
+        @"boolean": [ORKAnswerFormat booleanAnswerFormat],
+    };
+}
+
+#pragma mark - Conformance
+
+// Each row is an answer format, a string and whether it was accepted before validators were compiled.
+- (void)testStringValidation_matchesAnswerFormats {
+    NSArray<NSArray *> *table = @[
+        @[@"text", [NSNull null], @NO],
+        @[@"text", @"", @NO],
+        @[@"text", @"   ", @NO],
+        @[@"text", @" \n\t", @NO],
+        @[@"text", @" ", @NO],
+        @[@"text", @" a ", @YES],
+        @[@"text", @"hello", @YES],
+        @[@"limited", @"hello", @YES],
+        @[@"limited", @"hello!", @NO],
+        @[@"limited", @"     ", @NO],
+        @[@"limited", @"👍👍", @YES],
+        @[@"limited", @"👍👍👍", @NO],
+        @[@"digits", @"123", @YES],
+        @[@"digits", @"1234", @NO],
+        @[@"digits", @"12a", @NO],
+        @[@"digits", @" 123", @NO],
+        @[@"digits", @"", @NO],
+        @[@"lowercase", @"ABc", @YES],
+        @[@"lowercase", @"ABC", @NO],
+        @[@"anyCase", @"ABC", @YES],
+        @[@"email", @"someone@researchkit.org", @YES],
+        @[@"email", @"someone@", @NO],
+        @[@"email", @" ", @NO],
+        @[@"range", @"5", @YES],
+        @[@"range", @"0", @YES],
+        @[@"range", @"10", @YES],
+        @[@"range", @"11", @NO],
+        @[@"range", @"-1", @NO],
+        @[@"range", @"", @NO],
+        @[@"range", [NSNull null], @NO],
+        @[@"range", @"abc", @NO],
+        @[@"unbounded", @"-1000000", @YES],
+        @[@"unbounded", @"abc", @NO],
+        @[@"atLeastFive", @"4", @NO],
+        @[@"atLeastFive", @"5", @YES],
+        @[@"atLeastFive", @"100000", @YES],
+        @[@"boolean", @"anything", @YES],
+    ];
+    
+    for (NSArray *row in table) {
+        ORKAnswerFormat *answerFormat = _answerFormats[row[0]];
+        NSString *text = (row[1] == [NSNull null]) ? nil : row[1];
+        BOOL expected = [row[2] boolValue];
+        XCTAssertEqual([answerFormat isAnswerValidWithString:text], expected, @"%@ %@", row[0], text);
+        XCTAssertEqual([answerFormat.validator isAnswerValidWithString:text], expected, @"%@ %@", row[0], text);
+    }
+}
+
+- (void)testAnswerValidation_matchesAnswerFormats {
+    NSArray<NSArray *> *table = @[
+        @[@"text", @"abc", @YES],
+        @[@"text", @5, @NO],
+        @[@"text", [ORKDontKnowAnswer answer], @YES],
+        @[@"text", [NSNull null], @NO],
+        @[@"limited", @"hello!", @NO],
+        @[@"range", @5, @YES],
+        @[@"range", @(NAN), @NO],
+        @[@"range", @10.5, @NO],
+        @[@"range", @"5", @NO],
+        @[@"range", [ORKDontKnowAnswer answer], @YES],
+        @[@"range", [NSNull null], @NO],
+    ];
+    
+    for (NSArray *row in table) {
+        ORKAnswerFormat *answerFormat = _answerFormats[row[0]];
+        BOOL expected = [row[2] boolValue];
+        XCTAssertEqual([answerFormat isAnswerValid:row[1]], expected, @"%@ %@", row[0], row[1]);
+        XCTAssertEqual([answerFormat.validator isAnswerValid:row[1]], expected, @"%@ %@", row[0], row[1]);
+    }
+}
+
+// Each row is a text answer format, a text, the range replaced, the replacement and whether the text
+// answer cells accepted the edit before they used the validator.
+- (void)testEditLengthValidation_matchesTextCells {
+    NSArray<NSArray *> *table = @[
+        @[@"limited", @"hell", [NSValue valueWithRange:NSMakeRange(4, 0)], @"o", @YES],
+        @[@"limited", @"hello", [NSValue valueWithRange:NSMakeRange(5, 0)], @"!", @NO],
+        @[@"limited", @"hello", [NSValue valueWithRange:NSMakeRange(0, 1)], @"j", @YES],
+        @[@"limited", @"hello", [NSValue valueWithRange:NSMakeRange(0, 5)], @"", @YES],
+        @[@"limited", @"hello!", [NSValue valueWithRange:NSMakeRange(5, 1)], @"", @YES],
+        @[@"limited", @"hello!", [NSValue valueWithRange:NSMakeRange(6, 0)], @"?", @NO],
+        @[@"limited", @"hel", [NSValue valueWithRange:NSMakeRange(3, 0)], @"lo\n", @YES],
+        @[@"limited", @"hel\r\n", [NSValue valueWithRange:NSMakeRange(5, 0)], @"lo", @YES],
+        @[@"limited", @"hel", [NSValue valueWithRange:NSMakeRange(3, 0)], @"\n\nlo!", @NO],
+        @[@"limited", [NSNull null], [NSValue valueWithRange:NSMakeRange(0, 0)], @"abcdef", @NO],
+        @[@"text", [NSNull null], [NSValue valueWithRange:NSMakeRange(0, 0)], @"a", @YES],
+        @[@"digits", @"1234", [NSValue valueWithRange:NSMakeRange(4, 0)], @"5", @YES],
+    ];
+    
+    for (NSArray *row in table) {
+        ORKTextAnswerFormat *answerFormat = (ORKTextAnswerFormat *)_answerFormats[row[0]];
+        NSString *text = (row[1] == [NSNull null]) ? nil : row[1];
+        NSRange range = [row[2] rangeValue];
+        BOOL expected = [row[4] boolValue];
+        XCTAssertEqual([answerFormat.validator isEditLengthValidWithString:text replacingCharactersInRange:range withString:row[3]], expected, @"%@ %@", row[0], text);
+        
+        NSString *edited = [(text ? : @"") stringByReplacingCharactersInRange:range withString:row[3]];
+        NSString *stripped = [[edited componentsSeparatedByCharactersInSet:[NSCharacterSet newlineCharacterSet]] componentsJoinedByString:@""];
+        BOOL cellAccepted = !(text.length < edited.length && answerFormat.maximumLength > 0 && stripped.length > (NSUInteger)answerFormat.maximumLength);
+        XCTAssertEqual(cellAccepted, expected, @"%@ %@", row[0], edited);
+    }
+}
+
+#pragma mark - Compilation
+
+- (void)testValidator_isCompiledAgainAfterChanges {
+    ORKTextAnswerFormat *textFormat = [ORKAnswerFormat textAnswerFormatWithMaximumLength:3];
+    ORKAnswerFormatValidator *validator = textFormat.validator;
+    XCTAssertEqual(textFormat.validator, validator);
+    XCTAssertFalse([textFormat isAnswerValidWithString:@"hello"]);
+    
+    textFormat.maximumLength = 5;
+    XCTAssertNotEqual(textFormat.validator, validator);
+    XCTAssertTrue([textFormat isAnswerValidWithString:@"hello"]);
+    
+    textFormat.validationRegularExpression = [NSRegularExpression regularExpressionWithPattern:@"^h" options:0 error:nil];
+    XCTAssertFalse([textFormat isAnswerValidWithString:@"jello"]);
+    
+    ORKNumericAnswerFormat *numericFormat = [ORKAnswerFormat integerAnswerFormatWithUnit:nil];
+    XCTAssertTrue([numericFormat isAnswerValidWithString:@"20"]);
+    numericFormat.maximum = @10;
+    XCTAssertFalse([numericFormat isAnswerValidWithString:@"20"]);
+    numericFormat.minimum = @15;
+    numericFormat.maximum = nil;
+    XCTAssertTrue([numericFormat isAnswerValidWithString:@"20"]);
+    XCTAssertFalse([numericFormat isAnswerValidWithString:@"14"]);
+}
+
+- (void)testRegularExpressionCache_sharesEqualPatterns {
+    ORKTextAnswerFormat *first = (ORKTextAnswerFormat *)_answerFormats[@"lowercase"];
+    NSRegularExpression *lowercase = [NSRegularExpression regularExpressionWithPattern:@"[a-z]" options:0 error:nil];
+    ORKTextAnswerFormat *second = [ORKAnswerFormat textAnswerFormatWithValidationRegularExpression:lowercase invalidMessage:@"Invalid"];
+    XCTAssertEqual(first.validator.regularExpression, second.validator.regularExpression);
+    XCTAssertNotEqual(first.validator.regularExpression, ((ORKTextAnswerFormat *)_answerFormats[@"anyCase"]).validator.regularExpression);
+    
+    ORKRegularExpressionCache *cache = [ORKRegularExpressionCache sharedCache];
+    XCTAssertNil([cache regularExpressionWithPattern:@"[" options:0]);
+    dispatch_apply(200, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t index) {
+        NSString *pattern = [NSString stringWithFormat:@"^[0-9]{%zu}$", index % 10];
+        XCTAssertEqualObjects([cache regularExpressionWithPattern:pattern options:0].pattern, pattern);
+    });
+}
+
+#pragma mark - Benchmarks
+
+// Types an answer into each field of a large form, checking the length of each edit and validating
+// the text on every keystroke as the text field cells do.
+- (void)testKeystrokeReplayPerformance {
+    NSMutableArray<ORKAnswerFormat *> *fields = [NSMutableArray array];
+    NSMutableArray<NSString *> *answers = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 50; i++) {
+        if (i % 2 == 0) {
+            [fields addObject:[ORKAnswerFormat emailAnswerFormat]];
+            [answers addObject:[NSString stringWithFormat:@"participant.%lu@researchkit.org", (unsigned long)i]];
+        } else {
+            [fields addObject:[[ORKNumericAnswerFormat alloc] initWithStyle:ORKNumericAnswerStyleInteger unit:nil minimum:@0 maximum:@100000]];
+            [answers addObject:[NSString stringWithFormat:@"%lu", (unsigned long)(i * 997)]];
+        }
+    }
+    
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        for (NSUInteger field = 0; field < fields.count; field++) {
+            ORKAnswerFormat *answerFormat = fields[field];
+            NSString *answer = answers[field];
+            NSString *text = @"";
+            for (NSUInteger length = 1; length <= answer.length; length++) {
+                NSString *keystroke = [answer substringWithRange:NSMakeRange(length - 1, 1)];
+                ORKAnswerFormatValidator *validator = answerFormat.validator;
+                if ([validator isKindOfClass:[ORKTextAnswerFormatValidator class]]) {
+                    [(ORKTextAnswerFormatValidator *)validator isEditLengthValidWithString:text replacingCharactersInRange:NSMakeRange(text.length, 0) withString:keystroke];
+                }
+                text = [text stringByAppendingString:keystroke];
+                [answerFormat isAnswerValidWithString:text];
+            }
+        }
+    }];
+}
+
+@end
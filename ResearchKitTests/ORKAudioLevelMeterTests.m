@@ -0,0 +1,271 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKitActiveTask;
+@import ResearchKitActiveTask_Private;
+
+
+@interface ORKAudioLevelMeterTests : XCTestCase
+
+@end
+
+
+@implementation ORKAudioLevelMeterTests
+
+- (void)testReadsLevelsInOrder {
+    ORKAudioLevelMeter *meter = [[ORKAudioLevelMeter alloc] initWithCapacity:5 decimationFactor:1];
+    XCTAssertEqual(meter.capacity, 8);
+    
+    for (NSInteger index = 0; index < 6; index++) {
+        XCTAssertTrue([meter writeLevel:index]);
+    }
+    float levels[8];
+    XCTAssertEqual([meter readLevels:levels maximumCount:4], 4);
+    XCTAssertEqual(levels[0], 0);
+    XCTAssertEqual(levels[3], 3);
+    
+    // Wraps around the end of the ring.
+    for (NSInteger index = 6; index < 12; index++) {
+        XCTAssertTrue([meter writeLevel:index]);
+    }
+    XCTAssertEqual([meter readLevels:levels maximumCount:8], 8);
+    for (NSInteger index = 0; index < 8; index++) {
+        XCTAssertEqual(levels[index], index + 4);
+    }
+    XCTAssertEqual([meter readLevels:levels maximumCount:8], 0);
+    XCTAssertEqual(meter.writtenLevelCount, 12);
+    XCTAssertEqual(meter.droppedLevelCount, 0);
+}
+
+- (void)testDropsLevelsWhenFull {
+    ORKAudioLevelMeter *meter = [[ORKAudioLevelMeter alloc] initWithCapacity:4 decimationFactor:1];
+    for (NSInteger index = 0; index < 6; index++) {
+        [meter writeLevel:index];
+    }
+    XCTAssertEqual(meter.writtenLevelCount, 4);
+    XCTAssertEqual(meter.droppedLevelCount, 2);
+    
+    // The oldest levels are kept.
+    float levels[4];
+    XCTAssertEqual([meter readLevels:levels maximumCount:4], 4);
+    XCTAssertEqual(levels[3], 3);
+    
+    [meter writeLevel:7];
+    [meter discardLevels];
+    XCTAssertEqual([meter readLevels:levels maximumCount:4], 0);
+}
+
+- (void)testDecimatesByMaximum {
+    ORKAudioLevelMeter *meter = [[ORKAudioLevelMeter alloc] initWithCapacity:64 decimationFactor:4];
+    float input[] = {0.1, 0.5, 0.2, 0.3, 0.9, 0.1, 0.1, 0.1, 0.4, 0.2};
+    for (NSUInteger index = 0; index < 10; index++) {
+        [meter writeLevel:input[index]];
+    }
+    NSArray<NSNumber *> *levels = [meter drainDecimatedLevels];
+    XCTAssertEqual(levels.count, 2);
+    XCTAssertEqualWithAccuracy(levels[0].floatValue, 0.5, 1e-6);
+    XCTAssertEqualWithAccuracy(levels[1].floatValue, 0.9, 1e-6);
+    
+    // The two leftover levels are merged into the next run.
+    [meter writeLevel:0.3];
+    [meter writeLevel:0.1];
+    levels = [meter drainDecimatedLevels];
+    XCTAssertEqual(levels.count, 1);
+    XCTAssertEqualWithAccuracy(levels[0].floatValue, 0.4, 1e-6);
+    XCTAssertEqual([meter drainDecimatedLevels].count, 0);
+}
+
+- (void)testDefaultDecimatesPerDrain {
+    ORKAudioLevelMeter *meter = [ORKAudioLevelMeter new];
+    XCTAssertEqual(meter.decimationFactor, ORKAudioLevelMeterDecimationPerDrain);
+    XCTAssertEqual([meter drainDecimatedLevels].count, 0);
+    float input[] = {0.1, 0.5, 0.2, 0.3, 0.9, 0.1, 0.1, 0.1, 0.4, 0.2};
+    for (NSUInteger index = 0; index < 10; index++) {
+        [meter writeLevel:input[index]];
+    }
+    NSArray<NSNumber *> *levels = [meter drainDecimatedLevels];
+    XCTAssertEqual(levels.count, 1);
+    XCTAssertEqualWithAccuracy(levels[0].floatValue, 0.9, 1e-6);
+    
+    // Nothing carries over between drains.
+    [meter writeLevel:0.3];
+    levels = [meter drainDecimatedLevels];
+    XCTAssertEqual(levels.count, 1);
+    XCTAssertEqualWithAccuracy(levels[0].floatValue, 0.3, 1e-6);
+    XCTAssertEqual([meter drainDecimatedLevels].count, 0);
+}
+
+- (void)testPeakLevel {
+    ORKAudioLevelMeter *meter = [ORKAudioLevelMeter new];
+    float loud[64];
+    float silent[64] = {0};
+    for (NSUInteger index = 0; index < 64; index++) {
+        loud[index] = (index % 2) ? 1.0 : -1.0;
+    }
+    for (NSUInteger index = 0; index < 50; index++) {
+        [meter writePeakLevelOfSamples:silent frameCount:64];
+    }
+    float levels[64];
+    NSUInteger count = [meter readLevels:levels maximumCount:64];
+    XCTAssertEqual(count, 50);
+    XCTAssertEqual(levels[count - 1], 0);
+    
+    for (NSUInteger index = 0; index < 50; index++) {
+        [meter writePeakLevelOfSamples:loud frameCount:64];
+    }
+    count = [meter readLevels:levels maximumCount:64];
+    XCTAssertEqual(count, 50);
+    // Smoothed from silence up to full scale.
+    XCTAssertLessThan(levels[0], levels[1]);
+    XCTAssertEqualWithAccuracy(levels[count - 1], 1.0, 1e-3);
+}
+
+- (void)testConcurrentProducerAndConsumer {
+    ORKAudioLevelMeter *meter = [[ORKAudioLevelMeter alloc] initWithCapacity:256 decimationFactor:1];
+    NSUInteger levelCount = 200000;
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INTERACTIVE, 0), ^{
+        for (NSUInteger index = 0; index < levelCount; index++) {
+            [meter writeLevel:index];
+        }
+    });
+    
+    NSUInteger readCount = 0;
+    float previous = -1;
+    BOOL ordered = YES;
+    float levels[256];
+    while (dispatch_group_wait(group, DISPATCH_TIME_NOW) != 0 || meter.writtenLevelCount > readCount) {
+        NSUInteger count = [meter readLevels:levels maximumCount:256];
+        for (NSUInteger index = 0; index < count; index++) {
+            ordered = ordered && (levels[index] > previous);
+            previous = levels[index];
+        }
+        readCount += count;
+    }
+    
+    XCTAssertTrue(ordered);
+    XCTAssertEqual(readCount, meter.writtenLevelCount);
+    XCTAssertEqual(meter.writtenLevelCount + meter.droppedLevelCount, levelCount);
+}
+
+static const NSUInteger ORKAudioLevelMeterTestTapCount = 750 * 60;
+
+- (void)testAudioThreadCost {
+    // A minute of 64-frame taps at 48 kHz, drained by a consumer at display rate.
+    float samples[64];
+    for (NSUInteger index = 0; index < 64; index++) {
+        samples[index] = sinf(index * 0.3f) * 0.5f;
+    }
+    // Blocks cannot capture C arrays.
+    const float *tapSamples = samples;
+    
+    [self measureBlock:^{
+        ORKAudioLevelMeter *meter = [[ORKAudioLevelMeter alloc] initWithCapacity:1024 decimationFactor:1];
+        __block volatile BOOL producing = YES;
+        dispatch_semaphore_t consumerFinished = dispatch_semaphore_create(0);
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            float levels[1024];
+            while (producing) {
+                [meter readLevels:levels maximumCount:1024];
+                usleep(16667);
+            }
+            dispatch_semaphore_signal(consumerFinished);
+        });
+        
+        for (NSUInteger tap = 0; tap < ORKAudioLevelMeterTestTapCount; tap++) {
+            [meter writePeakLevelOfSamples:tapSamples frameCount:64];
+        }
+        producing = NO;
+        dispatch_semaphore_wait(consumerFinished, DISPATCH_TIME_FOREVER);
+        
+        // Levels written faster than real time overrun the ring, but never before it is full.
+        XCTAssertEqual(meter.writtenLevelCount + meter.droppedLevelCount, ORKAudioLevelMeterTestTapCount);
+        XCTAssertLessThanOrEqual(meter.droppedLevelCount, ORKAudioLevelMeterTestTapCount - meter.capacity);
+    }];
+}
+
+- (void)testRealTimeDeliveryDropsNothing {
+    ORKAudioLevelMeter *meter = [[ORKAudioLevelMeter alloc] initWithCapacity:1024 decimationFactor:1];
+    float samples[64] = {0.25};
+    const float *tapSamples = samples;
+    __block NSUInteger drainedCount = 0;
+    [meter startDisplayUpdatesWithHandler:^(NSArray<NSNumber *> *levels) {
+        drainedCount += levels.count;
+    }];
+    
+    // Half a second of 64-frame taps at 48 kHz, paced in 10 ms bursts.
+    XCTestExpectation *expectation = [self expectationWithDescription:@"produced"];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INTERACTIVE, 0), ^{
+        for (NSUInteger burst = 0; burst < 50; burst++) {
+            for (NSUInteger tap = 0; tap < 8; tap++) {
+                [meter writePeakLevelOfSamples:tapSamples frameCount:64];
+            }
+            usleep(10000);
+        }
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    [meter stopDisplayUpdates];
+    
+    XCTAssertEqual(meter.droppedLevelCount, 0);
+    XCTAssertEqual(drainedCount, 400);
+}
+
+- (void)testPreviousDispatchCost {
+    // The baseline for testAudioThreadCost: a boxed level dispatched to a queue per tap.
+    float samples[64];
+    for (NSUInteger index = 0; index < 64; index++) {
+        samples[index] = sinf(index * 0.3f) * 0.5f;
+    }
+    const float *tapSamples = samples;
+    dispatch_queue_t queue = dispatch_queue_create("consumer", DISPATCH_QUEUE_SERIAL);
+    [self measureBlock:^{
+        __block float peakPower = 0;
+        __block NSUInteger received = 0;
+        for (NSUInteger tap = 0; tap < ORKAudioLevelMeterTestTapCount; tap++) {
+            float peak = 0;
+            for (NSUInteger index = 0; index < 64; index++) {
+                peak = MAX(peak, fabsf(tapSamples[index]));
+            }
+            peakPower = 0.3 * 20 * log10f(peak) + 0.7 * peakPower;
+            NSNumber *level = @(MAX(peakPower / 60.0, -1) + 1);
+            dispatch_async(queue, ^{
+                received += level.floatValue > 0;
+            });
+        }
+        dispatch_sync(queue, ^{});
+        XCTAssertEqual(received, ORKAudioLevelMeterTestTapCount);
+    }];
+}
+
+@end
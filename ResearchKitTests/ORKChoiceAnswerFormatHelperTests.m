@@ -35,6 +35,75 @@
 #import "ORKChoiceAnswerFormatHelper.h"
 
 
+// The linear matching that ORKChoiceAnswerFormatHelper used before it indexed choices, kept to check parity.
+static NSArray *ORKReferenceSelectedIndexesForAnswer(NSArray *choices, BOOL isValuePicker, id answer) {
+    if ([answer isKindOfClass:[NSNumber class]]) {
+        answer = @[answer];
+    }
+    
+    NSMutableArray *indexArray = [NSMutableArray new];
+    
+    if (answer != nil && answer != ORKNullAnswerValue()) {
+        if (![answer isKindOfClass:[ORKChoiceQuestionResult answerClass]]) {
+            @throw [NSException exceptionWithName:@"Wrong answer type" reason:nil userInfo:nil];
+        }
+        
+        for (id answerValue in (NSArray *)answer) {
+            id<ORKAnswerOption> matchedChoice = nil;
+            BOOL isTextChoiceOtherResult = YES;
+            for (id<ORKAnswerOption> choice in choices) {
+                if ([choice.value isEqual:answerValue]) {
+                    isTextChoiceOtherResult = NO;
+                }
+            }
+            
+            for (id<ORKAnswerOption> choice in choices) {
+                if ([choice isKindOfClass:[ORKTextChoiceOther class]]) {
+                    ORKTextChoiceOther *textChoiceOther = (ORKTextChoiceOther *)choice;
+                    if ([textChoiceOther.textViewText isEqual:answerValue]) {
+                        matchedChoice = choice;
+                        break;
+                    } else if (textChoiceOther.textViewInputOptional && textChoiceOther.textViewText.length <= 0 && [textChoiceOther.value isEqual:answerValue]) {
+                        matchedChoice = choice;
+                        break;
+                    } else if (isTextChoiceOtherResult) {
+                        textChoiceOther.textViewText = answerValue;
+                        matchedChoice = choice;
+                        break;
+                    }
+                } else if ([choice.value isEqual:answerValue]) {
+                    matchedChoice = choice;
+                    break;
+                }
+            }
+            
+            if (nil == matchedChoice) {
+                if (![answerValue isKindOfClass:[NSNumber class]]) {
+                    @throw [NSException exceptionWithName:@"No matching choice found" reason:nil userInfo:nil];
+                }
+                matchedChoice = choices[((NSNumber *)answerValue).unsignedIntegerValue + (isValuePicker ? 1 : 0)];
+            }
+            
+            [indexArray addObject:@([choices indexOfObject:matchedChoice])];
+        }
+    }
+    
+    if (isValuePicker && indexArray.count == 0) {
+        [indexArray addObject:@(0)];
+    }
+    
+    return [indexArray copy];
+}
+
+static id ORKResultOrExceptionName(id (^block)(void)) {
+    @try {
+        return block();
+    } @catch (NSException *exception) {
+        return exception.name;
+    }
+}
+
+
 @interface ORKChoiceAnswerFormatHelperTests : XCTestCase
 
 @end
@@ -349,4 +418,144 @@
     }
 }
 
+- (NSArray *)parityChoicesWithTextChoiceOthers:(BOOL)includeTextChoiceOthers {
+    NSMutableArray *choices = [NSMutableArray array];
+    [choices addObject:[ORKTextChoice choiceWithText:@"choice 01" value:@"c1"]];
+    if (includeTextChoiceOthers) {
+        [choices addObject:[[ORKTextChoiceOther alloc] initWithText:@"other 01" primaryTextAttributedString:nil detailText:nil detailTextAttributedString:nil value:@"o1" exclusive:NO textViewPlaceholderText:@"" textViewInputOptional:YES textViewStartsHidden:NO]];
+    }
+    [choices addObject:[ORKTextChoice choiceWithText:@"choice 02" value:@"c1"]];
+    [choices addObject:[ORKTextChoice choiceWithText:@"duplicate" value:@"d"]];
+    [choices addObject:[ORKTextChoice choiceWithText:@"zero" value:@0]];
+    if (includeTextChoiceOthers) {
+        [choices addObject:[ORKTextChoice choiceWithText:@"shadowed" value:@"o1"]];
+        [choices addObject:[[ORKTextChoiceOther alloc] initWithText:@"other 02" primaryTextAttributedString:nil detailText:nil detailTextAttributedString:nil value:@"o2" exclusive:NO textViewPlaceholderText:@"" textViewInputOptional:NO textViewStartsHidden:NO]];
+        [choices addObject:[ORKTextChoice choiceWithText:@"shadowed" value:@"o2"]];
+        [choices addObject:[[ORKTextChoiceOther alloc] initWithText:@"other 01" primaryTextAttributedString:nil detailText:nil detailTextAttributedString:nil value:@"o1" exclusive:NO textViewPlaceholderText:@"" textViewInputOptional:YES textViewStartsHidden:NO]];
+    }
+    [choices addObject:[ORKTextChoice choiceWithText:@"duplicate" value:@"d"]];
+    [choices addObject:[ORKTextChoice choiceWithText:@"seven" value:@7]];
+    [choices addObject:[ORKTextChoice choiceWithText:@"date" value:[NSDate dateWithTimeIntervalSince1970:0]]];
+    return choices;
+}
+
+- (NSArray *)parityAnswersForChoices:(NSArray *)choices {
+    NSMutableArray *answerValues = [NSMutableArray array];
+    for (ORKTextChoice *choice in choices) {
+        [answerValues addObject:choice.value];
+    }
+    for (NSInteger index = -1; index <= (NSInteger)choices.count + 1; index++) {
+        [answerValues addObject:@(index)];
+    }
+    [answerValues addObjectsFromArray:@[@"free text", @"more free text", @YES, @1.5, [NSDate dateWithTimeIntervalSince1970:1]]];
+    
+    NSMutableArray *answers = [NSMutableArray arrayWithArray:@[[NSNull null], @"c1", @0, @7, @[]]];
+    for (id first in answerValues) {
+        [answers addObject:@[first]];
+        for (id second in answerValues) {
+            [answers addObject:@[first, second]];
+        }
+    }
+    return answers;
+}
+
+- (void)testSelectedIndexesForAnswer_matchesLinearMatching {
+    for (NSNumber *includeTextChoiceOthers in @[@NO, @YES]) {
+        for (NSNumber *isValuePicker in @[@NO, @YES]) {
+            NSArray *helperChoices = [self parityChoicesWithTextChoiceOthers:includeTextChoiceOthers.boolValue];
+            NSArray *referenceChoices = [self parityChoicesWithTextChoiceOthers:includeTextChoiceOthers.boolValue];
+            
+            ORKAnswerFormat *answerFormat = isValuePicker.boolValue ? [ORKAnswerFormat valuePickerAnswerFormatWithTextChoices:helperChoices] : [ORKAnswerFormat choiceAnswerFormatWithStyle:ORKChoiceAnswerStyleMultipleChoice textChoices:helperChoices];
+            ORKChoiceAnswerFormatHelper *formatHelper = [[ORKChoiceAnswerFormatHelper alloc] initWithAnswerFormat:answerFormat];
+            if (isValuePicker.boolValue) {
+                referenceChoices = [@[[answerFormat choices].firstObject] arrayByAddingObjectsFromArray:referenceChoices];
+            }
+            
+            for (id answer in [self parityAnswersForChoices:helperChoices]) {
+                id expected = ORKResultOrExceptionName(^id{
+                    return ORKReferenceSelectedIndexesForAnswer(referenceChoices, isValuePicker.boolValue, answer == [NSNull null] ? nil : answer);
+                });
+                id actual = ORKResultOrExceptionName(^id{
+                    return [formatHelper selectedIndexesForAnswer:answer == [NSNull null] ? nil : answer];
+                });
+                XCTAssertEqualObjects(actual, expected, @"%@", answer);
+                
+                [referenceChoices enumerateObjectsUsingBlock:^(ORKTextChoice *choice, NSUInteger idx, BOOL *stop) {
+                    if ([choice isKindOfClass:[ORKTextChoiceOther class]]) {
+                        XCTAssertEqualObjects([formatHelper textChoiceAtIndex:idx].textViewText, ((ORKTextChoiceOther *)choice).textViewText, @"%@", answer);
+                    }
+                }];
+            }
+        }
+    }
+}
+
+- (void)testSelectedIndexesForAnswer_throwsForUnmatchedAnswers {
+    ORKAnswerFormat *answerFormat = [ORKAnswerFormat choiceAnswerFormatWithStyle:ORKChoiceAnswerStyleMultipleChoice textChoices:[self textChoices]];
+    ORKChoiceAnswerFormatHelper *formatHelper = [[ORKChoiceAnswerFormatHelper alloc] initWithAnswerFormat:answerFormat];
+    
+    XCTAssertThrowsSpecificNamed([formatHelper selectedIndexesForAnswer:@"c1"], NSException, @"Wrong answer type");
+    XCTAssertThrowsSpecificNamed([formatHelper selectedIndexesForAnswer:@[@"c9"]], NSException, @"No matching choice found");
+    XCTAssertThrowsSpecificNamed([formatHelper selectedIndexesForAnswer:@[@4]], NSException, NSRangeException);
+    XCTAssertEqualObjects([formatHelper selectedIndexesForAnswer:@[@3, @"c1"]], (@[@3, @0]));
+    
+    answerFormat = [ORKAnswerFormat valuePickerAnswerFormatWithTextChoices:[self textChoices]];
+    formatHelper = [[ORKChoiceAnswerFormatHelper alloc] initWithAnswerFormat:answerFormat];
+    XCTAssertThrowsSpecificNamed([formatHelper selectedIndexesForAnswer:@[@4]], NSException, NSRangeException);
+    XCTAssertEqualObjects([formatHelper selectedIndexesForAnswer:@[@3]], (@[@4]));
+}
+
+- (void)testAnswerForSelectedIndexes_skipsInvalidIndexes {
+    ORKAnswerFormat *answerFormat = [ORKAnswerFormat valuePickerAnswerFormatWithTextChoices:[self textChoices]];
+    ORKChoiceAnswerFormatHelper *formatHelper = [[ORKChoiceAnswerFormatHelper alloc] initWithAnswerFormat:answerFormat];
+    
+    XCTAssertEqual([formatHelper answerForSelectedIndex:5], ORKNullAnswerValue());
+    XCTAssertEqualObjects([formatHelper answerForSelectedIndexes:@[@0, @2, @9, @4]], (@[@"c2", @"c4"]));
+}
+
+#pragma mark - Benchmarks
+
+- (ORKTextChoiceAnswerFormat *)largeChoiceAnswerFormat {
+    NSMutableArray *textChoices = [NSMutableArray arrayWithCapacity:5000];
+    for (NSUInteger index = 0; index < 5000; index++) {
+        [textChoices addObject:[ORKTextChoice choiceWithText:[NSString stringWithFormat:@"Medication %lu", (unsigned long)index]
+                                                       value:[NSString stringWithFormat:@"medication.%lu", (unsigned long)index]]];
+    }
+    return [ORKAnswerFormat choiceAnswerFormatWithStyle:ORKChoiceAnswerStyleMultipleChoice textChoices:textChoices];
+}
+
+// Restores a multiple choice answer that selects every tenth choice of a large list.
+- (void)testSelectedIndexesForAnswerPerformance {
+    ORKTextChoiceAnswerFormat *answerFormat = [self largeChoiceAnswerFormat];
+    ORKChoiceAnswerFormatHelper *formatHelper = [[ORKChoiceAnswerFormatHelper alloc] initWithAnswerFormat:answerFormat];
+    NSMutableArray *answer = [NSMutableArray array];
+    for (NSUInteger index = 0; index < answerFormat.textChoices.count; index += 10) {
+        [answer addObject:answerFormat.textChoices[index].value];
+    }
+    
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        for (NSUInteger iteration = 0; iteration < 10; iteration++) {
+            [formatHelper selectedIndexesForAnswer:answer];
+        }
+    }];
+}
+
+- (void)testAnswerForSelectedIndexesPerformance {
+    ORKTextChoiceAnswerFormat *answerFormat = [self largeChoiceAnswerFormat];
+    ORKChoiceAnswerFormatHelper *formatHelper = [[ORKChoiceAnswerFormatHelper alloc] initWithAnswerFormat:answerFormat];
+    NSMutableArray *indexes = [NSMutableArray array];
+    for (NSUInteger index = 0; index < answerFormat.textChoices.count; index++) {
+        [indexes addObject:@(index)];
+    }
+    
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        for (NSUInteger iteration = 0; iteration < 10; iteration++) {
+            [formatHelper answerForSelectedIndexes:indexes];
+            for (NSUInteger index = 0; index < indexes.count; index += 10) {
+                [formatHelper answerForSelectedIndex:index];
+            }
+        }
+    }];
+}
+
 @end
@@ -0,0 +1,240 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKit;
+@import ResearchKit_Private;
+
+#include <mach/mach_time.h>
+
+
+@interface ORKClockTests : XCTestCase
+
+@end
+
+
+@implementation ORKClockTests
+
+- (void)testClockMatchesSystemUptime {
+    NSTimeInterval before = [NSProcessInfo processInfo].systemUptime;
+    NSTimeInterval uptime = ORKClockSystemUptime();
+    NSTimeInterval after = [NSProcessInfo processInfo].systemUptime;
+    
+    XCTAssertGreaterThanOrEqual(uptime, before - 0.001);
+    XCTAssertLessThanOrEqual(uptime, after + 0.001);
+}
+
+- (void)testClockIsMonotonic {
+    ORKClockTime previous = ORKClockNow();
+    for (NSInteger index = 0; index < 10000; index++) {
+        ORKClockTime now = ORKClockNow();
+        XCTAssertGreaterThanOrEqual(now, previous);
+        previous = now;
+    }
+}
+
+- (void)testConversions {
+    ORKClockTime clockTime = ORKClockTimeFromSystemUptime(12345.678901234);
+    XCTAssertEqual(clockTime, 12345678901234ULL);
+    XCTAssertEqualWithAccuracy(ORKSystemUptimeFromClockTime(clockTime), 12345.678901234, 1e-9);
+    XCTAssertEqual(ORKClockTimeFromSystemUptime(-1), 0);
+    
+    uint64_t hostTime = mach_absolute_time();
+    ORKClockTime hostClockTime = ORKClockTimeFromHostTime(hostTime);
+    // Converting back loses at most one tick.
+    uint64_t roundTrip = ORKHostTimeFromClockTime(hostClockTime);
+    XCTAssertLessThanOrEqual(hostTime - roundTrip, 1);
+    
+    XCTAssertEqualWithAccuracy(ORKTimeIntervalBetweenClockTimes(1000, 2500000000ULL), 2.499999999, 1e-12);
+    XCTAssertEqualWithAccuracy(ORKTimeIntervalBetweenClockTimes(2500000000ULL, 1000), -2.499999999, 1e-12);
+}
+
+- (void)testExactStreams {
+    ORKTimelineAligner *aligner = [ORKTimelineAligner new];
+    [aligner addStreamWithIdentifier:@"accelerometer" timebase:ORKTimelineTimebaseSystemUptime];
+    [aligner addStreamWithIdentifier:@"audio" timebase:ORKTimelineTimebaseHostTime];
+    // Observations of exact streams are ignored.
+    [aligner observeStreamTime:5 clockTime:ORKClockTimeFromSystemUptime(7) forStreamWithIdentifier:@"accelerometer"];
+    
+    ORKTimelineAlignmentResult *result = [aligner resultWithIdentifier:@"timeline"];
+    ORKTimelineStreamAlignment *accelerometer = [result streamAlignmentForIdentifier:@"accelerometer"];
+    XCTAssertEqual(accelerometer.sampleCount, 0);
+    XCTAssertEqualWithAccuracy([accelerometer systemUptimeForStreamTime:1234.5], 1234.5, 1e-9);
+    
+    uint64_t hostTime = mach_absolute_time();
+    ORKTimelineStreamAlignment *audio = [result streamAlignmentForIdentifier:@"audio"];
+    XCTAssertEqualWithAccuracy([audio systemUptimeForStreamTime:(double)hostTime], ORKSystemUptimeFromClockTime(ORKClockTimeFromHostTime(hostTime)), 1e-6);
+    
+    XCTAssertNotNil([result streamAlignmentForIdentifier:ORKTimelineWallClockStreamIdentifier]);
+    XCTAssertNil([result streamAlignmentForIdentifier:@"unknown"]);
+}
+
+- (void)testAlignmentOfSkewedStreams {
+    // A wall clock running 200 ppm fast and a second stream running 150 ppm slow, both
+    // observed every half second for five minutes with up to 2 ms of observation jitter.
+    const double skews[] = { 200e-6, -150e-6 };
+    const double offsets[] = { 1.7e9, -42.0 };
+    const NSTimeInterval jitter = 0.002;
+    const NSTimeInterval start = 5000;
+    
+    ORKTimelineAligner *aligner = [ORKTimelineAligner new];
+    [aligner addStreamWithIdentifier:@"fast" timebase:ORKTimelineTimebaseWallClock];
+    [aligner addStreamWithIdentifier:@"slow" timebase:ORKTimelineTimebaseStepRuntime];
+    NSArray<NSString *> *identifiers = @[ @"fast", @"slow" ];
+    
+    uint32_t state = 7;
+    for (NSInteger index = 0; index < 600; index++) {
+        NSTimeInterval uptime = start + (index * 0.5);
+        for (NSUInteger stream = 0; stream < identifiers.count; stream++) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            double noise = (((double)state / UINT32_MAX) * 2.0 - 1.0) * jitter;
+            double streamTime = offsets[stream] + ((uptime - start) * (1 + skews[stream]));
+            [aligner observeStreamTime:streamTime clockTime:ORKClockTimeFromSystemUptime(uptime + noise) forStreamWithIdentifier:identifiers[stream]];
+        }
+    }
+    
+    ORKTimelineAlignmentResult *result = [aligner resultWithIdentifier:@"timeline"];
+    for (NSUInteger stream = 0; stream < identifiers.count; stream++) {
+        ORKTimelineStreamAlignment *alignment = [result streamAlignmentForIdentifier:identifiers[stream]];
+        XCTAssertEqual(alignment.sampleCount, 600);
+        XCTAssertEqualWithAccuracy(alignment.rate, 1.0 / (1 + skews[stream]), 5e-6);
+        XCTAssertLessThan(alignment.residual, jitter);
+        
+        NSTimeInterval maximumError = 0;
+        for (NSInteger index = 0; index < 600; index++) {
+            NSTimeInterval uptime = start + (index * 0.5);
+            double streamTime = offsets[stream] + ((uptime - start) * (1 + skews[stream]));
+            maximumError = MAX(maximumError, fabs([alignment systemUptimeForStreamTime:streamTime] - uptime));
+        }
+        // Far better than the observation jitter, and far better than ignoring the 60 ms of drift.
+        XCTAssertLessThan(maximumError, 0.5e-3);
+    }
+}
+
+- (void)testRecorderStreamsShareWallClockFit {
+    // A recorder writing wall clock timestamps is never observed itself; only the wall clock
+    // stream is, here running 200 ppm fast with up to 2 ms of observation jitter.
+    const double skew = 200e-6;
+    const double offset = 1.7e9;
+    const NSTimeInterval jitter = 0.002;
+    const NSTimeInterval start = 5000;
+    
+    ORKTimelineAligner *aligner = [ORKTimelineAligner new];
+    [aligner addStreamWithIdentifier:@"location" timebase:ORKTimelineTimebaseWallClock];
+    uint32_t state = 11;
+    for (NSInteger index = 0; index < 600; index++) {
+        NSTimeInterval uptime = start + (index * 0.5);
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        double noise = (((double)state / UINT32_MAX) * 2.0 - 1.0) * jitter;
+        double wallClockTime = offset + ((uptime - start) * (1 + skew));
+        [aligner observeStreamTime:wallClockTime clockTime:ORKClockTimeFromSystemUptime(uptime + noise) forStreamWithIdentifier:ORKTimelineWallClockStreamIdentifier];
+    }
+    
+    ORKTimelineAlignmentResult *result = [aligner resultWithIdentifier:@"timeline"];
+    ORKTimelineStreamAlignment *location = [result streamAlignmentForIdentifier:@"location"];
+    XCTAssertEqual(location.timebase, ORKTimelineTimebaseWallClock);
+    XCTAssertEqual(location.sampleCount, 600);
+    XCTAssertEqualWithAccuracy(location.rate, 1.0 / (1 + skew), 5e-6);
+    
+    NSTimeInterval maximumError = 0;
+    for (NSInteger index = 0; index < 600; index++) {
+        NSTimeInterval uptime = start + (index * 0.5);
+        double wallClockTime = offset + ((uptime - start) * (1 + skew));
+        maximumError = MAX(maximumError, fabs([location systemUptimeForStreamTime:wallClockTime] - uptime));
+    }
+    XCTAssertLessThan(maximumError, 0.5e-3);
+}
+
+- (void)testRestartDiscardsObservations {
+    ORKTimelineAligner *aligner = [ORKTimelineAligner new];
+    [aligner addStreamWithIdentifier:@"runtime" timebase:ORKTimelineTimebaseStepRuntime];
+    [aligner observeStreamTime:0 clockTime:ORKClockTimeFromSystemUptime(100) forStreamWithIdentifier:@"runtime"];
+    [aligner observeStreamTime:5 clockTime:ORKClockTimeFromSystemUptime(105) forStreamWithIdentifier:@"runtime"];
+    
+    // Suspended for 20 seconds
+    [aligner restartStreamWithIdentifier:@"runtime"];
+    [aligner observeStreamTime:5 clockTime:ORKClockTimeFromSystemUptime(125) forStreamWithIdentifier:@"runtime"];
+    [aligner observeStreamTime:8 clockTime:ORKClockTimeFromSystemUptime(128) forStreamWithIdentifier:@"runtime"];
+    
+    ORKTimelineStreamAlignment *alignment = [[aligner resultWithIdentifier:@"timeline"] streamAlignmentForIdentifier:@"runtime"];
+    XCTAssertEqual(alignment.sampleCount, 2);
+    XCTAssertEqualWithAccuracy(alignment.rate, 1, 1e-9);
+    XCTAssertEqualWithAccuracy([alignment systemUptimeForStreamTime:6], 126, 1e-6);
+}
+
+- (void)testWallClockObservation {
+    ORKTimelineAligner *aligner = [ORKTimelineAligner new];
+    [aligner observeWallClock];
+    
+    ORKTimelineStreamAlignment *wallClock = [[aligner resultWithIdentifier:@"timeline"] streamAlignmentForIdentifier:ORKTimelineWallClockStreamIdentifier];
+    XCTAssertEqual(wallClock.sampleCount, 1);
+    NSTimeInterval now = [NSDate date].timeIntervalSince1970;
+    XCTAssertEqualWithAccuracy([wallClock systemUptimeForStreamTime:now], ORKClockSystemUptime(), 0.01);
+}
+
+- (void)testResultSecureCoding {
+    ORKTimelineAligner *aligner = [ORKTimelineAligner new];
+    [aligner addStreamWithIdentifier:@"touch" timebase:ORKTimelineTimebaseSystemUptime];
+    [aligner observeWallClock];
+    ORKTimelineAlignmentResult *result = [aligner resultWithIdentifier:@"timeline"];
+    
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:result requiringSecureCoding:YES error:NULL];
+    ORKTimelineAlignmentResult *decoded = [NSKeyedUnarchiver unarchivedObjectOfClass:[ORKTimelineAlignmentResult class] fromData:data error:NULL];
+    XCTAssertEqualObjects(decoded, result);
+    XCTAssertEqualObjects([result copy], result);
+}
+
+- (void)testClockReadPerformance {
+    [self measureBlock:^{
+        ORKClockTime sum = 0;
+        for (NSInteger index = 0; index < 1000000; index++) {
+            sum += ORKClockNow();
+        }
+        XCTAssertNotEqual(sum, 0);
+    }];
+}
+
+- (void)testSystemUptimeReadPerformance {
+    // Baseline for testClockReadPerformance
+    [self measureBlock:^{
+        NSTimeInterval sum = 0;
+        for (NSInteger index = 0; index < 1000000; index++) {
+            sum += [NSProcessInfo processInfo].systemUptime;
+        }
+        XCTAssertNotEqual(sum, 0);
+    }];
+}
+
+@end
@@ -192,4 +192,77 @@ body, p, h1, h2, h3 { font-family: Helvetica; }\n\
     XCTAssertEqualObjects(passedError, error);
 }
 
+- (NSURL *)temporaryPDFURL {
+    NSString *name = [[NSUUID UUID].UUIDString stringByAppendingPathExtension:@"pdf"];
+    NSURL *url = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:name]];
+    [self addTeardownBlock:^{
+        [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+    }];
+    return url;
+}
+
+- (void)testWritePDFToURL_withoutHTMLContent_writesTitleSectionsAndSignaturePage {
+    ORKConsentDocument *document = [[ORKConsentDocument alloc] init];
+    document.title = @"A Title";
+    ORKConsentSection *section = [[ORKConsentSection alloc] initWithType:ORKConsentSectionTypeCustom];
+    section.title = @"Section Title";
+    section.content = @"Section content";
+    document.sections = @[section];
+    document.signaturePageTitle = @"Signature Page Title";
+    document.signaturePageContent = @"signature page content";
+    ORKConsentSignature *signature = [ORKConsentSignature signatureForPersonWithTitle:@"Participant"
+                                                                     dateFormatString:nil
+                                                                           identifier:@"participant"
+                                                                            givenName:@"Jonny"
+                                                                           familyName:@"Appleseed"
+                                                                       signatureImage:nil
+                                                                           dateString:@"2/2/15"];
+    signature.requiresSignatureImage = NO;
+    document.signatures = @[signature];
+    
+    NSURL *url = [self temporaryPDFURL];
+    NSError *error = nil;
+    XCTAssertTrue([document writePDFToURL:url error:&error]);
+    XCTAssertNil(error);
+    
+    NSData *data = [NSData dataWithContentsOfURL:url];
+    NSString *pdf = [[NSString alloc] initWithData:data encoding:NSISOLatin1StringEncoding];
+    XCTAssertTrue([pdf hasPrefix:@"%PDF-1.4\n"]);
+    XCTAssertTrue([pdf hasSuffix:@"%%EOF\n"]);
+    XCTAssertTrue([pdf containsString:@"/Count 2 >>"]);
+    for (NSString *text in @[@"(A Title)", @"(Section Title)", @"(Section content)", @"(Signature Page Title)", @"(2/2/15)", @"(Date)"]) {
+        XCTAssertTrue([pdf containsString:text], @"%@ is missing", text);
+    }
+}
+
+- (void)testWritePDFToURL_whenRenameFails_keepsExistingItemAndRemovesPartialFile {
+    ORKConsentDocument *document = [[ORKConsentDocument alloc] init];
+    document.title = @"A Title";
+    
+    // A file can't be renamed over a directory, so the write fails after the PDF is streamed out.
+    NSURL *url = [self temporaryPDFURL];
+    NSURL *existingURL = [url URLByAppendingPathComponent:@"existing"];
+    XCTAssertTrue([[NSFileManager defaultManager] createDirectoryAtURL:url withIntermediateDirectories:NO attributes:nil error:NULL]);
+    XCTAssertTrue([[@"existing" dataUsingEncoding:NSUTF8StringEncoding] writeToURL:existingURL atomically:NO]);
+    
+    NSError *error = nil;
+    XCTAssertFalse([document writePDFToURL:url error:&error]);
+    XCTAssertEqualObjects(error.domain, NSPOSIXErrorDomain);
+    XCTAssertEqualObjects([NSData dataWithContentsOfURL:existingURL], [@"existing" dataUsingEncoding:NSUTF8StringEncoding]);
+    NSString *partialName = [NSString stringWithFormat:@".%@.partial", url.lastPathComponent];
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[url.URLByDeletingLastPathComponent URLByAppendingPathComponent:partialName].path]);
+}
+
+- (void)testWritePDFToURL_withHTMLReviewContent_fails {
+    ORKConsentDocument *document = [[ORKConsentDocument alloc] init];
+    document.htmlReviewContent = @"<p>some content</p>";
+    
+    NSURL *url = [self temporaryPDFURL];
+    NSError *error = nil;
+    XCTAssertFalse([document writePDFToURL:url error:&error]);
+    XCTAssertEqualObjects(error.domain, ORKErrorDomain);
+    XCTAssertEqual(error.code, ORKErrorInvalidObject);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:url.path]);
+}
+
 @end
@@ -0,0 +1,379 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKit_Private;
+
+#import <CommonCrypto/CommonDigest.h>
+
+
+static NSString *ORKDataLogUploadTestHash(NSData *data) {
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, digest);
+    NSMutableString *hash = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (NSUInteger index = 0; index < CC_SHA256_DIGEST_LENGTH; index++) {
+        [hash appendFormat:@"%02x", digest[index]];
+    }
+    return hash;
+}
+
+static NSData *ORKDataLogUploadTestData(NSUInteger length, NSUInteger seed) {
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    uint8_t *bytes = data.mutableBytes;
+    for (NSUInteger index = 0; index < length; index++) {
+        bytes[index] = (uint8_t)((index * 31 + seed * 7) ^ (index >> 8));
+    }
+    return data;
+}
+
+
+@interface ORKDataLogUploadQueueTests : XCTestCase
+
+@end
+
+
+@implementation ORKDataLogUploadQueueTests {
+    NSURL *_directory;
+    NSURL *_journalURL;
+    ORKDataLoggerManager *_manager;
+    ORKLoopbackDataLogUploadTransport *_transport;
+}
+
+- (void)setUp {
+    [super setUp];
+    _directory = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString] isDirectory:YES];
+    [[NSFileManager defaultManager] createDirectoryAtURL:_directory withIntermediateDirectories:YES attributes:nil error:nil];
+    _journalURL = [_directory URLByAppendingPathComponent:@".ORKDataLogUploadJournal"];
+    _manager = [[ORKDataLoggerManager alloc] initWithDirectory:_directory delegate:nil];
+    [_manager addJSONDataLoggerForLogName:@"test"];
+    _transport = [ORKLoopbackDataLogUploadTransport new];
+}
+
+- (void)tearDown {
+    _manager = nil;
+    _transport = nil;
+    [[NSFileManager defaultManager] removeItemAtURL:_directory error:nil];
+    [super tearDown];
+}
+
+- (NSURL *)writeLogWithIndex:(NSUInteger)index data:(NSData *)data {
+    // Finished logs are named logName-(timestamp)-(count), and upload in name order.
+    NSURL *url = [_directory URLByAppendingPathComponent:[NSString stringWithFormat:@"test-20260101000000-%05lu", (unsigned long)index]];
+    XCTAssertTrue([data writeToURL:url atomically:NO]);
+    return url;
+}
+
+- (ORKDataLogUploadQueue *)makeQueue {
+    ORKDataLogUploadQueue *queue = [[ORKDataLogUploadQueue alloc] initWithDataLoggerManager:_manager
+                                                                                  transport:_transport
+                                                                                 journalURL:_journalURL];
+    queue.chunkSize = 4096;
+    queue.initialRetryInterval = 0.001;
+    queue.maximumRetryInterval = 0.01;
+    return queue;
+}
+
+- (NSUInteger)runQueue:(ORKDataLogUploadQueue *)queue error:(NSError **)errorOut {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"pass"];
+    __block NSUInteger count = 0;
+    __block NSError *error = nil;
+    [queue uploadPendingLogsWithCompletion:^(NSUInteger uploadedLogCount, NSError *passError) {
+        XCTAssertTrue([NSThread isMainThread]);
+        count = uploadedLogCount;
+        error = passError;
+        [expectation fulfill];
+    }];
+    [self waitForExpectations:@[expectation] timeout:60];
+    if (errorOut) {
+        *errorOut = error;
+    }
+    return count;
+}
+
+- (void)testUploadsAndMarksPendingLogs {
+    ORKDataLogger *logger = [_manager dataLoggerForLogName:@"test"];
+    XCTAssertTrue([logger append:@{@"value": @1} error:NULL]);
+    [logger finishCurrentLog];
+    XCTAssertTrue([logger append:@{@"value": @2} error:NULL]);
+    
+    NSMutableArray<NSURL *> *urls = [NSMutableArray array];
+    [logger enumerateLogs:^(NSURL *logFileUrl, BOOL *stop) {
+        [urls addObject:logFileUrl];
+    } error:NULL];
+    [urls addObject:[self writeLogWithIndex:1 data:ORKDataLogUploadTestData(10000, 1)]];
+    [urls addObject:[self writeLogWithIndex:2 data:[NSData data]]];
+    XCTAssertEqual(urls.count, 3);
+    
+    NSError *error = nil;
+    ORKDataLogUploadQueue *queue = [self makeQueue];
+    XCTAssertEqual([self runQueue:queue error:&error], 3);
+    XCTAssertNil(error);
+    XCTAssertFalse(queue.isUploading);
+    
+    for (NSURL *url in urls) {
+        NSData *data = [NSData dataWithContentsOfURL:url];
+        XCTAssertTrue([logger isFileUploadedAtURL:url]);
+        XCTAssertEqualObjects([_transport dataForLogIdentifier:url.lastPathComponent], data);
+        
+        NSDictionary *manifest = [_transport manifestForLogIdentifier:url.lastPathComponent];
+        XCTAssertEqualObjects(manifest[@"sha256"], ORKDataLogUploadTestHash(data));
+        XCTAssertEqualObjects(manifest[@"length"], @(data.length));
+        XCTAssertEqual([manifest[@"chunks"] count], (data.length + 4095) / 4096);
+    }
+    // 1 chunk for the logger's log, 3 for the 10000 byte log, none for the empty one.
+    XCTAssertEqual(_transport.chunkRequestCount, 4);
+    XCTAssertEqual(_transport.finishRequestCount, 3);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:_journalURL.path]);
+    
+    // The current log is never uploaded, and nothing else is pending.
+    XCTAssertEqual([self runQueue:queue error:&error], 0);
+    XCTAssertNil(error);
+    XCTAssertEqual(_transport.chunkRequestCount, 4);
+    XCTAssertEqual(_transport.finishRequestCount, 3);
+}
+
+- (void)testRetriesFailedRequests {
+    [self writeLogWithIndex:0 data:ORKDataLogUploadTestData(10000, 0)];
+    
+    __block NSUInteger requestCount = 0;
+    _transport.requestHandler = ^NSError *(NSString *identifier, NSString *contentHash) {
+        requestCount++;
+        // Fail the first chunk twice and the finish request once.
+        BOOL fails = (requestCount <= 2 || requestCount == 6);
+        return fails ? [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorTimedOut userInfo:nil] : nil;
+    };
+    
+    NSError *error = nil;
+    XCTAssertEqual([self runQueue:[self makeQueue] error:&error], 1);
+    XCTAssertNil(error);
+    XCTAssertEqual(_transport.chunkRequestCount, 5);
+    XCTAssertEqual(_transport.finishRequestCount, 2);
+    XCTAssertEqualObjects([_transport dataForLogIdentifier:@"test-20260101000000-00000"], ORKDataLogUploadTestData(10000, 0));
+}
+
+- (void)testStopsAfterMaximumAttemptCount {
+    NSURL *url = [self writeLogWithIndex:0 data:ORKDataLogUploadTestData(100, 0)];
+    NSError *transportError = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNotConnectedToInternet userInfo:nil];
+    _transport.requestHandler = ^NSError *(NSString *identifier, NSString *contentHash) {
+        return transportError;
+    };
+    
+    ORKDataLogUploadQueue *queue = [self makeQueue];
+    queue.maximumAttemptCount = 3;
+    NSError *error = nil;
+    XCTAssertEqual([self runQueue:queue error:&error], 0);
+    XCTAssertEqualObjects(error, transportError);
+    XCTAssertEqual(_transport.chunkRequestCount, 3);
+    XCTAssertEqual(_transport.finishRequestCount, 0);
+    XCTAssertFalse([[_manager dataLoggerForLogName:@"test"] isFileUploadedAtURL:url]);
+}
+
+- (void)testResumesInterruptedLog {
+    NSData *data = ORKDataLogUploadTestData(10 * 4096, 0);
+    [self writeLogWithIndex:0 data:data];
+    
+    __block NSUInteger requestCount = 0;
+    _transport.requestHandler = ^NSError *(NSString *identifier, NSString *contentHash) {
+        requestCount++;
+        return (requestCount > 4) ? [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNetworkConnectionLost userInfo:nil] : nil;
+    };
+    ORKDataLogUploadQueue *queue = [self makeQueue];
+    queue.maximumAttemptCount = 1;
+    NSError *error = nil;
+    XCTAssertEqual([self runQueue:queue error:&error], 0);
+    XCTAssertEqualObjects(error.domain, NSURLErrorDomain);
+    XCTAssertEqual(_transport.storedChunkCount, 4);
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:_journalURL.path]);
+    
+    // A new queue picks up from the journal, keeping the chunk size the log started with.
+    _transport.requestHandler = nil;
+    queue = [self makeQueue];
+    queue.chunkSize = 1024;
+    XCTAssertEqual([self runQueue:queue error:&error], 1);
+    XCTAssertNil(error);
+    XCTAssertEqual(_transport.chunkRequestCount, 5 + 6);
+    XCTAssertEqual(_transport.storedChunkCount, 10);
+    XCTAssertEqualObjects([_transport dataForLogIdentifier:@"test-20260101000000-00000"], data);
+}
+
+- (void)testMarksCommittedLogFromJournal {
+    NSData *data = ORKDataLogUploadTestData(5000, 0);
+    NSURL *url = [self writeLogWithIndex:0 data:data];
+    
+    // The server committed the log, but the queue stopped before marking it; a record for another log was torn.
+    NSString *journal = [NSString stringWithFormat:@"done\t%@\t%@\nchunk\ttest-20260101000000-00001\t4096\t0", url.lastPathComponent, ORKDataLogUploadTestHash(data)];
+    XCTAssertTrue([journal writeToURL:_journalURL atomically:YES encoding:NSUTF8StringEncoding error:NULL]);
+    
+    NSError *error = nil;
+    XCTAssertEqual([self runQueue:[self makeQueue] error:&error], 1);
+    XCTAssertNil(error);
+    XCTAssertEqual(_transport.chunkRequestCount, 0);
+    XCTAssertEqual(_transport.finishRequestCount, 0);
+    XCTAssertTrue([[_manager dataLoggerForLogName:@"test"] isFileUploadedAtURL:url]);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:_journalURL.path]);
+}
+
+- (void)testResumesAfterCrashBetweenJournalAndMark {
+    NSData *data = ORKDataLogUploadTestData(3 * 4096, 0);
+    NSURL *url = [self writeLogWithIndex:0 data:data];
+    [self writeLogWithIndex:1 data:ORKDataLogUploadTestData(100, 1)];
+    
+    // The first request for the second log sees the journal as the queue left it after committing the
+    // first log; failing it ends the pass there.
+    __block NSData *journal = nil;
+    NSURL *journalURL = _journalURL;
+    NSString *secondChunkHash = ORKDataLogUploadTestHash(ORKDataLogUploadTestData(100, 1));
+    _transport.requestHandler = ^NSError *(NSString *identifier, NSString *contentHash) {
+        if (![contentHash isEqualToString:secondChunkHash]) {
+            return nil;
+        }
+        journal = [NSData dataWithContentsOfURL:journalURL];
+        return [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNetworkConnectionLost userInfo:nil];
+    };
+    ORKDataLogUploadQueue *queue = [self makeQueue];
+    queue.maximumAttemptCount = 1;
+    XCTAssertEqual([self runQueue:queue error:NULL], 1);
+    XCTAssertEqual(_transport.finishRequestCount, 1);
+    XCTAssertNotNil(journal);
+    
+    // Put the files back as a crash between the journal record and the uploaded mark would leave them.
+    XCTAssertTrue([_manager unmarkUploadedFiles:@[url] error:NULL]);
+    XCTAssertTrue([journal writeToURL:_journalURL atomically:YES]);
+    NSString *journalString = [[NSString alloc] initWithData:journal encoding:NSUTF8StringEncoding];
+    NSString *finishedRecord = [NSString stringWithFormat:@"done\t%@\t%@\n", url.lastPathComponent, ORKDataLogUploadTestHash(data)];
+    XCTAssertTrue([journalString containsString:finishedRecord]);
+    
+    _transport.requestHandler = nil;
+    NSUInteger chunkRequestCount = _transport.chunkRequestCount;
+    NSError *error = nil;
+    XCTAssertEqual([self runQueue:[self makeQueue] error:&error], 2);
+    XCTAssertNil(error);
+    XCTAssertTrue([[_manager dataLoggerForLogName:@"test"] isFileUploadedAtURL:url]);
+    XCTAssertEqual(_transport.chunkRequestCount, chunkRequestCount + 1);
+    XCTAssertEqual(_transport.finishRequestCount, 2);
+    XCTAssertEqualObjects(_transport.finishedLogIdentifiers, (@[url.lastPathComponent, @"test-20260101000000-00001"]));
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:_journalURL.path]);
+}
+
+- (void)testUnmarkedLogIsUploadedAgainWithoutStoringChunksTwice {
+    NSURL *url = [self writeLogWithIndex:0 data:ORKDataLogUploadTestData(10000, 0)];
+    ORKDataLogUploadQueue *queue = [self makeQueue];
+    XCTAssertEqual([self runQueue:queue error:NULL], 1);
+    XCTAssertTrue([_manager unmarkUploadedFiles:@[url] error:NULL]);
+    
+    XCTAssertEqual([self runQueue:queue error:NULL], 1);
+    XCTAssertEqual(_transport.chunkRequestCount, 6);
+    XCTAssertEqual(_transport.storedChunkCount, 3);
+    XCTAssertEqual(_transport.finishRequestCount, 2);
+    XCTAssertEqualObjects(_transport.finishedLogIdentifiers, @[url.lastPathComponent]);
+}
+
+- (void)testRemovesUploadedLogs {
+    NSURL *url = [self writeLogWithIndex:0 data:ORKDataLogUploadTestData(100, 0)];
+    ORKDataLogUploadQueue *queue = [self makeQueue];
+    queue.removesUploadedLogs = YES;
+    XCTAssertEqual([self runQueue:queue error:NULL], 1);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:url.path]);
+    XCTAssertNotNil([_transport dataForLogIdentifier:url.lastPathComponent]);
+}
+
+- (void)testCancel {
+    [self writeLogWithIndex:0 data:ORKDataLogUploadTestData(10000, 0)];
+    ORKDataLogUploadQueue *queue = [self makeQueue];
+    __weak ORKDataLogUploadQueue *weakQueue = queue;
+    _transport.requestHandler = ^NSError *(NSString *identifier, NSString *contentHash) {
+        [weakQueue cancel];
+        return nil;
+    };
+    
+    NSError *error = nil;
+    XCTAssertEqual([self runQueue:queue error:&error], 0);
+    XCTAssertEqualObjects(error.domain, NSCocoaErrorDomain);
+    XCTAssertEqual(error.code, NSUserCancelledError);
+    XCTAssertEqual(_transport.finishRequestCount, 0);
+}
+
+- (NSArray<NSURL *> *)writeBenchmarkLogsStartingAtIndex:(NSUInteger)startIndex {
+    NSMutableArray<NSURL *> *urls = [NSMutableArray array];
+    for (NSUInteger index = startIndex; index < startIndex + 2000; index++) {
+        [urls addObject:[self writeLogWithIndex:index data:ORKDataLogUploadTestData(16 * 1024, index)]];
+    }
+    return urls;
+}
+
+- (void)testUploadThroughputPerformance {
+    NSArray<NSURL *> *urls = [self writeBenchmarkLogsStartingAtIndex:0];
+    ORKDataLogUploadQueue *queue = [self makeQueue];
+    queue.chunkSize = 8 * 1024;
+    
+    XCTMeasureOptions *options = [XCTMeasureOptions defaultOptions];
+    options.invocationOptions = XCTMeasurementInvocationManuallyStart | XCTMeasurementInvocationManuallyStop;
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] options:options block:^{
+        [self->_manager unmarkUploadedFiles:urls error:NULL];
+        [self startMeasuring];
+        XCTAssertEqual([self runQueue:queue error:NULL], urls.count);
+        [self stopMeasuring];
+    }];
+}
+
+- (void)testCrashRecoveryPerformance {
+    // A 32 MiB log interrupted halfway through, with 2000 logs queued behind it.
+    [self writeLogWithIndex:0 data:ORKDataLogUploadTestData(32 * 1024 * 1024, 0)];
+    [self writeBenchmarkLogsStartingAtIndex:1];
+    
+    __block NSUInteger requestCount = 0;
+    _transport.requestHandler = ^NSError *(NSString *identifier, NSString *contentHash) {
+        requestCount++;
+        return (requestCount > 256) ? [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNetworkConnectionLost userInfo:nil] : nil;
+    };
+    ORKDataLogUploadQueue *queue = [self makeQueue];
+    queue.chunkSize = 64 * 1024;
+    queue.maximumAttemptCount = 1;
+    [self runQueue:queue error:NULL];
+    XCTAssertEqual(_transport.storedChunkCount, 256);
+    
+    // Measures a relaunch: replaying the journal, enumerating the queue and skipping the acknowledged chunks,
+    // up to the first new request.
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        NSUInteger chunkRequestCount = self->_transport.chunkRequestCount;
+        self->_transport.requestHandler = ^NSError *(NSString *identifier, NSString *contentHash) {
+            return [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNetworkConnectionLost userInfo:nil];
+        };
+        ORKDataLogUploadQueue *relaunchedQueue = [self makeQueue];
+        relaunchedQueue.maximumAttemptCount = 1;
+        NSError *error = nil;
+        XCTAssertEqual([self runQueue:relaunchedQueue error:&error], 0);
+        XCTAssertNotNil(error);
+        XCTAssertEqual(self->_transport.chunkRequestCount, chunkRequestCount + 1);
+    }];
+}
+
+@end
@@ -772,6 +772,41 @@ static NSArray *buttonIdentifierTable(void) {
     return table;
 }
 
+// Tapping samples are converted as a whole array straight from their packed records, producing the same
+// JSON as encoding each ORKTappingSample object.
+static NSArray *tappingSamplesToJSON(NSArray<ORKTappingSample *> *samples) {
+    ORKTappingSampleArray *sampleArray = [ORKTappingSampleArray sampleArrayWithSamples:samples];
+    NSMutableArray *output = [NSMutableArray arrayWithCapacity:sampleArray.count];
+    NSString *className = NSStringFromClass([ORKTappingSample class]);
+    NSArray *buttonTable = buttonIdentifierTable();
+    [sampleArray enumerateRecordsUsingBlock:^(const ORKTappingSampleRecord *record, __unused NSUInteger index, __unused BOOL *stop) {
+        [output addObject:@{ _ClassKey: className,
+                             @"timestamp": @(record->timestamp),
+                             @"duration": @(record->duration),
+                             @"buttonIdentifier": tableMapForward(record->buttonIdentifier, buttonTable),
+                             @"location": dictionaryFromCGPoint(record->location) }];
+    }];
+    return output;
+}
+
+static NSArray<ORKTappingSample *> *tappingSamplesFromJSON(NSArray<NSDictionary *> *array) {
+    NSUInteger count = array.count;
+    ORKTappingSampleRecord *records = calloc(MAX(count, 1), sizeof(ORKTappingSampleRecord));
+    NSArray *buttonTable = buttonIdentifierTable();
+    for (NSUInteger index = 0; index < count; index++) {
+        NSDictionary *dict = array[index];
+        records[index] = (ORKTappingSampleRecord){
+            .timestamp = ((NSNumber *)dict[@"timestamp"]).doubleValue,
+            .duration = ((NSNumber *)dict[@"duration"]).doubleValue,
+            .location = pointFromDictionary(dict[@"location"]),
+            .buttonIdentifier = tableMapReverse(dict[@"buttonIdentifier"], buttonTable)
+        };
+    }
+    ORKTappingSampleArray *samples = [[ORKTappingSampleArray alloc] initWithRecords:records count:count];
+    free(records);
+    return samples;
+}
+
 static NSArray *memoryGameStatusTable(void) {
     static NSArray *table = nil;
     static dispatch_once_t onceToken;
@@ -1572,6 +1607,7 @@ static NSMutableDictionary<NSString *, ORKESerializableTableEntry *> *ORKESerial
                  },
                  (@{
                     PROPERTY(frequency, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(analyzesTremor, NSNumber, NSObject, YES, nil, nil),
                     })),
            ENTRY(ORKdBHLToneAudiometryOnboardingStep,
                  ^id(NSDictionary *dict, ORKESerializationPropertyGetter getter) {
@@ -1981,6 +2017,9 @@ static NSMutableDictionary<NSString *, ORKESerializableTableEntry *> *ORKESerial
                      return [[ORKLocationRecorderConfiguration alloc] initWithIdentifier:GETPROP(dict,identifier)];
                  },
                  (@{
+                    PROPERTY(compressesTrajectory, NSNumber, NSObject, YES, nil, nil),
+                    PROPERTY(trajectoryTolerance, NSNumber, NSObject, YES, nil, nil),
+                    PROPERTY(estimatesWalkingDistance, NSNumber, NSObject, YES, nil, nil),
                     })),
 #endif 
            ENTRY(ORKPedometerRecorderConfiguration,
@@ -2022,7 +2061,9 @@ static NSMutableDictionary<NSString *, ORKESerializableTableEntry *> *ORKESerial
            ENTRY(ORKTappingIntervalResult,
                  nil,
                  (@{
-                    PROPERTY(samples, ORKTappingSample, NSArray, NO, nil, nil),
+                    PROPERTY(samples, NSArray, NSObject, NO,
+                             ^id(id samples, __unused ORKESerializationContext *context) { return tappingSamplesToJSON(samples); },
+                             ^id(id array, __unused ORKESerializationContext *context) { return tappingSamplesFromJSON(array); }),
                     PROPERTY(stepViewSize, NSValue, NSObject, NO,
                              ^id(id value, __unused ORKESerializationContext *context) { return value?dictionaryFromCGSize(((NSValue *)value).CGSizeValue):nil; },
                              ^id(id dict, __unused ORKESerializationContext *context) { return [NSValue valueWithCGSize:sizeFromDictionary(dict)]; }),
@@ -2085,6 +2126,27 @@ static NSMutableDictionary<NSString *, ORKESerializableTableEntry *> *ORKESerial
                     PROPERTY(contentType, NSString, NSObject, NO, nil, nil),
                     PROPERTY(fileName, NSString, NSObject, NO, nil, nil)
                     })),
+           ENTRY(ORKRandomSeedResult,
+                 nil,
+                 (@{
+                    PROPERTY(seed, NSNumber, NSObject, NO, nil, nil),
+                    })),
+           ENTRY(ORKTimelineAlignmentResult,
+                 nil,
+                 (@{
+                    PROPERTY(streamAlignments, ORKTimelineStreamAlignment, NSArray, NO, nil, nil),
+                    })),
+           ENTRY(ORKTimelineStreamAlignment,
+                 nil,
+                 (@{
+                    PROPERTY(identifier, NSString, NSObject, NO, nil, nil),
+                    PROPERTY(timebase, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(referenceStreamTime, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(referenceSystemUptime, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(rate, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(sampleCount, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(residual, NSNumber, NSObject, NO, nil, nil),
+                    })),
            ENTRY(ORKToneAudiometrySample,
                  nil,
                  (@{
@@ -2163,6 +2225,39 @@ static NSMutableDictionary<NSString *, ORKESerializableTableEntry *> *ORKESerial
                     PROPERTY(timeLimit, NSNumber, NSObject, NO, nil, nil),
                     PROPERTY(duration, NSNumber, NSObject, NO, nil, nil),
                     })),
+           ENTRY(ORKGaitResult,
+                 nil,
+                 (@{
+                    PROPERTY(numberOfSteps, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(cadence, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(stepRegularity, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(strideRegularity, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(gaitSymmetry, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(duration, NSNumber, NSObject, NO, nil, nil),
+                    })),
+           ENTRY(ORKTremorResult,
+                 nil,
+                 (@{
+                    PROPERTY(accelerationDominantFrequency, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(accelerationLowBandPower, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(accelerationHighBandPower, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(accelerationHarmonicRatio, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(rotationRateDominantFrequency, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(rotationRateLowBandPower, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(rotationRateHighBandPower, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(rotationRateHarmonicRatio, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(duration, NSNumber, NSObject, NO, nil, nil),
+                    })),
+           ENTRY(ORKWalkingDistanceResult,
+                 nil,
+                 (@{
+                    PROPERTY(distance, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(averagePace, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(locationGapFraction, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(stepLength, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(numberOfSteps, NSNumber, NSObject, NO, nil, nil),
+                    PROPERTY(duration, NSNumber, NSObject, NO, nil, nil),
+                    })),
            ENTRY(ORKPSATSample,
                  nil,
                  (@{
@@ -2198,6 +2293,10 @@ static NSMutableDictionary<NSString *, ORKESerializableTableEntry *> *ORKESerial
                  (@{
                     PROPERTY(puzzleWasSolved, NSNumber, NSObject, YES, nil, nil),
                     PROPERTY(moves, ORKTowerOfHanoiMove, NSArray, YES, nil, nil),
+                    PROPERTY(minimumNumberOfMoves, NSNumber, NSObject, YES, nil, nil),
+                    PROPERTY(excessMoveCount, NSNumber, NSObject, YES, nil, nil),
+                    PROPERTY(regressionMoveCount, NSNumber, NSObject, YES, nil, nil),
+                    PROPERTY(planningLatency, NSNumber, NSObject, YES, nil, nil),
                     })),
            ENTRY(ORKTowerOfHanoiMove,
                  nil,
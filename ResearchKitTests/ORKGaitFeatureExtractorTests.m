@@ -0,0 +1,181 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKit_Private;
+@import ResearchKitActiveTask;
+@import ResearchKitActiveTask_Private;
+
+
+static const double SamplingFrequency = 100.0;
+static const double StepFrequency = 1.8;
+
+typedef void (^ORKGaitSampleHandler)(NSTimeInterval timestamp, double x, double y, double z);
+
+// Vertical bounce at the step frequency, a weaker stride component at half of it, and a small
+// amount of deterministic noise, on top of gravity.
+static void ORKGenerateWalk(NSTimeInterval duration, ORKGaitSampleHandler handler) {
+    srand48(42);
+    const NSUInteger count = (NSUInteger)(duration * SamplingFrequency);
+    for (NSUInteger index = 0; index < count; index++) {
+        const NSTimeInterval t = index / SamplingFrequency;
+        const double magnitude = (1.0 +
+                                  (0.3 * sin(2 * M_PI * StepFrequency * t)) +
+                                  (0.08 * sin(M_PI * StepFrequency * t)) +
+                                  (0.01 * ((2 * drand48()) - 1)));
+        handler(t, 0.1 * magnitude, 0.2 * magnitude, sqrt(0.95) * magnitude);
+    }
+}
+
+
+@interface ORKGaitFeatureExtractorTests : XCTestCase
+
+@end
+
+
+@implementation ORKGaitFeatureExtractorTests
+
+- (NSURL *)writeLogWithItems:(NSArray<NSDictionary *> *)items {
+    NSURL *URL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    NSData *data = [NSJSONSerialization dataWithJSONObject:@{ @"items": items } options:0 error:nil];
+    [data writeToURL:URL atomically:YES];
+    [self addTeardownBlock:^{
+        [[NSFileManager defaultManager] removeItemAtURL:URL error:nil];
+    }];
+    return URL;
+}
+
+- (void)testSyntheticWalk {
+    ORKGaitFeatureExtractor *extractor = [[ORKGaitFeatureExtractor alloc] initWithFrequency:SamplingFrequency];
+    ORKGenerateWalk(30.0, ^(NSTimeInterval timestamp, double x, double y, double z) {
+        [extractor appendAccelerationWithTimestamp:timestamp x:x y:y z:z];
+    });
+    ORKGaitResult *result = [extractor resultWithIdentifier:@"accelerometer.gait"];
+    
+    XCTAssertEqualObjects(result.identifier, @"accelerometer.gait");
+    XCTAssertEqual(extractor.sampleCount, 3000);
+    XCTAssertEqualWithAccuracy(result.numberOfSteps, 30.0 * StepFrequency, 1);
+    XCTAssertEqualWithAccuracy(result.cadence, 60.0 * StepFrequency, 2.0);
+    XCTAssertEqualWithAccuracy(result.duration, 29.99, 0.001);
+    XCTAssertGreaterThan(result.stepRegularity, 0.7);
+    XCTAssertGreaterThan(result.strideRegularity, 0.7);
+    XCTAssertGreaterThan(result.gaitSymmetry, 0.0);
+}
+
+- (void)testStandingStillDetectsNoSteps {
+    ORKGaitFeatureExtractor *extractor = [[ORKGaitFeatureExtractor alloc] initWithFrequency:SamplingFrequency];
+    srand48(7);
+    for (NSUInteger index = 0; index < 3000; index++) {
+        [extractor appendAccelerationWithTimestamp:index / SamplingFrequency x:0 y:0 z:1.0 + (0.005 * ((2 * drand48()) - 1))];
+    }
+    ORKGaitResult *result = [extractor resultWithIdentifier:@"gait"];
+    
+    XCTAssertEqual(result.numberOfSteps, 0);
+    XCTAssertEqual(result.cadence, 0.0);
+}
+
+- (void)testReset {
+    ORKGaitFeatureExtractor *extractor = [[ORKGaitFeatureExtractor alloc] initWithFrequency:SamplingFrequency];
+    ORKGenerateWalk(10.0, ^(NSTimeInterval timestamp, double x, double y, double z) {
+        [extractor appendAccelerationWithTimestamp:timestamp x:x y:y z:z];
+    });
+    XCTAssertGreaterThan(extractor.numberOfSteps, 0);
+    
+    [extractor reset];
+    XCTAssertEqual(extractor.sampleCount, 0);
+    XCTAssertEqual(extractor.numberOfSteps, 0);
+    XCTAssertEqual([extractor resultWithIdentifier:@"gait"].stepRegularity, 0.0);
+}
+
+- (void)testReplayOfAccelerometerLog {
+    ORKGaitFeatureExtractor *streamingExtractor = [[ORKGaitFeatureExtractor alloc] initWithFrequency:SamplingFrequency];
+    NSMutableArray<NSDictionary *> *items = [NSMutableArray new];
+    ORKGenerateWalk(20.0, ^(NSTimeInterval timestamp, double x, double y, double z) {
+        [streamingExtractor appendAccelerationWithTimestamp:timestamp x:x y:y z:z];
+        [items addObject:@{ @"timestamp": @(timestamp), @"x": @(x), @"y": @(y), @"z": @(z) }];
+    });
+    
+    ORKGaitFeatureExtractor *replayExtractor = [[ORKGaitFeatureExtractor alloc] initWithFrequency:SamplingFrequency];
+    NSError *error = nil;
+    XCTAssertTrue([replayExtractor replayJSONLogAtURL:[self writeLogWithItems:items] error:&error]);
+    XCTAssertNil(error);
+    
+    ORKGaitResult *streamingResult = [streamingExtractor resultWithIdentifier:@"gait"];
+    ORKGaitResult *replayResult = [replayExtractor resultWithIdentifier:@"gait"];
+    XCTAssertEqual(replayResult.numberOfSteps, streamingResult.numberOfSteps);
+    XCTAssertEqualWithAccuracy(replayResult.cadence, streamingResult.cadence, 1e-6);
+    XCTAssertEqualWithAccuracy(replayResult.stepRegularity, streamingResult.stepRegularity, 1e-6);
+}
+
+- (void)testReplayOfDeviceMotionLog {
+    NSMutableArray<NSDictionary *> *items = [NSMutableArray new];
+    ORKGenerateWalk(20.0, ^(NSTimeInterval timestamp, double x, double y, double z) {
+        // Device motion logs carry user acceleration, with gravity removed.
+        [items addObject:@{ @"timestamp": @(timestamp),
+                            @"gravity": @{ @"x": @(0.1), @"y": @(0.2), @"z": @(sqrt(0.95)) },
+                            @"userAcceleration": @{ @"x": @(x - 0.1), @"y": @(y - 0.2), @"z": @(z - sqrt(0.95)) } }];
+    });
+    
+    ORKGaitFeatureExtractor *extractor = [[ORKGaitFeatureExtractor alloc] initWithFrequency:SamplingFrequency];
+    XCTAssertTrue([extractor replayJSONLogAtURL:[self writeLogWithItems:items] error:nil]);
+    XCTAssertEqualWithAccuracy([extractor resultWithIdentifier:@"gait"].cadence, 60.0 * StepFrequency, 2.0);
+}
+
+- (void)testReplayOfMalformedLog {
+    NSURL *URL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    [[@"[1, 2, 3]" dataUsingEncoding:NSUTF8StringEncoding] writeToURL:URL atomically:YES];
+    
+    ORKGaitFeatureExtractor *extractor = [[ORKGaitFeatureExtractor alloc] initWithFrequency:SamplingFrequency];
+    NSError *error = nil;
+    XCTAssertFalse([extractor replayJSONLogAtURL:URL error:&error]);
+    XCTAssertEqual(error.code, NSFileReadCorruptFileError);
+    [[NSFileManager defaultManager] removeItemAtURL:URL error:nil];
+}
+
+- (void)testStreamingPerformance {
+    // Ten minutes of accelerometer data at 100 Hz.
+    const NSUInteger count = 60000;
+    double *samples = malloc(count * sizeof(double));
+    for (NSUInteger index = 0; index < count; index++) {
+        samples[index] = 1.0 + (0.3 * sin(2 * M_PI * StepFrequency * (index / SamplingFrequency)));
+    }
+    
+    [self measureBlock:^{
+        ORKGaitFeatureExtractor *extractor = [[ORKGaitFeatureExtractor alloc] initWithFrequency:SamplingFrequency];
+        for (NSUInteger index = 0; index < count; index++) {
+            [extractor appendAccelerationWithTimestamp:index / SamplingFrequency x:0 y:0 z:samples[index]];
+        }
+        [extractor resultWithIdentifier:@"gait"];
+    }];
+    free(samples);
+}
+
+@end
@@ -592,6 +592,7 @@ ORK_MAKE_TEST_INIT(ORKAccuracyStroopStep, (^{ return [[ORKAccuracyStroopStep all
                                           @"ORKScaleAnswerFormat.numberFormatter",
                                           @"ORKSignatureResult.signatureImage",
                                           @"ORKSignatureResult.signaturePath",
+                                          @"ORKSignatureResult.strokeSamples",
                                           @"ORKSpatialSpanMemoryStep.customTargetImage",
                                           @"ORKStep.allowsBackNavigation",
                                           @"ORKStep.auxiliaryImage",
@@ -666,6 +667,8 @@ ORK_MAKE_TEST_INIT(ORKAccuracyStroopStep, (^{ return [[ORKAccuracyStroopStep all
         @"ORKBlurFooterView",
         @"ORKFrontFacingCameraStepOptionsView",
         @"ORKNoAnswer",
+        @"ORKTappingSampleArray",
+        @"ORKLazyStepArray",
         @"ORKTouchAbilityTouch",
         @"ORKTouchAbilityTouch",
         @"ORKTouchAbilityTrack",
@@ -1339,6 +1342,8 @@ ORKESerializationPropertyInjector *ORKSerializationTestPropertyInjector(void) {
                                  [ORKSkipStepNavigationRule class],     // abstract base class
                                  [ORKFormItemVisibilityRule class],     // abstract base class
                                  [ORKStepModifier class],     // abstract base class
+                                 [ORKTappingSampleArray class],     // NSArray subclass, archived as a plain array
+                                 [ORKLazyStepArray class],          // NSArray subclass, archived as a plain array
                                  [ORKVideoCaptureStep class],
                                  [ORKImageCaptureStep class]
                                  ];
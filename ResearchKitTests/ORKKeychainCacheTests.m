@@ -0,0 +1,194 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKit_Private;
+
+#import <Security/Security.h>
+
+
+static const NSUInteger ORKKeychainCacheBenchmarkReadCount = 10000;
+
+static NSDictionary *ORKKeychainCacheTestPasscode(void) {
+    return @{@"passcode": @"123456", @"touchIdEnabled": @YES};
+}
+
+
+@interface ORKKeychainCacheTests : XCTestCase
+
+@end
+
+
+@implementation ORKKeychainCacheTests {
+    ORKInMemorySecureStorageBackend *_backend;
+    ORKKeychainCache *_cache;
+}
+
+- (void)setUp {
+    [super setUp];
+    _backend = [ORKInMemorySecureStorageBackend new];
+    _cache = [[ORKKeychainCache alloc] initWithBackend:_backend];
+}
+
+- (void)testReadsAreServedFromCacheAfterFirstLookup {
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:ORKKeychainCacheTestPasscode() requiringSecureCoding:YES error:NULL];
+    XCTAssertTrue([_backend applyChanges:@{@"passcode": data} error:NULL]);
+    
+    NSError *error = nil;
+    for (NSUInteger index = 0; index < 5; index++) {
+        XCTAssertEqualObjects((NSDictionary *)[_cache objectForKey:@"passcode" error:&error], ORKKeychainCacheTestPasscode());
+        XCTAssertNil(error);
+    }
+    XCTAssertEqual(_backend.readCount, 1);
+    
+    [_cache invalidateObjectForKey:@"passcode"];
+    XCTAssertNotNil([_cache objectForKey:@"passcode" error:NULL]);
+    XCTAssertEqual(_backend.readCount, 2);
+}
+
+- (void)testMissingKeyIsNotCached {
+    NSError *error = nil;
+    XCTAssertNil([_cache objectForKey:@"missing" error:&error]);
+    XCTAssertEqualObjects(error.domain, NSOSStatusErrorDomain);
+    XCTAssertEqual(error.code, errSecItemNotFound);
+    
+    error = nil;
+    XCTAssertNil([_cache objectForKey:@"missing" error:&error]);
+    XCTAssertEqual(error.code, errSecItemNotFound);
+    XCTAssertEqual(_backend.readCount, 2);
+    
+    // An item added behind the cache's back, as another process would, is found on the next read.
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:@"value" requiringSecureCoding:YES error:NULL];
+    XCTAssertTrue([_backend applyChanges:@{@"missing": data} error:NULL]);
+    error = nil;
+    XCTAssertEqualObjects((NSString *)[_cache objectForKey:@"missing" error:&error], @"value");
+    XCTAssertNil(error);
+}
+
+- (void)testWritesUpdateCacheAndBackend {
+    NSError *error = nil;
+    XCTAssertTrue([_cache setObject:@"value" forKey:@"key" error:&error]);
+    XCTAssertNil(error);
+    XCTAssertEqualObjects((NSString *)[_cache objectForKey:@"key" error:NULL], @"value");
+    XCTAssertEqual(_backend.readCount, 0);
+    XCTAssertNotNil([_backend dataForKey:@"key" error:NULL]);
+    
+    XCTAssertTrue([_cache removeObjectForKey:@"key" error:&error]);
+    XCTAssertNil([_cache objectForKey:@"key" error:&error]);
+    XCTAssertEqual(error.code, errSecItemNotFound);
+}
+
+- (void)testBatchCoalescesChangesIntoOneBackendWrite {
+    BOOL success = [_cache performBatchUpdates:^(ORKKeychainWriteBatch *batch) {
+        [batch setObject:@"first" forKey:@"a"];
+        [batch setObject:@"second" forKey:@"a"];
+        [batch setObject:@(2) forKey:@"b"];
+        [batch setObject:@"removed" forKey:@"c"];
+        [batch removeObjectForKey:@"c"];
+    } error:NULL];
+    XCTAssertTrue(success);
+    XCTAssertEqual(_backend.writeCount, 1);
+    XCTAssertEqualObjects((NSString *)[_cache objectForKey:@"a" error:NULL], @"second");
+    XCTAssertEqualObjects((NSNumber *)[_cache objectForKey:@"b" error:NULL], @(2));
+    XCTAssertNil([_cache objectForKey:@"c" error:NULL]);
+    
+    XCTAssertTrue([_cache performBatchUpdates:^(__unused ORKKeychainWriteBatch *batch) {} error:NULL]);
+    XCTAssertEqual(_backend.writeCount, 1);
+}
+
+- (void)testFailedWriteInvalidatesCachedValues {
+    XCTAssertTrue([_cache setObject:@"old" forKey:@"key" error:NULL]);
+    
+    NSError *writeError = [NSError errorWithDomain:NSOSStatusErrorDomain code:errSecInteractionNotAllowed userInfo:nil];
+    _backend.writeError = writeError;
+    NSError *error = nil;
+    XCTAssertFalse([_cache setObject:@"new" forKey:@"key" error:&error]);
+    XCTAssertEqualObjects(error, writeError);
+    
+    NSUInteger readCount = _backend.readCount;
+    XCTAssertEqualObjects((NSString *)[_cache objectForKey:@"key" error:NULL], @"old");
+    XCTAssertEqual(_backend.readCount, readCount + 1);
+}
+
+- (void)testBackgroundPurgesCache {
+    XCTAssertTrue([_cache setObject:@"value" forKey:@"key" error:NULL]);
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationDidEnterBackgroundNotification object:nil];
+    
+    XCTAssertEqualObjects((NSString *)[_cache objectForKey:@"key" error:NULL], @"value");
+    XCTAssertEqual(_backend.readCount, 1);
+}
+
+- (void)testRemoveAllObjects {
+    XCTAssertTrue([_cache setObject:@"value" forKey:@"key" error:NULL]);
+    XCTAssertTrue([_cache removeAllObjectsWithError:NULL]);
+    NSError *error = nil;
+    XCTAssertNil([_cache objectForKey:@"key" error:&error]);
+    XCTAssertEqual(error.code, errSecItemNotFound);
+}
+
+#pragma mark - Benchmarks
+
+- (void)testCachedReadPerformance {
+    XCTAssertTrue([_cache setObject:ORKKeychainCacheTestPasscode() forKey:@"passcode" error:NULL]);
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        for (NSUInteger index = 0; index < ORKKeychainCacheBenchmarkReadCount; index++) {
+            @autoreleasepool {
+                XCTAssertNotNil([self->_cache objectForKey:@"passcode" error:NULL]);
+            }
+        }
+    }];
+}
+
+- (void)testUncachedReadPerformance {
+    // Every read goes to the backend, as ORKKeychainWrapper did before the cache. The in-memory backend
+    // leaves out the keychain round trip itself, so this only bounds the saving from below.
+    XCTAssertTrue([_cache setObject:ORKKeychainCacheTestPasscode() forKey:@"passcode" error:NULL]);
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        for (NSUInteger index = 0; index < ORKKeychainCacheBenchmarkReadCount; index++) {
+            @autoreleasepool {
+                [self->_cache invalidateObjectForKey:@"passcode"];
+                XCTAssertNotNil([self->_cache objectForKey:@"passcode" error:NULL]);
+            }
+        }
+    }];
+}
+
+- (void)testBatchedWritePerformance {
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        [self->_cache performBatchUpdates:^(ORKKeychainWriteBatch *batch) {
+            for (NSUInteger index = 0; index < 100; index++) {
+                [batch setObject:@(index) forKey:[NSString stringWithFormat:@"key%lu", (unsigned long)index]];
+            }
+        } error:NULL];
+    }];
+}
+
+@end
@@ -0,0 +1,294 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKit_Private;
+
+#import <CommonCrypto/CommonDigest.h>
+
+
+static NSString *ORKMediaArtifactTestHash(NSData *data) {
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, digest);
+    NSMutableString *hash = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (NSUInteger index = 0; index < CC_SHA256_DIGEST_LENGTH; index++) {
+        [hash appendFormat:@"%02x", digest[index]];
+    }
+    return hash;
+}
+
+static NSData *ORKMediaArtifactTestData(NSUInteger length) {
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    uint8_t *bytes = data.mutableBytes;
+    for (NSUInteger index = 0; index < length; index++) {
+        bytes[index] = (uint8_t)((index * 31) ^ (index >> 8));
+    }
+    return data;
+}
+
+
+@interface ORKMediaArtifactStoreTests : XCTestCase
+
+@end
+
+
+@implementation ORKMediaArtifactStoreTests {
+    NSURL *_directoryURL;
+    NSURL *_sourceDirectoryURL;
+}
+
+- (void)setUp {
+    [super setUp];
+    NSURL *rootURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString] isDirectory:YES];
+    _directoryURL = [rootURL URLByAppendingPathComponent:@"store" isDirectory:YES];
+    _sourceDirectoryURL = [rootURL URLByAppendingPathComponent:@"source" isDirectory:YES];
+    [[NSFileManager defaultManager] createDirectoryAtURL:_sourceDirectoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtURL:_directoryURL.URLByDeletingLastPathComponent error:nil];
+    [super tearDown];
+}
+
+- (NSURL *)sourceFileWithData:(NSData *)data {
+    NSURL *sourceURL = [_sourceDirectoryURL URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    XCTAssertTrue([data writeToURL:sourceURL atomically:NO]);
+    return sourceURL;
+}
+
+- (ORKMediaArtifactStore *)store {
+    ORKMediaArtifactStore *store = [[ORKMediaArtifactStore alloc] initWithDirectoryURL:_directoryURL
+                                                                   fileProtectionMode:ORKFileProtectionCompleteUnlessOpen];
+    store.chunkSize = 1000;
+    store.bufferSize = 4096;
+    return store;
+}
+
+- (void)assertArtifact:(ORKMediaArtifact *)artifact matchesData:(NSData *)data {
+    XCTAssertNotNil(artifact);
+    XCTAssertEqualObjects([NSData dataWithContentsOfURL:artifact.fileURL], data);
+    XCTAssertEqual(artifact.length, data.length);
+    XCTAssertNotNil([artifact computeManifestWithError:NULL]);
+    XCTAssertEqualObjects(artifact.contentHash, ORKMediaArtifactTestHash(data));
+    
+    XCTAssertEqual(artifact.chunks.count, (data.length + artifact.chunkSize - 1) / artifact.chunkSize);
+    for (ORKMediaArtifactChunk *chunk in artifact.chunks) {
+        NSData *chunkData = [data subdataWithRange:NSMakeRange((NSUInteger)chunk.offset, (NSUInteger)chunk.length)];
+        XCTAssertEqualObjects(chunk.contentHash, ORKMediaArtifactTestHash(chunkData));
+    }
+}
+
+- (void)testMovingIngestRenamesSource {
+    NSData *data = ORKMediaArtifactTestData(10500);
+    NSURL *sourceURL = [self sourceFileWithData:data];
+    
+    NSError *error = nil;
+    ORKMediaArtifact *artifact = [[self store] ingestFileAtURL:sourceURL fileName:@"video.mov" options:ORKMediaArtifactIngestOptionMoveSource error:&error];
+    XCTAssertNil(error);
+    // A renamed file is not read back until its manifest is needed.
+    XCTAssertNil(artifact.contentHash);
+    XCTAssertNil(artifact.chunks);
+    [self assertArtifact:artifact matchesData:data];
+    XCTAssertEqual(artifact.ingestMethod, ORKMediaArtifactIngestMethodRename);
+    XCTAssertEqualObjects(artifact.fileURL.lastPathComponent, @"video.mov");
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:sourceURL.path]);
+}
+
+- (void)testCopyingIngestKeepsSource {
+    NSData *data = ORKMediaArtifactTestData(2500);
+    NSURL *sourceURL = [self sourceFileWithData:data];
+    
+    ORKMediaArtifact *artifact = [[self store] ingestFileAtURL:sourceURL fileName:@"video.mov" options:0 error:NULL];
+    [self assertArtifact:artifact matchesData:data];
+    XCTAssertNotEqual(artifact.ingestMethod, ORKMediaArtifactIngestMethodRename);
+    XCTAssertEqualObjects([NSData dataWithContentsOfURL:sourceURL], data);
+}
+
+- (void)testStreamingCopy {
+    NSData *data = ORKMediaArtifactTestData(40000);
+    NSURL *sourceURL = [self sourceFileWithData:data];
+    
+    ORKMediaArtifact *artifact = [[self store] ingestFileAtURL:sourceURL
+                                                      fileName:@"video.mov"
+                                                       options:ORKMediaArtifactIngestOptionStreamingCopy | ORKMediaArtifactIngestOptionMoveSource
+                                                         error:NULL];
+    // The copy pass digests the file as it goes.
+    XCTAssertEqualObjects(artifact.contentHash, ORKMediaArtifactTestHash(data));
+    [self assertArtifact:artifact matchesData:data];
+    XCTAssertEqual(artifact.ingestMethod, ORKMediaArtifactIngestMethodStreamingCopy);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:sourceURL.path]);
+    
+    // No partial copy is left behind.
+    NSArray *contents = [[NSFileManager defaultManager] contentsOfDirectoryAtPath:_directoryURL.path error:NULL];
+    XCTAssertEqualObjects(contents, @[@"video.mov"]);
+}
+
+- (void)testIngestReplacesExistingArtifact {
+    ORKMediaArtifactStore *store = [self store];
+    [store writeData:ORKMediaArtifactTestData(5000) fileName:@"image.jpeg" error:NULL];
+    
+    NSData *data = ORKMediaArtifactTestData(100);
+    ORKMediaArtifact *artifact = [store ingestFileAtURL:[self sourceFileWithData:data] fileName:@"image.jpeg" options:0 error:NULL];
+    [self assertArtifact:artifact matchesData:data];
+    NSArray *contents = [[NSFileManager defaultManager] contentsOfDirectoryAtPath:_directoryURL.path error:NULL];
+    XCTAssertEqualObjects(contents, @[@"image.jpeg"]);
+}
+
+- (void)testFailedIngestKeepsExistingArtifact {
+    ORKMediaArtifactStore *store = [self store];
+    NSData *data = ORKMediaArtifactTestData(5000);
+    [store writeData:data fileName:@"image.jpeg" error:NULL];
+    
+    NSURL *sourceURL = [_sourceDirectoryURL URLByAppendingPathComponent:@"missing.jpeg"];
+    for (NSNumber *options in @[@(0), @(ORKMediaArtifactIngestOptionMoveSource), @(ORKMediaArtifactIngestOptionStreamingCopy)]) {
+        NSError *error = nil;
+        XCTAssertNil([store ingestFileAtURL:sourceURL fileName:@"image.jpeg" options:options.unsignedIntegerValue error:&error]);
+        XCTAssertEqual(error.code, ENOENT);
+        XCTAssertEqualObjects([NSData dataWithContentsOfURL:[_directoryURL URLByAppendingPathComponent:@"image.jpeg"]], data);
+    }
+    NSArray *contents = [[NSFileManager defaultManager] contentsOfDirectoryAtPath:_directoryURL.path error:NULL];
+    XCTAssertEqualObjects(contents, @[@"image.jpeg"]);
+}
+
+- (void)testWriteAndAdopt {
+    NSData *data = ORKMediaArtifactTestData(3000);
+    ORKMediaArtifactStore *store = [self store];
+    ORKMediaArtifact *written = [store writeData:data fileName:@"image.jpeg" error:NULL];
+    [self assertArtifact:written matchesData:data];
+    XCTAssertEqual(written.ingestMethod, ORKMediaArtifactIngestMethodWrite);
+    XCTAssertEqual(written.chunks.count, 3);
+    
+    ORKMediaArtifact *adopted = [store adoptFileAtURL:written.fileURL error:NULL];
+    [self assertArtifact:adopted matchesData:data];
+    XCTAssertEqual(adopted.ingestMethod, ORKMediaArtifactIngestMethodAdopt);
+}
+
+- (void)testEmptyFile {
+    NSData *data = [NSData data];
+    ORKMediaArtifact *artifact = [[self store] ingestFileAtURL:[self sourceFileWithData:data] fileName:@"empty" options:ORKMediaArtifactIngestOptionStreamingCopy error:NULL];
+    [self assertArtifact:artifact matchesData:data];
+    XCTAssertEqual(artifact.chunks.count, 0);
+}
+
+- (void)testManifestOfRemovedFileFails {
+    ORKMediaArtifact *artifact = [[self store] writeData:ORKMediaArtifactTestData(100) fileName:@"image.jpeg" error:NULL];
+    XCTAssertTrue([[NSFileManager defaultManager] removeItemAtURL:artifact.fileURL error:NULL]);
+    
+    NSError *error = nil;
+    XCTAssertNil([artifact computeManifestWithError:&error]);
+    XCTAssertEqualObjects(error.domain, NSPOSIXErrorDomain);
+    XCTAssertEqual(error.code, ENOENT);
+}
+
+- (void)testMissingSourceFails {
+    NSError *error = nil;
+    NSURL *sourceURL = [_sourceDirectoryURL URLByAppendingPathComponent:@"missing.mov"];
+    ORKMediaArtifact *artifact = [[self store] ingestFileAtURL:sourceURL fileName:@"video.mov" options:ORKMediaArtifactIngestOptionMoveSource error:&error];
+    XCTAssertNil(artifact);
+    XCTAssertEqualObjects(error.domain, NSPOSIXErrorDomain);
+    XCTAssertEqual(error.code, ENOENT);
+}
+
+- (void)testManifest {
+    NSData *data = ORKMediaArtifactTestData(2500);
+    ORKMediaArtifact *artifact = [[self store] writeData:data fileName:@"image.jpeg" error:NULL];
+    NSDictionary *manifest = [artifact computeManifestWithError:NULL];
+    XCTAssertTrue([NSJSONSerialization isValidJSONObject:manifest]);
+    XCTAssertEqualObjects(manifest[@"fileName"], @"image.jpeg");
+    XCTAssertEqualObjects(manifest[@"length"], @2500);
+    XCTAssertEqualObjects(manifest[@"sha256"], ORKMediaArtifactTestHash(data));
+    NSArray *chunks = manifest[@"chunks"];
+    XCTAssertEqual(chunks.count, 3);
+    XCTAssertEqualObjects(chunks[2][@"offset"], @2000);
+    XCTAssertEqualObjects(chunks[2][@"length"], @500);
+}
+
+#pragma mark Benchmarks
+
+// Set ORK_MEDIA_ARTIFACT_BENCHMARK_MEGABYTES to benchmark multi-gigabyte recordings, such as 4096.
+- (unsigned long long)benchmarkFileLength {
+    NSString *megabytes = NSProcessInfo.processInfo.environment[@"ORK_MEDIA_ARTIFACT_BENCHMARK_MEGABYTES"];
+    return (megabytes.longLongValue > 0 ? megabytes.longLongValue : 256) * 1024 * 1024;
+}
+
+- (NSURL *)benchmarkSourceFile {
+    // Fill the file with real blocks rather than a sparse hole, so reads hit the disk.
+    NSURL *sourceURL = [_sourceDirectoryURL URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    [[NSFileManager defaultManager] createFileAtPath:sourceURL.path contents:nil attributes:nil];
+    NSFileHandle *handle = [NSFileHandle fileHandleForWritingToURL:sourceURL error:NULL];
+    NSData *block = ORKMediaArtifactTestData(8 * 1024 * 1024);
+    for (unsigned long long written = 0; written < [self benchmarkFileLength]; written += block.length) {
+        [handle writeData:block];
+    }
+    [handle closeFile];
+    return sourceURL;
+}
+
+- (void)measureIngestWithOptions:(ORKMediaArtifactIngestOptions)options {
+    NSURL *sourceURL = [self benchmarkSourceFile];
+    ORKMediaArtifactStore *store = [[ORKMediaArtifactStore alloc] initWithDirectoryURL:_directoryURL
+                                                                   fileProtectionMode:ORKFileProtectionCompleteUnlessOpen];
+    __block NSURL *currentURL = sourceURL;
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        ORKMediaArtifact *artifact = [store ingestFileAtURL:currentURL fileName:[NSUUID UUID].UUIDString options:options error:NULL];
+        XCTAssertEqual(artifact.length, [self benchmarkFileLength]);
+        if (options & ORKMediaArtifactIngestOptionMoveSource) {
+            currentURL = artifact.fileURL;
+        } else {
+            [[NSFileManager defaultManager] removeItemAtURL:artifact.fileURL error:NULL];
+        }
+    }];
+}
+
+- (void)testIngestByRenamePerformance {
+    [self measureIngestWithOptions:ORKMediaArtifactIngestOptionMoveSource];
+}
+
+- (void)testIngestByClonePerformance {
+    [self measureIngestWithOptions:0];
+}
+
+- (void)testIngestByStreamingCopyPerformance {
+    [self measureIngestWithOptions:ORKMediaArtifactIngestOptionStreamingCopy];
+}
+
+- (void)testReadAndWriteWholeFilePerformance {
+    // The approach the camera steps used before the store, for comparison.
+    NSURL *sourceURL = [self benchmarkSourceFile];
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        NSURL *destinationURL = [self->_sourceDirectoryURL URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+        NSData *data = [NSData dataWithContentsOfURL:sourceURL];
+        [data writeToURL:destinationURL atomically:YES];
+        [[NSFileManager defaultManager] removeItemAtURL:destinationURL error:NULL];
+    }];
+}
+
+@end
@@ -0,0 +1,403 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import CoreMotion;
+@import ResearchKit_Private;
+
+
+// Three weeks of activity with a new activity every 1 to 30 seconds. Most activities repeat the
+// state before them, as CoreMotion's do.
+static NSData *ORKMotionActivitySamples(NSDate *endDate, NSTimeInterval duration, long seed) {
+    srand48(seed);
+    NSMutableData *data = [NSMutableData data];
+    ORKMotionActivitySample sample = { floor(endDate.timeIntervalSince1970) - duration, ORKMotionActivityStateStationary, ORKMotionActivityConfidenceHigh };
+    while (sample.startTime < endDate.timeIntervalSince1970 - 1) {
+        [data appendBytes:&sample length:sizeof(sample)];
+        sample.startTime += 1 + floor(drand48() * 30);
+        if (drand48() < 0.2) {
+            static const ORKMotionActivityStates states[] = { ORKMotionActivityStateStationary, ORKMotionActivityStateWalking, ORKMotionActivityStateRunning, ORKMotionActivityStateAutomotive, ORKMotionActivityStateUnknown | ORKMotionActivityStateStationary };
+            sample.states = states[(size_t)(drand48() * 5)];
+        }
+        if (drand48() < 0.1) {
+            sample.confidence = (ORKMotionActivityConfidence)(drand48() * 3);
+        }
+    }
+    return data;
+}
+
+static size_t ORKCoalescedSampleCount(const ORKMotionActivitySample *samples, size_t count) {
+    size_t coalescedCount = 0;
+    for (size_t index = 0; index < count; index++) {
+        if (index == 0 || !ORKMotionActivitySampleHasSameState(samples[index], samples[index - 1])) {
+            coalescedCount++;
+        }
+    }
+    return coalescedCount;
+}
+
+
+@interface ORKMockMotionActivity : CMMotionActivity
+
+- (instancetype)initWithSample:(ORKMotionActivitySample)sample;
+
+@end
+
+
+@implementation ORKMockMotionActivity {
+    ORKMotionActivitySample _sample;
+}
+
+- (instancetype)initWithSample:(ORKMotionActivitySample)sample {
+    self = [super init];
+    if (self) {
+        _sample = sample;
+    }
+    return self;
+}
+
+- (NSDate *)startDate {
+    return [NSDate dateWithTimeIntervalSince1970:_sample.startTime];
+}
+
+- (CMMotionActivityConfidence)confidence {
+    return (CMMotionActivityConfidence)_sample.confidence;
+}
+
+- (BOOL)unknown {
+    return (_sample.states & ORKMotionActivityStateUnknown) != 0;
+}
+
+- (BOOL)stationary {
+    return (_sample.states & ORKMotionActivityStateStationary) != 0;
+}
+
+- (BOOL)walking {
+    return (_sample.states & ORKMotionActivityStateWalking) != 0;
+}
+
+- (BOOL)running {
+    return (_sample.states & ORKMotionActivityStateRunning) != 0;
+}
+
+- (BOOL)automotive {
+    return (_sample.states & ORKMotionActivityStateAutomotive) != 0;
+}
+
+- (BOOL)cycling {
+    return NO;
+}
+
+@end
+
+
+// Answers queries from a fixed list of activities, like CoreMotion: the activities that start in
+// the queried range, preceded by the activity in progress at its start.
+@interface ORKMockMotionActivitySource : NSObject <ORKMotionActivitySource>
+
+- (instancetype)initWithSamples:(NSData *)samples;
+
+@property (nonatomic, readonly) NSUInteger queryCount;
+@property (nonatomic, readonly) NSUInteger maximumResultCount;
+
+@end
+
+
+@implementation ORKMockMotionActivitySource {
+    NSData *_samples;
+}
+
+- (instancetype)initWithSamples:(NSData *)samples {
+    self = [super init];
+    if (self) {
+        _samples = samples;
+    }
+    return self;
+}
+
+- (void)queryActivityStartingFromDate:(NSDate *)start toDate:(NSDate *)end toQueue:(NSOperationQueue *)queue withHandler:(CMMotionActivityQueryHandler)handler {
+    const ORKMotionActivitySample *samples = _samples.bytes;
+    const size_t count = _samples.length / sizeof(ORKMotionActivitySample);
+    const NSTimeInterval startTime = start.timeIntervalSince1970;
+    const NSTimeInterval endTime = end.timeIntervalSince1970;
+    
+    size_t lower = 0;
+    size_t upper = count;
+    while (lower < upper) {
+        const size_t middle = lower + ((upper - lower) / 2);
+        if (samples[middle].startTime < startTime) {
+            lower = middle + 1;
+        } else {
+            upper = middle;
+        }
+    }
+    NSMutableArray<CMMotionActivity *> *activities = [NSMutableArray array];
+    if (lower > 0) {
+        [activities addObject:[[ORKMockMotionActivity alloc] initWithSample:samples[lower - 1]]];
+    }
+    for (size_t index = lower; index < count && samples[index].startTime < endTime; index++) {
+        [activities addObject:[[ORKMockMotionActivity alloc] initWithSample:samples[index]]];
+    }
+    
+    _queryCount++;
+    _maximumResultCount = MAX(_maximumResultCount, activities.count);
+    [queue addOperationWithBlock:^{
+        handler(activities, nil);
+    }];
+}
+
+@end
+
+
+@interface ORKMotionActivityCollectionTests : XCTestCase <ORKDataCollectionManagerDelegate>
+
+@end
+
+
+@implementation ORKMotionActivityCollectionTests {
+    XCTestExpectation *_completionExpectation;
+    NSMutableArray<CMMotionActivity *> *_collectedActivities;
+    NSUInteger _deliveryCount;
+    NSUInteger _serializedLength;
+    BOOL _acceptDelivery;
+    BOOL _serializesDelivery;
+    NSError *_error;
+}
+
+- (void)setUp {
+    [super setUp];
+    _collectedActivities = [NSMutableArray array];
+    _deliveryCount = 0;
+    _serializedLength = 0;
+    _acceptDelivery = YES;
+    _serializesDelivery = NO;
+    _error = nil;
+}
+
+- (ORKDataCollectionManager *)managerWithSource:(id<ORKMotionActivitySource>)source startDate:(NSDate *)startDate collector:(ORKMotionActivityCollector **)collector {
+    NSURL *URL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    [self addTeardownBlock:^{
+        [[NSFileManager defaultManager] removeItemAtURL:URL error:nil];
+    }];
+    ORKDataCollectionManager *manager = [[ORKDataCollectionManager alloc] initWithPersistenceDirectoryURL:URL];
+    manager.motionActivitySource = source;
+    manager.delegate = self;
+    ORKMotionActivityCollector *motionCollector = [manager addMotionActivityCollectorWithStartDate:startDate error:nil];
+    if (collector) {
+        *collector = motionCollector;
+    }
+    return manager;
+}
+
+- (void)collectWithManager:(ORKDataCollectionManager *)manager {
+    _completionExpectation = [self expectationWithDescription:@"Expectation for collection completion"];
+    [manager startCollection];
+    [self waitForExpectationsWithTimeout:60.0 handler:nil];
+}
+
+#pragma mark - Encoding
+
+- (void)testEncoderMatchesDictionarySerialization {
+    NSDate *endDate = [NSDate date];
+    NSData *samples = ORKMotionActivitySamples(endDate, 6 * 60 * 60, 1);
+    NSMutableArray<CMMotionActivity *> *activities = [NSMutableArray array];
+    for (size_t index = 0; index < samples.length / sizeof(ORKMotionActivitySample); index++) {
+        [activities addObject:[[ORKMockMotionActivity alloc] initWithSample:((const ORKMotionActivitySample *)samples.bytes)[index]]];
+    }
+    
+    ORKMotionActivityCollector *collector = nil;
+    [self managerWithSource:[[ORKMockMotionActivitySource alloc] initWithSamples:samples] startDate:endDate collector:&collector];
+    NSData *data = [collector serializedDataForObjects:activities];
+    NSDictionary *output = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+    NSArray<NSDictionary *> *dictionaries = [collector serializableObjectsForObjects:activities];
+    
+    XCTAssertNotNil(output);
+    XCTAssertEqualObjects(output[@"items"], dictionaries);
+    XCTAssertEqual(dictionaries.count, ORKCoalescedSampleCount(samples.bytes, activities.count));
+    XCTAssertLessThan(dictionaries.count, activities.count / 2);
+    XCTAssertEqualObjects(dictionaries.firstObject, [activities.firstObject ork_JSONDictionary]);
+}
+
+- (void)testEncoderCoalescesRepeatedStates {
+    ORKMotionActivityEncoder *encoder = ORKMotionActivityEncoderCreate();
+    const ORKMotionActivitySample samples[] = {
+        { 1700000000, ORKMotionActivityStateStationary, ORKMotionActivityConfidenceHigh },
+        { 1700000010, ORKMotionActivityStateStationary, ORKMotionActivityConfidenceHigh },
+        { 1700000020, ORKMotionActivityStateStationary, ORKMotionActivityConfidenceLow },
+        { 1700000030, ORKMotionActivityStateWalking | ORKMotionActivityStateUnknown, ORKMotionActivityConfidenceLow },
+        { 1700000040, ORKMotionActivityStateWalking | ORKMotionActivityStateUnknown, ORKMotionActivityConfidenceLow },
+    };
+    const BOOL written[] = { YES, NO, YES, YES, NO };
+    for (size_t index = 0; index < 5; index++) {
+        XCTAssertEqual(ORKMotionActivityEncoderAppend(encoder, samples[index]), written[index]);
+    }
+    XCTAssertEqual(ORKMotionActivityEncoderItemCount(encoder), 3);
+    XCTAssertEqual(ORKMotionActivityEncoderCoalescedCount(encoder), 2);
+    
+    size_t length = 0;
+    const uint8_t *bytes = ORKMotionActivityEncoderFinish(encoder, &length);
+    NSDictionary *output = [NSJSONSerialization JSONObjectWithData:[NSData dataWithBytes:bytes length:length] options:0 error:nil];
+    NSArray *items = output[@"items"];
+    XCTAssertEqual(items.count, 3);
+    XCTAssertEqualObjects(items[2][@"activity"], (@[@"unknown", @"walking"]));
+    XCTAssertEqualObjects(items[2][@"confidence"], @"low");
+    XCTAssertEqualObjects(items[2][@"startDate"], ORKStringFromDateISO8601([NSDate dateWithTimeIntervalSince1970:1700000030]));
+    
+    ORKMotionActivityEncoderReset(encoder);
+    bytes = ORKMotionActivityEncoderFinish(encoder, &length);
+    XCTAssertEqualObjects([[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding], @"{\"items\":[]}");
+    ORKMotionActivityEncoderDestroy(encoder);
+}
+
+- (void)testWindowDurationFollowsDensity {
+    const ORKMotionActivityWindowPolicy policy = { .minimumDuration = 900, .maximumDuration = 604800, .targetCount = 2000 };
+    XCTAssertEqualWithAccuracy(ORKMotionActivityNextWindowDuration(policy, 21600, 1000), 43200, 1e-9);
+    XCTAssertEqualWithAccuracy(ORKMotionActivityNextWindowDuration(policy, 21600, 8000), 5400, 1e-9);
+    // The duration changes by at most a factor of 4 per window.
+    XCTAssertEqualWithAccuracy(ORKMotionActivityNextWindowDuration(policy, 21600, 0), 86400, 1e-9);
+    XCTAssertEqualWithAccuracy(ORKMotionActivityNextWindowDuration(policy, 21600, 1000000), 5400, 1e-9);
+    // The duration stays within the policy's bounds.
+    XCTAssertEqualWithAccuracy(ORKMotionActivityNextWindowDuration(policy, 1000, 100000), 900, 1e-9);
+    XCTAssertEqualWithAccuracy(ORKMotionActivityNextWindowDuration(policy, 500000, 1), 604800, 1e-9);
+}
+
+#pragma mark - Collection
+
+- (void)testMultiWeekBackfillIsCollectedInWindows {
+    NSDate *endDate = [NSDate date];
+    const NSTimeInterval duration = 21 * 24 * 60 * 60;
+    NSData *samples = ORKMotionActivitySamples(endDate, duration, 2);
+    const size_t sampleCount = samples.length / sizeof(ORKMotionActivitySample);
+    ORKMockMotionActivitySource *source = [[ORKMockMotionActivitySource alloc] initWithSamples:samples];
+    ORKMotionActivityCollector *collector = nil;
+    ORKDataCollectionManager *manager = [self managerWithSource:source startDate:[endDate dateByAddingTimeInterval:-duration] collector:&collector];
+    
+    [self collectWithManager:manager];
+    
+    XCTAssertNil(_error);
+    XCTAssertEqual(_collectedActivities.count, ORKCoalescedSampleCount(samples.bytes, sampleCount));
+    for (NSUInteger index = 1; index < _collectedActivities.count; index++) {
+        XCTAssertEqual([_collectedActivities[index - 1].startDate compare:_collectedActivities[index].startDate], NSOrderedAscending);
+        XCTAssertFalse([_collectedActivities[index] ork_hasSameStateAsActivity:_collectedActivities[index - 1]]);
+    }
+    
+    // No window returns many more activities than the target.
+    XCTAssertGreaterThan(source.queryCount, 10);
+    XCTAssertLessThan(source.maximumResultCount, 4 * manager.motionActivityWindowPolicy.targetCount);
+    XCTAssertGreaterThan(_deliveryCount, 1);
+    XCTAssertNotNil(((ORKMotionActivityCollector *)manager.collectors.firstObject).lastDate);
+    
+    // A second collection delivers only what is new.
+    [_collectedActivities removeAllObjects];
+    [self collectWithManager:manager];
+    XCTAssertNil(_error);
+    XCTAssertEqual(_collectedActivities.count, 0);
+}
+
+- (void)testRejectedDeliveryIsCollectedAgain {
+    NSDate *endDate = [NSDate date];
+    const NSTimeInterval duration = 2 * 24 * 60 * 60;
+    NSData *samples = ORKMotionActivitySamples(endDate, duration, 3);
+    ORKDataCollectionManager *manager = [self managerWithSource:[[ORKMockMotionActivitySource alloc] initWithSamples:samples]
+                                                      startDate:[endDate dateByAddingTimeInterval:-duration]
+                                                      collector:nil];
+    
+    _acceptDelivery = NO;
+    [self collectWithManager:manager];
+    XCTAssertEqual(_deliveryCount, 0);
+    XCTAssertNil(((ORKMotionActivityCollector *)manager.collectors.firstObject).lastDate);
+    
+    _acceptDelivery = YES;
+    _error = nil;
+    [_collectedActivities removeAllObjects];
+    [self collectWithManager:manager];
+    XCTAssertNil(_error);
+    XCTAssertEqual(_collectedActivities.count, ORKCoalescedSampleCount(samples.bytes, samples.length / sizeof(ORKMotionActivitySample)));
+}
+
+#pragma mark - Benchmarks
+
+- (void)testMultiWeekBackfillThroughput {
+    NSDate *endDate = [NSDate date];
+    const NSTimeInterval duration = 21 * 24 * 60 * 60;
+    NSData *samples = ORKMotionActivitySamples(endDate, duration, 4);
+    
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        ORKDataCollectionManager *manager = [self managerWithSource:[[ORKMockMotionActivitySource alloc] initWithSamples:samples]
+                                                          startDate:[endDate dateByAddingTimeInterval:-duration]
+                                                          collector:nil];
+        self->_serializesDelivery = YES;
+        [self collectWithManager:manager];
+    }];
+    XCTAssertGreaterThan(_serializedLength, 0);
+}
+
+- (void)testEncoderThroughput {
+    // A million activities, about two months of dense activity.
+    NSData *samples = ORKMotionActivitySamples([NSDate date], 60 * 24 * 60 * 60, 5);
+    const ORKMotionActivitySample *bytes = samples.bytes;
+    const size_t count = samples.length / sizeof(ORKMotionActivitySample);
+    
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        ORKMotionActivityEncoder *encoder = ORKMotionActivityEncoderCreate();
+        for (size_t index = 0; index < count; index++) {
+            ORKMotionActivityEncoderAppend(encoder, bytes[index]);
+        }
+        size_t length = 0;
+        XCTAssertNotEqual(ORKMotionActivityEncoderFinish(encoder, &length), NULL);
+        ORKMotionActivityEncoderDestroy(encoder);
+    }];
+}
+
+#pragma mark - ORKDataCollectionManagerDelegate
+
+- (BOOL)motionActivityCollector:(ORKMotionActivityCollector *)collector didCollectMotionActivities:(NSArray<CMMotionActivity *> *)motionActivities {
+    if (!_acceptDelivery) {
+        return NO;
+    }
+    _deliveryCount++;
+    if (_serializesDelivery) {
+        _serializedLength += [collector serializedDataForObjects:motionActivities].length;
+    } else {
+        [_collectedActivities addObjectsFromArray:motionActivities];
+    }
+    return YES;
+}
+
+- (void)dataCollectionManagerDidCompleteCollection:(ORKDataCollectionManager *)manager {
+    [_completionExpectation fulfill];
+}
+
+- (void)collector:(ORKCollector *)collector didDetectError:(NSError *)error {
+    _error = error;
+}
+
+@end
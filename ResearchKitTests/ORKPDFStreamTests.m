@@ -0,0 +1,282 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKit;
+@import ResearchKit_Private;
+
+#import "ORKConsentPDFComposer.h"
+#import "ORKPDFStream.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+static const size_t ORKPDFStreamBenchmarkPageCount = 500;
+
+// The output of -writeSmallDocumentToFileDescriptor:. Any change to it must still open in Preview
+// and pass a strict PDF parser.
+static const char ORKPDFStreamGoldenDocument[] =
+    "%PDF-1.4\n"
+    "%\342\343\317\323\n"
+    "1 0 obj\n"
+    "<< /Type /Catalog /Pages 2 0 R >>\n"
+    "endobj\n"
+    "3 0 obj\n"
+    "<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica /Encoding /WinAnsiEncoding >>\n"
+    "endobj\n"
+    "4 0 obj\n"
+    "<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica-Bold /Encoding /WinAnsiEncoding >>\n"
+    "endobj\n"
+    "5 0 obj\n"
+    "<< /Type /XObject /Subtype /Image /Width 4 /Height 2 /ColorSpace /DeviceGray /BitsPerComponent 8 /Filter /RunLengthDecode /Length 6 0 R >>\n"
+    "stream\n"
+    "\375\377\376\000\000\200\200\n"
+    "endstream\n"
+    "endobj\n"
+    "6 0 obj\n"
+    "7\n"
+    "endobj\n"
+    "8 0 obj\n"
+    "<< /Length 118 >>\n"
+    "stream\n"
+    "BT /F2 12 Tf 10 80 Td (Hello \\(world\\) \\351) Tj ET\n"
+    "0.5 w 10 50 m 190 50 l S\n"
+    "q 20 0 0 10 10 55 cm /Im5 Do Q\n"
+    "/Footer Do\n"
+    "\n"
+    "endstream\n"
+    "endobj\n"
+    "9 0 obj\n"
+    "<< /Type /Page /Parent 2 0 R /MediaBox [0 0 200 100] /Resources << /Font << /F1 3 0 R /F2 4 0 R >> /XObject << /Im5 5 0 R /Footer 7 0 R >> >> /Contents 8 0 R >>\n"
+    "endobj\n"
+    "7 0 obj\n"
+    "<< /Type /XObject /Subtype /Form /BBox [0 0 200 100] /Resources << /Font << /F1 3 0 R /F2 4 0 R >> >> /Length 38 >>\n"
+    "stream\n"
+    "BT /F1 12 Tf 88.32 26 Td (1 / 1) Tj ET\n"
+    "endstream\n"
+    "endobj\n"
+    "2 0 obj\n"
+    "<< /Type /Pages /Kids [9 0 R] /Count 1 >>\n"
+    "endobj\n"
+    "xref\n"
+    "0 10\n"
+    "0000000000 65535 f \n"
+    "0000000015 00000 n \n"
+    "0000000991 00000 n \n"
+    "0000000064 00000 n \n"
+    "0000000161 00000 n \n"
+    "0000000263 00000 n \n"
+    "0000000442 00000 n \n"
+    "0000000804 00000 n \n"
+    "0000000459 00000 n \n"
+    "0000000628 00000 n \n"
+    "trailer\n"
+    "<< /Size 10 /Root 1 0 R >>\n"
+    "startxref\n"
+    "1048\n"
+    "%%EOF\n";
+
+
+@interface ORKPDFStreamTests : XCTestCase
+
+@end
+
+
+@implementation ORKPDFStreamTests
+
+static size_t ORKPDFStreamTestFooter(void *context, size_t pageIndex, size_t pageCount, uint8_t *buffer, size_t capacity) {
+    int length = snprintf((char *)buffer, capacity, "%zu / %zu", pageIndex + 1, pageCount);
+    return MIN((size_t)MAX(length, 0), capacity);
+}
+
+- (NSURL *)temporaryPDFURL {
+    NSString *name = [[NSUUID UUID].UUIDString stringByAppendingPathExtension:@"pdf"];
+    NSURL *url = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:name]];
+    [self addTeardownBlock:^{
+        [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+    }];
+    return url;
+}
+
+- (NSData *)dataWrittenByBlock:(void (^)(int fileDescriptor))block {
+    NSURL *url = [self temporaryPDFURL];
+    int fileDescriptor = open(url.fileSystemRepresentation, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    XCTAssertGreaterThanOrEqual(fileDescriptor, 0);
+    block(fileDescriptor);
+    close(fileDescriptor);
+    return [NSData dataWithContentsOfURL:url];
+}
+
+- (void)writeSmallDocumentToFileDescriptor:(int)fileDescriptor {
+    ORKPDFStream *stream = ORKPDFStreamCreate(fileDescriptor);
+    ORKPDFStreamSetFooter(stream, ORKPDFStreamTestFooter, NULL, ORKPDFFontHelvetica, 12, 26);
+    ORKPDFStreamBeginPage(stream, 200, 100);
+    const uint8_t text[] = "Hello (world) \xE9";
+    ORKPDFStreamShowText(stream, ORKPDFFontHelveticaBold, 12, 10, 80, text, sizeof(text) - 1);
+    ORKPDFStreamStrokeLine(stream, 10, 50, 190, 50, 0.5);
+    const uint8_t pixels[] = { 255, 255, 255, 255, 0, 0, 0, 128 };
+    ORKPDFStreamDrawGrayImage(stream, pixels, 4, 2, 10, 55, 20, 10);
+    ORKPDFStreamEndPage(stream);
+    XCTAssertTrue(ORKPDFStreamFinish(stream));
+    XCTAssertEqual(ORKPDFStreamError(stream), 0);
+    XCTAssertEqual(ORKPDFStreamPageCount(stream), 1);
+    XCTAssertEqual(ORKPDFStreamBytesWritten(stream), (uint64_t)(sizeof(ORKPDFStreamGoldenDocument) - 1));
+    ORKPDFStreamDestroy(stream);
+}
+
+// Checks that every in-use entry of the cross-reference table gives the offset of its object.
+- (void)assertCrossReferenceTableOfData:(NSData *)data {
+    NSString *pdf = [[NSString alloc] initWithData:data encoding:NSISOLatin1StringEncoding];
+    NSRange startRange = [pdf rangeOfString:@"startxref\n" options:NSBackwardsSearch];
+    XCTAssertNotEqual(startRange.location, NSNotFound);
+    NSUInteger tableOffset = (NSUInteger)[pdf substringFromIndex:NSMaxRange(startRange)].integerValue;
+    XCTAssertTrue([[pdf substringFromIndex:tableOffset] hasPrefix:@"xref\n0 "]);
+    
+    NSScanner *scanner = [NSScanner scannerWithString:[pdf substringFromIndex:tableOffset + 7]];
+    NSInteger count = 0;
+    XCTAssertTrue([scanner scanInteger:&count]);
+    for (NSInteger object = 0; object < count; object++) {
+        long long offset = 0;
+        NSInteger generation = 0;
+        NSString *type = nil;
+        XCTAssertTrue([scanner scanLongLong:&offset]);
+        XCTAssertTrue([scanner scanInteger:&generation]);
+        XCTAssertTrue([scanner scanCharactersFromSet:[NSCharacterSet lowercaseLetterCharacterSet] intoString:&type]);
+        if ([type isEqualToString:@"n"]) {
+            NSString *header = [NSString stringWithFormat:@"%ld 0 obj\n", (long)object];
+            XCTAssertTrue([[pdf substringFromIndex:(NSUInteger)offset] hasPrefix:header], @"%@", header);
+        }
+    }
+}
+
+- (void)testFinish_writesGoldenDocument {
+    NSData *data = [self dataWrittenByBlock:^(int fileDescriptor) {
+        [self writeSmallDocumentToFileDescriptor:fileDescriptor];
+    }];
+    NSData *golden = [NSData dataWithBytes:ORKPDFStreamGoldenDocument length:sizeof(ORKPDFStreamGoldenDocument) - 1];
+    XCTAssertEqualObjects(data, golden);
+    [self assertCrossReferenceTableOfData:data];
+}
+
+- (void)testFinish_withManyPages_writesCrossReferenceTable {
+    NSData *data = [self dataWrittenByBlock:^(int fileDescriptor) {
+        ORKPDFStream *stream = ORKPDFStreamCreate(fileDescriptor);
+        ORKPDFStreamSetFooter(stream, ORKPDFStreamTestFooter, NULL, ORKPDFFontHelvetica, 10, 20);
+        const uint8_t pixels[] = { 0, 64, 128, 255 };
+        for (NSUInteger page = 0; page < 5; page++) {
+            ORKPDFStreamBeginPage(stream, 612, 792);
+            ORKPDFStreamShowText(stream, ORKPDFFontHelvetica, 12, 18, 700, (const uint8_t *)"page", 4);
+            if (page % 2 == 0) {
+                ORKPDFStreamDrawGrayImage(stream, pixels, 2, 2, 18, 600, 40, 40);
+            }
+            ORKPDFStreamEndPage(stream);
+        }
+        XCTAssertTrue(ORKPDFStreamFinish(stream));
+        ORKPDFStreamDestroy(stream);
+    }];
+    [self assertCrossReferenceTableOfData:data];
+}
+
+- (void)testWrite_toInvalidFileDescriptor_failsForEveryLaterCall {
+    ORKPDFStream *stream = ORKPDFStreamCreate(-1);
+    // The header is buffered, so the failure shows once the buffer is flushed.
+    ORKPDFStreamBeginPage(stream, 200, 100);
+    ORKPDFStreamEndPage(stream);
+    XCTAssertFalse(ORKPDFStreamFinish(stream));
+    XCTAssertEqual(ORKPDFStreamError(stream), EBADF);
+    XCTAssertFalse(ORKPDFStreamBeginPage(stream, 200, 100));
+    XCTAssertEqual(ORKPDFStreamError(stream), EBADF);
+    ORKPDFStreamDestroy(stream);
+}
+
+- (void)testFontTextWidth_usesHelveticaMetrics {
+    XCTAssertEqualWithAccuracy(ORKPDFFontTextWidth(ORKPDFFontHelvetica, 12, (const uint8_t *)"Hello", 5), 27.34, 0.001);
+    XCTAssertGreaterThan(ORKPDFFontTextWidth(ORKPDFFontHelveticaBold, 12, (const uint8_t *)"Hello", 5), 27.34);
+}
+
+- (void)testComposer_breaksPagesAndNumbersThem {
+    __block NSUInteger numberOfPages = 0;
+    NSData *data = [self dataWrittenByBlock:^(int fileDescriptor) {
+        ORKConsentPDFComposer *composer = [[ORKConsentPDFComposer alloc] initWithFileDescriptor:fileDescriptor pageWidth:612 pageHeight:792];
+        composer.pageNumberFormat = @"Page %1$ld of %2$ld";
+        [composer addHeading:@"Title" level:3];
+        for (NSUInteger paragraph = 0; paragraph < 100; paragraph++) {
+            [composer addParagraph:@"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua."];
+        }
+        [composer addPageBreak];
+        [composer addPageBreak];
+        ORKConsentPDFSignatureField *field = [[ORKConsentPDFSignatureField alloc] initWithCaption:@"Date" text:@"2/2/15"];
+        [composer addSignatureFields:@[field, field, field, field]];
+        NSError *error = nil;
+        XCTAssertTrue([composer finishWithError:&error]);
+        XCTAssertNil(error);
+        numberOfPages = composer.numberOfPages;
+    }];
+    
+    // 100 two-line paragraphs fill six Letter pages, and the signature rows start a seventh
+    // however many breaks come before them.
+    XCTAssertEqual(numberOfPages, 7);
+    NSString *pdf = [[NSString alloc] initWithData:data encoding:NSISOLatin1StringEncoding];
+    XCTAssertTrue([pdf containsString:@"(Page 1 of 7)"]);
+    XCTAssertTrue([pdf containsString:@"(Page 7 of 7)"]);
+    [self assertCrossReferenceTableOfData:data];
+}
+
+- (void)testPerformance_write500Pages {
+    const char *line = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt";
+    size_t lineLength = strlen(line);
+    NSMutableData *pixels = [NSMutableData dataWithLength:600 * 200];
+    memset(pixels.mutableBytes, 255, pixels.length);
+    NSURL *url = [self temporaryPDFURL];
+    
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        int fileDescriptor = open(url.fileSystemRepresentation, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        ORKPDFStream *stream = ORKPDFStreamCreate(fileDescriptor);
+        ORKPDFStreamSetFooter(stream, ORKPDFStreamTestFooter, NULL, ORKPDFFontHelvetica, 12, 26);
+        for (size_t page = 0; page < ORKPDFStreamBenchmarkPageCount; page++) {
+            ORKPDFStreamBeginPage(stream, 612, 792);
+            for (size_t row = 0; row < 50; row++) {
+                ORKPDFStreamShowText(stream, ORKPDFFontHelvetica, 12, 18, 749 - row * 14.4, (const uint8_t *)line, lineLength);
+            }
+            if (page % 10 == 9) {
+                ORKPDFStreamDrawGrayImage(stream, pixels.bytes, 600, 200, 18, 100, 180, 60);
+            }
+            ORKPDFStreamEndPage(stream);
+        }
+        XCTAssertTrue(ORKPDFStreamFinish(stream));
+        XCTAssertEqual(ORKPDFStreamPageCount(stream), ORKPDFStreamBenchmarkPageCount);
+        ORKPDFStreamDestroy(stream);
+        close(fileDescriptor);
+    }];
+}
+
+@end
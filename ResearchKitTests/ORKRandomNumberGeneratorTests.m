@@ -0,0 +1,135 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKit;
+
+
+static const NSUInteger ORKRandomNumberGeneratorBenchmarkDrawCount = 1000000;
+
+
+@interface ORKRandomNumberGeneratorTests : XCTestCase
+
+@end
+
+
+@implementation ORKRandomNumberGeneratorTests
+
+- (void)testKnownSequence {
+    // xoshiro256** with its state expanded from the seed by SplitMix64.
+    ORKRandomNumberGenerator *generator = [[ORKRandomNumberGenerator alloc] initWithSeed:0];
+    XCTAssertEqual([generator nextUInt64], 0x99ec5f36cb75f2b4ULL);
+    XCTAssertEqual([generator nextUInt64], 0xbf6e1f784956452aULL);
+    XCTAssertEqual([generator nextUInt64], 0x1a5f849d4933e6e0ULL);
+    XCTAssertEqual([generator nextUInt64], 0x6aa594f1262d2d2cULL);
+    
+    generator = [[ORKRandomNumberGenerator alloc] initWithSeed:42];
+    XCTAssertEqual(generator.seed, 42);
+    XCTAssertEqual([generator nextUInt64], 0x15780b2e0c2ec716ULL);
+    XCTAssertEqual([generator nextUInt64], 0x6104d9866d113a7eULL);
+}
+
+- (void)testSameSeedGivesSameSequence {
+    ORKRandomNumberGenerator *first = [ORKRandomNumberGenerator new];
+    ORKRandomNumberGenerator *second = [[ORKRandomNumberGenerator alloc] initWithSeed:first.seed];
+    for (NSUInteger index = 0; index < 1000; index++) {
+        XCTAssertEqual([first uniformIntegerLessThan:97], [second uniformIntegerLessThan:97]);
+    }
+    
+    ORKRandomNumberGenerator *copy = [first copy];
+    XCTAssertEqual(copy.seed, first.seed);
+    XCTAssertEqual([copy nextUInt64], [first nextUInt64]);
+}
+
+- (void)testBoundedValuesStayInRange {
+    ORKRandomNumberGenerator *generator = [[ORKRandomNumberGenerator alloc] initWithSeed:7];
+    XCTAssertEqual([generator uniformIntegerLessThan:0], 0);
+    XCTAssertEqual([generator uniformIntegerLessThan:1], 0);
+    
+    NSUInteger counts[6] = {0};
+    for (NSUInteger index = 0; index < 60000; index++) {
+        uint32_t value = [generator uniformIntegerLessThan:6];
+        XCTAssertLessThan(value, 6);
+        counts[value]++;
+        
+        double fraction = [generator uniformDouble];
+        XCTAssertGreaterThanOrEqual(fraction, 0);
+        XCTAssertLessThan(fraction, 1);
+    }
+    for (NSUInteger value = 0; value < 6; value++) {
+        XCTAssertEqualWithAccuracy(counts[value], 10000, 500);
+    }
+}
+
+- (void)testShuffleIsAPermutationAndRepeatable {
+    NSArray<NSNumber *> *values = @[@0, @1, @2, @3, @4, @5, @6, @7, @8, @9];
+    NSMutableArray<NSNumber *> *first = [values mutableCopy];
+    NSMutableArray<NSNumber *> *second = [values mutableCopy];
+    [[[ORKRandomNumberGenerator alloc] initWithSeed:1234] shuffleArray:first];
+    [[[ORKRandomNumberGenerator alloc] initWithSeed:1234] shuffleArray:second];
+    
+    XCTAssertEqualObjects(first, second);
+    XCTAssertEqualObjects([first sortedArrayUsingSelector:@selector(compare:)], values);
+}
+
+- (void)testSeedResultRoundTrips {
+    ORKRandomSeedResult *result = [[ORKRandomSeedResult alloc] initWithIdentifier:@"randomSeed"];
+    result.seed = UINT64_MAX - 1;
+    
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:result requiringSecureCoding:YES error:NULL];
+    ORKRandomSeedResult *decoded = [NSKeyedUnarchiver unarchivedObjectOfClass:[ORKRandomSeedResult class] fromData:data error:NULL];
+    XCTAssertEqualObjects(decoded, result);
+    XCTAssertEqual(decoded.seed, UINT64_MAX - 1);
+    XCTAssertEqualObjects([result copy], result);
+}
+
+- (void)testBoundedDrawPerformance {
+    ORKRandomNumberGenerator *generator = [[ORKRandomNumberGenerator alloc] initWithSeed:1];
+    [self measureWithMetrics:@[[XCTClockMetric new]] block:^{
+        uint64_t sum = 0;
+        for (NSUInteger index = 0; index < ORKRandomNumberGeneratorBenchmarkDrawCount; index++) {
+            sum += [generator uniformIntegerLessThan:1000];
+        }
+        XCTAssertGreaterThan(sum, 0);
+    }];
+}
+
+- (void)testArc4RandomBoundedDrawPerformance {
+    [self measureWithMetrics:@[[XCTClockMetric new]] block:^{
+        uint64_t sum = 0;
+        for (NSUInteger index = 0; index < ORKRandomNumberGeneratorBenchmarkDrawCount; index++) {
+            sum += arc4random_uniform(1000);
+        }
+        XCTAssertGreaterThan(sum, 0);
+    }];
+}
+
+@end
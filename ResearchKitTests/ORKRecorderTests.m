@@ -469,6 +469,55 @@ static const NSInteger kNumberOfSamples = 5;
         XCTAssertTrue(ork_doubleEqual(longitude, ((NSNumber *)sample[@"coordinate"][@"longitude"]).doubleValue), @"");
     }
 }
+
+- (void)testCompressedLocationRecorder {
+    ORKLocationRecorderConfiguration *configuration = [[ORKLocationRecorderConfiguration alloc] initWithIdentifier:@"location"];
+    configuration.compressesTrajectory = YES;
+    configuration.trajectoryTolerance = 5.0;
+    ORKLocationRecorder *recorder = (ORKLocationRecorder *)[self createRecorder:configuration];
+    XCTAssertTrue(recorder.compressesTrajectory);
+    XCTAssertEqual(recorder.trajectoryTolerance, 5.0);
+    
+    recorder = [[ORKMockLocationRecorder alloc] initWithIdentifier:@"location"
+                                                              step:recorder.step
+                                                   outputDirectory:recorder.outputDirectory];
+    recorder.compressesTrajectory = YES;
+    recorder.trajectoryTolerance = 5.0;
+    recorder.delegate = self;
+    [recorder start];
+    
+    id<CLLocationManagerDelegate> clDelegate = (id<CLLocationManagerDelegate>)recorder;
+    NSDate *timestamp = [NSDate date];
+    for (NSInteger i = 0; i < kNumberOfSamples; i++) {
+        CLLocation *location = [[CLLocation alloc] initWithCoordinate:CLLocationCoordinate2DMake(37.31317, -122.07238)
+                                                             altitude:11.0
+                                                   horizontalAccuracy:12.0
+                                                     verticalAccuracy:13.0
+                                                               course:14.0
+                                                                speed:15.0
+                                                            timestamp:[timestamp dateByAddingTimeInterval:i]];
+        [clDelegate locationManager:recorder.locationManager didUpdateLocations:@[location]];
+    }
+    [recorder stop];
+    
+    ORKFileResult *fileResult = (ORKFileResult *)_result;
+    XCTAssertTrue([fileResult isKindOfClass:[ORKFileResult class]]);
+    NSData *data = [NSData dataWithContentsOfURL:fileResult.fileURL];
+    NSArray *records = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil][@"items"];
+    
+    // The header, the first and last locations of the stationary trajectory, and the summary.
+    XCTAssertEqual(records.count, 4);
+    XCTAssertEqualObjects(records.lastObject[@"summary"][@"discardedLocationCount"], @(kNumberOfSamples - 2));
+    
+    NSError *error = nil;
+    NSDictionary *log = [NSJSONSerialization JSONObjectWithData:[ORKTrajectoryEncoder JSONLogDataWithCompressedLogData:data error:&error] options:0 error:nil];
+    XCTAssertNil(error);
+    NSArray<NSDictionary *> *items = log[@"items"];
+    XCTAssertEqual(items.count, 2);
+    XCTAssertEqualObjects(items.lastObject[@"timestamp"], ORKStringFromDateISO8601([timestamp dateByAddingTimeInterval:kNumberOfSamples - 1]));
+    XCTAssertEqualWithAccuracy([items.lastObject[@"coordinate"][@"longitude"] doubleValue], -122.07238, 1e-7);
+    XCTAssertEqualWithAccuracy([items.lastObject[@"speed"] doubleValue], 15.0, 0.01);
+}
 #endif
 
 - (void)testAccelerometerRecorder {
@@ -0,0 +1,221 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import Foundation;
+@import CoreMotion;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ORKAccelerometerRecorder;
+@class ORKDeviceMotionRecorder;
+@class ORKPedometerRecorder;
+@class ORKRecorder;
+
+/**
+ A sensor sample that can be fed to a recorder by `ORKSensorReplayHarness`.
+ */
+@protocol ORKSensorReplaySample <NSObject>
+
+/// The time at which the sample was taken, in seconds.
+@property (nonatomic, readonly) NSTimeInterval replayTimestamp;
+
+/// Returns a copy of the sample shifted in time by `offset` seconds.
+- (instancetype)replaySampleByAddingTimeInterval:(NSTimeInterval)offset;
+
+@end
+
+
+/// An accelerometer sample with settable values.
+@interface ORKReplayAccelerometerData : CMAccelerometerData <ORKSensorReplaySample>
+
+- (instancetype)initWithTimestamp:(NSTimeInterval)timestamp acceleration:(CMAcceleration)acceleration;
+
+@end
+
+
+/// A device motion sample with settable values.
+@interface ORKReplayDeviceMotion : CMDeviceMotion <ORKSensorReplaySample>
+
+- (instancetype)initWithTimestamp:(NSTimeInterval)timestamp
+                         attitude:(CMQuaternion)attitude
+                     rotationRate:(CMRotationRate)rotationRate
+                          gravity:(CMAcceleration)gravity
+                 userAcceleration:(CMAcceleration)userAcceleration
+                    magneticField:(CMCalibratedMagneticField)magneticField;
+
+@end
+
+
+/// A pedometer sample with settable values. The replay timestamp is the end date.
+@interface ORKReplayPedometerData : CMPedometerData <ORKSensorReplaySample>
+
+- (instancetype)initWithStartDate:(NSDate *)startDate
+                          endDate:(NSDate *)endDate
+                    numberOfSteps:(NSNumber *)numberOfSteps
+                         distance:(nullable NSNumber *)distance;
+
+@end
+
+
+/**
+ Controls how a sample stream is delivered to a recorder.
+ */
+@interface ORKSensorReplayConfiguration : NSObject <NSCopying>
+
+/**
+ The playback speed relative to the sample timestamps.
+ 
+ A value of 1 replays in real time and 10 replays ten times faster. A value of 0, the default,
+ delivers samples as fast as possible.
+ */
+@property (nonatomic) double speed;
+
+/**
+ The maximum amount, in seconds, by which each sample timestamp is randomly displaced.
+ 
+ The default value is 0.
+ */
+@property (nonatomic) NSTimeInterval jitter;
+
+/**
+ The time, in seconds, between the starts of simulated sensor dropouts.
+ 
+ Samples that fall within `gapDuration` of the start of each interval are not delivered. The
+ default value is 0, which disables gaps.
+ */
+@property (nonatomic) NSTimeInterval gapInterval;
+
+/// The length, in seconds, of each simulated sensor dropout.
+@property (nonatomic) NSTimeInterval gapDuration;
+
+/// The seed for the jitter generator, so that runs are reproducible. The default value is 1.
+@property (nonatomic) uint32_t seed;
+
+@end
+
+
+/**
+ The measurements collected during a replay.
+ */
+@interface ORKSensorReplayReport : NSObject
+
+/// The number of samples in the replayed stream.
+@property (nonatomic, readonly) NSUInteger sourceSampleCount;
+
+/// The number of samples skipped by simulated sensor dropouts.
+@property (nonatomic, readonly) NSUInteger skippedSampleCount;
+
+/// The number of samples delivered to the recorder.
+@property (nonatomic, readonly) NSUInteger deliveredSampleCount;
+
+/// The number of samples found in the recorder's output file.
+@property (nonatomic, readonly) NSUInteger loggedSampleCount;
+
+/// The number of delivered samples that did not reach the output file.
+@property (nonatomic, readonly) NSUInteger droppedSampleCount;
+
+/// The mean time, in seconds, from delivering a sample to the recorder having written it.
+@property (nonatomic, readonly) NSTimeInterval meanLatency;
+
+/// The 95th percentile of the sample latency, in seconds.
+@property (nonatomic, readonly) NSTimeInterval latency95thPercentile;
+
+/// The largest sample latency, in seconds.
+@property (nonatomic, readonly) NSTimeInterval maximumLatency;
+
+/// The process CPU time, user and system, spent per delivered sample, in seconds.
+@property (nonatomic, readonly) NSTimeInterval CPUTimePerSample;
+
+/// The wall clock time taken by the replay, in seconds.
+@property (nonatomic, readonly) NSTimeInterval duration;
+
+/// The output file reported by the recorder, if any.
+@property (nonatomic, readonly, nullable) NSURL *fileURL;
+
+/// The error reported by the recorder, if any.
+@property (nonatomic, readonly, nullable) NSError *error;
+
+@end
+
+
+/**
+ Drives recorders with recorded or synthetic sensor data.
+ 
+ The recorders returned by the harness obtain their motion manager or pedometer from the
+ harness instead of Core Motion, so the full logging pipeline runs without sensors or a user
+ interface. Samples are delivered on the queue the recorder asked for, exactly as Core Motion
+ would deliver them.
+ 
+ Call `replaySamples:throughRecorder:` from the main thread; it runs the main run loop until
+ the recorder has finished.
+ */
+@interface ORKSensorReplayHarness : NSObject
+
+- (instancetype)initWithConfiguration:(ORKSensorReplayConfiguration *)configuration NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, copy, readonly) ORKSensorReplayConfiguration *configuration;
+
+- (ORKAccelerometerRecorder *)accelerometerRecorderWithFrequency:(double)frequency outputDirectory:(NSURL *)outputDirectory;
+
+- (ORKDeviceMotionRecorder *)deviceMotionRecorderWithFrequency:(double)frequency outputDirectory:(NSURL *)outputDirectory;
+
+- (ORKPedometerRecorder *)pedometerRecorderWithOutputDirectory:(NSURL *)outputDirectory;
+
+/**
+ Starts the recorder, delivers the samples to it and stops it.
+ 
+ The recorder must have been created by this harness. Its delegate is replaced for the
+ duration of the replay.
+ */
+- (ORKSensorReplayReport *)replaySamples:(NSArray<id<ORKSensorReplaySample>> *)samples throughRecorder:(ORKRecorder *)recorder;
+
+/// Reads the samples from a JSON log written by an accelerometer recorder.
++ (nullable NSArray<ORKReplayAccelerometerData *> *)accelerometerSamplesWithContentsOfURL:(NSURL *)url error:(NSError * _Nullable *)error;
+
+/// Reads the samples from a JSON log written by a device motion recorder.
++ (nullable NSArray<ORKReplayDeviceMotion *> *)deviceMotionSamplesWithContentsOfURL:(NSURL *)url error:(NSError * _Nullable *)error;
+
+/// Reads the samples from a JSON log written by a pedometer recorder.
++ (nullable NSArray<ORKReplayPedometerData *> *)pedometerSamplesWithContentsOfURL:(NSURL *)url error:(NSError * _Nullable *)error;
+
+/// Returns accelerometer samples of a device carried by someone walking at 2 steps per second.
++ (NSArray<ORKReplayAccelerometerData *> *)syntheticAccelerometerSamplesWithFrequency:(double)frequency duration:(NSTimeInterval)duration;
+
+/// Returns device motion samples of a device carried by someone walking at 2 steps per second.
++ (NSArray<ORKReplayDeviceMotion *> *)syntheticDeviceMotionSamplesWithFrequency:(double)frequency duration:(NSTimeInterval)duration;
+
+/// Returns cumulative pedometer samples at the given interval for someone walking at 2 steps per second.
++ (NSArray<ORKReplayPedometerData *> *)syntheticPedometerSamplesWithInterval:(NSTimeInterval)interval duration:(NSTimeInterval)duration;
+
+@end
+
+NS_ASSUME_NONNULL_END
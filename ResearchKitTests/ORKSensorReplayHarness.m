@@ -0,0 +1,810 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKSensorReplayHarness.h"
+
+@import ResearchKit_Private;
+@import ResearchKitActiveTask;
+@import ResearchKitActiveTask_Private;
+
+#include <sys/resource.h>
+
+
+static const double ORKSyntheticStepFrequency = 2.0;
+
+static NSTimeInterval ORKProcessCPUTime(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) + ((usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6);
+}
+
+static CMAcceleration ORKAccelerationFromDictionary(NSDictionary *dictionary) {
+    return (CMAcceleration){ [dictionary[@"x"] doubleValue], [dictionary[@"y"] doubleValue], [dictionary[@"z"] doubleValue] };
+}
+
+static NSArray<NSDictionary *> *ORKItemsFromJSONLog(NSURL *url, NSError **error) {
+    NSData *data = [NSData dataWithContentsOfURL:url options:NSDataReadingMappedIfSafe error:error];
+    if (!data) {
+        return nil;
+    }
+    NSDictionary *log = [NSJSONSerialization JSONObjectWithData:data options:(NSJSONReadingOptions)0 error:error];
+    if (!log) {
+        return nil;
+    }
+    NSArray *items = [log isKindOfClass:[NSDictionary class]] ? log[@"items"] : nil;
+    if (![items isKindOfClass:[NSArray class]]) {
+        if (error) {
+            *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileReadCorruptFileError userInfo:@{NSURLErrorKey: url}];
+        }
+        return nil;
+    }
+    return items;
+}
+
+
+#pragma mark - Samples
+
+@implementation ORKReplayAccelerometerData {
+    NSTimeInterval _timestamp;
+    CMAcceleration _acceleration;
+}
+
+- (instancetype)initWithTimestamp:(NSTimeInterval)timestamp acceleration:(CMAcceleration)acceleration {
+    self = [super init];
+    if (self) {
+        _timestamp = timestamp;
+        _acceleration = acceleration;
+    }
+    return self;
+}
+
+- (NSTimeInterval)timestamp {
+    return _timestamp;
+}
+
+- (CMAcceleration)acceleration {
+    return _acceleration;
+}
+
+- (NSTimeInterval)replayTimestamp {
+    return _timestamp;
+}
+
+- (instancetype)replaySampleByAddingTimeInterval:(NSTimeInterval)offset {
+    return [[[self class] alloc] initWithTimestamp:_timestamp + offset acceleration:_acceleration];
+}
+
+@end
+
+
+@interface ORKReplayAttitude : CMAttitude
+
+- (instancetype)initWithQuaternion:(CMQuaternion)quaternion;
+
+@end
+
+
+@implementation ORKReplayAttitude {
+    CMQuaternion _quaternion;
+}
+
+- (instancetype)initWithQuaternion:(CMQuaternion)quaternion {
+    self = [super init];
+    if (self) {
+        _quaternion = quaternion;
+    }
+    return self;
+}
+
+- (CMQuaternion)quaternion {
+    return _quaternion;
+}
+
+@end
+
+
+@implementation ORKReplayDeviceMotion {
+    NSTimeInterval _timestamp;
+    ORKReplayAttitude *_attitude;
+    CMRotationRate _rotationRate;
+    CMAcceleration _gravity;
+    CMAcceleration _userAcceleration;
+    CMCalibratedMagneticField _magneticField;
+}
+
+- (instancetype)initWithTimestamp:(NSTimeInterval)timestamp
+                         attitude:(CMQuaternion)attitude
+                     rotationRate:(CMRotationRate)rotationRate
+                          gravity:(CMAcceleration)gravity
+                 userAcceleration:(CMAcceleration)userAcceleration
+                    magneticField:(CMCalibratedMagneticField)magneticField {
+    self = [super init];
+    if (self) {
+        _timestamp = timestamp;
+        _attitude = [[ORKReplayAttitude alloc] initWithQuaternion:attitude];
+        _rotationRate = rotationRate;
+        _gravity = gravity;
+        _userAcceleration = userAcceleration;
+        _magneticField = magneticField;
+    }
+    return self;
+}
+
+- (NSTimeInterval)timestamp {
+    return _timestamp;
+}
+
+- (CMAttitude *)attitude {
+    return _attitude;
+}
+
+- (CMRotationRate)rotationRate {
+    return _rotationRate;
+}
+
+- (CMAcceleration)gravity {
+    return _gravity;
+}
+
+- (CMAcceleration)userAcceleration {
+    return _userAcceleration;
+}
+
+- (CMCalibratedMagneticField)magneticField {
+    return _magneticField;
+}
+
+- (NSTimeInterval)replayTimestamp {
+    return _timestamp;
+}
+
+- (instancetype)replaySampleByAddingTimeInterval:(NSTimeInterval)offset {
+    return [[[self class] alloc] initWithTimestamp:_timestamp + offset
+                                          attitude:_attitude.quaternion
+                                      rotationRate:_rotationRate
+                                           gravity:_gravity
+                                  userAcceleration:_userAcceleration
+                                     magneticField:_magneticField];
+}
+
+@end
+
+
+@implementation ORKReplayPedometerData {
+    NSDate *_startDate;
+    NSDate *_endDate;
+    NSNumber *_numberOfSteps;
+    NSNumber *_distance;
+}
+
+- (instancetype)initWithStartDate:(NSDate *)startDate
+                          endDate:(NSDate *)endDate
+                    numberOfSteps:(NSNumber *)numberOfSteps
+                         distance:(NSNumber *)distance {
+    self = [super init];
+    if (self) {
+        _startDate = [startDate copy];
+        _endDate = [endDate copy];
+        _numberOfSteps = [numberOfSteps copy];
+        _distance = [distance copy];
+    }
+    return self;
+}
+
+- (NSDate *)startDate {
+    return _startDate;
+}
+
+- (NSDate *)endDate {
+    return _endDate;
+}
+
+- (NSNumber *)numberOfSteps {
+    return _numberOfSteps;
+}
+
+- (NSNumber *)distance {
+    return _distance;
+}
+
+- (NSNumber *)floorsAscended {
+    return nil;
+}
+
+- (NSNumber *)floorsDescended {
+    return nil;
+}
+
+- (NSTimeInterval)replayTimestamp {
+    return _endDate.timeIntervalSinceReferenceDate;
+}
+
+- (instancetype)replaySampleByAddingTimeInterval:(NSTimeInterval)offset {
+    return [[[self class] alloc] initWithStartDate:_startDate
+                                           endDate:[_endDate dateByAddingTimeInterval:offset]
+                                     numberOfSteps:_numberOfSteps
+                                          distance:_distance];
+}
+
+@end
+
+
+#pragma mark - Sources
+
+/**
+ Stands in for a Core Motion object, delivering samples to the handler a recorder registered.
+ 
+ Returns `NO` if the recorder is not currently receiving updates. `completion` is called on the
+ delivery queue once the recorder's handler has returned.
+ */
+@protocol ORKSensorReplaySource <NSObject>
+
+- (BOOL)deliverSample:(id)sample completion:(void (^)(void))completion;
+
+@end
+
+
+@interface ORKReplayMotionManager : CMMotionManager <ORKSensorReplaySource>
+
+@end
+
+
+@implementation ORKReplayMotionManager {
+    NSOperationQueue *_queue;
+    CMAccelerometerHandler _accelerometerHandler;
+    CMDeviceMotionHandler _deviceMotionHandler;
+}
+
+- (BOOL)isAccelerometerAvailable {
+    return YES;
+}
+
+- (BOOL)isDeviceMotionAvailable {
+    return YES;
+}
+
+- (BOOL)isAccelerometerActive {
+    @synchronized (self) {
+        return _accelerometerHandler != nil;
+    }
+}
+
+- (BOOL)isDeviceMotionActive {
+    @synchronized (self) {
+        return _deviceMotionHandler != nil;
+    }
+}
+
+- (void)startAccelerometerUpdatesToQueue:(NSOperationQueue *)queue withHandler:(CMAccelerometerHandler)handler {
+    @synchronized (self) {
+        _queue = queue;
+        _accelerometerHandler = [handler copy];
+    }
+}
+
+- (void)stopAccelerometerUpdates {
+    @synchronized (self) {
+        _accelerometerHandler = nil;
+    }
+}
+
+- (void)startDeviceMotionUpdatesToQueue:(NSOperationQueue *)queue withHandler:(CMDeviceMotionHandler)handler {
+    @synchronized (self) {
+        _queue = queue;
+        _deviceMotionHandler = [handler copy];
+    }
+}
+
+- (void)stopDeviceMotionUpdates {
+    @synchronized (self) {
+        _deviceMotionHandler = nil;
+    }
+}
+
+- (BOOL)deliverSample:(id)sample completion:(void (^)(void))completion {
+    NSOperationQueue *queue = nil;
+    void (^handler)(void) = nil;
+    @synchronized (self) {
+        queue = _queue;
+        if ([sample isKindOfClass:[CMAccelerometerData class]] && _accelerometerHandler) {
+            CMAccelerometerHandler accelerometerHandler = _accelerometerHandler;
+            handler = ^{ accelerometerHandler(sample, nil); };
+        } else if ([sample isKindOfClass:[CMDeviceMotion class]] && _deviceMotionHandler) {
+            CMDeviceMotionHandler deviceMotionHandler = _deviceMotionHandler;
+            handler = ^{ deviceMotionHandler(sample, nil); };
+        }
+    }
+    if (!handler) {
+        return NO;
+    }
+    [queue addOperationWithBlock:^{
+        handler();
+        completion();
+    }];
+    return YES;
+}
+
+@end
+
+
+@interface ORKReplayPedometer : CMPedometer <ORKSensorReplaySource>
+
+@end
+
+
+@implementation ORKReplayPedometer {
+    dispatch_queue_t _queue;
+    CMPedometerHandler _handler;
+}
+
++ (BOOL)isStepCountingAvailable {
+    return YES;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _queue = dispatch_queue_create("ResearchKit.ReplayPedometer", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+- (void)startPedometerUpdatesFromDate:(NSDate *)start withHandler:(CMPedometerHandler)handler {
+    @synchronized (self) {
+        _handler = [handler copy];
+    }
+}
+
+- (void)stopPedometerUpdates {
+    @synchronized (self) {
+        _handler = nil;
+    }
+}
+
+- (BOOL)deliverSample:(id)sample completion:(void (^)(void))completion {
+    CMPedometerHandler handler = nil;
+    @synchronized (self) {
+        handler = _handler;
+    }
+    if (!handler) {
+        return NO;
+    }
+    dispatch_async(_queue, ^{
+        handler(sample, nil);
+        completion();
+    });
+    return YES;
+}
+
+@end
+
+
+#pragma mark - Recorders
+
+@protocol ORKSensorReplayRecorder <NSObject>
+
+@property (nonatomic, strong) id<ORKSensorReplaySource> replaySource;
+
+@end
+
+
+@interface ORKReplayAccelerometerRecorder : ORKAccelerometerRecorder <ORKSensorReplayRecorder>
+
+@end
+
+
+@implementation ORKReplayAccelerometerRecorder
+
+@synthesize replaySource = _replaySource;
+
+- (CMMotionManager *)createMotionManager {
+    return (ORKReplayMotionManager *)_replaySource;
+}
+
+@end
+
+
+@interface ORKReplayDeviceMotionRecorder : ORKDeviceMotionRecorder <ORKSensorReplayRecorder>
+
+@end
+
+
+@implementation ORKReplayDeviceMotionRecorder
+
+@synthesize replaySource = _replaySource;
+
+- (CMMotionManager *)createMotionManager {
+    return (ORKReplayMotionManager *)_replaySource;
+}
+
+@end
+
+
+@interface ORKReplayPedometerRecorder : ORKPedometerRecorder <ORKSensorReplayRecorder>
+
+@end
+
+
+@implementation ORKReplayPedometerRecorder
+
+@synthesize replaySource = _replaySource;
+
+- (CMPedometer *)createPedometer {
+    return (ORKReplayPedometer *)_replaySource;
+}
+
+@end
+
+
+#pragma mark - Configuration and report
+
+@implementation ORKSensorReplayConfiguration
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _seed = 1;
+    }
+    return self;
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone {
+    ORKSensorReplayConfiguration *configuration = [[[self class] allocWithZone:zone] init];
+    configuration.speed = _speed;
+    configuration.jitter = _jitter;
+    configuration.gapInterval = _gapInterval;
+    configuration.gapDuration = _gapDuration;
+    configuration.seed = _seed;
+    return configuration;
+}
+
+@end
+
+
+@interface ORKSensorReplayReport ()
+
+@property (nonatomic) NSUInteger sourceSampleCount;
+@property (nonatomic) NSUInteger skippedSampleCount;
+@property (nonatomic) NSUInteger deliveredSampleCount;
+@property (nonatomic) NSUInteger loggedSampleCount;
+@property (nonatomic) NSUInteger droppedSampleCount;
+@property (nonatomic) NSTimeInterval meanLatency;
+@property (nonatomic) NSTimeInterval latency95thPercentile;
+@property (nonatomic) NSTimeInterval maximumLatency;
+@property (nonatomic) NSTimeInterval CPUTimePerSample;
+@property (nonatomic) NSTimeInterval duration;
+@property (nonatomic, nullable) NSURL *fileURL;
+@property (nonatomic, nullable) NSError *error;
+
+@end
+
+
+@implementation ORKSensorReplayReport
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p; delivered: %lu/%lu; logged: %lu; dropped: %lu; latency mean/p95/max: %.3f/%.3f/%.3f ms; cpu/sample: %.2f us; duration: %.3f s>",
+            self.class.description, self, (unsigned long)_deliveredSampleCount, (unsigned long)_sourceSampleCount,
+            (unsigned long)_loggedSampleCount, (unsigned long)_droppedSampleCount,
+            _meanLatency * 1e3, _latency95thPercentile * 1e3, _maximumLatency * 1e3, _CPUTimePerSample * 1e6, _duration];
+}
+
+@end
+
+
+#pragma mark - Harness
+
+@interface ORKSensorReplayHarness () <ORKRecorderDelegate>
+
+@end
+
+
+@implementation ORKSensorReplayHarness {
+    NSURL *_fileURL;
+    NSError *_error;
+}
+
+- (instancetype)init {
+    return [self initWithConfiguration:[ORKSensorReplayConfiguration new]];
+}
+
+- (instancetype)initWithConfiguration:(ORKSensorReplayConfiguration *)configuration {
+    self = [super init];
+    if (self) {
+        _configuration = [configuration copy];
+    }
+    return self;
+}
+
+- (ORKAccelerometerRecorder *)accelerometerRecorderWithFrequency:(double)frequency outputDirectory:(NSURL *)outputDirectory {
+    ORKReplayAccelerometerRecorder *recorder = [[ORKReplayAccelerometerRecorder alloc] initWithIdentifier:@"accelerometer"
+                                                                                                frequency:frequency
+                                                                                                     step:nil
+                                                                                          outputDirectory:outputDirectory];
+    recorder.replaySource = [ORKReplayMotionManager new];
+    return recorder;
+}
+
+- (ORKDeviceMotionRecorder *)deviceMotionRecorderWithFrequency:(double)frequency outputDirectory:(NSURL *)outputDirectory {
+    ORKReplayDeviceMotionRecorder *recorder = [[ORKReplayDeviceMotionRecorder alloc] initWithIdentifier:@"deviceMotion"
+                                                                                              frequency:frequency
+                                                                                                   step:nil
+                                                                                        outputDirectory:outputDirectory];
+    recorder.replaySource = [ORKReplayMotionManager new];
+    return recorder;
+}
+
+- (ORKPedometerRecorder *)pedometerRecorderWithOutputDirectory:(NSURL *)outputDirectory {
+    ORKReplayPedometerRecorder *recorder = [[ORKReplayPedometerRecorder alloc] initWithIdentifier:@"pedometer"
+                                                                                             step:nil
+                                                                                  outputDirectory:outputDirectory];
+    recorder.replaySource = [ORKReplayPedometer new];
+    return recorder;
+}
+
+- (NSArray<id<ORKSensorReplaySample>> *)samplesToDeliverFromSamples:(NSArray<id<ORKSensorReplaySample>> *)samples {
+    NSTimeInterval jitter = _configuration.jitter;
+    NSTimeInterval gapInterval = _configuration.gapInterval;
+    NSTimeInterval gapDuration = _configuration.gapDuration;
+    NSTimeInterval firstTimestamp = samples.firstObject.replayTimestamp;
+    
+    // xorshift32, so that jitter is reproducible across runs and platforms
+    uint32_t state = _configuration.seed ? : 1;
+    
+    NSMutableArray *deliveredSamples = [NSMutableArray arrayWithCapacity:samples.count];
+    for (id<ORKSensorReplaySample> sample in samples) {
+        if (gapInterval > 0 && fmod(sample.replayTimestamp - firstTimestamp, gapInterval) < gapDuration) {
+            continue;
+        }
+        if (jitter > 0) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            double unit = ((double)state / (double)UINT32_MAX) * 2.0 - 1.0;
+            [deliveredSamples addObject:[sample replaySampleByAddingTimeInterval:unit * jitter]];
+        } else {
+            [deliveredSamples addObject:sample];
+        }
+    }
+    return deliveredSamples;
+}
+
+- (ORKSensorReplayReport *)replaySamples:(NSArray<id<ORKSensorReplaySample>> *)samples throughRecorder:(ORKRecorder *)recorder {
+    NSParameterAssert([recorder conformsToProtocol:@protocol(ORKSensorReplayRecorder)]);
+    NSAssert([NSThread isMainThread], @"Replay must be driven from the main thread");
+    
+    id<ORKSensorReplaySource> source = ((id<ORKSensorReplayRecorder>)recorder).replaySource;
+    NSArray<id<ORKSensorReplaySample>> *deliveredSamples = [self samplesToDeliverFromSamples:samples];
+    const NSUInteger count = deliveredSamples.count;
+    const double speed = _configuration.speed;
+    
+    NSMutableData *deliveryTimes = [NSMutableData dataWithLength:count * sizeof(NSTimeInterval)];
+    NSMutableData *latencies = [NSMutableData dataWithLength:count * sizeof(NSTimeInterval)];
+    NSTimeInterval *deliveryTime = deliveryTimes.mutableBytes;
+    NSTimeInterval *latency = latencies.mutableBytes;
+    __block NSUInteger acceptedCount = 0;
+    
+    id<ORKRecorderDelegate> previousDelegate = recorder.delegate;
+    recorder.delegate = self;
+    _fileURL = nil;
+    _error = nil;
+    
+    NSProcessInfo *processInfo = [NSProcessInfo processInfo];
+    NSTimeInterval startCPUTime = ORKProcessCPUTime();
+    NSTimeInterval startTime = processInfo.systemUptime;
+    [recorder start];
+    
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_group_enter(group);
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        NSTimeInterval firstTimestamp = deliveredSamples.firstObject.replayTimestamp;
+        NSTimeInterval playbackStartTime = processInfo.systemUptime;
+        for (NSUInteger index = 0; index < count; index++) {
+            id<ORKSensorReplaySample> sample = deliveredSamples[index];
+            if (speed > 0) {
+                NSTimeInterval wait = playbackStartTime + ((sample.replayTimestamp - firstTimestamp) / speed) - processInfo.systemUptime;
+                if (wait > 0) {
+                    [NSThread sleepForTimeInterval:wait];
+                }
+            }
+            
+            dispatch_group_enter(group);
+            deliveryTime[index] = processInfo.systemUptime;
+            BOOL accepted = [source deliverSample:sample completion:^{
+                latency[index] = processInfo.systemUptime - deliveryTime[index];
+                dispatch_group_leave(group);
+            }];
+            if (accepted) {
+                acceptedCount++;
+            } else {
+                latency[index] = NAN;
+                dispatch_group_leave(group);
+            }
+        }
+        dispatch_group_leave(group);
+    });
+    
+    // Keep the main run loop turning for recorders that ask for updates on the main queue.
+    while (dispatch_group_wait(group, DISPATCH_TIME_NOW) != 0) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.001]];
+    }
+    
+    [recorder stop];
+    NSTimeInterval duration = processInfo.systemUptime - startTime;
+    NSTimeInterval CPUTime = ORKProcessCPUTime() - startCPUTime;
+    recorder.delegate = previousDelegate;
+    
+    ORKSensorReplayReport *report = [ORKSensorReplayReport new];
+    report.sourceSampleCount = samples.count;
+    report.skippedSampleCount = samples.count - count;
+    report.deliveredSampleCount = acceptedCount;
+    report.duration = duration;
+    report.CPUTimePerSample = acceptedCount > 0 ? CPUTime / acceptedCount : 0;
+    report.fileURL = _fileURL;
+    report.error = _error;
+    
+    NSUInteger loggedCount = 0;
+    if (_fileURL) {
+        loggedCount = [ORKItemsFromJSONLog(_fileURL, NULL) count];
+    }
+    report.loggedSampleCount = loggedCount;
+    report.droppedSampleCount = acceptedCount > loggedCount ? acceptedCount - loggedCount : 0;
+    
+    NSMutableArray<NSNumber *> *measuredLatencies = [NSMutableArray arrayWithCapacity:acceptedCount];
+    double latencySum = 0;
+    for (NSUInteger index = 0; index < count; index++) {
+        if (!isnan(latency[index])) {
+            latencySum += latency[index];
+            [measuredLatencies addObject:@(latency[index])];
+        }
+    }
+    if (measuredLatencies.count > 0) {
+        [measuredLatencies sortUsingSelector:@selector(compare:)];
+        report.meanLatency = latencySum / measuredLatencies.count;
+        report.latency95thPercentile = measuredLatencies[(NSUInteger)floor(0.95 * (measuredLatencies.count - 1))].doubleValue;
+        report.maximumLatency = measuredLatencies.lastObject.doubleValue;
+    }
+    return report;
+}
+
+#pragma mark ORKRecorderDelegate
+
+- (void)recorder:(ORKRecorder *)recorder didCompleteWithResult:(ORKResult *)result {
+    if ([result isKindOfClass:[ORKFileResult class]]) {
+        _fileURL = ((ORKFileResult *)result).fileURL;
+    }
+}
+
+- (void)recorder:(ORKRecorder *)recorder didFailWithError:(NSError *)error {
+    _error = error;
+}
+
+#pragma mark Sample streams
+
++ (NSArray<ORKReplayAccelerometerData *> *)accelerometerSamplesWithContentsOfURL:(NSURL *)url error:(NSError **)error {
+    NSArray<NSDictionary *> *items = ORKItemsFromJSONLog(url, error);
+    if (!items) {
+        return nil;
+    }
+    NSMutableArray *samples = [NSMutableArray arrayWithCapacity:items.count];
+    for (NSDictionary *item in items) {
+        [samples addObject:[[ORKReplayAccelerometerData alloc] initWithTimestamp:[item[@"timestamp"] doubleValue]
+                                                                    acceleration:ORKAccelerationFromDictionary(item)]];
+    }
+    return samples;
+}
+
++ (NSArray<ORKReplayDeviceMotion *> *)deviceMotionSamplesWithContentsOfURL:(NSURL *)url error:(NSError **)error {
+    NSArray<NSDictionary *> *items = ORKItemsFromJSONLog(url, error);
+    if (!items) {
+        return nil;
+    }
+    NSMutableArray *samples = [NSMutableArray arrayWithCapacity:items.count];
+    for (NSDictionary *item in items) {
+        NSDictionary *attitude = item[@"attitude"];
+        NSDictionary *rotationRate = item[@"rotationRate"];
+        NSDictionary *magneticField = item[@"magneticField"];
+        CMQuaternion quaternion = { [attitude[@"x"] doubleValue], [attitude[@"y"] doubleValue], [attitude[@"z"] doubleValue], [attitude[@"w"] doubleValue] };
+        CMRotationRate rate = { [rotationRate[@"x"] doubleValue], [rotationRate[@"y"] doubleValue], [rotationRate[@"z"] doubleValue] };
+        CMCalibratedMagneticField field = {
+            .field = { [magneticField[@"x"] doubleValue], [magneticField[@"y"] doubleValue], [magneticField[@"z"] doubleValue] },
+            .accuracy = (CMMagneticFieldCalibrationAccuracy)[magneticField[@"accuracy"] intValue]
+        };
+        [samples addObject:[[ORKReplayDeviceMotion alloc] initWithTimestamp:[item[@"timestamp"] doubleValue]
+                                                                   attitude:quaternion
+                                                               rotationRate:rate
+                                                                    gravity:ORKAccelerationFromDictionary(item[@"gravity"])
+                                                           userAcceleration:ORKAccelerationFromDictionary(item[@"userAcceleration"])
+                                                              magneticField:field]];
+    }
+    return samples;
+}
+
++ (NSArray<ORKReplayPedometerData *> *)pedometerSamplesWithContentsOfURL:(NSURL *)url error:(NSError **)error {
+    NSArray<NSDictionary *> *items = ORKItemsFromJSONLog(url, error);
+    if (!items) {
+        return nil;
+    }
+    NSMutableArray *samples = [NSMutableArray arrayWithCapacity:items.count];
+    for (NSDictionary *item in items) {
+        [samples addObject:[[ORKReplayPedometerData alloc] initWithStartDate:ORKDateFromStringISO8601(item[@"startDate"])
+                                                                     endDate:ORKDateFromStringISO8601(item[@"endDate"])
+                                                               numberOfSteps:item[@"numberOfSteps"]
+                                                                    distance:item[@"distance"]]];
+    }
+    return samples;
+}
+
++ (NSArray<ORKReplayAccelerometerData *> *)syntheticAccelerometerSamplesWithFrequency:(double)frequency duration:(NSTimeInterval)duration {
+    const NSUInteger count = (NSUInteger)floor(frequency * duration);
+    NSMutableArray *samples = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        NSTimeInterval timestamp = index / frequency;
+        double vertical = 1.0 + 0.3 * sin(2 * M_PI * ORKSyntheticStepFrequency * timestamp);
+        double sway = 0.05 * sin(M_PI * ORKSyntheticStepFrequency * timestamp);
+        [samples addObject:[[ORKReplayAccelerometerData alloc] initWithTimestamp:timestamp
+                                                                    acceleration:(CMAcceleration){ sway, 0, -vertical }]];
+    }
+    return samples;
+}
+
++ (NSArray<ORKReplayDeviceMotion *> *)syntheticDeviceMotionSamplesWithFrequency:(double)frequency duration:(NSTimeInterval)duration {
+    const NSUInteger count = (NSUInteger)floor(frequency * duration);
+    NSMutableArray *samples = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        NSTimeInterval timestamp = index / frequency;
+        double vertical = 0.3 * sin(2 * M_PI * ORKSyntheticStepFrequency * timestamp);
+        double sway = 0.05 * sin(M_PI * ORKSyntheticStepFrequency * timestamp);
+        [samples addObject:[[ORKReplayDeviceMotion alloc] initWithTimestamp:timestamp
+                                                                   attitude:(CMQuaternion){ 0, 0, 0, 1 }
+                                                               rotationRate:(CMRotationRate){ 0, 0.2 * sway, 0 }
+                                                                    gravity:(CMAcceleration){ 0, 0, -1 }
+                                                           userAcceleration:(CMAcceleration){ sway, 0, -vertical }
+                                                              magneticField:(CMCalibratedMagneticField){ .field = { 20, 0, -40 }, .accuracy = CMMagneticFieldCalibrationAccuracyHigh }]];
+    }
+    return samples;
+}
+
++ (NSArray<ORKReplayPedometerData *> *)syntheticPedometerSamplesWithInterval:(NSTimeInterval)interval duration:(NSTimeInterval)duration {
+    const NSUInteger count = (NSUInteger)floor(duration / interval);
+    NSDate *startDate = [NSDate dateWithTimeIntervalSinceReferenceDate:0];
+    NSMutableArray *samples = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 1; index <= count; index++) {
+        NSTimeInterval elapsed = index * interval;
+        NSInteger steps = (NSInteger)floor(elapsed * ORKSyntheticStepFrequency);
+        [samples addObject:[[ORKReplayPedometerData alloc] initWithStartDate:startDate
+                                                                     endDate:[startDate dateByAddingTimeInterval:elapsed]
+                                                               numberOfSteps:@(steps)
+                                                                    distance:@(steps * 0.7)]];
+    }
+    return samples;
+}
+
+@end
@@ -0,0 +1,203 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKit_Private;
+@import ResearchKitActiveTask;
+@import ResearchKitActiveTask_Private;
+
+#import "ORKSensorReplayHarness.h"
+
+
+@interface ORKSensorReplayHarnessTests : XCTestCase
+
+@end
+
+
+@implementation ORKSensorReplayHarnessTests {
+    NSURL *_outputDirectory;
+}
+
+- (void)setUp {
+    [super setUp];
+    _outputDirectory = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    [[NSFileManager defaultManager] createDirectoryAtURL:_outputDirectory withIntermediateDirectories:YES attributes:nil error:nil];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtURL:_outputDirectory error:nil];
+    [super tearDown];
+}
+
+- (void)testAccelerometerReplayAsFastAsPossible {
+    ORKSensorReplayHarness *harness = [[ORKSensorReplayHarness alloc] initWithConfiguration:[ORKSensorReplayConfiguration new]];
+    ORKAccelerometerRecorder *recorder = [harness accelerometerRecorderWithFrequency:100 outputDirectory:_outputDirectory];
+    NSArray *samples = [ORKSensorReplayHarness syntheticAccelerometerSamplesWithFrequency:100 duration:10];
+    
+    ORKSensorReplayReport *report = [harness replaySamples:samples throughRecorder:recorder];
+    
+    XCTAssertNil(report.error);
+    XCTAssertNotNil(report.fileURL);
+    XCTAssertEqual(report.sourceSampleCount, 1000);
+    XCTAssertEqual(report.deliveredSampleCount, 1000);
+    XCTAssertEqual(report.loggedSampleCount, 1000);
+    XCTAssertEqual(report.droppedSampleCount, 0);
+    XCTAssertGreaterThan(report.meanLatency, 0);
+    XCTAssertLessThanOrEqual(report.meanLatency, report.maximumLatency);
+    XCTAssertLessThanOrEqual(report.latency95thPercentile, report.maximumLatency);
+    
+    // The log written by the recorder replays to the same samples.
+    NSError *error = nil;
+    NSArray<ORKReplayAccelerometerData *> *replayed = [ORKSensorReplayHarness accelerometerSamplesWithContentsOfURL:report.fileURL error:&error];
+    XCTAssertNil(error);
+    XCTAssertEqual(replayed.count, samples.count);
+    for (NSUInteger index = 0; index < samples.count; index++) {
+        ORKReplayAccelerometerData *original = samples[index];
+        XCTAssertEqualWithAccuracy(replayed[index].timestamp, original.timestamp, 1e-9);
+        XCTAssertEqualWithAccuracy(replayed[index].acceleration.z, original.acceleration.z, 1e-9);
+    }
+}
+
+- (void)testDeviceMotionReplayAtTenTimesRealTime {
+    ORKSensorReplayConfiguration *configuration = [ORKSensorReplayConfiguration new];
+    configuration.speed = 10;
+    ORKSensorReplayHarness *harness = [[ORKSensorReplayHarness alloc] initWithConfiguration:configuration];
+    ORKDeviceMotionRecorder *recorder = [harness deviceMotionRecorderWithFrequency:100 outputDirectory:_outputDirectory];
+    NSArray *samples = [ORKSensorReplayHarness syntheticDeviceMotionSamplesWithFrequency:100 duration:5];
+    
+    ORKSensorReplayReport *report = [harness replaySamples:samples throughRecorder:recorder];
+    
+    XCTAssertNil(report.error);
+    XCTAssertEqual(report.deliveredSampleCount, 500);
+    XCTAssertEqual(report.droppedSampleCount, 0);
+    // 5 seconds of samples at 10x take at least half a second to deliver.
+    XCTAssertGreaterThanOrEqual(report.duration, 0.49);
+    
+    NSArray<ORKReplayDeviceMotion *> *replayed = [ORKSensorReplayHarness deviceMotionSamplesWithContentsOfURL:report.fileURL error:NULL];
+    XCTAssertEqual(replayed.count, samples.count);
+    XCTAssertEqualWithAccuracy(replayed.lastObject.userAcceleration.z, ((ORKReplayDeviceMotion *)samples.lastObject).userAcceleration.z, 1e-9);
+    XCTAssertEqualWithAccuracy(replayed.lastObject.attitude.quaternion.w, 1, 1e-9);
+}
+
+- (void)testPedometerReplay {
+    ORKSensorReplayHarness *harness = [[ORKSensorReplayHarness alloc] initWithConfiguration:[ORKSensorReplayConfiguration new]];
+    ORKPedometerRecorder *recorder = [harness pedometerRecorderWithOutputDirectory:_outputDirectory];
+    NSArray *samples = [ORKSensorReplayHarness syntheticPedometerSamplesWithInterval:1 duration:30];
+    
+    ORKSensorReplayReport *report = [harness replaySamples:samples throughRecorder:recorder];
+    
+    XCTAssertNil(report.error);
+    XCTAssertEqual(report.loggedSampleCount, 30);
+    XCTAssertEqual(report.droppedSampleCount, 0);
+    
+    NSArray<ORKReplayPedometerData *> *replayed = [ORKSensorReplayHarness pedometerSamplesWithContentsOfURL:report.fileURL error:NULL];
+    XCTAssertEqualObjects(replayed.lastObject.numberOfSteps, @(60));
+}
+
+- (void)testGapsSkipSamples {
+    ORKSensorReplayConfiguration *configuration = [ORKSensorReplayConfiguration new];
+    configuration.gapInterval = 2;
+    configuration.gapDuration = 0.5;
+    ORKSensorReplayHarness *harness = [[ORKSensorReplayHarness alloc] initWithConfiguration:configuration];
+    ORKAccelerometerRecorder *recorder = [harness accelerometerRecorderWithFrequency:100 outputDirectory:_outputDirectory];
+    NSArray *samples = [ORKSensorReplayHarness syntheticAccelerometerSamplesWithFrequency:100 duration:10];
+    
+    ORKSensorReplayReport *report = [harness replaySamples:samples throughRecorder:recorder];
+    
+    // A quarter of every 2 second interval is dropped by the sensor.
+    XCTAssertEqual(report.skippedSampleCount, 250);
+    XCTAssertEqual(report.deliveredSampleCount, 750);
+    XCTAssertEqual(report.loggedSampleCount, 750);
+    XCTAssertEqual(report.droppedSampleCount, 0);
+}
+
+- (void)testJitterIsReproducible {
+    ORKSensorReplayConfiguration *configuration = [ORKSensorReplayConfiguration new];
+    configuration.jitter = 0.004;
+    configuration.seed = 42;
+    NSArray *samples = [ORKSensorReplayHarness syntheticAccelerometerSamplesWithFrequency:100 duration:2];
+    
+    NSArray *(^replay)(void) = ^NSArray *{
+        ORKSensorReplayHarness *harness = [[ORKSensorReplayHarness alloc] initWithConfiguration:configuration];
+        ORKAccelerometerRecorder *recorder = [harness accelerometerRecorderWithFrequency:100 outputDirectory:self->_outputDirectory];
+        ORKSensorReplayReport *report = [harness replaySamples:samples throughRecorder:recorder];
+        return [ORKSensorReplayHarness accelerometerSamplesWithContentsOfURL:report.fileURL error:NULL];
+    };
+    NSArray<ORKReplayAccelerometerData *> *first = replay();
+    NSArray<ORKReplayAccelerometerData *> *second = replay();
+    
+    XCTAssertEqual(first.count, samples.count);
+    XCTAssertEqual(second.count, samples.count);
+    BOOL displaced = NO;
+    for (NSUInteger index = 0; index < samples.count; index++) {
+        NSTimeInterval original = ((ORKReplayAccelerometerData *)samples[index]).timestamp;
+        XCTAssertEqualWithAccuracy(first[index].timestamp, original, 0.004 + 1e-9);
+        XCTAssertEqualWithAccuracy(first[index].timestamp, second[index].timestamp, 1e-12);
+        displaced = displaced || fabs(first[index].timestamp - original) > 1e-6;
+    }
+    XCTAssertTrue(displaced);
+}
+
+- (void)testRecorderThatCannotLogReportsError {
+    ORKSensorReplayHarness *harness = [[ORKSensorReplayHarness alloc] initWithConfiguration:[ORKSensorReplayConfiguration new]];
+    ORKAccelerometerRecorder *recorder = [harness accelerometerRecorderWithFrequency:100 outputDirectory:[NSURL fileURLWithPath:@"/dev/null/unwritable"]];
+    NSArray *samples = [ORKSensorReplayHarness syntheticAccelerometerSamplesWithFrequency:100 duration:1];
+    
+    ORKSensorReplayReport *report = [harness replaySamples:samples throughRecorder:recorder];
+    
+    // The recorder cannot create its log, so it never starts receiving updates.
+    XCTAssertEqual(report.deliveredSampleCount, 0);
+    XCTAssertEqual(report.loggedSampleCount, 0);
+    XCTAssertNil(report.fileURL);
+    XCTAssertNotNil(report.error);
+}
+
+- (void)testAccelerometerLoggingPerformance {
+    NSArray *samples = [ORKSensorReplayHarness syntheticAccelerometerSamplesWithFrequency:100 duration:60];
+    [self measureBlock:^{
+        ORKSensorReplayHarness *harness = [[ORKSensorReplayHarness alloc] initWithConfiguration:[ORKSensorReplayConfiguration new]];
+        ORKAccelerometerRecorder *recorder = [harness accelerometerRecorderWithFrequency:100 outputDirectory:self->_outputDirectory];
+        ORKSensorReplayReport *report = [harness replaySamples:samples throughRecorder:recorder];
+        XCTAssertEqual(report.droppedSampleCount, 0);
+    }];
+}
+
+- (void)testDeviceMotionLoggingPerformance {
+    NSArray *samples = [ORKSensorReplayHarness syntheticDeviceMotionSamplesWithFrequency:100 duration:60];
+    [self measureBlock:^{
+        ORKSensorReplayHarness *harness = [[ORKSensorReplayHarness alloc] initWithConfiguration:[ORKSensorReplayConfiguration new]];
+        ORKDeviceMotionRecorder *recorder = [harness deviceMotionRecorderWithFrequency:100 outputDirectory:self->_outputDirectory];
+        ORKSensorReplayReport *report = [harness replaySamples:samples throughRecorder:recorder];
+        XCTAssertEqual(report.droppedSampleCount, 0);
+    }];
+}
+
+@end
@@ -0,0 +1,223 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import AVFoundation;
+@import ResearchKit_Private;
+@import ResearchKitActiveTask;
+@import ResearchKitActiveTask_Private;
+
+
+@interface ORKSpeechInNoiseStimulusTests : XCTestCase
+
+@end
+
+
+@implementation ORKSpeechInNoiseStimulusTests {
+    NSURL *_cacheDirectoryURL;
+    ORKSpeechInNoiseStimulusBank *_bank;
+    ORKSpeechInNoiseStimulus *_stimulus;
+}
+
+- (void)setUp {
+    [super setUp];
+    _cacheDirectoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory() isDirectory:YES] URLByAppendingPathComponent:[NSUUID UUID].UUIDString isDirectory:YES];
+    _bank = [[ORKSpeechInNoiseStimulusBank alloc] initWithCacheDirectoryURL:_cacheDirectoryURL];
+    
+    ORKSpeechInNoiseStep *step = [[ORKSpeechInNoiseStep alloc] initWithIdentifier:@"speechInNoise"];
+    step.speechFileNameWithExtension = @"Sentence1.wav";
+    step.gainAppliedToNoise = 0.73;
+    _stimulus = [ORKSpeechInNoiseStimulus stimulusWithStep:step];
+    XCTAssertNotNil(_stimulus);
+}
+
+- (void)tearDown {
+    [_bank removeCachedTracks];
+    [super tearDown];
+}
+
+- (AVAudioPCMBuffer *)bufferByReadingAudioFileAtURL:(NSURL *)url {
+    AVAudioFile *audioFile = [[AVAudioFile alloc] initForReading:url error:nil];
+    AVAudioPCMBuffer *buffer = [[AVAudioPCMBuffer alloc] initWithPCMFormat:audioFile.processingFormat frameCapacity:(AVAudioFrameCount)audioFile.length];
+    [audioFile readIntoBuffer:buffer error:nil];
+    return buffer;
+}
+
+- (void)testBankDecodesOnceIntoMappedCache {
+    NSURL *url = [ORKSpeechInNoiseStimulusBank URLForAudioFileNamed:@"Sentence1.wav"];
+    XCTAssertNotNil(url);
+    
+    NSError *error = nil;
+    ORKSpeechInNoisePCMTrack *track = [_bank trackForAudioFileAtURL:url error:&error];
+    XCTAssertNotNil(track, @"%@", error);
+    
+    AVAudioPCMBuffer *reference = [self bufferByReadingAudioFileAtURL:url];
+    XCTAssertEqual(track.frameCount, reference.frameLength);
+    XCTAssertEqual(track.sampleRate, reference.format.sampleRate);
+    XCTAssertEqualWithAccuracy(track.duration, reference.frameLength / reference.format.sampleRate, 1e-9);
+    XCTAssertEqual(memcmp(track.samples, reference.floatChannelData[0], reference.frameLength * sizeof(float)), 0);
+    
+    // The same track object is handed out while it is mapped.
+    XCTAssertEqual([_bank trackForAudioFileAtURL:url error:nil], track);
+    
+    NSArray<NSURL *> *cacheFiles = [[NSFileManager defaultManager] contentsOfDirectoryAtURL:_cacheDirectoryURL includingPropertiesForKeys:nil options:0 error:nil];
+    XCTAssertEqual(cacheFiles.count, 1);
+    
+    // Another bank on the same directory maps the cache file instead of decoding again.
+    ORKSpeechInNoiseStimulusBank *otherBank = [[ORKSpeechInNoiseStimulusBank alloc] initWithCacheDirectoryURL:_cacheDirectoryURL];
+    NSDate *modificationDate = [[NSFileManager defaultManager] attributesOfItemAtPath:cacheFiles.firstObject.path error:nil].fileModificationDate;
+    ORKSpeechInNoisePCMTrack *mappedTrack = [otherBank trackForAudioFileAtURL:url error:nil];
+    XCTAssertEqual(mappedTrack.frameCount, track.frameCount);
+    XCTAssertEqual(memcmp(mappedTrack.samples, track.samples, track.frameCount * sizeof(float)), 0);
+    XCTAssertEqualObjects([[NSFileManager defaultManager] attributesOfItemAtPath:cacheFiles.firstObject.path error:nil].fileModificationDate, modificationDate);
+}
+
+- (void)testMissingFileFails {
+    NSError *error = nil;
+    NSURL *url = [_cacheDirectoryURL URLByAppendingPathComponent:@"Missing.wav"];
+    XCTAssertNil([_bank trackForAudioFileAtURL:url error:&error]);
+    XCTAssertEqualObjects(error.domain, ORKErrorDomain);
+}
+
+- (void)testMixMatchesScalarReference {
+    NSUInteger frameCount = 1001;
+    float *speech = malloc(frameCount * sizeof(float));
+    float *noise = malloc(frameCount * sizeof(float));
+    float *filter = malloc(frameCount * sizeof(float));
+    float *output = malloc(frameCount * sizeof(float));
+    for (NSUInteger index = 0; index < frameCount; index++) {
+        speech[index] = sinf(index * 0.01f);
+        noise[index] = cosf(index * 0.37f);
+        filter[index] = (float)index / frameCount;
+    }
+    
+    ORKSpeechInNoiseMix(speech, noise, 1.46f, filter, output, frameCount);
+    for (NSUInteger index = 0; index < frameCount; index++) {
+        XCTAssertEqualWithAccuracy(output[index], (speech[index] + noise[index] * 1.46f) * filter[index], 1e-6);
+    }
+    
+    // Mixing in place, without a filter.
+    ORKSpeechInNoiseMix(speech, noise, 0.5f, NULL, speech, frameCount);
+    for (NSUInteger index = 0; index < frameCount; index++) {
+        XCTAssertEqualWithAccuracy(speech[index], sinf(index * 0.01f) + noise[index] * 0.5f, 1e-6);
+    }
+    
+    free(speech);
+    free(noise);
+    free(filter);
+    free(output);
+}
+
+- (void)testMixerMatchesPreviousMix {
+    ORKSpeechInNoiseMixer *mixer = [[ORKSpeechInNoiseMixer alloc] initWithStimulusBank:_bank];
+    NSError *error = nil;
+    AVAudioPCMBuffer *buffer = [mixer bufferForStimulus:_stimulus noiseOffset:12345 error:&error];
+    XCTAssertNotNil(buffer, @"%@", error);
+    
+    // The mix as the step used to make it, with scalar loops over freshly read files.
+    AVAudioPCMBuffer *speech = [self bufferByReadingAudioFileAtURL:_stimulus.speechURL];
+    AVAudioPCMBuffer *noise = [self bufferByReadingAudioFileAtURL:_stimulus.noiseURL];
+    AVAudioPCMBuffer *filter = [self bufferByReadingAudioFileAtURL:_stimulus.filterURL];
+    XCTAssertEqual(buffer.frameLength, filter.frameLength);
+    for (AVAudioFrameCount index = 0; index < filter.frameLength; index++) {
+        float expected = (speech.floatChannelData[0][index] + noise.floatChannelData[0][index + 12345] * 0.73) * filter.floatChannelData[0][index];
+        if (fabsf(buffer.floatChannelData[0][index] - expected) > 1e-6) {
+            XCTFail(@"Sample %u differs: %f != %f", index, buffer.floatChannelData[0][index], expected);
+            break;
+        }
+    }
+}
+
+- (void)testLoopingStimulusIsUnmodifiedSpeech {
+    ORKSpeechInNoiseMixer *mixer = [[ORKSpeechInNoiseMixer alloc] initWithStimulusBank:_bank];
+    ORKSpeechInNoiseStimulus *stimulus = [[ORKSpeechInNoiseStimulus alloc] initWithSpeechURL:_stimulus.speechURL noiseURL:nil filterURL:nil noiseGain:0];
+    AVAudioPCMBuffer *buffer = [mixer bufferForStimulus:stimulus error:nil];
+    AVAudioPCMBuffer *speech = [self bufferByReadingAudioFileAtURL:_stimulus.speechURL];
+    XCTAssertEqual(buffer.frameLength, speech.frameLength);
+    XCTAssertEqual(memcmp(buffer.floatChannelData[0], speech.floatChannelData[0], speech.frameLength * sizeof(float)), 0);
+}
+
+- (void)testBuffersAreReused {
+    ORKSpeechInNoiseMixer *mixer = [[ORKSpeechInNoiseMixer alloc] initWithStimulusBank:_bank];
+    AVAudioPCMBuffer *buffer = [mixer bufferForStimulus:_stimulus error:nil];
+    XCTAssertEqual(mixer.pooledBufferCount, 0);
+    
+    [mixer recycleBuffer:buffer];
+    [mixer recycleBuffer:buffer];
+    XCTAssertEqual(mixer.pooledBufferCount, 1);
+    
+    XCTAssertEqual([mixer bufferForStimulus:_stimulus error:nil], buffer);
+    XCTAssertEqual(mixer.pooledBufferCount, 0);
+}
+
+- (void)testPrefetchedMixIsTakenOnce {
+    ORKSpeechInNoiseMixer *mixer = [[ORKSpeechInNoiseMixer alloc] initWithStimulusBank:_bank];
+    [mixer prefetchStimulus:_stimulus];
+    AVAudioPCMBuffer *prefetched = [mixer bufferForStimulus:_stimulus error:nil];
+    XCTAssertNotNil(prefetched);
+    
+    // Nothing is left prefetched, so the next request mixes into a new buffer.
+    AVAudioPCMBuffer *mixed = [mixer bufferForStimulus:_stimulus error:nil];
+    XCTAssertNotNil(mixed);
+    XCTAssertNotEqual(mixed, prefetched);
+    XCTAssertEqual(mixed.frameLength, prefetched.frameLength);
+}
+
+- (void)testTrialSetupPerformance {
+    ORKSpeechInNoiseMixer *mixer = [[ORKSpeechInNoiseMixer alloc] initWithStimulusBank:_bank];
+    [mixer recycleBuffer:[mixer bufferForStimulus:_stimulus error:nil]];
+    
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        for (NSInteger trial = 0; trial < 10; trial++) {
+            AVAudioPCMBuffer *buffer = [mixer bufferForStimulus:self->_stimulus error:nil];
+            [mixer recycleBuffer:buffer];
+        }
+    }];
+}
+
+- (void)testPreviousTrialSetupPerformance {
+    // The baseline for testTrialSetupPerformance: read every file and mix with scalar loops.
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        for (NSInteger trial = 0; trial < 10; trial++) {
+            AVAudioPCMBuffer *speech = [self bufferByReadingAudioFileAtURL:self->_stimulus.speechURL];
+            AVAudioPCMBuffer *noise = [self bufferByReadingAudioFileAtURL:self->_stimulus.noiseURL];
+            AVAudioPCMBuffer *filter = [self bufferByReadingAudioFileAtURL:self->_stimulus.filterURL];
+            for (AVAudioFrameCount index = 0; index < filter.frameLength; index++) {
+                speech.floatChannelData[0][index] += noise.floatChannelData[0][index] * 0.73;
+            }
+            for (AVAudioFrameCount index = 0; index < filter.frameLength; index++) {
+                speech.floatChannelData[0][index] *= filter.floatChannelData[0][index];
+            }
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,204 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKit_Private;
+@import ResearchKitActiveTask;
+
+
+static NSArray<ORKStepTemplate *> *ORKStepTemplateTestTemplates(NSUInteger count, NSMutableArray<NSString *> *builtIdentifiers) {
+    NSMutableArray<ORKStepTemplate *> *templates = [NSMutableArray array];
+    for (NSUInteger index = 0; index < count; index++) {
+        NSString *identifier = [NSString stringWithFormat:@"step%lu", (unsigned long)index];
+        [templates addObject:[ORKStepTemplate templateWithIdentifier:identifier builder:^ORKStep *(NSString *stepIdentifier) {
+            @synchronized (builtIdentifiers) {
+                [builtIdentifiers addObject:stepIdentifier];
+            }
+            ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
+            step.title = stepIdentifier;
+            return step;
+        }]];
+    }
+    return templates;
+}
+
+static NSArray<ORKOrderedTask *> *ORKStepTemplateTestMakePredefinedTasks(void) {
+    ORKPredefinedTaskOption options = ORKPredefinedTaskOptionNone;
+    NSMutableArray<ORKOrderedTask *> *tasks = [NSMutableArray array];
+    [tasks addObject:[ORKOrderedTask amslerGridTaskWithIdentifier:@"amsler" intendedUseDescription:nil options:options]];
+    [tasks addObject:[ORKOrderedTask holePegTestTaskWithIdentifier:@"holePeg" intendedUseDescription:nil dominantHand:ORKBodySagittalLeft numberOfPegs:9 threshold:0.2 rotated:NO timeLimit:300 options:options]];
+    [tasks addObject:[ORKOrderedTask fitnessCheckTaskWithIdentifier:@"fitness" intendedUseDescription:nil walkDuration:360 restDuration:180 options:options]];
+    [tasks addObject:[ORKOrderedTask sixMinuteWalkTaskWithIdentifier:@"6mwt" intendedUseDescription:nil options:options]];
+    [tasks addObject:[ORKOrderedTask shortWalkTaskWithIdentifier:@"shortWalk" intendedUseDescription:nil numberOfStepsPerLeg:20 restDuration:20 options:options]];
+    [tasks addObject:[ORKOrderedTask walkBackAndForthTaskWithIdentifier:@"walkBackAndForth" intendedUseDescription:nil walkDuration:30 restDuration:30 options:options]];
+    [tasks addObject:[ORKOrderedTask kneeRangeOfMotionTaskWithIdentifier:@"knee" limbOption:ORKPredefinedTaskLimbOptionBoth intendedUseDescription:nil options:options]];
+    [tasks addObject:[ORKOrderedTask shoulderRangeOfMotionTaskWithIdentifier:@"shoulder" limbOption:ORKPredefinedTaskLimbOptionBoth intendedUseDescription:nil options:options]];
+    [tasks addObject:[ORKOrderedTask audioTaskWithIdentifier:@"audio" intendedUseDescription:nil speechInstruction:nil shortSpeechInstruction:nil duration:20 recordingSettings:nil checkAudioLevel:YES options:options]];
+    [tasks addObject:[ORKOrderedTask twoFingerTappingIntervalTaskWithIdentifier:@"tapping" intendedUseDescription:nil duration:20 handOptions:ORKPredefinedTaskHandOptionBoth options:options]];
+    [tasks addObject:[ORKOrderedTask spatialSpanMemoryTaskWithIdentifier:@"spatialSpan" intendedUseDescription:nil initialSpan:3 minimumSpan:2 maximumSpan:15 playSpeed:1 maximumTests:5 maximumConsecutiveFailures:3 customTargetImage:nil customTargetPluralName:nil requireReversal:NO options:options]];
+    [tasks addObject:[ORKOrderedTask stroopTaskWithIdentifier:@"stroop" intendedUseDescription:nil numberOfAttempts:10 options:options]];
+    [tasks addObject:[ORKOrderedTask speechRecognitionTaskWithIdentifier:@"speechRecognition" intendedUseDescription:nil speechRecognizerLocale:ORKSpeechRecognizerLocaleEnglishUS speechRecognitionImage:nil speechRecognitionText:@"A quick brown fox" shouldHideTranscript:NO allowsEdittingTranscript:YES options:options]];
+    [tasks addObject:[ORKOrderedTask speechInNoiseTaskWithIdentifier:@"speechInNoise" intendedUseDescription:nil options:options]];
+    [tasks addObject:[ORKOrderedTask toneAudiometryTaskWithIdentifier:@"toneAudiometry" intendedUseDescription:nil speechInstruction:nil shortSpeechInstruction:nil toneDuration:20 options:options]];
+    [tasks addObject:[ORKOrderedTask dBHLToneAudiometryTaskWithIdentifier:@"dBHL" intendedUseDescription:nil options:options]];
+    [tasks addObject:[ORKOrderedTask reactionTimeTaskWithIdentifier:@"reactionTime" intendedUseDescription:nil maximumStimulusInterval:10 minimumStimulusInterval:4 thresholdAcceleration:0.5 numberOfAttempts:3 timeout:3 successSound:0 timeoutSound:0 failureSound:0 options:options]];
+    [tasks addObject:[ORKOrderedTask normalizedReactionTimeTaskWithIdentifier:@"normalizedReactionTime" intendedUseDescription:nil maximumStimulusInterval:10 minimumStimulusInterval:4 thresholdAcceleration:0.5 numberOfAttempts:3 timeout:3 successSound:0 timeoutSound:0 failureSound:0 options:options]];
+    [tasks addObject:[ORKOrderedTask towerOfHanoiTaskWithIdentifier:@"towerOfHanoi" intendedUseDescription:nil numberOfDisks:5 options:options]];
+    [tasks addObject:[ORKOrderedTask timedWalkTaskWithIdentifier:@"timedWalk" intendedUseDescription:nil distanceInMeters:100 timeLimit:180 turnAroundTimeLimit:60 includeAssistiveDeviceForm:YES options:options]];
+    [tasks addObject:[ORKOrderedTask PSATTaskWithIdentifier:@"psat" intendedUseDescription:nil presentationMode:ORKPSATPresentationModeAuditory interStimulusInterval:3 stimulusDuration:1 seriesLength:60 options:options]];
+    [tasks addObject:[ORKOrderedTask tremorTestTaskWithIdentifier:@"tremor" intendedUseDescription:nil activeStepDuration:10 activeTaskOptions:ORKTremorActiveTaskOptionNone handOptions:ORKPredefinedTaskHandOptionBoth options:options]];
+    [tasks addObject:[ORKOrderedTask trailmakingTaskWithIdentifier:@"trailmaking" intendedUseDescription:nil trailmakingInstruction:nil trailType:ORKTrailMakingTypeIdentifierA options:options]];
+    return tasks;
+}
+
+
+@interface ORKStepTemplateTests : XCTestCase
+
+@end
+
+
+@implementation ORKStepTemplateTests
+
+- (void)testStepsAreBuiltOnFirstAccessAndKept {
+    NSMutableArray<NSString *> *builtIdentifiers = [NSMutableArray array];
+    ORKLazyStepArray *steps = [[ORKLazyStepArray alloc] initWithStepTemplates:ORKStepTemplateTestTemplates(4, builtIdentifiers)];
+    
+    XCTAssertEqual(steps.count, 4);
+    XCTAssertEqualObjects(steps.stepIdentifiers, (@[@"step0", @"step1", @"step2", @"step3"]));
+    XCTAssertEqual([steps indexOfStepWithIdentifier:@"step2"], 2);
+    XCTAssertEqual([steps indexOfStepWithIdentifier:@"missing"], NSNotFound);
+    XCTAssertEqual(builtIdentifiers.count, 0);
+    
+    ORKStep *step = steps[2];
+    XCTAssertEqualObjects(step.identifier, @"step2");
+    XCTAssertTrue([steps isStepBuiltAtIndex:2]);
+    XCTAssertFalse([steps isStepBuiltAtIndex:1]);
+    XCTAssertEqual(steps[2], step);
+    XCTAssertEqualObjects(builtIdentifiers, @[@"step2"]);
+}
+
+- (void)testConcurrentAccessKeepsOneStepPerIndex {
+    NSMutableArray<NSString *> *builtIdentifiers = [NSMutableArray array];
+    ORKLazyStepArray *steps = [[ORKLazyStepArray alloc] initWithStepTemplates:ORKStepTemplateTestTemplates(16, builtIdentifiers)];
+    
+    // Racing threads may each build a step, but every caller must get the one that was stored first.
+    NSMutableArray<ORKStep *> *seenSteps = [NSMutableArray array];
+    dispatch_apply(256, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t iteration) {
+        ORKStep *step = steps[iteration % 16];
+        @synchronized (seenSteps) {
+            [seenSteps addObject:step];
+        }
+    });
+    XCTAssertEqual(seenSteps.count, 256);
+    for (ORKStep *step in seenSteps) {
+        XCTAssertEqual(step, steps[[steps indexOfStepWithIdentifier:step.identifier]]);
+    }
+    XCTAssertGreaterThanOrEqual(builtIdentifiers.count, 16);
+    XCTAssertEqual([NSSet setWithArray:builtIdentifiers].count, 16);
+}
+
+- (void)testBuilderMustKeepIdentifier {
+    ORKStepTemplate *stepTemplate = [ORKStepTemplate templateWithIdentifier:@"expected" builder:^ORKStep *(NSString *stepIdentifier) {
+        return [[ORKInstructionStep alloc] initWithIdentifier:@"other"];
+    }];
+    XCTAssertThrowsSpecificNamed([stepTemplate makeStep], NSException, NSInternalInconsistencyException);
+}
+
+- (void)testTaskNavigationBuildsOnlyVisitedSteps {
+    NSMutableArray<NSString *> *builtIdentifiers = [NSMutableArray array];
+    ORKOrderedTask *task = [[ORKOrderedTask alloc] initWithIdentifier:@"task" stepTemplates:ORKStepTemplateTestTemplates(5, builtIdentifiers)];
+    ORKTaskResult *result = [[ORKTaskResult alloc] initWithIdentifier:@"task"];
+    
+    ORKStep *first = [task stepAfterStep:nil withResult:result];
+    ORKStep *second = [task stepAfterStep:first withResult:result];
+    XCTAssertEqualObjects(second.identifier, @"step1");
+    XCTAssertEqualObjects(builtIdentifiers, (@[@"step0", @"step1"]));
+    
+    XCTAssertEqualObjects([task stepWithIdentifier:@"step3"].identifier, @"step3");
+    XCTAssertEqualObjects([task stepBeforeStep:second withResult:result], first);
+    XCTAssertEqual([task indexOfStep:second], 1);
+    XCTAssertEqualObjects(builtIdentifiers, (@[@"step0", @"step1", @"step3"]));
+}
+
+- (void)testDuplicateTemplateIdentifiersAreRejected {
+    ORKStepTemplateBuilder builder = ^ORKStep *(NSString *stepIdentifier) {
+        return [[ORKInstructionStep alloc] initWithIdentifier:stepIdentifier];
+    };
+    NSArray<ORKStepTemplate *> *templates = @[[ORKStepTemplate templateWithIdentifier:@"same" builder:builder],
+                                              [ORKStepTemplate templateWithIdentifier:@"same" builder:builder]];
+    XCTAssertThrows([[ORKOrderedTask alloc] initWithIdentifier:@"task" stepTemplates:templates]);
+}
+
+- (void)testCopyKeepsUnbuiltStepsLazy {
+    NSMutableArray<NSString *> *builtIdentifiers = [NSMutableArray array];
+    ORKOrderedTask *task = [[ORKOrderedTask alloc] initWithIdentifier:@"task" stepTemplates:ORKStepTemplateTestTemplates(3, builtIdentifiers)];
+    ORKStep *built = [task stepWithIdentifier:@"step0"];
+    
+    ORKOrderedTask *copy = [task copy];
+    XCTAssertTrue([copy.steps isKindOfClass:[ORKLazyStepArray class]]);
+    ORKLazyStepArray *copiedSteps = (ORKLazyStepArray *)copy.steps;
+    XCTAssertTrue([copiedSteps isStepBuiltAtIndex:0]);
+    XCTAssertFalse([copiedSteps isStepBuiltAtIndex:1]);
+    XCTAssertNotEqual(copiedSteps[0], built);
+    XCTAssertEqualObjects(copiedSteps[0], built);
+    XCTAssertEqualObjects(builtIdentifiers, @[@"step0"]);
+}
+
+- (void)testArchivedTaskDecodesWithPlainSteps {
+    ORKOrderedTask *task = [ORKOrderedTask PSATTaskWithIdentifier:@"psat" intendedUseDescription:nil presentationMode:ORKPSATPresentationModeVisual interStimulusInterval:3 stimulusDuration:1 seriesLength:60 options:ORKPredefinedTaskOptionNone];
+    XCTAssertTrue([task.steps isKindOfClass:[ORKLazyStepArray class]]);
+    
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:task requiringSecureCoding:YES error:NULL];
+    ORKOrderedTask *decoded = [NSKeyedUnarchiver unarchivedObjectOfClass:[ORKOrderedTask class] fromData:data error:NULL];
+    XCTAssertFalse([decoded.steps isKindOfClass:[ORKLazyStepArray class]]);
+    XCTAssertEqualObjects(decoded, task);
+}
+
+- (void)testTremorTaskKeepsNavigationRulesAndLastStepInstruction {
+    ORKNavigableOrderedTask *task = [ORKOrderedTask tremorTestTaskWithIdentifier:@"tremor" intendedUseDescription:nil activeStepDuration:10 activeTaskOptions:ORKTremorActiveTaskOptionNone handOptions:ORKPredefinedTaskHandOptionRight options:ORKPredefinedTaskOptionNone];
+    NSPredicate *activeSteps = [NSPredicate predicateWithFormat:@"class == %@", [ORKActiveStep class]];
+    NSArray<ORKActiveStep *> *tremorSteps = [task.steps filteredArrayUsingPredicate:activeSteps];
+    XCTAssertEqual(tremorSteps.count, 5);
+    XCTAssertNotNil(tremorSteps.lastObject.finishedSpokenInstruction);
+    XCTAssertNotEqualObjects(tremorSteps.lastObject.finishedSpokenInstruction, tremorSteps.firstObject.finishedSpokenInstruction);
+    
+    ORKNavigableOrderedTask *bothHands = [ORKOrderedTask tremorTestTaskWithIdentifier:@"tremor" intendedUseDescription:nil activeStepDuration:10 activeTaskOptions:ORKTremorActiveTaskOptionNone handOptions:ORKPredefinedTaskHandOptionBoth options:ORKPredefinedTaskOptionNone];
+    XCTAssertNotNil([bothHands navigationRuleForTriggerStepIdentifier:@"skipHand"]);
+}
+
+- (void)testPredefinedTaskConstructionPerformance {
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        NSArray<ORKOrderedTask *> *tasks = ORKStepTemplateTestMakePredefinedTasks();
+        XCTAssertEqual(tasks.count, 23);
+    }];
+}
+
+@end
@@ -242,6 +242,24 @@
     XCTAssertThrows([validReactionTimeStep validateParameters]);
 }
 
+- (void)testViewControllerResultsRecordSeed {
+    NSArray<ORKStepViewController *> *stepViewControllers = @[
+        [[ORKReactionTimeViewController alloc] initWithStep:[[ORKReactionTimeStep alloc] initWithIdentifier:@"ReactionTimeStep"]],
+        [[ORKNormalizedReactionTimeViewController alloc] initWithStep:[[ORKNormalizedReactionTimeStep alloc] initWithIdentifier:@"NormalizedReactionTimeStep"]]
+    ];
+    for (ORKStepViewController *stepViewController in stepViewControllers) {
+        stepViewController.randomNumberGenerator = [[ORKRandomNumberGenerator alloc] initWithSeed:42];
+        ORKRandomSeedResult *seedResult = nil;
+        for (ORKResult *result in stepViewController.result.results) {
+            if ([result isKindOfClass:[ORKRandomSeedResult class]]) {
+                seedResult = (ORKRandomSeedResult *)result;
+            }
+        }
+        XCTAssertNotNil(seedResult, @"%@", stepViewController.class);
+        XCTAssertEqual(seedResult.seed, 42);
+    }
+}
+
 @end
 
 @interface ORKPageStepTests : XCTestCase
@@ -0,0 +1,335 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKit;
+@import ResearchKit_Private;
+
+
+// A signature of about four hundred curves, as drawn on a 3x display.
+static const NSUInteger ORKStrokeCount = 40;
+static const NSUInteger ORKCurvesPerStroke = 10;
+static const CGFloat ORKDisplayScale = 3;
+
+
+typedef struct {
+    CGPathElementType type;
+    CGPoint points[3];
+} ORKTestPathElement;
+
+static NSData *ORKElementsOfPath(UIBezierPath *path) {
+    NSMutableData *elements = [NSMutableData data];
+    CGPathApplyWithBlock(path.CGPath, ^(const CGPathElement *pathElement) {
+        ORKTestPathElement element = { .type = pathElement->type };
+        NSUInteger count = (pathElement->type == kCGPathElementAddCurveToPoint ? 3 :
+                            pathElement->type == kCGPathElementAddQuadCurveToPoint ? 2 :
+                            pathElement->type == kCGPathElementCloseSubpath ? 0 : 1);
+        for (NSUInteger i = 0; i < count; i++) {
+            element.points[i] = pathElement->points[i];
+        }
+        [elements appendBytes:&element length:sizeof(element)];
+    });
+    return elements;
+}
+
+
+@interface ORKStrokeCodecTests : XCTestCase
+
+@end
+
+
+@implementation ORKStrokeCodecTests
+
+// Builds paths the way the signature view does: round quadratic curves through the midpoints
+// between touch locations, split where the line width steps.
+- (NSArray<UIBezierPath *> *)signaturePathsWithGrid:(CGFloat)grid {
+    NSMutableArray<UIBezierPath *> *paths = [NSMutableArray array];
+    for (NSUInteger stroke = 0; stroke < ORKStrokeCount; stroke++) {
+        CGPoint previous = CGPointMake(20 + (stroke * 37) % 220, 20 + (stroke * 53) % 140);
+        UIBezierPath *path = nil;
+        for (NSUInteger step = 1; step <= ORKCurvesPerStroke; step++) {
+            if (path == nil || step % 4 == 0) {
+                CGPoint start = path ? path.currentPoint : previous;
+                path = [UIBezierPath bezierPath];
+                path.lineCapStyle = kCGLineCapRound;
+                path.lineJoinStyle = kCGLineJoinRound;
+                path.lineWidth = 1 + (step / 4) * 0.25;
+                [path moveToPoint:start];
+                [paths addObject:path];
+            }
+            CGPoint point = CGPointMake(round((previous.x + 5.3) * grid) / grid,
+                                        round((previous.y + 9 * sin(step * 0.7 + stroke)) * grid) / grid);
+            [path addQuadCurveToPoint:CGPointMake((point.x + previous.x) / 2, (point.y + previous.y) / 2)
+                         controlPoint:previous];
+            previous = point;
+        }
+    }
+    return paths;
+}
+
+- (NSArray<NSData *> *)samplesWithStrokes:(NSUInteger)strokeCount {
+    NSMutableArray<NSData *> *strokes = [NSMutableArray array];
+    for (NSUInteger stroke = 0; stroke < strokeCount; stroke++) {
+        NSMutableData *data = [NSMutableData data];
+        for (NSUInteger i = 0; i < 60; i++) {
+            // Touches are reported at 240 Hz, in seconds since system startup.
+            ORKStrokeSample sample = {
+                .location = CGPointMake(20 + i * 1.5, 40 + 10 * sin(i * 0.2 + stroke)),
+                .timestamp = 86400.0 + stroke * 0.75 + i / 240.0
+            };
+            [data appendBytes:&sample length:sizeof(sample)];
+        }
+        [strokes addObject:data];
+    }
+    return strokes;
+}
+
+- (void)assertPaths:(NSArray<UIBezierPath *> *)actual equalPaths:(NSArray<UIBezierPath *> *)expected accuracy:(CGFloat)accuracy {
+    XCTAssertEqual(actual.count, expected.count);
+    for (NSUInteger i = 0; i < MIN(actual.count, expected.count); i++) {
+        XCTAssertEqual(actual[i].lineWidth, expected[i].lineWidth);
+        XCTAssertEqual(actual[i].lineCapStyle, expected[i].lineCapStyle);
+        XCTAssertEqual(actual[i].lineJoinStyle, expected[i].lineJoinStyle);
+        NSData *actualElements = ORKElementsOfPath(actual[i]);
+        NSData *expectedElements = ORKElementsOfPath(expected[i]);
+        XCTAssertEqual(actualElements.length, expectedElements.length);
+        if (actualElements.length != expectedElements.length) {
+            continue;
+        }
+        const ORKTestPathElement *actualElement = actualElements.bytes;
+        const ORKTestPathElement *expectedElement = expectedElements.bytes;
+        for (NSUInteger e = 0; e < actualElements.length / sizeof(ORKTestPathElement); e++) {
+            XCTAssertEqual(actualElement[e].type, expectedElement[e].type);
+            for (NSUInteger p = 0; p < 3; p++) {
+                XCTAssertEqualWithAccuracy(actualElement[e].points[p].x, expectedElement[e].points[p].x, accuracy);
+                XCTAssertEqualWithAccuracy(actualElement[e].points[p].y, expectedElement[e].points[p].y, accuracy);
+            }
+        }
+    }
+}
+
+- (void)testPaths_onTheEncodingGrid_roundTripExactly {
+    NSArray<UIBezierPath *> *paths = [self signaturePathsWithGrid:2];
+    ORKStrokeCodec *codec = [ORKStrokeCodec new];
+    NSError *error = nil;
+    NSArray<UIBezierPath *> *decoded = [ORKStrokeCodec pathsWithData:[codec dataWithPaths:paths] error:&error];
+    XCTAssertNil(error);
+    [self assertPaths:decoded equalPaths:paths accuracy:0];
+    for (NSUInteger i = 0; i < paths.count; i++) {
+        XCTAssertTrue(CGPathEqualToPath(decoded[i].CGPath, paths[i].CGPath));
+    }
+}
+
+- (void)testPaths_offTheEncodingGrid_roundTripWithinHalfAUnit {
+    NSArray<UIBezierPath *> *paths = [self signaturePathsWithGrid:ORKDisplayScale];
+    ORKStrokeCodec *codec = [ORKStrokeCodec new];
+    NSData *data = [codec dataWithPaths:paths];
+    NSArray<UIBezierPath *> *decoded = [ORKStrokeCodec pathsWithData:data error:NULL];
+    [self assertPaths:decoded equalPaths:paths accuracy:0.5 / codec.unitsPerPoint];
+    
+    // Decoding is lossless at the precision of the encoding.
+    XCTAssertEqualObjects([codec dataWithPaths:decoded], data);
+}
+
+- (void)testPaths_withEveryElementType_roundTrip {
+    UIBezierPath *path = [UIBezierPath bezierPathWithOvalInRect:CGRectMake(10, 10, 40, 30)];
+    [path moveToPoint:CGPointMake(-5, 100.25)];
+    [path addLineToPoint:CGPointMake(1000, -3.5)];
+    [path addQuadCurveToPoint:CGPointMake(12, 14) controlPoint:CGPointMake(8.125, 2)];
+    [path closePath];
+    path.lineWidth = 2.75;
+    path.lineCapStyle = kCGLineCapSquare;
+    path.lineJoinStyle = kCGLineJoinBevel;
+    
+    ORKStrokeCodec *codec = [[ORKStrokeCodec alloc] initWithUnitsPerPoint:1024];
+    NSArray<UIBezierPath *> *decoded = [ORKStrokeCodec pathsWithData:[codec dataWithPaths:@[path, [UIBezierPath bezierPath]]] error:NULL];
+    [self assertPaths:decoded equalPaths:@[path, [UIBezierPath bezierPath]] accuracy:0.5 / 1024];
+}
+
+- (void)testSamples_roundTripWithTimestamps {
+    NSArray<NSData *> *strokes = [self samplesWithStrokes:5];
+    ORKStrokeCodec *codec = [ORKStrokeCodec new];
+    NSData *data = [codec dataWithSamples:strokes];
+    NSError *error = nil;
+    NSArray<NSData *> *decoded = [ORKStrokeCodec samplesWithData:data error:&error];
+    XCTAssertNil(error);
+    XCTAssertEqual(decoded.count, strokes.count);
+    for (NSUInteger s = 0; s < strokes.count; s++) {
+        XCTAssertEqual(decoded[s].length, strokes[s].length);
+        const ORKStrokeSample *actual = decoded[s].bytes;
+        const ORKStrokeSample *expected = strokes[s].bytes;
+        for (NSUInteger i = 0; i < strokes[s].length / sizeof(ORKStrokeSample); i++) {
+            XCTAssertEqualWithAccuracy(actual[i].location.x, expected[i].location.x, 0.5 / codec.unitsPerPoint);
+            XCTAssertEqualWithAccuracy(actual[i].location.y, expected[i].location.y, 0.5 / codec.unitsPerPoint);
+            XCTAssertEqualWithAccuracy(actual[i].timestamp, expected[i].timestamp, 5e-6);
+        }
+    }
+    XCTAssertEqualObjects([codec dataWithSamples:decoded], data);
+    
+    // Two bytes a coordinate, however large the timestamps.
+    XCTAssertLessThan(data.length, 5 * 60 * 6 + 64);
+}
+
+- (void)testSimplification_keepsPolylinesWithinTolerance {
+    ORKStrokeCodec *codec = [ORKStrokeCodec new];
+    codec.simplificationTolerance = 0.5;
+    
+    NSArray<NSData *> *strokes = [self samplesWithStrokes:1];
+    NSArray<NSData *> *simplified = [ORKStrokeCodec samplesWithData:[codec dataWithSamples:strokes] error:NULL];
+    NSUInteger count = strokes[0].length / sizeof(ORKStrokeSample);
+    NSUInteger simplifiedCount = simplified[0].length / sizeof(ORKStrokeSample);
+    XCTAssertLessThan(simplifiedCount, count / 2);
+    
+    // The ends and the timing of the samples that are kept do not change.
+    const ORKStrokeSample *original = strokes[0].bytes;
+    const ORKStrokeSample *kept = simplified[0].bytes;
+    XCTAssertEqualWithAccuracy(kept[0].timestamp, original[0].timestamp, 5e-6);
+    XCTAssertEqualWithAccuracy(kept[simplifiedCount - 1].timestamp, original[count - 1].timestamp, 5e-6);
+    
+    // Every original sample lies within the tolerance of the simplified polyline.
+    for (NSUInteger i = 0; i < count; i++) {
+        CGFloat nearest = CGFLOAT_MAX;
+        for (NSUInteger k = 0; k + 1 < simplifiedCount; k++) {
+            CGPoint a = kept[k].location;
+            CGPoint b = kept[k + 1].location;
+            CGPoint p = original[i].location;
+            CGFloat t = ((p.x - a.x) * (b.x - a.x) + (p.y - a.y) * (b.y - a.y)) /
+                        ((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y));
+            t = MAX(0, MIN(1, t));
+            nearest = MIN(nearest, hypot(a.x + t * (b.x - a.x) - p.x, a.y + t * (b.y - a.y) - p.y));
+        }
+        XCTAssertLessThanOrEqual(nearest, 0.5 + 1.0 / codec.unitsPerPoint);
+    }
+    
+    // Runs of line segments are simplified; curves are kept.
+    UIBezierPath *path = [UIBezierPath bezierPath];
+    [path moveToPoint:CGPointZero];
+    for (NSUInteger i = 1; i <= 20; i++) {
+        [path addLineToPoint:CGPointMake(i, (i % 2) * 0.1)];
+    }
+    [path addQuadCurveToPoint:CGPointMake(30, 0) controlPoint:CGPointMake(25, 0.1)];
+    NSArray<UIBezierPath *> *paths = [ORKStrokeCodec pathsWithData:[codec dataWithPaths:@[path]] error:NULL];
+    UIBezierPath *expected = [UIBezierPath bezierPath];
+    [expected moveToPoint:CGPointZero];
+    [expected addLineToPoint:CGPointMake(20, 0)];
+    [expected addQuadCurveToPoint:CGPointMake(30, 0) controlPoint:CGPointMake(25, 0.1)];
+    [self assertPaths:paths equalPaths:@[expected] accuracy:0.5 / codec.unitsPerPoint];
+}
+
+- (void)testDecoding_malformedData_fails {
+    ORKStrokeCodec *codec = [ORKStrokeCodec new];
+    NSData *paths = [codec dataWithPaths:[self signaturePathsWithGrid:2]];
+    NSData *samples = [codec dataWithSamples:[self samplesWithStrokes:2]];
+    
+    NSError *error = nil;
+    XCTAssertNil([ORKStrokeCodec pathsWithData:[paths subdataWithRange:NSMakeRange(0, paths.length - 1)] error:&error]);
+    XCTAssertEqualObjects(error.domain, ORKErrorDomain);
+    XCTAssertEqual(error.code, ORKErrorInvalidObject);
+    
+    XCTAssertNil([ORKStrokeCodec samplesWithData:[samples subdataWithRange:NSMakeRange(0, samples.length / 2)] error:NULL]);
+    XCTAssertNil([ORKStrokeCodec samplesWithData:paths error:NULL]);
+    XCTAssertNil([ORKStrokeCodec pathsWithData:samples error:NULL]);
+    XCTAssertNil([ORKStrokeCodec pathsWithData:[NSData data] error:NULL]);
+}
+
+- (void)testSignatureResult_archivesStrokes {
+    NSArray<UIBezierPath *> *paths = [self signaturePathsWithGrid:2];
+    // Timestamps on the 10 microsecond grid of the encoding come back unchanged.
+    NSMutableData *stroke = [NSMutableData data];
+    for (NSUInteger i = 0; i < 10; i++) {
+        ORKStrokeSample sample = { CGPointMake(i * 2.5, 10), (8640000000 + i * 417) / 100000.0 };
+        [stroke appendBytes:&sample length:sizeof(sample)];
+    }
+    ORKSignatureResult *result = [[ORKSignatureResult alloc] initWithIdentifier:@"signature"
+                                                                 signatureImage:nil
+                                                                  signaturePath:paths
+                                                                  strokeSamples:@[stroke]];
+    
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:result requiringSecureCoding:YES error:NULL];
+    ORKSignatureResult *decoded = [NSKeyedUnarchiver unarchivedObjectOfClass:[ORKSignatureResult class] fromData:data error:NULL];
+    [self assertPaths:decoded.signaturePath equalPaths:paths accuracy:0];
+    XCTAssertEqualObjects(decoded.strokeSamples, @[stroke]);
+    
+    ORKSignatureResult *withoutStrokes = [[ORKSignatureResult alloc] initWithIdentifier:@"signature" signatureImage:nil signaturePath:nil];
+    data = [NSKeyedArchiver archivedDataWithRootObject:withoutStrokes requiringSecureCoding:YES error:NULL];
+    decoded = [NSKeyedUnarchiver unarchivedObjectOfClass:[ORKSignatureResult class] fromData:data error:NULL];
+    XCTAssertNil(decoded.signaturePath);
+    XCTAssertNil(decoded.strokeSamples);
+}
+
+- (void)testSignatureResult_drawsImageAtAnyScale {
+    UIBezierPath *path = [UIBezierPath bezierPath];
+    [path moveToPoint:CGPointMake(10, 10)];
+    [path addLineToPoint:CGPointMake(90, 30)];
+    path.lineWidth = 4;
+    ORKSignatureResult *result = [[ORKSignatureResult alloc] initWithIdentifier:@"signature" signatureImage:nil signaturePath:@[path]];
+    
+    UIImage *image = [result signatureImageWithScale:4];
+    XCTAssertTrue(CGSizeEqualToSize(image.size, CGSizeMake(92, 32)));
+    XCTAssertEqual(image.scale, 4);
+    XCTAssertEqual(CGImageGetWidth(image.CGImage), 368);
+    
+    XCTAssertNil([[[ORKSignatureResult alloc] initWithIdentifier:@"signature" signatureImage:nil signaturePath:nil] signatureImageWithScale:2]);
+}
+
+#pragma mark - Benchmarks
+
+- (void)testEncodedSize_isAFractionOfArchivedPaths {
+    NSArray<UIBezierPath *> *paths = [self signaturePathsWithGrid:ORKDisplayScale];
+    NSData *compact = [[ORKStrokeCodec new] dataWithPaths:paths];
+    NSData *archived = [NSKeyedArchiver archivedDataWithRootObject:paths requiringSecureCoding:YES error:NULL];
+    XCTAssertLessThan(compact.length * 4, archived.length, @"%lu compact bytes against %lu archived bytes",
+                      (unsigned long)compact.length, (unsigned long)archived.length);
+}
+
+- (void)testEncodingPerformance {
+    NSArray<UIBezierPath *> *paths = [self signaturePathsWithGrid:ORKDisplayScale];
+    ORKStrokeCodec *codec = [ORKStrokeCodec new];
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        for (NSUInteger i = 0; i < 100; i++) {
+            NSData *data = [codec dataWithPaths:paths];
+            [ORKStrokeCodec pathsWithData:data error:NULL];
+        }
+    }];
+}
+
+- (void)testArchivingPerformance {
+    NSArray<UIBezierPath *> *paths = [self signaturePathsWithGrid:ORKDisplayScale];
+    NSSet *classes = [NSSet setWithObjects:[NSArray class], [UIBezierPath class], nil];
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        for (NSUInteger i = 0; i < 100; i++) {
+            NSData *data = [NSKeyedArchiver archivedDataWithRootObject:paths requiringSecureCoding:YES error:NULL];
+            [NSKeyedUnarchiver unarchivedObjectOfClasses:classes fromData:data error:NULL];
+        }
+    }];
+}
+
+@end
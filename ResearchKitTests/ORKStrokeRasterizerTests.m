@@ -0,0 +1,245 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKitUI;
+@import ResearchKitUI_Private;
+
+
+static const CGSize ORKStrokeCanvasSize = { 320, 200 };
+static const CGFloat ORKStrokeCanvasScale = 2;
+static const uint8_t ORKStrokeMaximumPixelDifference = 4;
+
+
+@interface ORKStrokeRasterizerTests : XCTestCase
+
+@end
+
+
+@implementation ORKStrokeRasterizerTests
+
+// A white canvas whose coordinates are flipped like those of -[UIView drawRect:].
+static CGContextRef ORKCreateCanvas(CGFloat scale) {
+    size_t width = (size_t)(ORKStrokeCanvasSize.width * scale);
+    size_t height = (size_t)(ORKStrokeCanvasSize.height * scale);
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceGray();
+    CGContextRef context = CGBitmapContextCreate(NULL, width, height, 8, 0, colorSpace, (CGBitmapInfo)kCGImageAlphaNone);
+    CGColorSpaceRelease(colorSpace);
+    CGContextSetGrayFillColor(context, 1.0, 1.0);
+    CGContextFillRect(context, CGRectMake(0, 0, width, height));
+    CGContextTranslateCTM(context, 0, height);
+    CGContextScaleCTM(context, scale, -scale);
+    return context;
+}
+
+static uint8_t ORKMaximumPixelDifference(CGContextRef context1, CGContextRef context2) {
+    const uint8_t *pixels1 = CGBitmapContextGetData(context1);
+    const uint8_t *pixels2 = CGBitmapContextGetData(context2);
+    size_t bytesPerRow = CGBitmapContextGetBytesPerRow(context1);
+    size_t width = CGBitmapContextGetWidth(context1);
+    uint8_t maximum = 0;
+    for (size_t row = 0; row < CGBitmapContextGetHeight(context1); row++) {
+        for (size_t column = 0; column < width; column++) {
+            size_t index = row * bytesPerRow + column;
+            uint8_t difference = (uint8_t)abs((int)pixels1[index] - (int)pixels2[index]);
+            maximum = MAX(maximum, difference);
+        }
+    }
+    return maximum;
+}
+
+// Strokes every path, as the views used to on each frame.
+static CGContextRef ORKCreateCanvasWithPaths(CGFloat scale, NSArray<NSArray *> *paths, CGColorRef color) {
+    CGContextRef context = ORKCreateCanvas(scale);
+    CGContextSetStrokeColorWithColor(context, color);
+    CGContextSetLineCap(context, kCGLineCapRound);
+    CGContextSetLineJoin(context, kCGLineJoinRound);
+    CGContextSetFlatness(context, 0.6);
+    for (NSArray *entry in paths) {
+        CGContextSetLineWidth(context, [entry[1] doubleValue]);
+        CGContextAddPath(context, (__bridge CGPathRef)entry[0]);
+        CGContextStrokePath(context);
+    }
+    return context;
+}
+
+static CGColorRef ORKBlackColor(void) {
+    static CGColorRef color;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceGray();
+        color = CGColorCreate(colorSpace, (CGFloat[]){ 0.0, 1.0 });
+        CGColorSpaceRelease(colorSpace);
+    });
+    return color;
+}
+
+// Draws `count` wavy strokes the way the signature view does, stepping the line width every few
+// points, and returns each finished path with its line width.
+- (NSArray<NSArray *> *)drawStrokes:(NSUInteger)count withRasterizer:(ORKStrokeRasterizer *)rasterizer {
+    NSMutableArray<NSArray *> *paths = [NSMutableArray array];
+    void (^commit)(void) = ^{
+        CGPathRef path = CGPathCreateCopy(rasterizer.strokePath);
+        CGFloat lineWidth = rasterizer.strokeLineWidth;
+        if ([rasterizer commitStrokePath]) {
+            [paths addObject:@[(__bridge id)path, @(lineWidth)]];
+        }
+        CGPathRelease(path);
+    };
+    
+    for (NSUInteger stroke = 0; stroke < count; stroke++) {
+        CGPoint origin = CGPointMake(20 + (stroke * 37) % 220, 20 + (stroke * 53) % 140);
+        CGPoint previous = origin;
+        [rasterizer beginStrokeAtPoint:origin previousPoint:origin lineWidth:1];
+        for (NSUInteger step = 1; step <= 12; step++) {
+            CGPoint point = CGPointMake(origin.x + step * 6, origin.y + 12 * sin(step * 0.7 + stroke));
+            if (step % 4 == 0) {
+                commit();
+                [rasterizer restartStrokePathWithLineWidth:1 + (step / 4) * 0.25];
+            }
+            [rasterizer extendStrokeToPoint:point previousPoint:previous];
+            previous = point;
+        }
+        commit();
+    }
+    return paths;
+}
+
+- (void)testExtendStroke_smoothsThroughMidpoints {
+    ORKStrokeRasterizer *rasterizer = [[ORKStrokeRasterizer alloc] initWithScale:2];
+    [rasterizer beginStrokeAtPoint:CGPointMake(10, 10) previousPoint:CGPointMake(8, 10) lineWidth:2];
+    CGRect drawBox = [rasterizer extendStrokeToPoint:CGPointMake(20, 14) previousPoint:CGPointMake(10, 10)];
+    [rasterizer extendStrokeToPoint:CGPointMake(30, 10) previousPoint:CGPointMake(20, 14)];
+    
+    CGMutablePathRef expected = CGPathCreateMutable();
+    CGPathMoveToPoint(expected, NULL, 10, 10);
+    CGPathAddArc(expected, NULL, 10, 10, 0.1, 0.0, 2.0 * M_PI, false);
+    CGPathAddQuadCurveToPoint(expected, NULL, 10, 10, 15, 12);
+    CGPathAddQuadCurveToPoint(expected, NULL, 20, 14, 25, 12);
+    XCTAssertTrue(CGPathEqualToPath(rasterizer.strokePath, expected));
+    CGPathRelease(expected);
+    
+    // The hull of (9, 10), (10, 10) and (15, 12), outset by twice the line width.
+    XCTAssertTrue(CGRectEqualToRect(drawBox, CGRectMake(5, 6, 14, 10)));
+    
+    [rasterizer commitStrokePath];
+    [rasterizer restartStrokePathWithLineWidth:2.25];
+    XCTAssertTrue(CGPointEqualToPoint(CGPathGetCurrentPoint(rasterizer.strokePath), CGPointMake(25, 12)));
+    XCTAssertEqual(rasterizer.strokeLineWidth, 2.25);
+}
+
+- (void)testCommitStrokePath_withEmptyPath_discardsIt {
+    ORKStrokeRasterizer *rasterizer = [[ORKStrokeRasterizer alloc] initWithScale:2];
+    [rasterizer beginStrokeAtPoint:CGPointMake(10, 10) previousPoint:CGPointMake(10, 10) lineWidth:1];
+    XCTAssertTrue([rasterizer commitStrokePath]);
+    [rasterizer restartStrokePathWithLineWidth:1];
+    XCTAssertFalse([rasterizer commitStrokePath]);
+    XCTAssertEqual(rasterizer.numberOfStrokePaths, 1);
+    XCTAssertTrue(CGRectIsNull([rasterizer extendStrokeToPoint:CGPointMake(20, 20) previousPoint:CGPointMake(10, 10)]));
+}
+
+- (void)testDraw_matchesStrokingEveryPath {
+    ORKStrokeRasterizer *rasterizer = [[ORKStrokeRasterizer alloc] initWithScale:ORKStrokeCanvasScale];
+    NSArray<NSArray *> *paths = [self drawStrokes:40 withRasterizer:rasterizer];
+    XCTAssertEqual(rasterizer.numberOfStrokePaths, paths.count);
+    
+    CGContextRef expected = ORKCreateCanvasWithPaths(ORKStrokeCanvasScale, paths, ORKBlackColor());
+    CGRect bounds = { CGPointZero, ORKStrokeCanvasSize };
+    CGContextRef actual = ORKCreateCanvas(ORKStrokeCanvasScale);
+    [rasterizer drawInContext:actual rect:bounds color:ORKBlackColor()];
+    XCTAssertLessThanOrEqual(ORKMaximumPixelDifference(expected, actual), ORKStrokeMaximumPixelDifference);
+    
+    // Redrawing a dirty rectangle across tile boundaries leaves the same pixels.
+    CGRect dirtyRect = CGRectMake(100, 40, 90, 90);
+    CGContextSetGrayFillColor(actual, 1.0, 1.0);
+    CGContextFillRect(actual, dirtyRect);
+    [rasterizer drawInContext:actual rect:dirtyRect color:ORKBlackColor()];
+    XCTAssertLessThanOrEqual(ORKMaximumPixelDifference(expected, actual), ORKStrokeMaximumPixelDifference);
+    
+    CGContextRelease(expected);
+    CGContextRelease(actual);
+}
+
+- (void)testSetScale_rasterizesStrokesAgain {
+    ORKStrokeRasterizer *rasterizer = [[ORKStrokeRasterizer alloc] initWithScale:ORKStrokeCanvasScale];
+    NSArray<NSArray *> *paths = [self drawStrokes:40 withRasterizer:rasterizer];
+    rasterizer.scale = 3;
+    
+    CGContextRef expected = ORKCreateCanvasWithPaths(3, paths, ORKBlackColor());
+    CGContextRef actual = ORKCreateCanvas(3);
+    [rasterizer drawInContext:actual rect:(CGRect){ CGPointZero, ORKStrokeCanvasSize } color:ORKBlackColor()];
+    XCTAssertLessThanOrEqual(ORKMaximumPixelDifference(expected, actual), ORKStrokeMaximumPixelDifference);
+    
+    CGContextRelease(expected);
+    CGContextRelease(actual);
+}
+
+- (void)testRemoveAllStrokes_freesTiles {
+    ORKStrokeRasterizer *rasterizer = [[ORKStrokeRasterizer alloc] initWithScale:ORKStrokeCanvasScale];
+    [self drawStrokes:10 withRasterizer:rasterizer];
+    XCTAssertGreaterThan(rasterizer.numberOfTiles, 0);
+    // 256-pixel tiles over a 640 by 400 pixel canvas.
+    XCTAssertLessThanOrEqual(rasterizer.numberOfTiles, 6);
+    
+    [rasterizer removeAllStrokes];
+    XCTAssertEqual(rasterizer.numberOfTiles, 0);
+    XCTAssertEqual(rasterizer.numberOfStrokePaths, 0);
+    XCTAssertTrue(rasterizer.strokePath == NULL);
+}
+
+- (void)measureFrameCostWithStrokeCount:(NSUInteger)strokeCount {
+    ORKStrokeRasterizer *rasterizer = [[ORKStrokeRasterizer alloc] initWithScale:ORKStrokeCanvasScale];
+    [self drawStrokes:strokeCount withRasterizer:rasterizer];
+    CGContextRef context = ORKCreateCanvas(ORKStrokeCanvasScale);
+    
+    // One frame per touch of a new stroke, each redrawing the dirty rectangle the views would.
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        CGPoint previous = CGPointMake(10, 100);
+        [rasterizer beginStrokeAtPoint:previous previousPoint:previous lineWidth:1];
+        for (NSUInteger frame = 0; frame < 300; frame++) {
+            CGPoint point = CGPointMake(10 + frame, 100 + 40 * sin(frame * 0.1));
+            CGRect dirtyRect = [rasterizer extendStrokeToPoint:point previousPoint:previous];
+            [rasterizer drawInContext:context rect:dirtyRect color:ORKBlackColor()];
+            previous = point;
+        }
+    }];
+    CGContextRelease(context);
+}
+
+- (void)testPerformance_frameCostWith100Strokes {
+    [self measureFrameCostWithStrokeCount:100];
+}
+
+- (void)testPerformance_frameCostWith5000Strokes {
+    [self measureFrameCostWithStrokeCount:5000];
+}
+
+@end
@@ -0,0 +1,251 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKit_Private;
+@import ResearchKitActiveTask;
+@import ResearchKitActiveTask_Private;
+
+
+static const NSUInteger ORKTappingSampleBenchmarkTapCount = 10000;
+
+// How often the benchmarks ask for a result, as the task view controller does while the step runs.
+static const NSUInteger ORKTappingSampleBenchmarkResultInterval = 100;
+
+static ORKTappingSample *ORKTappingTestSample(NSTimeInterval timestamp, NSTimeInterval duration, CGPoint location, ORKTappingButtonIdentifier buttonIdentifier) {
+    ORKTappingSample *sample = [[ORKTappingSample alloc] init];
+    sample.timestamp = timestamp;
+    sample.duration = duration;
+    sample.location = location;
+    sample.buttonIdentifier = buttonIdentifier;
+    return sample;
+}
+
+
+// Archives the way results were written before samples were packed.
+@interface _ORKTappingLegacyIntervalResult : ORKTappingIntervalResult
+
+@property (nonatomic, copy) NSArray<ORKTappingSample *> *legacySamples;
+
+@end
+
+
+@implementation _ORKTappingLegacyIntervalResult
+
+- (void)encodeWithCoder:(NSCoder *)aCoder {
+    self.samples = nil;
+    [super encodeWithCoder:aCoder];
+    [aCoder encodeObject:self.legacySamples forKey:@"samples"];
+}
+
+- (Class)classForKeyedArchiver {
+    return [ORKTappingIntervalResult class];
+}
+
+@end
+
+
+@interface ORKTappingSampleBufferTests : XCTestCase
+
+@end
+
+
+@implementation ORKTappingSampleBufferTests
+
+- (void)testReleaseClosesMostRecentOpenPressOnButton {
+    ORKTappingSampleBuffer *buffer = [ORKTappingSampleBuffer new];
+    [buffer appendSampleWithTimestamp:1.0 location:CGPointMake(1, 1) buttonIdentifier:ORKTappingButtonIdentifierLeft];
+    [buffer appendSampleWithTimestamp:1.1 location:CGPointMake(2, 2) buttonIdentifier:ORKTappingButtonIdentifierRight];
+    [buffer appendSampleWithTimestamp:1.2 location:CGPointMake(3, 3) buttonIdentifier:ORKTappingButtonIdentifierLeft];
+    [buffer appendSampleWithTimestamp:1.3 location:CGPointMake(4, 4) buttonIdentifier:ORKTappingButtonIdentifierNone];
+    
+    XCTAssertTrue([buffer closeOpenSampleForButton:ORKTappingButtonIdentifierLeft atTimestamp:1.5]);
+    XCTAssertTrue([buffer closeOpenSampleForButton:ORKTappingButtonIdentifierLeft atTimestamp:2.0]);
+    XCTAssertFalse([buffer closeOpenSampleForButton:ORKTappingButtonIdentifierLeft atTimestamp:2.5]);
+    XCTAssertTrue([buffer closeOpenSampleForButton:ORKTappingButtonIdentifierRight atTimestamp:1.6]);
+    XCTAssertFalse([buffer closeOpenSampleForButton:ORKTappingButtonIdentifierNone atTimestamp:2.0]);
+    
+    NSArray<ORKTappingSample *> *samples = [buffer snapshot];
+    XCTAssertEqual(samples.count, 4);
+    XCTAssertEqualWithAccuracy(samples[0].duration, 1.0, 1e-9);
+    XCTAssertEqualWithAccuracy(samples[1].duration, 0.5, 1e-9);
+    XCTAssertEqualWithAccuracy(samples[2].duration, 0.3, 1e-9);
+    XCTAssertEqual(samples[3].duration, 0);
+    XCTAssertEqual(samples[3].buttonIdentifier, ORKTappingButtonIdentifierNone);
+    XCTAssertTrue(CGPointEqualToPoint(samples[2].location, CGPointMake(3, 3)));
+}
+
+- (void)testSnapshotDoesNotObserveLaterTaps {
+    ORKTappingSampleBuffer *buffer = [ORKTappingSampleBuffer new];
+    [buffer appendSampleWithTimestamp:1.0 location:CGPointZero buttonIdentifier:ORKTappingButtonIdentifierLeft];
+    
+    ORKTappingSampleArray *snapshot = [buffer snapshot];
+    XCTAssertEqual([buffer snapshot], snapshot);
+    
+    [buffer closeOpenSampleForButton:ORKTappingButtonIdentifierLeft atTimestamp:1.25];
+    [buffer appendSampleWithTimestamp:2.0 location:CGPointZero buttonIdentifier:ORKTappingButtonIdentifierRight];
+    
+    XCTAssertEqual(snapshot.count, 1);
+    XCTAssertEqual(snapshot[0].duration, 0);
+    
+    ORKTappingSampleArray *laterSnapshot = [buffer snapshot];
+    XCTAssertNotEqual(laterSnapshot, snapshot);
+    XCTAssertEqual(laterSnapshot.count, 2);
+    XCTAssertEqualWithAccuracy(laterSnapshot[0].duration, 0.25, 1e-9);
+    XCTAssertEqual([laterSnapshot copy], laterSnapshot);
+}
+
+- (void)testSampleArrayEqualsSampleObjects {
+    NSArray<ORKTappingSample *> *samples = @[ORKTappingTestSample(0.5, 0.1, CGPointMake(10, 20), ORKTappingButtonIdentifierLeft),
+                                             ORKTappingTestSample(0.75, 0, CGPointMake(-3, 4.5), ORKTappingButtonIdentifierNone)];
+    ORKTappingSampleArray *sampleArray = [ORKTappingSampleArray sampleArrayWithSamples:samples];
+    ORKTappingSampleArray *otherArray = [[ORKTappingSampleArray alloc] initWithObjects:samples.firstObject, samples.lastObject, nil];
+    
+    XCTAssertEqualObjects(sampleArray, otherArray);
+    XCTAssertEqualObjects(sampleArray, samples);
+    XCTAssertEqualObjects(samples, sampleArray);
+    XCTAssertEqual([ORKTappingSampleArray sampleArrayWithSamples:sampleArray], sampleArray);
+    
+    NSUInteger enumerated = 0;
+    for (ORKTappingSample *sample in sampleArray) {
+        XCTAssertEqualObjects(sample, samples[enumerated]);
+        enumerated++;
+    }
+    XCTAssertEqual(enumerated, samples.count);
+}
+
+- (void)testArchivedRecordsRoundTrip {
+    ORKTappingSampleBuffer *buffer = [ORKTappingSampleBuffer new];
+    for (NSUInteger index = 0; index < 300; index++) {
+        ORKTappingButtonIdentifier button = (ORKTappingButtonIdentifier)(index % 3);
+        [buffer appendSampleWithTimestamp:index * 0.1 location:CGPointMake(index, -(CGFloat)index / 3) buttonIdentifier:button];
+        [buffer closeOpenSampleForButton:button atTimestamp:index * 0.1 + 0.05];
+    }
+    ORKTappingSampleArray *samples = [buffer snapshot];
+    NSData *data = [samples archivedRecords];
+    XCTAssertEqual(data.length, 300 * 40);
+    XCTAssertEqualObjects([ORKTappingSampleArray sampleArrayWithArchivedRecords:data], samples);
+    XCTAssertNil([ORKTappingSampleArray sampleArrayWithArchivedRecords:[data subdataWithRange:NSMakeRange(0, 39)]]);
+}
+
+- (void)testResultSecureCodingUsesPackedRecords {
+    ORKTappingSampleBuffer *buffer = [ORKTappingSampleBuffer new];
+    [buffer appendSampleWithTimestamp:0.5 location:CGPointMake(1, 2) buttonIdentifier:ORKTappingButtonIdentifierRight];
+    [buffer closeOpenSampleForButton:ORKTappingButtonIdentifierRight atTimestamp:0.6];
+    
+    ORKTappingIntervalResult *result = [[ORKTappingIntervalResult alloc] initWithIdentifier:@"tapping"];
+    result.samples = [buffer snapshot];
+    
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:result requiringSecureCoding:YES error:NULL];
+    ORKTappingIntervalResult *decoded = [NSKeyedUnarchiver unarchivedObjectOfClass:[ORKTappingIntervalResult class] fromData:data error:NULL];
+    XCTAssertEqualObjects(decoded, result);
+    XCTAssertTrue([decoded.samples isKindOfClass:[ORKTappingSampleArray class]]);
+    
+    // Samples handed out as objects are mutable; edits to them are what gets archived.
+    decoded.samples[0].duration = 2;
+    NSData *editedData = [NSKeyedArchiver archivedDataWithRootObject:decoded requiringSecureCoding:YES error:NULL];
+    ORKTappingIntervalResult *edited = [NSKeyedUnarchiver unarchivedObjectOfClass:[ORKTappingIntervalResult class] fromData:editedData error:NULL];
+    XCTAssertEqual(edited.samples[0].duration, 2);
+}
+
+- (void)testResultDecodesLegacySampleArchives {
+    NSArray<ORKTappingSample *> *samples = @[ORKTappingTestSample(0.5, 0.1, CGPointMake(10, 20), ORKTappingButtonIdentifierLeft)];
+    _ORKTappingLegacyIntervalResult *legacyResult = [[_ORKTappingLegacyIntervalResult alloc] initWithIdentifier:@"tapping"];
+    legacyResult.legacySamples = samples;
+    
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:legacyResult requiringSecureCoding:YES error:NULL];
+    ORKTappingIntervalResult *decoded = [NSKeyedUnarchiver unarchivedObjectOfClass:[ORKTappingIntervalResult class] fromData:data error:NULL];
+    XCTAssertEqual(decoded.class, [ORKTappingIntervalResult class]);
+    XCTAssertEqualObjects(decoded.samples, samples);
+}
+
+#pragma mark - Benchmarks
+
+- (void)testRecordTenThousandTapSessionPerformance {
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        ORKTappingSampleBuffer *buffer = [ORKTappingSampleBuffer new];
+        NSArray *result = nil;
+        for (NSUInteger index = 0; index < ORKTappingSampleBenchmarkTapCount; index++) {
+            // Two fingers alternating, each press released after the other button goes down.
+            ORKTappingButtonIdentifier button = (index % 2) ? ORKTappingButtonIdentifierRight : ORKTappingButtonIdentifierLeft;
+            [buffer appendSampleWithTimestamp:index * 0.05 location:CGPointMake(index % 320, 400) buttonIdentifier:button];
+            ORKTappingButtonIdentifier other = (button == ORKTappingButtonIdentifierLeft) ? ORKTappingButtonIdentifierRight : ORKTappingButtonIdentifierLeft;
+            [buffer closeOpenSampleForButton:other atTimestamp:index * 0.05 + 0.01];
+            if (index % ORKTappingSampleBenchmarkResultInterval == 0) {
+                result = [buffer snapshot];
+            }
+        }
+        result = [buffer snapshot];
+        XCTAssertEqual(result.count, ORKTappingSampleBenchmarkTapCount);
+    }];
+}
+
+- (void)testRecordTenThousandTapSessionWithSampleObjectsPerformance {
+    // The approach the step view controller used before the buffer, for comparison.
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        NSMutableArray<ORKTappingSample *> *samples = [NSMutableArray array];
+        NSArray *result = nil;
+        for (NSUInteger index = 0; index < ORKTappingSampleBenchmarkTapCount; index++) {
+            ORKTappingButtonIdentifier button = (index % 2) ? ORKTappingButtonIdentifierRight : ORKTappingButtonIdentifierLeft;
+            [samples addObject:ORKTappingTestSample(index * 0.05, 0, CGPointMake(index % 320, 400), button)];
+            ORKTappingButtonIdentifier other = (button == ORKTappingButtonIdentifierLeft) ? ORKTappingButtonIdentifierRight : ORKTappingButtonIdentifierLeft;
+            for (ORKTappingSample *sample in [samples reverseObjectEnumerator]) {
+                if (sample.buttonIdentifier == other && sample.duration == 0) {
+                    sample.duration = index * 0.05 + 0.01 - sample.timestamp;
+                    break;
+                }
+            }
+            if (index % ORKTappingSampleBenchmarkResultInterval == 0) {
+                result = [samples copy];
+            }
+        }
+        result = [samples copy];
+        XCTAssertEqual(result.count, ORKTappingSampleBenchmarkTapCount);
+    }];
+}
+
+- (void)testArchiveTenThousandTapResultPerformance {
+    ORKTappingSampleBuffer *buffer = [ORKTappingSampleBuffer new];
+    for (NSUInteger index = 0; index < ORKTappingSampleBenchmarkTapCount; index++) {
+        [buffer appendSampleWithTimestamp:index * 0.05 location:CGPointMake(index % 320, 400) buttonIdentifier:ORKTappingButtonIdentifierLeft];
+        [buffer closeOpenSampleForButton:ORKTappingButtonIdentifierLeft atTimestamp:index * 0.05 + 0.01];
+    }
+    ORKTappingIntervalResult *result = [[ORKTappingIntervalResult alloc] initWithIdentifier:@"tapping"];
+    result.samples = [buffer snapshot];
+    
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        NSData *data = [NSKeyedArchiver archivedDataWithRootObject:result requiringSecureCoding:YES error:NULL];
+        ORKTappingIntervalResult *decoded = [NSKeyedUnarchiver unarchivedObjectOfClass:[ORKTappingIntervalResult class] fromData:data error:NULL];
+        XCTAssertEqual(decoded.samples.count, ORKTappingSampleBenchmarkTapCount);
+    }];
+}
+
+@end
@@ -0,0 +1,257 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKit_Private;
+@import ResearchKitActiveTask_Private;
+
+
+static const ORKClockTime ORKTestStartTime = 1000ULL * NSEC_PER_SEC;
+
+@interface ORKTickSchedulerTests : XCTestCase
+
+@end
+
+
+@implementation ORKTickSchedulerTests {
+    uint32_t _randomState;
+}
+
+- (void)setUp {
+    [super setUp];
+    _randomState = 0x9E3779B9;
+}
+
+- (double)nextRandom {
+    // xorshift32, so the simulated wakeup jitter is reproducible.
+    _randomState ^= _randomState << 13;
+    _randomState ^= _randomState >> 17;
+    _randomState ^= _randomState << 5;
+    return (double)_randomState / (double)UINT32_MAX;
+}
+
+/// Wakes the scheduler at a random point inside each window it asks for, until `endTime`.
+- (NSUInteger)driveScheduler:(ORKTickScheduler *)scheduler untilClockTime:(ORKClockTime)endTime {
+    NSUInteger wakeups = 0;
+    while (scheduler.nextDeadline <= endTime) {
+        ORKClockTime nextDeadline = scheduler.nextDeadline;
+        ORKClockTime window = scheduler.latestWakeupTime - nextDeadline;
+        [scheduler wakeAtClockTime:nextDeadline + (ORKClockTime)([self nextRandom] * window)];
+        wakeups += 1;
+    }
+    return wakeups;
+}
+
+- (void)testDeadlinesDoNotDriftOverSimulatedHour {
+    ORKTickScheduler *scheduler = [[ORKTickScheduler alloc] initWithManualWakeups];
+    
+    NSMutableArray<NSNumber *> *intervals = [@[@1.0, @0.1, @(1.0 / 30.0)] mutableCopy];
+    NSMutableArray<ORKTickSubscription *> *subscriptions = [NSMutableArray new];
+    NSMutableDictionary<NSNumber *, NSNumber *> *lastDeadlines = [NSMutableDictionary new];
+    NSMutableDictionary<NSNumber *, NSNumber *> *lastIndices = [NSMutableDictionary new];
+    for (NSNumber *interval in intervals) {
+        ORKTickSubscription *subscription = [scheduler scheduleTicksWithInterval:interval.doubleValue
+                                                                   firstDeadline:ORKTestStartTime
+                                                                          leeway:interval.doubleValue * 0.1
+                                                                           queue:nil
+                                                                         handler:^(NSUInteger tickIndex, ORKClockTime deadline) {
+            lastIndices[interval] = @(tickIndex);
+            lastDeadlines[interval] = @(deadline);
+        }];
+        [subscriptions addObject:subscription];
+    }
+    
+    ORKClockTime endTime = ORKTestStartTime + 3600ULL * NSEC_PER_SEC;
+    [self driveScheduler:scheduler untilClockTime:endTime];
+    
+    for (NSUInteger index = 0; index < intervals.count; index++) {
+        NSTimeInterval interval = intervals[index].doubleValue;
+        ORKTickSubscription *subscription = subscriptions[index];
+        NSUInteger expectedTicks = (NSUInteger)floor(3600.0 / interval + 1e-6) + 1;
+        ORKTickStatistics statistics = subscription.statistics;
+        
+        XCTAssertEqual(statistics.tickCount, expectedTicks);
+        XCTAssertEqual(statistics.missedTickCount, 0);
+        XCTAssertEqual(lastIndices[intervals[index]].unsignedIntegerValue, expectedTicks - 1);
+        
+        // The last deadline is where an ideal clock puts it, regardless of a hour of late wakeups.
+        NSTimeInterval lastDeadline = ORKTimeIntervalBetweenClockTimes(ORKTestStartTime, lastDeadlines[intervals[index]].unsignedLongLongValue);
+        XCTAssertEqualWithAccuracy(lastDeadline, (expectedTicks - 1) * interval, 1e-4);
+        
+        XCTAssertGreaterThan(statistics.meanLateness, 0);
+        XCTAssertLessThanOrEqual(statistics.maximumLateness, subscription.leeway + 1e-9);
+        XCTAssertGreaterThan(statistics.latenessStandardDeviation, 0);
+    }
+    
+    ORKTickStatistics statistics = scheduler.statistics;
+    XCTAssertEqual(statistics.tickCount, 3601 + 36001 + 108001);
+}
+
+- (void)testLateWakeupSkipsMissedTicks {
+    ORKTickScheduler *scheduler = [[ORKTickScheduler alloc] initWithManualWakeups];
+    NSMutableArray<NSNumber *> *indices = [NSMutableArray new];
+    ORKTickSubscription *subscription = [scheduler scheduleTicksWithInterval:0.1
+                                                               firstDeadline:ORKTestStartTime
+                                                                      leeway:0.01
+                                                                       queue:nil
+                                                                     handler:^(NSUInteger tickIndex, ORKClockTime deadline) {
+        [indices addObject:@(tickIndex)];
+    }];
+    
+    [scheduler wakeAtClockTime:ORKTestStartTime - 1];
+    XCTAssertEqual(indices.count, 0);
+    
+    [scheduler wakeAtClockTime:ORKTestStartTime];
+    // Stalled for 0.55 s: ticks 1 to 4 are missed and tick 5 is delivered once.
+    [scheduler wakeAtClockTime:ORKTestStartTime + 550 * NSEC_PER_MSEC];
+    [scheduler wakeAtClockTime:ORKTestStartTime + 600 * NSEC_PER_MSEC];
+    
+    XCTAssertEqualObjects(indices, (@[@0, @5, @6]));
+    ORKTickStatistics statistics = subscription.statistics;
+    XCTAssertEqual(statistics.tickCount, 3);
+    XCTAssertEqual(statistics.missedTickCount, 4);
+    XCTAssertEqualWithAccuracy(statistics.maximumLateness, 0.05, 1e-9);
+    XCTAssertEqual(scheduler.nextDeadline, ORKTestStartTime + 700 * NSEC_PER_MSEC);
+}
+
+- (void)testInvalidateStopsDelivery {
+    ORKTickScheduler *scheduler = [[ORKTickScheduler alloc] initWithManualWakeups];
+    __block NSUInteger tickCount = 0;
+    __block ORKTickSubscription *subscription = nil;
+    subscription = [scheduler scheduleTicksWithInterval:1
+                                          firstDeadline:ORKTestStartTime
+                                                 leeway:0
+                                                  queue:nil
+                                                handler:^(NSUInteger tickIndex, ORKClockTime deadline) {
+        tickCount += 1;
+        if (tickIndex == 2) {
+            // Invalidating from the handler must not deadlock.
+            [subscription invalidate];
+        }
+    }];
+    
+    [self driveScheduler:scheduler untilClockTime:ORKTestStartTime + 10 * NSEC_PER_SEC];
+    XCTAssertEqual(tickCount, 3);
+    XCTAssertFalse(subscription.valid);
+    XCTAssertEqual(scheduler.nextDeadline, UINT64_MAX);
+}
+
+- (void)testCoalescesSubscriptionsWithSamePeriod {
+    ORKTickScheduler *scheduler = [[ORKTickScheduler alloc] initWithManualWakeups];
+    NSUInteger subscriberCount = 10;
+    for (NSUInteger index = 0; index < subscriberCount; index++) {
+        // Phases spread over 5 ms, inside the 10 ms leeway.
+        [scheduler scheduleTicksWithInterval:0.1
+                               firstDeadline:ORKTestStartTime + index * 500 * NSEC_PER_USEC
+                                      leeway:0.01
+                                       queue:nil
+                                     handler:^(NSUInteger tickIndex, ORKClockTime deadline) {}];
+    }
+    
+    // The system fires a timer at the end of its leeway when it can defer it.
+    NSUInteger wakeups = 0;
+    ORKClockTime endTime = ORKTestStartTime + 60 * NSEC_PER_SEC;
+    while (scheduler.nextDeadline <= endTime) {
+        [scheduler wakeAtClockTime:scheduler.latestWakeupTime];
+        wakeups += 1;
+    }
+    
+    XCTAssertEqual(scheduler.statistics.tickCount, subscriberCount * 601);
+    XCTAssertEqual(wakeups, 601);
+    XCTAssertEqual(scheduler.statistics.missedTickCount, 0);
+}
+
+- (void)testActiveStepTimerFinishes {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"finished"];
+    __block NSUInteger tickCount = 0;
+    ORKActiveStepTimer *timer = [[ORKActiveStepTimer alloc] initWithDuration:0.5 interval:0.1 runtime:0 handler:^(ORKActiveStepTimer *timer, BOOL finished) {
+        tickCount += 1;
+        if (finished) {
+            [expectation fulfill];
+        }
+    }];
+    [timer resume];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    
+    XCTAssertEqual(tickCount, 5);
+    XCTAssertGreaterThanOrEqual(timer.runtime, 0.5);
+}
+
+- (void)testWakeupsPerSecond {
+    // Eight 10 Hz subscribers, as with several countdowns and recorders on screen at once.
+    ORKTickScheduler *scheduler = [ORKTickScheduler new];
+    NSMutableArray<ORKTickSubscription *> *subscriptions = [NSMutableArray new];
+    ORKClockTime firstDeadline = ORKClockNow() + 100 * NSEC_PER_MSEC;
+    for (NSUInteger index = 0; index < 8; index++) {
+        [subscriptions addObject:[scheduler scheduleTicksWithInterval:0.1
+                                                        firstDeadline:firstDeadline + index * NSEC_PER_MSEC
+                                                               leeway:0.02
+                                                                queue:nil
+                                                              handler:^(NSUInteger tickIndex, ORKClockTime deadline) {}]];
+    }
+    
+    NSTimeInterval duration = 2;
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:duration]];
+    for (ORKTickSubscription *subscription in subscriptions) {
+        [subscription invalidate];
+    }
+    
+    ORKTickStatistics statistics = scheduler.statistics;
+    double wakeupsPerSecond = scheduler.wakeupCount / duration;
+    double ticksPerSecond = statistics.tickCount / duration;
+    
+    // Nominally 80 ticks/s; allow for a loaded test machine.
+    XCTAssertGreaterThan(ticksPerSecond, 40);
+    // Without coalescing every tick would be a wakeup.
+    XCTAssertLessThan(wakeupsPerSecond, ticksPerSecond / 2);
+    // Ticks are due within their 20 ms leeway; allow 10 ms more for the run loop on average, and
+    // less than one interval at worst, past which a tick would have been counted as missed.
+    XCTAssertLessThan(statistics.meanLateness, 0.03);
+    XCTAssertLessThan(statistics.maximumLateness, 0.1);
+}
+
+- (void)testWakeupPerformance {
+    ORKTickScheduler *scheduler = [[ORKTickScheduler alloc] initWithManualWakeups];
+    for (NSUInteger index = 0; index < 32; index++) {
+        [scheduler scheduleTicksWithInterval:0.01 * (index % 4 + 1)
+                               firstDeadline:ORKTestStartTime + index * NSEC_PER_MSEC
+                                      leeway:0.005
+                                       queue:nil
+                                     handler:^(NSUInteger tickIndex, ORKClockTime deadline) {}];
+    }
+    __block ORKClockTime endTime = ORKTestStartTime;
+    [self measureBlock:^{
+        endTime += 10 * NSEC_PER_SEC;
+        [self driveScheduler:scheduler untilClockTime:endTime];
+    }];
+}
+
+@end
@@ -0,0 +1,256 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import AVFoundation;
+@import ResearchKitActiveTask;
+@import ResearchKitActiveTask_Private;
+
+
+static const double ORKToneSynthesisTestSampleRate = 44100;
+
+// `AudioBufferList` declares room for one buffer; this has the same layout with room for two.
+typedef struct {
+    UInt32 mNumberBuffers;
+    AudioBuffer mBuffers[2];
+} ORKToneSynthesisTestStereoBufferList;
+
+static ORKToneSynthesisTestStereoBufferList ORKToneSynthesisTestMakeStereoBufferList(float *left, float *right, AVAudioFrameCount frameCount) {
+    ORKToneSynthesisTestStereoBufferList bufferList = {
+        .mNumberBuffers = 2,
+        .mBuffers = {
+            { .mNumberChannels = 1, .mDataByteSize = frameCount * (UInt32)sizeof(float), .mData = left },
+            { .mNumberChannels = 1, .mDataByteSize = frameCount * (UInt32)sizeof(float), .mData = right }
+        }
+    };
+    return bufferList;
+}
+
+// The per-sample renderer the audiometry generators used before sharing the engine.
+static void ORKToneSynthesisReferenceRender(float *samples, NSUInteger frameCount, double frequency, double amplitude, NSTimeInterval fadeInDuration) {
+    double theta = 0;
+    double fadeInFactor = 0;
+    for (NSUInteger frame = 0; frame < frameCount; frame++) {
+        samples[frame] = sin(theta) * amplitude * pow(10, 2 * fadeInFactor - 2);
+        theta += 2.0 * M_PI * frequency / ORKToneSynthesisTestSampleRate;
+        if (theta > 2.0 * M_PI) {
+            theta -= 2.0 * M_PI;
+        }
+        fadeInFactor = MIN(fadeInFactor + 1.0 / (ORKToneSynthesisTestSampleRate * fadeInDuration), 1);
+    }
+}
+
+static double ORKToneSynthesisMagnitudeAtFrequency(const float *samples, NSUInteger frameCount, double frequency) {
+    double real = 0;
+    double imaginary = 0;
+    for (NSUInteger frame = 0; frame < frameCount; frame++) {
+        double angle = 2.0 * M_PI * frequency * frame / ORKToneSynthesisTestSampleRate;
+        real += samples[frame] * cos(angle);
+        imaginary += samples[frame] * sin(angle);
+    }
+    return sqrt(real * real + imaginary * imaginary);
+}
+
+
+@interface ORKToneSynthesisEngineTests : XCTestCase
+
+@end
+
+
+@implementation ORKToneSynthesisEngineTests
+
+- (void)renderEngine:(ORKToneSynthesisEngine *)engine intoBuffer:(AVAudioPCMBuffer *)buffer sliceFrameCount:(AVAudioFrameCount)sliceFrameCount {
+    for (AVAudioFrameCount offset = 0; offset < buffer.frameCapacity; offset += sliceFrameCount) {
+        AVAudioFrameCount frameCount = MIN(sliceFrameCount, buffer.frameCapacity - offset);
+        float *left = buffer.floatChannelData[0] + offset;
+        float *right = buffer.floatChannelData[1] + offset;
+        ORKToneSynthesisTestStereoBufferList bufferList = ORKToneSynthesisTestMakeStereoBufferList(left, right, frameCount);
+        [engine renderFrameCount:frameCount intoBufferList:(AudioBufferList *)&bufferList];
+    }
+    buffer.frameLength = buffer.frameCapacity;
+}
+
+- (void)testToneMatchesReferenceRenderer {
+    ORKToneSynthesisEngine *engine = [[ORKToneSynthesisEngine alloc] initWithSampleRate:ORKToneSynthesisTestSampleRate];
+    ORKToneSynthesisStimulus *stimulus = [ORKToneSynthesisStimulus toneWithFrequency:1000 amplitude:0.03];
+    stimulus.fadeInDuration = 0.5;
+    [stimulus setGain:0 forChannel:ORKAudioChannelRight];
+    [engine startStimulus:stimulus atSampleTime:ORKToneSynthesisSampleTimeImmediate];
+    
+    // Render in device-sized buffers so that phase and fade carry across buffer boundaries.
+    AVAudioFormat *format = [[AVAudioFormat alloc] initStandardFormatWithSampleRate:ORKToneSynthesisTestSampleRate channels:2];
+    AVAudioPCMBuffer *buffer = [[AVAudioPCMBuffer alloc] initWithPCMFormat:format frameCapacity:44100];
+    [self renderEngine:engine intoBuffer:buffer sliceFrameCount:471];
+    
+    float *reference = malloc(44100 * sizeof(float));
+    ORKToneSynthesisReferenceRender(reference, 44100, 1000, 0.03, 0.5);
+    float maximumError = 0;
+    float maximumRight = 0;
+    for (NSUInteger frame = 0; frame < 44100; frame++) {
+        maximumError = MAX(maximumError, fabsf(buffer.floatChannelData[0][frame] - reference[frame]));
+        maximumRight = MAX(maximumRight, fabsf(buffer.floatChannelData[1][frame]));
+    }
+    free(reference);
+    
+    XCTAssertLessThan(maximumError, 1e-6);
+    XCTAssertEqual(maximumRight, 0);
+    XCTAssertEqual(engine.sampleTime, 44100);
+    XCTAssertEqualWithAccuracy(engine.currentAmplitude, 0.03, 1e-9);
+}
+
+- (void)testRenderCallbackMatchesRenderMethod {
+    ORKToneSynthesisStimulus *stimulus = [ORKToneSynthesisStimulus toneWithFrequency:1000 amplitude:0.25];
+    AVAudioFormat *format = [[AVAudioFormat alloc] initStandardFormatWithSampleRate:ORKToneSynthesisTestSampleRate channels:2];
+    ORKToneSynthesisEngine *methodEngine = [ORKToneSynthesisEngine new];
+    [methodEngine startStimulus:stimulus atSampleTime:100];
+    AVAudioPCMBuffer *expected = [[AVAudioPCMBuffer alloc] initWithPCMFormat:format frameCapacity:2048];
+    [self renderEngine:methodEngine intoBuffer:expected sliceFrameCount:512];
+    
+    // The callback renders through the refCon alone, as the audio unit would call it.
+    ORKToneSynthesisEngine *engine = [ORKToneSynthesisEngine new];
+    [engine startStimulus:stimulus atSampleTime:100];
+    AVAudioPCMBuffer *buffer = [[AVAudioPCMBuffer alloc] initWithPCMFormat:format frameCapacity:2048];
+    for (AVAudioFrameCount offset = 0; offset < 2048; offset += 512) {
+        ORKToneSynthesisTestStereoBufferList bufferList = ORKToneSynthesisTestMakeStereoBufferList(buffer.floatChannelData[0] + offset, buffer.floatChannelData[1] + offset, 512);
+        AudioUnitRenderActionFlags flags = 0;
+        AudioTimeStamp timeStamp = { .mSampleTime = offset };
+        XCTAssertEqual(ORKToneSynthesisEngineRenderCallback(engine.renderCallbackRefCon, &flags, &timeStamp, 0, 512, (AudioBufferList *)&bufferList), noErr);
+    }
+    XCTAssertEqual(memcmp(buffer.floatChannelData[0], expected.floatChannelData[0], 2048 * sizeof(float)), 0);
+    XCTAssertEqual(memcmp(buffer.floatChannelData[1], expected.floatChannelData[1], 2048 * sizeof(float)), 0);
+    XCTAssertEqual(engine.sampleTime, 2048);
+}
+
+- (void)testSampleAccurateScheduling {
+    ORKToneSynthesisEngine *engine = [ORKToneSynthesisEngine new];
+    ORKToneSynthesisStimulus *stimulus = [ORKToneSynthesisStimulus toneWithFrequency:440 amplitude:0.5];
+    ORKToneSynthesisVoice voice = [engine startStimulus:stimulus atSampleTime:1000];
+    XCTAssertNotEqual(voice, ORKToneSynthesisVoiceNone);
+    XCTAssertTrue([engine stopVoice:voice atSampleTime:3000 fadeOutDuration:0]);
+    
+    AVAudioPCMBuffer *buffer = [engine renderOfflineWithFrameCount:4096];
+    const float *left = buffer.floatChannelData[0];
+    NSInteger firstFrame = -1;
+    NSInteger lastFrame = -1;
+    for (NSInteger frame = 0; frame < 4096; frame++) {
+        if (left[frame] != 0) {
+            firstFrame = (firstFrame < 0) ? frame : firstFrame;
+            lastFrame = frame;
+        }
+    }
+    // The first frame of a tone is sin(0).
+    XCTAssertEqual(firstFrame, 1001);
+    XCTAssertEqual(lastFrame, 2999);
+    XCTAssertEqual(engine.activeVoiceCount, 0);
+}
+
+- (void)testFadeOutReleasesVoice {
+    ORKToneSynthesisEngine *engine = [ORKToneSynthesisEngine new];
+    [engine startStimulus:[ORKToneSynthesisStimulus toneWithFrequency:1000 amplitude:0.1] atSampleTime:ORKToneSynthesisSampleTimeImmediate];
+    [engine renderOfflineWithFrameCount:1024];
+    XCTAssertEqual(engine.activeVoiceCount, 1);
+    
+    [engine stopAllVoicesAtSampleTime:ORKToneSynthesisSampleTimeImmediate fadeOutDuration:0.2];
+    AVAudioPCMBuffer *buffer = [engine renderOfflineWithFrameCount:16384];
+    NSInteger lastFrame = -1;
+    for (NSInteger frame = 0; frame < 16384; frame++) {
+        if (buffer.floatChannelData[0][frame] != 0) {
+            lastFrame = frame;
+        }
+    }
+    XCTAssertEqualWithAccuracy(lastFrame, 0.2 * ORKToneSynthesisTestSampleRate, 2);
+    XCTAssertEqual(engine.activeVoiceCount, 0);
+    XCTAssertEqual(engine.currentAmplitude, 0);
+}
+
+- (void)testMultipleTonesAreSummed {
+    double frequencies[] = {500, 1500};
+    ORKToneSynthesisEngine *combinedEngine = [ORKToneSynthesisEngine new];
+    AVAudioPCMBuffer *separate[2];
+    for (NSUInteger index = 0; index < 2; index++) {
+        ORKToneSynthesisStimulus *stimulus = [ORKToneSynthesisStimulus toneWithFrequency:frequencies[index] amplitude:0.2];
+        ORKToneSynthesisEngine *engine = [ORKToneSynthesisEngine new];
+        [engine startStimulus:stimulus atSampleTime:ORKToneSynthesisSampleTimeImmediate];
+        separate[index] = [engine renderOfflineWithFrameCount:2048];
+        [combinedEngine startStimulus:stimulus atSampleTime:ORKToneSynthesisSampleTimeImmediate];
+    }
+    AVAudioPCMBuffer *combined = [combinedEngine renderOfflineWithFrameCount:2048];
+    for (NSUInteger frame = 0; frame < 2048; frame++) {
+        float sum = separate[0].floatChannelData[0][frame] + separate[1].floatChannelData[0][frame];
+        XCTAssertEqualWithAccuracy(combined.floatChannelData[0][frame], sum, 1e-6);
+    }
+    XCTAssertEqualWithAccuracy(combinedEngine.currentAmplitude, 0.4, 1e-6);
+}
+
+- (void)testChannelGains {
+    ORKToneSynthesisEngine *engine = [ORKToneSynthesisEngine new];
+    [engine setGain:0.5 forChannel:ORKAudioChannelRight];
+    [engine startStimulus:[ORKToneSynthesisStimulus toneWithFrequency:750 amplitude:0.2] atSampleTime:ORKToneSynthesisSampleTimeImmediate];
+    AVAudioPCMBuffer *buffer = [engine renderOfflineWithFrameCount:1024];
+    for (NSUInteger frame = 0; frame < 1024; frame++) {
+        XCTAssertEqualWithAccuracy(buffer.floatChannelData[1][frame], 0.5 * buffer.floatChannelData[0][frame], 1e-7);
+    }
+    
+    // Gain changes are picked up at the next buffer.
+    [engine setGain:0 forChannel:ORKAudioChannelLeft];
+    buffer = [engine renderOfflineWithFrameCount:1024];
+    for (NSUInteger frame = 0; frame < 1024; frame++) {
+        XCTAssertEqual(buffer.floatChannelData[0][frame], 0);
+    }
+}
+
+- (void)testNoiseIsBandLimited {
+    ORKToneSynthesisEngine *engine = [ORKToneSynthesisEngine new];
+    [engine startStimulus:[ORKToneSynthesisStimulus noiseWithLowerFrequency:1000 upperFrequency:2000 amplitude:1] atSampleTime:ORKToneSynthesisSampleTimeImmediate];
+    AVAudioPCMBuffer *buffer = [engine renderOfflineWithFrameCount:8192];
+    double inBand = ORKToneSynthesisMagnitudeAtFrequency(buffer.floatChannelData[0], 8192, 1414);
+    double outOfBand = ORKToneSynthesisMagnitudeAtFrequency(buffer.floatChannelData[0], 8192, 8000);
+    XCTAssertGreaterThan(inBand, 5 * outOfBand);
+}
+
+- (void)testRenderPerformance {
+    // Ten seconds of four tones and a noise band, in 256-frame buffers.
+    [self measureWithMetrics:@[[XCTClockMetric new]] block:^{
+        ORKToneSynthesisEngine *engine = [ORKToneSynthesisEngine new];
+        for (NSUInteger index = 0; index < 4; index++) {
+            ORKToneSynthesisStimulus *stimulus = [ORKToneSynthesisStimulus toneWithFrequency:250 << index amplitude:0.1];
+            stimulus.fadeInDuration = 0.2;
+            [engine startStimulus:stimulus atSampleTime:index * 4410];
+        }
+        [engine startStimulus:[ORKToneSynthesisStimulus noiseWithLowerFrequency:500 upperFrequency:4000 amplitude:0.1] atSampleTime:ORKToneSynthesisSampleTimeImmediate];
+        
+        AVAudioFormat *format = [[AVAudioFormat alloc] initStandardFormatWithSampleRate:ORKToneSynthesisTestSampleRate channels:2];
+        AVAudioPCMBuffer *buffer = [[AVAudioPCMBuffer alloc] initWithPCMFormat:format frameCapacity:441000];
+        [self renderEngine:engine intoBuffer:buffer sliceFrameCount:256];
+    }];
+}
+
+@end
@@ -0,0 +1,210 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKit_Private;
+@import ResearchKitActiveTask;
+@import ResearchKitActiveTask_Private;
+
+#import "ORKTouchAbilityTrialMetrics.h"
+
+
+static const double Accuracy = 1e-9;
+
+static ORKTouchAbilityTouch *ORKTestTouch(NSTimeInterval timestamp, CGPoint location) {
+    ORKTouchAbilityTouch *touch = [[ORKTouchAbilityTouch alloc] init];
+    [touch setValue:@(timestamp) forKey:@"timestamp"];
+    [touch setValue:[NSValue valueWithCGPoint:location] forKey:@"locationInWindow"];
+    return touch;
+}
+
+static ORKTouchAbilityTrack *ORKTestTrack(const ORKTouchAbilitySample *samples, NSUInteger count) {
+    NSMutableArray<ORKTouchAbilityTouch *> *touches = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        [touches addObject:ORKTestTouch(samples[index].timestamp, samples[index].location)];
+    }
+    ORKTouchAbilityTrack *track = [[ORKTouchAbilityTrack alloc] init];
+    [track setValue:touches forKey:@"touches"];
+    return track;
+}
+
+
+@interface ORKTouchAbilityTrialMetricsTests : XCTestCase
+
+@end
+
+
+@implementation ORKTouchAbilityTrialMetricsTests
+
+- (void)testEmptyTrack {
+    ORKTouchAbilityKinematics kinematics = ORKTouchAbilityKinematicsForSamples(NULL, 0, ORKTouchAbilityDefaultDwellSpeedThreshold);
+    XCTAssertEqual(kinematics.sampleCount, 0);
+    XCTAssertEqual(kinematics.pathLength, 0.0);
+    XCTAssertEqual(kinematics.duration, 0.0);
+}
+
+- (void)testConstantVelocity {
+    const ORKTouchAbilitySample samples[] = {
+        { 0.0, { 0.0, 0.0 } },
+        { 0.1, { 10.0, 0.0 } },
+        { 0.2, { 20.0, 0.0 } },
+        { 0.3, { 30.0, 0.0 } },
+    };
+    ORKTouchAbilityKinematics kinematics = ORKTouchAbilityKinematicsForSamples(samples, 4, ORKTouchAbilityDefaultDwellSpeedThreshold);
+    
+    XCTAssertEqual(kinematics.sampleCount, 4);
+    XCTAssertEqualWithAccuracy(kinematics.duration, 0.3, Accuracy);
+    XCTAssertEqualWithAccuracy(kinematics.pathLength, 30.0, Accuracy);
+    XCTAssertEqualWithAccuracy(kinematics.displacement, 30.0, Accuracy);
+    XCTAssertEqualWithAccuracy(kinematics.peakSpeed, 100.0, 1e-6);
+    XCTAssertEqualWithAccuracy(kinematics.peakAcceleration, 0.0, 1e-6);
+    XCTAssertEqualWithAccuracy(kinematics.sumOfSquaredJerk, 0.0, 1e-6);
+    XCTAssertEqual(kinematics.jerkSampleCount, 1);
+    XCTAssertEqual(kinematics.dwellTime, 0.0);
+}
+
+- (void)testConstantAcceleration {
+    // x = 50 t^2, so the acceleration is 100 pt/s^2 and the jerk is zero.
+    const ORKTouchAbilitySample samples[] = {
+        { 0.0, { 0.0, 0.0 } },
+        { 0.1, { 0.5, 0.0 } },
+        { 0.2, { 2.0, 0.0 } },
+        { 0.3, { 4.5, 0.0 } },
+        { 0.4, { 8.0, 0.0 } },
+    };
+    ORKTouchAbilityKinematics kinematics = ORKTouchAbilityKinematicsForSamples(samples, 5, 0.0);
+    
+    XCTAssertEqualWithAccuracy(kinematics.pathLength, 8.0, Accuracy);
+    XCTAssertEqualWithAccuracy(kinematics.peakSpeed, 35.0, 1e-6);
+    XCTAssertEqualWithAccuracy(kinematics.peakAcceleration, 100.0, 1e-6);
+    XCTAssertEqualWithAccuracy(kinematics.sumOfSquaredJerk, 0.0, 1e-3);
+    XCTAssertEqual(kinematics.jerkSampleCount, 2);
+}
+
+- (void)testDwellAndPathEfficiency {
+    // Rest for 0.5 s, then trace two sides of a 30 x 40 rectangle.
+    const ORKTouchAbilitySample samples[] = {
+        { 0.00, { 0.0, 0.0 } },
+        { 0.25, { 0.0, 0.0 } },
+        { 0.50, { 0.0, 0.0 } },
+        { 0.60, { 30.0, 0.0 } },
+        { 0.70, { 30.0, 40.0 } },
+    };
+    ORKTouchAbilityTrial *trial = [[ORKTouchAbilityTrial alloc] init];
+    [trial setValue:@[ORKTestTrack(samples, 5)] forKey:@"tracks"];
+    ORKTouchAbilityTrialMetrics *metrics = [ORKTouchAbilityTrialMetrics metricsForTrial:trial];
+    
+    XCTAssertEqual(metrics.trackCount, 1);
+    XCTAssertEqual(metrics.sampleCount, 5);
+    XCTAssertEqualWithAccuracy(metrics.dwellTime, 0.5, Accuracy);
+    XCTAssertEqualWithAccuracy(metrics.pathLength, 70.0, Accuracy);
+    XCTAssertEqualWithAccuracy(metrics.pathEfficiency, 50.0 / 70.0, Accuracy);
+    XCTAssertEqualWithAccuracy(metrics.meanSpeed, 100.0, 1e-6);
+    XCTAssertEqualWithAccuracy(metrics.peakSpeed, 400.0, 1e-6);
+    XCTAssertTrue(isnan(metrics.scaleError));
+    XCTAssertTrue(isnan(metrics.rotationError));
+}
+
+- (void)testMultipleTracksAreAggregated {
+    const ORKTouchAbilitySample first[] = {
+        { 0.0, { 0.0, 0.0 } },
+        { 0.1, { 10.0, 0.0 } },
+    };
+    const ORKTouchAbilitySample second[] = {
+        { 0.0, { 100.0, 100.0 } },
+        { 0.2, { 100.0, 140.0 } },
+    };
+    ORKTouchAbilityTrial *trial = [[ORKTouchAbilityTrial alloc] init];
+    [trial setValue:@[ORKTestTrack(first, 2), ORKTestTrack(second, 2)] forKey:@"tracks"];
+    ORKTouchAbilityTrialMetrics *metrics = [ORKTouchAbilityTrialMetrics metricsForTrial:trial];
+    
+    XCTAssertEqual(metrics.trackCount, 2);
+    XCTAssertEqual(metrics.sampleCount, 4);
+    XCTAssertEqualWithAccuracy(metrics.pathLength, 50.0, Accuracy);
+    XCTAssertEqualWithAccuracy(metrics.pathEfficiency, 1.0, Accuracy);
+    XCTAssertEqualWithAccuracy(metrics.duration, 0.3, Accuracy);
+    XCTAssertEqualWithAccuracy(metrics.peakSpeed, 200.0, 1e-6);
+}
+
+- (void)testTargetErrors {
+    ORKTouchAbilityPinchTrial *pinchTrial = [[ORKTouchAbilityPinchTrial alloc] initWithTargetScale:2.0];
+    pinchTrial.resultScale = 1.75;
+    XCTAssertEqualWithAccuracy([ORKTouchAbilityTrialMetrics metricsForTrial:pinchTrial].scaleError, -0.25, Accuracy);
+    XCTAssertTrue(isnan([ORKTouchAbilityTrialMetrics metricsForTrial:pinchTrial].rotationError));
+    
+    ORKTouchAbilityRotationTrial *rotationTrial = [[ORKTouchAbilityRotationTrial alloc] initWithTargetRotation:M_PI_2];
+    rotationTrial.resultRotation = M_PI_4;
+    XCTAssertEqualWithAccuracy([ORKTouchAbilityTrialMetrics metricsForTrial:rotationTrial].rotationError, -M_PI_4, Accuracy);
+    XCTAssertTrue(isnan([ORKTouchAbilityTrialMetrics metricsForTrial:rotationTrial].scaleError));
+}
+
+- (void)testMetricsOfDecodedTrial {
+    const ORKTouchAbilitySample samples[] = {
+        { 0.0, { 0.0, 0.0 } },
+        { 0.1, { 3.0, 4.0 } },
+        { 0.2, { 6.0, 8.0 } },
+    };
+    ORKTouchAbilityPinchTrial *trial = [[ORKTouchAbilityPinchTrial alloc] initWithTargetScale:1.5];
+    trial.resultScale = 1.5;
+    [trial setValue:@[ORKTestTrack(samples, 3)] forKey:@"tracks"];
+    
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:trial requiringSecureCoding:YES error:nil];
+    NSSet *classes = [NSSet setWithObjects:[ORKTouchAbilityPinchTrial class], [ORKTouchAbilityTrack class], [ORKTouchAbilityTouch class],
+                      [ORKTouchAbilityGestureRecoginzerEvent class], [NSArray class], [NSDate class], [NSNumber class], nil];
+    ORKTouchAbilityPinchTrial *decodedTrial = [NSKeyedUnarchiver unarchivedObjectOfClasses:classes fromData:data error:nil];
+    
+    ORKTouchAbilityTrialMetrics *metrics = [ORKTouchAbilityTrialMetrics metricsForTrial:trial];
+    ORKTouchAbilityTrialMetrics *decodedMetrics = [ORKTouchAbilityTrialMetrics metricsForTrial:decodedTrial];
+    XCTAssertEqualWithAccuracy(decodedMetrics.pathLength, metrics.pathLength, Accuracy);
+    XCTAssertEqualWithAccuracy(decodedMetrics.peakSpeed, metrics.peakSpeed, Accuracy);
+    XCTAssertEqualWithAccuracy(decodedMetrics.scaleError, 0.0, Accuracy);
+}
+
+- (void)testKinematicsPerformance {
+    const NSUInteger trialCount = 1000;
+    const NSUInteger sampleCount = 240;
+    ORKTouchAbilitySample *samples = malloc(sampleCount * sizeof(ORKTouchAbilitySample));
+    for (NSUInteger index = 0; index < sampleCount; index++) {
+        const double t = index / 120.0;
+        samples[index] = (ORKTouchAbilitySample){ t, CGPointMake(200.0 * t + 3.0 * sin(60.0 * t), 150.0 * t * t) };
+    }
+    
+    [self measureBlock:^{
+        ORKTouchAbilityKinematics aggregate = {0};
+        for (NSUInteger trial = 0; trial < trialCount; trial++) {
+            ORKTouchAbilityKinematicsAccumulate(&aggregate, ORKTouchAbilityKinematicsForSamples(samples, sampleCount, ORKTouchAbilityDefaultDwellSpeedThreshold));
+        }
+        XCTAssertEqual(aggregate.sampleCount, trialCount * sampleCount);
+    }];
+    free(samples);
+}
+
+@end
@@ -0,0 +1,239 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKit;
+@import ResearchKitActiveTask;
+@import ResearchKitActiveTask_Private;
+
+
+static const NSUInteger ORKTowerOfHanoiOracleMaximumNumberOfDisks = 6;
+static const NSUInteger ORKTowerOfHanoiBenchmarkSequenceCount = 1000;
+static const NSUInteger ORKTowerOfHanoiBenchmarkSequenceLength = 2000;
+
+
+@interface ORKTowerOfHanoiEngineTests : XCTestCase
+
+@end
+
+
+@implementation ORKTowerOfHanoiEngineTests
+
+// Encodes the tower of each disk as a base-3 number, the smallest disk in the lowest digit.
+static NSUInteger ORKEncodeTowers(const uint8_t *towers, NSUInteger numberOfDisks) {
+    NSUInteger state = 0;
+    for (NSInteger disk = (NSInteger)numberOfDisks - 1; disk >= 0; disk--) {
+        state = state * 3 + towers[disk];
+    }
+    return state;
+}
+
+static void ORKDecodeTowers(NSUInteger state, uint8_t *towers, NSUInteger numberOfDisks) {
+    for (NSUInteger disk = 0; disk < numberOfDisks; disk++) {
+        towers[disk] = state % 3;
+        state /= 3;
+    }
+}
+
+// Breadth-first search back from the solved state, giving the exact distance to it from every state.
+- (NSData *)distancesToSolvedStateWithNumberOfDisks:(NSUInteger)numberOfDisks {
+    NSUInteger stateCount = (NSUInteger)pow(3, numberOfDisks);
+    NSMutableData *distances = [NSMutableData dataWithLength:stateCount * sizeof(NSInteger)];
+    NSInteger *distance = distances.mutableBytes;
+    for (NSUInteger state = 0; state < stateCount; state++) {
+        distance[state] = -1;
+    }
+    NSUInteger *queue = calloc(stateCount, sizeof(NSUInteger));
+    NSUInteger head = 0;
+    NSUInteger tail = 0;
+    NSUInteger solved = stateCount - 1;
+    distance[solved] = 0;
+    queue[tail++] = solved;
+    
+    uint8_t towers[ORKTowerOfHanoiOracleMaximumNumberOfDisks];
+    while (head < tail) {
+        NSUInteger state = queue[head++];
+        ORKDecodeTowers(state, towers, numberOfDisks);
+        for (uint8_t from = 0; from < 3; from++) {
+            for (uint8_t to = 0; to < 3; to++) {
+                if (from == to) {
+                    continue;
+                }
+                // The smallest disk on each tower is its top disk.
+                NSInteger moving = -1;
+                NSInteger blocking = -1;
+                for (NSUInteger disk = 0; disk < numberOfDisks; disk++) {
+                    if (moving < 0 && towers[disk] == from) {
+                        moving = disk;
+                    }
+                    if (blocking < 0 && towers[disk] == to) {
+                        blocking = disk;
+                    }
+                }
+                if (moving < 0 || (blocking >= 0 && blocking < moving)) {
+                    continue;
+                }
+                towers[moving] = to;
+                NSUInteger next = ORKEncodeTowers(towers, numberOfDisks);
+                towers[moving] = from;
+                if (distance[next] < 0) {
+                    distance[next] = distance[state] + 1;
+                    queue[tail++] = next;
+                }
+            }
+        }
+    }
+    free(queue);
+    return distances;
+}
+
+- (NSUInteger)stateOfEngine:(ORKTowerOfHanoiEngine *)engine {
+    uint8_t towers[ORKTowerOfHanoiOracleMaximumNumberOfDisks] = {0};
+    for (uint8_t tower = 0; tower < engine.numberOfTowers; tower++) {
+        for (NSNumber *disk in [engine disksOnTowerAtIndex:tower]) {
+            towers[disk.unsignedIntegerValue - 1] = tower;
+        }
+    }
+    return ORKEncodeTowers(towers, engine.numberOfDisks);
+}
+
+- (void)solve:(ORKTowerOfHanoiEngine *)engine disks:(NSUInteger)disks from:(NSUInteger)from to:(NSUInteger)to via:(NSUInteger)via time:(NSTimeInterval *)time {
+    if (disks == 0) {
+        return;
+    }
+    [self solve:engine disks:disks - 1 from:from to:via via:to time:time];
+    XCTAssertTrue([engine moveDiskFromTowerAtIndex:from toTowerAtIndex:to atTime:*time]);
+    *time += 1;
+    [self solve:engine disks:disks - 1 from:via to:to via:from time:time];
+}
+
+- (void)testRemainingMovesMatchSearchOracle {
+    ORKRandomNumberGenerator *generator = [[ORKRandomNumberGenerator alloc] initWithSeed:2024];
+    for (NSUInteger numberOfDisks = 1; numberOfDisks <= ORKTowerOfHanoiOracleMaximumNumberOfDisks; numberOfDisks++) {
+        NSData *distances = [self distancesToSolvedStateWithNumberOfDisks:numberOfDisks];
+        const NSInteger *distance = distances.bytes;
+        
+        for (NSUInteger walk = 0; walk < 50; walk++) {
+            ORKTowerOfHanoiEngine *engine = [[ORKTowerOfHanoiEngine alloc] initWithNumberOfDisks:numberOfDisks];
+            XCTAssertEqual(engine.remainingNumberOfMoves, engine.minimumNumberOfMoves);
+            XCTAssertEqual(engine.minimumNumberOfMoves, (1ULL << numberOfDisks) - 1);
+            
+            for (NSUInteger attempt = 0; attempt < 200; attempt++) {
+                NSUInteger from = [generator uniformIntegerLessThan:3];
+                NSUInteger to = [generator uniformIntegerLessThan:3];
+                uint64_t before = engine.remainingNumberOfMoves;
+                BOOL legal = [engine canMoveDiskFromTowerAtIndex:from toTowerAtIndex:to];
+                XCTAssertEqual([engine moveDiskFromTowerAtIndex:from toTowerAtIndex:to atTime:attempt], legal);
+                XCTAssertEqual(engine.remainingNumberOfMoves, (uint64_t)distance[[self stateOfEngine:engine]]);
+                if (!legal) {
+                    XCTAssertEqual(engine.remainingNumberOfMoves, before);
+                }
+            }
+            XCTAssertEqual(engine.excessMoveCount, engine.numberOfMoves + engine.remainingNumberOfMoves - engine.minimumNumberOfMoves);
+            XCTAssertEqual(engine.solved, engine.remainingNumberOfMoves == 0);
+        }
+    }
+}
+
+- (void)testOptimalSolutionHasNoExcessMoves {
+    ORKTowerOfHanoiEngine *engine = [[ORKTowerOfHanoiEngine alloc] initWithNumberOfDisks:8];
+    [engine beginAtTime:100];
+    NSTimeInterval time = 104.5;
+    [self solve:engine disks:8 from:0 to:2 via:1 time:&time];
+    
+    XCTAssertTrue(engine.solved);
+    XCTAssertEqual(engine.numberOfMoves, 255);
+    XCTAssertEqual(engine.excessMoveCount, 0);
+    XCTAssertEqual(engine.regressionMoveCount, 0);
+    XCTAssertEqual(engine.planningLatency, 4.5);
+    
+    ORKTowerOfHanoiResult *result = [engine resultWithIdentifier:@"hanoi"];
+    XCTAssertTrue(result.puzzleWasSolved);
+    XCTAssertEqual(result.minimumNumberOfMoves, 255);
+    XCTAssertEqual(result.excessMoveCount, 0);
+    XCTAssertEqual(result.regressionMoveCount, 0);
+    XCTAssertEqual(result.planningLatency, 4.5);
+    XCTAssertEqual(result.moves.count, 255);
+    XCTAssertEqual(result.moves.firstObject.timestamp, 0);
+    XCTAssertEqual(result.moves.lastObject.timestamp, 254);
+}
+
+- (void)testDetourCountsExcessAndRegressionMoves {
+    ORKTowerOfHanoiEngine *engine = [[ORKTowerOfHanoiEngine alloc] initWithNumberOfDisks:3];
+    XCTAssertEqual(engine.planningLatency, 0);
+    
+    // The optimal first move for three disks is onto the last tower; moving there and back wastes two moves.
+    XCTAssertTrue([engine moveDiskFromTowerAtIndex:0 toTowerAtIndex:2 atTime:0]);
+    XCTAssertEqual(engine.remainingNumberOfMoves, 6);
+    XCTAssertTrue([engine moveDiskFromTowerAtIndex:2 toTowerAtIndex:0 atTime:1]);
+    XCTAssertEqual(engine.remainingNumberOfMoves, 7);
+    XCTAssertEqual(engine.regressionMoveCount, 1);
+    XCTAssertEqual(engine.excessMoveCount, 2);
+    
+    // A suboptimal first move does not raise the remaining count, but still costs excess moves.
+    XCTAssertTrue([engine moveDiskFromTowerAtIndex:0 toTowerAtIndex:1 atTime:2]);
+    XCTAssertEqual(engine.regressionMoveCount, 1);
+    XCTAssertGreaterThan(engine.excessMoveCount, 2);
+}
+
+- (void)testResultRoundTrip {
+    ORKTowerOfHanoiEngine *engine = [[ORKTowerOfHanoiEngine alloc] initWithNumberOfDisks:4];
+    [engine beginAtTime:0];
+    [engine moveDiskFromTowerAtIndex:0 toTowerAtIndex:2 atTime:2];
+    [engine moveDiskFromTowerAtIndex:2 toTowerAtIndex:1 atTime:3];
+    ORKTowerOfHanoiResult *result = [engine resultWithIdentifier:@"hanoi"];
+    
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:result requiringSecureCoding:YES error:nil];
+    ORKTowerOfHanoiResult *decoded = [NSKeyedUnarchiver unarchivedObjectOfClass:[ORKTowerOfHanoiResult class] fromData:data error:nil];
+    XCTAssertEqualObjects(decoded, result);
+    XCTAssertEqual(decoded.regressionMoveCount, result.regressionMoveCount);
+    XCTAssertEqual(decoded.planningLatency, 2);
+    XCTAssertEqualObjects([result copy], result);
+}
+
+- (void)testRandomMoveReplayPerformance {
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        ORKRandomNumberGenerator *generator = [[ORKRandomNumberGenerator alloc] initWithSeed:7];
+        NSUInteger legalMoves = 0;
+        for (NSUInteger sequence = 0; sequence < ORKTowerOfHanoiBenchmarkSequenceCount; sequence++) {
+            ORKTowerOfHanoiEngine *engine = [[ORKTowerOfHanoiEngine alloc] initWithNumberOfDisks:8];
+            for (NSUInteger attempt = 0; attempt < ORKTowerOfHanoiBenchmarkSequenceLength; attempt++) {
+                uint64_t draw = [generator nextUInt64];
+                if ([engine moveDiskFromTowerAtIndex:draw % 3 toTowerAtIndex:(draw >> 8) % 3 atTime:attempt]) {
+                    legalMoves++;
+                }
+            }
+        }
+        XCTAssertGreaterThan(legalMoves, 0);
+    }];
+}
+
+@end
@@ -0,0 +1,298 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import CoreLocation;
+@import ResearchKit_Private;
+@import ResearchKitActiveTask;
+@import ResearchKitActiveTask_Private;
+
+
+#if ORK_FEATURE_CLLOCATIONMANAGER_AUTHORIZATION
+static const NSTimeInterval ReferenceTime = 1700000000;
+
+// A walk around a block at 1.4 m/s, turning every minute, with one sample per second and GPS noise
+// of about a meter.
+static NSArray<CLLocation *> *ORKWalkingTrack(NSUInteger count) {
+    const CLLocationCoordinate2D origin = CLLocationCoordinate2DMake(37.3318, -122.0312);
+    const double metersPerDegree = 6371008.8 * M_PI / 180.0;
+    srand48(7);
+    NSMutableArray<CLLocation *> *locations = [NSMutableArray arrayWithCapacity:count];
+    double x = 0;
+    double y = 0;
+    double heading = 0;
+    for (NSUInteger second = 0; second < count; second++) {
+        if (second % 60 == 0) {
+            heading += M_PI_2;
+        }
+        x += 1.4 * cos(heading);
+        y += 1.4 * sin(heading);
+        const double noisyX = x + (2 * drand48() - 1);
+        const double noisyY = y + (2 * drand48() - 1);
+        CLLocationCoordinate2D coordinate = CLLocationCoordinate2DMake(origin.latitude + (noisyY / metersPerDegree),
+                                                                       origin.longitude + (noisyX / (metersPerDegree * cos(origin.latitude * M_PI / 180.0))));
+        [locations addObject:[[CLLocation alloc] initWithCoordinate:coordinate
+                                                           altitude:20.0 + (0.1 * second)
+                                                 horizontalAccuracy:5.0
+                                                   verticalAccuracy:3.0
+                                                             course:fmod(heading * 180.0 / M_PI, 360.0)
+                                                              speed:1.4
+                                                          timestamp:[NSDate dateWithTimeIntervalSince1970:ReferenceTime + second]]];
+    }
+    return locations;
+}
+
+static CLLocationCoordinate2D ORKCoordinateOfDictionary(NSDictionary *dictionary) {
+    return CLLocationCoordinate2DMake([dictionary[@"coordinate"][@"latitude"] doubleValue], [dictionary[@"coordinate"][@"longitude"] doubleValue]);
+}
+
+// The distance from `location` to the trajectory through `dictionaries`, interpolated linearly to the
+// time of `location`.
+static CLLocationDistance ORKDistanceFromTrajectory(CLLocation *location, NSArray<NSDictionary *> *dictionaries) {
+    const NSTimeInterval time = location.timestamp.timeIntervalSince1970;
+    for (NSUInteger index = 0; index + 1 < dictionaries.count; index++) {
+        const NSTimeInterval startTime = ORKDateFromStringISO8601(dictionaries[index][@"timestamp"]).timeIntervalSince1970;
+        const NSTimeInterval endTime = ORKDateFromStringISO8601(dictionaries[index + 1][@"timestamp"]).timeIntervalSince1970;
+        if (time < startTime || time > endTime) {
+            continue;
+        }
+        const CLLocationCoordinate2D start = ORKCoordinateOfDictionary(dictionaries[index]);
+        const CLLocationCoordinate2D end = ORKCoordinateOfDictionary(dictionaries[index + 1]);
+        const double fraction = endTime > startTime ? (time - startTime) / (endTime - startTime) : 0;
+        CLLocation *interpolated = [[CLLocation alloc] initWithLatitude:start.latitude + fraction * (end.latitude - start.latitude)
+                                                              longitude:start.longitude + fraction * (end.longitude - start.longitude)];
+        return [location distanceFromLocation:interpolated];
+    }
+    return DBL_MAX;
+}
+
+
+@interface ORKTrajectoryEncoderTests : XCTestCase
+
+@end
+
+
+@implementation ORKTrajectoryEncoderTests
+
+- (NSArray *)recordsForLocations:(NSArray<CLLocation *> *)locations encoder:(ORKTrajectoryEncoder *)encoder {
+    NSMutableArray *records = [NSMutableArray array];
+    // Deliver the locations in small batches, as the location manager does.
+    for (NSUInteger index = 0; index < locations.count; index += 3) {
+        [records addObjectsFromArray:[encoder recordsByEncodingLocations:[locations subarrayWithRange:NSMakeRange(index, MIN(3, locations.count - index))]]];
+    }
+    [records addObjectsFromArray:[encoder recordsByFinishing]];
+    return records;
+}
+
+#pragma mark - Accuracy
+
+- (void)testLosslessEncodingRestoresLocationDictionaries {
+    NSDate *timestamp = [NSDate dateWithTimeIntervalSince1970:ReferenceTime + 0.75];
+    NSArray<CLLocation *> *locations = @[
+        [[CLLocation alloc] initWithCoordinate:CLLocationCoordinate2DMake(37.31317, -122.07238159997) altitude:11.25 horizontalAccuracy:12.0 verticalAccuracy:13.0 course:14.5 speed:15.25 timestamp:timestamp],
+        [[CLLocation alloc] initWithCoordinate:CLLocationCoordinate2DMake(37.3132, -122.0724) altitude:-3.5 horizontalAccuracy:4.0 verticalAccuracy:-1.0 course:-1.0 speed:-1.0 timestamp:[timestamp dateByAddingTimeInterval:1]],
+        [[CLLocation alloc] initWithCoordinate:kCLLocationCoordinate2DInvalid altitude:12.0 horizontalAccuracy:-1.0 verticalAccuracy:2.0 course:359.99 speed:0 timestamp:[timestamp dateByAddingTimeInterval:2]],
+        [[CLLocation alloc] initWithCoordinate:CLLocationCoordinate2DMake(-33.8568, 151.2153) altitude:0 horizontalAccuracy:65.0 verticalAccuracy:10.0 course:0 speed:30.0 timestamp:[timestamp dateByAddingTimeInterval:3600]],
+    ];
+    ORKTrajectoryEncoder *encoder = [[ORKTrajectoryEncoder alloc] initWithTolerance:0];
+    NSArray *records = [self recordsForLocations:locations encoder:encoder];
+    XCTAssertEqual(records.count, locations.count + 2);
+    XCTAssertEqual(encoder.locationCount, locations.count);
+    XCTAssertEqual(encoder.discardedLocationCount, 0);
+    
+    NSError *error = nil;
+    NSArray<NSDictionary *> *dictionaries = [ORKTrajectoryEncoder locationDictionariesWithRecords:records error:&error];
+    XCTAssertNil(error);
+    XCTAssertEqual(dictionaries.count, locations.count);
+    
+    [locations enumerateObjectsUsingBlock:^(CLLocation *location, NSUInteger index, BOOL *stop) {
+        NSDictionary *expected = [location ork_JSONDictionary];
+        NSDictionary *decoded = dictionaries[index];
+        XCTAssertEqualObjects([NSSet setWithArray:decoded.allKeys], [NSSet setWithArray:expected.allKeys], @"%lu", (unsigned long)index);
+        XCTAssertEqualObjects(decoded[@"timestamp"], expected[@"timestamp"]);
+        for (NSString *key in @[@"horizontalAccuracy", @"altitude", @"verticalAccuracy", @"course", @"speed"]) {
+            XCTAssertEqualWithAccuracy([decoded[key] doubleValue], [expected[key] doubleValue], 0.005, @"%@", key);
+        }
+        XCTAssertEqualWithAccuracy([decoded[@"coordinate"][@"latitude"] doubleValue], [expected[@"coordinate"][@"latitude"] doubleValue], 5e-8);
+        XCTAssertEqualWithAccuracy([decoded[@"coordinate"][@"longitude"] doubleValue], [expected[@"coordinate"][@"longitude"] doubleValue], 5e-8);
+    }];
+}
+
+- (void)testSimplifiedTrackStaysWithinTolerance {
+    NSArray<CLLocation *> *track = ORKWalkingTrack(360);
+    for (NSNumber *tolerance in @[@1, @2, @5, @10]) {
+        ORKTrajectoryEncoder *encoder = [[ORKTrajectoryEncoder alloc] initWithTolerance:tolerance.doubleValue];
+        NSArray<NSDictionary *> *dictionaries = [ORKTrajectoryEncoder locationDictionariesWithRecords:[self recordsForLocations:track encoder:encoder] error:NULL];
+        
+        XCTAssertEqual(encoder.discardedLocationCount + dictionaries.count, track.count, @"%@", tolerance);
+        XCTAssertLessThanOrEqual(encoder.maximumDiscardedError, tolerance.doubleValue);
+        XCTAssertLessThanOrEqual(encoder.meanDiscardedError, encoder.maximumDiscardedError);
+        XCTAssertEqualObjects(dictionaries.firstObject[@"timestamp"], [track.firstObject ork_JSONDictionary][@"timestamp"]);
+        XCTAssertEqualObjects(dictionaries.lastObject[@"timestamp"], [track.lastObject ork_JSONDictionary][@"timestamp"]);
+        
+        CLLocationDistance maximumDistance = 0;
+        for (CLLocation *location in track) {
+            maximumDistance = MAX(maximumDistance, ORKDistanceFromTrajectory(location, dictionaries));
+        }
+        // Allow for the fixed-point coordinates and the difference between the projection used by
+        // the encoder and the geodesic distance.
+        XCTAssertLessThanOrEqual(maximumDistance, (tolerance.doubleValue * 1.01) + 0.05, @"%@", tolerance);
+    }
+    
+    ORKTrajectoryEncoder *encoder = [[ORKTrajectoryEncoder alloc] initWithTolerance:5];
+    [self recordsForLocations:track encoder:encoder];
+    // Little more than the corners of the block are kept.
+    XCTAssertLessThan(track.count - encoder.discardedLocationCount, 20);
+}
+
+- (void)testStraightTrackIsSimplifiedInBoundedWindows {
+    NSMutableArray<CLLocation *> *track = [NSMutableArray array];
+    for (NSUInteger second = 0; second < 1000; second++) {
+        [track addObject:[[CLLocation alloc] initWithCoordinate:CLLocationCoordinate2DMake(37.0 + (second * 1e-4), -122.0)
+                                                       altitude:0
+                                             horizontalAccuracy:5.0
+                                               verticalAccuracy:-1.0
+                                                         course:0
+                                                          speed:11.1
+                                                      timestamp:[NSDate dateWithTimeIntervalSince1970:ReferenceTime + second]]];
+    }
+    ORKTrajectoryEncoder *encoder = [[ORKTrajectoryEncoder alloc] initWithTolerance:1];
+    NSArray<NSDictionary *> *dictionaries = [ORKTrajectoryEncoder locationDictionariesWithRecords:[self recordsForLocations:track encoder:encoder] error:NULL];
+    
+    XCTAssertGreaterThanOrEqual(dictionaries.count, 5);
+    XCTAssertLessThanOrEqual(dictionaries.count, 6);
+    XCTAssertLessThan(encoder.maximumDiscardedError, 0.05);
+}
+
+- (void)testLocationsWithoutCoordinateAreKept {
+    NSMutableArray<CLLocation *> *track = [ORKWalkingTrack(120) mutableCopy];
+    track[30] = [[CLLocation alloc] initWithCoordinate:kCLLocationCoordinate2DInvalid altitude:0 horizontalAccuracy:-1 verticalAccuracy:-1 course:-1 speed:-1 timestamp:track[30].timestamp];
+    
+    ORKTrajectoryEncoder *encoder = [[ORKTrajectoryEncoder alloc] initWithTolerance:10];
+    NSArray<NSDictionary *> *dictionaries = [ORKTrajectoryEncoder locationDictionariesWithRecords:[self recordsForLocations:track encoder:encoder] error:NULL];
+    
+    NSUInteger index = [dictionaries indexOfObjectPassingTest:^BOOL(NSDictionary *dictionary, NSUInteger idx, BOOL *stop) {
+        return dictionary[@"coordinate"] == nil;
+    }];
+    XCTAssertNotEqual(index, NSNotFound);
+    XCTAssertEqualObjects(dictionaries[index], [track[30] ork_JSONDictionary]);
+    // The locations on either side of the gap are kept too.
+    XCTAssertEqualObjects(dictionaries[index - 1][@"timestamp"], [track[29] ork_JSONDictionary][@"timestamp"]);
+    XCTAssertEqualObjects(dictionaries[index + 1][@"timestamp"], [track[31] ork_JSONDictionary][@"timestamp"]);
+}
+
+- (void)testSummaryRecord {
+    ORKTrajectoryEncoder *encoder = [[ORKTrajectoryEncoder alloc] initWithTolerance:5];
+    NSArray *records = [self recordsForLocations:ORKWalkingTrack(360) encoder:encoder];
+    
+    XCTAssertEqualObjects(records.firstObject[@"trajectory"][@"tolerance"], @5);
+    NSDictionary *summary = records.lastObject[@"summary"];
+    XCTAssertEqualObjects(summary[@"locationCount"], @360);
+    XCTAssertEqualObjects(summary[@"discardedLocationCount"], @(encoder.discardedLocationCount));
+    XCTAssertEqualWithAccuracy([summary[@"maximumDiscardedError"] doubleValue], encoder.maximumDiscardedError, 1e-9);
+    XCTAssertEqualWithAccuracy([summary[@"meanDiscardedError"] doubleValue], encoder.meanDiscardedError, 1e-9);
+}
+
+#pragma mark - Decoding
+
+- (void)testCompressedLogDecodesToLocationLog {
+    NSArray<CLLocation *> *track = ORKWalkingTrack(60);
+    NSArray *records = [self recordsForLocations:track encoder:[[ORKTrajectoryEncoder alloc] initWithTolerance:0]];
+    NSData *data = [NSJSONSerialization dataWithJSONObject:@{ @"items": records } options:0 error:nil];
+    
+    NSError *error = nil;
+    NSData *logData = [ORKTrajectoryEncoder JSONLogDataWithCompressedLogData:data error:&error];
+    XCTAssertNil(error);
+    NSArray<NSDictionary *> *items = [NSJSONSerialization JSONObjectWithData:logData options:0 error:nil][@"items"];
+    XCTAssertEqual(items.count, track.count);
+    [track enumerateObjectsUsingBlock:^(CLLocation *location, NSUInteger index, BOOL *stop) {
+        XCTAssertEqualObjects(items[index][@"timestamp"], [location ork_JSONDictionary][@"timestamp"]);
+        XCTAssertEqualWithAccuracy([items[index][@"coordinate"][@"latitude"] doubleValue], location.coordinate.latitude, 5e-8);
+        XCTAssertEqualWithAccuracy([items[index][@"altitude"] doubleValue], location.altitude, 0.005);
+    }];
+}
+
+- (void)testMalformedRecords {
+    NSArray *valid = [self recordsForLocations:ORKWalkingTrack(10) encoder:[[ORKTrajectoryEncoder alloc] initWithTolerance:0]];
+    NSArray *malformed = @[
+        @[],
+        [valid subarrayWithRange:NSMakeRange(1, valid.count - 1)],
+        @[ @{ @"trajectory": @{ @"version": @2 } } ],
+        [@[valid.firstObject, @[]] arrayByAddingObjectsFromArray:valid],
+        @[valid.firstObject, @[@"1"]],
+        @[valid.firstObject, @{ @"timestamp": @"2023-11-14T22:13:20+0000" }],
+    ];
+    for (NSArray *records in malformed) {
+        NSError *error = nil;
+        XCTAssertNil([ORKTrajectoryEncoder locationDictionariesWithRecords:records error:&error]);
+        XCTAssertEqualObjects(error.domain, ORKErrorDomain);
+        XCTAssertEqual(error.code, ORKErrorInvalidObject);
+    }
+    
+    NSError *error = nil;
+    NSData *uncompressed = [NSJSONSerialization dataWithJSONObject:@{ @"items": @[ [ORKWalkingTrack(1).firstObject ork_JSONDictionary] ] } options:0 error:nil];
+    XCTAssertNil([ORKTrajectoryEncoder JSONLogDataWithCompressedLogData:uncompressed error:&error]);
+    XCTAssertEqual(error.code, ORKErrorInvalidObject);
+}
+
+#pragma mark - Benchmarks
+
+- (void)testCompressedSizeOfWalkingTrack {
+    NSArray<CLLocation *> *track = ORKWalkingTrack(360);
+    NSMutableArray<NSDictionary *> *dictionaries = [NSMutableArray arrayWithCapacity:track.count];
+    for (CLLocation *location in track) {
+        [dictionaries addObject:[location ork_JSONDictionary]];
+    }
+    const NSUInteger uncompressedLength = [NSJSONSerialization dataWithJSONObject:@{ @"items": dictionaries } options:0 error:nil].length;
+    
+    NSArray *losslessRecords = [self recordsForLocations:track encoder:[[ORKTrajectoryEncoder alloc] initWithTolerance:0]];
+    const NSUInteger losslessLength = [NSJSONSerialization dataWithJSONObject:@{ @"items": losslessRecords } options:0 error:nil].length;
+    NSArray *simplifiedRecords = [self recordsForLocations:track encoder:[[ORKTrajectoryEncoder alloc] initWithTolerance:5]];
+    const NSUInteger simplifiedLength = [NSJSONSerialization dataWithJSONObject:@{ @"items": simplifiedRecords } options:0 error:nil].length;
+    
+    XCTAssertLessThan(losslessLength * 3, uncompressedLength);
+    XCTAssertLessThan(simplifiedLength * 50, uncompressedLength);
+}
+
+- (void)testHourLongTrackThroughput {
+    // An hour of locations at 1 Hz.
+    NSArray<CLLocation *> *track = ORKWalkingTrack(3600);
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        ORKTrajectoryEncoder *encoder = [[ORKTrajectoryEncoder alloc] initWithTolerance:5];
+        for (CLLocation *location in track) {
+            [encoder recordsByEncodingLocations:@[location]];
+        }
+        [encoder recordsByFinishing];
+    }];
+}
+
+@end
+#endif
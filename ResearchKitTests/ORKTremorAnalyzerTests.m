@@ -0,0 +1,316 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import ResearchKit_Private;
+@import ResearchKitActiveTask;
+@import ResearchKitActiveTask_Private;
+
+
+static const double SamplingFrequency = 100.0;
+
+typedef void (^ORKTremorSampleHandler)(NSTimeInterval timestamp, ORKTremorVector userAcceleration, ORKTremorVector rotationRate);
+
+// A tremor at `frequency` with an optional second harmonic, split across the x and y axes, on top of
+// a slow voluntary movement along z and a small amount of deterministic noise. The rotation rate
+// follows the acceleration at ten times its amplitude.
+static void ORKGenerateTremor(NSTimeInterval duration, double frequency, double amplitude, double harmonicAmplitude, ORKTremorSampleHandler handler) {
+    srand48(42);
+    const NSUInteger count = (NSUInteger)(duration * SamplingFrequency);
+    for (NSUInteger index = 0; index < count; index++) {
+        const NSTimeInterval t = index / SamplingFrequency;
+        const double tremor = ((amplitude * sin(2 * M_PI * frequency * t)) +
+                               (harmonicAmplitude * sin(4 * M_PI * frequency * t)) +
+                               (0.002 * ((2 * drand48()) - 1)));
+        const double voluntary = 0.2 * sin(2 * M_PI * 0.4 * t);
+        const ORKTremorVector userAcceleration = { 0.6 * tremor, 0.8 * tremor, voluntary };
+        const ORKTremorVector rotationRate = { 10 * 0.8 * tremor, -10 * 0.6 * tremor, 0 };
+        handler(t, userAcceleration, rotationRate);
+    }
+}
+
+
+@interface ORKTremorAnalyzerTests : XCTestCase
+
+@end
+
+
+@implementation ORKTremorAnalyzerTests
+
+- (NSURL *)writeLogWithItems:(NSArray<NSDictionary *> *)items {
+    NSURL *URL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    NSData *data = [NSJSONSerialization dataWithJSONObject:@{ @"items": items } options:0 error:nil];
+    [data writeToURL:URL atomically:YES];
+    [self addTeardownBlock:^{
+        [[NSFileManager defaultManager] removeItemAtURL:URL error:nil];
+    }];
+    return URL;
+}
+
+- (ORKTremorResult *)resultForTremorWithFrequency:(double)frequency amplitude:(double)amplitude harmonicAmplitude:(double)harmonicAmplitude {
+    ORKTremorAnalyzer *analyzer = [[ORKTremorAnalyzer alloc] initWithFrequency:SamplingFrequency];
+    ORKGenerateTremor(60.0, frequency, amplitude, harmonicAmplitude, ^(NSTimeInterval timestamp, ORKTremorVector userAcceleration, ORKTremorVector rotationRate) {
+        [analyzer appendSampleWithTimestamp:timestamp userAcceleration:userAcceleration rotationRate:rotationRate];
+    });
+    return [analyzer resultWithIdentifier:@"motion.tremor"];
+}
+
+#pragma mark - Accuracy
+
+- (void)testRestingTremor {
+    ORKTremorResult *result = [self resultForTremorWithFrequency:5.0 amplitude:0.1 harmonicAmplitude:0];
+    
+    XCTAssertEqualObjects(result.identifier, @"motion.tremor");
+    XCTAssertEqualWithAccuracy(result.duration, 59.99, 0.001);
+    XCTAssertEqualWithAccuracy(result.accelerationDominantFrequency, 5.0, 0.05);
+    // A sine of amplitude A has a power of A² / 2, however it is split across axes.
+    XCTAssertEqualWithAccuracy(result.accelerationLowBandPower, 0.005, 0.00025);
+    XCTAssertLessThan(result.accelerationHighBandPower, 1e-5);
+    XCTAssertLessThan(result.accelerationHarmonicRatio, 0.01);
+    
+    XCTAssertEqualWithAccuracy(result.rotationRateDominantFrequency, 5.0, 0.05);
+    XCTAssertEqualWithAccuracy(result.rotationRateLowBandPower, 0.5, 0.025);
+}
+
+- (void)testPhysiologicalTremor {
+    ORKTremorResult *result = [self resultForTremorWithFrequency:10.0 amplitude:0.2 harmonicAmplitude:0];
+    
+    XCTAssertEqualWithAccuracy(result.accelerationDominantFrequency, 10.0, 0.05);
+    XCTAssertEqualWithAccuracy(result.accelerationHighBandPower, 0.02, 0.001);
+    XCTAssertLessThan(result.accelerationLowBandPower, 1e-4);
+}
+
+- (void)testFrequencyBetweenBins {
+    for (NSNumber *frequency in @[@3.7, @4.45, @6.3, @8.85, @11.2]) {
+        ORKTremorResult *result = [self resultForTremorWithFrequency:frequency.doubleValue amplitude:0.05 harmonicAmplitude:0];
+        XCTAssertEqualWithAccuracy(result.accelerationDominantFrequency, frequency.doubleValue, 0.05, @"%@", frequency);
+    }
+}
+
+- (void)testHarmonicRatio {
+    ORKTremorResult *result = [self resultForTremorWithFrequency:4.5 amplitude:0.1 harmonicAmplitude:0.05];
+    
+    XCTAssertEqualWithAccuracy(result.accelerationDominantFrequency, 4.5, 0.05);
+    XCTAssertEqualWithAccuracy(result.accelerationHarmonicRatio, 0.25, 0.02);
+    XCTAssertEqualWithAccuracy(result.rotationRateHarmonicRatio, 0.25, 0.02);
+}
+
+- (void)testStillDeviceHasNoDominantFrequency {
+    ORKTremorAnalyzer *analyzer = [[ORKTremorAnalyzer alloc] initWithFrequency:SamplingFrequency];
+    for (NSUInteger index = 0; index < 3000; index++) {
+        [analyzer appendSampleWithTimestamp:index / SamplingFrequency userAcceleration:(ORKTremorVector){ 0, 0, 0 } rotationRate:(ORKTremorVector){ 0, 0, 0 }];
+    }
+    ORKTremorResult *result = [analyzer resultWithIdentifier:@"tremor"];
+    
+    XCTAssertEqual(result.accelerationDominantFrequency, 0.0);
+    XCTAssertEqual(result.accelerationLowBandPower, 0.0);
+    XCTAssertEqual(result.accelerationHarmonicRatio, 0.0);
+}
+
+- (void)testShortRecordingHasNoFeatures {
+    ORKTremorAnalyzer *analyzer = [[ORKTremorAnalyzer alloc] initWithFrequency:SamplingFrequency];
+    ORKGenerateTremor(2.0, 5.0, 0.1, 0, ^(NSTimeInterval timestamp, ORKTremorVector userAcceleration, ORKTremorVector rotationRate) {
+        [analyzer appendSampleWithTimestamp:timestamp userAcceleration:userAcceleration rotationRate:rotationRate];
+    });
+    
+    XCTAssertEqual(analyzer.sampleCount, 200);
+    XCTAssertEqual([analyzer resultWithIdentifier:@"tremor"].accelerationDominantFrequency, 0.0);
+}
+
+- (void)testReset {
+    ORKTremorAnalyzer *analyzer = [[ORKTremorAnalyzer alloc] initWithFrequency:SamplingFrequency];
+    ORKGenerateTremor(10.0, 5.0, 0.1, 0, ^(NSTimeInterval timestamp, ORKTremorVector userAcceleration, ORKTremorVector rotationRate) {
+        [analyzer appendSampleWithTimestamp:timestamp userAcceleration:userAcceleration rotationRate:rotationRate];
+    });
+    XCTAssertGreaterThan([analyzer resultWithIdentifier:@"tremor"].accelerationDominantFrequency, 0.0);
+    
+    [analyzer reset];
+    XCTAssertEqual(analyzer.sampleCount, 0);
+    ORKTremorResult *result = [analyzer resultWithIdentifier:@"tremor"];
+    XCTAssertEqual(result.accelerationDominantFrequency, 0.0);
+    XCTAssertEqual(result.duration, 0.0);
+}
+
+#pragma mark - Spectrum
+
+- (void)testVectorTransformMatchesPortableTransform {
+    for (size_t length = 4; length <= 1024; length *= 2) {
+        double *samples = malloc(length * sizeof(double));
+        double *vectorPower = malloc(((length / 2) + 1) * sizeof(double));
+        double *portablePower = malloc(((length / 2) + 1) * sizeof(double));
+        srand48((long)length);
+        for (size_t index = 0; index < length; index++) {
+            samples[index] = drand48() - 0.5;
+        }
+        
+        ORKTremorFFT *vectorFFT = ORKTremorFFTCreate(length, false);
+        ORKTremorFFT *portableFFT = ORKTremorFFTCreate(length, true);
+        ORKTremorFFTPower(vectorFFT, samples, vectorPower);
+        ORKTremorFFTPower(portableFFT, samples, portablePower);
+        
+        // Bin 1 of the transform against a direct sum.
+        double real = 0;
+        double imaginary = 0;
+        for (size_t index = 0; index < length; index++) {
+            real += samples[index] * cos(2 * M_PI * index / length);
+            imaginary -= samples[index] * sin(2 * M_PI * index / length);
+        }
+        XCTAssertEqualWithAccuracy(portablePower[1], (real * real) + (imaginary * imaginary), 1e-9);
+        
+        for (size_t bin = 0; bin <= length / 2; bin++) {
+            XCTAssertEqualWithAccuracy(vectorPower[bin], portablePower[bin], 1e-9 * MAX(1.0, portablePower[bin]), @"%zu %zu", length, bin);
+        }
+        
+        ORKTremorFFTDestroy(vectorFFT);
+        ORKTremorFFTDestroy(portableFFT);
+        free(samples);
+        free(vectorPower);
+        free(portablePower);
+    }
+    
+    XCTAssertTrue(ORKTremorFFTCreate(6, false) == NULL);
+    XCTAssertTrue(ORKTremorSpectrumCreate(SamplingFrequency, 100, 3) == NULL);
+}
+
+- (void)testDensityOfWhiteNoise {
+    // Uniform noise on [-0.5, 0.5] has a variance of 1 / 12, spread evenly up to the Nyquist
+    // frequency.
+    ORKTremorSpectrum *spectrum = ORKTremorSpectrumCreate(SamplingFrequency, 256, 1);
+    srand48(3);
+    for (NSUInteger index = 0; index < 60000; index++) {
+        const double value = drand48() - 0.5;
+        ORKTremorSpectrumAppend(spectrum, &value);
+    }
+    
+    size_t binCount = 0;
+    const double *density = ORKTremorSpectrumDensity(spectrum, &binCount);
+    XCTAssertEqual(binCount, 129);
+    XCTAssertEqual(ORKTremorSpectrumSegmentCount(spectrum), (60000 - 256) / 128 + 1);
+    XCTAssertEqualWithAccuracy(ORKTremorSpectrumBinWidth(spectrum), SamplingFrequency / 256, 1e-12);
+    
+    double variance = 0;
+    for (size_t bin = 0; bin < binCount; bin++) {
+        variance += density[bin] * ORKTremorSpectrumBinWidth(spectrum);
+    }
+    XCTAssertEqualWithAccuracy(variance, 1.0 / 12.0, 0.004);
+    XCTAssertEqualWithAccuracy(density[64], (1.0 / 12.0) / (SamplingFrequency / 2), 0.0003);
+    ORKTremorSpectrumDestroy(spectrum);
+}
+
+#pragma mark - Logs
+
+- (void)testReplayOfDeviceMotionLog {
+    ORKTremorAnalyzer *streamingAnalyzer = [[ORKTremorAnalyzer alloc] initWithFrequency:SamplingFrequency];
+    NSMutableArray<NSDictionary *> *items = [NSMutableArray new];
+    ORKGenerateTremor(20.0, 5.5, 0.05, 0.01, ^(NSTimeInterval timestamp, ORKTremorVector userAcceleration, ORKTremorVector rotationRate) {
+        [streamingAnalyzer appendSampleWithTimestamp:timestamp userAcceleration:userAcceleration rotationRate:rotationRate];
+        [items addObject:@{ @"timestamp": @(timestamp),
+                            @"userAcceleration": @{ @"x": @(userAcceleration.x), @"y": @(userAcceleration.y), @"z": @(userAcceleration.z) },
+                            @"rotationRate": @{ @"x": @(rotationRate.x), @"y": @(rotationRate.y), @"z": @(rotationRate.z) } }];
+    });
+    // Accelerometer entries are skipped.
+    [items addObject:@{ @"timestamp": @(20.0), @"x": @(0), @"y": @(0), @"z": @(1) }];
+    
+    ORKTremorAnalyzer *replayAnalyzer = [[ORKTremorAnalyzer alloc] initWithFrequency:SamplingFrequency];
+    NSError *error = nil;
+    XCTAssertTrue([replayAnalyzer replayJSONLogAtURL:[self writeLogWithItems:items] error:&error]);
+    XCTAssertNil(error);
+    XCTAssertEqual(replayAnalyzer.sampleCount, streamingAnalyzer.sampleCount);
+    
+    ORKTremorResult *streamingResult = [streamingAnalyzer resultWithIdentifier:@"tremor"];
+    ORKTremorResult *replayResult = [replayAnalyzer resultWithIdentifier:@"tremor"];
+    XCTAssertEqualWithAccuracy(replayResult.accelerationDominantFrequency, streamingResult.accelerationDominantFrequency, 1e-9);
+    XCTAssertEqualWithAccuracy(replayResult.accelerationLowBandPower, streamingResult.accelerationLowBandPower, 1e-12);
+    XCTAssertEqualWithAccuracy(replayResult.rotationRateHarmonicRatio, streamingResult.rotationRateHarmonicRatio, 1e-9);
+}
+
+- (void)testReplayOfMalformedLog {
+    NSURL *URL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    [[@"[1, 2, 3]" dataUsingEncoding:NSUTF8StringEncoding] writeToURL:URL atomically:YES];
+    
+    ORKTremorAnalyzer *analyzer = [[ORKTremorAnalyzer alloc] initWithFrequency:SamplingFrequency];
+    NSError *error = nil;
+    XCTAssertFalse([analyzer replayJSONLogAtURL:URL error:&error]);
+    XCTAssertEqual(error.code, NSFileReadCorruptFileError);
+    [[NSFileManager defaultManager] removeItemAtURL:URL error:nil];
+}
+
+#pragma mark - Configuration
+
+- (void)testTremorTaskAnalyzesEveryPose {
+    ORKOrderedTask *task = [ORKOrderedTask tremorTestTaskWithIdentifier:@"tremor"
+                                                 intendedUseDescription:nil
+                                                     activeStepDuration:10
+                                                      activeTaskOptions:ORKTremorActiveTaskOptionNone
+                                                            handOptions:ORKPredefinedTaskHandOptionBoth
+                                                                options:ORKPredefinedTaskOptionNone];
+    NSUInteger analyzedPoseCount = 0;
+    for (ORKStep *step in task.steps) {
+        if (![step isKindOfClass:[ORKActiveStep class]]) {
+            continue;
+        }
+        for (ORKRecorderConfiguration *configuration in ((ORKActiveStep *)step).recorderConfigurations) {
+            if ([configuration isKindOfClass:[ORKDeviceMotionRecorderConfiguration class]]) {
+                XCTAssertTrue(((ORKDeviceMotionRecorderConfiguration *)configuration).analyzesTremor, @"%@", step.identifier);
+                ORKDeviceMotionRecorder *recorder = (ORKDeviceMotionRecorder *)[configuration recorderForStep:step outputDirectory:nil];
+                XCTAssertTrue(recorder.analyzesTremor);
+                analyzedPoseCount += 1;
+            }
+        }
+    }
+    XCTAssertEqual(analyzedPoseCount, 10);
+}
+
+#pragma mark - Benchmarks
+
+- (void)testHourLongRecordingThroughput {
+    // An hour of device motion at 100 Hz.
+    const NSUInteger count = 360000;
+    double *samples = malloc(count * sizeof(double));
+    srand48(11);
+    for (NSUInteger index = 0; index < count; index++) {
+        samples[index] = (0.05 * sin(2 * M_PI * 5.0 * (index / SamplingFrequency))) + (0.002 * ((2 * drand48()) - 1));
+    }
+    
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        ORKTremorAnalyzer *analyzer = [[ORKTremorAnalyzer alloc] initWithFrequency:SamplingFrequency];
+        for (NSUInteger index = 0; index < count; index++) {
+            const double value = samples[index];
+            [analyzer appendSampleWithTimestamp:index / SamplingFrequency
+                               userAcceleration:(ORKTremorVector){ value, 0.5 * value, 0 }
+                                   rotationRate:(ORKTremorVector){ 10 * value, 0, -5 * value }];
+        }
+        [analyzer resultWithIdentifier:@"tremor"];
+    }];
+    free(samples);
+}
+
+@end
@@ -0,0 +1,421 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import XCTest;
+@import CoreLocation;
+@import ResearchKit_Private;
+@import ResearchKitActiveTask;
+@import ResearchKitActiveTask_Private;
+
+
+static const NSTimeInterval ReferenceTime = 1700000000;
+static const NSTimeInterval WalkDuration = 360;
+static const double WalkingSpeed = 1.3;
+static const double StrideLength = 0.72;
+
+typedef NS_ENUM(NSInteger, ORKWalkPath) {
+    ORKWalkPathLine,
+    ORKWalkPathLoop,
+};
+
+typedef NS_ENUM(NSInteger, ORKWalkInterruption) {
+    ORKWalkInterruptionNone,
+    ORKWalkInterruptionNoLocation,
+    ORKWalkInterruptionPoorAccuracy,
+    ORKWalkInterruptionStanding,
+};
+
+typedef struct {
+    ORKWalkPath path;
+    ORKWalkInterruption interruption;
+    NSTimeInterval interruptionStart;
+    NSTimeInterval interruptionEnd;
+    BOOL hasPedometer;
+    BOOL hasLocation;
+    BOOL pedometerEstimatesDistance;
+} ORKWalkScenario;
+
+typedef void (^ORKWalkLocationHandler)(CLLocation *location);
+typedef void (^ORKWalkPedometerHandler)(NSInteger numberOfSteps, double distance, NSDate *date);
+
+static double ORKGaussian(void) {
+    const double u = drand48();
+    const double v = drand48();
+    return sqrt(-2 * log(1 - u)) * cos(2 * M_PI * v);
+}
+
+// Six minutes of walking at 1.3 m/s with one location per second and a pedometer update every
+// three seconds. The location noise is correlated over about ten seconds, like GPS noise, with a
+// standard deviation of 3 meters. Returns the distance actually walked.
+static double ORKSimulateWalk(ORKWalkScenario scenario, long seed, ORKWalkLocationHandler locationHandler, ORKWalkPedometerHandler pedometerHandler) {
+    srand48(seed);
+    const CLLocationCoordinate2D origin = CLLocationCoordinate2DMake(37.3318, -122.0312);
+    const double metersPerDegree = 6371008.8 * M_PI / 180.0;
+    const double metersPerDegreeOfLongitude = metersPerDegree * cos(origin.latitude * M_PI / 180.0);
+    const double noiseCorrelation = 0.9;
+    const double noiseScale = sqrt(1 - (noiseCorrelation * noiseCorrelation)) * 3.0;
+    const BOOL pausesLocation = (scenario.interruption == ORKWalkInterruptionNoLocation || scenario.interruption == ORKWalkInterruptionPoorAccuracy);
+    
+    double noiseX = 0;
+    double noiseY = 0;
+    double distance = 0;
+    for (NSInteger second = 0; second <= WalkDuration; second++) {
+        const BOOL standing = (scenario.interruption == ORKWalkInterruptionStanding && second > scenario.interruptionStart && second <= scenario.interruptionEnd);
+        if (second > 0 && !standing) {
+            distance += WalkingSpeed;
+        }
+        double x = distance;
+        double y = 0;
+        if (scenario.path == ORKWalkPathLoop) {
+            const double radius = 400 / (2 * M_PI);
+            x = radius * sin(distance / radius);
+            y = radius - (radius * cos(distance / radius));
+        }
+        noiseX = (noiseCorrelation * noiseX) + (noiseScale * ORKGaussian());
+        noiseY = (noiseCorrelation * noiseY) + (noiseScale * ORKGaussian());
+        NSDate *date = [NSDate dateWithTimeIntervalSince1970:ReferenceTime + second];
+        
+        const NSInteger numberOfSteps = (NSInteger)floor(distance / StrideLength);
+        if (scenario.hasPedometer && second > 0 && second % 3 == 0) {
+            pedometerHandler(numberOfSteps, scenario.pedometerEstimatesDistance ? numberOfSteps * StrideLength : -1, date);
+        }
+        if (!scenario.hasLocation) {
+            continue;
+        }
+        
+        CLLocationAccuracy accuracy = 5;
+        const BOOL interrupted = pausesLocation && second >= scenario.interruptionStart && second < scenario.interruptionEnd;
+        if (interrupted && scenario.interruption == ORKWalkInterruptionNoLocation) {
+            continue;
+        } else if (interrupted) {
+            accuracy = 65;
+            x += 30 * ORKGaussian();
+            y += 30 * ORKGaussian();
+        } else {
+            x += noiseX;
+            y += noiseY;
+        }
+        CLLocationCoordinate2D coordinate = CLLocationCoordinate2DMake(origin.latitude + (y / metersPerDegree),
+                                                                       origin.longitude + (x / metersPerDegreeOfLongitude));
+        locationHandler([[CLLocation alloc] initWithCoordinate:coordinate
+                                                      altitude:0
+                                            horizontalAccuracy:accuracy
+                                              verticalAccuracy:-1
+                                                     timestamp:date]);
+    }
+    return distance;
+}
+
+
+@interface ORKWalkingDistanceEstimatorTests : XCTestCase
+
+@end
+
+
+@implementation ORKWalkingDistanceEstimatorTests
+
+- (NSURL *)writeLogWithItems:(NSArray<NSDictionary *> *)items {
+    NSURL *URL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    NSData *data = [NSJSONSerialization dataWithJSONObject:@{ @"items": items } options:0 error:nil];
+    [data writeToURL:URL atomically:YES];
+    [self addTeardownBlock:^{
+        [[NSFileManager defaultManager] removeItemAtURL:URL error:nil];
+    }];
+    return URL;
+}
+
+- (double)walkScenario:(ORKWalkScenario)scenario seed:(long)seed estimator:(ORKWalkingDistanceEstimator *)estimator {
+    return ORKSimulateWalk(scenario, seed, ^(CLLocation *location) {
+        [estimator appendLocation:location];
+    }, ^(NSInteger numberOfSteps, double distance, NSDate *date) {
+        [estimator appendPedometerStepCount:numberOfSteps distance:distance date:date];
+    });
+}
+
+// Checks the estimate against the ground truth for several noise realizations.
+- (void)assertScenario:(ORKWalkScenario)scenario gapFraction:(double)gapFraction {
+    for (long seed = 1; seed <= 3; seed++) {
+        ORKWalkingDistanceEstimator *estimator = [ORKWalkingDistanceEstimator new];
+        const double distance = [self walkScenario:scenario seed:seed estimator:estimator];
+        
+        XCTAssertEqualWithAccuracy(estimator.distance, distance, 0.05 * distance, @"seed %ld", seed);
+        XCTAssertEqualWithAccuracy(estimator.averagePace, WalkDuration / distance, 0.05 * WalkDuration / distance, @"seed %ld", seed);
+        XCTAssertEqualWithAccuracy(estimator.locationGapFraction, gapFraction, 0.02, @"seed %ld", seed);
+        XCTAssertEqualWithAccuracy(estimator.duration, scenario.hasLocation ? WalkDuration : WalkDuration - 3, 1e-6);
+        
+        // The walk ends at a steady pace.
+        XCTAssertEqualWithAccuracy(estimator.pace, 1 / WalkingSpeed, 0.35 / WalkingSpeed, @"seed %ld", seed);
+    }
+}
+
+#pragma mark - Accuracy
+
+- (void)testStraightWalk {
+    [self assertScenario:(ORKWalkScenario){ ORKWalkPathLine, ORKWalkInterruptionNone, 0, 0, YES, YES, NO } gapFraction:0];
+}
+
+- (void)testLoopWalk {
+    [self assertScenario:(ORKWalkScenario){ ORKWalkPathLoop, ORKWalkInterruptionNone, 0, 0, YES, YES, NO } gapFraction:0];
+}
+
+- (void)testGapIsBridgedBySteps {
+    [self assertScenario:(ORKWalkScenario){ ORKWalkPathLine, ORKWalkInterruptionNoLocation, 120, 180, YES, YES, NO } gapFraction:60 / WalkDuration];
+}
+
+- (void)testInaccurateLocationsAreDiscarded {
+    ORKWalkScenario scenario = { ORKWalkPathLoop, ORKWalkInterruptionPoorAccuracy, 60, 120, YES, YES, NO };
+    [self assertScenario:scenario gapFraction:60 / WalkDuration];
+    
+    ORKWalkingDistanceEstimator *estimator = [ORKWalkingDistanceEstimator new];
+    [self walkScenario:scenario seed:1 estimator:estimator];
+    XCTAssertEqual(estimator.rejectedLocationCount, 60);
+    XCTAssertEqual(estimator.acceptedLocationCount, 301);
+}
+
+- (void)testStandingStillAddsNoDistance {
+    ORKWalkScenario scenario = { ORKWalkPathLoop, ORKWalkInterruptionStanding, 120, 180, YES, YES, NO };
+    [self assertScenario:scenario gapFraction:0];
+    
+    // Location noise while standing still does not accumulate.
+    ORKWalkingDistanceEstimator *estimator = [ORKWalkingDistanceEstimator new];
+    __block double distanceAtStop = 0;
+    __block double distanceAtResume = 0;
+    ORKSimulateWalk(scenario, 1, ^(CLLocation *location) {
+        [estimator appendLocation:location];
+        const NSTimeInterval second = location.timestamp.timeIntervalSince1970 - ReferenceTime;
+        if (second == 130) {
+            distanceAtStop = estimator.distance;
+        } else if (second == 180) {
+            distanceAtResume = estimator.distance;
+            XCTAssertEqual(estimator.pace, 0);
+        }
+    }, ^(NSInteger numberOfSteps, double distance, NSDate *date) {
+        [estimator appendPedometerStepCount:numberOfSteps distance:distance date:date];
+    });
+    XCTAssertEqualWithAccuracy(distanceAtResume, distanceAtStop, 1.0);
+}
+
+- (void)testPedometerOnly {
+    ORKWalkScenario scenario = { ORKWalkPathLine, ORKWalkInterruptionNone, 0, 0, YES, NO, YES };
+    [self assertScenario:scenario gapFraction:1];
+    
+    // Without locations, the pedometer's own distance estimate is used.
+    ORKWalkingDistanceEstimator *estimator = [ORKWalkingDistanceEstimator new];
+    const double distance = [self walkScenario:scenario seed:1 estimator:estimator];
+    XCTAssertEqualWithAccuracy(estimator.stepLength, StrideLength, 1e-9);
+    XCTAssertEqualWithAccuracy(estimator.distance, floor(distance / StrideLength) * StrideLength, 1e-6);
+    XCTAssertEqual(estimator.numberOfSteps, (NSInteger)floor(distance / StrideLength));
+    
+    // Without any distance estimate, a typical step length is assumed.
+    scenario.pedometerEstimatesDistance = NO;
+    [self assertScenario:scenario gapFraction:1];
+}
+
+- (void)testLocationOnlyGapIsBridgedByStraightLine {
+    ORKWalkScenario scenario = { ORKWalkPathLine, ORKWalkInterruptionNoLocation, 120, 180, NO, YES, NO };
+    for (long seed = 1; seed <= 3; seed++) {
+        ORKWalkingDistanceEstimator *estimator = [ORKWalkingDistanceEstimator new];
+        const double distance = [self walkScenario:scenario seed:seed estimator:estimator];
+        XCTAssertEqualWithAccuracy(estimator.distance, distance, 0.05 * distance, @"seed %ld", seed);
+        XCTAssertEqualWithAccuracy(estimator.locationGapFraction, 60 / WalkDuration, 0.02, @"seed %ld", seed);
+        XCTAssertEqual(estimator.numberOfSteps, 0);
+    }
+}
+
+- (void)testStepLengthIsCalibratedAgainstLocations {
+    ORKWalkingDistanceEstimator *estimator = [ORKWalkingDistanceEstimator new];
+    [self walkScenario:(ORKWalkScenario){ ORKWalkPathLine, ORKWalkInterruptionNone, 0, 0, YES, YES, NO } seed:1 estimator:estimator];
+    XCTAssertEqualWithAccuracy(estimator.stepLength, StrideLength, 0.05 * StrideLength);
+}
+
+- (void)testOutOfOrderLocationsAreDiscarded {
+    ORKWalkingDistanceEstimator *estimator = [ORKWalkingDistanceEstimator new];
+    NSDate *date = [NSDate dateWithTimeIntervalSince1970:ReferenceTime];
+    CLLocation *location = [[CLLocation alloc] initWithCoordinate:CLLocationCoordinate2DMake(37.3318, -122.0312) altitude:0 horizontalAccuracy:5 verticalAccuracy:-1 timestamp:date];
+    [estimator appendLocation:location];
+    [estimator appendLocation:location];
+    [estimator appendLocation:[[CLLocation alloc] initWithCoordinate:kCLLocationCoordinate2DInvalid altitude:0 horizontalAccuracy:-1 verticalAccuracy:-1 timestamp:[date dateByAddingTimeInterval:1]]];
+    XCTAssertEqual(estimator.acceptedLocationCount, 1);
+    XCTAssertEqual(estimator.rejectedLocationCount, 2);
+    XCTAssertEqual(estimator.distance, 0);
+    XCTAssertEqual(estimator.averagePace, 0);
+}
+
+- (void)testReset {
+    ORKWalkingDistanceEstimator *estimator = [ORKWalkingDistanceEstimator new];
+    [self walkScenario:(ORKWalkScenario){ ORKWalkPathLine, ORKWalkInterruptionNone, 0, 0, YES, YES, NO } seed:1 estimator:estimator];
+    XCTAssertGreaterThan(estimator.distance, 0);
+    
+    [estimator reset];
+    XCTAssertEqual(estimator.distance, 0);
+    XCTAssertEqual(estimator.duration, 0);
+    XCTAssertEqual(estimator.numberOfSteps, 0);
+    XCTAssertEqual(estimator.acceptedLocationCount, 0);
+    XCTAssertEqual(estimator.locationGapFraction, 0);
+    XCTAssertEqualWithAccuracy(estimator.stepLength, 0.7, 1e-9);
+}
+
+- (void)testResult {
+    ORKWalkingDistanceEstimator *estimator = [ORKWalkingDistanceEstimator new];
+    [self walkScenario:(ORKWalkScenario){ ORKWalkPathLine, ORKWalkInterruptionNoLocation, 120, 180, YES, YES, NO } seed:1 estimator:estimator];
+    
+    ORKWalkingDistanceResult *result = [estimator resultWithIdentifier:@"location.distance"];
+    XCTAssertEqualObjects(result.identifier, @"location.distance");
+    XCTAssertEqual(result.distance, estimator.distance);
+    XCTAssertEqual(result.averagePace, estimator.averagePace);
+    XCTAssertEqual(result.locationGapFraction, estimator.locationGapFraction);
+    XCTAssertEqual(result.stepLength, estimator.stepLength);
+    XCTAssertEqual(result.numberOfSteps, estimator.numberOfSteps);
+    XCTAssertEqual(result.duration, estimator.duration);
+    
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:result requiringSecureCoding:YES error:nil];
+    ORKWalkingDistanceResult *decodedResult = [NSKeyedUnarchiver unarchivedObjectOfClass:[ORKWalkingDistanceResult class] fromData:data error:nil];
+    XCTAssertEqualObjects(decodedResult, result);
+}
+
+#pragma mark - Logs
+
+#if ORK_FEATURE_CLLOCATIONMANAGER_AUTHORIZATION
+- (void)replayLogsWithCompression:(BOOL)compressesTrajectory {
+    ORKWalkingDistanceEstimator *streamingEstimator = [ORKWalkingDistanceEstimator new];
+    NSMutableArray<CLLocation *> *locations = [NSMutableArray new];
+    NSMutableArray<NSDictionary *> *pedometerItems = [NSMutableArray new];
+    ORKSimulateWalk((ORKWalkScenario){ ORKWalkPathLoop, ORKWalkInterruptionNoLocation, 120, 180, YES, YES, NO }, 1, ^(CLLocation *location) {
+        [streamingEstimator appendLocation:location];
+        [locations addObject:location];
+    }, ^(NSInteger numberOfSteps, double distance, NSDate *date) {
+        [streamingEstimator appendPedometerStepCount:numberOfSteps distance:distance date:date];
+        [pedometerItems addObject:@{ @"startDate": ORKStringFromDateISO8601([NSDate dateWithTimeIntervalSince1970:ReferenceTime]),
+                                     @"endDate": ORKStringFromDateISO8601(date),
+                                     @"numberOfSteps": @(numberOfSteps) }];
+    });
+    
+    NSMutableArray *locationItems = [NSMutableArray new];
+    if (compressesTrajectory) {
+        ORKTrajectoryEncoder *encoder = [[ORKTrajectoryEncoder alloc] initWithTolerance:0];
+        [locationItems addObjectsFromArray:[encoder recordsByEncodingLocations:locations]];
+        [locationItems addObjectsFromArray:[encoder recordsByFinishing]];
+    } else {
+        for (CLLocation *location in locations) {
+            [locationItems addObject:[location ork_JSONDictionary]];
+        }
+    }
+    
+    ORKWalkingDistanceEstimator *replayEstimator = [ORKWalkingDistanceEstimator new];
+    NSError *error = nil;
+    XCTAssertTrue([replayEstimator replayLocationLogAtURL:[self writeLogWithItems:locationItems]
+                                        pedometerLogAtURL:[self writeLogWithItems:pedometerItems]
+                                                    error:&error]);
+    XCTAssertNil(error);
+    XCTAssertEqual(replayEstimator.acceptedLocationCount, streamingEstimator.acceptedLocationCount);
+    XCTAssertEqual(replayEstimator.numberOfSteps, streamingEstimator.numberOfSteps);
+    // Compressed coordinates are rounded to about a centimeter.
+    XCTAssertEqualWithAccuracy(replayEstimator.distance, streamingEstimator.distance, 0.1);
+    XCTAssertEqualWithAccuracy(replayEstimator.locationGapFraction, streamingEstimator.locationGapFraction, 1e-9);
+}
+
+- (void)testReplayOfLocationAndPedometerLogs {
+    [self replayLogsWithCompression:NO];
+}
+
+- (void)testReplayOfCompressedLocationLog {
+    [self replayLogsWithCompression:YES];
+}
+#endif
+
+- (void)testReplayOfMalformedLog {
+    NSURL *URL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    [[@"[1, 2, 3]" dataUsingEncoding:NSUTF8StringEncoding] writeToURL:URL atomically:YES];
+    
+    ORKWalkingDistanceEstimator *estimator = [ORKWalkingDistanceEstimator new];
+    NSError *error = nil;
+    XCTAssertFalse([estimator replayLocationLogAtURL:nil pedometerLogAtURL:URL error:&error]);
+    XCTAssertEqual(error.code, NSFileReadCorruptFileError);
+    [[NSFileManager defaultManager] removeItemAtURL:URL error:nil];
+}
+
+#pragma mark - Configuration
+
+#if ORK_FEATURE_CLLOCATIONMANAGER_AUTHORIZATION
+- (void)testWalkingTasksEstimateDistance {
+    ORKOrderedTask *task = [ORKOrderedTask fitnessCheckTaskWithIdentifier:@"fitness"
+                                                   intendedUseDescription:nil
+                                                             walkDuration:360
+                                                             restDuration:0
+                                                                  options:ORKPredefinedTaskOptionNone];
+    ORKActiveStep *walkStep = (ORKActiveStep *)[task stepWithIdentifier:@"fitness.walk"];
+    XCTAssertNotNil(walkStep);
+    
+    NSUInteger locationConfigurationCount = 0;
+    for (ORKRecorderConfiguration *configuration in walkStep.recorderConfigurations) {
+        if ([configuration isKindOfClass:[ORKLocationRecorderConfiguration class]]) {
+            XCTAssertTrue(((ORKLocationRecorderConfiguration *)configuration).estimatesWalkingDistance);
+            ORKLocationRecorder *recorder = (ORKLocationRecorder *)[configuration recorderForStep:walkStep outputDirectory:nil];
+            XCTAssertNotNil(recorder.walkingDistanceEstimator);
+            locationConfigurationCount += 1;
+        }
+    }
+    XCTAssertEqual(locationConfigurationCount, 1);
+}
+#endif
+
+#pragma mark - Benchmarks
+
+- (void)testHourLongWalkThroughput {
+    // An hour of locations at 1 Hz with a pedometer update every three seconds. Each sample takes
+    // constant time, so this scales linearly with the duration of the walk.
+    NSMutableArray<CLLocation *> *locations = [NSMutableArray arrayWithCapacity:3600];
+    srand48(5);
+    const double metersPerDegree = 6371008.8 * M_PI / 180.0;
+    for (NSInteger second = 0; second < 3600; second++) {
+        CLLocationCoordinate2D coordinate = CLLocationCoordinate2DMake(37.3318 + ((3 * ORKGaussian()) / metersPerDegree),
+                                                                       -122.0312 + ((WalkingSpeed * second) / (metersPerDegree * 0.795)));
+        [locations addObject:[[CLLocation alloc] initWithCoordinate:coordinate
+                                                           altitude:0
+                                                 horizontalAccuracy:5
+                                                   verticalAccuracy:-1
+                                                          timestamp:[NSDate dateWithTimeIntervalSince1970:ReferenceTime + second]]];
+    }
+    
+    [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+        ORKWalkingDistanceEstimator *estimator = [ORKWalkingDistanceEstimator new];
+        for (NSInteger second = 0; second < 3600; second++) {
+            CLLocation *location = locations[second];
+            if (second > 0 && second % 3 == 0) {
+                [estimator appendPedometerStepCount:(NSInteger)(second * WalkingSpeed / StrideLength) distance:-1 date:location.timestamp];
+            }
+            [estimator appendLocation:location];
+            (void)estimator.distance;
+        }
+    }];
+}
+
+@end
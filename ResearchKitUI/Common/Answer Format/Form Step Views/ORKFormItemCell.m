@@ -44,6 +44,8 @@
 #import "ORKDontKnowButton.h"
 
 #import <ResearchKit/ORKAnswerFormat_Private.h>
+#import "ORKAnswerFormat_Internal.h"
+#import "ORKAnswerFormatValidator.h"
 #import "ORKFormItem_Internal.h"
 #import "ORKResult_Private.h"
 
@@ -1044,21 +1046,19 @@ NSString * const ORKClearTextViewButtonAccessibilityIdentifier = @"ORKClearTextV
 
 - (BOOL)textField:(UITextField *)textField shouldChangeCharactersInRange:(NSRange)range replacementString:(NSString *)string {
     ORKTextAnswerFormat *answerFormat = (ORKTextAnswerFormat *)[self.formItem impliedAnswerFormat];
+    BOOL isEditLengthValid = [answerFormat.validator isEditLengthValidWithString:textField.text replacingCharactersInRange:range withString:string];
     
     NSString *text = [textField.text stringByReplacingCharactersInRange:range withString:string];
     
-    // Only need to validate the text if the user enters a character other than a backspace.
+    // Only need to strip newlines if the user enters a character other than a backspace.
     // For example, if the `textField.text = researchki` and the `text = researchkit`.
     if (textField.text.length < text.length) {
-        
         text = [[text componentsSeparatedByCharactersInSet:[NSCharacterSet newlineCharacterSet]] componentsJoinedByString:@""];
-        
-        NSInteger maxLength = answerFormat.maximumLength;
-        
-        if (maxLength > 0 && text.length > maxLength) {
-            [self updateErrorLabelWithMessage:[[self.formItem impliedAnswerFormat] localizedInvalidValueStringWithAnswerString:text]];
-            return NO;
-        }
+    }
+    
+    if (!isEditLengthValid) {
+        [self updateErrorLabelWithMessage:[[self.formItem impliedAnswerFormat] localizedInvalidValueStringWithAnswerString:text]];
+        return NO;
     }
     
     [self ork_setAnswer:text.length ? text : ORKNullAnswerValue()];
@@ -1193,6 +1193,7 @@ NSString * const ORKClearTextViewButtonAccessibilityIdentifier = @"ORKClearTextV
     ORKDontKnowButton *_dontKnowButton;
     CGFloat _lastSeenLineCount;
     NSInteger _maxLength;
+    ORKTextAnswerFormatValidator *_textValidator;
     NSString *_defaultTextAnswer;
     BOOL _shouldShowDontKnow;
 }
@@ -1477,6 +1478,7 @@ NSString * const ORKClearTextViewButtonAccessibilityIdentifier = @"ORKClearTextV
         ORKTextAnswerFormat *textAnswerFormat = (ORKTextAnswerFormat *)answerFormat;
         _defaultTextAnswer = textAnswerFormat.defaultTextAnswer;
         _maxLength = [textAnswerFormat maximumLength];
+        _textValidator = textAnswerFormat.validator;
         _textView.autocorrectionType = textAnswerFormat.autocorrectionType;
         _textView.autocapitalizationType = textAnswerFormat.autocapitalizationType;
         _textView.spellCheckingType = textAnswerFormat.spellCheckingType;
@@ -1489,6 +1491,7 @@ NSString * const ORKClearTextViewButtonAccessibilityIdentifier = @"ORKClearTextV
         }
     } else {
         _maxLength = 0;
+        _textValidator = nil;
     }
 }
 
@@ -1606,18 +1609,12 @@ NSString * const ORKClearTextViewButtonAccessibilityIdentifier = @"ORKClearTextV
 }
 
 - (BOOL)textView:(UITextView *)textView shouldChangeTextInRange:(NSRange)range replacementText:(NSString *)text {
-    NSString *string = [textView.text stringByReplacingCharactersInRange:range withString:text];
-    
-    // Only need to validate the text if the user enters a character other than a backspace.
-    // For example, if the `textView.text = researchki` and the `string = researchkit`.
-    if (textView.text.length < string.length) {
-        
+    // The edited text is only built when the edit makes it too long.
+    if (_textValidator && ![_textValidator isEditLengthValidWithString:textView.text replacingCharactersInRange:range withString:text]) {
+        NSString *string = [textView.text stringByReplacingCharactersInRange:range withString:text];
         string = [[string componentsSeparatedByCharactersInSet:[NSCharacterSet newlineCharacterSet]] componentsJoinedByString:@""];
-        
-        if (_maxLength > 0 && string.length > _maxLength) {
-            [self showValidityAlertWithMessage:[[self.formItem impliedAnswerFormat] localizedInvalidValueStringWithAnswerString:string]];
-            return NO;
-        }
+        [self showValidityAlertWithMessage:[[self.formItem impliedAnswerFormat] localizedInvalidValueStringWithAnswerString:string]];
+        return NO;
     }
     
     return YES;
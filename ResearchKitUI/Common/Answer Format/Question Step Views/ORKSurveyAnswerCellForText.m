@@ -36,6 +36,7 @@
 #import "ORKDontKnowButton.h"
 
 #import "ORKAnswerFormat_Internal.h"
+#import "ORKAnswerFormatValidator.h"
 #import "ORKQuestionStep_Internal.h"
 
 #import "ORKHelpers_Internal.h"
@@ -63,6 +64,7 @@ static const CGFloat DividerViewTopPadding = 10.0;
 
 @implementation ORKSurveyAnswerCellForText {
     NSInteger _maxLength;
+    ORKTextAnswerFormatValidator *_textValidator;
     NSString *_defaultTextAnswer;
     UILabel *_textCountLabel;
     UIButton *_clearTextViewButton;
@@ -82,6 +84,7 @@ static const CGFloat DividerViewTopPadding = 10.0;
     if ([answerFormat isKindOfClass:[ORKTextAnswerFormat class]]) {
         ORKTextAnswerFormat *textAnswerFormat = (ORKTextAnswerFormat *)answerFormat;
         _maxLength = [textAnswerFormat maximumLength];
+        _textValidator = textAnswerFormat.validator;
         _hideClearButton = [textAnswerFormat hideClearButton];
         _hideCharacterCountLabel = [textAnswerFormat hideCharacterCountLabel];
         _defaultTextAnswer = textAnswerFormat.defaultTextAnswer;
@@ -97,6 +100,7 @@ static const CGFloat DividerViewTopPadding = 10.0;
         }
     } else {
         _maxLength = 0;
+        _textValidator = nil;
     }
 }
 
@@ -501,26 +505,24 @@ static const CGFloat DividerViewTopPadding = 10.0;
 
 - (BOOL)textView:(UITextView *)textView shouldChangeTextInRange:(NSRange)range replacementText:(NSString *)text {
     
-    NSString *string = [textView.text stringByReplacingCharactersInRange:range withString:text];
-    
-    // Only need to validate the text if the user enters a character other than a backspace.
-    // For example, if the `textView.text = researchki` and the `string = researchkit`.
-    if (textView.text.length < string.length) {
-        
-        string = [[string componentsSeparatedByCharactersInSet:[NSCharacterSet newlineCharacterSet]] componentsJoinedByString:@""];
+    // The edited text is only built when the edit makes it too long.
+    if (_textValidator && ![_textValidator isEditLengthValidWithString:textView.text replacingCharactersInRange:range withString:text]) {
         
-        if (_maxLength > 0 && string.length > _maxLength) {
-            
-            if (_textCountLabel.isHidden) {
-                [self updateErrorLabelWithMessage:ORKLocalizedString(@"MAX_WORD_COUNT_ERROR", @"")];
-            } else {
-                [self showValidityAlertWithMessage:[[self.step impliedAnswerFormat] localizedInvalidValueStringWithAnswerString:string]];
-            }
-           
-            return NO;
-        } else if (_errorLabel.attributedText) {
-            [self removeErrorMessage];
+        if (_textCountLabel.isHidden) {
+            [self updateErrorLabelWithMessage:ORKLocalizedString(@"MAX_WORD_COUNT_ERROR", @"")];
+        } else {
+            NSString *string = [textView.text stringByReplacingCharactersInRange:range withString:text];
+            string = [[string componentsSeparatedByCharactersInSet:[NSCharacterSet newlineCharacterSet]] componentsJoinedByString:@""];
+            [self showValidityAlertWithMessage:[[self.step impliedAnswerFormat] localizedInvalidValueStringWithAnswerString:string]];
         }
+        
+        return NO;
+    }
+    
+    // Only a character other than a backspace clears the error.
+    // For example, if the `textView.text = researchki` and the edited text is `researchkit`.
+    if (text.length > range.length && _errorLabel.attributedText) {
+        [self removeErrorMessage];
     }
     
     return YES;
@@ -857,20 +859,13 @@ static const CGFloat DividerViewTopPadding = 10.0;
     ORKAnswerFormat *impliedFormat = [self.step impliedAnswerFormat];
     NSAssert([impliedFormat isKindOfClass:[ORKTextAnswerFormat class]], @"answerFormat should be ORKTextAnswerFormat type instance.");
     
-    NSString *text = [textField.text stringByReplacingCharactersInRange:range withString:string];
-    
-    // Only need to validate the text if the user enters a character other than a backspace.
-    // For example, if the `textField.text = researchki` and the `text = researchkit`.
-    if (textField.text.length < text.length) {
-        
+    // The edited text is only built when the edit makes it too long.
+    ORKTextAnswerFormatValidator *validator = [(ORKTextAnswerFormat *)impliedFormat validator];
+    if (![validator isEditLengthValidWithString:textField.text replacingCharactersInRange:range withString:string]) {
+        NSString *text = [textField.text stringByReplacingCharactersInRange:range withString:string];
         text = [[text componentsSeparatedByCharactersInSet:[NSCharacterSet newlineCharacterSet]] componentsJoinedByString:@""];
-        
-        NSInteger maxLength = [(ORKTextAnswerFormat *)impliedFormat maximumLength];
-        
-        if (maxLength > 0 && text.length > maxLength) {
-            [self updateErrorLabelWithMessage:[[self.step impliedAnswerFormat] localizedInvalidValueStringWithAnswerString:text]];
-            return NO;
-        }
+        [self updateErrorLabelWithMessage:[[self.step impliedAnswerFormat] localizedInvalidValueStringWithAnswerString:text]];
+        return NO;
     }
     
     [self checkTextAndSetAnswer];
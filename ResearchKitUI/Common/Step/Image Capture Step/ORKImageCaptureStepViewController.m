@@ -42,6 +42,7 @@
 #import "ORKStep.h"
 
 #import "ORKHelpers_Internal.h"
+#import "ORKMediaArtifactStore.h"
 
 @import AVFoundation;
 
@@ -363,9 +364,8 @@
 }
 
 - (NSURL *)writeCapturedDataWithError:(NSError **)errorOut {
-    NSURL *URL = [[self.outputDirectory URLByAppendingPathComponent:self.step.identifier] URLByAppendingPathExtension: _imageDataExtension];
     // Confirm the outputDirectory was set properly
-    if (!URL) {
+    if (!self.outputDirectory) {
         if (errorOut != NULL) {
             *errorOut = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileWriteInvalidFileNameError userInfo:@{NSLocalizedDescriptionKey:ORKLocalizedString(@"CAPTURE_ERROR_NO_OUTPUT_DIRECTORY", nil)}];
         }
@@ -373,8 +373,12 @@
     }
     
     // If set properly, the outputDirectory is already created, so write the file into it
+    ORKMediaArtifactStore *store = [[ORKMediaArtifactStore alloc] initWithDirectoryURL:self.outputDirectory
+                                                                   fileProtectionMode:ORKFileProtectionCompleteUnlessOpen];
+    NSString *fileName = [self.step.identifier stringByAppendingPathExtension:_imageDataExtension];
     NSError *writeError = nil;
-    if (![_capturedImageData writeToURL:URL options:NSDataWritingAtomic|NSDataWritingFileProtectionCompleteUnlessOpen error:&writeError]) {
+    ORKMediaArtifact *artifact = [store writeData:_capturedImageData fileName:fileName error:&writeError];
+    if (!artifact) {
         if (writeError) {
             ORK_Log_Error("%@", writeError);
         }
@@ -384,7 +388,7 @@
         return nil;
     }
     
-    return URL;
+    return artifact.fileURL;
 }
 
 - (ORKStepResult *)result {
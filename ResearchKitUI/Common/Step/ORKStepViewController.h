@@ -31,6 +31,7 @@
 
 #import <UIKit/UIKit.h>
 #import <ResearchKit/ORKDefines.h>
+#import <ResearchKit/ORKRandomNumberGenerator.h>
 #import <ResearchKit/ORKTask.h>
 #import <ResearchKitUI/ORKBorderedButton.h>
 
@@ -386,6 +387,16 @@ ORK_CLASS_AVAILABLE
  */
 - (void)addResult:(ORKResult*)result;
 
+/**
+ The random number generator from which the step draws its stimuli.
+ 
+ A generator with a random seed is created the first time this property is read. To replay a
+ session, set a generator created with the seed from the step's `ORKRandomSeedResult` before the
+ step is presented. Once the generator exists, the step result includes an `ORKRandomSeedResult`
+ recording its seed.
+ */
+@property (nonatomic, strong, null_resettable) ORKRandomNumberGenerator *randomNumberGenerator;
+
 /**
  Returns a Boolean value indicating whether there is a previous step.
  
@@ -35,6 +35,7 @@
 #import "ORKTaskViewController_Internal.h"
 
 #import "ORKCollectionResult.h"
+#import "ORKRandomSeedResult.h"
 #import "ORKReviewStep_Internal.h"
 
 #import "ORKNavigationContainerView.h"
@@ -48,6 +49,8 @@
 static const CGFloat iPadStepTitleLabelPadding = 15.0;
 static const CGFloat iPadStepTitleLabelFontSize = 50.0;
 
+static NSString *const ORKRandomSeedResultIdentifier = @"randomSeed";
+
 @interface ORKStepViewController () {
     BOOL _hasBeenPresented;
     BOOL _dismissing;
@@ -430,13 +433,26 @@ static const CGFloat iPadStepTitleLabelFontSize = 50.0;
 
 - (ORKStepResult *)result {
     
-    ORKStepResult *stepResult = [[ORKStepResult alloc] initWithStepIdentifier:self.step.identifier results:_addedResults ? : @[]];
+    NSArray<ORKResult *> *results = _addedResults ? : @[];
+    if (_randomNumberGenerator) {
+        ORKRandomSeedResult *seedResult = [[ORKRandomSeedResult alloc] initWithIdentifier:ORKRandomSeedResultIdentifier];
+        seedResult.seed = _randomNumberGenerator.seed;
+        results = [results arrayByAddingObject:seedResult];
+    }
+    ORKStepResult *stepResult = [[ORKStepResult alloc] initWithStepIdentifier:self.step.identifier results:results];
     stepResult.startDate = self.presentedDate ? : [NSDate date];
     stepResult.endDate = self.dismissedDate ? : [NSDate date];
     
     return stepResult;
 }
 
+- (ORKRandomNumberGenerator *)randomNumberGenerator {
+    if (_randomNumberGenerator == nil) {
+        _randomNumberGenerator = [ORKRandomNumberGenerator new];
+    }
+    return _randomNumberGenerator;
+}
+
 - (void)addResult:(ORKResult *)result {
     ORKResult *copy = [result copy];
     if (_addedResults == nil) {
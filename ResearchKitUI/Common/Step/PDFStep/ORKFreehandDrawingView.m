@@ -31,6 +31,7 @@
 
 #import "ORKHelpers_Internal.h"
 #import "ORKFreehandDrawingView.h"
+#import "ORKStrokeRasterizer.h"
 #import <UIKit/UIGestureRecognizerSubclass.h>
 
 
@@ -95,9 +96,6 @@ static const CGFloat MaxPressureForStrokeVelocity = 9;
 static const CGFloat LineWidthStepValue = 0.25f;
 
 @interface ORKFreehandDrawingView () <ORKFreehandDrawingGestureRecognizerDelegate> {
-    CGPoint currentPoint;
-    CGPoint previousPoint1;
-    CGPoint previousPoint2;
     // Pressure scale based on if using force or speed of stroke.
     CGFloat minPressure;
     CGFloat maxPressure;
@@ -108,7 +106,7 @@ static const CGFloat LineWidthStepValue = 0.25f;
     BOOL _touchedOutside;
 }
 
-@property (nonatomic, strong) UIBezierPath *currentPath;
+@property (nonatomic, strong) ORKStrokeRasterizer *rasterizer;
 @property (nonatomic, strong) PDFKitPlatformBezierPath *pdfCurrentPath;
 
 @property (nonatomic, strong) NSMutableArray *pathArray;
@@ -129,6 +127,7 @@ static const CGFloat LineWidthStepValue = 0.25f;
     if (self) {
         _lineWidth = DefaultLineWidth;
         _lineWidthVariation = DefaultLineWidthVariation;
+        _rasterizer = [[ORKStrokeRasterizer alloc] initWithScale:self.contentScaleFactor];
         [self makeFreehandDrawingGestureRecognizer];
     }
     return self;
@@ -142,6 +141,11 @@ static const CGFloat LineWidthStepValue = 0.25f;
     return self;
 }
 
+- (void)didMoveToWindow {
+    [super didMoveToWindow];
+    _rasterizer.scale = self.contentScaleFactor;
+}
+
 - (UIBezierPath *)pathWithRoundedStyle {
     UIBezierPath *path = [UIBezierPath bezierPath];
     path.lineCapStyle = kCGLineCapRound;
@@ -217,15 +221,12 @@ static const CGFloat LineWidthStepValue = 0.25f;
         CGRect pageBounds = [_pdfView.currentPage boundsForBox:[_pdfView displayBox]];
         if ( CGRectContainsPoint(pageBounds, pdfPoint) ) {
             _touchedOutside = NO;
-            self.currentPath = [self pathWithRoundedStyle];
             self.pdfCurrentPath = [self pathWithRoundedStyle];
             
-            // Trigger full redraw - whether there's a path has changed
-            [self setNeedsDisplay];
-            
-            previousPoint1 = [touch previousLocationInView:self];
-            previousPoint2 = [touch previousLocationInView:self];
-            currentPoint = point;
+            CGRect drawBox = [self.rasterizer beginStrokeAtPoint:point
+                                                   previousPoint:[touch previousLocationInView:self]
+                                                       lineWidth:self.lineWidth];
+            [self setNeedsDisplayInRect:drawBox];
             
             if ([self isForceTouchAvailable] || [self isTouchTypeStylus:touch]) {
                 // This is a scale based on true force on the screen.
@@ -240,12 +241,8 @@ static const CGFloat LineWidthStepValue = 0.25f;
                 previousTouchTime = touch.timestamp;
             }
             
-            [self.currentPath moveToPoint:currentPoint];
-            
-            [self.pdfCurrentPath moveToPoint:[_pdfView convertPoint:currentPoint toPage:_pdfView.currentPage]];
-            
-            [self.currentPath addArcWithCenter:currentPoint radius:0.1 startAngle:0.0 endAngle:2.0 * M_PI clockwise:YES];
-            [self.pdfCurrentPath addArcWithCenter:[_pdfView convertPoint:currentPoint toPage:_pdfView.currentPage] radius:0.1 startAngle:0.0 endAngle:2.0 * M_PI clockwise:YES];
+            [self.pdfCurrentPath moveToPoint:pdfPoint];
+            [self.pdfCurrentPath addArcWithCenter:pdfPoint radius:0.1 startAngle:0.0 endAngle:2.0 * M_PI clockwise:YES];
             
             [self gestureTouchesMoved:touches withEvent:event];
         }
@@ -254,14 +251,10 @@ static const CGFloat LineWidthStepValue = 0.25f;
         }
     }
     else {
-        self.currentPath = [self pathWithRoundedStyle];
-        
-        // Trigger full redraw - whether there's a path has changed
-        [self setNeedsDisplay];
-        
-        previousPoint1 = [touch previousLocationInView:self];
-        previousPoint2 = [touch previousLocationInView:self];
-        currentPoint = point;
+        CGRect drawBox = [self.rasterizer beginStrokeAtPoint:point
+                                               previousPoint:[touch previousLocationInView:self]
+                                                   lineWidth:self.lineWidth];
+        [self setNeedsDisplayInRect:drawBox];
         
         if ([self isForceTouchAvailable] || [self isTouchTypeStylus:touch]) {
             // This is a scale based on true force on the screen.
@@ -276,8 +269,6 @@ static const CGFloat LineWidthStepValue = 0.25f;
             previousTouchTime = touch.timestamp;
         }
         
-        [self.currentPath moveToPoint:currentPoint];
-        [self.currentPath addArcWithCenter:currentPoint radius:0.1 startAngle:0.0 endAngle:2.0 * M_PI clockwise:YES];
         [self gestureTouchesMoved:touches withEvent:event];
     }
 }
@@ -289,7 +280,7 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
 - (void)gestureTouchesMoved:(NSSet *)touches withEvent:(UIEvent *)event {
     UITouch *touch = [touches anyObject];
     CGPoint point = [touch locationInView:self];
-    CGFloat previousLineWidth = self.currentPath.lineWidth;
+    CGFloat previousLineWidth = self.rasterizer.strokeLineWidth;
 
     if (_pdfView) {
         CGPoint pdfPoint = [_pdfView convertPoint:point toPage:_pdfView.currentPage];
@@ -317,21 +308,20 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
                 }
                 
                 [self commitCurrentPath];
+                [self.rasterizer restartStrokePathWithLineWidth:lineWidth];
                 
-                self.currentPath = [self pathWithRoundedStyle];
                 self.pdfCurrentPath = [self pathWithRoundedStyle];
-                self.currentPath.lineWidth = lineWidth;
                 self.pdfCurrentPath.lineWidth = lineWidth;
                 
-                CGPoint previousMid2 = mmid_Point(currentPoint, previousPoint1);
-                [self.currentPath moveToPoint:previousMid2];
-                
+                CGPoint previousMid2 = mmid_Point(self.rasterizer.currentPoint, self.rasterizer.previousPoint);
                 [self.pdfCurrentPath moveToPoint:[_pdfView convertPoint:previousMid2 toPage:_pdfView.currentPage]];
             }
             
-            CGPoint mid2 = [self getMid2FromDrawBoxWithTouch:touch];
+            CGRect drawBox = [self.rasterizer extendStrokeToPoint:point previousPoint:[touch previousLocationInView:self]];
+            [self setNeedsDisplayInRect:drawBox];
             
-            [self.pdfCurrentPath addQuadCurveToPoint:[_pdfView convertPoint:mid2 toPage:_pdfView.currentPage] controlPoint:[_pdfView convertPoint:previousPoint1 toPage:_pdfView.currentPage]];
+            CGPoint mid2 = mmid_Point(self.rasterizer.currentPoint, self.rasterizer.previousPoint);
+            [self.pdfCurrentPath addQuadCurveToPoint:[_pdfView convertPoint:mid2 toPage:_pdfView.currentPage] controlPoint:[_pdfView convertPoint:self.rasterizer.previousPoint toPage:_pdfView.currentPage]];
         }
         else {
             _touchedOutside = YES;
@@ -340,6 +330,9 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
     else {
 
         CGFloat proposedLineWidth = [self getProposedLineWidthWithTouch:touch WithEvent:event];
+        if (proposedLineWidth == CGFLOAT_MIN) {
+            return;
+        }
         
         // Only step the line width up and down by a set value.
         // This prevents the line looking jagged, and adding excessive
@@ -356,14 +349,11 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
             }
             
             [self commitCurrentPath];
-            
-            self.currentPath = [self pathWithRoundedStyle];
-            self.currentPath.lineWidth = lineWidth;
-            
-            CGPoint previousMid2 = mmid_Point(currentPoint, previousPoint1);
-            [self.currentPath moveToPoint:previousMid2];
+            [self.rasterizer restartStrokePathWithLineWidth:lineWidth];
         }
-        CGPoint _ __attribute__((unused)) = [self getMid2FromDrawBoxWithTouch:touch];
+        
+        CGRect drawBox = [self.rasterizer extendStrokeToPoint:point previousPoint:[touch previousLocationInView:self]];
+        [self setNeedsDisplayInRect:drawBox];
     }
 }
 
@@ -371,6 +361,7 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
     
     CGPoint point = [touch locationInView:self];
     //check if the point is farther than min dist from previous
+    CGPoint currentPoint = self.rasterizer.currentPoint;
     CGFloat dx = point.x - currentPoint.x;
     CGFloat dy = point.y - currentPoint.y;
     
@@ -403,43 +394,24 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
     return ((pressure - minPressure) * self.lineWidthVariation / (maxPressure - minPressure)) + self.lineWidth;
 }
 
-- (CGPoint)getMid2FromDrawBoxWithTouch:(UITouch *)touch {
-    previousPoint2 = previousPoint1;
-    previousPoint1 = [touch previousLocationInView:self];
-    currentPoint = [touch locationInView:self];
-    
-    CGPoint mid1 = mmid_Point(previousPoint1, previousPoint2);
-    CGPoint mid2 = mmid_Point(currentPoint, previousPoint1);
-    
-    UIBezierPath *subPath = [UIBezierPath bezierPath];
-    [subPath moveToPoint:mid1];
-    [subPath addQuadCurveToPoint:mid2 controlPoint:previousPoint1];
-    CGRect bounds = CGPathGetBoundingBox(subPath.CGPath);
-
-    [self.currentPath addQuadCurveToPoint:mid2 controlPoint:previousPoint1];
-    
-    
-    CGRect drawBox = bounds;
-    drawBox.origin.x -= self.currentPath.lineWidth * 2.0;
-    drawBox.origin.y -= self.currentPath.lineWidth * 2.0;
-    drawBox.size.width += self.currentPath.lineWidth * 4.0;
-    drawBox.size.height += self.currentPath.lineWidth * 4.0;
-    
-    [self setNeedsDisplayInRect:drawBox];
-    return mid2;
-}
-
 - (void)gestureTouchesEnded:(NSSet *)touches withEvent:(UIEvent *)event {
     [self commitCurrentPath];
 }
 
 - (void)commitCurrentPath {
-    CGRect rect = self.currentPath.bounds;
-    if (CGSizeEqualToSize(rect.size, CGSizeZero)) {
+    CGPathRef strokePath = self.rasterizer.strokePath;
+    if (strokePath == NULL) {
+        return;
+    }
+    
+    UIBezierPath *path = [self pathWithRoundedStyle];
+    path.CGPath = strokePath;
+    path.lineWidth = self.rasterizer.strokeLineWidth;
+    if (![self.rasterizer commitStrokePath]) {
         return;
     }
     
-    [self.pathArray addObject:self.currentPath];
+    [self.pathArray addObject:path];
     if (_pdfView) {
         [self.pdfPathArray addObject:self.pdfCurrentPath];
     }
@@ -451,15 +423,10 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
         _backgroundColor = [UIColor whiteColor];
     }
     [_backgroundColor setFill];
-    CGContextFillRect(UIGraphicsGetCurrentContext(), rect);
+    CGContextRef context = UIGraphicsGetCurrentContext();
+    CGContextFillRect(context, rect);
     
-    for (UIBezierPath *path in self.pathArray) {
-        [self.lineColor setStroke];
-        [path stroke];
-    }
-    
-    [self.lineColor setStroke];
-    [self.currentPath stroke];
+    [self.rasterizer drawInContext:context rect:rect color:self.lineColor.CGColor];
 }
 
 - (NSArray <UIBezierPath *> *)freehandDrawingPath {
@@ -489,10 +456,7 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
 
 - (void)clear {
     if (self.pathArray.count > 0) {
-        if (self.currentPath != nil) {
-            self.currentPath = [self pathWithRoundedStyle];
-        }
-        
+        [self.rasterizer removeAllStrokes];
         [self.pathArray removeAllObjects];
         [self setNeedsDisplayInRect:self.bounds];
     }
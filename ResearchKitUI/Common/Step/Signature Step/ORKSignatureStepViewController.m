@@ -210,6 +210,7 @@
 @property (nonatomic, strong, readonly, nullable) ORKSignatureView *signatureView;
 @property (nonatomic, strong) ORKConsentSigningView *signingView;
 @property (nonatomic, strong) NSArray <UIBezierPath *> *originalPath;
+@property (nonatomic, strong) NSArray<NSData *> *originalStrokeSamples;
 
 @end
 
@@ -225,6 +226,7 @@
             [[(ORKStepResult *)result results] enumerateObjectsUsingBlock:^(ORKResult * _Nonnull obj, NSUInteger idx, BOOL * _Nonnull stop) {
                 if ([obj isKindOfClass:[ORKSignatureResult class]]) {
                     _originalPath = [(ORKSignatureResult*)obj signaturePath];
+                    _originalStrokeSamples = [(ORKSignatureResult*)obj strokeSamples];
                     *stop = YES;
                 }
             }];
@@ -239,6 +241,9 @@
 
     // set the original path and update state
     self.signatureView.signaturePath = self.originalPath;
+    if (self.originalPath) {
+        self.signatureView.strokeSamples = self.originalStrokeSamples;
+    }
     [self updateButtonStates];
 }
 
@@ -248,7 +253,8 @@
     if (self.signatureView.signatureExists) {
         ORKSignatureResult *sigResult = [[ORKSignatureResult alloc] initWithIdentifier:self.step.identifier
                                                                         signatureImage:self.signatureView.signatureImage
-                                                                         signaturePath:self.signatureView.signaturePath];
+                                                                         signaturePath:self.signatureView.signaturePath
+                                                                         strokeSamples:self.signatureView.strokeSamples];
         parentResult.results = @[sigResult];
     }
     
@@ -79,6 +79,12 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong, nullable) UIGestureRecognizer *signatureGestureRecognizer;
 @property (nonatomic, copy, nullable) NSArray <UIBezierPath *> *signaturePath;
 
+/**
+ The touch samples of each stroke, as `NSData` objects holding consecutive `ORKStrokeSample`
+ values. Setting `signaturePath` does not change them.
+ */
+@property (nonatomic, copy, null_resettable) NSArray<NSData *> *strokeSamples;
+
 - (UIImage *)signatureImage;
 
 @property (nonatomic, readonly) BOOL signatureExists;
@@ -33,9 +33,11 @@
 #import "ORKSignatureView.h"
 
 #import "ORKSelectionTitleLabel.h"
+#import "ORKStrokeRasterizer.h"
 
 #import "ORKHelpers_Internal.h"
 #import "ORKSkin.h"
+#import "ORKStrokeCodec.h"
 
 #import <UIKit/UIGestureRecognizerSubclass.h>
 
@@ -125,9 +127,6 @@ static const CGFloat MaxPressureForStrokeVelocity = 9;
 static const CGFloat LineWidthStepValue = 0.25f;
 
 @interface ORKSignatureView () <ORKSignatureGestureRecognizerDelegate> {
-    CGPoint currentPoint;
-    CGPoint previousPoint1;
-    CGPoint previousPoint2;
     // Pressure scale based on if using force or speed of stroke.
     CGFloat minPressure;
     CGFloat maxPressure;
@@ -135,8 +134,9 @@ static const CGFloat LineWidthStepValue = 0.25f;
     NSTimeInterval previousTouchTime;
 }
 
-@property (nonatomic, strong) UIBezierPath *currentPath;
+@property (nonatomic, strong) ORKStrokeRasterizer *rasterizer;
 @property (nonatomic, strong) NSMutableArray *pathArray;
+@property (nonatomic, strong) NSMutableArray<NSMutableData *> *sampleArray;
 @property (nonatomic, strong) NSArray *backgroundLines;
 @property (nonatomic) BOOL setWidth;
 
@@ -178,6 +178,7 @@ static const CGFloat LineWidthStepValue = 0.25f;
 - (void)commonInit {
     _lineWidth = DefaultLineWidth;
     _lineWidthVariation = DefaultLineWidthVariation;
+    _rasterizer = [[ORKStrokeRasterizer alloc] initWithScale:self.contentScaleFactor];
     
     self.layer.borderColor = [[UIColor separatorColor] CGColor];
     self.layer.borderWidth = 1.0;
@@ -193,6 +194,11 @@ static const CGFloat LineWidthStepValue = 0.25f;
     [self updateConstraintConstantsForWindow:newWindow];
 }
 
+- (void)didMoveToWindow {
+    [super didMoveToWindow];
+    _rasterizer.scale = self.contentScaleFactor;
+}
+
 - (void)updateConstraintConstantsForWindow:(UIWindow *)window {
     _heightConstraint.constant = ORKGetMetricForWindow(ORKScreenMetricSignatureViewHeight, window);
     
@@ -274,6 +280,13 @@ static const CGFloat LineWidthStepValue = 0.25f;
     return _pathArray;
 }
 
+- (NSMutableArray<NSMutableData *> *)sampleArray {
+    if (_sampleArray == nil) {
+        _sampleArray = [NSMutableArray new];
+    }
+    return _sampleArray;
+}
+
 - (CGFloat)placeholderPoint {
     CGFloat height = self.bounds.size.height;
     CGFloat y1 = height * TopToSigningLineRatio;
@@ -334,14 +347,12 @@ static const CGFloat LineWidthStepValue = 0.25f;
 - (void)gestureTouchesBegan:(NSSet *)touches withEvent:(UIEvent *)event {
     UITouch *touch = [touches anyObject];
     
-    self.currentPath = [self pathWithRoundedStyle];
+    [self.sampleArray addObject:[NSMutableData data]];
     
-    // Trigger full redraw - whether there's a path has changed
-    [self setNeedsDisplay];
-    
-    previousPoint1 = [touch previousLocationInView:self];
-    previousPoint2 = [touch previousLocationInView:self];
-    currentPoint = [touch locationInView:self];
+    CGRect drawBox = [self.rasterizer beginStrokeAtPoint:[touch locationInView:self]
+                                           previousPoint:[touch previousLocationInView:self]
+                                               lineWidth:self.lineWidth];
+    [self setNeedsDisplayInRect:drawBox];
     
     if ([self isForceTouchAvailable] || [self isTouchTypeStylus:touch]) {
         // This is a scale based on true force on the screen.
@@ -356,21 +367,18 @@ static const CGFloat LineWidthStepValue = 0.25f;
         previousTouchTime = touch.timestamp;
     }
     
-    [self.currentPath moveToPoint:currentPoint];
-    [self.currentPath addArcWithCenter:currentPoint radius:0.1 startAngle:0.0 endAngle:2.0 * M_PI clockwise:YES];
     [self gestureTouchesMoved:touches withEvent:event];
 }
 
-static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
-    return CGPointMake((p1.x + p2.x) * 0.5, (p1.y + p2.y) * 0.5);
-}
-
 - (void)gestureTouchesMoved:(NSSet *)touches withEvent:(UIEvent *)event {
     UITouch *touch = [touches anyObject];
     
+    [self recordSamplesOfTouch:touch withEvent:event];
+    
     CGPoint point = [touch locationInView:self];
     
     //check if the point is farther than min dist from previous
+    CGPoint currentPoint = self.rasterizer.currentPoint;
     CGFloat dx = point.x - currentPoint.x;
     CGFloat dy = point.y - currentPoint.y;
     
@@ -401,7 +409,7 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
     pressure = MAX(minPressure, pressure);
     pressure = MIN(maxPressure, pressure);
     
-    CGFloat previousLineWidth = self.currentPath.lineWidth;
+    CGFloat previousLineWidth = self.rasterizer.strokeLineWidth;
     CGFloat proposedLineWidth = ((pressure - minPressure) *
                                  self.lineWidthVariation /
                                  (maxPressure - minPressure))
@@ -422,41 +430,44 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
         }
         
         [self commitCurrentPath];
-        
-        self.currentPath = [self pathWithRoundedStyle];
-        self.currentPath.lineWidth = lineWidth;
-        
-        CGPoint previousMid2 = mmid_Point(currentPoint, previousPoint1);
-        [self.currentPath moveToPoint:previousMid2];
+        [self.rasterizer restartStrokePathWithLineWidth:lineWidth];
     }
     
-    previousPoint2 = previousPoint1;
-    previousPoint1 = [touch previousLocationInView:self];
-    currentPoint = [touch locationInView:self];
-    
-    CGPoint mid1 = mmid_Point(previousPoint1, previousPoint2);
-    CGPoint mid2 = mmid_Point(currentPoint, previousPoint1);
-    
-    UIBezierPath *subPath = [UIBezierPath bezierPath];
-    [subPath moveToPoint:mid1];
-    [subPath addQuadCurveToPoint:mid2 controlPoint:previousPoint1];
-    CGRect bounds = CGPathGetBoundingBox(subPath.CGPath);
-    
-    [self.currentPath addQuadCurveToPoint:mid2 controlPoint:previousPoint1];
-    
-    CGRect drawBox = bounds;
-    drawBox.origin.x -= self.currentPath.lineWidth * 2.0;
-    drawBox.origin.y -= self.currentPath.lineWidth * 2.0;
-    drawBox.size.width += self.currentPath.lineWidth * 4.0;
-    drawBox.size.height += self.currentPath.lineWidth * 4.0;
-    
+    CGRect drawBox = [self.rasterizer extendStrokeToPoint:point previousPoint:[touch previousLocationInView:self]];
     [self setNeedsDisplayInRect:drawBox];
 }
 
 - (void)gestureTouchesEnded:(NSSet *)touches withEvent:(UIEvent *)event {
+    [self recordSamplesOfTouch:[touches anyObject] withEvent:event];
     [self commitCurrentPath];
 }
 
+- (void)recordSamplesOfTouch:(UITouch *)touch withEvent:(UIEvent *)event {
+    NSMutableData *stroke = self.sampleArray.lastObject;
+    if (touch == nil || stroke == nil) {
+        return;
+    }
+    
+    // Every location the digitizer reported is kept, including those coalesced into this event
+    // and those too close together to extend the path.
+    NSArray<UITouch *> *coalescedTouches = [event coalescedTouchesForTouch:touch] ? : @[touch];
+    NSTimeInterval lastTimestamp = -DBL_MAX;
+    if (stroke.length >= sizeof(ORKStrokeSample)) {
+        lastTimestamp = ((const ORKStrokeSample *)stroke.bytes)[stroke.length / sizeof(ORKStrokeSample) - 1].timestamp;
+    }
+    for (UITouch *coalescedTouch in coalescedTouches) {
+        if (coalescedTouch.timestamp <= lastTimestamp) {
+            continue;
+        }
+        ORKStrokeSample sample = {
+            .location = [coalescedTouch locationInView:self],
+            .timestamp = coalescedTouch.timestamp
+        };
+        [stroke appendBytes:&sample length:sizeof(sample)];
+        lastTimestamp = sample.timestamp;
+    }
+}
+
 - (void)gestureTouchesHaveEndedWithTimeInterval {
     if (self.delegate && [self.delegate respondsToSelector:@selector(signatureViewDidEndEditingWithTimeInterval)]) {
         [self.delegate signatureViewDidEndEditingWithTimeInterval];
@@ -464,12 +475,19 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
 }
 
 - (void)commitCurrentPath {
-    CGRect rect = self.currentPath.bounds;
-    if (CGSizeEqualToSize(rect.size, CGSizeZero)) {
+    CGPathRef strokePath = self.rasterizer.strokePath;
+    if (strokePath == NULL) {
         return;
     }
     
-    [self.pathArray addObject:self.currentPath];
+    UIBezierPath *path = [self pathWithRoundedStyle];
+    path.CGPath = strokePath;
+    path.lineWidth = self.rasterizer.strokeLineWidth;
+    if (![self.rasterizer commitStrokePath]) {
+        return;
+    }
+    
+    [self.pathArray addObject:path];
     
     [self.delegate signatureViewDidEditImage:self];
 }
@@ -479,15 +497,11 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
     fillColor = [UIColor systemBackgroundColor];
     [fillColor setFill];
     
-    CGContextFillRect(UIGraphicsGetCurrentContext(), rect);
-    
-    for (UIBezierPath *path in self.pathArray) {
-        [self.lineColor setStroke];
-        [path stroke];
-    }
+    CGContextRef context = UIGraphicsGetCurrentContext();
+    CGContextFillRect(context, rect);
     
-    [self.lineColor setStroke];
-    [self.currentPath stroke];
+    // Finished strokes come from the rasterizer's tiles, so the cost of a frame does not grow with the signature.
+    [self.rasterizer drawInContext:context rect:rect color:self.lineColor.CGColor];
     _signatureSize = (self.bounds.size.width == 0 || self.bounds.size.height == 0) ? CGSizeMake(200, 200) :
                         self.bounds.size;
 }
@@ -499,10 +513,25 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
 - (void)setSignaturePath:(NSArray<UIBezierPath *> *)signaturePath {
     if (signaturePath) {
         _pathArray = [signaturePath mutableCopy];
+        [self.rasterizer removeAllStrokes];
+        for (UIBezierPath *path in _pathArray) {
+            [self.rasterizer addStrokePath:path.CGPath lineWidth:path.lineWidth];
+        }
         [self setNeedsDisplay];
     }
 }
 
+- (NSArray<NSData *> *)strokeSamples {
+    return [[NSArray alloc] initWithArray:self.sampleArray copyItems:YES];
+}
+
+- (void)setStrokeSamples:(NSArray<NSData *> *)strokeSamples {
+    _sampleArray = [NSMutableArray arrayWithCapacity:strokeSamples.count];
+    for (NSData *stroke in strokeSamples) {
+        [_sampleArray addObject:[stroke mutableCopy]];
+    }
+}
+
 - (UIImage *)signatureImage {
     UIGraphicsBeginImageContext(_signatureSize);
 
@@ -523,11 +552,9 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
 
 - (void)clear {
     if (self.pathArray.count > 0) {
-        if (self.currentPath != nil) {
-            self.currentPath = [self pathWithRoundedStyle];
-        }
-        
+        [self.rasterizer removeAllStrokes];
         [self.pathArray removeAllObjects];
+        [self.sampleArray removeAllObjects];
         [self setNeedsDisplayInRect:self.bounds];
     }
 }
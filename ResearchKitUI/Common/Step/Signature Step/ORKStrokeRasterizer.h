@@ -0,0 +1,130 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Renders freehand strokes from a tiled backing store.
+ 
+ Finished strokes are rasterized once into coverage tiles, which are only allocated where
+ something has been drawn. The stroke in progress is kept as a path and drawn on top of them.
+ Redrawing a rectangle costs one mask fill per tile that it overlaps, however many strokes came
+ before.
+ 
+ The stroke in progress is smoothed with quadratic curves through the midpoints between touch
+ locations, with each location as a control point. A stroke can be split into several paths,
+ for example to change the line width as it is drawn.
+ 
+ Coordinates are in points, with the origin at the top left as in `-[UIView drawRect:]`. The
+ rasterizer uses Core Graphics only, so it can run without a view.
+ */
+@interface ORKStrokeRasterizer : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithScale:(CGFloat)scale NS_DESIGNATED_INITIALIZER;
+
+/**
+ The number of pixels per point of the tiles. Changing it rasterizes the finished strokes again.
+ */
+@property (nonatomic) CGFloat scale;
+
+/**
+ The number of finished paths.
+ */
+@property (nonatomic, readonly) NSUInteger numberOfStrokePaths;
+
+@property (nonatomic, readonly) NSUInteger numberOfTiles;
+
+/**
+ The path of the stroke in progress, or NULL if there is none.
+ */
+@property (nonatomic, readonly, nullable) CGPathRef strokePath;
+
+@property (nonatomic, readonly) CGFloat strokeLineWidth;
+
+/**
+ The last touch location added to the stroke in progress.
+ */
+@property (nonatomic, readonly) CGPoint currentPoint;
+
+/**
+ The touch location before `currentPoint`, which is the control point of the last curve.
+ */
+@property (nonatomic, readonly) CGPoint previousPoint;
+
+/**
+ Starts a stroke with a dot at `point`. Returns the rectangle to redisplay.
+ */
+- (CGRect)beginStrokeAtPoint:(CGPoint)point previousPoint:(CGPoint)previousPoint lineWidth:(CGFloat)lineWidth;
+
+/**
+ Adds a curve to the midpoint between `point` and `previousPoint`. Returns the rectangle to
+ redisplay, or `CGRectNull` if there is no stroke in progress.
+ */
+- (CGRect)extendStrokeToPoint:(CGPoint)point previousPoint:(CGPoint)previousPoint;
+
+/**
+ Rasterizes the path of the stroke in progress into the tiles. The stroke can still be extended
+ after `restartStrokePathWithLineWidth:`.
+ 
+ Returns NO, and discards the path, if its bounds are empty.
+ */
+- (BOOL)commitStrokePath;
+
+/**
+ Starts a new path for the stroke in progress where the previous one ended.
+ */
+- (void)restartStrokePathWithLineWidth:(CGFloat)lineWidth;
+
+/**
+ Rasterizes a finished path, such as one restored from a saved drawing.
+ */
+- (void)addStrokePath:(CGPathRef)path lineWidth:(CGFloat)lineWidth;
+
+/**
+ Removes every stroke, including the one in progress, and frees the tiles.
+ */
+- (void)removeAllStrokes;
+
+/**
+ Draws the strokes that intersect `rect` with `color` into `context`, whose coordinates are
+ flipped to match the rasterizer's.
+ */
+- (void)drawInContext:(CGContextRef)context rect:(CGRect)rect color:(CGColorRef)color;
+
+@end
+
+NS_ASSUME_NONNULL_END
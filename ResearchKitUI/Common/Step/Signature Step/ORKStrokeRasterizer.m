@@ -0,0 +1,336 @@
+/*
+ Copyright (c) 2024, Apple Inc. All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKStrokeRasterizer.h"
+
+#import "ORKHelpers_Internal.h"
+
+
+static const size_t ORKStrokeTileSize = 256;
+static const CGFloat ORKStrokeDotRadius = 0.1;
+// The default flatness of UIBezierPath, so that strokes match those the views drew before.
+static const CGFloat ORKStrokeFlatness = 0.6;
+
+static CGPoint ORKStrokeMidpoint(CGPoint p1, CGPoint p2) {
+    return CGPointMake((p1.x + p2.x) * 0.5, (p1.y + p2.y) * 0.5);
+}
+
+static void ORKStrokePathInContext(CGContextRef context, CGPathRef path, CGFloat lineWidth) {
+    CGContextSetLineWidth(context, lineWidth);
+    CGContextSetLineCap(context, kCGLineCapRound);
+    CGContextSetLineJoin(context, kCGLineJoinRound);
+    CGContextSetFlatness(context, ORKStrokeFlatness);
+    CGContextAddPath(context, path);
+    CGContextStrokePath(context);
+}
+
+// Returns the tiles `first` to `last` that cover `minimum` to `maximum` points.
+static void ORKStrokeTileRange(CGFloat minimum, CGFloat maximum, CGFloat scale, NSInteger *first, NSInteger *last) {
+    *first = (NSInteger)floor(minimum * scale / ORKStrokeTileSize);
+    *last = MAX(*first, (NSInteger)ceil(maximum * scale / ORKStrokeTileSize) - 1);
+}
+
+
+@interface ORKStrokePathRecord : NSObject
+
+- (instancetype)initWithPath:(CGPathRef)path lineWidth:(CGFloat)lineWidth;
+
+@property (nonatomic, readonly) CGPathRef path;
+
+@property (nonatomic, readonly) CGFloat lineWidth;
+
+@end
+
+
+@implementation ORKStrokePathRecord
+
+- (instancetype)initWithPath:(CGPathRef)path lineWidth:(CGFloat)lineWidth {
+    self = [super init];
+    if (self) {
+        _path = CGPathCreateCopy(path);
+        _lineWidth = lineWidth;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    CGPathRelease(_path);
+}
+
+@end
+
+
+/**
+ A square of coverage, white where strokes have been drawn, for use as a clipping mask.
+ */
+@interface ORKStrokeTile : NSObject
+
+- (instancetype)initWithColumn:(NSInteger)column row:(NSInteger)row scale:(CGFloat)scale;
+
+@property (nonatomic, readonly) CGRect rect;
+
+- (void)strokePath:(CGPathRef)path lineWidth:(CGFloat)lineWidth;
+
+- (CGImageRef)image;
+
+@end
+
+
+@implementation ORKStrokeTile {
+    CGContextRef _context;
+    CGImageRef _image;
+}
+
+- (instancetype)initWithColumn:(NSInteger)column row:(NSInteger)row scale:(CGFloat)scale {
+    self = [super init];
+    if (self) {
+        CGFloat size = ORKStrokeTileSize / scale;
+        _rect = CGRectMake(column * size, row * size, size, size);
+        
+        // Zero-filled, so the tile starts out masking everything.
+        CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceGray();
+        _context = CGBitmapContextCreate(NULL, ORKStrokeTileSize, ORKStrokeTileSize, 8, 0, colorSpace, (CGBitmapInfo)kCGImageAlphaNone);
+        CGColorSpaceRelease(colorSpace);
+        
+        // Map the tile's points to its pixels, top row first like the rasterizer's coordinates.
+        CGContextTranslateCTM(_context, 0, ORKStrokeTileSize);
+        CGContextScaleCTM(_context, scale, -scale);
+        CGContextTranslateCTM(_context, -_rect.origin.x, -_rect.origin.y);
+        CGContextSetGrayStrokeColor(_context, 1.0, 1.0);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    CGImageRelease(_image);
+    CGContextRelease(_context);
+}
+
+- (void)strokePath:(CGPathRef)path lineWidth:(CGFloat)lineWidth {
+    CGImageRelease(_image);
+    _image = NULL;
+    ORKStrokePathInContext(_context, path, lineWidth);
+}
+
+- (CGImageRef)image {
+    if (_image == NULL) {
+        _image = CGBitmapContextCreateImage(_context);
+    }
+    return _image;
+}
+
+@end
+
+
+@implementation ORKStrokeRasterizer {
+    NSMutableArray<ORKStrokePathRecord *> *_strokePaths;
+    NSMutableDictionary<NSNumber *, ORKStrokeTile *> *_tiles;
+    CGMutablePathRef _strokePath;
+    BOOL _stroking;
+    CGPoint _previousPreviousPoint;
+}
+
+- (instancetype)init {
+    ORKThrowMethodUnavailableException();
+}
+
+- (instancetype)initWithScale:(CGFloat)scale {
+    self = [super init];
+    if (self) {
+        _scale = MAX(scale, 1.0);
+        _strokePaths = [NSMutableArray new];
+        _tiles = [NSMutableDictionary new];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    CGPathRelease(_strokePath);
+}
+
+- (void)setScale:(CGFloat)scale {
+    scale = MAX(scale, 1.0);
+    if (scale == _scale) {
+        return;
+    }
+    _scale = scale;
+    [_tiles removeAllObjects];
+    for (ORKStrokePathRecord *record in _strokePaths) {
+        [self rasterizePath:record.path lineWidth:record.lineWidth];
+    }
+}
+
+- (NSUInteger)numberOfStrokePaths {
+    return _strokePaths.count;
+}
+
+- (NSUInteger)numberOfTiles {
+    return _tiles.count;
+}
+
+- (CGPathRef)strokePath {
+    return _strokePath;
+}
+
+#pragma mark - Tiles
+
+- (void)enumerateTilesInRect:(CGRect)rect creatingTiles:(BOOL)create usingBlock:(void (^)(ORKStrokeTile *tile))block {
+    if (CGRectIsNull(rect) || CGRectIsEmpty(rect)) {
+        return;
+    }
+    NSInteger firstColumn, lastColumn, firstRow, lastRow;
+    ORKStrokeTileRange(CGRectGetMinX(rect), CGRectGetMaxX(rect), _scale, &firstColumn, &lastColumn);
+    ORKStrokeTileRange(CGRectGetMinY(rect), CGRectGetMaxY(rect), _scale, &firstRow, &lastRow);
+    for (NSInteger row = firstRow; row <= lastRow; row++) {
+        for (NSInteger column = firstColumn; column <= lastColumn; column++) {
+            NSNumber *key = @(((int64_t)row << 32) | (uint32_t)column);
+            ORKStrokeTile *tile = _tiles[key];
+            if (tile == nil && create) {
+                tile = [[ORKStrokeTile alloc] initWithColumn:column row:row scale:_scale];
+                _tiles[key] = tile;
+            }
+            if (tile != nil) {
+                block(tile);
+            }
+        }
+    }
+}
+
+- (void)rasterizePath:(CGPathRef)path lineWidth:(CGFloat)lineWidth {
+    // Round caps reach half the line width past the path; allow a pixel more for antialiasing.
+    CGFloat outset = lineWidth / 2 + 1.0 / _scale;
+    CGRect bounds = CGRectInset(CGPathGetPathBoundingBox(path), -outset, -outset);
+    [self enumerateTilesInRect:bounds creatingTiles:YES usingBlock:^(ORKStrokeTile *tile) {
+        [tile strokePath:path lineWidth:lineWidth];
+    }];
+}
+
+#pragma mark - Strokes
+
+- (CGRect)beginStrokeAtPoint:(CGPoint)point previousPoint:(CGPoint)previousPoint lineWidth:(CGFloat)lineWidth {
+    _stroking = YES;
+    _previousPreviousPoint = previousPoint;
+    _previousPoint = previousPoint;
+    _currentPoint = point;
+    _strokeLineWidth = lineWidth;
+    
+    CGPathRelease(_strokePath);
+    _strokePath = CGPathCreateMutable();
+    CGPathMoveToPoint(_strokePath, NULL, point.x, point.y);
+    CGPathAddArc(_strokePath, NULL, point.x, point.y, ORKStrokeDotRadius, 0.0, 2.0 * M_PI, false);
+    
+    CGFloat outset = lineWidth * 2.0 + ORKStrokeDotRadius;
+    return CGRectInset(CGRectMake(point.x, point.y, 0, 0), -outset, -outset);
+}
+
+- (CGRect)extendStrokeToPoint:(CGPoint)point previousPoint:(CGPoint)previousPoint {
+    if (_strokePath == NULL) {
+        return CGRectNull;
+    }
+    _previousPreviousPoint = _previousPoint;
+    _previousPoint = previousPoint;
+    _currentPoint = point;
+    
+    CGPoint mid1 = ORKStrokeMidpoint(_previousPoint, _previousPreviousPoint);
+    CGPoint mid2 = ORKStrokeMidpoint(_currentPoint, _previousPoint);
+    CGPathAddQuadCurveToPoint(_strokePath, NULL, _previousPoint.x, _previousPoint.y, mid2.x, mid2.y);
+    
+    // The curve lies within the hull of its points.
+    CGFloat minX = MIN(MIN(mid1.x, mid2.x), _previousPoint.x);
+    CGFloat minY = MIN(MIN(mid1.y, mid2.y), _previousPoint.y);
+    CGFloat maxX = MAX(MAX(mid1.x, mid2.x), _previousPoint.x);
+    CGFloat maxY = MAX(MAX(mid1.y, mid2.y), _previousPoint.y);
+    CGFloat outset = _strokeLineWidth * 2.0;
+    return CGRectInset(CGRectMake(minX, minY, maxX - minX, maxY - minY), -outset, -outset);
+}
+
+- (BOOL)commitStrokePath {
+    if (_strokePath == NULL) {
+        return NO;
+    }
+    BOOL committed = !CGSizeEqualToSize(CGPathGetPathBoundingBox(_strokePath).size, CGSizeZero);
+    if (committed) {
+        [_strokePaths addObject:[[ORKStrokePathRecord alloc] initWithPath:_strokePath lineWidth:_strokeLineWidth]];
+        [self rasterizePath:_strokePath lineWidth:_strokeLineWidth];
+    }
+    CGPathRelease(_strokePath);
+    _strokePath = NULL;
+    return committed;
+}
+
+- (void)restartStrokePathWithLineWidth:(CGFloat)lineWidth {
+    if (!_stroking) {
+        return;
+    }
+    CGPathRelease(_strokePath);
+    _strokePath = CGPathCreateMutable();
+    _strokeLineWidth = lineWidth;
+    CGPoint start = ORKStrokeMidpoint(_currentPoint, _previousPoint);
+    CGPathMoveToPoint(_strokePath, NULL, start.x, start.y);
+}
+
+- (void)addStrokePath:(CGPathRef)path lineWidth:(CGFloat)lineWidth {
+    [_strokePaths addObject:[[ORKStrokePathRecord alloc] initWithPath:path lineWidth:lineWidth]];
+    [self rasterizePath:path lineWidth:lineWidth];
+}
+
+- (void)removeAllStrokes {
+    _stroking = NO;
+    CGPathRelease(_strokePath);
+    _strokePath = NULL;
+    [_strokePaths removeAllObjects];
+    [_tiles removeAllObjects];
+}
+
+#pragma mark - Drawing
+
+- (void)drawInContext:(CGContextRef)context rect:(CGRect)rect color:(CGColorRef)color {
+    CGContextSaveGState(context);
+    CGContextClipToRect(context, rect);
+    CGContextSetFillColorWithColor(context, color);
+    [self enumerateTilesInRect:rect creatingTiles:NO usingBlock:^(ORKStrokeTile *tile) {
+        CGRect tileRect = tile.rect;
+        CGContextSaveGState(context);
+        // Images are drawn with their first row at the top of a y-up space, so flip the tile in place.
+        CGContextTranslateCTM(context, 0, CGRectGetMinY(tileRect) + CGRectGetMaxY(tileRect));
+        CGContextScaleCTM(context, 1, -1);
+        CGContextClipToMask(context, tileRect, tile.image);
+        CGContextFillRect(context, tileRect);
+        CGContextRestoreGState(context);
+    }];
+    if (_strokePath != NULL) {
+        CGContextSetStrokeColorWithColor(context, color);
+        ORKStrokePathInContext(context, _strokePath, _strokeLineWidth);
+    }
+    CGContextRestoreGState(context);
+}
+
+@end
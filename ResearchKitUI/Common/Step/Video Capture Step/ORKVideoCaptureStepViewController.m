@@ -34,6 +34,7 @@
 #import "ORKVideoCaptureView.h"
 #import "ORKVideoCaptureStep.h"
 #import "ORKHelpers_Internal.h"
+#import "ORKMediaArtifactStore.h"
 
 #import <AVFoundation/AVFoundation.h>
 
@@ -396,6 +397,19 @@
     self.recording = NO;
     self.fileURL = outputFileURL;
     
+    // The movie is recorded straight into the output directory; protect it there without copying it.
+    NSURL *outputDirectory = self.outputDirectory;
+    if (outputDirectory) {
+        dispatch_async(_sessionQueue, ^{
+            ORKMediaArtifactStore *store = [[ORKMediaArtifactStore alloc] initWithDirectoryURL:outputDirectory
+                                                                           fileProtectionMode:ORKFileProtectionCompleteUnlessOpen];
+            NSError *artifactError = nil;
+            if (![store adoptFileAtURL:outputFileURL error:&artifactError]) {
+                ORK_Log_Error("%@", artifactError);
+            }
+        });
+    }
+    
     if (UIAccessibilityIsVoiceOverRunning()) {
         UIAccessibilityPostNotification(UIAccessibilityAnnouncementNotification, ORKLocalizedString(@"AX_VIDEO_CAPTURE_COMPLETE", nil));
     }